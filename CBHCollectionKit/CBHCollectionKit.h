@@ -25,11 +25,34 @@ FOUNDATION_EXPORT const unsigned char CBHCollectionKitVersionString[];
 
 #import <CBHCollectionKit/CBHCollection.h>
 #import <CBHCollectionKit/CBHPrimitiveCollection.h>
+#import <CBHCollectionKit/CBHAllocator.h>
+#import <CBHCollectionKit/CBHAllocation.h>
+#import <CBHCollectionKit/CBHArenaAllocator.h>
+#import <CBHCollectionKit/CBHPoolAllocator.h>
+#import <CBHCollectionKit/CBHThreadCacheAllocator.h>
+#import <CBHCollectionKit/CBHCollectionPool.h>
+#import <CBHCollectionKit/CBHCollectionFormat.h>
+#import <CBHCollectionKit/CBHCollectionCoder.h>
+#import <CBHCollectionKit/CBHObjectCodec.h>
+#import <CBHCollectionKit/CBHSliceReader.h>
 
+#import <CBHCollectionKit/CBHSliceView.h>
 #import <CBHCollectionKit/CBHSlice.h>
 #import <CBHCollectionKit/CBHMutableSlice.h>
 #import <CBHCollectionKit/CBHWedge.h>
+#import <CBHCollectionKit/CBHSortedWedge.h>
+#import <CBHCollectionKit/CBHBitSlice.h>
+#import <CBHCollectionKit/CBHPackedWedge.h>
+#import <CBHCollectionKit/CBHCompressedWedge.h>
+#import <CBHCollectionKit/CBHTable.h>
+#import <CBHCollectionKit/CBHPrimitiveHashSet.h>
+#import <CBHCollectionKit/CBHPrimitiveHashMap.h>
 
 #import <CBHCollectionKit/CBHStack.h>
 #import <CBHCollectionKit/CBHQueue.h>
 #import <CBHCollectionKit/CBHHeap.h>
+#import <CBHCollectionKit/CBHConcurrentStack.h>
+#import <CBHCollectionKit/CBHBlockingQueue.h>
+#import <CBHCollectionKit/CBHPersistentStack.h>
+#import <CBHCollectionKit/CBHPersistentQueue.h>
+#import <CBHCollectionKit/CBHConcurrentHeap.h>
@@ -0,0 +1,84 @@
+//  CBHAllocation.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import <CBHCollectionKit/CBHAllocator.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Allocation Options
+
+/** The size of a cache line on the host, a useful alignment for buffers read with SIMD instructions. */
+#if defined(__arm64__) && defined(__APPLE__)
+#define CBHCacheLineSize 128
+#else
+#define CBHCacheLineSize 64
+#endif
+
+/** How the pages of a buffer are prepared when it is allocated. */
+typedef NS_OPTIONS(NSUInteger, CBHAllocationFlags) {
+	CBHAllocationFlagsNone = 0,
+
+	/** Buffers of at least `CBHHugePageSize` bytes are aligned to huge pages and, where the system supports it, backed by transparent huge pages. */
+	CBHAllocationHugePages = 1 << 0,
+
+	/** Every page of a buffer is touched when it is allocated or grown, so the first writes don't fault. Pages are placed by the allocating thread. */
+	CBHAllocationPrefault = 1 << 1,
+};
+
+/** The size of a huge page, below which `CBHAllocationHugePages` has no effect. */
+#define CBHHugePageSize ((size_t)2 * 1024 * 1024)
+
+/** How the buffer of a primitive collection is allocated.
+ *
+ * The options are kept by the collection and used again whenever its buffer is reallocated.
+ */
+typedef struct CBHAllocationOptions {
+	/** The alignment of the first entry in bytes, a power of two, or zero for the system's default. */
+	size_t alignment;
+
+	/** How the buffer's pages are prepared. */
+	CBHAllocationFlags flags;
+
+	/** Where the buffer comes from, or `NULL` for the system's allocator. `CBHAllocationHugePages` only applies to the system's allocator. */
+	const CBHAllocator * _Nullable allocator;
+} CBHAllocationOptions;
+
+/** The system's allocator and default alignment with no special page handling. */
+extern const CBHAllocationOptions CBHAllocationOptionsDefault;
+
+/** Makes allocation options.
+ *
+ * @param alignment    The alignment of the first entry in bytes. Must be zero or a power of two.
+ * @param flags        How the buffer's pages are prepared.
+ *
+ * @return             New allocation options.
+ */
+CBHAllocationOptions CBHAllocationOptionsMake(size_t alignment, CBHAllocationFlags flags);
+
+/** Makes allocation options which allocate from `allocator`.
+ *
+ * @param allocator    The allocator buffers come from. It must outlive every collection using it.
+ *
+ * @return             New allocation options with the default alignment.
+ */
+CBHAllocationOptions CBHAllocationOptionsWithAllocator(const CBHAllocator *allocator);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,45 @@
+//  CBHAllocation.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHAllocation.h"
+
+
+const CBHAllocationOptions CBHAllocationOptionsDefault = {0, CBHAllocationFlagsNone, NULL};
+
+
+#pragma mark - Allocation Options
+
+CBHAllocationOptions CBHAllocationOptionsMake(size_t alignment, CBHAllocationFlags flags)
+{
+	if ( (alignment & (alignment - 1)) != 0 ) @throw NSInvalidArgumentException;
+
+	CBHAllocationOptions options;
+	options.alignment = alignment;
+	options.flags = flags;
+	options.allocator = NULL;
+
+	return options;
+}
+
+CBHAllocationOptions CBHAllocationOptionsWithAllocator(const CBHAllocator *allocator)
+{
+	CBHAllocationOptions options = CBHAllocationOptionsDefault;
+	options.allocator = allocator;
+
+	return options;
+}
@@ -0,0 +1,75 @@
+//  CBHAllocator.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Allocator
+
+/** Allocates `length` bytes aligned to `alignment`.
+ *
+ * @param length       The number of bytes to allocate. May be zero.
+ * @param alignment    The alignment of the returned pointer, a power of two no smaller than `2 * sizeof(void *)`.
+ * @param context      The allocator's context.
+ *
+ * @return             The new bytes, or `NULL` if they could not be allocated.
+ */
+typedef void * _Nullable (*CBHAllocatorAllocFunction)(size_t length, size_t alignment, void * _Nullable context);
+
+/** Resizes bytes from the same allocator, keeping their leading contents.
+ *
+ * @param data         The bytes to resize.
+ * @param oldLength    The length the bytes were allocated with.
+ * @param newLength    The new length of the bytes.
+ * @param alignment    The alignment the bytes were allocated with.
+ * @param context      The allocator's context.
+ *
+ * @return             The resized bytes, or `NULL` if they could not be resized, in which case `data` is untouched.
+ */
+typedef void * _Nullable (*CBHAllocatorReallocFunction)(void *data, size_t oldLength, size_t newLength, size_t alignment, void * _Nullable context);
+
+/** Returns bytes to the allocator they came from.
+ *
+ * @param data         The bytes to free.
+ * @param length       The length the bytes were allocated with.
+ * @param alignment    The alignment the bytes were allocated with.
+ * @param context      The allocator's context.
+ */
+typedef void (*CBHAllocatorFreeFunction)(void *data, size_t length, size_t alignment, void * _Nullable context);
+
+/** A source of memory for the buffers of collections.
+ *
+ * Collections hand the allocator back the length and alignment of every buffer they free or resize, so allocators don't need to keep headers beside their allocations.
+ *
+ * @note: Collections don't retain their allocator. It must outlive every collection, copy, and `-dataNoCopy` created with it.
+ */
+typedef struct CBHAllocator {
+	CBHAllocatorAllocFunction alloc;
+	CBHAllocatorReallocFunction realloc;
+	CBHAllocatorFreeFunction free;
+
+	/** Passed to each of the functions. */
+	void * _Nullable context;
+} CBHAllocator;
+
+/** Allocates from the system's `malloc`, the allocator used when none is given. */
+extern const CBHAllocator CBHSystemAllocator;
+
+NS_ASSUME_NONNULL_END
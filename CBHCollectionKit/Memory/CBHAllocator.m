@@ -0,0 +1,66 @@
+//  CBHAllocator.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHAllocator.h"
+
+#include <stdlib.h>
+
+
+/// What `malloc` guarantees on every platform we run on.
+#define MALLOC_ALIGNMENT (2 * sizeof(void *))
+
+
+#pragma mark - System Allocator
+
+static void *CBHSystemAllocator_alloc(size_t length, size_t alignment, void *context)
+{
+	/// Zero length allocations are still unique pointers.
+	length = MAX(length, (size_t)1);
+	if ( alignment <= MALLOC_ALIGNMENT ) return malloc(length);
+
+	void *data = NULL;
+	if ( posix_memalign(&data, alignment, length) != 0 ) return NULL;
+
+	return data;
+}
+
+static void *CBHSystemAllocator_realloc(void *data, size_t oldLength, size_t newLength, size_t alignment, void *context)
+{
+	if ( alignment <= MALLOC_ALIGNMENT ) return realloc(data, MAX(newLength, (size_t)1));
+
+	/// There is no aligned realloc, so the contents are moved to new bytes.
+	void *resized = CBHSystemAllocator_alloc(newLength, alignment, context);
+	if ( !resized ) return NULL;
+
+	memcpy(resized, data, MIN(oldLength, newLength));
+	free(data);
+
+	return resized;
+}
+
+static void CBHSystemAllocator_free(void *data, size_t length, size_t alignment, void *context)
+{
+	free(data);
+}
+
+const CBHAllocator CBHSystemAllocator = {
+	CBHSystemAllocator_alloc,
+	CBHSystemAllocator_realloc,
+	CBHSystemAllocator_free,
+	NULL,
+};
@@ -0,0 +1,81 @@
+//  CBHArenaAllocator.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import <CBHCollectionKit/CBHAllocator.h>
+#import <CBHCollectionKit/CBHAllocation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** An allocator which hands out memory by bumping a pointer through large blocks, and takes it all back at once.
+ *
+ * Freeing is almost free: memory is reclaimed when the arena is reset, except that the most recent allocation is grown, shrunk and freed in place. Allocations larger than a block get a block of their own, which is released as soon as it is freed. This suits collections which live for a single request or frame.
+ *
+ * @note: Arenas are not thread safe. Resetting an arena invalidates every collection allocated from it.
+ *
+ * @author    Christian Huxtable <chris@huxtable.ca>
+ */
+@interface CBHArenaAllocator : NSObject
+
+#pragma mark - Factories
+
++ (instancetype)arena;
++ (instancetype)arenaWithBlockSize:(size_t)blockSize;
+
+
+#pragma mark - Initialization
+
+- (instancetype)init;
+
+/** Initializes an arena which reserves memory from the system `blockSize` bytes at a time.
+ *
+ * @param blockSize    The size of each block. Must not be zero.
+ *
+ * @return             An initialized arena.
+ */
+- (instancetype)initWithBlockSize:(size_t)blockSize NS_DESIGNATED_INITIALIZER;
+
+
+#pragma mark - Properties
+
+/** The allocator to give collections. Valid for the life of the arena. */
+@property (nonatomic, readonly) const CBHAllocator *allocator;
+
+/** Allocation options which allocate from the arena. */
+@property (nonatomic, readonly) CBHAllocationOptions allocationOptions;
+
+@property (nonatomic, readonly) size_t blockSize;
+
+/** The number of bytes handed out since the arena was last reset, including padding. */
+@property (nonatomic, readonly) size_t bytesAllocated;
+
+/** The number of bytes held from the system. */
+@property (nonatomic, readonly) size_t bytesReserved;
+
+
+#pragma mark - Resetting
+
+/** Takes back everything allocated from the arena. Blocks are kept for reuse, blocks for large allocations are released.
+ */
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
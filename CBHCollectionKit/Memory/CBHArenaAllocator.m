@@ -0,0 +1,294 @@
+//  CBHArenaAllocator.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHArenaAllocator.h"
+
+@import CBHMemoryKit;
+
+#include <stdlib.h>
+
+
+#define DEFAULT_BLOCK_SIZE (64 * 1024)
+
+#define _blockBytes(aBlock) ((uint8_t *)(aBlock) + sizeof(CBHArenaBlock_t))
+/// Whether an allocation might not fit in a fresh block once aligned.
+#define _isLarge(anArena, aLength, anAlignment) ( (aLength) > (anArena)->_blockSize || (anAlignment) - 1 > (anArena)->_blockSize - (aLength) )
+
+
+typedef struct CBHArenaBlock_t {
+	struct CBHArenaBlock_t *_next;
+	size_t _size;
+	size_t _used;
+} CBHArenaBlock_t;
+
+
+#pragma mark - Blocks
+
+static CBHArenaBlock_t *CBHArenaBlock_create(size_t size)
+{
+	if ( size > SIZE_MAX - sizeof(CBHArenaBlock_t) ) return NULL;
+
+	CBHArenaBlock_t *block = malloc(sizeof(CBHArenaBlock_t) + size);
+	if ( !block ) return NULL;
+
+	block->_next = NULL;
+	block->_size = size;
+	block->_used = 0;
+
+	return block;
+}
+
+static void CBHArenaBlock_freeAll(CBHArenaBlock_t *block)
+{
+	while ( block )
+	{
+		CBHArenaBlock_t *next = block->_next;
+		free(block);
+		block = next;
+	}
+}
+
+static void *CBHArenaBlock_bump(CBHArenaBlock_t *block, size_t length, size_t alignment)
+{
+	const uintptr_t base = (uintptr_t)_blockBytes(block);
+	const uintptr_t start = (base + block->_used + (alignment - 1)) & ~(uintptr_t)(alignment - 1);
+	const size_t offset = (size_t)(start - base);
+
+	if ( offset > block->_size || length > block->_size - offset ) return NULL;
+
+	block->_used = offset + length;
+	return (void *)start;
+}
+
+
+@implementation CBHArenaAllocator
+{
+	CBHAllocator _allocator;
+	size_t _blockSize;
+
+	CBHArenaBlock_t *_first;
+	CBHArenaBlock_t *_current;
+
+	/// Blocks holding a single allocation too large for a regular block.
+	CBHArenaBlock_t *_large;
+}
+
+#pragma mark - Allocator
+
+/// Whether `data` is the most recent allocation in the current block.
+static BOOL CBHArena_isTop(CBHArenaAllocator *arena, void *data, size_t length)
+{
+	return ( (uint8_t *)data + length == _blockBytes(arena->_current) + arena->_current->_used );
+}
+
+static void *CBHArena_alloc(size_t length, size_t alignment, void *context)
+{
+	CBHArenaAllocator *arena = (CBHArenaAllocator *)context;
+	length = MAX(length, (size_t)1);
+
+	if ( _isLarge(arena, length, alignment) )
+	{
+		if ( length > SIZE_MAX - alignment ) return NULL;
+
+		CBHArenaBlock_t *block = CBHArenaBlock_create(length + alignment);
+		if ( !block ) return NULL;
+
+		block->_next = arena->_large;
+		arena->_large = block;
+
+		return CBHArenaBlock_bump(block, length, alignment);
+	}
+
+	while ( YES )
+	{
+		void *data = CBHArenaBlock_bump(arena->_current, length, alignment);
+		if ( data ) return data;
+
+		/// Blocks past the current one are empty, either fresh or kept from before a reset.
+		if ( !arena->_current->_next )
+		{
+			arena->_current->_next = CBHArenaBlock_create(arena->_blockSize);
+			if ( !arena->_current->_next ) return NULL;
+		}
+
+		arena->_current = arena->_current->_next;
+	}
+}
+
+static void CBHArena_free(void *data, size_t length, size_t alignment, void *context)
+{
+	CBHArenaAllocator *arena = (CBHArenaAllocator *)context;
+	length = MAX(length, (size_t)1);
+
+	if ( _isLarge(arena, length, alignment) )
+	{
+		for (CBHArenaBlock_t **link = &arena->_large; *link; link = &(*link)->_next)
+		{
+			CBHArenaBlock_t *block = *link;
+			if ( (uint8_t *)data < _blockBytes(block) || (uint8_t *)data >= _blockBytes(block) + block->_size ) continue;
+
+			*link = block->_next;
+			free(block);
+			return;
+		}
+
+		return;
+	}
+
+	if ( CBHArena_isTop(arena, data, length) )
+	{
+		arena->_current->_used = (size_t)((uint8_t *)data - _blockBytes(arena->_current));
+	}
+}
+
+static void *CBHArena_realloc(void *data, size_t oldLength, size_t newLength, size_t alignment, void *context)
+{
+	CBHArenaAllocator *arena = (CBHArenaAllocator *)context;
+	oldLength = MAX(oldLength, (size_t)1);
+	newLength = MAX(newLength, (size_t)1);
+
+	if ( !_isLarge(arena, oldLength, alignment) )
+	{
+		/// The most recent allocation can move its end freely.
+		if ( CBHArena_isTop(arena, data, oldLength) )
+		{
+			const size_t offset = (size_t)((uint8_t *)data - _blockBytes(arena->_current));
+			if ( newLength <= arena->_current->_size - offset )
+			{
+				arena->_current->_used = offset + newLength;
+				return data;
+			}
+		}
+		else if ( newLength <= oldLength )
+		{
+			return data;
+		}
+	}
+
+	void *resized = CBHArena_alloc(newLength, alignment, context);
+	if ( !resized ) return NULL;
+
+	memcpy(resized, data, MIN(oldLength, newLength));
+	CBHArena_free(data, oldLength, alignment, context);
+
+	return resized;
+}
+
+
+#pragma mark - Factories
+
++ (instancetype)arena
+{
+	return [[(CBHArenaAllocator *)[self alloc] init] autorelease];
+}
+
++ (instancetype)arenaWithBlockSize:(size_t)blockSize
+{
+	return [[(CBHArenaAllocator *)[self alloc] initWithBlockSize:blockSize] autorelease];
+}
+
+
+#pragma mark - Initialization
+
+- (instancetype)init
+{
+	return [self initWithBlockSize:DEFAULT_BLOCK_SIZE];
+}
+
+- (instancetype)initWithBlockSize:(size_t)blockSize
+{
+	if ( blockSize <= 0 ) @throw NSInvalidArgumentException;
+
+	if ( (self = [super init]) )
+	{
+		_first = CBHArenaBlock_create(blockSize);
+		if ( !_first ) @throw CBHCallocException;
+
+		_current = _first;
+		_large = NULL;
+		_blockSize = blockSize;
+
+		_allocator.alloc = CBHArena_alloc;
+		_allocator.realloc = CBHArena_realloc;
+		_allocator.free = CBHArena_free;
+		_allocator.context = self;
+	}
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	CBHArenaBlock_freeAll(_first);
+	CBHArenaBlock_freeAll(_large);
+
+	[super dealloc];
+}
+
+
+#pragma mark - Properties
+
+- (const CBHAllocator *)allocator
+{
+	return &_allocator;
+}
+
+- (CBHAllocationOptions)allocationOptions
+{
+	return CBHAllocationOptionsWithAllocator(&_allocator);
+}
+
+- (size_t)blockSize
+{
+	return _blockSize;
+}
+
+- (size_t)bytesAllocated
+{
+	size_t total = 0;
+	for (CBHArenaBlock_t *block = _first; block; block = block->_next) { total += block->_used; }
+	for (CBHArenaBlock_t *block = _large; block; block = block->_next) { total += block->_used; }
+
+	return total;
+}
+
+- (size_t)bytesReserved
+{
+	size_t total = 0;
+	for (CBHArenaBlock_t *block = _first; block; block = block->_next) { total += block->_size; }
+	for (CBHArenaBlock_t *block = _large; block; block = block->_next) { total += block->_size; }
+
+	return total;
+}
+
+
+#pragma mark - Resetting
+
+- (void)reset
+{
+	CBHArenaBlock_freeAll(_large);
+	_large = NULL;
+
+	for (CBHArenaBlock_t *block = _first; block; block = block->_next) { block->_used = 0; }
+	_current = _first;
+}
+
+@end
@@ -0,0 +1,129 @@
+//  CBHCollectionPool.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import <CBHCollectionKit/CBHWedge.h>
+#import <CBHCollectionKit/CBHStack.h>
+#import <CBHCollectionKit/CBHQueue.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** Counts of how a collection pool has been used. */
+typedef struct CBHCollectionPoolStatistics {
+	/** Collections handed out from the pool. */
+	NSUInteger hits;
+
+	/** Collections created because the pool had none to hand out. */
+	NSUInteger misses;
+
+	/** Collections taken back. */
+	NSUInteger recycled;
+
+	/** Collections turned away, because they couldn't be reused or would take the pool over its byte limit. */
+	NSUInteger discarded;
+} CBHCollectionPoolStatistics;
+
+
+/** A pool of empty wedges, stacks, and queues which keeps their buffers between uses.
+ *
+ * Collections handed out are empty and have at least the capacity asked for. When done with one, recycle it and the pool empties it, keeping its capacity, and holds on to it for the next request. Each thread keeps a few collections of each kind to itself, which it takes and returns without locking. Collections beyond that are shared between threads.
+ *
+ * Only collections whose buffers are their own and come from the system are taken back, and only while the pool holds no more than `maximumRetainedBytes`.
+ *
+ * @note: Collections must not be used after they are recycled. A thread's collections are released when it exits, or when the pool is deallocated on that thread. Those of other threads still running when the pool is deallocated are released as the threads exit or next set up a cache.
+ *
+ * @author    Christian Huxtable <chris@huxtable.ca>
+ */
+@interface CBHCollectionPool : NSObject
+
+#pragma mark - Factories
+
++ (instancetype)pool;
++ (instancetype)poolWithMaximumRetainedBytes:(size_t)maximumRetainedBytes;
+
+
+#pragma mark - Initialization
+
+- (instancetype)init;
+
+/** Initializes a pool which holds on to at most `maximumRetainedBytes` of collections.
+ *
+ * @param maximumRetainedBytes    The most bytes of objects and buffers the pool keeps alive.
+ * @param depth                   The number of collections of each kind each thread keeps to itself. Must not be zero.
+ *
+ * @return                        An initialized pool.
+ */
+- (instancetype)initWithMaximumRetainedBytes:(size_t)maximumRetainedBytes depth:(NSUInteger)depth NS_DESIGNATED_INITIALIZER;
+
+
+#pragma mark - Properties
+
+@property (nonatomic, readonly) size_t maximumRetainedBytes;
+@property (nonatomic, readonly) NSUInteger depth;
+
+/** The number of bytes of objects and buffers the pool currently keeps alive. */
+@property (nonatomic, readonly) size_t retainedBytes;
+
+/** The pool's use so far, summed over every thread. */
+@property (nonatomic, readonly) CBHCollectionPoolStatistics statistics;
+
+
+#pragma mark - Taking Collections
+
+- (CBHWedge *)wedgeWithEntrySize:(size_t)entrySize;
+- (CBHWedge *)wedgeWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity;
+
+- (CBHStack *)stack;
+- (CBHStack *)stackWithCapacity:(NSUInteger)capacity;
+
+- (CBHQueue *)queue;
+- (CBHQueue *)queueWithCapacity:(NSUInteger)capacity;
+
+
+#pragma mark - Recycling
+
+/** Empties `wedge` and keeps it for reuse, or leaves it be if it can't be reused.
+ *
+ * @param wedge    A wedge which is no longer used. Subclasses are not taken back.
+ */
+- (void)recycleWedge:(CBHWedge *)wedge;
+
+/** Empties `stack`, releasing its objects, and keeps it for reuse, or leaves it be if it can't be reused.
+ *
+ * @param stack    A stack which is no longer used. Subclasses are not taken back.
+ */
+- (void)recycleStack:(CBHStack *)stack;
+
+/** Empties `queue`, releasing its objects, and keeps it for reuse, or leaves it be if it can't be reused.
+ *
+ * @param queue    A queue which is no longer used. Subclasses are not taken back.
+ */
+- (void)recycleQueue:(CBHQueue *)queue;
+
+
+#pragma mark - Draining
+
+/** Releases the collections kept by the calling thread and those shared between threads.
+ */
+- (void)drain;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,486 @@
+//  CBHCollectionPool.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHCollectionPool.h"
+#import "_CBHReuse.h"
+#import "_CBHPerThread.h"
+
+@import CBHMemoryKit;
+
+#include <stdlib.h>
+
+
+#define DEFAULT_MAXIMUM_RETAINED_BYTES (16 * 1024 * 1024)
+#define DEFAULT_DEPTH 16
+#define DEFAULT_CAPACITY 8
+
+#define _objectAt(aCache, aKind, aPosition) (aCache)->_objects[((aKind) * (aCache)->_shared->_depth) + (aPosition)]
+
+/// Statistics are written by their thread alone and read by any.
+#define _increment(aStatistic) __atomic_store_n(&(aStatistic), __atomic_load_n(&(aStatistic), __ATOMIC_RELAXED) + 1, __ATOMIC_RELAXED)
+
+
+typedef NS_ENUM(NSUInteger, CBHCollectionPoolKind) {
+	CBHCollectionPoolKindWedge = 0,
+	CBHCollectionPoolKindStack,
+	CBHCollectionPoolKindQueue,
+	CBHCollectionPoolKindCount,
+};
+
+/// State shared by the pool and its threads' caches.
+typedef struct CBHCollectionPoolShared_t {
+	CBHPerThread_t _perThread;
+
+	size_t _maximumRetainedBytes;
+	NSUInteger _depth;
+
+	/// Updated atomically by every thread.
+	size_t _retainedBytes;
+
+	/// Collections recycled while their thread's cache was full, guarded by the lock.
+	NSMutableArray *_shared[CBHCollectionPoolKindCount];
+
+	/// Statistics of threads which have exited or never got a cache, guarded by the lock.
+	CBHCollectionPoolStatistics _retired;
+} CBHCollectionPoolShared_t;
+
+typedef struct CBHCollectionPoolCache_t {
+	CBHPerThreadEntry_t _entry;
+	CBHCollectionPoolShared_t *_shared;
+
+	CBHCollectionPoolStatistics _statistics;
+
+	/// The number of collections held of each kind.
+	NSUInteger _counts[CBHCollectionPoolKindCount];
+
+	/// `_depth` collections of each kind.
+	id *_objects;
+} CBHCollectionPoolCache_t;
+
+#define _lock(aShared) pthread_mutex_lock(&(aShared)->_perThread._lock)
+#define _unlock(aShared) pthread_mutex_unlock(&(aShared)->_perThread._lock)
+
+
+#pragma mark - Sizes
+
+static size_t CBHCollectionPool_lengthOf(id collection, CBHCollectionPoolKind kind)
+{
+	switch (kind)
+	{
+		case CBHCollectionPoolKindWedge: return [(CBHWedge *)collection reusableLength];
+		case CBHCollectionPoolKindStack: return [(CBHStack *)collection reusableLength];
+		default: return [(CBHQueue *)collection reusableLength];
+	}
+}
+
+/// Whether `collection` can be handed out for a request of `entrySize`, which only matters for wedges.
+static BOOL CBHCollectionPool_matches(id collection, CBHCollectionPoolKind kind, size_t entrySize)
+{
+	return ( kind != CBHCollectionPoolKindWedge || [(CBHWedge *)collection entrySize] == entrySize );
+}
+
+
+#pragma mark - Caches
+
+static void CBHCollectionPoolShared_free(CBHPerThread_t *perThread)
+{
+	CBHCollectionPoolShared_t *shared = (CBHCollectionPoolShared_t *)perThread;
+	for (NSUInteger i = 0; i < CBHCollectionPoolKindCount; ++i) { [shared->_shared[i] release]; }
+
+	free(shared);
+}
+
+static void CBHCollectionPoolStatistics_add(CBHCollectionPoolStatistics *sum, const CBHCollectionPoolStatistics *statistics)
+{
+	sum->hits += __atomic_load_n(&statistics->hits, __ATOMIC_RELAXED);
+	sum->misses += __atomic_load_n(&statistics->misses, __ATOMIC_RELAXED);
+	sum->recycled += __atomic_load_n(&statistics->recycled, __ATOMIC_RELAXED);
+	sum->discarded += __atomic_load_n(&statistics->discarded, __ATOMIC_RELAXED);
+}
+
+/// Releases every collection held by `cache`.
+static void CBHCollectionPoolCache_flush(CBHCollectionPoolCache_t *cache)
+{
+	CBHCollectionPoolShared_t *shared = cache->_shared;
+
+	@autoreleasepool
+	{
+		for (NSUInteger kind = 0; kind < CBHCollectionPoolKindCount; ++kind)
+		{
+			while ( cache->_counts[kind] > 0 )
+			{
+				id collection = _objectAt(cache, kind, --cache->_counts[kind]);
+				__atomic_fetch_sub(&shared->_retainedBytes, CBHCollectionPool_lengthOf(collection, kind), __ATOMIC_RELAXED);
+				[collection release];
+			}
+		}
+	}
+}
+
+static void CBHCollectionPoolCache_retire(CBHPerThreadEntry_t *entry)
+{
+	CBHCollectionPoolCache_t *cache = (CBHCollectionPoolCache_t *)entry;
+	CBHCollectionPoolShared_t *shared = cache->_shared;
+
+	/// Released outside the lock, as collections release their objects.
+	CBHCollectionPoolCache_flush(cache);
+
+	/// Moved in one step so the statistics are never counted twice.
+	_lock(shared);
+	CBHCollectionPoolStatistics_add(&shared->_retired, &cache->_statistics);
+	memset(&cache->_statistics, 0, sizeof(cache->_statistics));
+	_unlock(shared);
+}
+
+/// The calling thread's cache, created on first use. Returns `NULL` if it could not be created.
+static CBHCollectionPoolCache_t *CBHCollectionPoolCache_current(CBHCollectionPoolShared_t *shared)
+{
+	CBHCollectionPoolCache_t *cache = (CBHCollectionPoolCache_t *)CBHPerThread_current(&shared->_perThread);
+	if ( !cache || cache->_objects ) return cache;
+
+	/// Fresh caches are zeroed, the collections follow the cache itself.
+	cache->_shared = shared;
+	cache->_objects = (id *)(cache + 1);
+
+	return cache;
+}
+
+/// The calling thread's cache, or `NULL` if it has none.
+static CBHCollectionPoolCache_t *CBHCollectionPoolCache_existing(CBHCollectionPoolShared_t *shared)
+{
+	return (CBHCollectionPoolCache_t *)CBHPerThread_existing(&shared->_perThread);
+}
+
+/// The statistics to count the calling thread's use in, falling back to the shared ones under the lock.
+#define _count(aCache, aShared, aField) do {\
+	if ( aCache ) { _increment((aCache)->_statistics.aField); }\
+	else\
+	{\
+		_lock(aShared);\
+		++(aShared)->_retired.aField;\
+		_unlock(aShared);\
+	}\
+} while (0)
+
+
+#pragma mark - Taking and Returning
+
+/// Takes a collection of `kind` from the calling thread's cache, or those shared between threads. Returns `nil` on a miss.
+static id CBHCollectionPool_take(CBHCollectionPoolShared_t *shared, CBHCollectionPoolKind kind, size_t entrySize)
+{
+	CBHCollectionPoolCache_t *cache = CBHCollectionPoolCache_current(shared);
+	id collection = nil;
+
+	if ( cache )
+	{
+		/// Most recently returned first, it is the most likely to still be in cache.
+		for (NSUInteger i = cache->_counts[kind]; i > 0; --i)
+		{
+			id candidate = _objectAt(cache, kind, i - 1);
+			if ( !CBHCollectionPool_matches(candidate, kind, entrySize) ) continue;
+
+			const NSUInteger last = --cache->_counts[kind];
+			_objectAt(cache, kind, i - 1) = _objectAt(cache, kind, last);
+			collection = candidate;
+			break;
+		}
+	}
+
+	if ( !collection )
+	{
+		_lock(shared);
+
+		NSMutableArray *collections = shared->_shared[kind];
+		for (NSUInteger i = [collections count]; i > 0; --i)
+		{
+			id candidate = [collections objectAtIndex:i - 1];
+			if ( !CBHCollectionPool_matches(candidate, kind, entrySize) ) continue;
+
+			collection = [candidate retain];
+			[collections removeObjectAtIndex:i - 1];
+			break;
+		}
+
+		_unlock(shared);
+	}
+
+	if ( !collection )
+	{
+		_count(cache, shared, misses);
+		return nil;
+	}
+
+	__atomic_fetch_sub(&shared->_retainedBytes, CBHCollectionPool_lengthOf(collection, kind), __ATOMIC_RELAXED);
+	_count(cache, shared, hits);
+
+	return [collection autorelease];
+}
+
+/// Keeps an emptied `collection` of `kind`, unless it would take the pool over its limit.
+static void CBHCollectionPool_return(CBHCollectionPoolShared_t *shared, id collection, CBHCollectionPoolKind kind)
+{
+	CBHCollectionPoolCache_t *cache = CBHCollectionPoolCache_current(shared);
+	const size_t length = CBHCollectionPool_lengthOf(collection, kind);
+
+	/// Reserve the bytes first so racing threads can't overshoot the limit together.
+	const size_t retained = __atomic_add_fetch(&shared->_retainedBytes, length, __ATOMIC_RELAXED);
+	if ( retained > shared->_maximumRetainedBytes )
+	{
+		__atomic_fetch_sub(&shared->_retainedBytes, length, __ATOMIC_RELAXED);
+		_count(cache, shared, discarded);
+		return;
+	}
+
+	if ( cache && cache->_counts[kind] < shared->_depth )
+	{
+		_objectAt(cache, kind, cache->_counts[kind]++) = [collection retain];
+		_increment(cache->_statistics.recycled);
+		return;
+	}
+
+	_lock(shared);
+	[shared->_shared[kind] addObject:collection];
+	_unlock(shared);
+
+	_count(cache, shared, recycled);
+}
+
+
+@implementation CBHCollectionPool
+{
+	CBHCollectionPoolShared_t *_shared;
+}
+
+#pragma mark - Factories
+
++ (instancetype)pool
+{
+	return [[(CBHCollectionPool *)[self alloc] init] autorelease];
+}
+
++ (instancetype)poolWithMaximumRetainedBytes:(size_t)maximumRetainedBytes
+{
+	return [[(CBHCollectionPool *)[self alloc] initWithMaximumRetainedBytes:maximumRetainedBytes depth:DEFAULT_DEPTH] autorelease];
+}
+
+
+#pragma mark - Initialization
+
+- (instancetype)init
+{
+	return [self initWithMaximumRetainedBytes:DEFAULT_MAXIMUM_RETAINED_BYTES depth:DEFAULT_DEPTH];
+}
+
+- (instancetype)initWithMaximumRetainedBytes:(size_t)maximumRetainedBytes depth:(NSUInteger)depth
+{
+	if ( depth == 0 )
+	{
+		[self release];
+		@throw NSInvalidArgumentException;
+	}
+
+	if ( (self = [super init]) )
+	{
+		CBHCollectionPoolShared_t *shared = calloc(1, sizeof(CBHCollectionPoolShared_t));
+		if ( !shared )
+		{
+			[self release];
+			@throw CBHCallocException;
+		}
+
+		shared->_maximumRetainedBytes = maximumRetainedBytes;
+		shared->_depth = depth;
+		shared->_retainedBytes = 0;
+
+		const size_t cacheLength = sizeof(CBHCollectionPoolCache_t) + (CBHCollectionPoolKindCount * depth * sizeof(id));
+		CBHPerThread_init(&shared->_perThread, cacheLength, (CBHPerThreadCallbacks){CBHCollectionPoolCache_retire, CBHCollectionPoolShared_free});
+
+		for (NSUInteger i = 0; i < CBHCollectionPoolKindCount; ++i) { shared->_shared[i] = [[NSMutableArray alloc] init]; }
+
+		_shared = shared;
+	}
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	/// Only the calling thread's cache and the shared collections are released here, other threads release theirs.
+	if ( _shared )
+	{
+		[self drain];
+		CBHPerThread_close(&_shared->_perThread);
+	}
+
+	[super dealloc];
+}
+
+
+#pragma mark - Properties
+
+- (size_t)maximumRetainedBytes
+{
+	return _shared->_maximumRetainedBytes;
+}
+
+- (NSUInteger)depth
+{
+	return _shared->_depth;
+}
+
+- (size_t)retainedBytes
+{
+	return __atomic_load_n(&_shared->_retainedBytes, __ATOMIC_RELAXED);
+}
+
+- (CBHCollectionPoolStatistics)statistics
+{
+	_lock(_shared);
+
+	CBHCollectionPoolStatistics statistics = _shared->_retired;
+	for (CBHPerThreadEntry_t *entry = _shared->_perThread._caches; entry; entry = entry->_next) { CBHCollectionPoolStatistics_add(&statistics, &((CBHCollectionPoolCache_t *)entry)->_statistics); }
+
+	_unlock(_shared);
+
+	return statistics;
+}
+
+
+#pragma mark - Taking Collections
+
+- (CBHWedge *)wedgeWithEntrySize:(size_t)entrySize
+{
+	return [self wedgeWithEntrySize:entrySize andCapacity:DEFAULT_CAPACITY];
+}
+
+- (CBHWedge *)wedgeWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity
+{
+	CBHWedge *wedge = CBHCollectionPool_take(_shared, CBHCollectionPoolKindWedge, entrySize);
+	if ( !wedge ) return [CBHWedge wedgeWithEntrySize:entrySize andCapacity:capacity];
+
+	[wedge growToFit:capacity];
+	return wedge;
+}
+
+- (CBHStack *)stack
+{
+	return [self stackWithCapacity:DEFAULT_CAPACITY];
+}
+
+- (CBHStack *)stackWithCapacity:(NSUInteger)capacity
+{
+	CBHStack *stack = CBHCollectionPool_take(_shared, CBHCollectionPoolKindStack, sizeof(id));
+	if ( !stack ) return [CBHStack stackWithCapacity:capacity];
+
+	[stack growToFit:capacity];
+	return stack;
+}
+
+- (CBHQueue *)queue
+{
+	return [self queueWithCapacity:DEFAULT_CAPACITY];
+}
+
+- (CBHQueue *)queueWithCapacity:(NSUInteger)capacity
+{
+	CBHQueue *queue = CBHCollectionPool_take(_shared, CBHCollectionPoolKindQueue, sizeof(id));
+	if ( !queue ) return [CBHQueue queueWithCapacity:capacity];
+
+	[queue growToFit:capacity];
+	return queue;
+}
+
+
+#pragma mark - Recycling
+
+- (void)recycleWedge:(CBHWedge *)wedge
+{
+	if ( !wedge ) return;
+
+	if ( [wedge class] != [CBHWedge class] || ![wedge isReusable] )
+	{
+		CBHCollectionPoolCache_t *cache = CBHCollectionPoolCache_existing(_shared);
+		_count(cache, _shared, discarded);
+		return;
+	}
+
+	[wedge removeAll];
+	CBHCollectionPool_return(_shared, wedge, CBHCollectionPoolKindWedge);
+}
+
+- (void)recycleStack:(CBHStack *)stack
+{
+	if ( !stack ) return;
+
+	if ( [stack class] != [CBHStack class] || ![stack isReusable] )
+	{
+		CBHCollectionPoolCache_t *cache = CBHCollectionPoolCache_existing(_shared);
+		_count(cache, _shared, discarded);
+		return;
+	}
+
+	[stack removeAllObjects];
+	CBHCollectionPool_return(_shared, stack, CBHCollectionPoolKindStack);
+}
+
+- (void)recycleQueue:(CBHQueue *)queue
+{
+	if ( !queue ) return;
+
+	if ( [queue class] != [CBHQueue class] || ![queue isReusable] )
+	{
+		CBHCollectionPoolCache_t *cache = CBHCollectionPoolCache_existing(_shared);
+		_count(cache, _shared, discarded);
+		return;
+	}
+
+	[queue removeAllObjects];
+	CBHCollectionPool_return(_shared, queue, CBHCollectionPoolKindQueue);
+}
+
+
+#pragma mark - Draining
+
+- (void)drain
+{
+	CBHCollectionPoolCache_t *cache = CBHCollectionPoolCache_existing(_shared);
+	if ( cache ) CBHCollectionPoolCache_flush(cache);
+
+	_lock(_shared);
+
+	NSMutableArray *collections[CBHCollectionPoolKindCount];
+	for (NSUInteger kind = 0; kind < CBHCollectionPoolKindCount; ++kind)
+	{
+		collections[kind] = _shared->_shared[kind];
+		_shared->_shared[kind] = [[NSMutableArray alloc] init];
+	}
+
+	_unlock(_shared);
+
+	/// Released outside the lock, as collections release their objects.
+	for (NSUInteger kind = 0; kind < CBHCollectionPoolKindCount; ++kind)
+	{
+		for (id collection in collections[kind]) { __atomic_fetch_sub(&_shared->_retainedBytes, CBHCollectionPool_lengthOf(collection, kind), __ATOMIC_RELAXED); }
+		[collections[kind] release];
+	}
+}
+
+@end
@@ -0,0 +1,69 @@
+//  CBHPoolAllocator.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import <CBHCollectionKit/CBHAllocator.h>
+#import <CBHCollectionKit/CBHAllocation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** A thread safe allocator which keeps freed memory in power-of-two size classes for reuse.
+ *
+ * Requests of up to `maximumSize` bytes are rounded up to a size class and carved from large slabs, so collections of similar sizes reuse each other's memory instead of fragmenting the heap. Slabs are only returned to the system when the pool is deallocated. Larger requests go to the system's allocator.
+ *
+ * @author    Christian Huxtable <chris@huxtable.ca>
+ */
+@interface CBHPoolAllocator : NSObject
+
+#pragma mark - Factories
+
++ (instancetype)pool;
++ (instancetype)poolWithMaximumSize:(size_t)maximumSize;
+
+
+#pragma mark - Initialization
+
+- (instancetype)init;
+
+/** Initializes a pool which keeps allocations of up to `maximumSize` bytes.
+ *
+ * @param maximumSize    The size of the largest size class, rounded up to a power of two and limited to 256KB.
+ *
+ * @return               An initialized pool.
+ */
+- (instancetype)initWithMaximumSize:(size_t)maximumSize NS_DESIGNATED_INITIALIZER;
+
+
+#pragma mark - Properties
+
+/** The allocator to give collections. Valid for the life of the pool. */
+@property (nonatomic, readonly) const CBHAllocator *allocator;
+
+/** Allocation options which allocate from the pool. */
+@property (nonatomic, readonly) CBHAllocationOptions allocationOptions;
+
+@property (nonatomic, readonly) size_t maximumSize;
+
+/** The number of bytes held in slabs. */
+@property (nonatomic, readonly) size_t bytesReserved;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,264 @@
+//  CBHPoolAllocator.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHPoolAllocator.h"
+
+@import CBHMemoryKit;
+
+#include <stdlib.h>
+#include <pthread.h>
+
+
+#define MINIMUM_SHIFT 4
+#define DEFAULT_MAXIMUM_SIZE (64 * 1024)
+#define SLAB_SIZE (256 * 1024)
+#define SLAB_ALIGNMENT 4096
+
+/// Blocks in a slab are aligned to their size, up to the slab's own alignment.
+#define _isPooled(aPool, aLength, anAlignment) ( (aLength) <= (aPool)->_maximumSize && (anAlignment) <= MIN((aPool)->_maximumSize, SLAB_ALIGNMENT) )
+
+
+typedef struct CBHPoolClass_t {
+	/// Free blocks, each holding a pointer to the next.
+	void *_freeList;
+	pthread_mutex_t _lock;
+} CBHPoolClass_t;
+
+
+#pragma mark - Size Classes
+
+static NSUInteger CBHPool_shiftForSize(size_t size)
+{
+	if ( size <= ((size_t)1 << MINIMUM_SHIFT) ) return MINIMUM_SHIFT;
+	return (NSUInteger)(64 - __builtin_clzll((unsigned long long)(size - 1)));
+}
+
+
+@implementation CBHPoolAllocator
+{
+	CBHAllocator _allocator;
+	size_t _maximumSize;
+
+	NSUInteger _classCount;
+	CBHPoolClass_t *_classes;
+
+	pthread_mutex_t _slabLock;
+	void **_slabs;
+	NSUInteger _slabCount;
+	NSUInteger _slabCapacity;
+}
+
+#pragma mark - Slabs
+
+/// Carves a new slab into blocks of `size` and returns them as a list. Returns `NULL` on failure.
+static void *CBHPool_carveSlab(CBHPoolAllocator *pool, size_t size)
+{
+	void *slab = NULL;
+	if ( posix_memalign(&slab, SLAB_ALIGNMENT, SLAB_SIZE) != 0 ) return NULL;
+
+	pthread_mutex_lock(&pool->_slabLock);
+
+	if ( pool->_slabCount >= pool->_slabCapacity )
+	{
+		const NSUInteger capacity = MAX(pool->_slabCapacity * 2, (NSUInteger)8);
+		void **slabs = CBHMemory_realloc(pool->_slabs, capacity, sizeof(void *));
+		if ( !slabs )
+		{
+			pthread_mutex_unlock(&pool->_slabLock);
+			free(slab);
+			return NULL;
+		}
+
+		pool->_slabs = slabs;
+		pool->_slabCapacity = capacity;
+	}
+
+	pool->_slabs[pool->_slabCount++] = slab;
+	pthread_mutex_unlock(&pool->_slabLock);
+
+	/// Linked back to front so blocks are handed out in address order.
+	void *list = NULL;
+	for (size_t offset = SLAB_SIZE; offset >= size; offset -= size)
+	{
+		void *block = (uint8_t *)slab + offset - size;
+		*(void **)block = list;
+		list = block;
+	}
+
+	return list;
+}
+
+
+#pragma mark - Allocator
+
+static void *CBHPool_alloc(size_t length, size_t alignment, void *context)
+{
+	CBHPoolAllocator *pool = (CBHPoolAllocator *)context;
+	if ( !_isPooled(pool, length, alignment) ) return CBHSystemAllocator.alloc(length, alignment, NULL);
+
+	const NSUInteger shift = CBHPool_shiftForSize(MAX(length, alignment));
+	CBHPoolClass_t *sizeClass = &pool->_classes[shift - MINIMUM_SHIFT];
+
+	pthread_mutex_lock(&sizeClass->_lock);
+
+	if ( !sizeClass->_freeList ) sizeClass->_freeList = CBHPool_carveSlab(pool, (size_t)1 << shift);
+
+	void *block = sizeClass->_freeList;
+	if ( block ) sizeClass->_freeList = *(void **)block;
+
+	pthread_mutex_unlock(&sizeClass->_lock);
+
+	return block;
+}
+
+static void CBHPool_free(void *data, size_t length, size_t alignment, void *context)
+{
+	CBHPoolAllocator *pool = (CBHPoolAllocator *)context;
+	if ( !_isPooled(pool, length, alignment) )
+	{
+		CBHSystemAllocator.free(data, length, alignment, NULL);
+		return;
+	}
+
+	CBHPoolClass_t *sizeClass = &pool->_classes[CBHPool_shiftForSize(MAX(length, alignment)) - MINIMUM_SHIFT];
+
+	pthread_mutex_lock(&sizeClass->_lock);
+	*(void **)data = sizeClass->_freeList;
+	sizeClass->_freeList = data;
+	pthread_mutex_unlock(&sizeClass->_lock);
+}
+
+static void *CBHPool_realloc(void *data, size_t oldLength, size_t newLength, size_t alignment, void *context)
+{
+	CBHPoolAllocator *pool = (CBHPoolAllocator *)context;
+	const BOOL wasPooled = _isPooled(pool, oldLength, alignment);
+	const BOOL isPooled = _isPooled(pool, newLength, alignment);
+
+	if ( !wasPooled && !isPooled ) return CBHSystemAllocator.realloc(data, oldLength, newLength, alignment, NULL);
+
+	/// Blocks are as large as their class, so resizing within it is free.
+	if ( wasPooled && isPooled && CBHPool_shiftForSize(MAX(oldLength, alignment)) == CBHPool_shiftForSize(MAX(newLength, alignment)) ) return data;
+
+	void *resized = CBHPool_alloc(newLength, alignment, context);
+	if ( !resized ) return NULL;
+
+	memcpy(resized, data, MIN(oldLength, newLength));
+	CBHPool_free(data, oldLength, alignment, context);
+
+	return resized;
+}
+
+
+#pragma mark - Factories
+
++ (instancetype)pool
+{
+	return [[(CBHPoolAllocator *)[self alloc] init] autorelease];
+}
+
++ (instancetype)poolWithMaximumSize:(size_t)maximumSize
+{
+	return [[(CBHPoolAllocator *)[self alloc] initWithMaximumSize:maximumSize] autorelease];
+}
+
+
+#pragma mark - Initialization
+
+- (instancetype)init
+{
+	return [self initWithMaximumSize:DEFAULT_MAXIMUM_SIZE];
+}
+
+- (instancetype)initWithMaximumSize:(size_t)maximumSize
+{
+	if ( (self = [super init]) )
+	{
+		const NSUInteger shift = CBHPool_shiftForSize(MIN(maximumSize, (size_t)SLAB_SIZE));
+
+		const NSUInteger classCount = shift - MINIMUM_SHIFT + 1;
+
+		/// Destroying the receiver only touches the classes once they are counted.
+		pthread_mutex_init(&_slabLock, NULL);
+		_classes = CBHMemory_calloc(classCount, sizeof(CBHPoolClass_t));
+		if ( !_classes )
+		{
+			[self release];
+			@throw CBHCallocException;
+		}
+
+		_maximumSize = (size_t)1 << shift;
+		_classCount = classCount;
+
+		for (NSUInteger i = 0; i < _classCount; ++i) { pthread_mutex_init(&_classes[i]._lock, NULL); }
+
+		_slabs = NULL;
+		_slabCount = 0;
+		_slabCapacity = 0;
+
+		_allocator.alloc = CBHPool_alloc;
+		_allocator.realloc = CBHPool_realloc;
+		_allocator.free = CBHPool_free;
+		_allocator.context = self;
+	}
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	for (NSUInteger i = 0; i < _slabCount; ++i) { free(_slabs[i]); }
+	CBHMemory_free(_slabs);
+
+	for (NSUInteger i = 0; i < _classCount; ++i) { pthread_mutex_destroy(&_classes[i]._lock); }
+	CBHMemory_free(_classes);
+	pthread_mutex_destroy(&_slabLock);
+
+	[super dealloc];
+}
+
+
+#pragma mark - Properties
+
+- (const CBHAllocator *)allocator
+{
+	return &_allocator;
+}
+
+- (CBHAllocationOptions)allocationOptions
+{
+	return CBHAllocationOptionsWithAllocator(&_allocator);
+}
+
+- (size_t)maximumSize
+{
+	return _maximumSize;
+}
+
+- (size_t)bytesReserved
+{
+	pthread_mutex_lock(&_slabLock);
+	const size_t reserved = _slabCount * SLAB_SIZE;
+	pthread_mutex_unlock(&_slabLock);
+
+	return reserved;
+}
+
+@end
@@ -0,0 +1,81 @@
+//  CBHThreadCacheAllocator.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import <CBHCollectionKit/CBHAllocator.h>
+#import <CBHCollectionKit/CBHAllocation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** An allocator which keeps a small cache of freed buffers for each thread in front of another allocator.
+ *
+ * Requests of up to `maximumSize` bytes are rounded up to a power-of-two size class. Freeing such a buffer puts it in the calling thread's cache and allocating takes from that cache, neither of which locks. A full cache returns half of a class to the backing allocator. A thread's cache is returned when the thread exits, or when the allocator is deallocated on that thread.
+ *
+ * @note: The backing allocator must be thread safe and outlive every thread which used this allocator. Caches are only touched by their own threads, so those of threads still running when the allocator is deallocated are returned as the threads exit or next set up a cache. These are best kept for the life of the threads using them.
+ *
+ * @author    Christian Huxtable <chris@huxtable.ca>
+ */
+@interface CBHThreadCacheAllocator : NSObject
+
+#pragma mark - Shared Allocator
+
+/** A process wide thread caching allocator in front of the system's allocator.
+ */
++ (instancetype)sharedAllocator;
+
+
+#pragma mark - Initialization
+
+/** Initializes a thread caching allocator in front of the system's allocator.
+ */
+- (instancetype)init;
+
+/** Initializes a thread caching allocator in front of `allocator`.
+ *
+ * @param allocator      The thread safe allocator buffers come from. It is copied.
+ * @param maximumSize    The size of the largest size class, rounded up to a power of two.
+ * @param depth          The number of buffers each thread keeps per size class. Must not be zero.
+ *
+ * @return               An initialized allocator.
+ */
+- (instancetype)initWithAllocator:(const CBHAllocator *)allocator maximumSize:(size_t)maximumSize depth:(NSUInteger)depth NS_DESIGNATED_INITIALIZER;
+
+
+#pragma mark - Properties
+
+/** The allocator to give collections. Valid for the life of the receiver. */
+@property (nonatomic, readonly) const CBHAllocator *allocator;
+
+/** Allocation options which allocate through the receiver. */
+@property (nonatomic, readonly) CBHAllocationOptions allocationOptions;
+
+@property (nonatomic, readonly) size_t maximumSize;
+@property (nonatomic, readonly) NSUInteger depth;
+
+
+#pragma mark - Flushing
+
+/** Returns the calling thread's cached buffers to the backing allocator.
+ */
+- (void)flush;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,289 @@
+//  CBHThreadCacheAllocator.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHThreadCacheAllocator.h"
+#import "_CBHPerThread.h"
+
+@import CBHMemoryKit;
+
+#include <stdlib.h>
+
+
+#define MINIMUM_SHIFT 4
+#define DEFAULT_MAXIMUM_SIZE (32 * 1024)
+#define DEFAULT_DEPTH 32
+#define MAXIMUM_ALIGNMENT 4096
+
+/// Cached buffers are aligned to their size class, up to a page, so any request they can hold finds them aligned.
+#define _classAlignment(aShift) MIN((size_t)1 << (aShift), (size_t)MAXIMUM_ALIGNMENT)
+#define _isCached(aShared, aLength, anAlignment) ( (aLength) <= (aShared)->_maximumSize && (anAlignment) <= MIN((aShared)->_maximumSize, (size_t)MAXIMUM_ALIGNMENT) )
+
+#define _bufferAt(aCache, anIndex, aPosition) (aCache)->_buffers[((anIndex) * (aCache)->_shared->_depth) + (aPosition)]
+
+
+/// State shared by the allocator and its threads' caches.
+typedef struct CBHThreadCacheShared_t {
+	CBHPerThread_t _perThread;
+
+	CBHAllocator _backing;
+	size_t _maximumSize;
+	NSUInteger _classCount;
+	NSUInteger _depth;
+} CBHThreadCacheShared_t;
+
+typedef struct CBHThreadCache_t {
+	CBHPerThreadEntry_t _entry;
+	CBHThreadCacheShared_t *_shared;
+
+	/// The number of buffers held in each class.
+	NSUInteger *_counts;
+
+	/// `_depth` buffers for each class.
+	void **_buffers;
+} CBHThreadCache_t;
+
+
+#pragma mark - Size Classes
+
+static NSUInteger CBHThreadCache_shiftForSize(size_t size)
+{
+	if ( size <= ((size_t)1 << MINIMUM_SHIFT) ) return MINIMUM_SHIFT;
+	return (NSUInteger)(64 - __builtin_clzll((unsigned long long)(size - 1)));
+}
+
+
+#pragma mark - Caches
+
+/// Returns buffers of class `index` to the backing allocator until `keep` remain.
+static void CBHThreadCache_trim(CBHThreadCache_t *cache, NSUInteger index, NSUInteger keep)
+{
+	const CBHAllocator *backing = &cache->_shared->_backing;
+	const NSUInteger shift = index + MINIMUM_SHIFT;
+
+	while ( cache->_counts[index] > keep )
+	{
+		void *buffer = _bufferAt(cache, index, --cache->_counts[index]);
+		backing->free(buffer, (size_t)1 << shift, _classAlignment(shift), backing->context);
+	}
+}
+
+static void CBHThreadCache_flush(CBHThreadCache_t *cache)
+{
+	for (NSUInteger i = 0; i < cache->_shared->_classCount; ++i) { CBHThreadCache_trim(cache, i, 0); }
+}
+
+static void CBHThreadCache_retire(CBHPerThreadEntry_t *entry)
+{
+	CBHThreadCache_flush((CBHThreadCache_t *)entry);
+}
+
+static void CBHThreadCacheShared_free(CBHPerThread_t *perThread)
+{
+	free(perThread);
+}
+
+/// The calling thread's cache, created on first use. Returns `NULL` if it could not be created.
+static CBHThreadCache_t *CBHThreadCache_current(CBHThreadCacheShared_t *shared)
+{
+	CBHThreadCache_t *cache = (CBHThreadCache_t *)CBHPerThread_current(&shared->_perThread);
+	if ( !cache || cache->_counts ) return cache;
+
+	/// Fresh caches are zeroed, the classes follow the cache itself.
+	cache->_shared = shared;
+	cache->_counts = (NSUInteger *)(cache + 1);
+	cache->_buffers = (void **)((uint8_t *)cache->_counts + (shared->_classCount * sizeof(NSUInteger)));
+
+	return cache;
+}
+
+
+#pragma mark - Allocator
+
+static void *CBHThreadCache_alloc(size_t length, size_t alignment, void *context)
+{
+	CBHThreadCacheShared_t *shared = context;
+	const CBHAllocator *backing = &shared->_backing;
+
+	if ( !_isCached(shared, length, alignment) ) return backing->alloc(length, alignment, backing->context);
+
+	const NSUInteger shift = CBHThreadCache_shiftForSize(MAX(length, alignment));
+	const NSUInteger index = shift - MINIMUM_SHIFT;
+
+	CBHThreadCache_t *cache = CBHThreadCache_current(shared);
+	if ( cache && cache->_counts[index] > 0 ) return _bufferAt(cache, index, --cache->_counts[index]);
+
+	return backing->alloc((size_t)1 << shift, _classAlignment(shift), backing->context);
+}
+
+static void CBHThreadCache_free(void *data, size_t length, size_t alignment, void *context)
+{
+	CBHThreadCacheShared_t *shared = context;
+	const CBHAllocator *backing = &shared->_backing;
+
+	if ( !_isCached(shared, length, alignment) )
+	{
+		backing->free(data, length, alignment, backing->context);
+		return;
+	}
+
+	const NSUInteger shift = CBHThreadCache_shiftForSize(MAX(length, alignment));
+	const NSUInteger index = shift - MINIMUM_SHIFT;
+
+	CBHThreadCache_t *cache = CBHThreadCache_current(shared);
+	if ( !cache )
+	{
+		backing->free(data, (size_t)1 << shift, _classAlignment(shift), backing->context);
+		return;
+	}
+
+	/// Half is kept so a thread alternating between allocating and freeing doesn't thrash.
+	if ( cache->_counts[index] >= shared->_depth ) CBHThreadCache_trim(cache, index, shared->_depth / 2);
+
+	_bufferAt(cache, index, cache->_counts[index]++) = data;
+}
+
+static void *CBHThreadCache_realloc(void *data, size_t oldLength, size_t newLength, size_t alignment, void *context)
+{
+	CBHThreadCacheShared_t *shared = context;
+	const BOOL wasCached = _isCached(shared, oldLength, alignment);
+	const BOOL isCached = _isCached(shared, newLength, alignment);
+
+	if ( !wasCached && !isCached ) return shared->_backing.realloc(data, oldLength, newLength, alignment, shared->_backing.context);
+
+	/// Buffers are as large as their class, so resizing within it is free.
+	if ( wasCached && isCached && CBHThreadCache_shiftForSize(MAX(oldLength, alignment)) == CBHThreadCache_shiftForSize(MAX(newLength, alignment)) ) return data;
+
+	void *resized = CBHThreadCache_alloc(newLength, alignment, context);
+	if ( !resized ) return NULL;
+
+	memcpy(resized, data, MIN(oldLength, newLength));
+	CBHThreadCache_free(data, oldLength, alignment, context);
+
+	return resized;
+}
+
+
+@implementation CBHThreadCacheAllocator
+{
+	CBHAllocator _allocator;
+	CBHThreadCacheShared_t *_shared;
+}
+
+#pragma mark - Shared Allocator
+
++ (instancetype)sharedAllocator
+{
+	static CBHThreadCacheAllocator *sharedAllocator = nil;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		sharedAllocator = [[CBHThreadCacheAllocator alloc] init];
+	});
+
+	return sharedAllocator;
+}
+
+
+#pragma mark - Initialization
+
+- (instancetype)init
+{
+	return [self initWithAllocator:&CBHSystemAllocator maximumSize:DEFAULT_MAXIMUM_SIZE depth:DEFAULT_DEPTH];
+}
+
+- (instancetype)initWithAllocator:(const CBHAllocator *)allocator maximumSize:(size_t)maximumSize depth:(NSUInteger)depth
+{
+	if ( depth <= 0 )
+	{
+		[self release];
+		@throw NSInvalidArgumentException;
+	}
+
+	if ( (self = [super init]) )
+	{
+		CBHThreadCacheShared_t *shared = calloc(1, sizeof(CBHThreadCacheShared_t));
+		if ( !shared )
+		{
+			[self release];
+			@throw CBHCallocException;
+		}
+
+		const NSUInteger shift = CBHThreadCache_shiftForSize(MIN(maximumSize, (size_t)1 << 30));
+
+		shared->_backing = *allocator;
+		shared->_maximumSize = (size_t)1 << shift;
+		shared->_classCount = shift - MINIMUM_SHIFT + 1;
+		shared->_depth = depth;
+
+		const size_t cacheLength = sizeof(CBHThreadCache_t) + (shared->_classCount * sizeof(NSUInteger)) + (shared->_classCount * depth * sizeof(void *));
+		CBHPerThread_init(&shared->_perThread, cacheLength, (CBHPerThreadCallbacks){CBHThreadCache_retire, CBHThreadCacheShared_free});
+
+		_shared = shared;
+
+		_allocator.alloc = CBHThreadCache_alloc;
+		_allocator.realloc = CBHThreadCache_realloc;
+		_allocator.free = CBHThreadCache_free;
+		_allocator.context = shared;
+	}
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	/// Only the calling thread's cache is returned here, other threads return theirs.
+	if ( _shared ) CBHPerThread_close(&_shared->_perThread);
+
+	[super dealloc];
+}
+
+
+#pragma mark - Properties
+
+- (const CBHAllocator *)allocator
+{
+	return &_allocator;
+}
+
+- (CBHAllocationOptions)allocationOptions
+{
+	return CBHAllocationOptionsWithAllocator(&_allocator);
+}
+
+- (size_t)maximumSize
+{
+	return _shared->_maximumSize;
+}
+
+- (NSUInteger)depth
+{
+	return _shared->_depth;
+}
+
+
+#pragma mark - Flushing
+
+- (void)flush
+{
+	CBHThreadCache_t *cache = (CBHThreadCache_t *)CBHPerThread_existing(&_shared->_perThread);
+	if ( cache ) CBHThreadCache_flush(cache);
+}
+
+@end
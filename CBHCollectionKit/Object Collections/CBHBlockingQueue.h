@@ -0,0 +1,134 @@
+//  CBHBlockingQueue.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import <CBHCollectionKit/CBHCollection.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** A bounded first-in-first-out collection of objects for passing work between threads.
+ *
+ * A Blocking Queue holds at most `capacity` objects. Producers wait while it is full and consumers wait while it is empty, either indefinitely or until a timeout.
+ *
+ * Waiting consumers are only signalled when the queue goes from empty to non-empty, and waiting producers when it goes from full to not full. A woken thread passes the wakeup on to the next if objects, or space, remain. So no wakeup is lost and no thread is woken without something to do.
+ *
+ * Closing the queue refuses further objects and wakes every waiting thread. Consumers still receive the objects already queued, then `nil`.
+ *
+ * Objects are retained when enqueued and autoreleased when dequeued, as with `CBHQueue`.
+ *
+ * @author    Christian Huxtable <chris@huxtable.ca>
+ */
+@interface CBHBlockingQueue<ObjectType> : NSObject <CBHCollection>
+
+#pragma mark - Factories
+
++ (instancetype)blockingQueueWithCapacity:(NSUInteger)capacity;
+
+
+#pragma mark - Initialization
+
+/** Initializes an empty, open blocking queue.
+ *
+ * @param capacity    The most objects the queue holds at once. Must be at least 1.
+ *
+ * @return            An initialized empty blocking queue.
+ */
+- (instancetype)initWithCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+
+
+#pragma mark - Properties
+
+@property (nonatomic, readonly) NSUInteger count;
+@property (nonatomic, readonly) NSUInteger capacity;
+@property (nonatomic, readonly) BOOL isEmpty;
+@property (nonatomic, readonly) BOOL isClosed;
+
+
+#pragma mark - Description
+
+- (NSString *)description;
+- (NSString *)debugDescription;
+
+
+#pragma mark - Addition
+
+/** Adds an object to the tail of the receiver, waiting for as long as the receiver is full.
+ *
+ * @param object    The object to add.
+ *
+ * @return          `YES` if the object was added, `NO` if the receiver is closed.
+ */
+- (BOOL)enqueueObject:(ObjectType)object;
+
+/** Adds an object to the tail of the receiver, waiting at most `timeout` seconds for space.
+ *
+ * @param object     The object to add.
+ * @param timeout    The longest time to wait. A timeout of zero or less doesn't wait.
+ *
+ * @return           `YES` if the object was added, `NO` if the time ran out or the receiver is closed.
+ */
+- (BOOL)enqueueObject:(ObjectType)object timeout:(NSTimeInterval)timeout;
+
+
+#pragma mark - Subtraction
+
+/** Removes and returns the object at the head of the receiver, waiting for as long as the receiver is empty.
+ *
+ * @return    The object at the head, or `nil` once the receiver is closed and empty.
+ */
+- (nullable ObjectType)dequeueObject;
+
+/** Removes and returns the object at the head of the receiver, waiting at most `timeout` seconds for one.
+ *
+ * @param timeout    The longest time to wait. A timeout of zero or less doesn't wait.
+ *
+ * @return           The object at the head, or `nil` if the time ran out or the receiver is closed and empty.
+ */
+- (nullable ObjectType)dequeueObjectWithTimeout:(NSTimeInterval)timeout;
+
+/** Moves every available object, up to `max`, to the end of `array` under a single acquisition of the lock. Doesn't wait.
+ *
+ * @param array    The array to add the objects to, in queue order.
+ * @param max      The most objects to move.
+ *
+ * @return         The number of objects moved.
+ */
+- (NSUInteger)drainTo:(NSMutableArray<ObjectType> *)array max:(NSUInteger)max;
+
+
+#pragma mark - Closing
+
+/** Refuses any further objects and wakes every waiting thread. Objects already queued can still be dequeued. */
+- (void)close;
+
+/** Closes the receiver and removes the objects still queued.
+ *
+ * @return    The objects which were never dequeued, in queue order.
+ */
+- (NSArray<ObjectType> *)shutdown;
+
+
+#pragma mark - Unavailable
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,338 @@
+//  CBHBlockingQueue.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHBlockingQueue.h"
+#import "_CBHQueue.h"
+
+@import CBHMemoryKit;
+
+#include <errno.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+
+#define _pointerAtIndex(aQueue, anIndex) CBHQueue_pointerAtIndex((aQueue), (anIndex))
+#define _objectAtIndex(aQueue, anIndex) ((id)_pointerAtIndex((aQueue), (anIndex)))
+
+#define _isFull() ( _queue._count >= _queue._capacity )
+
+
+#pragma mark - Waiting
+
+/// Converts a relative timeout into the absolute time `pthread_cond_timedwait()` expects.
+static struct timespec CBHBlockingQueue_deadline(NSTimeInterval timeout)
+{
+	struct timeval now;
+	gettimeofday(&now, NULL);
+
+	const double seconds = ( timeout > 0.0 ) ? timeout : 0.0;
+	const long long nanoseconds = (long long)now.tv_usec * 1000 + (long long)((seconds - floor(seconds)) * 1e9);
+
+	struct timespec deadline;
+	deadline.tv_sec = now.tv_sec + (time_t)floor(seconds) + (time_t)(nanoseconds / 1000000000);
+	deadline.tv_nsec = (long)(nanoseconds % 1000000000);
+
+	return deadline;
+}
+
+/// Waits on `condition`, counted among its waiters. Returns `NO` once the deadline passes, a `NULL` deadline never does.
+static BOOL CBHBlockingQueue_wait(pthread_cond_t *condition, pthread_mutex_t *lock, NSUInteger *waiters, const struct timespec *deadline)
+{
+	++(*waiters);
+	const int result = ( deadline ) ? pthread_cond_timedwait(condition, lock, deadline) : pthread_cond_wait(condition, lock);
+	--(*waiters);
+
+	return ( result != ETIMEDOUT );
+}
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface CBHBlockingQueue<ObjectType> ()
+{
+	CBHQueue_t _queue;
+
+	pthread_mutex_t _lock;
+	pthread_cond_t _notEmpty;
+	pthread_cond_t _notFull;
+
+	NSUInteger _waitingConsumers;
+	NSUInteger _waitingProducers;
+
+	BOOL _isClosed;
+}
+
+
+#pragma mark - Private Waiting
+
+- (BOOL)enqueueObject:(ObjectType)object deadline:(const struct timespec * _Nullable)deadline;
+- (nullable ObjectType)dequeueObjectWithDeadline:(const struct timespec * _Nullable)deadline;
+
+/// Signals whoever the removal of `removed` objects may have unblocked. Must be called with the lock held.
+- (void)signalAfterRemoving:(NSUInteger)removed;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+@implementation CBHBlockingQueue
+
+#pragma mark - Factories
+
++ (instancetype)blockingQueueWithCapacity:(NSUInteger)capacity
+{
+	return [[(CBHBlockingQueue *)[self alloc] initWithCapacity:capacity] autorelease];
+}
+
+
+#pragma mark - Initialization
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+{
+	if ( capacity < 1 )
+	{
+		[self release];
+		@throw NSInvalidArgumentException;
+	}
+
+	if ( (self = [super init]) )
+	{
+		/// The ring is never grown, producers wait instead.
+		_queue = CBHQueue_init(capacity, sizeof(id));
+
+		pthread_mutex_init(&_lock, NULL);
+		pthread_cond_init(&_notEmpty, NULL);
+		pthread_cond_init(&_notFull, NULL);
+	}
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	/// Release stored objects.
+	for (NSUInteger i = 0; i < _queue._count; ++i) { CFRelease(_pointerAtIndex(&_queue, i)); }
+	CBHQueue_dealloc(&_queue);
+
+	pthread_cond_destroy(&_notFull);
+	pthread_cond_destroy(&_notEmpty);
+	pthread_mutex_destroy(&_lock);
+
+	[super dealloc];
+}
+
+
+#pragma mark - Properties
+
+- (NSUInteger)count
+{
+	pthread_mutex_lock(&_lock);
+	const NSUInteger count = _queue._count;
+	pthread_mutex_unlock(&_lock);
+
+	return count;
+}
+
+- (NSUInteger)capacity
+{
+	return _queue._capacity;
+}
+
+- (BOOL)isEmpty
+{
+	return ( [self count] <= 0 );
+}
+
+- (BOOL)isClosed
+{
+	pthread_mutex_lock(&_lock);
+	const BOOL isClosed = _isClosed;
+	pthread_mutex_unlock(&_lock);
+
+	return isClosed;
+}
+
+
+#pragma mark - Description
+
+- (NSString *)description
+{
+	NSMutableString *description = [NSMutableString stringWithString:@"("];
+
+	pthread_mutex_lock(&_lock);
+
+	for (NSUInteger i = 0; i < _queue._count; ++i)
+	{
+		if ( i > 0 ) { [description appendFormat:@",\n\t%@", _objectAtIndex(&_queue, i)]; }
+		else { [description appendFormat:@"\n\t%@", _objectAtIndex(&_queue, i)]; }
+	}
+
+	pthread_mutex_unlock(&_lock);
+
+	return [NSString stringWithFormat:@"%@\n)", description];
+}
+
+- (NSString *)debugDescription
+{
+	NSString *properties = [NSString stringWithFormat:@"{\n\tcapacity: %lu,\n\tcount: %lu,\n\tisClosed: %@\n},\n", [self capacity], [self count], [self isClosed] ? @"YES" : @"NO"];
+	return [NSString stringWithFormat:@"<%@: %p>\n%@%@", [self class], (void *)self, properties, [self description]];
+}
+
+
+#pragma mark - Addition
+
+- (BOOL)enqueueObject:(id)object
+{
+	return [self enqueueObject:object deadline:NULL];
+}
+
+- (BOOL)enqueueObject:(id)object timeout:(NSTimeInterval)timeout
+{
+	const struct timespec deadline = CBHBlockingQueue_deadline(timeout);
+	return [self enqueueObject:object deadline:&deadline];
+}
+
+
+#pragma mark - Subtraction
+
+- (id)dequeueObject
+{
+	return [self dequeueObjectWithDeadline:NULL];
+}
+
+- (id)dequeueObjectWithTimeout:(NSTimeInterval)timeout
+{
+	const struct timespec deadline = CBHBlockingQueue_deadline(timeout);
+	return [self dequeueObjectWithDeadline:&deadline];
+}
+
+- (NSUInteger)drainTo:(NSMutableArray *)array max:(NSUInteger)max
+{
+	pthread_mutex_lock(&_lock);
+
+	const NSUInteger count = MIN(max, _queue._count);
+	for (NSUInteger i = 0; i < count; ++i)
+	{
+		id object = (id)CBHQueue_dequeue(&_queue);
+		[array addObject:object];
+		[object release];
+	}
+
+	[self signalAfterRemoving:count];
+	pthread_mutex_unlock(&_lock);
+
+	return count;
+}
+
+
+#pragma mark - Closing
+
+- (void)close
+{
+	pthread_mutex_lock(&_lock);
+
+	_isClosed = YES;
+
+	/// Every waiter must see the queue is closed.
+	pthread_cond_broadcast(&_notEmpty);
+	pthread_cond_broadcast(&_notFull);
+
+	pthread_mutex_unlock(&_lock);
+}
+
+- (NSArray *)shutdown
+{
+	[self close];
+
+	NSMutableArray *remaining = [NSMutableArray array];
+	[self drainTo:remaining max:NSUIntegerMax];
+
+	return remaining;
+}
+
+
+#pragma mark - Private Waiting
+
+- (BOOL)enqueueObject:(id)object deadline:(const struct timespec *)deadline
+{
+	pthread_mutex_lock(&_lock);
+
+	/// A timed out wait still takes space which opened up in the meantime.
+	while ( !_isClosed && _isFull() )
+	{
+		if ( !CBHBlockingQueue_wait(&_notFull, &_lock, &_waitingProducers, deadline) ) break;
+	}
+
+	if ( _isClosed || _isFull() )
+	{
+		pthread_mutex_unlock(&_lock);
+		return NO;
+	}
+
+	[object retain];
+	CBHQueue_enqueue(&_queue, &object);
+
+	/// Consumers only wait on an empty queue, so only the first object can have one to wake.
+	if ( _queue._count == 1 && _waitingConsumers > 0 ) pthread_cond_signal(&_notEmpty);
+
+	/// Pass a wakeup on to the next producer while there is still space.
+	if ( !_isFull() && _waitingProducers > 0 ) pthread_cond_signal(&_notFull);
+
+	pthread_mutex_unlock(&_lock);
+	return YES;
+}
+
+- (id)dequeueObjectWithDeadline:(const struct timespec *)deadline
+{
+	pthread_mutex_lock(&_lock);
+
+	/// A timed out wait still takes an object which arrived in the meantime.
+	while ( !_isClosed && _queue._count <= 0 )
+	{
+		if ( !CBHBlockingQueue_wait(&_notEmpty, &_lock, &_waitingConsumers, deadline) ) break;
+	}
+
+	if ( _queue._count <= 0 )
+	{
+		pthread_mutex_unlock(&_lock);
+		return nil;
+	}
+
+	id object = (id)CBHQueue_dequeue(&_queue);
+	[self signalAfterRemoving:1];
+
+	pthread_mutex_unlock(&_lock);
+	return [object autorelease];
+}
+
+- (void)signalAfterRemoving:(NSUInteger)removed
+{
+	if ( removed <= 0 ) return;
+
+	/// Producers only wait on a full queue, so only the first space can have one to wake.
+	if ( _queue._count + removed == _queue._capacity && _waitingProducers > 0 ) pthread_cond_signal(&_notFull);
+
+	/// Pass a wakeup on to the next consumer while there are still objects.
+	if ( _queue._count > 0 && _waitingConsumers > 0 ) pthread_cond_signal(&_notEmpty);
+}
+
+@end
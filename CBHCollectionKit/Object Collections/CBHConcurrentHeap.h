@@ -0,0 +1,132 @@
+//  CBHConcurrentHeap.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import <CBHCollectionKit/CBHCollection.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** A priority queue of objects which many threads can insert into and extract from at once.
+ *
+ * A Concurrent Heap is a MultiQueue: its objects are spread over several independently locked heaps, called shards, ordered by the same comparator as `CBHHeap`. Each insertion goes to a random shard. Each extraction locks two random shards and takes the better of their two minimums.
+ *
+ * Extraction is relaxed, it returns an object close to the minimum rather than always the minimum. With `n` shards the expected rank of an extracted object, the number of objects remaining which the comparator orders before it, is `O(n)`, and it is `O(n log n)` with high probability. A single shard is an exact, if serialized, priority queue.
+ *
+ * @note: `count`, `capacity`, and `isEmpty` are snapshots and may be stale by the time they return when other threads are mutating the heap.
+ *
+ * @author    Christian Huxtable <chris@huxtable.ca>
+ */
+@interface CBHConcurrentHeap<ObjectType> : NSObject <CBHCollection>
+
+#pragma mark - Factories
+
++ (instancetype)concurrentHeapWithComparator:(NSComparator)comparator;
++ (instancetype)concurrentHeapWithComparator:(NSComparator)comparator shardCount:(NSUInteger)shardCount;
+
+
+#pragma mark - Initialization
+
+/** Initializes an empty concurrent heap with two shards for every active processor.
+ *
+ * @param comparator    The comparator which orders the heap.
+ *
+ * @return              An initialized empty concurrent heap.
+ */
+- (instancetype)initWithComparator:(NSComparator)comparator;
+
+/** Initializes an empty concurrent heap.
+ *
+ * More shards reduce contention between threads but loosen the ordering of extractions. Two shards for every thread using the heap is a good balance.
+ *
+ * @param comparator    The comparator which orders the heap.
+ * @param shardCount    The number of independently locked heaps to spread objects over. Must be at least 1.
+ *
+ * @return              An initialized empty concurrent heap.
+ */
+- (instancetype)initWithComparator:(NSComparator)comparator shardCount:(NSUInteger)shardCount NS_DESIGNATED_INITIALIZER;
+
+
+#pragma mark - Properties
+
+@property (nonatomic, readonly) NSComparator comparator;
+@property (nonatomic, readonly) NSUInteger shardCount;
+
+@property (nonatomic, readonly) NSUInteger count;
+@property (nonatomic, readonly) NSUInteger capacity;
+@property (nonatomic, readonly) BOOL isEmpty;
+
+
+#pragma mark - Description
+
+- (NSString *)description;
+- (NSString *)debugDescription;
+
+
+#pragma mark - Conversion
+
+/** Returns the objects of the receiver in the order defined by the comparator.
+ *
+ * Every shard is locked while the objects are gathered, so the array is an exact snapshot.
+ *
+ * @return    An array of the receiver's objects.
+ */
+- (NSArray<ObjectType> *)array;
+
+
+#pragma mark - Addition
+
+- (void)insertObject:(ObjectType)object;
+
+/** Inserts a batch of objects, each into its own random shard as by `insertObject:`, taking each chosen shard's lock once.
+ *
+ * @param objects    A C array of objects to insert.
+ * @param count      The number of objects in `objects`.
+ */
+- (void)insertObjects:(const ObjectType _Nonnull [_Nonnull])objects count:(NSUInteger)count;
+
+
+#pragma mark - Subtraction
+
+/** Removes and returns an object close to the minimum of the receiver.
+ *
+ * @return    An object whose rank is bounded as described above, or `nil` if the receiver is empty.
+ */
+- (nullable ObjectType)extractObject;
+
+/** Removes up to `count` objects from the better of two random shards, taking its lock once.
+ *
+ * The objects are in order relative to each other and the first is bounded as for `extractObject`. The rest come from the same shard, so the `k`-th object's rank can be around `k` times the shard count.
+ *
+ * @param count    The maximum number of objects to remove.
+ *
+ * @return         The removed objects. Empty if the receiver is empty.
+ */
+- (NSArray<ObjectType> *)extractObjects:(NSUInteger)count;
+
+- (void)removeAllObjects;
+
+
+#pragma mark - Unavailable
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
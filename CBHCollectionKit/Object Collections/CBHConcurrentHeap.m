@@ -0,0 +1,462 @@
+//  CBHConcurrentHeap.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHConcurrentHeap.h"
+#import "_CBHHeap.h"
+
+@import CBHMemoryKit;
+
+#include <stdlib.h>
+#include <pthread.h>
+
+
+#define SHARDS_PER_PROCESSOR 2
+#define SHARD_CAPACITY 64
+
+/// Shards are padded apart so locking one never invalidates a neighbour's cache line.
+#define SHARD_ALIGNMENT 128
+
+#define _publishCount(aShard) __atomic_store_n(&(aShard)->_count, (aShard)->_heap._count, __ATOMIC_RELAXED)
+#define _countOf(aShard) __atomic_load_n(&(aShard)->_count, __ATOMIC_RELAXED)
+#define _peekObject(aShard) ((id)CBHQueue_peek(&(aShard)->_heap))
+
+
+typedef struct CBHConcurrentHeapShard_t {
+	pthread_mutex_t _lock;
+	CBHQueue_t _heap;
+
+	/// Mirrors `_heap._count` so other threads can skip empty shards without taking the lock.
+	NSUInteger _count;
+} __attribute__((aligned(SHARD_ALIGNMENT))) CBHConcurrentHeapShard_t;
+
+
+#pragma mark - Random Choice
+
+/// Each thread draws from its own xorshift state, so choosing a shard touches no shared memory.
+static __thread uint64_t CBHConcurrentHeap_state = 0;
+
+static inline NSUInteger CBHConcurrentHeap_random(NSUInteger bound)
+{
+	uint64_t state = CBHConcurrentHeap_state;
+	if ( state == 0 ) state = ((uint64_t)(uintptr_t)pthread_self() * 0x9e3779b97f4a7c15ull) | 1;
+
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+
+	CBHConcurrentHeap_state = state;
+	return (NSUInteger)(state % bound);
+}
+
+
+#pragma mark - Locking
+
+/// Blocks only when asked to, so a busy shard can be passed over for another.
+static inline BOOL CBHConcurrentHeap_lockShard(CBHConcurrentHeapShard_t *shard, BOOL shouldBlock)
+{
+	if ( shouldBlock ) return ( pthread_mutex_lock(&shard->_lock) == 0 );
+	return ( pthread_mutex_trylock(&shard->_lock) == 0 );
+}
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface CBHConcurrentHeap<ObjectType> ()
+{
+	CBHConcurrentHeapShard_t *_shards;
+	NSUInteger _shardCount;
+	NSComparator _comparator;
+}
+
+
+#pragma mark - Private Shard Selection
+
+/// Locks and returns a random shard, preferring one which isn't busy.
+- (CBHConcurrentHeapShard_t *)lockRandomShard;
+
+/// Locks and returns the non-empty shard with the better minimum of two random choices, or `NULL` if every shard is empty.
+- (nullable CBHConcurrentHeapShard_t *)lockBestShard;
+
+/// Locks and returns the first non-empty shard from a random starting point, or `NULL` if every shard is empty.
+- (nullable CBHConcurrentHeapShard_t *)lockAnyShard;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+@implementation CBHConcurrentHeap
+
+#pragma mark - Factories
+
++ (instancetype)concurrentHeapWithComparator:(NSComparator)comparator
+{
+	return [[(CBHConcurrentHeap *)[self alloc] initWithComparator:comparator] autorelease];
+}
+
++ (instancetype)concurrentHeapWithComparator:(NSComparator)comparator shardCount:(NSUInteger)shardCount
+{
+	return [[(CBHConcurrentHeap *)[self alloc] initWithComparator:comparator shardCount:shardCount] autorelease];
+}
+
+
+#pragma mark - Initialization
+
+- (instancetype)initWithComparator:(NSComparator)comparator
+{
+	return [self initWithComparator:comparator shardCount:SHARDS_PER_PROCESSOR * [[NSProcessInfo processInfo] activeProcessorCount]];
+}
+
+- (instancetype)initWithComparator:(NSComparator)comparator shardCount:(NSUInteger)shardCount
+{
+	if ( shardCount < 1 )
+	{
+		[self release];
+		@throw NSInvalidArgumentException;
+	}
+
+	if ( (self = [super init]) )
+	{
+		void *shards = NULL;
+		if ( posix_memalign(&shards, SHARD_ALIGNMENT, shardCount * sizeof(CBHConcurrentHeapShard_t)) != 0 )
+		{
+			[self release];
+			@throw CBHCallocException;
+		}
+
+		_shards = (CBHConcurrentHeapShard_t *)shards;
+		_shardCount = shardCount;
+		_comparator = [comparator copy];
+
+		for (NSUInteger i = 0; i < _shardCount; ++i)
+		{
+			pthread_mutex_init(&_shards[i]._lock, NULL);
+			_shards[i]._heap = CBHQueue_init(SHARD_CAPACITY, sizeof(id));
+			_shards[i]._count = 0;
+		}
+	}
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	[self removeAllObjects];
+
+	for (NSUInteger i = 0; i < _shardCount; ++i)
+	{
+		CBHQueue_dealloc(&_shards[i]._heap);
+		pthread_mutex_destroy(&_shards[i]._lock);
+	}
+
+	free(_shards);
+	[_comparator release];
+
+	[super dealloc];
+}
+
+
+#pragma mark - Properties
+
+@synthesize comparator = _comparator;
+@synthesize shardCount = _shardCount;
+
+- (NSUInteger)count
+{
+	NSUInteger count = 0;
+	for (NSUInteger i = 0; i < _shardCount; ++i) { count += _countOf(&_shards[i]); }
+
+	return count;
+}
+
+- (NSUInteger)capacity
+{
+	NSUInteger capacity = 0;
+	for (NSUInteger i = 0; i < _shardCount; ++i)
+	{
+		pthread_mutex_lock(&_shards[i]._lock);
+		capacity += _shards[i]._heap._capacity;
+		pthread_mutex_unlock(&_shards[i]._lock);
+	}
+
+	return capacity;
+}
+
+- (BOOL)isEmpty
+{
+	for (NSUInteger i = 0; i < _shardCount; ++i)
+	{
+		if ( _countOf(&_shards[i]) > 0 ) return NO;
+	}
+
+	return YES;
+}
+
+
+#pragma mark - Description
+
+- (NSString *)description
+{
+	NSMutableString *description = [NSMutableString stringWithString:@"("];
+
+	BOOL firstLoop = YES;
+	for (id object in [self array])
+	{
+		if ( !firstLoop ) { [description appendFormat:@",\n\t%@", object]; }
+		else
+		{
+			[description appendFormat:@"\n\t%@", object];
+			firstLoop = NO;
+		}
+	}
+	return [NSString stringWithFormat:@"%@\n)", description];
+}
+
+- (NSString *)debugDescription
+{
+	NSString *properties = [NSString stringWithFormat:@"{\n\tshardCount: %lu,\n\tcount: %lu\n},\n", _shardCount, [self count]];
+	return [NSString stringWithFormat:@"<%@: %p>\n%@%@", [self class], (void *)self, properties, [self description]];
+}
+
+
+#pragma mark - Conversion
+
+- (NSArray *)array
+{
+	/// Shards are always locked in index order, so two snapshots can't deadlock.
+	for (NSUInteger i = 0; i < _shardCount; ++i) { pthread_mutex_lock(&_shards[i]._lock); }
+
+	NSMutableArray *array = [NSMutableArray arrayWithCapacity:[self count]];
+	for (NSUInteger i = 0; i < _shardCount; ++i)
+	{
+		const CBHQueue_t *heap = &_shards[i]._heap;
+		for (NSUInteger j = 0; j < heap->_count; ++j) { [array addObject:(id)CBHQueue_pointerAtIndex(heap, j)]; }
+	}
+
+	for (NSUInteger i = 0; i < _shardCount; ++i) { pthread_mutex_unlock(&_shards[i]._lock); }
+
+	[array sortUsingComparator:_comparator];
+	return [NSArray arrayWithArray:array];
+}
+
+
+#pragma mark - Addition
+
+- (void)insertObject:(id)object
+{
+	[object retain];
+
+	CBHConcurrentHeapShard_t *shard = [self lockRandomShard];
+	CBHHeap_insertValue(&shard->_heap, &object, _comparator);
+	_publishCount(shard);
+	pthread_mutex_unlock(&shard->_lock);
+}
+
+- (void)insertObjects:(const id [])objects count:(NSUInteger)count
+{
+	if ( count <= 0 ) return;
+
+	/// Each object still goes to its own random shard, so the batch keeps the rank bound. Grouping them by shard takes each lock once.
+	NSUInteger *offsets = CBHMemory_calloc(_shardCount + 1, sizeof(NSUInteger));
+	NSUInteger *shardOf = CBHMemory_alloc(count, sizeof(NSUInteger));
+	id __unsafe_unretained *grouped = CBHMemory_alloc(count, sizeof(id));
+	if ( !offsets || !shardOf || !grouped )
+	{
+		free(offsets);
+		free(shardOf);
+		free(grouped);
+		@throw CBHCallocException;
+	}
+
+	for (NSUInteger i = 0; i < count; ++i)
+	{
+		shardOf[i] = CBHConcurrentHeap_random(_shardCount);
+		++offsets[shardOf[i] + 1];
+	}
+
+	for (NSUInteger i = 0; i < _shardCount; ++i) { offsets[i + 1] += offsets[i]; }
+
+	/// Fills each group from its start, leaving `offsets[i]` at the end of group `i`.
+	for (NSUInteger i = 0; i < count; ++i) { grouped[offsets[shardOf[i]]++] = [objects[i] retain]; }
+	free(shardOf);
+
+	NSUInteger start = 0;
+	for (NSUInteger i = 0; i < _shardCount; ++i)
+	{
+		const NSUInteger end = offsets[i];
+		if ( end <= start ) continue;
+
+		CBHConcurrentHeapShard_t *shard = &_shards[i];
+		pthread_mutex_lock(&shard->_lock);
+		for (NSUInteger j = start; j < end; ++j) { CBHHeap_insertValue(&shard->_heap, &grouped[j], _comparator); }
+		_publishCount(shard);
+		pthread_mutex_unlock(&shard->_lock);
+
+		start = end;
+	}
+
+	free(offsets);
+	free(grouped);
+}
+
+
+#pragma mark - Subtraction
+
+- (id)extractObject
+{
+	CBHConcurrentHeapShard_t *shard = [self lockBestShard];
+	if ( !shard ) return nil;
+
+	id object = (id)CBHHeap_extractValue(&shard->_heap, _comparator);
+	_publishCount(shard);
+	pthread_mutex_unlock(&shard->_lock);
+
+	return [object autorelease];
+}
+
+- (NSArray *)extractObjects:(NSUInteger)count
+{
+	/// Catch trivial empty case.
+	if ( count == 0 ) { return @[]; }
+
+	CBHConcurrentHeapShard_t *shard = [self lockBestShard];
+	if ( !shard ) return @[];
+
+	const NSUInteger extracted = MIN(count, shard->_heap._count);
+
+	/// Store entries on the heap temporarily, the count is the caller's.
+	id __unsafe_unretained *array = CBHMemory_alloc(extracted, sizeof(id));
+	if ( !array )
+	{
+		pthread_mutex_unlock(&shard->_lock);
+		@throw CBHCallocException;
+	}
+
+	for (NSUInteger i = 0; i < extracted; ++i) { array[i] = (id)CBHHeap_extractValue(&shard->_heap, _comparator); }
+
+	_publishCount(shard);
+	pthread_mutex_unlock(&shard->_lock);
+
+	/// Load entries into `NSArray`, which takes over the references.
+	NSArray *objects = [NSArray arrayWithObjects:array count:extracted];
+	for (NSUInteger i = 0; i < extracted; ++i) { [array[i] release]; }
+	free(array);
+
+	return objects;
+}
+
+- (void)removeAllObjects
+{
+	for (NSUInteger i = 0; i < _shardCount; ++i)
+	{
+		CBHConcurrentHeapShard_t *shard = &_shards[i];
+		pthread_mutex_lock(&shard->_lock);
+
+		/// Release stored objects.
+		for (NSUInteger j = 0; j < shard->_heap._count; ++j) { CFRelease(CBHQueue_pointerAtIndex(&shard->_heap, j)); }
+
+		/// Reset the counter and offset.
+		shard->_heap._count = 0;
+		shard->_heap._offset = 0;
+
+		_publishCount(shard);
+		pthread_mutex_unlock(&shard->_lock);
+	}
+}
+
+
+#pragma mark - Private Shard Selection
+
+- (CBHConcurrentHeapShard_t *)lockRandomShard
+{
+	/// After a full round of busy shards, wait on one rather than spinning.
+	for (NSUInteger attempts = 0; YES; ++attempts)
+	{
+		CBHConcurrentHeapShard_t *shard = &_shards[CBHConcurrentHeap_random(_shardCount)];
+		if ( CBHConcurrentHeap_lockShard(shard, ( attempts >= _shardCount )) ) return shard;
+	}
+}
+
+- (CBHConcurrentHeapShard_t *)lockBestShard
+{
+	NSUInteger misses = 0;
+
+	for (NSUInteger attempts = 0; YES; ++attempts)
+	{
+		CBHConcurrentHeapShard_t *a = &_shards[CBHConcurrentHeap_random(_shardCount)];
+		CBHConcurrentHeapShard_t *b = &_shards[CBHConcurrentHeap_random(_shardCount)];
+
+		/// Choosing among empty shards is hopeless when most are empty, so fall back to looking at each in turn.
+		if ( _countOf(a) <= 0 && _countOf(b) <= 0 )
+		{
+			if ( ++misses >= _shardCount ) return [self lockAnyShard];
+			continue;
+		}
+
+		if ( _countOf(a) <= 0 ) a = b;
+		if ( _countOf(b) <= 0 ) b = a;
+
+		/// Two shards are locked in address order, so blocking can't deadlock.
+		if ( a > b ) { CBHConcurrentHeapShard_t *tmp = a; a = b; b = tmp; }
+
+		const BOOL shouldBlock = ( attempts >= _shardCount );
+		if ( !CBHConcurrentHeap_lockShard(a, shouldBlock) ) continue;
+
+		if ( a != b )
+		{
+			if ( !CBHConcurrentHeap_lockShard(b, shouldBlock) )
+			{
+				pthread_mutex_unlock(&a->_lock);
+				continue;
+			}
+
+			/// Either may have emptied since it was chosen.
+			CBHConcurrentHeapShard_t *worse = b;
+			if ( a->_heap._count <= 0 ) worse = a;
+			else if ( b->_heap._count > 0 && _comparator(_peekObject(b), _peekObject(a)) == NSOrderedAscending ) worse = a;
+
+			pthread_mutex_unlock(&worse->_lock);
+			if ( worse == a ) a = b;
+		}
+
+		if ( a->_heap._count > 0 ) return a;
+		pthread_mutex_unlock(&a->_lock);
+	}
+}
+
+- (CBHConcurrentHeapShard_t *)lockAnyShard
+{
+	const NSUInteger start = CBHConcurrentHeap_random(_shardCount);
+
+	for (NSUInteger i = 0; i < _shardCount; ++i)
+	{
+		CBHConcurrentHeapShard_t *shard = &_shards[(start + i) % _shardCount];
+		if ( _countOf(shard) <= 0 ) continue;
+
+		pthread_mutex_lock(&shard->_lock);
+		if ( shard->_heap._count > 0 ) return shard;
+		pthread_mutex_unlock(&shard->_lock);
+	}
+
+	return NULL;
+}
+
+@end
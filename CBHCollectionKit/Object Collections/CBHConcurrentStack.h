@@ -0,0 +1,88 @@
+//  CBHConcurrentStack.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import <CBHCollectionKit/CBHCollection.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** A last-in-first-out collection of objects which many threads can push to and pop from at once without locking.
+ *
+ * A Concurrent Stack is a Treiber stack: a linked list whose head is swapped with a double-width compare-and-swap. The head carries a tag which every swap increments, so a node which is popped and pushed back between a thread's read and its swap can't be mistaken for the node it read.
+ *
+ * Nodes are pooled. Popped nodes are reused by later pushes and their memory is only freed with the stack, which also makes it safe for a thread to read a node another thread has just popped.
+ *
+ * Objects are retained when pushed and autoreleased when popped, as with `CBHStack`.
+ *
+ * @note: `count` and `isEmpty` are snapshots and may be stale by the time they return when other threads are mutating the stack.
+ *
+ * @author    Christian Huxtable <chris@huxtable.ca>
+ */
+@interface CBHConcurrentStack<ObjectType> : NSObject <CBHCollection>
+
+#pragma mark - Factories
+
++ (instancetype)concurrentStack;
+
+
+#pragma mark - Initialization
+
+- (instancetype)init NS_DESIGNATED_INITIALIZER;
+
+
+#pragma mark - Properties
+
+@property (nonatomic, readonly) NSUInteger count;
+
+/** The number of nodes the stack has allocated. It never shrinks, since nodes are only freed with the stack. */
+@property (nonatomic, readonly) NSUInteger capacity;
+
+@property (nonatomic, readonly) BOOL isEmpty;
+
+
+#pragma mark - Addition
+
+- (void)pushObject:(ObjectType)object;
+
+/** Pushes a batch of objects with a single swap of the head.
+ *
+ * The objects end up in the same order as if they were pushed one at a time, so the last object is on top.
+ *
+ * @param objects    A C array of objects to push.
+ * @param count      The number of objects in `objects`.
+ */
+- (void)pushObjects:(const ObjectType _Nonnull [_Nonnull])objects count:(NSUInteger)count;
+
+
+#pragma mark - Subtraction
+
+- (nullable ObjectType)popObject;
+
+/** Removes every object with a single swap of the head.
+ *
+ * @return    The removed objects, from the top of the stack to the bottom.
+ */
+- (NSArray<ObjectType> *)popAll;
+
+- (void)removeAllObjects;
+
+@end
+
+NS_ASSUME_NONNULL_END
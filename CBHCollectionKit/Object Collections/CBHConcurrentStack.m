@@ -0,0 +1,304 @@
+//  CBHConcurrentStack.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHConcurrentStack.h"
+
+@import CBHMemoryKit;
+
+#include <stdlib.h>
+
+
+#define SLAB_NODES 256
+
+/// The head, the pool, and the count are each contended, so they are kept on separate cache lines.
+#define LINE_SIZE 128
+
+
+#pragma mark - Nodes
+
+typedef struct CBHConcurrentStackNode_t {
+	struct CBHConcurrentStackNode_t *_next;
+	id _object;
+} CBHConcurrentStackNode_t;
+
+/// A node paired with a tag bumped by every swap, so a node popped and pushed back by other threads compares unequal.
+typedef struct CBHConcurrentStackHead_t {
+	CBHConcurrentStackNode_t *_node;
+	uintptr_t _tag;
+} __attribute__((aligned(16))) CBHConcurrentStackHead_t;
+
+
+#pragma mark - Lists
+
+/// Reads the tag before the node, a torn pair fails the swap and is read again.
+static inline CBHConcurrentStackHead_t CBHConcurrentStack_loadHead(CBHConcurrentStackHead_t *head)
+{
+	CBHConcurrentStackHead_t retVal;
+	retVal._tag = __atomic_load_n(&head->_tag, __ATOMIC_ACQUIRE);
+	retVal._node = __atomic_load_n(&head->_node, __ATOMIC_ACQUIRE);
+	return retVal;
+}
+
+static inline BOOL CBHConcurrentStack_swapHead(CBHConcurrentStackHead_t *head, CBHConcurrentStackHead_t *expected, CBHConcurrentStackNode_t *node)
+{
+	CBHConcurrentStackHead_t desired = {node, expected->_tag + 1};
+	return __atomic_compare_exchange(head, expected, &desired, YES, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+/// Pushes the linked nodes from `first` to `last` with a single swap.
+static void CBHConcurrentStack_pushNodes(CBHConcurrentStackHead_t *head, CBHConcurrentStackNode_t *first, CBHConcurrentStackNode_t *last)
+{
+	CBHConcurrentStackHead_t expected = CBHConcurrentStack_loadHead(head);
+	do
+	{
+		__atomic_store_n(&last->_next, expected._node, __ATOMIC_RELAXED);
+	}
+	while ( !CBHConcurrentStack_swapHead(head, &expected, first) );
+}
+
+/// Nodes are never freed while the stack lives, so reading `_next` of a node another thread just popped is safe. The tag rejects the stale result.
+static CBHConcurrentStackNode_t *CBHConcurrentStack_popNode(CBHConcurrentStackHead_t *head)
+{
+	CBHConcurrentStackHead_t expected = CBHConcurrentStack_loadHead(head);
+	while ( expected._node )
+	{
+		CBHConcurrentStackNode_t *next = __atomic_load_n(&expected._node->_next, __ATOMIC_RELAXED);
+		if ( CBHConcurrentStack_swapHead(head, &expected, next) ) return expected._node;
+	}
+
+	return NULL;
+}
+
+static CBHConcurrentStackNode_t *CBHConcurrentStack_popAllNodes(CBHConcurrentStackHead_t *head)
+{
+	CBHConcurrentStackHead_t expected = CBHConcurrentStack_loadHead(head);
+	while ( expected._node )
+	{
+		if ( CBHConcurrentStack_swapHead(head, &expected, NULL) ) return expected._node;
+	}
+
+	return NULL;
+}
+
+
+#pragma mark - Node Pool
+
+typedef struct CBHConcurrentStackSlab_t {
+	struct CBHConcurrentStackSlab_t *_next;
+	CBHConcurrentStackNode_t _nodes[SLAB_NODES];
+} CBHConcurrentStackSlab_t;
+
+typedef struct CBHConcurrentStackShared_t {
+	CBHConcurrentStackHead_t _head __attribute__((aligned(LINE_SIZE)));
+	CBHConcurrentStackHead_t _pool __attribute__((aligned(LINE_SIZE)));
+
+	/// Raised before a push and lowered after a pop, so it is never below the true count.
+	NSUInteger _count __attribute__((aligned(LINE_SIZE)));
+
+	CBHConcurrentStackSlab_t *_slabs;
+	NSUInteger _capacity;
+} CBHConcurrentStackShared_t;
+
+static CBHConcurrentStackNode_t *CBHConcurrentStack_takeNode(CBHConcurrentStackShared_t *shared)
+{
+	CBHConcurrentStackNode_t *node = CBHConcurrentStack_popNode(&shared->_pool);
+	if ( node ) return node;
+
+	CBHConcurrentStackSlab_t *slab = CBHMemory_alloc(1, sizeof(CBHConcurrentStackSlab_t));
+	if ( !slab ) @throw CBHCallocException;
+
+	/// Keep the first node and pool the rest.
+	for (NSUInteger i = 1; i < SLAB_NODES - 1; ++i) { slab->_nodes[i]._next = &slab->_nodes[i + 1]; }
+	CBHConcurrentStack_pushNodes(&shared->_pool, &slab->_nodes[1], &slab->_nodes[SLAB_NODES - 1]);
+
+	/// Slabs are only ever added until the stack is freed, so their list can't suffer from ABA.
+	slab->_next = __atomic_load_n(&shared->_slabs, __ATOMIC_RELAXED);
+	while ( !__atomic_compare_exchange_n(&shared->_slabs, &slab->_next, slab, YES, __ATOMIC_RELEASE, __ATOMIC_RELAXED) );
+	__atomic_fetch_add(&shared->_capacity, SLAB_NODES, __ATOMIC_RELAXED);
+
+	return &slab->_nodes[0];
+}
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface CBHConcurrentStack<ObjectType> ()
+{
+	CBHConcurrentStackShared_t *_shared;
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+@implementation CBHConcurrentStack
+
+#pragma mark - Factories
+
++ (instancetype)concurrentStack
+{
+	return [[(CBHConcurrentStack *)[self alloc] init] autorelease];
+}
+
+
+#pragma mark - Initialization
+
+- (instancetype)init
+{
+	if ( (self = [super init]) )
+	{
+		void *shared = NULL;
+		if ( posix_memalign(&shared, LINE_SIZE, sizeof(CBHConcurrentStackShared_t)) != 0 ) @throw CBHCallocException;
+
+		_shared = (CBHConcurrentStackShared_t *)shared;
+		memset(_shared, 0, sizeof(CBHConcurrentStackShared_t));
+	}
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	[self removeAllObjects];
+
+	CBHConcurrentStackSlab_t *slab = _shared->_slabs;
+	while ( slab )
+	{
+		CBHConcurrentStackSlab_t *next = slab->_next;
+		free(slab);
+		slab = next;
+	}
+
+	free(_shared);
+
+	[super dealloc];
+}
+
+
+#pragma mark - Properties
+
+- (NSUInteger)count
+{
+	return __atomic_load_n(&_shared->_count, __ATOMIC_RELAXED);
+}
+
+- (NSUInteger)capacity
+{
+	return __atomic_load_n(&_shared->_capacity, __ATOMIC_RELAXED);
+}
+
+- (BOOL)isEmpty
+{
+	return ( __atomic_load_n(&_shared->_head._node, __ATOMIC_RELAXED) == NULL );
+}
+
+
+#pragma mark - Addition
+
+- (void)pushObject:(id)object
+{
+	CBHConcurrentStackNode_t *node = CBHConcurrentStack_takeNode(_shared);
+	node->_object = [object retain];
+
+	__atomic_fetch_add(&_shared->_count, 1, __ATOMIC_RELAXED);
+	CBHConcurrentStack_pushNodes(&_shared->_head, node, node);
+}
+
+- (void)pushObjects:(const id [])objects count:(NSUInteger)count
+{
+	if ( count <= 0 ) return;
+
+	/// Link the batch privately, the last object on top.
+	CBHConcurrentStackNode_t *first = NULL;
+	CBHConcurrentStackNode_t *last = NULL;
+
+	for (NSUInteger i = 0; i < count; ++i)
+	{
+		CBHConcurrentStackNode_t *node = CBHConcurrentStack_takeNode(_shared);
+		node->_object = [objects[i] retain];
+		__atomic_store_n(&node->_next, first, __ATOMIC_RELAXED);
+
+		if ( !last ) last = node;
+		first = node;
+	}
+
+	__atomic_fetch_add(&_shared->_count, count, __ATOMIC_RELAXED);
+	CBHConcurrentStack_pushNodes(&_shared->_head, first, last);
+}
+
+
+#pragma mark - Subtraction
+
+- (id)popObject
+{
+	CBHConcurrentStackNode_t *node = CBHConcurrentStack_popNode(&_shared->_head);
+	if ( !node ) return nil;
+
+	__atomic_fetch_sub(&_shared->_count, 1, __ATOMIC_RELAXED);
+
+	id object = node->_object;
+	CBHConcurrentStack_pushNodes(&_shared->_pool, node, node);
+
+	return [object autorelease];
+}
+
+- (NSArray *)popAll
+{
+	CBHConcurrentStackNode_t *first = CBHConcurrentStack_popAllNodes(&_shared->_head);
+	if ( !first ) return @[];
+
+	NSMutableArray *objects = [NSMutableArray array];
+
+	/// The detached list belongs to this thread alone.
+	CBHConcurrentStackNode_t *last = first;
+	for (CBHConcurrentStackNode_t *node = first; node; node = node->_next)
+	{
+		[objects addObject:node->_object];
+		[node->_object release];
+		last = node;
+	}
+
+	__atomic_fetch_sub(&_shared->_count, [objects count], __ATOMIC_RELAXED);
+	CBHConcurrentStack_pushNodes(&_shared->_pool, first, last);
+
+	return objects;
+}
+
+- (void)removeAllObjects
+{
+	CBHConcurrentStackNode_t *first = CBHConcurrentStack_popAllNodes(&_shared->_head);
+	if ( !first ) return;
+
+	NSUInteger removed = 0;
+	CBHConcurrentStackNode_t *last = first;
+	for (CBHConcurrentStackNode_t *node = first; node; node = node->_next)
+	{
+		[node->_object release];
+		last = node;
+		++removed;
+	}
+
+	__atomic_fetch_sub(&_shared->_count, removed, __ATOMIC_RELAXED);
+	CBHConcurrentStack_pushNodes(&_shared->_pool, first, last);
+}
+
+@end
@@ -19,6 +19,8 @@
 @import Foundation;
 
 #import <CBHCollectionKit/CBHCollection.h>
+#import <CBHCollectionKit/CBHCollectionCoder.h>
+#import <CBHCollectionKit/CBHAllocation.h>
 
 
 NS_ASSUME_NONNULL_BEGIN
@@ -35,6 +37,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 + (instancetype)heapWithComparator:(NSComparator)comparator;
 + (instancetype)heapWithComparator:(NSComparator)comparator andCapacity:(NSUInteger)capacity;
++ (instancetype)heapWithComparator:(NSComparator)comparator andCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options;
 + (instancetype)heapWithComparator:(NSComparator)comparator andObjects:(nullable ObjectType)object, ... NS_REQUIRES_NIL_TERMINATION;
 
 + (instancetype)heapWithComparator:(NSComparator)comparator andArray:(NSArray<ObjectType> *)array;
@@ -45,13 +48,35 @@ NS_ASSUME_NONNULL_BEGIN
 #pragma mark - Initialization
 
 - (instancetype)initWithComparator:(NSComparator)comparator;
-- (instancetype)initWithComparator:(NSComparator)comparator andCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+- (instancetype)initWithComparator:(NSComparator)comparator andCapacity:(NSUInteger)capacity;
+
+/** Initializes an empty heap whose buffer is allocated as described by `options`.
+ *
+ * @param comparator    The comparator which orders the heap.
+ * @param capacity      The number of objects the heap can hold before growing.
+ * @param options       The alignment, paging, and allocator of the heap's buffer.
+ *
+ * @return              An initialized empty heap.
+ */
+- (instancetype)initWithComparator:(NSComparator)comparator andCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options NS_DESIGNATED_INITIALIZER;
 - (instancetype)initWithComparator:(NSComparator)comparator andObjects:(nullable ObjectType)object, ... NS_REQUIRES_NIL_TERMINATION;
 
 - (instancetype)initWithComparator:(NSComparator)comparator andArray:(NSArray<ObjectType> *)array;
 - (instancetype)initWithComparator:(NSComparator)comparator andSet:(NSSet<ObjectType> *)set;
 - (instancetype)initWithComparator:(NSComparator)comparator andEnumerator:(NSEnumerator<ObjectType> *)enumerator;
 
+/** Initializes a newly allocated heap with the next object collection read by `decoder`.
+ *
+ * A comparator can't be encoded, so it is supplied again when decoding.
+ *
+ * @param comparator    The comparator which orders the heap.
+ * @param decoder       The decoder to read from.
+ * @param codec         The codec used to read each object.
+ *
+ * @return              A newly initialized heap, or `nil` if the collection could not be read. The reason is left in the decoder's `error`.
+ */
+- (nullable instancetype)initWithComparator:(NSComparator)comparator collectionDecoder:(CBHCollectionDecoder *)decoder codec:(id<CBHObjectCodec>)codec;
+
 
 #pragma mark - Properties
 
@@ -89,6 +114,18 @@ NS_ASSUME_NONNULL_BEGIN
 - (NSMutableOrderedSet<ObjectType> *)mutableOrderedSet;
 
 
+#pragma mark - Serialization
+
+/** Writes the objects of the receiver to `encoder` in the binary collection format. Objects are written in storage order, not sorted.
+ *
+ * @param encoder    The encoder to write to.
+ * @param codec      The codec used to write each object.
+ *
+ * @return           `YES` if the receiver was written, otherwise `NO`. The reason is left in the encoder's `error`.
+ */
+- (BOOL)encodeWithCollectionEncoder:(CBHCollectionEncoder *)encoder codec:(id<CBHObjectCodec>)codec;
+
+
 #pragma mark - Peeking
 
 - (nullable ObjectType)peekAtObject;
@@ -18,11 +18,14 @@
 
 #import "CBHHeap.h"
 #import "_CBHHeap.h"
+#import "_CBHBuffer.h"
+#import "_CBHHash.h"
 
 @import CBHMemoryKit;
 
 
 #define DEFAULT_CAPACITY 8
+#define DECODING_CAPACITY 65536
 #define GROWTH_FACTOR 1.618033988749895
 
 #define _nextCapacity(aCapacity) (size_t)ceil((double)(aCapacity) * GROWTH_FACTOR)
@@ -40,6 +43,9 @@
 
 #define _guardNotEmpty(retVal) if ( _queue._count <= 0 ) return (retVal)
 
+/// Shared storage is copied before writing and the copy needs its own references.
+#define _makeUnique() CBHQueue_makeUniqueRetainingObjects(&_queue)
+
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -54,6 +60,9 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (instancetype)initWithComparator:(NSComparator)comparator firstObject:(ObjectType)object andArgumentList:(va_list)argList;
 
+/// Takes over an initialized queue which is already in heap order.
+- (instancetype)initWithComparator:(NSComparator)comparator andQueue:(CBHQueue_t)queue;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -73,6 +82,11 @@ NS_ASSUME_NONNULL_END
 	return [[(CBHHeap *)[self alloc] initWithComparator:comparator andCapacity:capacity] autorelease];
 }
 
++ (instancetype)heapWithComparator:(NSComparator)comparator andCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options
+{
+	return [[(CBHHeap *)[self alloc] initWithComparator:comparator andCapacity:capacity options:options] autorelease];
+}
+
 + (instancetype)heapWithComparator:(NSComparator)comparator andObjects:(id)object, ...
 {
 	va_list arguments;
@@ -101,6 +115,15 @@ NS_ASSUME_NONNULL_END
 }
 
 
+#pragma mark - Allocation
+
++ (instancetype)allocWithZone:(NSZone *)zone
+{
+	/// Small collections keep their entries inside the object rather than allocating a buffer.
+	return CBHBuffer_allocInlineObject(self);
+}
+
+
 #pragma mark - Initialization
 
 - (instancetype)initWithComparator:(NSComparator)comparator
@@ -109,10 +132,15 @@ NS_ASSUME_NONNULL_END
 }
 
 - (instancetype)initWithComparator:(NSComparator)comparator andCapacity:(NSUInteger)capacity
+{
+	return [self initWithComparator:comparator andCapacity:capacity options:CBHAllocationOptionsDefault];
+}
+
+- (instancetype)initWithComparator:(NSComparator)comparator andCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options
 {
 	if ( (self = [super init]) )
 	{
-		_queue = CBHQueue_init(capacity, sizeof(id));
+		_queue = CBHQueue_initInline(CBHBuffer_inlineBytes(self), capacity, sizeof(id), &options);
 		_comparator = [comparator copy];
 	}
 
@@ -177,12 +205,56 @@ NS_ASSUME_NONNULL_END
 	return self;
 }
 
+- (instancetype)initWithComparator:(NSComparator)comparator collectionDecoder:(CBHCollectionDecoder *)decoder codec:(id<CBHObjectCodec>)codec
+{
+	NSUInteger count = 0;
+	if ( ![decoder beginObjects:&count] )
+	{
+		[self release];
+		return nil;
+	}
+
+	/// The count is only trusted as far as a reasonable capacity, the heap grows if it was honest.
+	if ( !(self = [self initWithComparator:comparator andCapacity:MAX(MIN(count, DECODING_CAPACITY), 1)]) ) return nil;
+
+	@autoreleasepool
+	{
+		for (NSUInteger i = 0; i < count; ++i)
+		{
+			id object = [decoder decodeObjectWithCodec:codec];
+			if ( !object ) break;
+
+			_insertObject(&_queue, object);
+		}
+	}
+
+	if ( ![decoder endObjects] )
+	{
+		[self release];
+		return nil;
+	}
+
+	return self;
+}
+
+- (instancetype)initWithComparator:(NSComparator)comparator andQueue:(CBHQueue_t)queue
+{
+	if ( (self = [super init]) )
+	{
+		_queue = queue;
+		_comparator = [comparator copy];
+	}
+
+	return self;
+}
+
 
 #pragma mark - Destructor
 
 - (void)dealloc
 {
-	[self removeAllObjects];
+	/// Objects in shared storage stay with the collections still sharing it.
+	if ( !CBHSlice_releaseShared((CBHSlice_t *)&_queue) ) [self removeAllObjects];
 	CBHQueue_dealloc(&_queue);
 
 	[super dealloc];
@@ -213,22 +285,8 @@ NS_ASSUME_NONNULL_END
 
 - (id)copyWithZone:(NSZone *)zone
 {
-	CBHHeap *heap = [(CBHHeap *)[[self class] allocWithZone:zone] initWithComparator:_comparator andCapacity:_queue._capacity];
-
-	/// Copy existing heap to new heap.
-	CBHMemory_copyTo(_queue._data, heap->_queue._data, sizeof(id), _queue._capacity);
-
-	/// Set heap properties.
-	heap->_queue._count = _queue._count;
-	heap->_queue._offset = _queue._offset;
-
-	/// Retain all objects.
-	for (NSUInteger i = 0; i < _queue._count; ++i)
-	{
-		CFBridgingRetain((__bridge id __unsafe_unretained)CBHQueue_pointerAtIndex(&heap->_queue, i));
-	}
-
-	return heap;
+	/// Shares the storage and its references, whichever heap is written to first copies them.
+	return [(CBHHeap *)[[self class] allocWithZone:zone] initWithComparator:_comparator andQueue:CBHQueue_initSharing(&_queue)];
 }
 
 
@@ -267,29 +325,15 @@ NS_ASSUME_NONNULL_END
 
 - (NSUInteger)hash
 {
-	/// Mix in properties.
-	NSUInteger hash = ((_queue._capacity * 3) * 31);
-	NSUInteger count = _queue._count;
-
-	/// XOR in middle object hash.
-	if ( count >= 3 )
-	{
-		hash ^= [_objectAtIndex(&_queue, (NSUInteger)((float)count / 2.0f)) hash] * 71;
-	}
-
-	/// XOR in last object hash.
-	if ( count >= 2 )
-	{
-		hash ^= [_objectAtIndex(&_queue, count - 1) hash] * 61;
-	}
+	/// Equal heaps can hold their objects in different orders, so the mixed hashes are summed, which ignores order.
+	uint64_t hash = _queue._count;
 
-	/// XOR in first object hash.
-	if ( count >= 1 )
+	for (NSUInteger i = 0; i < _queue._count; ++i)
 	{
-		hash ^= [_objectAtIndex(&_queue, 0) hash] * 41;
+		hash += CBHHash_mix((uint64_t)[_objectAtIndex(&_queue, i) hash], 0x9e3779b97f4a7c15ull);
 	}
 
-	return hash;
+	return (NSUInteger)hash;
 }
 
 
@@ -362,6 +406,23 @@ NS_ASSUME_NONNULL_END
 }
 
 
+#pragma mark - Serialization
+
+- (BOOL)encodeWithCollectionEncoder:(CBHCollectionEncoder *)encoder codec:(id<CBHObjectCodec>)codec
+{
+	BOOL success = [encoder beginObjects:_queue._count];
+
+	/// Storage order is already a valid heap, so decoding rebuilds it without reordering.
+	for (NSUInteger i = 0; i < _queue._count && success; ++i)
+	{
+		success = [encoder encodeObject:_objectAtIndex(&_queue, i) withCodec:codec];
+	}
+
+	/// Always closes the collection, even after a failure.
+	return [encoder endObjects] && success;
+}
+
+
 #pragma mark - Peeking
 
 - (id)peekAtObject
@@ -375,6 +436,7 @@ NS_ASSUME_NONNULL_END
 
 - (void)insertObject:(id)object
 {
+	_makeUnique();
 	_insertObject(&_queue, object);
 }
 
@@ -383,6 +445,8 @@ NS_ASSUME_NONNULL_END
 	va_list arguments;
 	va_start(arguments, object);
 
+	_makeUnique();
+
 	id __nullable current = object;
 	while ( current )
 	{
@@ -396,6 +460,7 @@ NS_ASSUME_NONNULL_END
 
 - (void)insertObjectsFromArray:(NSArray *)array
 {
+	_makeUnique();
 	[self growToFit:([array count] + _queue._count)];
 
 	// TODO: Only balance at end?
@@ -404,6 +469,7 @@ NS_ASSUME_NONNULL_END
 
 - (void)insertObjectsFromSet:(NSSet *)set
 {
+	_makeUnique();
 	[self growToFit:([set count] + _queue._count)];
 
 	// TODO: Only balance at end?
@@ -412,6 +478,8 @@ NS_ASSUME_NONNULL_END
 
 - (void)insertObjectsFromEnumerator:(id <NSFastEnumeration>)enumerator
 {
+	_makeUnique();
+
 	// TODO: Only balance at end?
 	for (id object in enumerator) { _insertObject(&_queue, object); }
 }
@@ -421,6 +489,7 @@ NS_ASSUME_NONNULL_END
 
 - (id)extractObject
 {
+	_makeUnique();
 	return _extractObject();
 }
 
@@ -433,6 +502,8 @@ NS_ASSUME_NONNULL_END
 	id array[count];
 	NSUInteger index = 0;
 
+	_makeUnique();
+
 	/// Store entries on stack temporarily.
 	while ( index < count && (object = _extractObject()) )
 	{
@@ -446,6 +517,16 @@ NS_ASSUME_NONNULL_END
 
 - (void)removeAllObjects
 {
+	/// Drop shared storage rather than copying it only to release the copies.
+	const NSUInteger capacity = _queue._capacity;
+	if ( CBHSlice_releaseShared((CBHSlice_t *)&_queue) )
+	{
+		CBHSlice_setCapacity((CBHSlice_t *)&_queue, capacity, NO);
+		_queue._count = 0;
+		_queue._offset = 0;
+		return;
+	}
+
 	/// Release stored objects.
 	for (NSUInteger i = 0; i < _queue._count; ++i)
 	{
@@ -467,6 +548,7 @@ NS_ASSUME_NONNULL_END
 	if ( newCapacity < 1 ) newCapacity = 1;
 
 	/// Shrink.
+	_makeUnique();
 	return CBHQueue_shrinkTo(&_queue, newCapacity);
 }
 
@@ -476,6 +558,7 @@ NS_ASSUME_NONNULL_END
 	if ( _queue._capacity > _queue._count ) return NO;
 
 	/// Grow.
+	_makeUnique();
 	return CBHQueue_growTo(&_queue, _nextCapacity(_queue._capacity));
 }
 
@@ -489,12 +572,14 @@ NS_ASSUME_NONNULL_END
 	while ( neededCapacity > nextCapacity ) { nextCapacity = _nextCapacity(nextCapacity); }
 
 	/// Grow to new capacity.
+	_makeUnique();
 	CBHQueue_growTo(&_queue, nextCapacity);
 	return YES;
 }
 
 - (BOOL)resize:(NSUInteger)newCapacity
 {
+	_makeUnique();
 	return CBHQueue_resize(&_queue, newCapacity);
 }
 
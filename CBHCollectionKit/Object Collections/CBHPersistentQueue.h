@@ -0,0 +1,126 @@
+//  CBHPersistentQueue.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+@import Foundation;
+
+#import <CBHCollectionKit/CBHCollection.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** An immutable first-in-first-out collection of objects whose versions share structure.
+ *
+ * A persistent queue is a real-time queue built from persistent stacks: objects are dequeued from the top of the front stack and enqueued onto the rear stack. Once the rear grows longer than the front, a rotation starts moving the rear onto the end of the front, a couple of objects with each new version. Enqueuing and dequeuing return new queues in worst-case constant time and leave the receiver untouched, so the bound holds however many versions are branched from one snapshot, keeping an old version costs nothing and copying is a retain.
+ *
+ * Objects are shared in chunks of up to 256, so a dequeued object is released once no version reaches its chunk and the rotation under way when it was dequeued has finished.
+ *
+ * @author    Christian Huxtable <chris@huxtable.ca>
+ */
+@interface CBHPersistentQueue<ObjectType> : NSObject <NSCopying, NSFastEnumeration, CBHCollection>
+
+#pragma mark - Factories
+
++ (instancetype)persistentQueue;
++ (instancetype)persistentQueueWithArray:(NSArray<ObjectType> *)array;
+
+
+#pragma mark - Initialization
+
+- (instancetype)init;
+
+/** Initializes a queue holding the objects of `array`.
+ *
+ * @param array    The objects to hold, the head first.
+ *
+ * @return         An initialized queue.
+ */
+- (instancetype)initWithArray:(NSArray<ObjectType> *)array NS_DESIGNATED_INITIALIZER;
+
+
+#pragma mark - Properties
+
+@property (nonatomic, readonly) NSUInteger count;
+
+/// The same as `count`, a persistent queue never holds free space of its own.
+@property (nonatomic, readonly) NSUInteger capacity;
+@property (nonatomic, readonly) BOOL isEmpty;
+
+
+#pragma mark - Copying
+
+- (id)copyWithZone:(nullable NSZone *)zone;
+
+
+#pragma mark - Equality
+
+- (BOOL)isEqual:(id)other;
+- (BOOL)isEqualToPersistentQueue:(CBHPersistentQueue<ObjectType> *)other;
+
+- (NSUInteger)hash;
+
+
+#pragma mark - Description
+
+- (NSString *)description;
+- (NSString *)debugDescription;
+
+
+#pragma mark - Fast Enumeration
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id __unsafe_unretained _Nullable [_Nonnull])buffer count:(NSUInteger)len;
+
+
+#pragma mark - Conversion
+
+/// The objects of the receiver, the head first.
+- (NSArray<ObjectType> *)array;
+
+
+#pragma mark - Accessors
+
+- (nullable ObjectType)peekAtObject;
+
+
+#pragma mark - Versions
+
+/** Returns a queue with `object` added after the receiver's objects.
+ *
+ * @param object    The object to enqueue.
+ *
+ * @return          A new queue sharing the receiver's objects.
+ */
+- (CBHPersistentQueue<ObjectType> *)queueByEnqueuingObject:(ObjectType)object;
+
+/** Returns a queue with the objects of `array` added in order after the receiver's objects.
+ *
+ * @param array    The objects to enqueue.
+ *
+ * @return         A new queue sharing the receiver's objects.
+ */
+- (CBHPersistentQueue<ObjectType> *)queueByEnqueuingObjectsFromArray:(NSArray<ObjectType> *)array;
+
+/** Returns a queue without the receiver's head object.
+ *
+ * @return    A new queue sharing the receiver's remaining objects, or the receiver if it is empty.
+ */
+- (CBHPersistentQueue<ObjectType> *)queueByDequeuingObject;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,552 @@
+//  CBHPersistentQueue.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#import "CBHPersistentQueue.h"
+#import "_CBHPersistentStack.h"
+#import "_CBHHash.h"
+
+@import CBHMemoryKit;
+
+
+#pragma mark - Rotations
+
+typedef NS_ENUM(uint8_t, CBHPersistentRotationPhase) {
+	CBHPersistentRotationPhaseIdle = 0,
+
+	/// Moving the old front onto `_reversedFront` and the old rear onto `_result`, one object of each per step.
+	CBHPersistentRotationPhaseReversing,
+
+	/// Moving the objects of `_reversedFront` still in the queue onto `_result`.
+	CBHPersistentRotationPhaseAppending,
+
+	/// `_result` is the new front.
+	CBHPersistentRotationPhaseDone,
+};
+
+/// Moves the rear onto the end of the front a few objects per version, so no version does more than constant work.
+typedef struct CBHPersistentRotation_t {
+	CBHPersistentRotationPhase _phase;
+
+	/// Objects moved off the old front which haven't been dequeued since.
+	NSInteger _valid;
+
+	CBHPersistentStack_t _front;
+	CBHPersistentStack_t _reversedFront;
+	CBHPersistentStack_t _rear;
+	CBHPersistentStack_t _result;
+} CBHPersistentRotation_t;
+
+typedef struct CBHPersistentQueue_t {
+	/// The head is the top of the front. While rotating, the first `_frontCount` objects are the front followed by those the rotation still holds.
+	CBHPersistentStack_t _front;
+	NSUInteger _frontCount;
+
+	/// The tail is the top of the rear, which is never longer than `_frontCount`.
+	CBHPersistentStack_t _rear;
+
+	CBHPersistentRotation_t _rotation;
+} CBHPersistentQueue_t;
+
+
+static inline void CBHPersistentStack_replace(CBHPersistentStack_t *stack, CBHPersistentStack_t next)
+{
+	CBHPersistentStack_dealloc(stack);
+	*stack = next;
+}
+
+/// Moves the top of `from` onto `to`.
+static void CBHPersistentStack_move(CBHPersistentStack_t *from, CBHPersistentStack_t *to)
+{
+	CBHPersistentStack_replace(to, CBHPersistentStack_push(to, CBHPersistentStack_peek(from)));
+	CBHPersistentStack_replace(from, CBHPersistentStack_pop(from));
+}
+
+static CBHPersistentRotation_t CBHPersistentRotation_initSharing(const CBHPersistentRotation_t *rotation)
+{
+	CBHPersistentRotation_t copy = *rotation;
+
+	copy._front = CBHPersistentStack_initSharing(&rotation->_front);
+	copy._reversedFront = CBHPersistentStack_initSharing(&rotation->_reversedFront);
+	copy._rear = CBHPersistentStack_initSharing(&rotation->_rear);
+	copy._result = CBHPersistentStack_initSharing(&rotation->_result);
+
+	return copy;
+}
+
+static void CBHPersistentRotation_dealloc(CBHPersistentRotation_t *rotation)
+{
+	CBHPersistentStack_dealloc(&rotation->_front);
+	CBHPersistentStack_dealloc(&rotation->_reversedFront);
+	CBHPersistentStack_dealloc(&rotation->_rear);
+	CBHPersistentStack_dealloc(&rotation->_result);
+
+	rotation->_phase = CBHPersistentRotationPhaseIdle;
+	rotation->_valid = 0;
+}
+
+static void CBHPersistentRotation_step(CBHPersistentRotation_t *rotation)
+{
+	switch ( rotation->_phase )
+	{
+		case CBHPersistentRotationPhaseReversing:
+			/// The old rear is one longer than the old front, its last object is moved as appending starts.
+			if ( rotation->_front._count > 0 )
+			{
+				CBHPersistentStack_move(&rotation->_front, &rotation->_reversedFront);
+				++rotation->_valid;
+			}
+			else rotation->_phase = CBHPersistentRotationPhaseAppending;
+
+			CBHPersistentStack_move(&rotation->_rear, &rotation->_result);
+			break;
+
+		case CBHPersistentRotationPhaseAppending:
+			if ( rotation->_valid > 0 )
+			{
+				CBHPersistentStack_move(&rotation->_reversedFront, &rotation->_result);
+				--rotation->_valid;
+				break;
+			}
+
+			/// The rest were dequeued while rotating.
+			CBHPersistentStack_dealloc(&rotation->_reversedFront);
+			rotation->_phase = CBHPersistentRotationPhaseDone;
+			break;
+
+		default:
+			break;
+	}
+}
+
+/// Accounts for the head being dequeued while the rotation may still hold it.
+static void CBHPersistentRotation_invalidate(CBHPersistentRotation_t *rotation)
+{
+	switch ( rotation->_phase )
+	{
+		case CBHPersistentRotationPhaseReversing:
+			--rotation->_valid;
+			break;
+
+		case CBHPersistentRotationPhaseAppending:
+			if ( rotation->_valid > 0 )
+			{
+				--rotation->_valid;
+				break;
+			}
+
+			/// The head is already on top of the result.
+			CBHPersistentStack_replace(&rotation->_result, CBHPersistentStack_pop(&rotation->_result));
+			CBHPersistentStack_dealloc(&rotation->_reversedFront);
+			rotation->_phase = CBHPersistentRotationPhaseDone;
+			break;
+
+		default:
+			break;
+	}
+}
+
+
+#pragma mark - Queues
+
+static CBHPersistentQueue_t CBHPersistentQueue_initSharing(const CBHPersistentQueue_t *queue)
+{
+	return (CBHPersistentQueue_t){
+		CBHPersistentStack_initSharing(&queue->_front),
+		queue->_frontCount,
+		CBHPersistentStack_initSharing(&queue->_rear),
+		CBHPersistentRotation_initSharing(&queue->_rotation),
+	};
+}
+
+static void CBHPersistentQueue_dealloc(CBHPersistentQueue_t *queue)
+{
+	CBHPersistentStack_dealloc(&queue->_front);
+	CBHPersistentStack_dealloc(&queue->_rear);
+	CBHPersistentRotation_dealloc(&queue->_rotation);
+	queue->_frontCount = 0;
+}
+
+/// Starts a rotation once the rear outgrows the front, and advances any under way by two steps.
+static void CBHPersistentQueue_check(CBHPersistentQueue_t *queue)
+{
+	/// Two steps per version always finish a rotation before the rear can outgrow the front again.
+	if ( queue->_rear._count > queue->_frontCount )
+	{
+		queue->_rotation._phase = CBHPersistentRotationPhaseReversing;
+		queue->_rotation._valid = 0;
+		queue->_rotation._front = CBHPersistentStack_initSharing(&queue->_front);
+		queue->_rotation._rear = queue->_rear;
+
+		queue->_frontCount += queue->_rear._count;
+		queue->_rear = CBHPersistentStack_init();
+	}
+
+	CBHPersistentRotation_step(&queue->_rotation);
+	CBHPersistentRotation_step(&queue->_rotation);
+
+	if ( queue->_rotation._phase != CBHPersistentRotationPhaseDone ) return;
+
+	CBHPersistentStack_dealloc(&queue->_front);
+	queue->_front = queue->_rotation._result;
+	queue->_rotation._result = CBHPersistentStack_init();
+
+	CBHPersistentRotation_dealloc(&queue->_rotation);
+}
+
+static void CBHPersistentQueue_enqueue(CBHPersistentQueue_t *queue, id object)
+{
+	CBHPersistentStack_replace(&queue->_rear, CBHPersistentStack_push(&queue->_rear, object));
+	CBHPersistentQueue_check(queue);
+}
+
+static void CBHPersistentQueue_dequeue(CBHPersistentQueue_t *queue)
+{
+	CBHPersistentStack_replace(&queue->_front, CBHPersistentStack_pop(&queue->_front));
+	--queue->_frontCount;
+
+	CBHPersistentRotation_invalidate(&queue->_rotation);
+	CBHPersistentQueue_check(queue);
+}
+
+/// Copies the objects after the front to `buffer`, the first first.
+static void CBHPersistentQueue_copyBack(const CBHPersistentQueue_t *queue, id __unsafe_unretained *buffer)
+{
+	const CBHPersistentRotation_t *rotation = &queue->_rotation;
+	CBHPersistentStack_t cursor = rotation->_result;
+	NSUInteger copied = 0;
+
+	switch ( rotation->_phase )
+	{
+		case CBHPersistentRotationPhaseReversing:
+			/// What is left of the old rear, then what has been moved of it.
+			CBHPersistentStack_copyFromBottom(&rotation->_rear, buffer);
+			copied = rotation->_rear._count;
+			copied += CBHPersistentStack_copyFromTop(&cursor, buffer + copied, cursor._count);
+			break;
+
+		case CBHPersistentRotationPhaseAppending:
+			/// Objects moved back from the old front are at the top of the result and still in the front.
+			CBHPersistentStack_dropFromTop(&cursor, queue->_front._count - (NSUInteger)rotation->_valid);
+			copied = CBHPersistentStack_copyFromTop(&cursor, buffer, cursor._count);
+			break;
+
+		default:
+			break;
+	}
+
+	CBHPersistentStack_copyFromBottom(&queue->_rear, buffer + copied);
+}
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface CBHPersistentQueue ()
+{
+	@protected
+	CBHPersistentQueue_t _queue;
+}
+
+
+#pragma mark - Initialization
+
+/// Takes over an initialized queue.
+- (instancetype)initWithQueue:(CBHPersistentQueue_t)queue;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+@implementation CBHPersistentQueue
+
+
+#define _count() (_queue._frontCount + _queue._rear._count)
+
+#define _cursorFromState(aState) (CBHPersistentStack_t){(CBHPersistentChunk_t *)(uintptr_t)(aState)->extra[0], (aState)->extra[1], (aState)->extra[2]}
+#define _saveCursorToState(aCursor, aState)\
+{\
+	(aState)->extra[0] = (unsigned long)(uintptr_t)(aCursor)._chunk;\
+	(aState)->extra[1] = (aCursor)._fill;\
+	(aState)->extra[2] = (aCursor)._count;\
+}
+
+
+#pragma mark - Factories
+
++ (instancetype)persistentQueue
+{
+	return [[(CBHPersistentQueue *)[self alloc] init] autorelease];
+}
+
++ (instancetype)persistentQueueWithArray:(NSArray *)array
+{
+	return [[(CBHPersistentQueue *)[self alloc] initWithArray:array] autorelease];
+}
+
+
+#pragma mark - Initialization
+
+- (instancetype)init
+{
+	return [self initWithArray:@[]];
+}
+
+- (instancetype)initWithArray:(NSArray *)array
+{
+	if ( (self = [super init]) )
+	{
+		const NSUInteger count = [array count];
+		if ( count <= 0 ) return self;
+
+		/// The whole array goes to the front, which holds the head on top.
+		id __unsafe_unretained *objects = CBHMemory_calloc(count, sizeof(id));
+		if ( !objects )
+		{
+			[self release];
+			@throw CBHCallocException;
+		}
+
+		[array getObjects:objects range:NSMakeRange(0, count)];
+		for (NSUInteger i = 0; i < count / 2; ++i)
+		{
+			id object = objects[i];
+			objects[i] = objects[count - 1 - i];
+			objects[count - 1 - i] = object;
+		}
+
+		_queue._front = CBHPersistentStack_initWithObjects(objects, count);
+		_queue._frontCount = count;
+		free(objects);
+	}
+
+	return self;
+}
+
+- (instancetype)initWithQueue:(CBHPersistentQueue_t)queue
+{
+	if ( (self = [super init]) )
+	{
+		_queue = queue;
+	}
+
+	return self;
+}
+
+
+#pragma mark Destructor
+
+- (void)dealloc
+{
+	CBHPersistentQueue_dealloc(&_queue);
+
+	[super dealloc];
+}
+
+
+#pragma mark Properties
+
+- (NSUInteger)count
+{
+	return _count();
+}
+
+- (NSUInteger)capacity
+{
+	return _count();
+}
+
+- (BOOL)isEmpty
+{
+	return ( _count() <= 0 );
+}
+
+
+#pragma mark - Copying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	/// Immutable, so a copy is the same queue.
+	return [self retain];
+}
+
+
+#pragma mark - Equality
+
+- (BOOL)isEqual:(id)other
+{
+	if ( [other isKindOfClass:[CBHPersistentQueue class]] ) return [self isEqualToPersistentQueue:other];
+	return [super isEqual:other];
+}
+
+- (BOOL)isEqualToPersistentQueue:(CBHPersistentQueue *)other
+{
+	/// Catch trivial cases.
+	if ( self == other ) return YES;
+	if ( _count() != other->_queue._frontCount + other->_queue._rear._count ) return NO;
+
+	const BOOL isIdle = ( _queue._rotation._phase == CBHPersistentRotationPhaseIdle && other->_queue._rotation._phase == CBHPersistentRotationPhaseIdle );
+	if ( isIdle && CBHPersistentStack_isShared(&_queue._front, &other->_queue._front) && CBHPersistentStack_isShared(&_queue._rear, &other->_queue._rear) ) return YES;
+
+	/// The same objects may be split differently between the stacks.
+	return [[self array] isEqualToArray:[other array]];
+}
+
+- (NSUInteger)hash
+{
+	/// Mix in the hash of every object, in order.
+	uint64_t hash = _count();
+
+	for (id object in self)
+	{
+		hash = CBHHash_mix(hash ^ (uint64_t)[object hash], 0x9e3779b97f4a7c15ull);
+	}
+
+	return (NSUInteger)hash;
+}
+
+
+#pragma mark - Description
+
+- (NSString *)description
+{
+	NSMutableString *description = [NSMutableString string];
+
+	[description appendString:@"("];
+
+	BOOL firstLoop = YES;
+	for (id object in self)
+	{
+		if ( !firstLoop ) { [description appendFormat:@",\n\t%@", object]; }
+		else
+		{
+			[description appendFormat:@"\n\t%@", object];
+			firstLoop = NO;
+		}
+	}
+	[description appendString:@"\n)"];
+
+	return [NSString stringWithString:description];
+}
+
+- (NSString *)debugDescription
+{
+	NSString *properties = [NSString stringWithFormat:@"\n{\n\tcount: %lu,\n\tfront: %lu,\n\trear: %lu\n},\n", _count(), _queue._frontCount, _queue._rear._count];
+	return [NSString stringWithFormat:@"<%@: %p>%@%@", [self class], (void *)self, properties, [self description]];
+}
+
+
+#pragma mark - Fast Enumeration
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id __unsafe_unretained [])buffer count:(NSUInteger)len
+{
+	/// Start from the top of the front. The queue is immutable so the mutations counter never changes.
+	if ( state->state == 0 )
+	{
+		_saveCursorToState(_queue._front, state);
+		state->extra[3] = 0;
+		state->mutationsPtr = &state->extra[3];
+		state->state = 1;
+	}
+
+	if ( state->state == 1 )
+	{
+		CBHPersistentStack_t cursor = _cursorFromState(state);
+		const NSUInteger count = CBHPersistentStack_copyFromTop(&cursor, buffer, len);
+		_saveCursorToState(cursor, state);
+
+		state->itemsPtr = buffer;
+		if ( count > 0 ) return count;
+
+		state->state = 2;
+		const NSUInteger remaining = _count() - _queue._front._count;
+		if ( remaining <= 0 ) return 0;
+
+		/// The rest isn't linked in order, so it is listed from a copy which lives in the autorelease pool.
+		NSMutableData *data = [NSMutableData dataWithLength:remaining * sizeof(id)];
+		CBHPersistentQueue_copyBack(&_queue, (id __unsafe_unretained *)[data mutableBytes]);
+
+		state->itemsPtr = (id __unsafe_unretained *)[data mutableBytes];
+		return remaining;
+	}
+
+	return 0;
+}
+
+
+#pragma mark - Conversion
+
+- (NSArray *)array
+{
+	const NSUInteger count = _count();
+	if ( count <= 0 ) return @[];
+
+	id __unsafe_unretained *objects = CBHMemory_calloc(count, sizeof(id));
+	if ( !objects ) @throw CBHCallocException;
+
+	CBHPersistentStack_t cursor = _queue._front;
+	CBHPersistentStack_copyFromTop(&cursor, objects, _queue._front._count);
+	CBHPersistentQueue_copyBack(&_queue, objects + _queue._front._count);
+
+	NSArray *array = [NSArray arrayWithObjects:objects count:count];
+	free(objects);
+
+	return array;
+}
+
+
+#pragma mark - Accessors
+
+- (id)peekAtObject
+{
+	return CBHPersistentStack_peek(&_queue._front);
+}
+
+
+#pragma mark - Versions
+
+- (CBHPersistentQueue *)queueByEnqueuingObject:(id)object
+{
+	CBHPersistentQueue_t queue = CBHPersistentQueue_initSharing(&_queue);
+	CBHPersistentQueue_enqueue(&queue, object);
+
+	return [[(CBHPersistentQueue *)[[self class] alloc] initWithQueue:queue] autorelease];
+}
+
+- (CBHPersistentQueue *)queueByEnqueuingObjectsFromArray:(NSArray *)array
+{
+	if ( [array count] <= 0 ) return self;
+
+	/// The versions in between are never seen, so they are kept as structs rather than queues.
+	CBHPersistentQueue_t queue = CBHPersistentQueue_initSharing(&_queue);
+	for (id object in array) { CBHPersistentQueue_enqueue(&queue, object); }
+
+	return [[(CBHPersistentQueue *)[[self class] alloc] initWithQueue:queue] autorelease];
+}
+
+- (CBHPersistentQueue *)queueByDequeuingObject
+{
+	if ( _count() <= 0 ) return self;
+
+	CBHPersistentQueue_t queue = CBHPersistentQueue_initSharing(&_queue);
+	CBHPersistentQueue_dequeue(&queue);
+
+	return [[(CBHPersistentQueue *)[[self class] alloc] initWithQueue:queue] autorelease];
+}
+
+@end
@@ -0,0 +1,130 @@
+//  CBHPersistentStack.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+@import Foundation;
+
+#import <CBHCollectionKit/CBHCollection.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** An immutable last-in-first-out collection of objects whose versions share structure.
+ *
+ * Pushing or popping returns a new stack in constant time and leaves the receiver untouched. Versions share the chunks of objects below their top, so keeping an old version as a snapshot costs nothing and copying is a retain.
+ *
+ * A push writes into the free slot of the shared top chunk when no other version has already taken it, otherwise it starts a new chunk. Chunks are released when the last version reaching them is, so a popped object lives as long as its chunk.
+ *
+ * Versions may be read, pushed to and popped from on any number of threads at once.
+ *
+ * @note: Unlike `CBHStack`, which lists objects from the bottom, a persistent stack lists them from the top, in the order they would be popped.
+ *
+ * @author    Christian Huxtable <chris@huxtable.ca>
+ */
+@interface CBHPersistentStack<ObjectType> : NSObject <NSCopying, NSFastEnumeration, CBHCollection>
+
+#pragma mark - Factories
+
++ (instancetype)persistentStack;
++ (instancetype)persistentStackWithArray:(NSArray<ObjectType> *)array;
+
+
+#pragma mark - Initialization
+
+- (instancetype)init;
+
+/** Initializes a stack holding the objects of `array`, in a single chunk.
+ *
+ * @param array    The objects to hold, the top first.
+ *
+ * @return         An initialized stack.
+ */
+- (instancetype)initWithArray:(NSArray<ObjectType> *)array NS_DESIGNATED_INITIALIZER;
+
+
+#pragma mark - Properties
+
+@property (nonatomic, readonly) NSUInteger count;
+
+/// The same as `count`, a persistent stack never holds free space of its own.
+@property (nonatomic, readonly) NSUInteger capacity;
+@property (nonatomic, readonly) BOOL isEmpty;
+
+
+#pragma mark - Copying
+
+- (id)copyWithZone:(nullable NSZone *)zone;
+
+
+#pragma mark - Equality
+
+- (BOOL)isEqual:(id)other;
+- (BOOL)isEqualToPersistentStack:(CBHPersistentStack<ObjectType> *)other;
+
+- (NSUInteger)hash;
+
+
+#pragma mark - Description
+
+- (NSString *)description;
+- (NSString *)debugDescription;
+
+
+#pragma mark - Fast Enumeration
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id __unsafe_unretained _Nullable [_Nonnull])buffer count:(NSUInteger)len;
+
+
+#pragma mark - Conversion
+
+/// The objects of the receiver, the top first.
+- (NSArray<ObjectType> *)array;
+
+
+#pragma mark - Accessors
+
+- (nullable ObjectType)peekAtObject;
+
+
+#pragma mark - Versions
+
+/** Returns a stack with `object` pushed on top of the receiver's objects.
+ *
+ * @param object    The object to push.
+ *
+ * @return          A new stack sharing the receiver's objects.
+ */
+- (CBHPersistentStack<ObjectType> *)stackByPushingObject:(ObjectType)object;
+
+/** Returns a stack with the objects of `array` pushed in order, so the last is on top.
+ *
+ * @param array    The objects to push.
+ *
+ * @return         A new stack sharing the receiver's objects.
+ */
+- (CBHPersistentStack<ObjectType> *)stackByPushingObjectsFromArray:(NSArray<ObjectType> *)array;
+
+/** Returns a stack without the receiver's top object.
+ *
+ * @return    A new stack sharing the receiver's remaining objects, or the receiver if it is empty.
+ */
+- (CBHPersistentStack<ObjectType> *)stackByPoppingObject;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,312 @@
+//  CBHPersistentStack.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#import "CBHPersistentStack.h"
+#import "_CBHPersistentStack.h"
+#import "_CBHHash.h"
+
+@import CBHMemoryKit;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface CBHPersistentStack ()
+{
+	@protected
+	CBHPersistentStack_t _stack;
+}
+
+
+#pragma mark - Initialization
+
+/// Takes over an initialized stack.
+- (instancetype)initWithStack:(CBHPersistentStack_t)stack;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+@implementation CBHPersistentStack
+
+
+/// Objects compared per step while walking two stacks together.
+#define COMPARISON_RUN 16
+
+#define _cursorFromState(aState) (CBHPersistentStack_t){(CBHPersistentChunk_t *)(uintptr_t)(aState)->extra[0], (aState)->extra[1], (aState)->extra[2]}
+#define _saveCursorToState(aCursor, aState)\
+{\
+	(aState)->extra[0] = (unsigned long)(uintptr_t)(aCursor)._chunk;\
+	(aState)->extra[1] = (aCursor)._fill;\
+	(aState)->extra[2] = (aCursor)._count;\
+}
+
+
+#pragma mark - Factories
+
++ (instancetype)persistentStack
+{
+	return [[(CBHPersistentStack *)[self alloc] init] autorelease];
+}
+
++ (instancetype)persistentStackWithArray:(NSArray *)array
+{
+	return [[(CBHPersistentStack *)[self alloc] initWithArray:array] autorelease];
+}
+
+
+#pragma mark - Initialization
+
+- (instancetype)init
+{
+	return [self initWithArray:@[]];
+}
+
+- (instancetype)initWithArray:(NSArray *)array
+{
+	if ( (self = [super init]) )
+	{
+		const NSUInteger count = [array count];
+		if ( count <= 0 ) return self;
+
+		/// The array lists the top first and the chunk holds the bottom first.
+		id __unsafe_unretained *objects = CBHMemory_calloc(count, sizeof(id));
+		if ( !objects ) @throw CBHCallocException;
+		[array getObjects:objects range:NSMakeRange(0, count)];
+		for (NSUInteger i = 0; i < count / 2; ++i)
+		{
+			id object = objects[i];
+			objects[i] = objects[count - 1 - i];
+			objects[count - 1 - i] = object;
+		}
+
+		_stack = CBHPersistentStack_initWithObjects(objects, count);
+		free(objects);
+	}
+
+	return self;
+}
+
+- (instancetype)initWithStack:(CBHPersistentStack_t)stack
+{
+	if ( (self = [super init]) )
+	{
+		_stack = stack;
+	}
+
+	return self;
+}
+
+
+#pragma mark Destructor
+
+- (void)dealloc
+{
+	CBHPersistentStack_dealloc(&_stack);
+
+	[super dealloc];
+}
+
+
+#pragma mark Properties
+
+- (NSUInteger)count
+{
+	return _stack._count;
+}
+
+- (NSUInteger)capacity
+{
+	return _stack._count;
+}
+
+- (BOOL)isEmpty
+{
+	return ( _stack._count <= 0 );
+}
+
+
+#pragma mark - Copying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	/// Immutable, so a copy is the same stack.
+	return [self retain];
+}
+
+
+#pragma mark - Equality
+
+- (BOOL)isEqual:(id)other
+{
+	if ( [other isKindOfClass:[CBHPersistentStack class]] ) return [self isEqualToPersistentStack:other];
+	return [super isEqual:other];
+}
+
+- (BOOL)isEqualToPersistentStack:(CBHPersistentStack *)other
+{
+	/// Catch trivial cases.
+	if ( self == other ) return YES;
+	if ( _stack._count != other->_stack._count ) return NO;
+
+	id __unsafe_unretained objects0[COMPARISON_RUN];
+	id __unsafe_unretained objects1[COMPARISON_RUN];
+
+	CBHPersistentStack_t cursor0 = _stack;
+	CBHPersistentStack_t cursor1 = other->_stack;
+
+	/// Compare runs from the top until the stacks reach a shared version, below which they are the same.
+	while ( !CBHPersistentStack_isShared(&cursor0, &cursor1) )
+	{
+		const NSUInteger count = CBHPersistentStack_copyFromTop(&cursor0, objects0, COMPARISON_RUN);
+		CBHPersistentStack_copyFromTop(&cursor1, objects1, COMPARISON_RUN);
+
+		/// Early return on failure.
+		for (NSUInteger i = 0; i < count; ++i)
+		{
+			if ( ![objects0[i] isEqual:objects1[i]] ) return NO;
+		}
+	}
+
+	return YES;
+}
+
+- (NSUInteger)hash
+{
+	/// Mix in the hash of every object, in order.
+	uint64_t hash = _stack._count;
+
+	for (id object in self)
+	{
+		hash = CBHHash_mix(hash ^ (uint64_t)[object hash], 0x9e3779b97f4a7c15ull);
+	}
+
+	return (NSUInteger)hash;
+}
+
+
+#pragma mark - Description
+
+- (NSString *)description
+{
+	NSMutableString *description = [NSMutableString string];
+
+	[description appendString:@"("];
+
+	BOOL firstLoop = YES;
+	for (id object in self)
+	{
+		if ( !firstLoop ) { [description appendFormat:@",\n\t%@", object]; }
+		else
+		{
+			[description appendFormat:@"\n\t%@", object];
+			firstLoop = NO;
+		}
+	}
+	[description appendString:@"\n)"];
+
+	return [NSString stringWithString:description];
+}
+
+- (NSString *)debugDescription
+{
+	NSString *properties = [NSString stringWithFormat:@"\n{\n\tcount: %lu\n},\n", _stack._count];
+	return [NSString stringWithFormat:@"<%@: %p>%@%@", [self class], (void *)self, properties, [self description]];
+}
+
+
+#pragma mark - Fast Enumeration
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id __unsafe_unretained [])buffer count:(NSUInteger)len
+{
+	/// Start from the top. The stack is immutable so the mutations counter never changes.
+	if ( state->state == 0 )
+	{
+		_saveCursorToState(_stack, state);
+		state->extra[3] = 0;
+		state->mutationsPtr = &state->extra[3];
+		state->state = 1;
+	}
+
+	/// Copy the next run, the chunks hold their objects bottom first.
+	CBHPersistentStack_t cursor = _cursorFromState(state);
+	const NSUInteger count = CBHPersistentStack_copyFromTop(&cursor, buffer, len);
+	_saveCursorToState(cursor, state);
+
+	state->itemsPtr = buffer;
+	return count;
+}
+
+
+#pragma mark - Conversion
+
+- (NSArray *)array
+{
+	if ( _stack._count <= 0 ) return @[];
+
+	id __unsafe_unretained *objects = CBHMemory_calloc(_stack._count, sizeof(id));
+	if ( !objects ) @throw CBHCallocException;
+	CBHPersistentStack_t cursor = _stack;
+	CBHPersistentStack_copyFromTop(&cursor, objects, _stack._count);
+
+	NSArray *array = [NSArray arrayWithObjects:objects count:_stack._count];
+	free(objects);
+
+	return array;
+}
+
+
+#pragma mark - Accessors
+
+- (id)peekAtObject
+{
+	return CBHPersistentStack_peek(&_stack);
+}
+
+
+#pragma mark - Versions
+
+- (CBHPersistentStack *)stackByPushingObject:(id)object
+{
+	return [[(CBHPersistentStack *)[[self class] alloc] initWithStack:CBHPersistentStack_push(&_stack, object)] autorelease];
+}
+
+- (CBHPersistentStack *)stackByPushingObjectsFromArray:(NSArray *)array
+{
+	if ( [array count] <= 0 ) return self;
+
+	/// Only the first push can meet another version, the rest extend chunks no one else reaches.
+	CBHPersistentStack_t stack = CBHPersistentStack_initSharing(&_stack);
+	for (id object in array)
+	{
+		CBHPersistentStack_t next = CBHPersistentStack_push(&stack, object);
+		CBHPersistentStack_dealloc(&stack);
+		stack = next;
+	}
+
+	return [[(CBHPersistentStack *)[[self class] alloc] initWithStack:stack] autorelease];
+}
+
+- (CBHPersistentStack *)stackByPoppingObject
+{
+	if ( _stack._count <= 0 ) return self;
+	return [[(CBHPersistentStack *)[[self class] alloc] initWithStack:CBHPersistentStack_pop(&_stack)] autorelease];
+}
+
+@end
@@ -18,9 +18,15 @@
 
 #import "CBHQueue.h"
 #import "_CBHQueue.h"
+#import "_CBHBuffer.h"
+#import "_CBHReuse.h"
+#import "_CBHHash.h"
+#import "_CBHParallel.h"
 
 
 #define DEFAULT_CAPACITY 8
+#define DECODING_CAPACITY 65536
+#define CODER_KEY @"CBHObjects"
 #define GROWTH_FACTOR 1.618033988749895
 
 #define _nextCapacity(aCapacity) (size_t)ceil((double)(aCapacity) * GROWTH_FACTOR)
@@ -34,20 +40,33 @@
 {\
 	[anObject retain];\
 	CBHQueue_enqueue((aQueue), &(anObject));\
+	++_mutations;\
 }
 #define _dequeueObject() [(id)CBHQueue_dequeue(&_queue) autorelease];
 #define _peekObject() (id)CBHQueue_peek(&_queue)
 
 #define _guardNotEmpty(retVal) if ( _queue._count <= 0 ) return (retVal)
 
+/// Shared storage is copied before writing and the copy needs its own references.
+#define _makeUnique() CBHQueue_makeUniqueRetainingObjects(&_queue)
+
 
 NS_ASSUME_NONNULL_BEGIN
 
 @interface CBHQueue ()
 {
 	CBHQueue_t _queue;
+
+	/// Bumped by every mutation so fast enumeration can detect them.
+	unsigned long _mutations;
 }
 
+
+#pragma mark - Initialization
+
+/// Takes over an initialized queue.
+- (instancetype)initWithQueue:(CBHQueue_t)queue;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -67,6 +86,11 @@ NS_ASSUME_NONNULL_END
 	return [[(CBHQueue *)[self alloc] initWithCapacity:capacity] autorelease];
 }
 
++ (instancetype)queueWithCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options
+{
+	return [[(CBHQueue *)[self alloc] initWithCapacity:capacity options:options] autorelease];
+}
+
 + (instancetype)queueWithObjects:(id)object, ...
 {
 	va_list arguments;
@@ -95,6 +119,15 @@ NS_ASSUME_NONNULL_END
 }
 
 
+#pragma mark - Allocation
+
++ (instancetype)allocWithZone:(NSZone *)zone
+{
+	/// Small collections keep their entries inside the object rather than allocating a buffer.
+	return CBHBuffer_allocInlineObject(self);
+}
+
+
 #pragma mark - Initialization
 
 - (instancetype)init
@@ -103,10 +136,15 @@ NS_ASSUME_NONNULL_END
 }
 
 - (instancetype)initWithCapacity:(NSUInteger)capacity
+{
+	return [self initWithCapacity:capacity options:CBHAllocationOptionsDefault];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options
 {
 	if ( (self = [super init]) )
 	{
-		_queue = CBHQueue_init(capacity, sizeof(id));
+		_queue = CBHQueue_initInline(CBHBuffer_inlineBytes(self), capacity, sizeof(id), &options);
 	}
 
 	return self;
@@ -171,12 +209,68 @@ NS_ASSUME_NONNULL_END
 	return self;
 }
 
+- (instancetype)initWithQueue:(CBHQueue_t)queue
+{
+	if ( (self = [super init]) )
+	{
+		_queue = queue;
+	}
+
+	return self;
+}
+
+- (instancetype)initWithCollectionDecoder:(CBHCollectionDecoder *)decoder codec:(id<CBHObjectCodec>)codec
+{
+	NSUInteger count = 0;
+	if ( ![decoder beginObjects:&count] )
+	{
+		[self release];
+		return nil;
+	}
+
+	/// The count is only trusted as far as a reasonable capacity, the queue grows if it was honest.
+	if ( !(self = [self initWithCapacity:MAX(MIN(count, DECODING_CAPACITY), 1)]) ) return nil;
+
+	@autoreleasepool
+	{
+		for (NSUInteger i = 0; i < count; ++i)
+		{
+			id object = [decoder decodeObjectWithCodec:codec];
+			if ( !object ) break;
+
+			_enqueueObject(&_queue, object);
+		}
+	}
+
+	if ( ![decoder endObjects] )
+	{
+		[self release];
+		return nil;
+	}
+
+	return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)coder
+{
+	NSSet *classes = [([coder allowedClasses] ?: [NSSet set]) setByAddingObject:[NSArray class]];
+	NSArray *array = [coder decodeObjectOfClasses:classes forKey:CODER_KEY];
+	if ( ![array isKindOfClass:[NSArray class]] )
+	{
+		[self release];
+		return nil;
+	}
+
+	return [self initWithArray:array];
+}
+
 
 #pragma mark - Destructor
 
 - (void)dealloc
 {
-	[self removeAllObjects];
+	/// Objects in shared storage stay with the collections still sharing it.
+	if ( !CBHSlice_releaseShared((CBHSlice_t *)&_queue) ) [self removeAllObjects];
 	CBHQueue_dealloc(&_queue);
 
 	[super dealloc];
@@ -205,14 +299,8 @@ NS_ASSUME_NONNULL_END
 
 - (id)copyWithZone:(nullable NSZone *)zone
 {
-	CBHQueue *queue = [(CBHQueue *)[[self class] allocWithZone:zone] initWithCapacity:_queue._count];
-
-	for (id object in self)
-	{
-		_enqueueObject(&queue->_queue, object);
-	}
-
-	return queue;
+	/// Shares the storage and its references, whichever queue is written to first copies them.
+	return [(CBHQueue *)[[self class] allocWithZone:zone] initWithQueue:CBHQueue_initSharing(&_queue)];
 }
 
 
@@ -246,29 +334,15 @@ NS_ASSUME_NONNULL_END
 
 - (NSUInteger)hash
 {
-	/// Mix in properties.
-	NSUInteger hash = ((_queue._capacity * 3) * 31);
-	NSUInteger count = _queue._count;
+	/// Mix in the hash of every object, in order.
+	uint64_t hash = _queue._count;
 
-	/// XOR in middle object hash.
-	if ( count >= 3 )
-	{
-		hash ^= [_objectAtIndex(&_queue, (NSUInteger)((float)count / 2.0f)) hash] * 71;
-	}
-
-	/// XOR in last object hash.
-	if ( count >= 2 )
-	{
-		hash ^= [_objectAtIndex(&_queue, count - 1) hash] * 61;
-	}
-
-	/// XOR in first object hash.
-	if ( count >= 1 )
+	for (NSUInteger i = 0; i < _queue._count; ++i)
 	{
-		hash ^= [_objectAtIndex(&_queue, 0) hash] * 41;
+		hash = CBHHash_mix(hash ^ (uint64_t)[_objectAtIndex(&_queue, i) hash], 0x9e3779b97f4a7c15ull);
 	}
 
-	return hash;
+	return (NSUInteger)hash;
 }
 
 
@@ -309,7 +383,7 @@ NS_ASSUME_NONNULL_END
 		/// Return early if second iteration.
 		if ( state->state > 0 ) return 0;
 
-		state->mutationsPtr = (unsigned long *)(__bridge void *)self;
+		state->mutationsPtr = &_mutations;
 		state->itemsPtr = _objectArray();
 		state->state = 1;
 		return _queue._count;
@@ -320,7 +394,7 @@ NS_ASSUME_NONNULL_END
 	{
 		/// Return the first half.
 		state->state = 1;
-		state->mutationsPtr = (unsigned long *)(__bridge void *)self;
+		state->mutationsPtr = &_mutations;
 		state->itemsPtr = _objectArray();
 		return _queue._capacity - _queue._offset;
 	}
@@ -336,6 +410,38 @@ NS_ASSUME_NONNULL_END
 }
 
 
+#pragma mark - Block Enumeration
+
+- (void)enumerateObjectsUsingBlock:(void (NS_NOESCAPE ^)(id object, NSUInteger index, BOOL *stop))block
+{
+	[self enumerateObjectsWithOptions:0 usingBlock:block];
+}
+
+- (void)enumerateObjectsWithOptions:(NSEnumerationOptions)options usingBlock:(void (NS_NOESCAPE ^)(id object, NSUInteger index, BOOL *stop))block
+{
+	if ( _queue._count <= 0 ) return;
+
+	void (^objectBlock)(const void *, NSUInteger, BOOL *) = ^(const void *entry, NSUInteger index, BOOL *stop) {
+		block(*(const id *)entry, index, stop);
+	};
+
+	/// The ring is at most two contiguous runs: from the head to the end of the buffer, then from the start of the buffer to the tail.
+	const NSUInteger headCount = ( CBHQueue_isSegmented(&_queue) ) ? _queue._capacity - _queue._offset : _queue._count;
+	const NSUInteger tailCount = _queue._count - headCount;
+	const void *head = CBHQueue_pointerToIndex(&_queue, 0);
+
+	if ( options & NSEnumerationReverse )
+	{
+		if ( CBHParallel_enumerate(_queue._data, tailCount, sizeof(id), headCount, options, objectBlock) ) return;
+		CBHParallel_enumerate(head, headCount, sizeof(id), 0, options, objectBlock);
+		return;
+	}
+
+	if ( CBHParallel_enumerate(head, headCount, sizeof(id), 0, options, objectBlock) ) return;
+	CBHParallel_enumerate(_queue._data, tailCount, sizeof(id), headCount, options, objectBlock);
+}
+
+
 #pragma mark - Conversion
 
 - (NSArray *)array
@@ -391,6 +497,32 @@ NS_ASSUME_NONNULL_END
 }
 
 
+#pragma mark - Serialization
+
++ (BOOL)supportsSecureCoding
+{
+	return YES;
+}
+
+- (BOOL)encodeWithCollectionEncoder:(CBHCollectionEncoder *)encoder codec:(id<CBHObjectCodec>)codec
+{
+	BOOL success = [encoder beginObjects:_queue._count];
+
+	for (NSUInteger i = 0; i < _queue._count && success; ++i)
+	{
+		success = [encoder encodeObject:_objectAtIndex(&_queue, i) withCodec:codec];
+	}
+
+	/// Always closes the collection, even after a failure.
+	return [encoder endObjects] && success;
+}
+
+- (void)encodeWithCoder:(NSCoder *)coder
+{
+	[coder encodeObject:[self array] forKey:CODER_KEY];
+}
+
+
 #pragma mark - Accessors
 
 - (id)peekAtObject
@@ -410,11 +542,14 @@ NS_ASSUME_NONNULL_END
 
 - (void)enqueueObject:(id)object
 {
+	_makeUnique();
 	_enqueueObject(&_queue, object);
 }
 
 - (id)dequeueObject
 {
+	_makeUnique();
+	++_mutations;
 	return _dequeueObject();
 }
 
@@ -424,6 +559,8 @@ NS_ASSUME_NONNULL_END
 	va_list arguments;
 	va_start(arguments, object);
 
+	_makeUnique();
+
 	id __nullable current = object;
 	while ( current )
 	{
@@ -437,6 +574,7 @@ NS_ASSUME_NONNULL_END
 - (void)enqueueObjectsFromArray:(NSArray *)array
 {
 	/// Grow once to fit addition objects.
+	_makeUnique();
 	[self growToFit:([array count] + _queue._count)];
 
 	/// Enqueue objects.
@@ -446,6 +584,7 @@ NS_ASSUME_NONNULL_END
 - (void)enqueueObjectsFromOrderedSet:(NSOrderedSet *)set
 {
 	/// Grow once to fit addition objects.
+	_makeUnique();
 	[self growToFit:([set count] + _queue._count)];
 
 	/// Enqueue objects.
@@ -455,6 +594,7 @@ NS_ASSUME_NONNULL_END
 - (void)enqueueObjectsFromEnumerator:(id <NSFastEnumeration>)enumerator
 {
 	/// Enqueue objects.
+	_makeUnique();
 	for (id object in enumerator) { _enqueueObject(&_queue, object); }
 }
 
@@ -482,6 +622,18 @@ NS_ASSUME_NONNULL_END
 
 - (void)removeAllObjects
 {
+	++_mutations;
+
+	/// Drop shared storage rather than copying it only to release the copies.
+	const NSUInteger capacity = _queue._capacity;
+	if ( CBHSlice_releaseShared((CBHSlice_t *)&_queue) )
+	{
+		CBHSlice_setCapacity((CBHSlice_t *)&_queue, capacity, NO);
+		_queue._count = 0;
+		_queue._offset = 0;
+		return;
+	}
+
 	/// Release stored objects.
 	for (NSUInteger i = 0; i < _queue._count; ++i)
 	{
@@ -503,6 +655,8 @@ NS_ASSUME_NONNULL_END
 	if ( newCapacity < 1 ) newCapacity = 1;
 
 	/// Shrink.
+	_makeUnique();
+	++_mutations;
 	return CBHQueue_shrinkTo(&_queue, newCapacity);
 }
 
@@ -512,6 +666,8 @@ NS_ASSUME_NONNULL_END
 	if ( _queue._capacity > _queue._count ) return NO;
 
 	/// Grow.
+	_makeUnique();
+	++_mutations;
 	return CBHQueue_growTo(&_queue, _nextCapacity(_queue._capacity));
 }
 
@@ -525,13 +681,35 @@ NS_ASSUME_NONNULL_END
 	while ( neededCapacity > nextCapacity ) { nextCapacity = _nextCapacity(nextCapacity); }
 
 	/// Grow to new capacity.
+	_makeUnique();
+	++_mutations;
 	CBHQueue_growTo(&_queue, nextCapacity);
 	return YES;
 }
 
 - (BOOL)resize:(NSUInteger)newCapacity
 {
+	_makeUnique();
+	++_mutations;
 	return CBHQueue_resize(&_queue, newCapacity);
 }
 
 @end
+
+
+#pragma mark - Reuse
+
+@implementation CBHQueue (Reuse)
+
+- (BOOL)isReusable
+{
+	return ( !_queue._owner && !_queue._options.allocator );
+}
+
+- (size_t)reusableLength
+{
+	const size_t bufferLength = ( _queue._isInline ) ? 0 : _queue._capacity * _queue._entrySize;
+	return CBHBuffer_inlineObjectSize([self class]) + bufferLength;
+}
+
+@end
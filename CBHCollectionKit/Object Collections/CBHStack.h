@@ -19,6 +19,8 @@
 @import Foundation;
 
 #import <CBHCollectionKit/CBHCollection.h>
+#import <CBHCollectionKit/CBHCollectionCoder.h>
+#import <CBHCollectionKit/CBHAllocation.h>
 
 
 NS_ASSUME_NONNULL_BEGIN
@@ -29,12 +31,13 @@ NS_ASSUME_NONNULL_BEGIN
  *
  * @author    Christian Huxtable <chris@huxtable.ca>
  */
-@interface CBHStack<ObjectType> : NSObject <NSCopying, NSFastEnumeration, CBHCollectionResizable>
+@interface CBHStack<ObjectType> : NSObject <NSCopying, NSSecureCoding, NSFastEnumeration, CBHCollectionResizable>
 
 #pragma mark - Factories
 
 + (instancetype)stack;
 + (instancetype)stackWithCapacity:(NSUInteger)capacity;
++ (instancetype)stackWithCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options;
 + (instancetype)stackWithObjects:(nullable ObjectType)object, ... NS_REQUIRES_NIL_TERMINATION;
 
 + (instancetype)stackWithArray:(NSArray<ObjectType> *)array;
@@ -45,13 +48,33 @@ NS_ASSUME_NONNULL_BEGIN
 #pragma mark - Initialization
 
 - (instancetype)init;
-- (instancetype)initWithCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+- (instancetype)initWithCapacity:(NSUInteger)capacity;
+
+/** Initializes an empty stack whose buffer is allocated as described by `options`.
+ *
+ * @param capacity    The number of objects the stack can hold before growing.
+ * @param options     The alignment, paging, and allocator of the stack's buffer.
+ *
+ * @return            An initialized empty stack.
+ */
+- (instancetype)initWithCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options NS_DESIGNATED_INITIALIZER;
 - (instancetype)initWithObjects:(nullable ObjectType)object, ... NS_REQUIRES_NIL_TERMINATION;
 
 - (instancetype)initWithArray:(NSArray<ObjectType> *)array;
 - (instancetype)initWithOrderedSet:(NSOrderedSet<ObjectType> *)set;
 - (instancetype)initWithEnumerator:(id<NSFastEnumeration>)enumerator;
 
+/** Initializes a newly allocated stack with the next object collection read by `decoder`.
+ *
+ * @param decoder    The decoder to read from.
+ * @param codec      The codec used to read each object.
+ *
+ * @return           A newly initialized stack, or `nil` if the collection could not be read. The reason is left in the decoder's `error`.
+ */
+- (nullable instancetype)initWithCollectionDecoder:(CBHCollectionDecoder *)decoder codec:(id<CBHObjectCodec>)codec;
+
+- (nullable instancetype)initWithCoder:(NSCoder *)coder;
+
 
 #pragma mark - Properties
 
@@ -84,6 +107,26 @@ NS_ASSUME_NONNULL_BEGIN
 - (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id __unsafe_unretained _Nullable [_Nonnull])buffer count:(NSUInteger)len;
 
 
+#pragma mark - Block Enumeration
+
+/** Calls a block with each object of the receiver, from the bottom.
+ *
+ * The receiver must not be mutated from within the block.
+ *
+ * @param block    The block to call with an object, its index, and a flag which stops the enumeration when set to `YES`.
+ */
+- (void)enumerateObjectsUsingBlock:(void (NS_NOESCAPE ^)(ObjectType object, NSUInteger index, BOOL *stop))block;
+
+/** Calls a block with each object of the receiver, as described by `options`.
+ *
+ * With `NSEnumerationConcurrent` the objects are split into chunks which are enumerated concurrently, so the block may be called from several threads at once and in any order. With `NSEnumerationReverse` the objects, or the objects within each chunk, are visited from the top.
+ *
+ * @param options    The options for the enumeration.
+ * @param block      The block to call with an object, its index, and a flag which stops the enumeration when set to `YES`.
+ */
+- (void)enumerateObjectsWithOptions:(NSEnumerationOptions)options usingBlock:(void (NS_NOESCAPE ^)(ObjectType object, NSUInteger index, BOOL *stop))block;
+
+
 #pragma mark - Conversion
 
 - (NSArray<ObjectType> *)array;
@@ -93,6 +136,22 @@ NS_ASSUME_NONNULL_BEGIN
 - (NSMutableOrderedSet<ObjectType> *)mutableOrderedSet;
 
 
+#pragma mark - Serialization
+
+/** Writes the objects of the receiver to `encoder` in the binary collection format, in the same order as `array`.
+ *
+ * @param encoder    The encoder to write to.
+ * @param codec      The codec used to write each object.
+ *
+ * @return           `YES` if the receiver was written, otherwise `NO`. The reason is left in the encoder's `error`.
+ */
+- (BOOL)encodeWithCollectionEncoder:(CBHCollectionEncoder *)encoder codec:(id<CBHObjectCodec>)codec;
+
+/** Encodes the objects of the receiver. Each object must conform to `NSSecureCoding`.
+ */
+- (void)encodeWithCoder:(NSCoder *)coder;
+
+
 #pragma mark - Accessors
 
 - (nullable ObjectType)peekAtObject;
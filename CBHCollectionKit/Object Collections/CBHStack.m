@@ -18,6 +18,10 @@
 
 #import "CBHStack.h"
 #import "_CBHStack.h"
+#import "_CBHBuffer.h"
+#import "_CBHReuse.h"
+#import "_CBHHash.h"
+#import "_CBHParallel.h"
 
 
 NS_ASSUME_NONNULL_BEGIN
@@ -26,6 +30,9 @@ NS_ASSUME_NONNULL_BEGIN
 {
 	@protected
 	CBHStack_t _stack;
+
+	/// Bumped by every mutation so fast enumeration can detect them.
+	unsigned long _mutations;
 }
 
 
@@ -33,6 +40,9 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (instancetype)initWithFirstObject:(id)object andArgumentList:(va_list)argList;
 
+/// Takes over an initialized stack.
+- (instancetype)initWithStack:(CBHStack_t)stack;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -42,6 +52,8 @@ NS_ASSUME_NONNULL_END
 
 
 #define DEFAULT_CAPACITY 8
+#define DECODING_CAPACITY 65536
+#define CODER_KEY @"CBHObjects"
 #define GROWTH_FACTOR 1.618033988749895
 
 #define _nextCapacity(aCapacity) (size_t)ceil((double)(aCapacity) * GROWTH_FACTOR)
@@ -52,10 +64,14 @@ NS_ASSUME_NONNULL_END
 
 #define _objectArray() (id *)_stack._data
 
+/// Shared storage is copied before writing and the copy needs its own references.
+#define _makeUnique() CBHStack_makeUniqueRetainingObjects(&_stack)
+
 #define _pushObject(aQueue, anObject)\
 {\
 	[anObject retain];\
 	CBHStack_pushValue((aQueue), &(anObject));\
+	++_mutations;\
 }
 #define _popObject() [(id)CBHStack_popValue(&_stack) autorelease]
 #define _peekObject() (id)CBHStack_peekValue(&_stack)
@@ -76,6 +92,11 @@ NS_ASSUME_NONNULL_END
 	return [[(CBHStack *)[self alloc] initWithCapacity:capacity] autorelease];
 }
 
++ (instancetype)stackWithCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options
+{
+	return [[(CBHStack *)[self alloc] initWithCapacity:capacity options:options] autorelease];
+}
+
 + (instancetype)stackWithObjects:(id)object, ...
 {
 	va_list arguments;
@@ -104,6 +125,15 @@ NS_ASSUME_NONNULL_END
 }
 
 
+#pragma mark - Allocation
+
++ (instancetype)allocWithZone:(NSZone *)zone
+{
+	/// Small collections keep their entries inside the object rather than allocating a buffer.
+	return CBHBuffer_allocInlineObject(self);
+}
+
+
 #pragma mark - Initialization
 
 - (instancetype)init
@@ -112,10 +142,15 @@ NS_ASSUME_NONNULL_END
 }
 
 - (instancetype)initWithCapacity:(NSUInteger)capacity
+{
+	return [self initWithCapacity:capacity options:CBHAllocationOptionsDefault];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options
 {
 	if ( (self = [super init]) )
 	{
-		_stack = CBHStack_init(capacity, sizeof(id));
+		_stack = CBHStack_initInline(CBHBuffer_inlineBytes(self), capacity, sizeof(id), &options);
 	}
 
 	return self;
@@ -180,12 +215,69 @@ NS_ASSUME_NONNULL_END
 	return self;
 }
 
+- (instancetype)initWithStack:(CBHStack_t)stack
+{
+	if ( (self = [super init]) )
+	{
+		_stack = stack;
+	}
+
+	return self;
+}
+
+- (instancetype)initWithCollectionDecoder:(CBHCollectionDecoder *)decoder codec:(id<CBHObjectCodec>)codec
+{
+	NSUInteger count = 0;
+	if ( ![decoder beginObjects:&count] )
+	{
+		[self release];
+		return nil;
+	}
+
+	/// The count is only trusted as far as a reasonable capacity, the stack grows if it was honest.
+	if ( !(self = [self initWithCapacity:MAX(MIN(count, DECODING_CAPACITY), 1)]) ) return nil;
+
+	@autoreleasepool
+	{
+		for (NSUInteger i = 0; i < count; ++i)
+		{
+			id object = [decoder decodeObjectWithCodec:codec];
+			if ( !object ) break;
+
+			_growIfNeeded();
+			_pushObject(&_stack, object);
+		}
+	}
+
+	if ( ![decoder endObjects] )
+	{
+		[self release];
+		return nil;
+	}
+
+	return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)coder
+{
+	NSSet *classes = [([coder allowedClasses] ?: [NSSet set]) setByAddingObject:[NSArray class]];
+	NSArray *array = [coder decodeObjectOfClasses:classes forKey:CODER_KEY];
+	if ( ![array isKindOfClass:[NSArray class]] )
+	{
+		[self release];
+		return nil;
+	}
+
+	return [self initWithArray:array];
+}
+
 
 #pragma mark Destructor
 
 - (void)dealloc
 {
-	[self removeAllObjects];
+	/// Objects in shared storage stay with the collections still sharing it.
+	if ( !CBHSlice_releaseShared((CBHSlice_t *)&_stack) ) [self removeAllObjects];
 	CBHStack_dealloc(&_stack);
 
 	[super dealloc];
@@ -214,14 +306,8 @@ NS_ASSUME_NONNULL_END
 
 - (id)copyWithZone:(NSZone *)zone
 {
-	CBHStack *stack = [(CBHStack *)[[self class] allocWithZone:zone] initWithCapacity:_stack._capacity];
-
-	for (id object in self)
-	{
-		_pushObject(&stack->_stack, object);
-	}
-
-	return stack;
+	/// Shares the storage and its references, whichever stack is written to first copies them.
+	return [(CBHStack *)[[self class] allocWithZone:zone] initWithStack:CBHStack_initSharing(&_stack)];
 }
 
 
@@ -255,28 +341,15 @@ NS_ASSUME_NONNULL_END
 
 - (NSUInteger)hash
 {
-	/// Mix in properties.
-	NSUInteger hash = ((_stack._capacity * 3) * 31);
+	/// Mix in the hash of every object, in order.
+	uint64_t hash = _stack._count;
 
-	/// XOR in middle object hash.
-	if ( _stack._count >= 3 )
-	{
-		hash ^= [_objectAtIndex(&_stack, (NSUInteger)((float)_stack._count / 2.0f)) hash] * 71;
-	}
-
-	/// XOR in last object hash.
-	if ( _stack._count >= 2 )
-	{
-		hash ^= [_objectAtIndex(&_stack, _stack._count - 1) hash] * 61;
-	}
-
-	/// XOR in first object hash.
-	if ( _stack._count >= 1 )
+	for (NSUInteger i = 0; i < _stack._count; ++i)
 	{
-		hash ^= [_objectAtIndex(&_stack, 0) hash] * 41;
+		hash = CBHHash_mix(hash ^ (uint64_t)[_objectAtIndex(&_stack, i) hash], 0x9e3779b97f4a7c15ull);
 	}
 
-	return hash;
+	return (NSUInteger)hash;
 }
 
 
@@ -318,13 +391,28 @@ NS_ASSUME_NONNULL_END
 	if ( state->state != 0 ) return 0;
 
 	/// Return the data directly.
-	state->mutationsPtr = (unsigned long *)(__bridge void *)self;
+	state->mutationsPtr = &_mutations;
 	state->itemsPtr = _objectArray();
 	state->state = 1;
 	return _stack._count;
 }
 
 
+#pragma mark - Block Enumeration
+
+- (void)enumerateObjectsUsingBlock:(void (NS_NOESCAPE ^)(id object, NSUInteger index, BOOL *stop))block
+{
+	[self enumerateObjectsWithOptions:0 usingBlock:block];
+}
+
+- (void)enumerateObjectsWithOptions:(NSEnumerationOptions)options usingBlock:(void (NS_NOESCAPE ^)(id object, NSUInteger index, BOOL *stop))block
+{
+	CBHParallel_enumerate(_stack._data, _stack._count, sizeof(id), 0, options, ^(const void *entry, NSUInteger index, BOOL *stop) {
+		block(*(const id *)entry, index, stop);
+	});
+}
+
+
 #pragma mark - Conversion
 
 - (NSArray *)array
@@ -348,6 +436,32 @@ NS_ASSUME_NONNULL_END
 }
 
 
+#pragma mark - Serialization
+
++ (BOOL)supportsSecureCoding
+{
+	return YES;
+}
+
+- (BOOL)encodeWithCollectionEncoder:(CBHCollectionEncoder *)encoder codec:(id<CBHObjectCodec>)codec
+{
+	BOOL success = [encoder beginObjects:_stack._count];
+
+	for (NSUInteger i = 0; i < _stack._count && success; ++i)
+	{
+		success = [encoder encodeObject:_objectAtIndex(&_stack, i) withCodec:codec];
+	}
+
+	/// Always closes the collection, even after a failure.
+	return [encoder endObjects] && success;
+}
+
+- (void)encodeWithCoder:(NSCoder *)coder
+{
+	[coder encodeObject:[self array] forKey:CODER_KEY];
+}
+
+
 #pragma mark - Accessors
 
 - (id)peekAtObject
@@ -374,6 +488,7 @@ NS_ASSUME_NONNULL_END
 
 - (void)pushObject:(id)object
 {
+	_makeUnique();
 	_growIfNeeded();
 
 	_pushObject(&_stack, object);
@@ -382,6 +497,9 @@ NS_ASSUME_NONNULL_END
 - (id)popObject
 {
 	_guardNotEmpty(nil);
+	_makeUnique();
+
+	++_mutations;
 	return _popObject();
 }
 
@@ -403,12 +521,14 @@ NS_ASSUME_NONNULL_END
 
 - (void)pushObjectsFromArray:(NSArray *)array
 {
+	_makeUnique();
 	[self growToFit:([array count] + _stack._count)];
 	for (id object in array) { _pushObject(&_stack, object); }
 }
 
 - (void)pushObjectsFromOrderedSet:(NSOrderedSet *)set
 {
+	_makeUnique();
 	[self growToFit:([set count] + _stack._count)];
 	for (id object in set) { _pushObject(&_stack, object); }
 }
@@ -421,6 +541,17 @@ NS_ASSUME_NONNULL_END
 
 - (void)removeAllObjects
 {
+	++_mutations;
+
+	/// Drop shared storage rather than copying it only to release the copies.
+	const NSUInteger capacity = _stack._capacity;
+	if ( CBHSlice_releaseShared((CBHSlice_t *)&_stack) )
+	{
+		CBHSlice_setCapacity((CBHSlice_t *)&_stack, capacity, NO);
+		_stack._count = 0;
+		return;
+	}
+
 	/// Release stored objects.
 	for (NSUInteger i = 0; i < _stack._count; ++i)
 	{
@@ -441,6 +572,8 @@ NS_ASSUME_NONNULL_END
 	if ( newCapacity < 1 ) newCapacity = 1;
 
 	/// Shrink.
+	_makeUnique();
+	++_mutations;
 	CBHSlice_setCapacity((CBHSlice_t *)&_stack, newCapacity, NO);
 	return YES;
 }
@@ -451,6 +584,8 @@ NS_ASSUME_NONNULL_END
 	if ( _stack._capacity > _stack._count ) return NO;
 
 	/// Grow.
+	_makeUnique();
+	++_mutations;
 	CBHSlice_setCapacity((CBHSlice_t *)&_stack, _nextCapacity(_stack._capacity), NO);
 	return YES;
 }
@@ -465,6 +600,8 @@ NS_ASSUME_NONNULL_END
 	while ( neededCapacity > nextCapacity ) { nextCapacity = _nextCapacity(nextCapacity); }
 
 	/// Grow.
+	_makeUnique();
+	++_mutations;
 	CBHSlice_setCapacity((CBHSlice_t *)&_stack, nextCapacity, NO);
 	return YES;
 }
@@ -477,8 +614,28 @@ NS_ASSUME_NONNULL_END
 	if ( newCapacity < _stack._count ) return NO;
 
 	/// Resize.
+	_makeUnique();
+	++_mutations;
 	CBHSlice_setCapacity((CBHSlice_t *)&_stack, newCapacity, NO);
 	return YES;
 }
 
 @end
+
+
+#pragma mark - Reuse
+
+@implementation CBHStack (Reuse)
+
+- (BOOL)isReusable
+{
+	return ( !_stack._owner && !_stack._options.allocator );
+}
+
+- (size_t)reusableLength
+{
+	const size_t bufferLength = ( _stack._isInline ) ? 0 : _stack._capacity * _stack._entrySize;
+	return CBHBuffer_inlineObjectSize([self class]) + bufferLength;
+}
+
+@end
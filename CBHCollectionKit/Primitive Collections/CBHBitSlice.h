@@ -0,0 +1,246 @@
+//  CBHBitSlice.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import <CBHCollectionKit/CBHPrimitiveCollection.h>
+#import <CBHCollectionKit/CBHAllocation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** A dynamic ordered collection of bits.
+ *
+ * A Bit Slice packs its entries into 64-bit words, so a bit takes an eighth of the space of the smallest wedge entry. Bits are clear when added unless stated otherwise, and the collection grows like a wedge as bits are appended.
+ *
+ * Bulk logic between bit slices works a vector of words at a time. Rank and select are answered from a directory of running counts, one per 512 bits, built on first use after a change and costing an eighth of the bits' space.
+ *
+ * @note: `entrySize` is the size of a word, and `bytes` holds `wordCount` words. The bits beyond `count` in the last word are always clear.
+ *
+ * @author    Christian Huxtable <chris@huxtable.ca>
+ */
+@interface CBHBitSlice : NSObject <NSCopying, CBHPrimitiveCollection, CBHCollectionResizable>
+
+#pragma mark - Factories
+
++ (instancetype)bitSlice;
++ (instancetype)bitSliceWithCapacity:(NSUInteger)capacity;
++ (instancetype)bitSliceWithCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options;
+
++ (instancetype)bitSliceWithCount:(NSUInteger)count;
++ (instancetype)bitSliceWithCount:(NSUInteger)count copyingWords:(const uint64_t *)words;
+
+
+#pragma mark - Initialization
+
+- (instancetype)init;
+- (instancetype)initWithCapacity:(NSUInteger)capacity;
+
+/** Initializes an empty bit slice whose words are allocated as described by `options`.
+ *
+ * @param capacity    The number of bits the bit slice can hold before growing.
+ * @param options     The alignment, paging, and allocator of the bit slice's words.
+ *
+ * @return            An initialized empty bit slice.
+ */
+- (instancetype)initWithCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options NS_DESIGNATED_INITIALIZER;
+
+/** Initializes a bit slice of `count` clear bits.
+ *
+ * @param count    The number of bits.
+ *
+ * @return         An initialized bit slice.
+ */
+- (instancetype)initWithCount:(NSUInteger)count;
+
+/** Initializes a bit slice with `count` bits copied from `words`. Bit `i` is bit `i % 64` of word `i / 64`.
+ *
+ * @param count    The number of bits.
+ * @param words    The words to copy. Bits beyond `count` are ignored.
+ *
+ * @return         An initialized bit slice.
+ */
+- (instancetype)initWithCount:(NSUInteger)count copyingWords:(const uint64_t *)words;
+
+
+#pragma mark - Properties
+
+/** The number of bits. */
+@property (nonatomic, readonly) NSUInteger count;
+
+/** The number of bits which fit before growing. */
+@property (nonatomic, readonly) NSUInteger capacity;
+
+@property (nonatomic, readonly) size_t entrySize;
+
+@property (nonatomic, readonly) BOOL isEmpty;
+
+/** The number of words holding the bits. */
+@property (nonatomic, readonly) NSUInteger wordCount;
+
+@property (nonatomic, readonly) const void *bytes;
+
+@property (nonatomic, readonly) CBHAllocationOptions allocationOptions;
+
+
+#pragma mark - Copying
+
+- (id)copyWithZone:(nullable NSZone *)zone;
+
+
+#pragma mark - Equality
+
+- (BOOL)isEqual:(id)other;
+- (BOOL)isEqualToBitSlice:(CBHBitSlice *)other;
+
+- (NSUInteger)hash;
+
+
+#pragma mark - Conversion
+
+/** The words holding the bits. */
+- (NSData *)data;
+
+
+#pragma mark - Resizing
+
+- (BOOL)shrink;
+
+- (BOOL)grow;
+- (BOOL)growToFit:(NSUInteger)neededCapacity;
+
+- (BOOL)resize:(NSUInteger)newCapacity;
+
+
+#pragma mark - Description
+
+- (NSString *)description;
+- (NSString *)debugDescription;
+
+
+#pragma mark - Bits
+
+- (BOOL)bitAtIndex:(NSUInteger)index;
+
+- (void)setBit:(BOOL)bit atIndex:(NSUInteger)index;
+- (void)setBitAtIndex:(NSUInteger)index;
+- (void)clearBitAtIndex:(NSUInteger)index;
+- (void)flipBitAtIndex:(NSUInteger)index;
+
+- (void)setBitsInRange:(NSRange)range;
+- (void)clearBitsInRange:(NSRange)range;
+
+- (void)setAll;
+- (void)clearAll;
+
+
+#pragma mark - Appending and Removing
+
+- (void)appendBit:(BOOL)bit;
+
+/** Appends `count` copies of `bit`.
+ *
+ * @param bit      The value of the bits to append.
+ * @param count    The number of bits to append.
+ */
+- (void)appendBits:(BOOL)bit count:(NSUInteger)count;
+
+- (void)removeAll;
+- (void)removeLast:(NSUInteger)count;
+
+
+#pragma mark - Counting
+
+/** The number of set bits. */
+- (NSUInteger)popCount;
+- (NSUInteger)popCountInRange:(NSRange)range;
+
+
+#pragma mark - Finding
+
+/** The index of the first set bit, or `NSNotFound` if none are set. */
+- (NSUInteger)firstSetBit;
+
+/** The index of the first set bit at or after `index`, or `NSNotFound` if there is none.
+ *
+ * @param index    The index to start searching from.
+ *
+ * @return         The index of the next set bit.
+ */
+- (NSUInteger)nextSetBitFromIndex:(NSUInteger)index;
+
+/** The index of the first clear bit, or `NSNotFound` if all are set. */
+- (NSUInteger)firstClearBit;
+
+/** The index of the first clear bit at or after `index`, or `NSNotFound` if there is none.
+ *
+ * @param index    The index to start searching from.
+ *
+ * @return         The index of the next clear bit.
+ */
+- (NSUInteger)nextClearBitFromIndex:(NSUInteger)index;
+
+
+#pragma mark - Rank and Select
+
+/** The number of set bits before `index`.
+ *
+ * @param index    An index no greater than `count`.
+ *
+ * @return         The number of set bits in `[0, index)`.
+ */
+- (NSUInteger)rankAtIndex:(NSUInteger)index;
+
+/** The index of the set bit with `rank` set bits before it.
+ *
+ * @param rank    The zero based rank of the set bit.
+ *
+ * @return        The index of the set bit, or `NSNotFound` if fewer than `rank + 1` bits are set.
+ */
+- (NSUInteger)indexOfSetBitWithRank:(NSUInteger)rank;
+
+
+#pragma mark - Bulk Logic
+
+/** Keeps only the bits also set in `other`. Bits beyond the end of `other` are cleared.
+ *
+ * @param other    The bit slice to intersect with.
+ */
+- (void)andWithBitSlice:(CBHBitSlice *)other;
+
+/** Sets the bits set in `other`, growing the receiver to at least the count of `other`.
+ *
+ * @param other    The bit slice to unite with.
+ */
+- (void)orWithBitSlice:(CBHBitSlice *)other;
+
+/** Flips the bits set in `other`, growing the receiver to at least the count of `other`.
+ *
+ * @param other    The bit slice to differ with.
+ */
+- (void)xorWithBitSlice:(CBHBitSlice *)other;
+
+/** Clears the bits set in `other`.
+ *
+ * @param other    The bit slice to subtract.
+ */
+- (void)andNotWithBitSlice:(CBHBitSlice *)other;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,685 @@
+//  CBHBitSlice.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHBitSlice.h"
+#import "_CBHStack.h"
+#import "_CBHHash.h"
+
+@import CBHMemoryKit;
+
+
+#define DEFAULT_CAPACITY 512
+#define GROWTH_FACTOR 1.618033988749895
+
+#define WORD_BITS ((NSUInteger)64)
+#define BLOCK_WORDS ((NSUInteger)8)
+#define VECTOR_WORDS ((NSUInteger)4)
+
+#define _words ((uint64_t *)_stack._data)
+#define _wordsFor(aCount) (((aCount) + (WORD_BITS - 1)) / WORD_BITS)
+#define _blockCount() ((_stack._count + (BLOCK_WORDS - 1)) / BLOCK_WORDS)
+#define _maskFrom(aBit) (~(uint64_t)0 << (aBit))
+#define _popCount(aWord) ((NSUInteger)__builtin_popcountll(aWord))
+#define _lowestBit(aWord) ((NSUInteger)__builtin_ctzll(aWord))
+
+#define _checkReadableIndex(anIndex) if ( (anIndex) >= _count ) @throw NSRangeException
+#define _checkRange(aRange) if ( (aRange).location > _count || (aRange).length > _count - (aRange).location ) @throw NSRangeException
+#define _checkAppendable(aCount) if ( (aCount) > NSUIntegerMax - _count ) @throw NSRangeException
+
+#define _nextCapacity(aCapacity) (size_t)ceil((double)(aCapacity) * GROWTH_FACTOR)
+
+/// Any change to the bits makes the rank directory stale.
+#define _invalidateRanks() _ranksAreValid = NO
+
+
+/// Four words, loaded and stored without regard to their alignment.
+typedef uint64_t CBHBitVector __attribute__((vector_size(VECTOR_WORDS * sizeof(uint64_t)), aligned(8)));
+
+#define _defineBulkOperation(aName, anOperator)\
+static void aName(uint64_t *dst, const uint64_t *src, NSUInteger count)\
+{\
+	NSUInteger i = 0;\
+	for (; i + VECTOR_WORDS <= count; i += VECTOR_WORDS)\
+	{\
+		CBHBitVector *a = (CBHBitVector *)(dst + i);\
+		const CBHBitVector b = *(const CBHBitVector *)(src + i);\
+		*a = anOperator(*a, b);\
+	}\
+	for (; i < count; ++i) { dst[i] = anOperator(dst[i], src[i]); }\
+}
+
+#define _and(a, b) ((a) & (b))
+#define _or(a, b) ((a) | (b))
+#define _xor(a, b) ((a) ^ (b))
+#define _andNot(a, b) ((a) & ~(b))
+
+_defineBulkOperation(CBHBitSlice_and, _and)
+_defineBulkOperation(CBHBitSlice_or, _or)
+_defineBulkOperation(CBHBitSlice_xor, _xor)
+_defineBulkOperation(CBHBitSlice_andNot, _andNot)
+
+
+#pragma mark - Word Operations
+
+static NSUInteger CBHBitSlice_popCount(const uint64_t *words, NSUInteger count)
+{
+	NSUInteger total = 0;
+	for (NSUInteger i = 0; i < count; ++i) { total += _popCount(words[i]); }
+
+	return total;
+}
+
+/// The position of the set bit of `word` with `rank` set bits below it. `word` must have more than `rank` bits set.
+static NSUInteger CBHBitSlice_selectInWord(uint64_t word, NSUInteger rank)
+{
+	for (; rank > 0; --rank) { word &= word - 1; }
+	return _lowestBit(word);
+}
+
+/// Sets or clears bits `[from, to)`.
+static void CBHBitSlice_fillRange(uint64_t *words, NSUInteger from, NSUInteger to, BOOL bit)
+{
+	if ( from >= to ) return;
+
+	const NSUInteger first = from / WORD_BITS;
+	const NSUInteger last = (to - 1) / WORD_BITS;
+
+	const uint64_t firstMask = _maskFrom(from % WORD_BITS);
+	const uint64_t lastMask = ~(uint64_t)0 >> (WORD_BITS - 1 - ((to - 1) % WORD_BITS));
+
+	if ( first == last )
+	{
+		const uint64_t mask = firstMask & lastMask;
+		words[first] = ( bit ) ? words[first] | mask : words[first] & ~mask;
+		return;
+	}
+
+	words[first] = ( bit ) ? words[first] | firstMask : words[first] & ~firstMask;
+	memset(words + first + 1, ( bit ) ? 0xFF : 0x00, (last - first - 1) * sizeof(uint64_t));
+	words[last] = ( bit ) ? words[last] | lastMask : words[last] & ~lastMask;
+}
+
+
+@interface CBHBitSlice ()
+{
+	CBHStack_t _stack;
+	NSUInteger _count;
+
+	/// Set bits before each block of `BLOCK_WORDS` words, followed by the total.
+	NSUInteger *_ranks;
+	NSUInteger _rankCapacity;
+	BOOL _ranksAreValid;
+}
+
+/// Changes the number of bits, clearing any which are added.
+- (void)setBitCount:(NSUInteger)count;
+
+/// Builds the rank directory if the bits have changed since it was last built.
+- (void)prepareRanks;
+
+@end
+
+
+@implementation CBHBitSlice
+
+#pragma mark - Factories
+
++ (instancetype)bitSlice
+{
+	return [[(CBHBitSlice *)[self alloc] init] autorelease];
+}
+
++ (instancetype)bitSliceWithCapacity:(NSUInteger)capacity
+{
+	return [[(CBHBitSlice *)[self alloc] initWithCapacity:capacity] autorelease];
+}
+
++ (instancetype)bitSliceWithCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options
+{
+	return [[(CBHBitSlice *)[self alloc] initWithCapacity:capacity options:options] autorelease];
+}
+
++ (instancetype)bitSliceWithCount:(NSUInteger)count
+{
+	return [[(CBHBitSlice *)[self alloc] initWithCount:count] autorelease];
+}
+
++ (instancetype)bitSliceWithCount:(NSUInteger)count copyingWords:(const uint64_t *)words
+{
+	return [[(CBHBitSlice *)[self alloc] initWithCount:count copyingWords:words] autorelease];
+}
+
+
+#pragma mark - Initialization
+
+- (instancetype)init
+{
+	return [self initWithCapacity:DEFAULT_CAPACITY];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+{
+	return [self initWithCapacity:capacity options:CBHAllocationOptionsDefault];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options
+{
+	if ( (self = [super init]) )
+	{
+		const NSUInteger wordCapacity = _wordsFor(capacity);
+		_stack = CBHStack_initWithOptions(( wordCapacity > 0 ) ? wordCapacity : 1, sizeof(uint64_t), &options);
+		_count = 0;
+
+		_ranks = NULL;
+		_rankCapacity = 0;
+		_ranksAreValid = NO;
+	}
+
+	return self;
+}
+
+- (instancetype)initWithCount:(NSUInteger)count
+{
+	if ( (self = [self initWithCapacity:count]) )
+	{
+		[self setBitCount:count];
+	}
+
+	return self;
+}
+
+- (instancetype)initWithCount:(NSUInteger)count copyingWords:(const uint64_t *)words
+{
+	if ( (self = [self initWithCapacity:count]) )
+	{
+		_stack._count = _wordsFor(count);
+		_count = count;
+
+		memcpy(_stack._data, words, _stack._count * sizeof(uint64_t));
+
+		/// Keep the bits past the end clear.
+		if ( count % WORD_BITS != 0 ) { _words[_stack._count - 1] &= ~_maskFrom(count % WORD_BITS); }
+	}
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	CBHStack_dealloc(&_stack);
+	CBHMemory_free(_ranks);
+
+	[super dealloc];
+}
+
+
+#pragma mark - Properties
+
+- (NSUInteger)count
+{
+	return _count;
+}
+
+- (NSUInteger)capacity
+{
+	return _stack._capacity * WORD_BITS;
+}
+
+- (size_t)entrySize
+{
+	return _stack._entrySize;
+}
+
+- (BOOL)isEmpty
+{
+	return ( _count <= 0 );
+}
+
+- (NSUInteger)wordCount
+{
+	return _stack._count;
+}
+
+- (const void *)bytes
+{
+	return _stack._data;
+}
+
+- (CBHAllocationOptions)allocationOptions
+{
+	return _stack._options;
+}
+
+
+#pragma mark - Copying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	CBHBitSlice *copy = [[CBHBitSlice allocWithZone:zone] initWithCapacity:_count options:_stack._options];
+	[copy setBitCount:_count];
+	memcpy(copy->_stack._data, _stack._data, _stack._count * sizeof(uint64_t));
+
+	return copy;
+}
+
+
+#pragma mark - Equality
+
+- (BOOL)isEqual:(id)other
+{
+	if ( [other isKindOfClass:[CBHBitSlice class]] ) return [self isEqualToBitSlice:other];
+	return [super isEqual:other];
+}
+
+- (BOOL)isEqualToBitSlice:(CBHBitSlice *)other
+{
+	/// Catch trivial cases.
+	if ( self == other ) return YES;
+	if ( _count != other->_count ) return NO;
+	if ( _count <= 0 ) return YES;
+
+	/// Compare the words, the bits past the end are always clear.
+	return CBHMemory_compare(_stack._data, other->_stack._data, _stack._count, sizeof(uint64_t));
+}
+
+- (NSUInteger)hash
+{
+	/// Hash every word, the bits past the end are always clear.
+	return (NSUInteger)CBHHash(_stack._data, _stack._count * sizeof(uint64_t), _count);
+}
+
+
+#pragma mark - Conversion
+
+- (NSData *)data
+{
+	return [NSData dataWithBytes:_stack._data length:_stack._count * sizeof(uint64_t)];
+}
+
+
+#pragma mark - Resizable
+
+- (BOOL)shrink
+{
+	/// Prevent empty capacity.
+	NSUInteger newCapacity = _stack._count;
+	if ( newCapacity < 1 ) newCapacity = 1;
+
+	/// Shrink.
+	CBHStack_setCapacity(&_stack, newCapacity);
+	return YES;
+}
+
+- (BOOL)grow
+{
+	/// Early return if growth unnecessary.
+	if ( _stack._capacity * WORD_BITS > _count ) return NO;
+
+	/// Grow.
+	CBHStack_setCapacity(&_stack, _nextCapacity(_stack._capacity));
+	return YES;
+}
+
+- (BOOL)growToFit:(NSUInteger)neededCapacity
+{
+	/// Early return if growth unnecessary.
+	const NSUInteger neededWords = _wordsFor(neededCapacity);
+	if ( neededWords <= _stack._capacity ) return NO;
+
+	/// Find new capacity which fits the needed capacity.
+	NSUInteger nextCapacity = ( _stack._capacity > 0 ) ? _stack._capacity : 1;
+	while ( neededWords > nextCapacity ) { nextCapacity = _nextCapacity(nextCapacity); }
+
+	/// Grow.
+	CBHStack_setCapacity(&_stack, nextCapacity);
+	return YES;
+}
+
+- (BOOL)resize:(NSUInteger)newCapacity
+{
+	/// Early return if resize unnecessary.
+	const NSUInteger newWords = _wordsFor(newCapacity);
+	if ( newWords <= 0 ) return NO;
+	if ( newWords == _stack._capacity ) return NO;
+	if ( newWords < _stack._count ) return NO;
+
+	/// Resize.
+	CBHStack_setCapacity(&_stack, newWords);
+	return YES;
+}
+
+- (void)setBitCount:(NSUInteger)count
+{
+	const NSUInteger oldWords = _stack._count;
+	const NSUInteger newWords = _wordsFor(count);
+
+	if ( count > _count )
+	{
+		[self growToFit:count];
+
+		/// Words past the end may hold bits from before a removal.
+		if ( newWords > oldWords ) { memset(_words + oldWords, 0, (newWords - oldWords) * sizeof(uint64_t)); }
+	}
+	else if ( count % WORD_BITS != 0 )
+	{
+		_words[newWords - 1] &= ~_maskFrom(count % WORD_BITS);
+	}
+
+	_stack._count = newWords;
+	_count = count;
+
+	_invalidateRanks();
+}
+
+
+#pragma mark - Description
+
+- (NSString *)description
+{
+	NSMutableString *description = [NSMutableString stringWithCapacity:_count + 2];
+	[description appendString:@"("];
+
+	for (NSUInteger i = 0; i < _count; ++i)
+	{
+		[description appendString:( (_words[i / WORD_BITS] >> (i % WORD_BITS)) & 1 ) ? @"1" : @"0"];
+	}
+
+	[description appendString:@")"];
+	return description;
+}
+
+- (NSString *)debugDescription
+{
+	return [NSString stringWithFormat:@"<%@: %p> %@", [self class], (void *)self, [self description]];
+}
+
+
+#pragma mark - Bits
+
+- (BOOL)bitAtIndex:(NSUInteger)index
+{
+	_checkReadableIndex(index);
+	return ( (_words[index / WORD_BITS] >> (index % WORD_BITS)) & 1 ) != 0;
+}
+
+- (void)setBit:(BOOL)bit atIndex:(NSUInteger)index
+{
+	if ( bit ) [self setBitAtIndex:index];
+	else [self clearBitAtIndex:index];
+}
+
+- (void)setBitAtIndex:(NSUInteger)index
+{
+	_checkReadableIndex(index);
+
+	_words[index / WORD_BITS] |= (uint64_t)1 << (index % WORD_BITS);
+	_invalidateRanks();
+}
+
+- (void)clearBitAtIndex:(NSUInteger)index
+{
+	_checkReadableIndex(index);
+
+	_words[index / WORD_BITS] &= ~((uint64_t)1 << (index % WORD_BITS));
+	_invalidateRanks();
+}
+
+- (void)flipBitAtIndex:(NSUInteger)index
+{
+	_checkReadableIndex(index);
+
+	_words[index / WORD_BITS] ^= (uint64_t)1 << (index % WORD_BITS);
+	_invalidateRanks();
+}
+
+
+- (void)setBitsInRange:(NSRange)range
+{
+	_checkRange(range);
+
+	CBHBitSlice_fillRange(_words, range.location, NSMaxRange(range), YES);
+	_invalidateRanks();
+}
+
+- (void)clearBitsInRange:(NSRange)range
+{
+	_checkRange(range);
+
+	CBHBitSlice_fillRange(_words, range.location, NSMaxRange(range), NO);
+	_invalidateRanks();
+}
+
+
+- (void)setAll
+{
+	CBHBitSlice_fillRange(_words, 0, _count, YES);
+	_invalidateRanks();
+}
+
+- (void)clearAll
+{
+	memset(_stack._data, 0, _stack._count * sizeof(uint64_t));
+	_invalidateRanks();
+}
+
+
+#pragma mark - Appending and Removing
+
+- (void)appendBit:(BOOL)bit
+{
+	[self appendBits:bit count:1];
+}
+
+- (void)appendBits:(BOOL)bit count:(NSUInteger)count
+{
+	_checkAppendable(count);
+
+	const NSUInteger start = _count;
+	[self setBitCount:_count + count];
+
+	if ( bit ) { CBHBitSlice_fillRange(_words, start, _count, YES); }
+}
+
+- (void)removeAll
+{
+	[self setBitCount:0];
+}
+
+- (void)removeLast:(NSUInteger)count
+{
+	[self setBitCount:( count >= _count ) ? 0 : _count - count];
+}
+
+
+#pragma mark - Counting
+
+- (NSUInteger)popCount
+{
+	[self prepareRanks];
+	return _ranks[_blockCount()];
+}
+
+- (NSUInteger)popCountInRange:(NSRange)range
+{
+	_checkRange(range);
+	return [self rankAtIndex:NSMaxRange(range)] - [self rankAtIndex:range.location];
+}
+
+
+#pragma mark - Finding
+
+- (NSUInteger)firstSetBit
+{
+	return [self nextSetBitFromIndex:0];
+}
+
+- (NSUInteger)nextSetBitFromIndex:(NSUInteger)index
+{
+	if ( index >= _count ) return NSNotFound;
+
+	NSUInteger wordIndex = index / WORD_BITS;
+	uint64_t word = _words[wordIndex] & _maskFrom(index % WORD_BITS);
+
+	/// The bits past the end are clear, so any set bit found is in range.
+	while ( !word )
+	{
+		if ( ++wordIndex >= _stack._count ) return NSNotFound;
+		word = _words[wordIndex];
+	}
+
+	return (wordIndex * WORD_BITS) + _lowestBit(word);
+}
+
+- (NSUInteger)firstClearBit
+{
+	return [self nextClearBitFromIndex:0];
+}
+
+- (NSUInteger)nextClearBitFromIndex:(NSUInteger)index
+{
+	if ( index >= _count ) return NSNotFound;
+
+	NSUInteger wordIndex = index / WORD_BITS;
+	uint64_t word = ~_words[wordIndex] & _maskFrom(index % WORD_BITS);
+
+	while ( !word )
+	{
+		if ( ++wordIndex >= _stack._count ) return NSNotFound;
+		word = ~_words[wordIndex];
+	}
+
+	/// The bits past the end are clear too, so check the bit found is in range.
+	const NSUInteger found = (wordIndex * WORD_BITS) + _lowestBit(word);
+	return ( found < _count ) ? found : NSNotFound;
+}
+
+
+#pragma mark - Rank and Select
+
+- (void)prepareRanks
+{
+	if ( _ranksAreValid ) return;
+
+	const NSUInteger blockCount = _blockCount();
+	if ( blockCount + 1 > _rankCapacity )
+	{
+		NSUInteger *ranks = CBHMemory_realloc(_ranks, blockCount + 1, sizeof(NSUInteger));
+		if ( !ranks ) @throw CBHReallocException;
+
+		_ranks = ranks;
+		_rankCapacity = blockCount + 1;
+	}
+
+	NSUInteger total = 0;
+	for (NSUInteger block = 0; block < blockCount; ++block)
+	{
+		_ranks[block] = total;
+
+		const NSUInteger first = block * BLOCK_WORDS;
+		const NSUInteger length = MIN(BLOCK_WORDS, _stack._count - first);
+		total += CBHBitSlice_popCount(_words + first, length);
+	}
+	_ranks[blockCount] = total;
+
+	_ranksAreValid = YES;
+}
+
+- (NSUInteger)rankAtIndex:(NSUInteger)index
+{
+	if ( index > _count ) @throw NSRangeException;
+	[self prepareRanks];
+
+	const NSUInteger wordIndex = index / WORD_BITS;
+	const NSUInteger block = wordIndex / BLOCK_WORDS;
+
+	/// Count from the start of the block up to the word, then within it.
+	NSUInteger rank = _ranks[block] + CBHBitSlice_popCount(_words + (block * BLOCK_WORDS), wordIndex - (block * BLOCK_WORDS));
+	if ( index % WORD_BITS != 0 ) { rank += _popCount(_words[wordIndex] & ~_maskFrom(index % WORD_BITS)); }
+
+	return rank;
+}
+
+- (NSUInteger)indexOfSetBitWithRank:(NSUInteger)rank
+{
+	[self prepareRanks];
+
+	const NSUInteger blockCount = _blockCount();
+	if ( rank >= _ranks[blockCount] ) return NSNotFound;
+
+	/// Find the last block starting at or before the rank.
+	NSUInteger low = 0;
+	NSUInteger high = blockCount;
+	while ( high - low > 1 )
+	{
+		const NSUInteger middle = low + ((high - low) / 2);
+		if ( _ranks[middle] <= rank ) low = middle;
+		else high = middle;
+	}
+
+	/// Walk the words of the block to the one holding the bit.
+	NSUInteger remaining = rank - _ranks[low];
+	for (NSUInteger wordIndex = low * BLOCK_WORDS; wordIndex < _stack._count; ++wordIndex)
+	{
+		const NSUInteger bits = _popCount(_words[wordIndex]);
+		if ( remaining < bits ) return (wordIndex * WORD_BITS) + CBHBitSlice_selectInWord(_words[wordIndex], remaining);
+
+		remaining -= bits;
+	}
+
+	@throw NSInternalInconsistencyException;
+}
+
+
+#pragma mark - Bulk Logic
+
+- (void)andWithBitSlice:(CBHBitSlice *)other
+{
+	const NSUInteger shared = MIN(_stack._count, other->_stack._count);
+
+	CBHBitSlice_and(_words, (const uint64_t *)other->_stack._data, shared);
+	memset(_words + shared, 0, (_stack._count - shared) * sizeof(uint64_t));
+
+	_invalidateRanks();
+}
+
+- (void)orWithBitSlice:(CBHBitSlice *)other
+{
+	if ( other->_count > _count ) [self setBitCount:other->_count];
+
+	CBHBitSlice_or(_words, (const uint64_t *)other->_stack._data, other->_stack._count);
+	_invalidateRanks();
+}
+
+- (void)xorWithBitSlice:(CBHBitSlice *)other
+{
+	if ( other->_count > _count ) [self setBitCount:other->_count];
+
+	CBHBitSlice_xor(_words, (const uint64_t *)other->_stack._data, other->_stack._count);
+	_invalidateRanks();
+}
+
+- (void)andNotWithBitSlice:(CBHBitSlice *)other
+{
+	CBHBitSlice_andNot(_words, (const uint64_t *)other->_stack._data, MIN(_stack._count, other->_stack._count));
+	_invalidateRanks();
+}
+
+@end
@@ -0,0 +1,615 @@
+//  CBHCompressedWedge.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHCompressedWedge.h"
+#import "_CBHHash.h"
+
+@import CBHMemoryKit;
+
+
+#define BLOCK_LENGTH ((NSUInteger)128)
+#define LANE_COUNT ((NSUInteger)4)
+#define LANE_LENGTH (BLOCK_LENGTH / LANE_COUNT)
+#define LANE_BITS ((NSUInteger)32)
+
+#define _headerAt(aBlock) (((const CBHCompressedBlock_t *)[_headers bytes]) + (aBlock))
+#define _payloadAt(anOffset) ((const uint8_t *)[_payload bytes] + (anOffset))
+
+#define _checkRange(aRange) if ( (aRange).location > _count || (aRange).length > _count - (aRange).location ) @throw NSRangeException
+#define _checkAppendable(aCount) if ( (aCount) > NSUIntegerMax - _count ) @throw NSRangeException
+
+/// The number of bits needed for `aValue`, where zero needs none.
+#define _bitsFor(aValue) (( (aValue) != 0 ) ? ((NSUInteger)64 - (NSUInteger)__builtin_clzll(aValue)) : 0)
+#define _laneMask(aWidth) (( (aWidth) >= LANE_BITS ) ? UINT32_MAX : (((uint32_t)1 << (aWidth)) - 1))
+
+
+/// Four lanes of a block, loaded and stored without regard to their alignment.
+typedef uint32_t CBHLanes __attribute__((vector_size(LANE_COUNT * sizeof(uint32_t)), aligned(4)));
+
+typedef NS_ENUM(uint8_t, CBHCompressedMode) {
+	/// Offsets from `_base`, the smallest value.
+	CBHCompressedModeFrame = 0,
+
+	/// Differences from the value before, starting from `_base`, the first value.
+	CBHCompressedModeDelta,
+
+	/// The values as they are.
+	CBHCompressedModeRaw,
+};
+
+typedef struct CBHCompressedBlock_t {
+	uint64_t _base;
+
+	/// Where the block's payload starts.
+	uint64_t _offset;
+
+	CBHCompressedMode _mode;
+	uint8_t _bitWidth;
+} CBHCompressedBlock_t;
+
+
+#pragma mark - Lanes
+
+/// Packs 128 values of `bitWidth` bits into `bitWidth` vectors. Value `i` goes in lane `i % 4`, so each vector holds the next bits of four values.
+static void CBHCompressedWedge_pack(const uint32_t *values, NSUInteger bitWidth, uint8_t *packed)
+{
+	if ( bitWidth <= 0 ) return;
+
+	const CBHLanes *input = (const CBHLanes *)values;
+	CBHLanes *output = (CBHLanes *)packed;
+
+	CBHLanes pending = {0, 0, 0, 0};
+	NSUInteger shift = 0;
+
+	for (NSUInteger i = 0; i < LANE_LENGTH; ++i)
+	{
+		const CBHLanes lanes = input[i];
+		pending |= lanes << (uint32_t)shift;
+		shift += bitWidth;
+
+		if ( shift >= LANE_BITS )
+		{
+			*output++ = pending;
+			shift -= LANE_BITS;
+			pending = ( shift ) ? lanes >> (uint32_t)(bitWidth - shift) : (CBHLanes){0, 0, 0, 0};
+		}
+	}
+}
+
+static void CBHCompressedWedge_unpack(const uint8_t *packed, NSUInteger bitWidth, uint32_t *values)
+{
+	CBHLanes *output = (CBHLanes *)values;
+
+	if ( bitWidth <= 0 )
+	{
+		memset(values, 0, BLOCK_LENGTH * sizeof(uint32_t));
+		return;
+	}
+
+	const CBHLanes *input = (const CBHLanes *)packed;
+	const uint32_t mask = _laneMask(bitWidth);
+
+	CBHLanes current = *input++;
+	NSUInteger shift = 0;
+
+	for (NSUInteger i = 0; i < LANE_LENGTH; ++i)
+	{
+		CBHLanes lanes = current >> (uint32_t)shift;
+		shift += bitWidth;
+
+		if ( shift > LANE_BITS )
+		{
+			/// The value straddles two vectors.
+			current = *input++;
+			shift -= LANE_BITS;
+			lanes |= current << (uint32_t)(bitWidth - shift);
+		}
+		else if ( shift == LANE_BITS )
+		{
+			shift = 0;
+			if ( i + 1 < LANE_LENGTH ) { current = *input++; }
+		}
+
+		output[i] = lanes & mask;
+	}
+}
+
+/// Reads value `index` of a packed block without unpacking the others.
+static uint32_t CBHCompressedWedge_unpackOne(const uint8_t *packed, NSUInteger bitWidth, NSUInteger index)
+{
+	if ( bitWidth <= 0 ) return 0;
+
+	const uint32_t *words = (const uint32_t *)packed;
+	const NSUInteger lane = index % LANE_COUNT;
+	const NSUInteger bit = (index / LANE_COUNT) * bitWidth;
+	const NSUInteger shift = bit % LANE_BITS;
+
+	/// Word `n` of a lane is word `n * 4 + lane` of the payload.
+	const NSUInteger word = ((bit / LANE_BITS) * LANE_COUNT) + lane;
+
+	uint64_t value = words[word] >> shift;
+	if ( shift + bitWidth > LANE_BITS ) { value |= (uint64_t)words[word + LANE_COUNT] << (LANE_BITS - shift); }
+
+	return (uint32_t)value & _laneMask(bitWidth);
+}
+
+
+#pragma mark - Blocks
+
+/// Picks the narrowest packing for a full block and packs it into `packed`, which must hold 1024 bytes. Returns the payload's length.
+static NSUInteger CBHCompressedWedge_encode(const uint64_t *values, CBHCompressedBlock_t *header, uint8_t *packed)
+{
+	uint64_t minimum = values[0];
+	uint64_t maximum = values[0];
+	uint64_t deltaBits = 0;
+	BOOL isSorted = YES;
+
+	for (NSUInteger i = 1; i < BLOCK_LENGTH; ++i)
+	{
+		if ( values[i] < minimum ) minimum = values[i];
+		if ( values[i] > maximum ) maximum = values[i];
+
+		if ( values[i] < values[i - 1] ) isSorted = NO;
+		else deltaBits |= values[i] - values[i - 1];
+	}
+
+	const NSUInteger frameWidth = _bitsFor(maximum - minimum);
+	const NSUInteger deltaWidth = ( isSorted ) ? _bitsFor(deltaBits) : NSUIntegerMax;
+
+	if ( frameWidth > LANE_BITS && deltaWidth > LANE_BITS )
+	{
+		header->_mode = CBHCompressedModeRaw;
+		header->_bitWidth = 64;
+
+		/// Unused by the payload, but searches expect every block's first value.
+		header->_base = values[0];
+
+		memcpy(packed, values, BLOCK_LENGTH * sizeof(uint64_t));
+		return BLOCK_LENGTH * sizeof(uint64_t);
+	}
+
+	uint32_t narrowed[BLOCK_LENGTH];
+
+	/// Offsets read single values in place, so prefer them unless differences are narrower.
+	if ( deltaWidth < frameWidth )
+	{
+		header->_mode = CBHCompressedModeDelta;
+		header->_bitWidth = (uint8_t)deltaWidth;
+		header->_base = values[0];
+
+		narrowed[0] = 0;
+		for (NSUInteger i = 1; i < BLOCK_LENGTH; ++i) { narrowed[i] = (uint32_t)(values[i] - values[i - 1]); }
+	}
+	else
+	{
+		header->_mode = CBHCompressedModeFrame;
+		header->_bitWidth = (uint8_t)frameWidth;
+		header->_base = minimum;
+
+		for (NSUInteger i = 0; i < BLOCK_LENGTH; ++i) { narrowed[i] = (uint32_t)(values[i] - minimum); }
+	}
+
+	CBHCompressedWedge_pack(narrowed, header->_bitWidth, packed);
+	return (NSUInteger)header->_bitWidth * LANE_COUNT * sizeof(uint32_t);
+}
+
+static void CBHCompressedWedge_decode(const CBHCompressedBlock_t *header, const uint8_t *packed, uint64_t *values)
+{
+	if ( header->_mode == CBHCompressedModeRaw )
+	{
+		memcpy(values, packed, BLOCK_LENGTH * sizeof(uint64_t));
+		return;
+	}
+
+	uint32_t narrowed[BLOCK_LENGTH];
+	CBHCompressedWedge_unpack(packed, header->_bitWidth, narrowed);
+
+	uint64_t value = header->_base;
+	if ( header->_mode == CBHCompressedModeDelta )
+	{
+		for (NSUInteger i = 0; i < BLOCK_LENGTH; ++i)
+		{
+			value += narrowed[i];
+			values[i] = value;
+		}
+	}
+	else
+	{
+		for (NSUInteger i = 0; i < BLOCK_LENGTH; ++i) { values[i] = value + narrowed[i]; }
+	}
+}
+
+
+@interface CBHCompressedWedge ()
+{
+	CBHWedge *_headers;
+	CBHWedge *_payload;
+	NSUInteger _count;
+
+	/// Values of the block still filling.
+	uint64_t _tail[BLOCK_LENGTH];
+
+	uint64_t _last;
+	BOOL _isSorted;
+
+	/// The last block decoded whole, or `NSNotFound`.
+	NSUInteger _cachedBlock;
+	uint64_t _cache[BLOCK_LENGTH];
+}
+
+/// The values of a full block, decoding it unless it is cached.
+- (const uint64_t *)valuesOfBlock:(NSUInteger)block;
+
+@end
+
+
+@implementation CBHCompressedWedge
+
+#pragma mark - Factories
+
++ (instancetype)compressedWedge
+{
+	return [[(CBHCompressedWedge *)[self alloc] init] autorelease];
+}
+
++ (instancetype)compressedWedgeWithWedge:(CBHWedge *)wedge
+{
+	return [[(CBHCompressedWedge *)[self alloc] initWithWedge:wedge] autorelease];
+}
+
+
+#pragma mark - Initialization
+
+- (instancetype)init
+{
+	if ( (self = [super init]) )
+	{
+		_headers = [[CBHWedge alloc] initWithEntrySize:sizeof(CBHCompressedBlock_t)];
+		_payload = [[CBHWedge alloc] initWithEntrySize:sizeof(uint8_t) andCapacity:BLOCK_LENGTH * sizeof(uint64_t)];
+		_count = 0;
+
+		_last = 0;
+		_isSorted = YES;
+		_cachedBlock = NSNotFound;
+	}
+
+	return self;
+}
+
+- (instancetype)initWithWedge:(CBHWedge *)wedge
+{
+	if ( [wedge entrySize] != sizeof(uint64_t) ) @throw CBHEntrySizeException;
+
+	if ( (self = [self init]) )
+	{
+		[self appendValues:[wedge bytes] count:[wedge count]];
+	}
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	[_headers release];
+	[_payload release];
+
+	[super dealloc];
+}
+
+
+#pragma mark - Properties
+
+- (NSUInteger)count
+{
+	return _count;
+}
+
+- (NSUInteger)capacity
+{
+	return [_headers count] * BLOCK_LENGTH + BLOCK_LENGTH;
+}
+
+- (size_t)entrySize
+{
+	return sizeof(uint64_t);
+}
+
+- (BOOL)isEmpty
+{
+	return ( _count <= 0 );
+}
+
+- (BOOL)isSorted
+{
+	return _isSorted;
+}
+
+- (NSUInteger)blockCount
+{
+	return (_count + (BLOCK_LENGTH - 1)) / BLOCK_LENGTH;
+}
+
+- (NSUInteger)compressedLength
+{
+	return [_payload count] + ([_headers count] * sizeof(CBHCompressedBlock_t)) + ((_count % BLOCK_LENGTH) * sizeof(uint64_t));
+}
+
+
+#pragma mark - Copying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	CBHCompressedWedge *copy = [[CBHCompressedWedge allocWithZone:zone] init];
+
+	/// Blocks are never rewritten, so the copied wedges share their bytes.
+	[copy->_headers release];
+	[copy->_payload release];
+	copy->_headers = [_headers copy];
+	copy->_payload = [_payload copy];
+
+	memcpy(copy->_tail, _tail, sizeof(_tail));
+	copy->_count = _count;
+	copy->_last = _last;
+	copy->_isSorted = _isSorted;
+
+	return copy;
+}
+
+
+#pragma mark - Equality
+
+- (BOOL)isEqual:(id)other
+{
+	if ( [other isKindOfClass:[CBHCompressedWedge class]] ) return [self isEqualToCompressedWedge:other];
+	return [super isEqual:other];
+}
+
+- (BOOL)isEqualToCompressedWedge:(CBHCompressedWedge *)other
+{
+	/// Catch trivial cases.
+	if ( self == other ) return YES;
+	if ( _count != other->_count ) return NO;
+
+	/// Blocks start every 128 values and are packed the same way for the same values.
+	if ( ![_headers isEqualToWedge:other->_headers] ) return NO;
+	if ( ![_payload isEqualToWedge:other->_payload] ) return NO;
+
+	return ( memcmp(_tail, other->_tail, (_count % BLOCK_LENGTH) * sizeof(uint64_t)) == 0 );
+}
+
+- (NSUInteger)hash
+{
+	/// Equal values are packed the same way, so hash everything compared without unpacking it.
+	uint64_t hash = CBHHash([_headers bytes], [_headers count] * sizeof(CBHCompressedBlock_t), _count);
+	hash = CBHHash([_payload bytes], [_payload count] * [_payload entrySize], hash);
+	hash = CBHHash(_tail, (_count % BLOCK_LENGTH) * sizeof(uint64_t), hash);
+
+	return (NSUInteger)hash;
+}
+
+
+#pragma mark - Description
+
+- (NSString *)description
+{
+	NSMutableString *description = [NSMutableString stringWithString:@"("];
+
+	for (NSUInteger i = 0; i < _count; ++i)
+	{
+		[description appendFormat:@"\n\t%llu", [self uint64AtIndex:i]];
+		if ( i != _count - 1 ) { [description appendString:@","]; }
+	}
+
+	return [NSString stringWithFormat:@"%@\n)", description];
+}
+
+- (NSString *)debugDescription
+{
+	return [NSString stringWithFormat:@"<%@: %p> %lu bytes %@", [self class], (void *)self, (unsigned long)[self compressedLength], [self description]];
+}
+
+
+#pragma mark - Values
+
+- (uint64_t)uint64AtIndex:(NSUInteger)index
+{
+	if ( index >= _count ) @throw NSRangeException;
+
+	const NSUInteger block = index / BLOCK_LENGTH;
+	const NSUInteger position = index % BLOCK_LENGTH;
+
+	if ( block >= [_headers count] ) return _tail[position];
+	if ( block == _cachedBlock ) return _cache[position];
+
+	/// Offsets and raw values are read in place, differences must be summed from the start of the block.
+	const CBHCompressedBlock_t *header = _headerAt(block);
+	switch (header->_mode)
+	{
+		case CBHCompressedModeFrame: return header->_base + CBHCompressedWedge_unpackOne(_payloadAt(header->_offset), header->_bitWidth, position);
+		case CBHCompressedModeRaw: return ((const uint64_t *)_payloadAt(header->_offset))[position];
+		default: return [self valuesOfBlock:block][position];
+	}
+}
+
+- (void)appendUInt64:(uint64_t)value
+{
+	[self appendValues:&value count:1];
+}
+
+- (void)appendValues:(const uint64_t *)values count:(NSUInteger)count
+{
+	_checkAppendable(count);
+
+	uint8_t packed[BLOCK_LENGTH * sizeof(uint64_t)];
+
+	for (NSUInteger i = 0; i < count; ++i)
+	{
+		const NSUInteger position = _count % BLOCK_LENGTH;
+
+		if ( _count > 0 && values[i] < _last ) _isSorted = NO;
+
+		_tail[position] = values[i];
+		_last = values[i];
+		++_count;
+
+		if ( position + 1 < BLOCK_LENGTH ) continue;
+
+		/// The block is full, compress it.
+		/// Cleared first so equal blocks have equal headers, padding included.
+		CBHCompressedBlock_t header;
+		memset(&header, 0, sizeof(CBHCompressedBlock_t));
+		header._offset = [_payload count];
+
+		const NSUInteger length = CBHCompressedWedge_encode(_tail, &header, packed);
+		[_payload appendValues:packed count:length];
+		[_headers appendValue:&header];
+	}
+}
+
+- (void)removeAll
+{
+	[_headers removeAll];
+	[_payload removeAll];
+	_count = 0;
+
+	_last = 0;
+	_isSorted = YES;
+	_cachedBlock = NSNotFound;
+}
+
+
+#pragma mark - Decoding
+
+- (const uint64_t *)valuesOfBlock:(NSUInteger)block
+{
+	if ( block != _cachedBlock )
+	{
+		const CBHCompressedBlock_t *header = _headerAt(block);
+		CBHCompressedWedge_decode(header, _payloadAt(header->_offset), _cache);
+		_cachedBlock = block;
+	}
+
+	return _cache;
+}
+
+- (void)getValues:(uint64_t *)values range:(NSRange)range
+{
+	_checkRange(range);
+
+	NSUInteger index = range.location;
+	const NSUInteger end = NSMaxRange(range);
+
+	while ( index < end )
+	{
+		const NSUInteger block = index / BLOCK_LENGTH;
+		const NSUInteger position = index % BLOCK_LENGTH;
+		const NSUInteger length = MIN(BLOCK_LENGTH - position, end - index);
+
+		if ( block >= [_headers count] )
+		{
+			memcpy(values, _tail + position, length * sizeof(uint64_t));
+		}
+		else if ( position == 0 && length == BLOCK_LENGTH )
+		{
+			/// Whole blocks are decoded straight into place.
+			const CBHCompressedBlock_t *header = _headerAt(block);
+			CBHCompressedWedge_decode(header, _payloadAt(header->_offset), values);
+		}
+		else
+		{
+			memcpy(values, [self valuesOfBlock:block] + position, length * sizeof(uint64_t));
+		}
+
+		values += length;
+		index += length;
+	}
+}
+
+- (NSUInteger)getValues:(uint64_t *)values ofBlock:(NSUInteger)block
+{
+	if ( block >= [self blockCount] ) @throw NSRangeException;
+
+	const NSUInteger first = block * BLOCK_LENGTH;
+	const NSUInteger length = MIN(BLOCK_LENGTH, _count - first);
+
+	[self getValues:values range:NSMakeRange(first, length)];
+	return length;
+}
+
+- (CBHSlice *)slice
+{
+	return [self sliceInRange:NSMakeRange(0, _count)];
+}
+
+- (CBHSlice *)sliceInRange:(NSRange)range
+{
+	_checkRange(range);
+
+	uint64_t *values = CBHMemory_alloc(( range.length > 0 ) ? range.length : 1, sizeof(uint64_t));
+	if ( !values ) @throw CBHCallocException;
+
+	[self getValues:values range:range];
+	return [CBHSlice sliceWithEntrySize:sizeof(uint64_t) owning:range.length entriesFromBytes:values];
+}
+
+
+#pragma mark - Searching
+
+- (NSUInteger)lowerBoundOfValue:(uint64_t)value
+{
+	if ( !_isSorted ) @throw NSInternalInconsistencyException;
+
+	/// Find the first block starting at or past the value, each block's base is its first value.
+	const NSUInteger blockCount = [_headers count];
+	NSUInteger low = 0;
+	NSUInteger high = blockCount;
+
+	while ( low < high )
+	{
+		const NSUInteger middle = low + ((high - low) / 2);
+		if ( _headerAt(middle)->_base < value ) low = middle + 1;
+		else high = middle;
+	}
+
+	if ( low == 0 && blockCount > 0 ) return 0;
+
+	/// Otherwise it is in the block before, or starts the block found.
+	if ( low > 0 )
+	{
+		const uint64_t *values = [self valuesOfBlock:low - 1];
+		for (NSUInteger i = 0; i < BLOCK_LENGTH; ++i)
+		{
+			if ( values[i] >= value ) return ((low - 1) * BLOCK_LENGTH) + i;
+		}
+
+		if ( low < blockCount ) return low * BLOCK_LENGTH;
+	}
+
+	/// Every block is below the value, search the tail.
+	for (NSUInteger i = blockCount * BLOCK_LENGTH; i < _count; ++i)
+	{
+		if ( _tail[i % BLOCK_LENGTH] >= value ) return i;
+	}
+
+	return _count;
+}
+
+@end
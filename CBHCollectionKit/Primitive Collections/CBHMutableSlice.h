@@ -31,9 +31,46 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @interface CBHMutableSlice : CBHSlice
 
+#pragma mark - Initialization
+
+/** Initializes a newly allocated slice backed by the contents of a file mapped into memory.
+ *
+ * The file is mapped shared and writable, so writes to the slice are written through to the file. Pages are loaded as entries are first accessed.
+ *
+ * @param path         The path of the file to map.
+ * @param entrySize    The size of each entry in the slice.
+ * @param options      The layout of the file and how its pages will be accessed.
+ * @param error        On return, the reason the file could not be mapped. May be `NULL`.
+ *
+ * @return             A newly initialized slice with the contents of the file, or `nil` if it could not be mapped.
+ *
+ * @note: Resizing the slice copies its entries out of the file, later writes are not written through.
+ */
+- (nullable instancetype)initWithContentsOfFile:(NSString *)path entrySize:(size_t)entrySize options:(CBHSliceFileOptions)options error:(NSError * _Nullable * _Nullable)error;
+
+
+#pragma mark - Syncing
+
+/** Writes changed entries back to the file backing the receiver and waits for them to be written.
+ *
+ * @return    `YES` if the entries were written, `NO` if they could not be or the receiver is not backed by a file.
+ */
+- (BOOL)sync;
+
+/** Writes changed entries within `range` back to the file backing the receiver and waits for them to be written.
+ *
+ * @param range    The range of entries to write.
+ *
+ * @return         `YES` if the entries were written, `NO` if they could not be or the receiver is not backed by a file.
+ */
+- (BOOL)syncRange:(NSRange)range;
+
+
 #pragma mark - Copying
 
 /** Returns a new instance that’s a copy of the receiver.
+ *
+ * The copy shares the receiver's bytes, whichever is written to first copies them.
  *
  * @param zone    This parameter is ignored. Memory zones are no longer used by Objective-C.
  */
@@ -61,6 +98,17 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)clearValuesInRange:(NSRange)range;
 
 
+#pragma mark - Unsafe Access
+
+/** Calls a block with a writable view of the receiver's entries.
+ *
+ * The view allows reading and writing entries without a message send or bounds check per entry. It must not be used after the block returns, or after the receiver is resized from within the block.
+ *
+ * @param block    The block to call with the view.
+ */
+- (void)withUnsafeMutableBytes:(void (NS_NOESCAPE ^)(CBHMutableSliceView view))block;
+
+
 #pragma mark - Generic Mutators
 
 - (void)setValue:(const void *)value atIndex:(NSUInteger)index;
@@ -130,10 +178,72 @@ NS_ASSUME_NONNULL_BEGIN
 @end
 
 
+#pragma mark - Sorting
+
+@interface CBHMutableSlice (Sorting)
+
+/** Sorts the entries of the receiver in ascending order by interpreting each whole entry as a value of the given type.
+ *
+ * Integer entries are sorted with an in-place radix sort. Large collections are sorted concurrently.
+ *
+ * @param type    How to interpret each entry. The entry size must be 1, 2, 4, or 8 bytes (4 or 8 for `CBHPrimitiveTypeFloat`).
+ */
+- (void)sortAsType:(CBHPrimitiveType)type;
+
+/** Sorts the entries of the receiver in ascending order by a key stored within each entry.
+ *
+ * @param offset    The byte offset of the key within an entry.
+ * @param size      The width of the key in bytes. Must be 1, 2, 4, or 8 (4 or 8 for `CBHPrimitiveTypeFloat`).
+ * @param type      How to interpret the key.
+ */
+- (void)sortByKeyAtOffset:(size_t)offset ofSize:(size_t)size asType:(CBHPrimitiveType)type;
+
+/** Sorts the entries of the receiver using a comparison function.
+ *
+ * Uses a pattern-defeating introsort. The sort is not stable.
+ *
+ * @param comparator    The function used to order two entries.
+ * @param context       A pointer passed through to the comparator.
+ */
+- (void)sortUsingFunction:(CBHPrimitiveComparator)comparator context:(nullable void *)context;
+
+@end
+
+
+#pragma mark - Parallel Operations
+
+@interface CBHMutableSlice (ParallelOperations)
+
+/** Sets every entry of the receiver to the same value.
+ *
+ * Values whose bytes are all equal are written with `memset`, others by repeatedly doubling a written run. Large slices are filled concurrently.
+ *
+ * @param value    A pointer to the entry to copy into every index.
+ */
+- (void)fillWithValue:(const void *)value;
+
+/** Rewrites the entries of the receiver in place using a function.
+ *
+ * Large slices are split into cache sized chunks which are transformed concurrently across all available cores.
+ *
+ * @param function    The function used to rewrite each run of entries.
+ * @param context     A pointer passed through to the function.
+ */
+- (void)transformUsingFunction:(CBHPrimitiveTransform)function context:(nullable void *)context;
+
+@end
+
+
 #pragma mark - Mutable Copying
 
 @interface CBHSlice (MutableCopying) <NSMutableCopying>
 
+/** Returns a new mutable instance that’s a copy of the receiver.
+ *
+ * The copy shares the receiver's bytes until it is first written to.
+ *
+ * @param zone    This parameter is ignored. Memory zones are no longer used by Objective-C.
+ */
 - (id)mutableCopyWithZone:(nullable NSZone *)zone;
 
 @end
@@ -18,6 +18,10 @@
 
 #import "CBHMutableSlice.h"
 #import "_CBHSlice.h"
+#import "_CBHSort.h"
+#import "_CBHHash.h"
+#import "_CBHParallel.h"
+#import "_CBHMappedFile.h"
 
 
 #define checkEntrySize(aType) if (_slice._entrySize != sizeof(aType)) @throw CBHEntrySizeException
@@ -29,16 +33,107 @@
 	CBHSlice_t _slice;
 }
 
+- (instancetype)initWithEntrySize:(size_t)entrySize borrowing:(NSUInteger)count entriesFromBytes:(void *)bytes owner:(id)owner;
+- (instancetype)initWithContentsOfFile:(NSString *)path entrySize:(size_t)entrySize options:(CBHSliceFileOptions)options writable:(BOOL)writable error:(NSError **)error;
+
 @end
 
 
 @implementation CBHMutableSlice
 
+#pragma mark - Initializers
+
+- (instancetype)initWithEntrySize:(size_t)entrySize adoptingData:(NSData *)data
+{
+	if ( entrySize <= 0 || [data length] % entrySize != 0 )
+	{
+		[self release];
+		@throw CBHEntrySizeException;
+	}
+
+	/// Only mutable data can be written through, copy anything else.
+	if ( ![data isKindOfClass:[NSMutableData class]] )
+	{
+		return [self initWithEntrySize:entrySize copying:[data length] / entrySize entriesFromBytes:[data bytes]];
+	}
+
+	NSMutableData *mutableData = (NSMutableData *)data;
+	return [self initWithEntrySize:entrySize borrowing:[mutableData length] / entrySize entriesFromBytes:[mutableData mutableBytes] owner:mutableData];
+}
+
+- (instancetype)initWithEntrySize:(size_t)entrySize adoptingDispatchData:(dispatch_data_t)data
+{
+	const void *bytes = NULL;
+	size_t length = 0;
+
+	/// Dispatch data is immutable, copy it.
+	dispatch_data_t map = dispatch_data_create_map(data, &bytes, &length);
+
+	@try
+	{
+		if ( entrySize <= 0 || length % entrySize != 0 )
+		{
+			[self release];
+			@throw CBHEntrySizeException;
+		}
+
+		self = [self initWithEntrySize:entrySize copying:length / entrySize entriesFromBytes:bytes];
+	}
+	@finally
+	{
+		dispatch_release(map);
+	}
+
+	return self;
+}
+
+- (instancetype)initWithContentsOfFile:(NSString *)path entrySize:(size_t)entrySize options:(CBHSliceFileOptions)options error:(NSError **)error
+{
+	return [self initWithContentsOfFile:path entrySize:entrySize options:options writable:YES error:error];
+}
+
+
+#pragma mark - Syncing
+
+- (BOOL)sync
+{
+	return [self syncRange:NSMakeRange(0, _slice._capacity)];
+}
+
+- (BOOL)syncRange:(NSRange)range
+{
+	if ( range.location > _slice._capacity || range.length > _slice._capacity - range.location ) @throw NSRangeException;
+
+	/// Resizing copies the entries out of the file.
+	if ( !CBHMappedFile_isMappedFile(_slice._owner) ) return NO;
+	if ( range.length <= 0 ) return YES;
+
+	return CBHMappedFile_sync(_slice._owner, CBHSlice_pointerToOffset(&_slice, range.location), range.length * _slice._entrySize);
+}
+
+
 #pragma mark - Copying
 
 - (id)copyWithZone:(NSZone *)zone
 {
-	return [[CBHSlice allocWithZone:zone] initWithEntrySize:_slice._entrySize copying:_slice._capacity entriesFromBytes:_slice._data];
+	/// Bytes written through to other objects can't be shared.
+	id owner = CBHSlice_shareStorage(&_slice);
+	if ( !owner ) return [[CBHSlice allocWithZone:zone] initWithEntrySize:_slice._entrySize copying:_slice._capacity entriesFromBytes:_slice._data];
+
+	/// The shared bytes were allocated with our options, so the copy reallocates them the same way.
+	CBHSlice *copy = [[CBHSlice allocWithZone:zone] initWithEntrySize:_slice._entrySize borrowing:_slice._capacity entriesFromBytes:_slice._data owner:owner];
+	copy->_slice._options = _slice._options;
+
+	return copy;
+}
+
+
+#pragma mark - Equality
+
+- (NSUInteger)hash
+{
+	/// The bytes can be written at any time, even through a view, so they are hashed on every call rather than cached.
+	return (NSUInteger)CBHHash(_slice._data, _slice._capacity * _slice._entrySize, _slice._entrySize);
 }
 
 
@@ -92,6 +187,17 @@
 }
 
 
+#pragma mark - Unsafe Access
+
+- (void)withUnsafeMutableBytes:(void (NS_NOESCAPE ^)(CBHMutableSliceView view))block
+{
+	CBHSlice_makeUnique(&_slice);
+
+	CBHMutableSliceView view = {_slice._data, _slice._capacity, _slice._entrySize, &_slice._generation, _slice._generation};
+	block(view);
+}
+
+
 #pragma mark - Generic Mutators
 
 - (void)setValue:(const void *)value atIndex:(NSUInteger)index
@@ -254,13 +360,64 @@
 @end
 
 
+#pragma mark - Sorting
+
+@implementation CBHMutableSlice (Sorting)
+
+- (void)sortAsType:(CBHPrimitiveType)type
+{
+	CBHSlice_makeUnique(&_slice);
+	CBHSort_sortByKey(_slice._data, _slice._capacity, _slice._entrySize, 0, _slice._entrySize, type);
+}
+
+- (void)sortByKeyAtOffset:(size_t)offset ofSize:(size_t)size asType:(CBHPrimitiveType)type
+{
+	CBHSlice_makeUnique(&_slice);
+	CBHSort_sortByKey(_slice._data, _slice._capacity, _slice._entrySize, offset, size, type);
+}
+
+- (void)sortUsingFunction:(CBHPrimitiveComparator)comparator context:(void *)context
+{
+	CBHSlice_makeUnique(&_slice);
+	CBHSort_sortUsingComparator(_slice._data, _slice._capacity, _slice._entrySize, comparator, context);
+}
+
+@end
+
+
+#pragma mark - Parallel Operations
+
+@implementation CBHMutableSlice (ParallelOperations)
+
+- (void)fillWithValue:(const void *)value
+{
+	CBHSlice_makeUnique(&_slice);
+	CBHParallel_fill(_slice._data, _slice._capacity, _slice._entrySize, value);
+}
+
+- (void)transformUsingFunction:(CBHPrimitiveTransform)function context:(void *)context
+{
+	CBHSlice_makeUnique(&_slice);
+	CBHParallel_transform(_slice._data, _slice._capacity, _slice._entrySize, function, context);
+}
+
+@end
+
+
 #pragma mark - Mutable Copying
 
 @implementation CBHSlice (MutableCopying)
 
 - (id)mutableCopyWithZone:(nullable NSZone *)zone
 {
-	return [[CBHMutableSlice allocWithZone:zone] initWithEntrySize:_slice._entrySize copying:_slice._capacity entriesFromBytes:_slice._data];
+	id owner = CBHSlice_shareStorage(&_slice);
+	if ( !owner ) return [[CBHMutableSlice allocWithZone:zone] initWithEntrySize:_slice._entrySize copying:_slice._capacity entriesFromBytes:_slice._data];
+
+	/// The shared bytes were allocated with our options, so the copy reallocates them the same way.
+	CBHMutableSlice *copy = [[CBHMutableSlice allocWithZone:zone] initWithEntrySize:_slice._entrySize borrowing:_slice._capacity entriesFromBytes:_slice._data owner:owner];
+	copy->_slice._options = _slice._options;
+
+	return copy;
 }
 
 @end
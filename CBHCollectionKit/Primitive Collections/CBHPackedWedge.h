@@ -0,0 +1,180 @@
+//  CBHPackedWedge.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import <CBHCollectionKit/CBHPrimitiveCollection.h>
+#import <CBHCollectionKit/CBHAllocation.h>
+#import <CBHCollectionKit/CBHWedge.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** A dynamic ordered collection of unsigned integers packed at a fixed bit width.
+ *
+ * A Packed Wedge stores each value in `bitWidth` bits, from 1 to 64, back to back in 64-bit words. Writing a value too wide for the current width widens every value first, so the width only ever grows to fit the widest value written.
+ *
+ * Values are read and written as `uint64_t`, which is the collection's `entrySize`. Bulk packing and unpacking move whole runs of 1, 2, 4, or 8 byte unsigned integers at once. Unpacking shifts and masks four values at a time in vector lanes, each loaded with a single unaligned read. Packing is a scalar loop which builds each word in a register and stores it once.
+ *
+ * @author    Christian Huxtable <chris@huxtable.ca>
+ */
+@interface CBHPackedWedge : NSObject <NSCopying, CBHPrimitiveCollection, CBHCollectionResizable>
+
+#pragma mark - Factories
+
++ (instancetype)packedWedgeWithBitWidth:(NSUInteger)bitWidth;
++ (instancetype)packedWedgeWithBitWidth:(NSUInteger)bitWidth andCapacity:(NSUInteger)capacity;
++ (instancetype)packedWedgeWithBitWidth:(NSUInteger)bitWidth andCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options;
+
++ (instancetype)packedWedgeWithWedge:(CBHWedge *)wedge;
+
+
+#pragma mark - Initialization
+
+- (instancetype)initWithBitWidth:(NSUInteger)bitWidth;
+- (instancetype)initWithBitWidth:(NSUInteger)bitWidth andCapacity:(NSUInteger)capacity;
+
+/** Initializes an empty packed wedge whose words are allocated as described by `options`.
+ *
+ * @param bitWidth    The number of bits each value starts with, from 1 to 64.
+ * @param capacity    The number of values the packed wedge can hold before growing.
+ * @param options     The alignment, paging, and allocator of the packed wedge's words.
+ *
+ * @return            An initialized empty packed wedge.
+ */
+- (instancetype)initWithBitWidth:(NSUInteger)bitWidth andCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options NS_DESIGNATED_INITIALIZER;
+
+/** Initializes a packed wedge with the entries of `wedge`, packed as narrowly as its widest entry allows.
+ *
+ * @param wedge    A wedge of unsigned integers 1, 2, 4, or 8 bytes wide.
+ *
+ * @return         An initialized packed wedge.
+ */
+- (instancetype)initWithWedge:(CBHWedge *)wedge;
+
+
+#pragma mark - Properties
+
+@property (nonatomic, readonly) NSUInteger count;
+@property (nonatomic, readonly) NSUInteger capacity;
+@property (nonatomic, readonly) size_t entrySize;
+
+@property (nonatomic, readonly) BOOL isEmpty;
+
+/** The number of bits each value is stored in. */
+@property (nonatomic, readonly) NSUInteger bitWidth;
+
+@property (nonatomic, readonly) const void *bytes;
+
+@property (nonatomic, readonly) CBHAllocationOptions allocationOptions;
+
+
+#pragma mark - Copying
+
+- (id)copyWithZone:(nullable NSZone *)zone;
+
+
+#pragma mark - Equality
+
+- (BOOL)isEqual:(id)other;
+
+/** Whether the values of the receiver and `other` are equal, whatever their widths.
+ *
+ * @param other    The packed wedge to compare with.
+ *
+ * @return         `YES` if both hold the same values in the same order, otherwise `NO`.
+ */
+- (BOOL)isEqualToPackedWedge:(CBHPackedWedge *)other;
+
+- (NSUInteger)hash;
+
+
+#pragma mark - Resizing
+
+- (BOOL)shrink;
+
+- (BOOL)grow;
+- (BOOL)growToFit:(NSUInteger)neededCapacity;
+
+- (BOOL)resize:(NSUInteger)newCapacity;
+
+/** Repacks every value at a wider width. Narrower widths are ignored.
+ *
+ * @param bitWidth    The new width, up to 64.
+ */
+- (void)widenToBitWidth:(NSUInteger)bitWidth;
+
+
+#pragma mark - Description
+
+- (NSString *)description;
+- (NSString *)debugDescription;
+
+
+#pragma mark - Values
+
+- (uint64_t)uint64AtIndex:(NSUInteger)index;
+- (void)appendUInt64:(uint64_t)value;
+- (void)setUInt64:(uint64_t)value atIndex:(NSUInteger)index;
+
+
+#pragma mark - Clearing
+
+- (void)removeAll;
+- (void)removeLast:(NSUInteger)count;
+
+
+#pragma mark - Bulk Packing
+
+/** Packs and appends unsigned integers, widening once to fit the widest of them.
+ *
+ * @param values       The integers to append.
+ * @param count        The number of integers.
+ * @param entrySize    The size of each integer. Must be 1, 2, 4, or 8.
+ */
+- (void)appendValues:(const void *)values count:(NSUInteger)count entrySize:(size_t)entrySize;
+
+- (void)appendWedge:(CBHWedge *)wedge;
+
+
+#pragma mark - Bulk Unpacking
+
+/** Unpacks a range of values into unsigned integers of `entrySize`.
+ *
+ * @param values       The buffer to unpack into. It must hold `range.length` entries.
+ * @param range        The range of values to unpack.
+ * @param entrySize    The size of each integer. Must be 1, 2, 4, or 8, and at least as wide as `bitWidth`.
+ */
+- (void)getValues:(void *)values range:(NSRange)range entrySize:(size_t)entrySize;
+
+/** Unpacks every value into a new wedge of unsigned integers of `entrySize`.
+ *
+ * @param entrySize    The size of each entry. Must be 1, 2, 4, or 8, and at least as wide as `bitWidth`.
+ *
+ * @return             A wedge of the unpacked values.
+ */
+- (CBHWedge *)wedgeWithEntrySize:(size_t)entrySize;
+
+
+#pragma mark - Unavailable
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,607 @@
+//  CBHPackedWedge.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHPackedWedge.h"
+#import "_CBHStack.h"
+#import "_CBHHash.h"
+
+@import CBHMemoryKit;
+
+
+#define DEFAULT_CAPACITY 64
+#define GROWTH_FACTOR 1.618033988749895
+
+#define WORD_BITS ((NSUInteger)64)
+
+/// Widths up to this many bits are read with a single unaligned load, whatever their offset within a byte.
+#define MAX_UNALIGNED_WIDTH ((NSUInteger)57)
+
+/// Values are repacked through a buffer of this many values when widening.
+#define REPACK_CHUNK 256
+
+/// Values are unpacked this many at a time, one to a lane.
+#define LANE_COUNT ((NSUInteger)4)
+
+#define _words ((uint64_t *)_stack._data)
+#define _mask(aWidth) (~(uint64_t)0 >> (WORD_BITS - (aWidth)))
+#define _bitsFor(aValue) (( (aValue) != 0 ) ? (WORD_BITS - (NSUInteger)__builtin_clzll(aValue)) : 1)
+
+/// One spare word past the values lets any value be read with a single unaligned 64-bit load.
+#define _wordsFor(aCount, aWidth) ((((aCount) * (aWidth)) + (WORD_BITS - 1)) / WORD_BITS + 1)
+#define _capacityOf(aWordCount, aWidth) ((((aWordCount) - 1) * WORD_BITS) / (aWidth))
+
+#define _checkWidth(aWidth) if ( (aWidth) < 1 || (aWidth) > WORD_BITS ) @throw NSInvalidArgumentException
+#define _checkReadableIndex(anIndex) if ( (anIndex) >= _count ) @throw NSRangeException
+#define _checkAppendable(aCount) if ( (aCount) > NSUIntegerMax - _count ) @throw NSRangeException
+#define _checkUnpackable(anEntrySize) if ( ((anEntrySize) * 8) < _bitWidth ) @throw CBHEntrySizeException
+
+#define _nextCapacity(aCapacity) (size_t)ceil((double)(aCapacity) * GROWTH_FACTOR)
+
+
+/// Four values being unpacked, each with the word loaded from its first byte.
+typedef uint64_t CBHPackedLanes __attribute__((vector_size(LANE_COUNT * sizeof(uint64_t)), aligned(8)));
+
+
+/// Unaligned loads read the bit stream in order only when words are little endian.
+_Static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Packed values assume little endian words.");
+
+
+#pragma mark - Packing
+
+static inline uint64_t CBHPackedWedge_get(const uint64_t *words, NSUInteger bitWidth, NSUInteger index)
+{
+	const NSUInteger bit = index * bitWidth;
+	const NSUInteger shift = bit % WORD_BITS;
+
+	if ( bitWidth <= MAX_UNALIGNED_WIDTH )
+	{
+		uint64_t word;
+		memcpy(&word, (const uint8_t *)words + (bit / 8), sizeof(uint64_t));
+		return (word >> (bit % 8)) & _mask(bitWidth);
+	}
+
+	uint64_t value = words[bit / WORD_BITS] >> shift;
+	if ( shift + bitWidth > WORD_BITS ) { value |= words[(bit / WORD_BITS) + 1] << (WORD_BITS - shift); }
+
+	return value & _mask(bitWidth);
+}
+
+static inline void CBHPackedWedge_set(uint64_t *words, NSUInteger bitWidth, NSUInteger index, uint64_t value)
+{
+	const NSUInteger bit = index * bitWidth;
+	const NSUInteger word = bit / WORD_BITS;
+	const NSUInteger shift = bit % WORD_BITS;
+	const uint64_t mask = _mask(bitWidth);
+
+	words[word] = (words[word] & ~(mask << shift)) | (value << shift);
+
+	/// Finish values which straddle two words.
+	if ( shift + bitWidth > WORD_BITS )
+	{
+		const NSUInteger spilled = WORD_BITS - shift;
+		words[word + 1] = (words[word + 1] & ~(mask >> spilled)) | (value >> spilled);
+	}
+}
+
+/// Defines functions which pack, unpack, and find the width of runs of unsigned integers of `aType`.
+#define _defineCodec(aType)\
+static void CBHPackedWedge_pack_##aType(uint64_t *words, NSUInteger bitWidth, NSUInteger first, NSUInteger count, const aType *values)\
+{\
+	if ( count <= 0 ) return;\
+\
+	NSUInteger word = (first * bitWidth) / WORD_BITS;\
+	NSUInteger shift = (first * bitWidth) % WORD_BITS;\
+\
+	/* Collect bits in a register, storing each word once it fills. */\
+	uint64_t pending = ( shift ) ? words[word] & (~(uint64_t)0 >> (WORD_BITS - shift)) : 0;\
+	for (NSUInteger i = 0; i < count; ++i)\
+	{\
+		const uint64_t value = values[i];\
+		pending |= value << shift;\
+		shift += bitWidth;\
+\
+		if ( shift >= WORD_BITS )\
+		{\
+			words[word++] = pending;\
+			shift -= WORD_BITS;\
+			pending = ( shift ) ? value >> (bitWidth - shift) : 0;\
+		}\
+	}\
+\
+	if ( shift ) { words[word] = pending; }\
+}\
+\
+static void CBHPackedWedge_unpack_##aType(const uint64_t *words, NSUInteger bitWidth, NSUInteger first, NSUInteger count, aType *values)\
+{\
+	/* Byte sized widths are already laid out as an array. */\
+	if ( bitWidth == sizeof(aType) * 8 )\
+	{\
+		memcpy(values, (const aType *)words + first, count * sizeof(aType));\
+		return;\
+	}\
+\
+	if ( bitWidth > MAX_UNALIGNED_WIDTH )\
+	{\
+		for (NSUInteger i = 0; i < count; ++i) { values[i] = (aType)CBHPackedWedge_get(words, bitWidth, first + i); }\
+		return;\
+	}\
+\
+	/* One unaligned load per value, then the shifts and masks of four values at once. */\
+	const uint8_t *bytes = (const uint8_t *)words;\
+	const uint64_t mask = _mask(bitWidth);\
+	const uint64_t step = LANE_COUNT * bitWidth;\
+	const uint64_t start = first * bitWidth;\
+\
+	CBHPackedLanes bits = {start, start + bitWidth, start + (2 * bitWidth), start + (3 * bitWidth)};\
+	NSUInteger i = 0;\
+\
+	for (; i + LANE_COUNT <= count; i += LANE_COUNT, bits += step)\
+	{\
+		CBHPackedLanes lanes = {0, 0, 0, 0};\
+		for (NSUInteger lane = 0; lane < LANE_COUNT; ++lane)\
+		{\
+			uint64_t word;\
+			memcpy(&word, bytes + (bits[lane] / 8), sizeof(uint64_t));\
+			lanes[lane] = word;\
+		}\
+\
+		lanes = (lanes >> (bits & 7)) & mask;\
+		for (NSUInteger lane = 0; lane < LANE_COUNT; ++lane) { values[i + lane] = (aType)lanes[lane]; }\
+	}\
+\
+	for (NSUInteger bit = (NSUInteger)bits[0]; i < count; ++i, bit += bitWidth)\
+	{\
+		uint64_t word;\
+		memcpy(&word, bytes + (bit / 8), sizeof(uint64_t));\
+		values[i] = (aType)((word >> (bit % 8)) & mask);\
+	}\
+}\
+\
+static NSUInteger CBHPackedWedge_width_##aType(const aType *values, NSUInteger count)\
+{\
+	/* The widest value has the highest set bit of them all. */\
+	uint64_t bits = 0;\
+	for (NSUInteger i = 0; i < count; ++i) { bits |= values[i]; }\
+\
+	return _bitsFor(bits);\
+}
+
+_defineCodec(uint8_t)
+_defineCodec(uint16_t)
+_defineCodec(uint32_t)
+_defineCodec(uint64_t)
+
+static NSUInteger CBHPackedWedge_width(const void *values, NSUInteger count, size_t entrySize)
+{
+	switch (entrySize)
+	{
+		case sizeof(uint8_t): return CBHPackedWedge_width_uint8_t(values, count);
+		case sizeof(uint16_t): return CBHPackedWedge_width_uint16_t(values, count);
+		case sizeof(uint32_t): return CBHPackedWedge_width_uint32_t(values, count);
+		case sizeof(uint64_t): return CBHPackedWedge_width_uint64_t(values, count);
+		default: @throw CBHEntrySizeException;
+	}
+}
+
+static void CBHPackedWedge_pack(uint64_t *words, NSUInteger bitWidth, NSUInteger first, NSUInteger count, const void *values, size_t entrySize)
+{
+	switch (entrySize)
+	{
+		case sizeof(uint8_t): CBHPackedWedge_pack_uint8_t(words, bitWidth, first, count, values); break;
+		case sizeof(uint16_t): CBHPackedWedge_pack_uint16_t(words, bitWidth, first, count, values); break;
+		case sizeof(uint32_t): CBHPackedWedge_pack_uint32_t(words, bitWidth, first, count, values); break;
+		case sizeof(uint64_t): CBHPackedWedge_pack_uint64_t(words, bitWidth, first, count, values); break;
+		default: @throw CBHEntrySizeException;
+	}
+}
+
+static void CBHPackedWedge_unpack(const uint64_t *words, NSUInteger bitWidth, NSUInteger first, NSUInteger count, void *values, size_t entrySize)
+{
+	switch (entrySize)
+	{
+		case sizeof(uint8_t): CBHPackedWedge_unpack_uint8_t(words, bitWidth, first, count, values); break;
+		case sizeof(uint16_t): CBHPackedWedge_unpack_uint16_t(words, bitWidth, first, count, values); break;
+		case sizeof(uint32_t): CBHPackedWedge_unpack_uint32_t(words, bitWidth, first, count, values); break;
+		case sizeof(uint64_t): CBHPackedWedge_unpack_uint64_t(words, bitWidth, first, count, values); break;
+		default: @throw CBHEntrySizeException;
+	}
+}
+
+
+@interface CBHPackedWedge ()
+{
+	CBHStack_t _stack;
+	NSUInteger _count;
+	NSUInteger _bitWidth;
+}
+
+/// Makes room for `count` values at `bitWidth`, which may be wider than the current width.
+- (void)reserveCount:(NSUInteger)count bitWidth:(NSUInteger)bitWidth;
+
+@end
+
+
+@implementation CBHPackedWedge
+
+#pragma mark - Factories
+
++ (instancetype)packedWedgeWithBitWidth:(NSUInteger)bitWidth
+{
+	return [[(CBHPackedWedge *)[self alloc] initWithBitWidth:bitWidth] autorelease];
+}
+
++ (instancetype)packedWedgeWithBitWidth:(NSUInteger)bitWidth andCapacity:(NSUInteger)capacity
+{
+	return [[(CBHPackedWedge *)[self alloc] initWithBitWidth:bitWidth andCapacity:capacity] autorelease];
+}
+
++ (instancetype)packedWedgeWithBitWidth:(NSUInteger)bitWidth andCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options
+{
+	return [[(CBHPackedWedge *)[self alloc] initWithBitWidth:bitWidth andCapacity:capacity options:options] autorelease];
+}
+
++ (instancetype)packedWedgeWithWedge:(CBHWedge *)wedge
+{
+	return [[(CBHPackedWedge *)[self alloc] initWithWedge:wedge] autorelease];
+}
+
+
+#pragma mark - Initialization
+
+- (instancetype)initWithBitWidth:(NSUInteger)bitWidth
+{
+	return [self initWithBitWidth:bitWidth andCapacity:DEFAULT_CAPACITY];
+}
+
+- (instancetype)initWithBitWidth:(NSUInteger)bitWidth andCapacity:(NSUInteger)capacity
+{
+	return [self initWithBitWidth:bitWidth andCapacity:capacity options:CBHAllocationOptionsDefault];
+}
+
+- (instancetype)initWithBitWidth:(NSUInteger)bitWidth andCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options
+{
+	_checkWidth(bitWidth);
+
+	if ( (self = [super init]) )
+	{
+		_stack = CBHStack_initWithOptions(_wordsFor(capacity, bitWidth), sizeof(uint64_t), &options);
+		_count = 0;
+		_bitWidth = bitWidth;
+	}
+
+	return self;
+}
+
+- (instancetype)initWithWedge:(CBHWedge *)wedge
+{
+	if ( (self = [self initWithBitWidth:1 andCapacity:[wedge count]]) )
+	{
+		[self appendWedge:wedge];
+	}
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	CBHStack_dealloc(&_stack);
+
+	[super dealloc];
+}
+
+
+#pragma mark - Properties
+
+- (NSUInteger)count
+{
+	return _count;
+}
+
+- (NSUInteger)capacity
+{
+	return _capacityOf(_stack._capacity, _bitWidth);
+}
+
+- (size_t)entrySize
+{
+	return sizeof(uint64_t);
+}
+
+- (BOOL)isEmpty
+{
+	return ( _count <= 0 );
+}
+
+- (NSUInteger)bitWidth
+{
+	return _bitWidth;
+}
+
+- (const void *)bytes
+{
+	return _stack._data;
+}
+
+- (CBHAllocationOptions)allocationOptions
+{
+	return _stack._options;
+}
+
+
+#pragma mark - Copying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	CBHPackedWedge *copy = [[CBHPackedWedge allocWithZone:zone] initWithBitWidth:_bitWidth andCapacity:_count options:_stack._options];
+	memcpy(copy->_stack._data, _stack._data, _wordsFor(_count, _bitWidth) * sizeof(uint64_t));
+	copy->_count = _count;
+
+	return copy;
+}
+
+
+#pragma mark - Equality
+
+- (BOOL)isEqual:(id)other
+{
+	if ( [other isKindOfClass:[CBHPackedWedge class]] ) return [self isEqualToPackedWedge:other];
+	return [super isEqual:other];
+}
+
+- (BOOL)isEqualToPackedWedge:(CBHPackedWedge *)other
+{
+	/// Catch trivial cases.
+	if ( self == other ) return YES;
+	if ( _count != other->_count ) return NO;
+	if ( _count <= 0 ) return YES;
+
+	const uint64_t *otherWords = (const uint64_t *)other->_stack._data;
+
+	/// Values of different widths are compared one by one.
+	if ( _bitWidth != other->_bitWidth )
+	{
+		for (NSUInteger i = 0; i < _count; ++i)
+		{
+			if ( CBHPackedWedge_get(_words, _bitWidth, i) != CBHPackedWedge_get(otherWords, other->_bitWidth, i) ) return NO;
+		}
+
+		return YES;
+	}
+
+	/// Compare whole words, then the bits of the last partial word which hold values.
+	const NSUInteger bits = _count * _bitWidth;
+	const NSUInteger wholeWords = bits / WORD_BITS;
+
+	if ( wholeWords > 0 && !CBHMemory_compare(_stack._data, other->_stack._data, wholeWords, sizeof(uint64_t)) ) return NO;
+	if ( bits % WORD_BITS == 0 ) return YES;
+
+	const uint64_t mask = _mask(bits % WORD_BITS);
+	return ( (_words[wholeWords] & mask) == (otherWords[wholeWords] & mask) );
+}
+
+- (NSUInteger)hash
+{
+	/// Hash every value unpacked, in chunks which don't depend on the width, so wedges equal at different widths hash the same.
+	uint64_t values[REPACK_CHUNK];
+	uint64_t hash = _count;
+
+	for (NSUInteger first = 0; first < _count; first += REPACK_CHUNK)
+	{
+		const NSUInteger count = MIN((NSUInteger)REPACK_CHUNK, _count - first);
+		CBHPackedWedge_unpack(_words, _bitWidth, first, count, values, sizeof(uint64_t));
+		hash = CBHHash(values, count * sizeof(uint64_t), hash);
+	}
+
+	return (NSUInteger)hash;
+}
+
+
+#pragma mark - Resizable
+
+- (BOOL)shrink
+{
+	/// Prevent empty capacity.
+	const NSUInteger newCapacity = _wordsFor(( _count > 0 ) ? _count : 1, _bitWidth);
+
+	/// Shrink.
+	CBHStack_setCapacity(&_stack, newCapacity);
+	return YES;
+}
+
+- (BOOL)grow
+{
+	/// Early return if growth unnecessary.
+	if ( _capacityOf(_stack._capacity, _bitWidth) > _count ) return NO;
+
+	/// Grow.
+	CBHStack_setCapacity(&_stack, _nextCapacity(_stack._capacity));
+	return YES;
+}
+
+- (BOOL)growToFit:(NSUInteger)neededCapacity
+{
+	/// Early return if growth unnecessary.
+	const NSUInteger neededWords = _wordsFor(neededCapacity, _bitWidth);
+	if ( neededWords <= _stack._capacity ) return NO;
+
+	/// Find new capacity which fits the needed capacity.
+	NSUInteger nextCapacity = ( _stack._capacity > 0 ) ? _stack._capacity : 1;
+	while ( neededWords > nextCapacity ) { nextCapacity = _nextCapacity(nextCapacity); }
+
+	/// Grow.
+	CBHStack_setCapacity(&_stack, nextCapacity);
+	return YES;
+}
+
+- (BOOL)resize:(NSUInteger)newCapacity
+{
+	/// Early return if resize unnecessary.
+	const NSUInteger newWords = _wordsFor(newCapacity, _bitWidth);
+	if ( newCapacity <= 0 ) return NO;
+	if ( newWords == _stack._capacity ) return NO;
+	if ( newCapacity < _count ) return NO;
+
+	/// Resize.
+	CBHStack_setCapacity(&_stack, newWords);
+	return YES;
+}
+
+- (void)widenToBitWidth:(NSUInteger)bitWidth
+{
+	_checkWidth(bitWidth);
+	if ( bitWidth <= _bitWidth ) return;
+
+	[self reserveCount:_count bitWidth:bitWidth];
+}
+
+- (void)reserveCount:(NSUInteger)count bitWidth:(NSUInteger)bitWidth
+{
+	if ( bitWidth <= _bitWidth )
+	{
+		[self growToFit:count];
+		return;
+	}
+
+	/// Repack into new words, keeping the capacity in values.
+	const NSUInteger capacity = MAX(count, _capacityOf(_stack._capacity, _bitWidth));
+	CBHStack_t stack = CBHStack_initWithOptions(_wordsFor(capacity, bitWidth), sizeof(uint64_t), &_stack._options);
+
+	uint64_t buffer[REPACK_CHUNK];
+	for (NSUInteger first = 0; first < _count; first += REPACK_CHUNK)
+	{
+		const NSUInteger length = MIN((NSUInteger)REPACK_CHUNK, _count - first);
+		CBHPackedWedge_unpack_uint64_t(_words, _bitWidth, first, length, buffer);
+		CBHPackedWedge_pack_uint64_t(stack._data, bitWidth, first, length, buffer);
+	}
+
+	CBHStack_dealloc(&_stack);
+	_stack = stack;
+	_bitWidth = bitWidth;
+}
+
+
+#pragma mark - Description
+
+- (NSString *)description
+{
+	NSMutableString *description = [NSMutableString stringWithString:@"("];
+
+	for (NSUInteger i = 0; i < _count; ++i)
+	{
+		[description appendFormat:@"\n\t%llu", CBHPackedWedge_get(_words, _bitWidth, i)];
+		if ( i != _count - 1 ) { [description appendString:@","]; }
+	}
+
+	return [NSString stringWithFormat:@"%@\n)", description];
+}
+
+- (NSString *)debugDescription
+{
+	return [NSString stringWithFormat:@"<%@: %p> %lu bits %@", [self class], (void *)self, (unsigned long)_bitWidth, [self description]];
+}
+
+
+#pragma mark - Values
+
+- (uint64_t)uint64AtIndex:(NSUInteger)index
+{
+	_checkReadableIndex(index);
+	return CBHPackedWedge_get(_words, _bitWidth, index);
+}
+
+- (void)appendUInt64:(uint64_t)value
+{
+	[self appendValues:&value count:1 entrySize:sizeof(uint64_t)];
+}
+
+- (void)setUInt64:(uint64_t)value atIndex:(NSUInteger)index
+{
+	if ( index == _count )
+	{
+		[self appendUInt64:value];
+		return;
+	}
+
+	_checkReadableIndex(index);
+
+	const NSUInteger bitWidth = _bitsFor(value);
+	if ( bitWidth > _bitWidth ) { [self widenToBitWidth:bitWidth]; }
+
+	CBHPackedWedge_set(_words, _bitWidth, index, value);
+}
+
+
+#pragma mark - Clearing
+
+- (void)removeAll
+{
+	_count = 0;
+}
+
+- (void)removeLast:(NSUInteger)count
+{
+	_count = ( count >= _count ) ? 0 : _count - count;
+}
+
+
+#pragma mark - Bulk Packing
+
+- (void)appendValues:(const void *)values count:(NSUInteger)count entrySize:(size_t)entrySize
+{
+	_checkAppendable(count);
+
+	const NSUInteger bitWidth = CBHPackedWedge_width(values, count, entrySize);
+
+	[self reserveCount:_count + count bitWidth:bitWidth];
+	CBHPackedWedge_pack(_words, _bitWidth, _count, count, values, entrySize);
+
+	_count += count;
+}
+
+- (void)appendWedge:(CBHWedge *)wedge
+{
+	[self appendValues:[wedge bytes] count:[wedge count] entrySize:[wedge entrySize]];
+}
+
+
+#pragma mark - Bulk Unpacking
+
+- (void)getValues:(void *)values range:(NSRange)range entrySize:(size_t)entrySize
+{
+	if ( range.location > _count || range.length > _count - range.location ) @throw NSRangeException;
+	_checkUnpackable(entrySize);
+
+	CBHPackedWedge_unpack(_words, _bitWidth, range.location, range.length, values, entrySize);
+}
+
+- (CBHWedge *)wedgeWithEntrySize:(size_t)entrySize
+{
+	_checkUnpackable(entrySize);
+	if ( _count <= 0 ) return [CBHWedge wedgeWithEntrySize:entrySize];
+
+	/// Unpack straight into the bytes the wedge adopts.
+	NSMutableData *data = [NSMutableData dataWithLength:_count * entrySize];
+	[self getValues:[data mutableBytes] range:NSMakeRange(0, _count) entrySize:entrySize];
+
+	return [CBHWedge wedgeWithEntrySize:entrySize adoptingData:data];
+}
+
+@end
@@ -0,0 +1,158 @@
+//  CBHPrimitiveHashMap.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import <CBHCollectionKit/CBHPrimitiveCollection.h>
+#import <CBHCollectionKit/CBHWedge.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** A dynamic unordered collection of primitive values, each stored at a distinct primitive key.
+ *
+ * A Primitive Hash Map stores its keys and values inline and compares keys by their bytes, so integer or struct keys need no boxing. Lookups compare sixteen one-byte hash fragments at a time before touching any key.
+ *
+ * @note: Keys are compared byte for byte. Structs with padding should be cleared before being filled.
+ *
+ * @author    Christian Huxtable <chris@huxtable.ca>
+ */
+@interface CBHPrimitiveHashMap : NSObject <NSCopying, CBHCollectionResizable>
+
+#pragma mark - Factories
+
++ (instancetype)hashMapWithKeySize:(size_t)keySize valueSize:(size_t)valueSize;
++ (instancetype)hashMapWithKeySize:(size_t)keySize valueSize:(size_t)valueSize andCapacity:(NSUInteger)capacity;
+
+
+#pragma mark - Initialization
+
+- (instancetype)initWithKeySize:(size_t)keySize valueSize:(size_t)valueSize;
+
+/** Initializes an empty map.
+ *
+ * @param keySize      The size of each key in bytes.
+ * @param valueSize    The size of each value in bytes.
+ * @param capacity     The number of entries the map can hold before growing.
+ *
+ * @return             An initialized empty map.
+ */
+- (instancetype)initWithKeySize:(size_t)keySize valueSize:(size_t)valueSize andCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+
+
+#pragma mark - Properties
+
+@property (nonatomic, readonly) NSUInteger count;
+
+/** The number of entries which fit before the map grows. */
+@property (nonatomic, readonly) NSUInteger capacity;
+
+@property (nonatomic, readonly) size_t keySize;
+@property (nonatomic, readonly) size_t valueSize;
+
+@property (nonatomic, readonly) BOOL isEmpty;
+
+
+#pragma mark - Copying
+
+- (id)copyWithZone:(nullable NSZone *)zone;
+
+
+#pragma mark - Equality
+
+- (BOOL)isEqual:(id)other;
+- (BOOL)isEqualToHashMap:(CBHPrimitiveHashMap *)other;
+
+- (NSUInteger)hash;
+
+
+#pragma mark - Conversion
+
+/** A wedge of the keys, in the same order as `valueWedge`. */
+- (CBHWedge *)keyWedge;
+
+/** A wedge of the values, in the same order as `keyWedge`. */
+- (CBHWedge *)valueWedge;
+
+
+#pragma mark - Resizing
+
+- (BOOL)shrink;
+
+- (BOOL)grow;
+- (BOOL)growToFit:(NSUInteger)neededCapacity;
+
+- (BOOL)resize:(NSUInteger)newCapacity;
+
+
+#pragma mark - Description
+
+- (NSString *)description;
+- (NSString *)debugDescription;
+
+
+#pragma mark - Accessors
+
+- (BOOL)containsKey:(const void *)key;
+
+/** The value stored at a key.
+ *
+ * @param key    A pointer to the key.
+ *
+ * @return       A pointer to the value, valid until the map is next mutated, or `NULL` if the key is absent.
+ */
+- (nullable const void *)valueAtKey:(const void *)key;
+
+/** Stores a value at a key, replacing any value already there.
+ *
+ * @param value    A pointer to the value.
+ * @param key      A pointer to the key.
+ */
+- (void)setValue:(const void *)value atKey:(const void *)key;
+
+/** Copies out the values at many keys at once. Each batch of keys is hashed and its slots prefetched before any is compared, so the cache misses of large maps overlap.
+ *
+ * @param values    A pointer to room for `count` values. Values of absent keys are left untouched.
+ * @param keys      A pointer to `count` consecutive keys.
+ * @param count     The number of keys.
+ * @param found     A pointer to room for `count` results, or `NULL`.
+ *
+ * @return          The number of keys present.
+ */
+- (NSUInteger)getValues:(void *)values atKeys:(const void *)keys count:(NSUInteger)count found:(nullable BOOL *)found;
+
+
+#pragma mark - Removing
+
+/** Removes a key and its value. Later entries are moved back into its place, so removing leaves nothing behind to slow lookups.
+ *
+ * @param key    A pointer to the key.
+ *
+ * @return       `YES` if the key was present.
+ */
+- (BOOL)removeValueAtKey:(const void *)key;
+- (void)removeAll;
+
+
+#pragma mark - Unavailable
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
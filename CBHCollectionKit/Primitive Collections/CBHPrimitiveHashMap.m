@@ -0,0 +1,333 @@
+//  CBHPrimitiveHashMap.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHPrimitiveHashMap.h"
+
+#import "_CBHHashTable.h"
+#import "_CBHHash.h"
+
+
+#define DEFAULT_CAPACITY 8
+#define BATCH_LENGTH ((NSUInteger)256)
+
+#define _checkEntrySize(anEntrySize) if ( (anEntrySize) <= 0 ) @throw CBHEntrySizeException
+
+#define _keySize _table._keys._entrySize
+#define _valueSize _table._values._entrySize
+
+
+@interface CBHPrimitiveHashMap ()
+{
+	CBHHashTable_t _table;
+}
+
+/// Appends the key or the value of every entry, in slot order.
+- (CBHWedge *)wedgeOfValues:(BOOL)shouldTakeValues;
+
+@end
+
+
+@implementation CBHPrimitiveHashMap
+
+#pragma mark - Factories
+
++ (instancetype)hashMapWithKeySize:(size_t)keySize valueSize:(size_t)valueSize
+{
+	return [[(CBHPrimitiveHashMap *)[self alloc] initWithKeySize:keySize valueSize:valueSize] autorelease];
+}
+
++ (instancetype)hashMapWithKeySize:(size_t)keySize valueSize:(size_t)valueSize andCapacity:(NSUInteger)capacity
+{
+	return [[(CBHPrimitiveHashMap *)[self alloc] initWithKeySize:keySize valueSize:valueSize andCapacity:capacity] autorelease];
+}
+
+
+#pragma mark - Initialization
+
+- (instancetype)initWithKeySize:(size_t)keySize valueSize:(size_t)valueSize
+{
+	return [self initWithKeySize:keySize valueSize:valueSize andCapacity:DEFAULT_CAPACITY];
+}
+
+- (instancetype)initWithKeySize:(size_t)keySize valueSize:(size_t)valueSize andCapacity:(NSUInteger)capacity
+{
+	_checkEntrySize(keySize);
+	_checkEntrySize(valueSize);
+
+	if ( (self = [super init]) )
+	{
+		_table = CBHHashTable_init(capacity, keySize, valueSize);
+	}
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	CBHHashTable_dealloc(&_table);
+	[super dealloc];
+}
+
+
+#pragma mark - Properties
+
+- (NSUInteger)count
+{
+	return _table._count;
+}
+
+- (NSUInteger)capacity
+{
+	return CBHHashTable_capacity(&_table);
+}
+
+- (size_t)keySize
+{
+	return _keySize;
+}
+
+- (size_t)valueSize
+{
+	return _valueSize;
+}
+
+- (BOOL)isEmpty
+{
+	return ( _table._count <= 0 );
+}
+
+
+#pragma mark - Copying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	CBHPrimitiveHashMap *copy = [[CBHPrimitiveHashMap allocWithZone:zone] initWithKeySize:_keySize valueSize:_valueSize];
+
+	CBHHashTable_dealloc(&copy->_table);
+	copy->_table = CBHHashTable_initCopying(&_table);
+
+	return copy;
+}
+
+
+#pragma mark - Equality
+
+- (BOOL)isEqual:(id)other
+{
+	if ( [other isKindOfClass:[CBHPrimitiveHashMap class]] ) return [self isEqualToHashMap:other];
+	return [super isEqual:other];
+}
+
+- (BOOL)isEqualToHashMap:(CBHPrimitiveHashMap *)other
+{
+	/// Catch trivial cases.
+	if ( self == other ) return YES;
+	if ( _table._count != other->_table._count ) return NO;
+	if ( _keySize != other->_table._keys._entrySize || _valueSize != other->_table._values._entrySize ) return NO;
+
+	/// Equal counts, so holding every key with an equal value means the same entries.
+	for (NSUInteger slot = 0; slot < CBHHashTable_slotCount(&_table); ++slot)
+	{
+		if ( !CBHHashTable_isFull(&_table, slot) ) continue;
+
+		const NSUInteger otherSlot = CBHHashTable_find(&other->_table, CBHHashTable_keyAtSlot(&_table, slot));
+		if ( otherSlot == NSNotFound ) return NO;
+		if ( memcmp(CBHHashTable_valueAtSlot(&_table, slot), CBHHashTable_valueAtSlot(&other->_table, otherSlot), _valueSize) != 0 ) return NO;
+	}
+
+	return YES;
+}
+
+- (NSUInteger)hash
+{
+	/// Entries are unordered, so each is hashed alone and folded in with XOR. Keys are unique, so no two entries cancel out.
+	uint64_t entries = 0;
+	for (NSUInteger slot = 0; slot < CBHHashTable_slotCount(&_table); ++slot)
+	{
+		if ( !CBHHashTable_isFull(&_table, slot) ) continue;
+
+		const uint64_t keyHash = CBHHashTable_hash(CBHHashTable_keyAtSlot(&_table, slot), _keySize);
+		entries ^= CBHHash(CBHHashTable_valueAtSlot(&_table, slot), _valueSize, keyHash);
+	}
+
+	return (NSUInteger)(entries ^ (_table._count * 31) ^ (_keySize * 61) ^ (_valueSize * 41));
+}
+
+
+#pragma mark - Conversion
+
+- (CBHWedge *)wedgeOfValues:(BOOL)shouldTakeValues
+{
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:( shouldTakeValues ) ? _valueSize : _keySize andCapacity:_table._count];
+
+	for (NSUInteger slot = 0; slot < CBHHashTable_slotCount(&_table); ++slot)
+	{
+		if ( !CBHHashTable_isFull(&_table, slot) ) continue;
+		[wedge appendValue:( shouldTakeValues ) ? CBHHashTable_valueAtSlot(&_table, slot) : CBHHashTable_keyAtSlot(&_table, slot)];
+	}
+
+	return wedge;
+}
+
+- (CBHWedge *)keyWedge
+{
+	return [self wedgeOfValues:NO];
+}
+
+- (CBHWedge *)valueWedge
+{
+	return [self wedgeOfValues:YES];
+}
+
+
+#pragma mark - Resizing
+
+- (BOOL)shrink
+{
+	CBHHashTable_setCapacity(&_table, _table._count);
+	return YES;
+}
+
+- (BOOL)grow
+{
+	/// Early return if growth unnecessary.
+	if ( CBHHashTable_capacity(&_table) > _table._count ) return NO;
+
+	/// Grow.
+	CBHHashTable_setCapacity(&_table, CBHHashTable_capacity(&_table) * 2);
+	return YES;
+}
+
+- (BOOL)growToFit:(NSUInteger)neededCapacity
+{
+	/// Early return if growth unnecessary.
+	if ( neededCapacity <= CBHHashTable_capacity(&_table) ) return NO;
+
+	/// Grow.
+	CBHHashTable_setCapacity(&_table, neededCapacity);
+	return YES;
+}
+
+- (BOOL)resize:(NSUInteger)newCapacity
+{
+	/// Prevent losing entries.
+	if ( newCapacity < _table._count ) return NO;
+
+	CBHHashTable_setCapacity(&_table, newCapacity);
+	return YES;
+}
+
+
+#pragma mark - Description
+
+- (NSString *)description
+{
+	NSMutableString *description = [NSMutableString stringWithString:@"{"];
+	NSUInteger remaining = _table._count;
+
+	for (NSUInteger slot = 0; slot < CBHHashTable_slotCount(&_table); ++slot)
+	{
+		if ( !CBHHashTable_isFull(&_table, slot) ) continue;
+
+		[description appendString:@"\n\t0x"];
+		const uint8_t *key = CBHHashTable_keyAtSlot(&_table, slot);
+		for (NSUInteger j = _keySize; j > 0; --j) { [description appendFormat:@"%02x", key[j - 1]]; }
+
+		[description appendString:@" = 0x"];
+		const uint8_t *value = CBHHashTable_valueAtSlot(&_table, slot);
+		for (NSUInteger j = _valueSize; j > 0; --j) { [description appendFormat:@"%02x", value[j - 1]]; }
+
+		if ( --remaining > 0 ) { [description appendString:@","]; }
+	}
+
+	return [NSString stringWithFormat:@"%@\n}", description];
+}
+
+- (NSString *)debugDescription
+{
+	return [NSString stringWithFormat:@"<%@: %p> %@", [self class], (void *)self, [self description]];
+}
+
+
+#pragma mark - Accessors
+
+- (BOOL)containsKey:(const void *)key
+{
+	return ( CBHHashTable_find(&_table, key) != NSNotFound );
+}
+
+- (const void *)valueAtKey:(const void *)key
+{
+	const NSUInteger slot = CBHHashTable_find(&_table, key);
+	if ( slot == NSNotFound ) return NULL;
+
+	return CBHHashTable_valueAtSlot(&_table, slot);
+}
+
+- (void)setValue:(const void *)value atKey:(const void *)key
+{
+	BOOL didInsert;
+	const NSUInteger slot = CBHHashTable_insert(&_table, key, &didInsert);
+
+	memcpy(CBHHashTable_valueAtSlot(&_table, slot), value, _valueSize);
+}
+
+- (NSUInteger)getValues:(void *)values atKeys:(const void *)keys count:(NSUInteger)count found:(BOOL *)found
+{
+	const uint8_t *keyBytes = (const uint8_t *)keys;
+	uint8_t *valueBytes = (uint8_t *)values;
+
+	NSUInteger slots[BATCH_LENGTH];
+	NSUInteger foundCount = 0;
+
+	for (NSUInteger start = 0; start < count; start += BATCH_LENGTH)
+	{
+		const NSUInteger length = MIN(BATCH_LENGTH, count - start);
+		CBHHashTable_findMany(&_table, keyBytes + (start * _keySize), length, slots);
+
+		for (NSUInteger i = 0; i < length; ++i)
+		{
+			const BOOL isPresent = ( slots[i] != NSNotFound );
+			if ( found ) { found[start + i] = isPresent; }
+			if ( !isPresent ) continue;
+
+			memcpy(valueBytes + ((start + i) * _valueSize), CBHHashTable_valueAtSlot(&_table, slots[i]), _valueSize);
+			++foundCount;
+		}
+	}
+
+	return foundCount;
+}
+
+
+#pragma mark - Removing
+
+- (BOOL)removeValueAtKey:(const void *)key
+{
+	return CBHHashTable_remove(&_table, key);
+}
+
+- (void)removeAll
+{
+	CBHHashTable_removeAll(&_table);
+}
+
+@end
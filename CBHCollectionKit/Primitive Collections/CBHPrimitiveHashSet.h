@@ -0,0 +1,152 @@
+//  CBHPrimitiveHashSet.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import <CBHCollectionKit/CBHPrimitiveCollection.h>
+#import <CBHCollectionKit/CBHWedge.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** A dynamic unordered collection of distinct primitive values.
+ *
+ * A Primitive Hash Set stores its entries inline and compares them by their bytes, so integer or struct values need no boxing. Lookups compare sixteen one-byte hash fragments at a time before touching any entry.
+ *
+ * @note: Entries are compared byte for byte. Structs with padding should be cleared before being filled.
+ *
+ * @author    Christian Huxtable <chris@huxtable.ca>
+ */
+@interface CBHPrimitiveHashSet : NSObject <NSCopying, CBHPrimitiveCollection, CBHCollectionResizable>
+
+#pragma mark - Factories
+
++ (instancetype)hashSetWithEntrySize:(size_t)entrySize;
++ (instancetype)hashSetWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity;
+
++ (instancetype)hashSetWithEntrySize:(size_t)entrySize copying:(NSUInteger)count entriesFromBytes:(const void *)bytes;
+
+
+#pragma mark - Initialization
+
+- (instancetype)initWithEntrySize:(size_t)entrySize;
+
+/** Initializes an empty set.
+ *
+ * @param entrySize    The size of each entry in bytes.
+ * @param capacity     The number of entries the set can hold before growing.
+ *
+ * @return             An initialized empty set.
+ */
+- (instancetype)initWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)initWithEntrySize:(size_t)entrySize copying:(NSUInteger)count entriesFromBytes:(const void *)bytes;
+
+
+#pragma mark - Properties
+
+@property (nonatomic, readonly) NSUInteger count;
+
+/** The number of entries which fit before the set grows. */
+@property (nonatomic, readonly) NSUInteger capacity;
+@property (nonatomic, readonly) size_t entrySize;
+
+@property (nonatomic, readonly) BOOL isEmpty;
+
+
+#pragma mark - Copying
+
+- (id)copyWithZone:(nullable NSZone *)zone;
+
+
+#pragma mark - Equality
+
+- (BOOL)isEqual:(id)other;
+- (BOOL)isEqualToHashSet:(CBHPrimitiveHashSet *)other;
+
+- (NSUInteger)hash;
+
+
+#pragma mark - Conversion
+
+/** A wedge of the entries, in no particular order. */
+- (CBHWedge *)wedge;
+
+
+#pragma mark - Resizing
+
+- (BOOL)shrink;
+
+- (BOOL)grow;
+- (BOOL)growToFit:(NSUInteger)neededCapacity;
+
+- (BOOL)resize:(NSUInteger)newCapacity;
+
+
+#pragma mark - Description
+
+- (NSString *)description;
+- (NSString *)debugDescription;
+
+
+#pragma mark - Membership
+
+- (BOOL)containsValue:(const void *)value;
+
+/** Checks many values at once. Each batch of values is hashed and its slots prefetched before any is compared, so the cache misses of large sets overlap.
+ *
+ * @param values     A pointer to `count` consecutive values.
+ * @param count      The number of values.
+ * @param results    A pointer to room for `count` results, or `NULL`.
+ *
+ * @return           The number of values in the set.
+ */
+- (NSUInteger)containsValues:(const void *)values count:(NSUInteger)count results:(nullable BOOL *)results;
+
+
+#pragma mark - Adding
+
+/** Adds a value unless an equal value is already present.
+ *
+ * @param value    A pointer to the value.
+ *
+ * @return         `YES` if the value was added.
+ */
+- (BOOL)addValue:(const void *)value;
+- (void)addValues:(const void *)values count:(NSUInteger)count;
+
+
+#pragma mark - Removing
+
+/** Removes a value. Later entries are moved back into its place, so removing leaves nothing behind to slow lookups.
+ *
+ * @param value    A pointer to the value.
+ *
+ * @return         `YES` if the value was present.
+ */
+- (BOOL)removeValue:(const void *)value;
+- (void)removeAll;
+
+
+#pragma mark - Unavailable
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,313 @@
+//  CBHPrimitiveHashSet.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHPrimitiveHashSet.h"
+
+#import "_CBHHashTable.h"
+
+
+#define DEFAULT_CAPACITY 8
+#define BATCH_LENGTH ((NSUInteger)256)
+
+#define _checkEntrySize(anEntrySize) if ( (anEntrySize) <= 0 ) @throw CBHEntrySizeException
+
+
+@interface CBHPrimitiveHashSet ()
+{
+	CBHHashTable_t _table;
+}
+
+@end
+
+
+@implementation CBHPrimitiveHashSet
+
+#pragma mark - Factories
+
++ (instancetype)hashSetWithEntrySize:(size_t)entrySize
+{
+	return [[(CBHPrimitiveHashSet *)[self alloc] initWithEntrySize:entrySize] autorelease];
+}
+
++ (instancetype)hashSetWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity
+{
+	return [[(CBHPrimitiveHashSet *)[self alloc] initWithEntrySize:entrySize andCapacity:capacity] autorelease];
+}
+
++ (instancetype)hashSetWithEntrySize:(size_t)entrySize copying:(NSUInteger)count entriesFromBytes:(const void *)bytes
+{
+	return [[(CBHPrimitiveHashSet *)[self alloc] initWithEntrySize:entrySize copying:count entriesFromBytes:bytes] autorelease];
+}
+
+
+#pragma mark - Initialization
+
+- (instancetype)initWithEntrySize:(size_t)entrySize
+{
+	return [self initWithEntrySize:entrySize andCapacity:DEFAULT_CAPACITY];
+}
+
+- (instancetype)initWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity
+{
+	_checkEntrySize(entrySize);
+
+	if ( (self = [super init]) )
+	{
+		_table = CBHHashTable_init(capacity, entrySize, 0);
+	}
+
+	return self;
+}
+
+- (instancetype)initWithEntrySize:(size_t)entrySize copying:(NSUInteger)count entriesFromBytes:(const void *)bytes
+{
+	if ( (self = [self initWithEntrySize:entrySize andCapacity:count]) )
+	{
+		[self addValues:bytes count:count];
+	}
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	CBHHashTable_dealloc(&_table);
+	[super dealloc];
+}
+
+
+#pragma mark - Properties
+
+- (NSUInteger)count
+{
+	return _table._count;
+}
+
+- (NSUInteger)capacity
+{
+	return CBHHashTable_capacity(&_table);
+}
+
+- (size_t)entrySize
+{
+	return _table._keys._entrySize;
+}
+
+- (BOOL)isEmpty
+{
+	return ( _table._count <= 0 );
+}
+
+
+#pragma mark - Copying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	CBHPrimitiveHashSet *copy = [[CBHPrimitiveHashSet allocWithZone:zone] initWithEntrySize:_table._keys._entrySize];
+
+	CBHHashTable_dealloc(&copy->_table);
+	copy->_table = CBHHashTable_initCopying(&_table);
+
+	return copy;
+}
+
+
+#pragma mark - Equality
+
+- (BOOL)isEqual:(id)other
+{
+	if ( [other isKindOfClass:[CBHPrimitiveHashSet class]] ) return [self isEqualToHashSet:other];
+	return [super isEqual:other];
+}
+
+- (BOOL)isEqualToHashSet:(CBHPrimitiveHashSet *)other
+{
+	/// Catch trivial cases.
+	if ( self == other ) return YES;
+	if ( _table._count != other->_table._count ) return NO;
+	if ( _table._keys._entrySize != other->_table._keys._entrySize ) return NO;
+
+	/// Equal counts, so containing every entry means the same entries.
+	for (NSUInteger slot = 0; slot < CBHHashTable_slotCount(&_table); ++slot)
+	{
+		if ( !CBHHashTable_isFull(&_table, slot) ) continue;
+		if ( CBHHashTable_find(&other->_table, CBHHashTable_keyAtSlot(&_table, slot)) == NSNotFound ) return NO;
+	}
+
+	return YES;
+}
+
+- (NSUInteger)hash
+{
+	/// Entries are unordered, so each is hashed alone and folded in with XOR.
+	uint64_t entries = 0;
+	for (NSUInteger slot = 0; slot < CBHHashTable_slotCount(&_table); ++slot)
+	{
+		if ( CBHHashTable_isFull(&_table, slot) ) { entries ^= CBHHashTable_hash(CBHHashTable_keyAtSlot(&_table, slot), _table._keys._entrySize); }
+	}
+
+	return (NSUInteger)(entries ^ (_table._count * 31) ^ (_table._keys._entrySize * 61));
+}
+
+
+#pragma mark - Conversion
+
+- (CBHWedge *)wedge
+{
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:_table._keys._entrySize andCapacity:_table._count];
+
+	for (NSUInteger slot = 0; slot < CBHHashTable_slotCount(&_table); ++slot)
+	{
+		if ( CBHHashTable_isFull(&_table, slot) ) { [wedge appendValue:CBHHashTable_keyAtSlot(&_table, slot)]; }
+	}
+
+	return wedge;
+}
+
+
+#pragma mark - Resizing
+
+- (BOOL)shrink
+{
+	CBHHashTable_setCapacity(&_table, _table._count);
+	return YES;
+}
+
+- (BOOL)grow
+{
+	/// Early return if growth unnecessary.
+	if ( CBHHashTable_capacity(&_table) > _table._count ) return NO;
+
+	/// Grow.
+	CBHHashTable_setCapacity(&_table, CBHHashTable_capacity(&_table) * 2);
+	return YES;
+}
+
+- (BOOL)growToFit:(NSUInteger)neededCapacity
+{
+	/// Early return if growth unnecessary.
+	if ( neededCapacity <= CBHHashTable_capacity(&_table) ) return NO;
+
+	/// Grow.
+	CBHHashTable_setCapacity(&_table, neededCapacity);
+	return YES;
+}
+
+- (BOOL)resize:(NSUInteger)newCapacity
+{
+	/// Prevent losing entries.
+	if ( newCapacity < _table._count ) return NO;
+
+	CBHHashTable_setCapacity(&_table, newCapacity);
+	return YES;
+}
+
+
+#pragma mark - Description
+
+- (NSString *)description
+{
+	NSMutableString *description = [NSMutableString stringWithString:@"("];
+	NSUInteger remaining = _table._count;
+
+	for (NSUInteger slot = 0; slot < CBHHashTable_slotCount(&_table); ++slot)
+	{
+		if ( !CBHHashTable_isFull(&_table, slot) ) continue;
+
+		[description appendString:@"\n\t0x"];
+		const uint8_t *entry = CBHHashTable_keyAtSlot(&_table, slot);
+		for (NSUInteger j = _table._keys._entrySize; j > 0; --j) { [description appendFormat:@"%02x", entry[j - 1]]; }
+
+		if ( --remaining > 0 ) { [description appendString:@","]; }
+	}
+
+	return [NSString stringWithFormat:@"%@\n)", description];
+}
+
+- (NSString *)debugDescription
+{
+	return [NSString stringWithFormat:@"<%@: %p> %@", [self class], (void *)self, [self description]];
+}
+
+
+#pragma mark - Membership
+
+- (BOOL)containsValue:(const void *)value
+{
+	return ( CBHHashTable_find(&_table, value) != NSNotFound );
+}
+
+- (NSUInteger)containsValues:(const void *)values count:(NSUInteger)count results:(BOOL *)results
+{
+	const uint8_t *bytes = (const uint8_t *)values;
+	NSUInteger slots[BATCH_LENGTH];
+	NSUInteger found = 0;
+
+	for (NSUInteger start = 0; start < count; start += BATCH_LENGTH)
+	{
+		const NSUInteger length = MIN(BATCH_LENGTH, count - start);
+		CBHHashTable_findMany(&_table, bytes + (start * _table._keys._entrySize), length, slots);
+
+		for (NSUInteger i = 0; i < length; ++i)
+		{
+			const BOOL isPresent = ( slots[i] != NSNotFound );
+			if ( results ) { results[start + i] = isPresent; }
+			found += ( isPresent ) ? 1 : 0;
+		}
+	}
+
+	return found;
+}
+
+
+#pragma mark - Adding
+
+- (BOOL)addValue:(const void *)value
+{
+	BOOL didInsert;
+	CBHHashTable_insert(&_table, value, &didInsert);
+
+	return didInsert;
+}
+
+- (void)addValues:(const void *)values count:(NSUInteger)count
+{
+	const uint8_t *bytes = (const uint8_t *)values;
+	BOOL didInsert;
+
+	[self growToFit:_table._count + count];
+	for (NSUInteger i = 0; i < count; ++i) { CBHHashTable_insert(&_table, bytes + (i * _table._keys._entrySize), &didInsert); }
+}
+
+
+#pragma mark - Removing
+
+- (BOOL)removeValue:(const void *)value
+{
+	return CBHHashTable_remove(&_table, value);
+}
+
+- (void)removeAll
+{
+	CBHHashTable_removeAll(&_table);
+}
+
+@end
@@ -17,19 +17,47 @@
 //  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 @import Foundation;
+@import Dispatch;
 
 #import <CBHCollectionKit/CBHPrimitiveCollection.h>
+#import <CBHCollectionKit/CBHAllocation.h>
+#import <CBHCollectionKit/CBHCollectionFormat.h>
+#import <CBHCollectionKit/CBHCollectionCoder.h>
+#import <CBHCollectionKit/CBHSliceView.h>
 
 
 NS_ASSUME_NONNULL_BEGIN
 
+#pragma mark - File Options
+
+/** How a file backing a slice is laid out and how its pages are expected to be accessed.
+ *
+ * `CBHSliceFileAdviseSequential` and `CBHSliceFileAdviseRandom` are mutually exclusive.
+ */
+typedef NS_OPTIONS(NSUInteger, CBHSliceFileOptions) {
+	CBHSliceFileOptionsNone = 0,
+
+	/** The entries are preceded by a `CBHCollectionHeader`, which is validated when the file is opened. */
+	CBHSliceFileHeader = 1 << 0,
+
+	/** Entries will be read in order, so pages can be read ahead aggressively and dropped once read. */
+	CBHSliceFileAdviseSequential = 1 << 1,
+
+	/** Entries will be read in no particular order, so read-ahead is wasted. */
+	CBHSliceFileAdviseRandom = 1 << 2,
+
+	/** All entries will be needed soon, so pages should start loading in the background. */
+	CBHSliceFileAdviseWillNeed = 1 << 3,
+};
+
+
 /** A static ordered collection of primitive values.
  *
  * A Slice can be thought of an abstraction over a c array. Slice adds ease-of-use features while also enhancing safety.
  *
  * @author    Christian Huxtable <chris@huxtable.ca>
  */
-@interface CBHSlice : NSObject <NSCopying, CBHPrimitiveCollection>
+@interface CBHSlice : NSObject <NSCopying, NSSecureCoding, CBHPrimitiveCollection>
 
 #pragma mark - Factories
 /**
@@ -55,6 +83,16 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (instancetype)sliceWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity shouldClear:(BOOL)shouldClear;
 
+/** Creates and returns a new cleared slice that can contain a `capacity` number of entries of size `entrySize`, allocated as described by `options`.
+ *
+ * @param entrySize    The size of each entry in the slice.
+ * @param capacity     The number of entries in the slice.
+ * @param options      The alignment and paging of the slice's buffer.
+ *
+ * @return             A new slice.
+ */
++ (instancetype)sliceWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options;
+
 /** Creates and returns a new slice that can contain a `capacity` number of entries of size `entrySize`.
  *
  * @param entrySize    The size of each entry in the slice.
@@ -88,6 +126,34 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (instancetype)sliceWithEntrySize:(size_t)entrySize owning:(NSUInteger)count entriesFromBytes:(void *)bytes;
 
+/** Creates and returns a new slice that shares the bytes of `data` without copying them.
+ *
+ * @param entrySize    The size of each entry in the slice.
+ * @param data         The data to adopt. Its length must be a multiple of `entrySize`.
+ *
+ * @return             A new slice with the contents of `data`.
+ */
++ (instancetype)sliceWithEntrySize:(size_t)entrySize adoptingData:(NSData *)data;
+
+/** Creates and returns a new slice that shares the bytes of `data` without copying them.
+ *
+ * @param entrySize    The size of each entry in the slice.
+ * @param data         The dispatch data to adopt. Its size must be a multiple of `entrySize`.
+ *
+ * @return             A new slice with the contents of `data`.
+ */
++ (instancetype)sliceWithEntrySize:(size_t)entrySize adoptingDispatchData:(dispatch_data_t)data;
+
+/** Creates and returns a new slice backed by the contents of a file mapped into memory.
+ *
+ * @param path         The path of the file to map.
+ * @param entrySize    The size of each entry in the slice.
+ * @param options      The layout of the file and how its pages will be accessed.
+ *
+ * @return             A new slice with the contents of the file, or `nil` if it could not be mapped.
+ */
++ (nullable instancetype)sliceWithContentsOfFile:(NSString *)path entrySize:(size_t)entrySize options:(CBHSliceFileOptions)options;
+
 
 #pragma mark - Initialization
 /**
@@ -113,7 +179,30 @@ NS_ASSUME_NONNULL_BEGIN
  *
  * @return             A newly initialized slice.
  */
-- (instancetype)initWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity shouldClear:(BOOL)shouldClear NS_DESIGNATED_INITIALIZER;
+- (instancetype)initWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity shouldClear:(BOOL)shouldClear;
+
+/** Initializes a newly allocated cleared slice that can contain a `capacity` number of entries of size `entrySize`, allocated as described by `options`.
+ *
+ * @param entrySize    The size of each entry in the slice.
+ * @param capacity     The number of entries in the slice.
+ * @param options      The alignment and paging of the slice's buffer.
+ *
+ * @return             A newly initialized slice.
+ */
+- (instancetype)initWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options;
+
+/** Initializes a newly allocated slice that can contain a `capacity` number of entries of size `entrySize`, allocated as described by `options`.
+ *
+ * The options are kept for the life of the slice, so a mutable slice reallocates its buffer the same way when resized.
+ *
+ * @param entrySize    The size of each entry in the slice.
+ * @param capacity     The number of entries in the slice.
+ * @param shouldClear  Whether the slice should be explicitly cleared.
+ * @param options      The alignment and paging of the slice's buffer.
+ *
+ * @return             A newly initialized slice.
+ */
+- (instancetype)initWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity shouldClear:(BOOL)shouldClear options:(CBHAllocationOptions)options NS_DESIGNATED_INITIALIZER;
 
 /** Initializes a newly allocated slice that can contain a `capacity` number of entries of size `entrySize`. Each entry has been set to the value at `value`.
  *
@@ -148,6 +237,63 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (instancetype)initWithEntrySize:(size_t)entrySize owning:(NSUInteger)count entriesFromBytes:(void *)bytes NS_DESIGNATED_INITIALIZER;
 
+/** Initializes a newly allocated slice that shares the bytes of `data` without copying them.
+ *
+ * @param entrySize    The size of each entry in the slice.
+ * @param data         The data to adopt. Its length must be a multiple of `entrySize`.
+ *
+ * @return             A newly initialized slice with the contents of `data`.
+ *
+ * @note: The slice retains an immutable copy of `data`, which is free for immutable data. A `CBHMutableSlice` instead retains an `NSMutableData` and writes through to its bytes, so the caller must not change the data's length while the slice is alive. Resizing the data can move its bytes and leave the slice pointing at freed memory.
+ */
+- (instancetype)initWithEntrySize:(size_t)entrySize adoptingData:(NSData *)data;
+
+/** Initializes a newly allocated slice that shares the bytes of `data` without copying them.
+ *
+ * @param entrySize    The size of each entry in the slice.
+ * @param data         The dispatch data to adopt. Its size must be a multiple of `entrySize`.
+ *
+ * @return             A newly initialized slice with the contents of `data`.
+ *
+ * @note: Discontiguous dispatch data is made contiguous first, which copies it. A `CBHMutableSlice` always copies.
+ */
+- (instancetype)initWithEntrySize:(size_t)entrySize adoptingDispatchData:(dispatch_data_t)data;
+
+/** Initializes a newly allocated slice backed by the contents of a file mapped into memory.
+ *
+ * @param path         The path of the file to map.
+ * @param entrySize    The size of each entry in the slice.
+ * @param options      The layout of the file and how its pages will be accessed.
+ *
+ * @return             A newly initialized slice with the contents of the file, or `nil` if it could not be mapped.
+ */
+- (nullable instancetype)initWithContentsOfFile:(NSString *)path entrySize:(size_t)entrySize options:(CBHSliceFileOptions)options;
+
+/** Initializes a newly allocated slice backed by the contents of a file mapped into memory.
+ *
+ * Nothing is read up front, pages are loaded as entries are first accessed. The header's checksum is not verified as that would read the whole file.
+ *
+ * @param path         The path of the file to map.
+ * @param entrySize    The size of each entry in the slice.
+ * @param options      The layout of the file and how its pages will be accessed.
+ * @param error        On return, the reason the file could not be mapped. May be `NULL`.
+ *
+ * @return             A newly initialized slice with the contents of the file, or `nil` if it could not be mapped.
+ *
+ * @note: The file is mapped read-only. It must not be truncated while the slice is alive. A `CBHMutableSlice` maps the file shared and writes through to it.
+ */
+- (nullable instancetype)initWithContentsOfFile:(NSString *)path entrySize:(size_t)entrySize options:(CBHSliceFileOptions)options error:(NSError * _Nullable * _Nullable)error;
+
+/** Initializes a newly allocated slice with the next collection read by `decoder`.
+ *
+ * @param decoder    The decoder to read from.
+ *
+ * @return           A newly initialized slice, or `nil` if the collection could not be read. The reason is left in the decoder's `error`.
+ */
+- (nullable instancetype)initWithCollectionDecoder:(CBHCollectionDecoder *)decoder;
+
+- (nullable instancetype)initWithCoder:(NSCoder *)coder;
+
 
 #pragma mark - Properties
 
@@ -173,6 +319,10 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, readonly) const void *bytes;
 
+/** How the slice's buffer is allocated. Slices backed by data, files, or borrowed bytes report the default options.
+ */
+@property (nonatomic, readonly) CBHAllocationOptions allocationOptions;
+
 
 #pragma mark - Copying
 
@@ -183,6 +333,21 @@ NS_ASSUME_NONNULL_BEGIN
 - (id)copyWithZone:(nullable NSZone *)zone;
 
 
+#pragma mark - Serialization
+
+/** Writes the receiver to `encoder` in the binary collection format.
+ *
+ * @param encoder    The encoder to write to.
+ *
+ * @return           `YES` if the receiver was written, otherwise `NO`. The reason is left in the encoder's `error`.
+ */
+- (BOOL)encodeWithCollectionEncoder:(CBHCollectionEncoder *)encoder;
+
+/** Encodes the receiver in the binary collection format.
+ */
+- (void)encodeWithCoder:(NSCoder *)coder;
+
+
 #pragma mark - Equality
 
 /** Returns a Boolean value that indicates whether the receiver and a given object are equal.
@@ -218,6 +383,26 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (NSMutableData *)mutableData;
 
+/** The receiver represented as `NSData` which shares the receiver's bytes.
+ *
+ * The data keeps the bytes alive until it is deallocated.
+ *
+ * @note: A `CBHMutableSlice` copies its bytes before its next write, so the data does not change. Bytes adopted from an `NSMutableData` are the exception and are written through.
+ */
+- (NSData *)dataNoCopy;
+
+/** Writes the receiver's entries to a file which can be mapped with `initWithContentsOfFile:entrySize:options:`.
+ *
+ * The file is written beside `path` and moved into place, so slices already mapping `path` keep their contents.
+ *
+ * @param path       The path of the file to write.
+ * @param options    `CBHSliceFileHeader` to precede the entries with a header. Advice is ignored.
+ * @param error      On return, the reason the file could not be written. May be `NULL`.
+ *
+ * @return           `YES` if the file was written, otherwise `NO`.
+ */
+- (BOOL)writeToFile:(NSString *)path options:(CBHSliceFileOptions)options error:(NSError * _Nullable * _Nullable)error;
+
 /** The receiver represented as a `NSString`.
  *
  * @param encoding    The encoding to use.
@@ -231,6 +416,17 @@ NS_ASSUME_NONNULL_BEGIN
 - (NSString *)debugDescription;
 
 
+#pragma mark - Unsafe Access
+
+/** Calls a block with a view of the receiver's entries.
+ *
+ * The view allows reading entries without a message send or bounds check per entry. It must not be used after the block returns.
+ *
+ * @param block    The block to call with the view.
+ */
+- (void)withUnsafeBytes:(void (NS_NOESCAPE ^)(CBHSliceView view))block;
+
+
 #pragma mark - Generic Accessors
 
 - (const void *)valueAtIndex:(NSUInteger)index;
@@ -299,4 +495,60 @@ NS_ASSUME_NONNULL_BEGIN
 
 @end
 
+
+#pragma mark - Parallel Operations
+
+@interface CBHSlice (ParallelOperations)
+
+/** Folds every entry of the receiver into a single entry.
+ *
+ * Large slices are split into cache sized chunks which are reduced concurrently across all available cores.
+ *
+ * @param function    The associative function used to fold runs of entries.
+ * @param identity    A pointer to an entry which leaves any entry unchanged when folded with it.
+ * @param context     A pointer passed through to the function.
+ * @param result      A pointer to an entry sized buffer which receives the result.
+ */
+- (void)reduceUsingFunction:(CBHPrimitiveReducer)function identity:(const void *)identity context:(nullable void *)context result:(void *)result;
+
+/** Calls a block with each cache sized chunk of the receiver's entries.
+ *
+ * Large slices are visited concurrently, so the block may be called from several threads at once and in any order. Small slices are passed to the block as a single chunk.
+ *
+ * @param block    The block to call with a pointer to the first entry of a chunk and the chunk's range of indices.
+ */
+- (void)forEachChunk:(void (NS_NOESCAPE ^)(const void *entries, NSRange range))block;
+
+@end
+
+
+#pragma mark - Enumeration
+
+@interface CBHSlice (Enumeration)
+
+/** Calls a block with a pointer to each entry of the receiver, in order.
+ *
+ * @param block    The block to call with a pointer to an entry, the entry's index, and a flag which stops the enumeration when set to `YES`.
+ */
+- (void)enumerateValuesUsingBlock:(void (NS_NOESCAPE ^)(const void *value, NSUInteger index, BOOL *stop))block;
+
+/** Calls a block with a pointer to each entry of the receiver, as described by `options`.
+ *
+ * With `NSEnumerationConcurrent` the entries are split into chunks which are enumerated concurrently, so the block may be called from several threads at once and in any order. With `NSEnumerationReverse` the entries, or the entries within each chunk, are visited from the last.
+ *
+ * @param options    The options for the enumeration.
+ * @param block      The block to call with a pointer to an entry, the entry's index, and a flag which stops the enumeration when set to `YES`.
+ */
+- (void)enumerateValuesWithOptions:(NSEnumerationOptions)options usingBlock:(void (NS_NOESCAPE ^)(const void *value, NSUInteger index, BOOL *stop))block;
+
+/** Calls a block with a pointer to each entry of the receiver within a range, as described by `options`.
+ *
+ * @param range      The range of entries to enumerate. Raises an `NSRangeException` if it extends past the capacity.
+ * @param options    The options for the enumeration, as for `enumerateValuesWithOptions:usingBlock:`.
+ * @param block      The block to call with a pointer to an entry, the entry's index, and a flag which stops the enumeration when set to `YES`.
+ */
+- (void)enumerateValuesInRange:(NSRange)range options:(NSEnumerationOptions)options usingBlock:(void (NS_NOESCAPE ^)(const void *value, NSUInteger index, BOOL *stop))block;
+
+@end
+
 NS_ASSUME_NONNULL_END
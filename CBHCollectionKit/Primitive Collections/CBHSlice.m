@@ -18,22 +18,41 @@
 
 #import "CBHSlice.h"
 #import "_CBHSlice.h"
+#import "_CBHHash.h"
+#import "_CBHParallel.h"
+#import "_CBHMappedFile.h"
 
 #import "CBHWedge.h"
 
 @import CBHMemoryKit;
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
 
 #define checkEntrySize(aType) if (_slice._entrySize != sizeof(aType)) @throw CBHEntrySizeException
+/// Only used by initializers, so the receiver is released before throwing.
+#define _checkLength(aLength, anEntrySize) if ( (anEntrySize) <= 0 || (aLength) % (anEntrySize) != 0 ) { [self release]; @throw CBHEntrySizeException; }
 #define typeAtIndex(aType, anIndex) *((aType *)CBHSlice_pointerToOffset(&_slice, (anIndex)))
 
+#define CODER_KEY @"CBHCollection"
+
 
 @interface CBHSlice ()
 {
 	@protected
 	CBHSlice_t _slice;
+
+	@private
+	/// Computed on first use, mutable slices hash afresh instead.
+	NSUInteger _hash;
+	BOOL _isHashed;
 }
 
+- (instancetype)initWithEntrySize:(size_t)entrySize borrowing:(NSUInteger)count entriesFromBytes:(void *)bytes owner:(id)owner NS_DESIGNATED_INITIALIZER;
+- (instancetype)initWithContentsOfFile:(NSString *)path entrySize:(size_t)entrySize options:(CBHSliceFileOptions)options writable:(BOOL)writable error:(NSError **)error;
+
 @end
 
 
@@ -51,6 +70,11 @@
 	return [[(CBHSlice *)[self alloc] initWithEntrySize:entrySize andCapacity:capacity shouldClear:shouldClear] autorelease];
 }
 
++ (instancetype)sliceWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options
+{
+	return [[(CBHSlice *)[self alloc] initWithEntrySize:entrySize andCapacity:capacity options:options] autorelease];
+}
+
 + (instancetype)sliceWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity initialValue:(const void *)value
 {
 	return [[(CBHSlice *)[self alloc] initWithEntrySize:entrySize andCapacity:capacity initialValue:value] autorelease];
@@ -67,6 +91,21 @@
 	return [[(CBHSlice *)[self alloc] initWithEntrySize:entrySize owning:count entriesFromBytes:bytes] autorelease];
 }
 
++ (instancetype)sliceWithEntrySize:(size_t)entrySize adoptingData:(NSData *)data
+{
+	return [[(CBHSlice *)[self alloc] initWithEntrySize:entrySize adoptingData:data] autorelease];
+}
+
++ (instancetype)sliceWithEntrySize:(size_t)entrySize adoptingDispatchData:(dispatch_data_t)data
+{
+	return [[(CBHSlice *)[self alloc] initWithEntrySize:entrySize adoptingDispatchData:data] autorelease];
+}
+
++ (instancetype)sliceWithContentsOfFile:(NSString *)path entrySize:(size_t)entrySize options:(CBHSliceFileOptions)options
+{
+	return [[(CBHSlice *)[self alloc] initWithContentsOfFile:path entrySize:entrySize options:options] autorelease];
+}
+
 
 #pragma mark - Initializers
 
@@ -76,10 +115,20 @@
 }
 
 - (instancetype)initWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity shouldClear:(BOOL)shouldClear
+{
+	return [self initWithEntrySize:entrySize andCapacity:capacity shouldClear:shouldClear options:CBHAllocationOptionsDefault];
+}
+
+- (instancetype)initWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options
+{
+	return [self initWithEntrySize:entrySize andCapacity:capacity shouldClear:YES options:options];
+}
+
+- (instancetype)initWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity shouldClear:(BOOL)shouldClear options:(CBHAllocationOptions)options
 {
 	if ( (self = [super init]) )
 	{
-		_slice = CBHSlice_init(capacity, entrySize, shouldClear);
+		_slice = CBHSlice_initWithOptions(capacity, entrySize, shouldClear, &options);
 	}
 
 	return self;
@@ -117,6 +166,171 @@
 	return self;
 }
 
+- (instancetype)initWithEntrySize:(size_t)entrySize borrowing:(NSUInteger)count entriesFromBytes:(void *)bytes owner:(id)owner
+{
+	if ( (self = [super init]) )
+	{
+		_slice = CBHSlice_initBorrowingBytes(bytes, entrySize, count, owner);
+	}
+
+	return self;
+}
+
+
+- (instancetype)initWithEntrySize:(size_t)entrySize adoptingData:(NSData *)data
+{
+	_checkLength([data length], entrySize);
+
+	/// Free for immutable data, protects against later mutation otherwise.
+	NSData *owner = [data copy];
+	self = [self initWithEntrySize:entrySize borrowing:[owner length] / entrySize entriesFromBytes:(void *)[owner bytes] owner:owner];
+	[owner release];
+
+	return self;
+}
+
+- (instancetype)initWithEntrySize:(size_t)entrySize adoptingDispatchData:(dispatch_data_t)data
+{
+	const void *bytes = NULL;
+	size_t length = 0;
+
+	dispatch_data_t map = dispatch_data_create_map(data, &bytes, &length);
+
+	@try
+	{
+		_checkLength(length, entrySize);
+		self = [self initWithEntrySize:entrySize borrowing:length / entrySize entriesFromBytes:(void *)bytes owner:(id)map];
+	}
+	@finally
+	{
+		dispatch_release(map);
+	}
+
+	return self;
+}
+
+
+- (instancetype)initWithContentsOfFile:(NSString *)path entrySize:(size_t)entrySize options:(CBHSliceFileOptions)options
+{
+	return [self initWithContentsOfFile:path entrySize:entrySize options:options error:NULL];
+}
+
+- (instancetype)initWithContentsOfFile:(NSString *)path entrySize:(size_t)entrySize options:(CBHSliceFileOptions)options error:(NSError **)error
+{
+	return [self initWithContentsOfFile:path entrySize:entrySize options:options writable:NO error:error];
+}
+
+- (instancetype)initWithContentsOfFile:(NSString *)path entrySize:(size_t)entrySize options:(CBHSliceFileOptions)options writable:(BOOL)writable error:(NSError **)error
+{
+	if ( entrySize <= 0 )
+	{
+		[self release];
+		@throw CBHEntrySizeException;
+	}
+
+	if ( (options & CBHSliceFileAdviseSequential) && (options & CBHSliceFileAdviseRandom) )
+	{
+		[self release];
+		@throw NSInvalidArgumentException;
+	}
+
+	_CBHMappedFile *file = [[_CBHMappedFile alloc] initWithPath:path writable:writable error:error];
+	if ( !file )
+	{
+		[self release];
+		return nil;
+	}
+
+	uint8_t *bytes = CBHMappedFile_bytes(file);
+	size_t length = CBHMappedFile_length(file);
+	NSUInteger count = 0;
+
+	if ( options & CBHSliceFileHeader )
+	{
+		/// A file too short for a header fails on its magic.
+		CBHCollectionHeader header;
+		memset(&header, 0, sizeof(header));
+		if ( length >= sizeof(header) ) memcpy(&header, bytes, sizeof(header));
+
+		if ( !CBHCollectionHeaderValidate(&header, entrySize, length - MIN(length, sizeof(header)), error) )
+		{
+			[file release];
+			[self release];
+			return nil;
+		}
+
+		count = (NSUInteger)header.count;
+		bytes += sizeof(header);
+	}
+	else
+	{
+		if ( length % entrySize != 0 )
+		{
+			if ( error ) *error = [NSError errorWithDomain:CBHCollectionFormatErrorDomain code:CBHCollectionFormatErrorEntrySize userInfo:@{NSFilePathErrorKey: path}];
+			[file release];
+			[self release];
+			return nil;
+		}
+
+		count = length / entrySize;
+	}
+
+	const size_t payload = count * entrySize;
+	if ( options & CBHSliceFileAdviseSequential ) CBHMappedFile_advise(file, bytes, payload, MADV_SEQUENTIAL);
+	if ( options & CBHSliceFileAdviseRandom ) CBHMappedFile_advise(file, bytes, payload, MADV_RANDOM);
+	if ( options & CBHSliceFileAdviseWillNeed ) CBHMappedFile_advise(file, bytes, payload, MADV_WILLNEED);
+
+	self = [self initWithEntrySize:entrySize borrowing:count entriesFromBytes:bytes owner:file];
+	[file release];
+
+	return self;
+}
+
+- (instancetype)initWithCollectionDecoder:(CBHCollectionDecoder *)decoder
+{
+	NSUInteger count = 0;
+	size_t entrySize = 0;
+
+	if ( ![decoder decodeEntryCount:&count entrySize:&entrySize] )
+	{
+		[self release];
+		return nil;
+	}
+
+	/// Entries are read straight into the slice, which grows as they arrive.
+	if ( (self = [self initWithEntrySize:entrySize andCapacity:0 shouldClear:NO]) )
+	{
+		const BOOL didDecode = [decoder decodeEntriesReserving:^void *(NSUInteger capacity) {
+			CBHSlice_setCapacity(&self->_slice, capacity, NO);
+			return self->_slice._data;
+		}];
+
+		if ( !didDecode )
+		{
+			[self release];
+			return nil;
+		}
+	}
+
+	return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)coder
+{
+	NSUInteger length = 0;
+	const uint8_t *bytes = [coder decodeBytesForKey:CODER_KEY returnedLength:&length];
+
+	NSData *data = [[NSData alloc] initWithBytesNoCopy:(void *)bytes length:length freeWhenDone:NO];
+	CBHCollectionDecoder *decoder = [[CBHCollectionDecoder alloc] initWithData:data];
+
+	self = [self initWithCollectionDecoder:decoder];
+
+	[decoder release];
+	[data release];
+
+	return self;
+}
+
 
 #pragma mark - Destructor
 
@@ -155,6 +369,11 @@
 	return _slice._data;
 }
 
+- (CBHAllocationOptions)allocationOptions
+{
+	return _slice._options;
+}
+
 
 #pragma mark - Copying
 
@@ -165,6 +384,30 @@
 }
 
 
+#pragma mark - Serialization
+
++ (BOOL)supportsSecureCoding
+{
+	return YES;
+}
+
+- (BOOL)encodeWithCollectionEncoder:(CBHCollectionEncoder *)encoder
+{
+	return [encoder encodeEntries:_slice._data entrySize:_slice._entrySize count:_slice._capacity];
+}
+
+- (void)encodeWithCoder:(NSCoder *)coder
+{
+	NSMutableData *data = [NSMutableData dataWithCapacity:sizeof(CBHCollectionHeader) + (_slice._capacity * _slice._entrySize)];
+
+	CBHCollectionEncoder *encoder = [[CBHCollectionEncoder alloc] initWithMutableData:data];
+	[self encodeWithCollectionEncoder:encoder];
+	[encoder release];
+
+	[coder encodeBytes:[data bytes] length:[data length] forKey:CODER_KEY];
+}
+
+
 #pragma mark - Equality
 
 - (BOOL)isEqual:(id)other
@@ -186,30 +429,14 @@
 
 - (NSUInteger)hash
 {
-	/// Mix in properties.
-	NSUInteger hash = ((_slice._capacity * 3) ^ (_slice._entrySize * 7) * 31);
-	const NSUInteger byteCount = _slice._capacity * _slice._entrySize;
-
-	/// XOR in middle 32/64 bits
-	if ( byteCount >= (sizeof(NSUInteger) + sizeof(NSUInteger) + sizeof(NSUInteger)) )
-	{
-		size_t middle = (size_t)((byteCount % sizeof(NSUInteger)) / 2.0) * sizeof(NSUInteger);
-		hash ^= (*(NSUInteger *)((size_t)_slice._data + middle)) * 71;
-	}
-
-	/// XOR in last 32/64 bits
-	if ( byteCount >= (sizeof(NSUInteger) + sizeof(NSUInteger)) )
-	{
-		hash ^= (*(NSUInteger *)((size_t)_slice._data + (byteCount - sizeof(NSUInteger)))) * 61;
-	}
-
-	/// XOR in first 32/64 bits
-	if ( byteCount >= sizeof(NSUInteger) )
+	/// The bytes never change, so hash them once.
+	if ( !_isHashed )
 	{
-		hash ^= (*(NSUInteger *)_slice._data) * 41;
+		_hash = (NSUInteger)CBHHash(_slice._data, _slice._capacity * _slice._entrySize, _slice._entrySize);
+		_isHashed = YES;
 	}
 
-	return hash;
+	return _hash;
 }
 
 
@@ -243,17 +470,74 @@
 
 - (NSData *)data
 {
-	return [NSData dataWithBytes:_slice._data length:_slice._capacity];
+	return [NSData dataWithBytes:_slice._data length:_slice._capacity * _slice._entrySize];
 }
 
 - (NSMutableData *)mutableData
 {
-	return [NSMutableData dataWithBytes:_slice._data length:_slice._capacity];
+	return [NSMutableData dataWithBytes:_slice._data length:_slice._capacity * _slice._entrySize];
+}
+
+- (NSData *)dataNoCopy
+{
+	/// Keep the bytes alive rather than the receiver, which copies away from shared bytes before writing.
+	id owner = CBHSlice_shareStorage(&_slice) ?: _slice._owner;
+	[owner retain];
+
+	return [[[NSData alloc] initWithBytesNoCopy:_slice._data length:_slice._capacity * _slice._entrySize deallocator:^(void *bytes, NSUInteger length) {
+		[owner release];
+	}] autorelease];
+}
+
+- (BOOL)writeToFile:(NSString *)path options:(CBHSliceFileOptions)options error:(NSError **)error
+{
+	/// Written beside the destination so the rename can't cross file systems.
+	char temporary[PATH_MAX];
+	if ( snprintf(temporary, sizeof(temporary), "%s.XXXXXX", [path fileSystemRepresentation]) >= (int)sizeof(temporary) )
+	{
+		if ( error ) *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:ENAMETOOLONG userInfo:@{NSFilePathErrorKey: path}];
+		return NO;
+	}
+
+	int fd = mkstemp(temporary);
+	if ( fd < 0 )
+	{
+		if ( error ) *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:@{NSFilePathErrorKey: path}];
+		return NO;
+	}
+
+	CBHCollectionEncoder *encoder = [[CBHCollectionEncoder alloc] initWithFileDescriptor:fd];
+	BOOL success = ( options & CBHSliceFileHeader ) ? [self encodeWithCollectionEncoder:encoder] : [encoder writeBytes:_slice._data length:_slice._capacity * _slice._entrySize];
+	if ( success ) success = [encoder flush];
+
+	NSError *failure = [[[encoder error] retain] autorelease];
+	[encoder release];
+
+	if ( success ) success = ( fchmod(fd, 0644) == 0 );
+	if ( close(fd) != 0 ) success = NO;
+	if ( success ) success = ( rename(temporary, [path fileSystemRepresentation]) == 0 );
+
+	if ( !success )
+	{
+		if ( error ) *error = failure ?: [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:@{NSFilePathErrorKey: path}];
+		unlink(temporary);
+	}
+
+	return success;
 }
 
 - (NSString *)stringWithEncoding:(NSStringEncoding)encoding
 {
-	return [[[NSString alloc] initWithBytes:_slice._data length:_slice._capacity encoding:encoding] autorelease];
+	return [[[NSString alloc] initWithBytes:_slice._data length:_slice._capacity * _slice._entrySize encoding:encoding] autorelease];
+}
+
+
+#pragma mark - Unsafe Access
+
+- (void)withUnsafeBytes:(void (NS_NOESCAPE ^)(CBHSliceView view))block
+{
+	CBHSliceView view = {_slice._data, _slice._capacity, _slice._entrySize, &_slice._generation, _slice._generation};
+	block(view);
 }
 
 
@@ -412,3 +696,46 @@
 }
 
 @end
+
+
+#pragma mark - Parallel Operations
+
+@implementation CBHSlice (ParallelOperations)
+
+- (void)reduceUsingFunction:(CBHPrimitiveReducer)function identity:(const void *)identity context:(void *)context result:(void *)result
+{
+	CBHParallel_reduce(_slice._data, _slice._capacity, _slice._entrySize, function, context, identity, result);
+}
+
+- (void)forEachChunk:(void (NS_NOESCAPE ^)(const void *entries, NSRange range))block
+{
+	CBHParallel_forEachChunk(_slice._data, _slice._capacity, _slice._entrySize, block);
+}
+
+@end
+
+
+#pragma mark - Enumeration
+
+@implementation CBHSlice (Enumeration)
+
+- (void)enumerateValuesUsingBlock:(void (NS_NOESCAPE ^)(const void *value, NSUInteger index, BOOL *stop))block
+{
+	CBHParallel_enumerate(_slice._data, _slice._capacity, _slice._entrySize, 0, 0, block);
+}
+
+- (void)enumerateValuesWithOptions:(NSEnumerationOptions)options usingBlock:(void (NS_NOESCAPE ^)(const void *value, NSUInteger index, BOOL *stop))block
+{
+	CBHParallel_enumerate(_slice._data, _slice._capacity, _slice._entrySize, 0, options, block);
+}
+
+- (void)enumerateValuesInRange:(NSRange)range options:(NSEnumerationOptions)options usingBlock:(void (NS_NOESCAPE ^)(const void *value, NSUInteger index, BOOL *stop))block
+{
+	const NSUInteger count = _slice._capacity;
+	if ( range.location > count || range.length > count - range.location ) @throw NSRangeException;
+
+	const void *data = (const uint8_t *)_slice._data + (range.location * _slice._entrySize);
+	CBHParallel_enumerate(data, range.length, _slice._entrySize, range.location, options, block);
+}
+
+@end
@@ -0,0 +1,151 @@
+//  CBHSliceView.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import <CBHCollectionKit/CBHPrimitiveCollection.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Slice Views
+
+/** A borrowed, read-only view of the entries of a primitive collection.
+ *
+ * Views are handed out by `-withUnsafeBytes:` and are only valid for the duration of that block. The collection is validated once when the view is created so the accessors below need no further checks. In `DEBUG` builds the accessors detect use of a view after its collection has been resized.
+ */
+typedef struct CBHSliceView {
+	/// A pointer to the first entry.
+	const void *bytes;
+
+	/// The number of entries in the view.
+	NSUInteger count;
+
+	/// The size of each entry in bytes.
+	size_t entrySize;
+
+	/// Private. Used to detect the storage moving out from under the view.
+	const NSUInteger * _Nullable _generation;
+	NSUInteger _expectedGeneration;
+} CBHSliceView;
+
+/** A borrowed, writable view of the entries of a primitive collection.
+ *
+ * Views are handed out by `-withUnsafeMutableBytes:` and are only valid for the duration of that block.
+ */
+typedef struct CBHMutableSliceView {
+	/// A pointer to the first entry.
+	void *bytes;
+
+	/// The number of entries in the view.
+	NSUInteger count;
+
+	/// The size of each entry in bytes.
+	size_t entrySize;
+
+	/// Private. Used to detect the storage moving out from under the view.
+	const NSUInteger * _Nullable _generation;
+	NSUInteger _expectedGeneration;
+} CBHMutableSliceView;
+
+
+#pragma mark - Exceptions
+
+extern const NSExceptionName CBHStaleViewException;
+
+
+#pragma mark - Validation
+
+/** Whether the collection the view was taken from has not been resized since.
+ */
+static inline BOOL CBHSliceView_isValid(CBHSliceView view)
+{
+	return ( !view._generation || *view._generation == view._expectedGeneration );
+}
+
+static inline BOOL CBHMutableSliceView_isValid(CBHMutableSliceView view)
+{
+	return ( !view._generation || *view._generation == view._expectedGeneration );
+}
+
+#if DEBUG
+	#define _CBHSliceView_checkValid(aView, aValidator) if ( !aValidator(aView) ) @throw CBHStaleViewException
+	#define _CBHSliceView_checkIndex(aView, anIndex) if ( (anIndex) >= (aView).count ) @throw NSRangeException
+#else
+	#define _CBHSliceView_checkValid(aView, aValidator)
+	#define _CBHSliceView_checkIndex(aView, anIndex)
+#endif
+
+
+#pragma mark - Typed Access
+
+/** Returns the entries of a view as a typed pointer, checking the entry size once.
+ *
+ * Loops over the returned pointer compile to plain loads:
+ *
+ *     const uint64_t *values = CBHSliceView_entries(view, uint64_t);
+ *     for (NSUInteger i = 0; i < view.count; ++i) { sum += values[i]; }
+ *
+ * @param aView    A `CBHSliceView`.
+ * @param aType    The type of each entry. Must be `entrySize` bytes wide.
+ */
+#define CBHSliceView_entries(aView, aType) ((const aType *)CBHSliceView_bytesOfSize((aView), sizeof(aType)))
+
+/** Returns the entries of a writable view as a typed pointer, checking the entry size once.
+ *
+ * @param aView    A `CBHMutableSliceView`.
+ * @param aType    The type of each entry. Must be `entrySize` bytes wide.
+ */
+#define CBHMutableSliceView_entries(aView, aType) ((aType *)CBHMutableSliceView_bytesOfSize((aView), sizeof(aType)))
+
+static inline const void *CBHSliceView_bytesOfSize(CBHSliceView view, size_t entrySize)
+{
+	if ( view.entrySize != entrySize ) @throw CBHEntrySizeException;
+	_CBHSliceView_checkValid(view, CBHSliceView_isValid);
+	return view.bytes;
+}
+
+static inline void *CBHMutableSliceView_bytesOfSize(CBHMutableSliceView view, size_t entrySize)
+{
+	if ( view.entrySize != entrySize ) @throw CBHEntrySizeException;
+	_CBHSliceView_checkValid(view, CBHMutableSliceView_isValid);
+	return view.bytes;
+}
+
+
+#pragma mark - Generic Access
+
+/** Returns a pointer to the entry at `index`. Only bounds-checked in `DEBUG` builds.
+ */
+static inline const void *CBHSliceView_valueAtIndex(CBHSliceView view, NSUInteger index)
+{
+	_CBHSliceView_checkValid(view, CBHSliceView_isValid);
+	_CBHSliceView_checkIndex(view, index);
+	return (const uint8_t *)view.bytes + (index * view.entrySize);
+}
+
+/** Returns a writable pointer to the entry at `index`. Only bounds-checked in `DEBUG` builds.
+ */
+static inline void *CBHMutableSliceView_valueAtIndex(CBHMutableSliceView view, NSUInteger index)
+{
+	_CBHSliceView_checkValid(view, CBHMutableSliceView_isValid);
+	_CBHSliceView_checkIndex(view, index);
+	return (uint8_t *)view.bytes + (index * view.entrySize);
+}
+
+NS_ASSUME_NONNULL_END
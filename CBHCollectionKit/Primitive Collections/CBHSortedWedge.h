@@ -0,0 +1,228 @@
+//  CBHSortedWedge.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import <CBHCollectionKit/CBHPrimitiveCollection.h>
+#import <CBHCollectionKit/CBHSlice.h>
+#import <CBHCollectionKit/CBHWedge.h>
+#import <CBHCollectionKit/CBHCollectionCoder.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** A dynamic collection of primitive values kept in ascending order.
+ *
+ * A Sorted Wedge orders its entries by a key, either the whole entry or a field within it, interpreted as an unsigned, signed, or floating point value. A single inserted entry is placed after any entries with an equal key.
+ *
+ * @author    Christian Huxtable <chris@huxtable.ca>
+ */
+@interface CBHSortedWedge : NSObject <NSCopying, NSSecureCoding, CBHPrimitiveCollection, CBHCollectionResizable>
+
+#pragma mark - Factories
+
++ (instancetype)sortedWedgeWithEntrySize:(size_t)entrySize type:(CBHPrimitiveType)type;
++ (instancetype)sortedWedgeWithEntrySize:(size_t)entrySize type:(CBHPrimitiveType)type andCapacity:(NSUInteger)capacity;
++ (instancetype)sortedWedgeWithEntrySize:(size_t)entrySize type:(CBHPrimitiveType)type andCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options;
+
++ (instancetype)sortedWedgeWithEntrySize:(size_t)entrySize type:(CBHPrimitiveType)type copying:(NSUInteger)count entriesFromBytes:(const void *)bytes;
+
++ (instancetype)sortedWedgeWithWedge:(CBHWedge *)wedge type:(CBHPrimitiveType)type;
+
+
+#pragma mark - Initialization
+
+- (instancetype)initWithEntrySize:(size_t)entrySize type:(CBHPrimitiveType)type;
+- (instancetype)initWithEntrySize:(size_t)entrySize type:(CBHPrimitiveType)type andCapacity:(NSUInteger)capacity;
+- (instancetype)initWithEntrySize:(size_t)entrySize type:(CBHPrimitiveType)type andCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options;
+
+/** Initializes an empty sorted wedge whose entries are ordered by a key stored within each entry.
+ *
+ * @param entrySize    The size of each entry in bytes.
+ * @param capacity     The number of entries to reserve space for.
+ * @param offset       The byte offset of the key within an entry.
+ * @param size         The width of the key in bytes. Must be 1, 2, 4, or 8 (4 or 8 for `CBHPrimitiveTypeFloat`).
+ * @param type         How to interpret the key.
+ *
+ * @return             An initialized sorted wedge.
+ */
+- (instancetype)initWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity sortedByKeyAtOffset:(size_t)offset ofSize:(size_t)size asType:(CBHPrimitiveType)type;
+
+/** Initializes an empty sorted wedge whose entries are ordered by a key stored within each entry, and whose buffer is allocated as described by `options`.
+ *
+ * @param entrySize    The size of each entry in bytes.
+ * @param capacity     The number of entries to reserve space for.
+ * @param offset       The byte offset of the key within an entry.
+ * @param size         The width of the key in bytes. Must be 1, 2, 4, or 8 (4 or 8 for `CBHPrimitiveTypeFloat`).
+ * @param type         How to interpret the key.
+ * @param options      The alignment, paging, and allocator of the sorted wedge's buffer.
+ *
+ * @return             An initialized sorted wedge.
+ */
+- (instancetype)initWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity sortedByKeyAtOffset:(size_t)offset ofSize:(size_t)size asType:(CBHPrimitiveType)type options:(CBHAllocationOptions)options NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)initWithEntrySize:(size_t)entrySize type:(CBHPrimitiveType)type copying:(NSUInteger)count entriesFromBytes:(const void *)bytes;
+
+- (instancetype)initWithWedge:(CBHWedge *)wedge type:(CBHPrimitiveType)type;
+
+- (nullable instancetype)initWithCollectionDecoder:(CBHCollectionDecoder *)decoder type:(CBHPrimitiveType)type;
+
+/** Initializes a newly allocated sorted wedge with the next collection read by `decoder`.
+ *
+ * The key isn't part of the binary collection format, so it is supplied again when decoding. Entries are sorted after they are read.
+ *
+ * @param decoder    The decoder to read from.
+ * @param offset     The byte offset of the key within an entry.
+ * @param size       The width of the key in bytes.
+ * @param type       How to interpret the key.
+ *
+ * @return           A newly initialized sorted wedge, or `nil` if the collection could not be read. The reason is left in the decoder's `error`.
+ */
+- (nullable instancetype)initWithCollectionDecoder:(CBHCollectionDecoder *)decoder sortedByKeyAtOffset:(size_t)offset ofSize:(size_t)size asType:(CBHPrimitiveType)type;
+
+- (nullable instancetype)initWithCoder:(NSCoder *)coder;
+
+
+#pragma mark - Properties
+
+@property (nonatomic, readonly) NSUInteger count;
+@property (nonatomic, readonly) NSUInteger capacity;
+@property (nonatomic, readonly) size_t entrySize;
+
+@property (nonatomic, readonly) BOOL isEmpty;
+
+@property (nonatomic, readonly) const void *bytes;
+
+@property (nonatomic, readonly) CBHPrimitiveType type;
+@property (nonatomic, readonly) size_t keyOffset;
+@property (nonatomic, readonly) size_t keySize;
+
+
+#pragma mark - Copying
+
+- (id)copyWithZone:(nullable NSZone *)zone;
+
+
+#pragma mark - Equality
+
+- (BOOL)isEqual:(id)other;
+- (BOOL)isEqualToSortedWedge:(CBHSortedWedge *)other;
+
+- (NSUInteger)hash;
+
+
+#pragma mark - Conversion
+
+- (CBHWedge *)wedge;
+- (CBHSlice *)slice;
+
+
+#pragma mark - Serialization
+
+/** Writes the entries of the receiver to `encoder` in the binary collection format. The key is not written.
+ *
+ * @param encoder    The encoder to write to.
+ *
+ * @return           `YES` if the receiver was written, otherwise `NO`. The reason is left in the encoder's `error`.
+ */
+- (BOOL)encodeWithCollectionEncoder:(CBHCollectionEncoder *)encoder;
+
+/** Encodes the key and the entries of the receiver.
+ */
+- (void)encodeWithCoder:(NSCoder *)coder;
+
+
+#pragma mark - Resizing
+
+- (BOOL)shrink;
+
+- (BOOL)grow;
+- (BOOL)growToFit:(NSUInteger)neededCapacity;
+
+- (BOOL)resize:(NSUInteger)newCapacity;
+
+
+#pragma mark - Searching
+
+/** Returns the index of the first entry whose key is not less than `key`.
+ *
+ * @param key    A pointer to a key of `keySize` bytes.
+ *
+ * @return       The index of the first entry not ordered before `key`, or `count` if every entry is.
+ */
+- (NSUInteger)lowerBound:(const void *)key;
+
+/** Returns the index of the first entry whose key is greater than `key`.
+ *
+ * @param key    A pointer to a key of `keySize` bytes.
+ *
+ * @return       The index of the first entry ordered after `key`, or `count` if there is none.
+ */
+- (NSUInteger)upperBound:(const void *)key;
+
+- (BOOL)containsValue:(const void *)key;
+- (NSUInteger)indexOfValue:(const void *)key;
+
+
+#pragma mark - Inserting
+
+/** Inserts an entry after any entries with an equal key.
+ *
+ * @param value    A pointer to an entry of `entrySize` bytes.
+ *
+ * @return         The index the entry was inserted at.
+ */
+- (NSUInteger)insertValue:(const void *)value;
+
+/** Inserts many entries at once.
+ *
+ * The entries are sorted and then merged into the receiver in a single pass, rather than shifting the receiver once per entry.
+ *
+ * @param values    A pointer to the first of `count` entries of `entrySize` bytes.
+ * @param count     The number of entries to insert.
+ */
+- (void)insertValues:(const void *)values count:(NSUInteger)count;
+
+
+#pragma mark - Removing
+
+- (BOOL)removeValue:(const void *)key;
+- (void)removeValueAtIndex:(NSUInteger)index;
+
+- (void)removeAll;
+- (void)removeLast:(NSUInteger)count;
+
+
+#pragma mark - Description
+
+- (NSString *)description;
+- (NSString *)debugDescription;
+
+
+#pragma mark - Generic Accessors
+
+- (const void *)valueAtIndex:(NSUInteger)index;
+
+
+#pragma mark - Unavailable
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,586 @@
+//  CBHSortedWedge.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHSortedWedge.h"
+#import "_CBHStack.h"
+#import "_CBHSort.h"
+#import "_CBHHash.h"
+
+@import CBHMemoryKit;
+
+
+#define DEFAULT_CAPACITY 8
+
+#define CODER_KEY @"CBHCollection"
+#define CODER_KEY_OFFSET @"CBHKeyOffset"
+#define CODER_KEY_SIZE @"CBHKeySize"
+#define CODER_KEY_TYPE @"CBHKeyType"
+#define GROWTH_FACTOR 1.618033988749895
+
+#define _checkReadableIndex(anIndex) if ( (anIndex) >= _stack._count ) @throw NSRangeException
+
+#define _pointerToIndex(anIndex) ((uint8_t *)_stack._data + ((anIndex) * _stack._entrySize))
+
+#define _nextCapacity(aCapacity) (size_t)ceil((double)(aCapacity) * GROWTH_FACTOR)
+
+
+#pragma mark - Searching
+
+/// Branchless binary search. Returns the index of the first entry whose key is not ordered before `bits`, or after it when `inclusive` is set.
+static inline NSUInteger CBHSortedWedge_bound(const CBHStack_t *stack, const CBHSortKey_t *key, uint64_t bits, BOOL inclusive)
+{
+	if ( stack->_count <= 0 ) return 0;
+
+	const uint8_t *data = (const uint8_t *)stack->_data;
+	const size_t entrySize = stack->_entrySize;
+
+	NSUInteger base = 0;
+	NSUInteger length = stack->_count;
+
+	while ( length > 1 )
+	{
+		const NSUInteger half = length / 2;
+
+		/// Fetch both possible next probes while this one resolves.
+		__builtin_prefetch(data + ((base + (half / 2)) * entrySize));
+		__builtin_prefetch(data + ((base + half + (half / 2)) * entrySize));
+
+		const uint64_t probe = CBHSortKey_bits(data + ((base + half) * entrySize), key);
+		base = ( probe < bits || (inclusive && probe == bits) ) ? base + half : base;
+		length -= half;
+	}
+
+	const uint64_t probe = CBHSortKey_bits(data + (base * entrySize), key);
+	return base + (NSUInteger)( probe < bits || (inclusive && probe == bits) );
+}
+
+
+@interface CBHSortedWedge ()
+{
+	CBHStack_t _stack;
+	CBHSortKey_t _key;
+
+	/// Describes a bare key supplied to the search methods.
+	CBHSortKey_t _searchKey;
+}
+
+@end
+
+
+@implementation CBHSortedWedge
+
+#pragma mark - Factories
+
++ (instancetype)sortedWedgeWithEntrySize:(size_t)entrySize type:(CBHPrimitiveType)type
+{
+	return [[(CBHSortedWedge *)[self alloc] initWithEntrySize:entrySize type:type] autorelease];
+}
+
++ (instancetype)sortedWedgeWithEntrySize:(size_t)entrySize type:(CBHPrimitiveType)type andCapacity:(NSUInteger)capacity
+{
+	return [[(CBHSortedWedge *)[self alloc] initWithEntrySize:entrySize type:type andCapacity:capacity] autorelease];
+}
+
++ (instancetype)sortedWedgeWithEntrySize:(size_t)entrySize type:(CBHPrimitiveType)type andCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options
+{
+	return [[(CBHSortedWedge *)[self alloc] initWithEntrySize:entrySize type:type andCapacity:capacity options:options] autorelease];
+}
+
+
++ (instancetype)sortedWedgeWithEntrySize:(size_t)entrySize type:(CBHPrimitiveType)type copying:(NSUInteger)count entriesFromBytes:(const void *)bytes
+{
+	return [[(CBHSortedWedge *)[self alloc] initWithEntrySize:entrySize type:type copying:count entriesFromBytes:bytes] autorelease];
+}
+
+
++ (instancetype)sortedWedgeWithWedge:(CBHWedge *)wedge type:(CBHPrimitiveType)type
+{
+	return [[(CBHSortedWedge *)[self alloc] initWithWedge:wedge type:type] autorelease];
+}
+
+
+#pragma mark - Initialization
+
+- (instancetype)initWithEntrySize:(size_t)entrySize type:(CBHPrimitiveType)type
+{
+	return [self initWithEntrySize:entrySize andCapacity:DEFAULT_CAPACITY sortedByKeyAtOffset:0 ofSize:entrySize asType:type];
+}
+
+- (instancetype)initWithEntrySize:(size_t)entrySize type:(CBHPrimitiveType)type andCapacity:(NSUInteger)capacity
+{
+	return [self initWithEntrySize:entrySize andCapacity:capacity sortedByKeyAtOffset:0 ofSize:entrySize asType:type];
+}
+
+- (instancetype)initWithEntrySize:(size_t)entrySize type:(CBHPrimitiveType)type andCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options
+{
+	return [self initWithEntrySize:entrySize andCapacity:capacity sortedByKeyAtOffset:0 ofSize:entrySize asType:type options:options];
+}
+
+- (instancetype)initWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity sortedByKeyAtOffset:(size_t)offset ofSize:(size_t)size asType:(CBHPrimitiveType)type
+{
+	return [self initWithEntrySize:entrySize andCapacity:capacity sortedByKeyAtOffset:offset ofSize:size asType:type options:CBHAllocationOptionsDefault];
+}
+
+- (instancetype)initWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity sortedByKeyAtOffset:(size_t)offset ofSize:(size_t)size asType:(CBHPrimitiveType)type options:(CBHAllocationOptions)options
+{
+	CBHSortKey_t key = {offset, size, type};
+
+	NSExceptionName invalid = CBHSortKey_check(&key, entrySize);
+	if ( invalid )
+	{
+		[self release];
+		@throw invalid;
+	}
+
+	if ( (self = [super init]) )
+	{
+		_stack = CBHStack_initWithOptions(capacity, entrySize, &options);
+
+		_key = key;
+		_searchKey = key;
+		_searchKey._offset = 0;
+	}
+
+	return self;
+}
+
+
+- (instancetype)initWithEntrySize:(size_t)entrySize type:(CBHPrimitiveType)type copying:(NSUInteger)count entriesFromBytes:(const void *)bytes
+{
+	if ( (self = [self initWithEntrySize:entrySize type:type andCapacity:count]) )
+	{
+		[self insertValues:bytes count:count];
+	}
+
+	return self;
+}
+
+- (instancetype)initWithWedge:(CBHWedge *)wedge type:(CBHPrimitiveType)type
+{
+	return [self initWithEntrySize:[wedge entrySize] type:type copying:[wedge count] entriesFromBytes:[wedge bytes]];
+}
+
+- (instancetype)initWithCollectionDecoder:(CBHCollectionDecoder *)decoder type:(CBHPrimitiveType)type
+{
+	return [self initWithCollectionDecoder:decoder sortedByKeyAtOffset:0 ofSize:0 asType:type];
+}
+
+- (instancetype)initWithCollectionDecoder:(CBHCollectionDecoder *)decoder sortedByKeyAtOffset:(size_t)offset ofSize:(size_t)size asType:(CBHPrimitiveType)type
+{
+	NSUInteger count = 0;
+	size_t entrySize = 0;
+
+	if ( ![decoder decodeEntryCount:&count entrySize:&entrySize] )
+	{
+		[self release];
+		return nil;
+	}
+
+	/// A size of zero keys by the whole entry, which is only known once the header is read.
+	if ( size <= 0 ) { size = entrySize; }
+
+	if ( (self = [self initWithEntrySize:entrySize andCapacity:DEFAULT_CAPACITY sortedByKeyAtOffset:offset ofSize:size asType:type]) )
+	{
+		const BOOL didDecode = [decoder decodeEntriesReserving:^void *(NSUInteger capacity) {
+			if ( capacity > self->_stack._capacity ) CBHStack_setCapacity(&self->_stack, capacity);
+			return self->_stack._data;
+		}];
+
+		if ( !didDecode )
+		{
+			[self release];
+			return nil;
+		}
+
+		/// Sorted in place, entries written by a sorted wedge are already in order.
+		CBHSort_sortByKey(_stack._data, count, entrySize, _key._offset, _key._size, _key._type);
+		_stack._count = count;
+	}
+
+	return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)coder
+{
+	const size_t offset = (size_t)[coder decodeInt64ForKey:CODER_KEY_OFFSET];
+	const size_t size = (size_t)[coder decodeInt64ForKey:CODER_KEY_SIZE];
+	const CBHPrimitiveType type = (CBHPrimitiveType)[coder decodeInt64ForKey:CODER_KEY_TYPE];
+
+	NSUInteger length = 0;
+	const uint8_t *bytes = [coder decodeBytesForKey:CODER_KEY returnedLength:&length];
+
+	NSData *data = [[NSData alloc] initWithBytesNoCopy:(void *)bytes length:length freeWhenDone:NO];
+	CBHCollectionDecoder *decoder = [[CBHCollectionDecoder alloc] initWithData:data];
+
+	self = [self initWithCollectionDecoder:decoder sortedByKeyAtOffset:offset ofSize:size asType:type];
+
+	[decoder release];
+	[data release];
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	CBHStack_dealloc(&_stack);
+
+	[super dealloc];
+}
+
+
+#pragma mark - Properties
+
+- (NSUInteger)count
+{
+	return _stack._count;
+}
+
+- (NSUInteger)capacity
+{
+	return _stack._capacity;
+}
+
+- (size_t)entrySize
+{
+	return _stack._entrySize;
+}
+
+- (BOOL)isEmpty
+{
+	return _stack._count <= 0;
+}
+
+- (const void *)bytes
+{
+	return _stack._data;
+}
+
+
+- (CBHPrimitiveType)type
+{
+	return _key._type;
+}
+
+- (size_t)keyOffset
+{
+	return _key._offset;
+}
+
+- (size_t)keySize
+{
+	return _key._size;
+}
+
+
+#pragma mark - Copying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	CBHSortedWedge *copy = [[CBHSortedWedge allocWithZone:zone] initWithEntrySize:_stack._entrySize andCapacity:_stack._capacity sortedByKeyAtOffset:_key._offset ofSize:_key._size asType:_key._type options:_stack._options];
+
+	/// Already sorted, copy directly.
+	CBHMemory_copyTo(_stack._data, copy->_stack._data, _stack._count, _stack._entrySize);
+	copy->_stack._count = _stack._count;
+
+	return copy;
+}
+
+
+#pragma mark - Equality
+
+- (BOOL)isEqual:(id)other
+{
+	if ( [other isKindOfClass:[CBHSortedWedge class]] ) return [self isEqualToSortedWedge:other];
+	return [super isEqual:other];
+}
+
+- (BOOL)isEqualToSortedWedge:(CBHSortedWedge *)other
+{
+	/// Catch trivial cases.
+	if ( self == other ) return YES;
+	if ( _stack._entrySize != other->_stack._entrySize ) return NO;
+	if ( _stack._count != other->_stack._count ) return NO;
+	if ( _key._offset != other->_key._offset || _key._size != other->_key._size || _key._type != other->_key._type ) return NO;
+	if ( _stack._count <= 0 ) return YES;
+
+	/// Compare the data.
+	return CBHMemory_compare(_stack._data, other->_stack._data, _stack._count, _stack._entrySize);
+}
+
+- (NSUInteger)hash
+{
+	/// Hash every entry, mixing in the key so the same bytes ordered another way hash apart.
+	const uint64_t key = ((uint64_t)_key._offset << 16) ^ ((uint64_t)_key._size << 8) ^ (uint64_t)_key._type;
+	return (NSUInteger)CBHHash(_stack._data, _stack._count * _stack._entrySize, _stack._entrySize ^ (key << 32));
+}
+
+
+#pragma mark - Conversion
+
+- (CBHWedge *)wedge
+{
+	return [CBHWedge wedgeWithEntrySize:_stack._entrySize copying:_stack._count entriesFromBytes:_stack._data];
+}
+
+- (CBHSlice *)slice
+{
+	return [CBHSlice sliceWithEntrySize:_stack._entrySize copying:_stack._count entriesFromBytes:_stack._data];
+}
+
+
+#pragma mark - Serialization
+
++ (BOOL)supportsSecureCoding
+{
+	return YES;
+}
+
+- (BOOL)encodeWithCollectionEncoder:(CBHCollectionEncoder *)encoder
+{
+	return [encoder encodeEntries:_stack._data entrySize:_stack._entrySize count:_stack._count];
+}
+
+- (void)encodeWithCoder:(NSCoder *)coder
+{
+	NSMutableData *data = [NSMutableData dataWithCapacity:sizeof(CBHCollectionHeader) + (_stack._count * _stack._entrySize)];
+
+	CBHCollectionEncoder *encoder = [[CBHCollectionEncoder alloc] initWithMutableData:data];
+	[self encodeWithCollectionEncoder:encoder];
+	[encoder release];
+
+	[coder encodeInt64:(int64_t)_key._offset forKey:CODER_KEY_OFFSET];
+	[coder encodeInt64:(int64_t)_key._size forKey:CODER_KEY_SIZE];
+	[coder encodeInt64:(int64_t)_key._type forKey:CODER_KEY_TYPE];
+	[coder encodeBytes:[data bytes] length:[data length] forKey:CODER_KEY];
+}
+
+
+#pragma mark - Resizable
+
+- (BOOL)shrink
+{
+	/// Prevent empty capacity.
+	NSUInteger newCapacity = _stack._count;
+	if ( newCapacity < 1 ) newCapacity = 1;
+
+	/// Shrink.
+	CBHStack_setCapacity(&_stack, newCapacity);
+	return YES;
+}
+
+- (BOOL)grow
+{
+	/// Early return if growth unnecessary.
+	if ( _stack._capacity > _stack._count ) return NO;
+
+	/// Grow.
+	CBHStack_setCapacity(&_stack, _nextCapacity(_stack._capacity));
+	return YES;
+}
+
+- (BOOL)growToFit:(NSUInteger)neededCapacity
+{
+	/// Early return if growth unnecessary.
+	if ( neededCapacity <= _stack._capacity ) return NO;
+
+	/// Find new capacity which fits the needed capacity.
+	NSUInteger nextCapacity = ( _stack._capacity > 0 ) ? _stack._capacity : 1;
+	while ( neededCapacity > nextCapacity ) { nextCapacity = _nextCapacity(nextCapacity); }
+
+	/// Grow.
+	CBHStack_setCapacity(&_stack, nextCapacity);
+	return YES;
+}
+
+- (BOOL)resize:(NSUInteger)newCapacity
+{
+	/// Early return if resize unnecessary.
+	if ( newCapacity <= 0 ) return NO;
+	if ( newCapacity == _stack._capacity ) return NO;
+	if ( newCapacity < _stack._count ) return NO;
+
+	/// Resize.
+	CBHStack_setCapacity(&_stack, newCapacity);
+	return YES;
+}
+
+
+#pragma mark - Searching
+
+- (NSUInteger)lowerBound:(const void *)key
+{
+	return CBHSortedWedge_bound(&_stack, &_key, CBHSortKey_bits(key, &_searchKey), NO);
+}
+
+- (NSUInteger)upperBound:(const void *)key
+{
+	return CBHSortedWedge_bound(&_stack, &_key, CBHSortKey_bits(key, &_searchKey), YES);
+}
+
+- (BOOL)containsValue:(const void *)key
+{
+	return [self indexOfValue:key] != NSNotFound;
+}
+
+- (NSUInteger)indexOfValue:(const void *)key
+{
+	const uint64_t bits = CBHSortKey_bits(key, &_searchKey);
+	const NSUInteger index = CBHSortedWedge_bound(&_stack, &_key, bits, NO);
+
+	if ( index >= _stack._count ) return NSNotFound;
+	if ( CBHSortKey_bits(_pointerToIndex(index), &_key) != bits ) return NSNotFound;
+
+	return index;
+}
+
+
+#pragma mark - Inserting
+
+- (NSUInteger)insertValue:(const void *)value
+{
+	const NSUInteger index = CBHSortedWedge_bound(&_stack, &_key, CBHSortKey_bits(value, &_key), YES);
+
+	if ( _stack._capacity <= _stack._count ) { [self growToFit:_stack._count + 1]; }
+
+	/// Shift the tail up by one and fill the gap.
+	memmove(_pointerToIndex(index + 1), _pointerToIndex(index), (_stack._count - index) * _stack._entrySize);
+	CBHMemory_copyTo(value, _pointerToIndex(index), 1, _stack._entrySize);
+	++_stack._count;
+
+	return index;
+}
+
+- (void)insertValues:(const void *)values count:(NSUInteger)count
+{
+	if ( count <= 0 ) return;
+	if ( count > NSUIntegerMax - _stack._count ) @throw NSRangeException;
+
+	const size_t entrySize = _stack._entrySize;
+
+	/// Sort a copy of the incoming entries, taken before growing in case they are within the receiver.
+	uint8_t *batch = CBHMemory_alloc(count, entrySize);
+	if ( !batch ) @throw CBHCallocException;
+
+	CBHMemory_copyTo(values, batch, count, entrySize);
+	CBHSort_sortByKey(batch, count, entrySize, _key._offset, _key._size, _key._type);
+
+	[self growToFit:_stack._count + count];
+
+	/// Merge from the back so no entry is moved more than once.
+	NSUInteger existing = _stack._count;
+	NSUInteger incoming = count;
+	NSUInteger destination = _stack._count + count;
+
+	while ( incoming > 0 )
+	{
+		const uint8_t *candidate = batch + ((incoming - 1) * entrySize);
+
+		if ( existing > 0 && CBHSortKey_bits(_pointerToIndex(existing - 1), &_key) > CBHSortKey_bits(candidate, &_key) )
+		{
+			--existing;
+			CBHMemory_copyTo(_pointerToIndex(existing), _pointerToIndex(--destination), 1, entrySize);
+		}
+		else
+		{
+			--incoming;
+			CBHMemory_copyTo(candidate, _pointerToIndex(--destination), 1, entrySize);
+		}
+	}
+
+	_stack._count += count;
+
+	CBHMemory_free(batch);
+}
+
+
+#pragma mark - Removing
+
+- (BOOL)removeValue:(const void *)key
+{
+	const NSUInteger index = [self indexOfValue:key];
+	if ( index == NSNotFound ) return NO;
+
+	[self removeValueAtIndex:index];
+	return YES;
+}
+
+- (void)removeValueAtIndex:(NSUInteger)index
+{
+	_checkReadableIndex(index);
+
+	memmove(_pointerToIndex(index), _pointerToIndex(index + 1), (_stack._count - index - 1) * _stack._entrySize);
+	--_stack._count;
+}
+
+
+- (void)removeAll
+{
+	_stack._count = 0;
+}
+
+- (void)removeLast:(NSUInteger)count
+{
+	if ( count >= _stack._count )
+	{
+		_stack._count = 0;
+	}
+	else
+	{
+		_stack._count -= count;
+	}
+}
+
+
+#pragma mark - Description
+
+- (NSString *)description
+{
+	NSMutableString *description = [NSMutableString stringWithString:@"("];
+
+	for (NSUInteger i = 0; i < _stack._count; ++i)
+	{
+		[description appendString:@"\n\t0x"];
+		uint8_t *ptr = _pointerToIndex(i);
+		for (NSUInteger j = _stack._entrySize; j > 0; --j)
+		{
+			[description appendFormat:@"%x", *(uint8_t *)((size_t)ptr + (j - 1))];
+		}
+		if ( i != _stack._count - 1 ) { [description appendString:@","]; }
+	}
+
+	return [NSString stringWithFormat:@"%@\n)", description];
+}
+
+- (NSString *)debugDescription
+{
+	return [NSString stringWithFormat:@"<%@: %p> %@", [self class], (void *)self, [self description]];
+}
+
+
+#pragma mark - Generic Accessors
+
+- (const void *)valueAtIndex:(NSUInteger)index
+{
+	_checkReadableIndex(index);
+	return _pointerToIndex(index);
+}
+
+@end
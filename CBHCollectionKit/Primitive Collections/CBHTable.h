@@ -0,0 +1,229 @@
+//  CBHTable.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import <CBHCollectionKit/CBHPrimitiveCollection.h>
+#import <CBHCollectionKit/CBHSliceView.h>
+#import <CBHCollectionKit/CBHWedge.h>
+#import <CBHCollectionKit/CBHBitSlice.h>
+
+#include <stddef.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Columns
+
+/** Describes a column of a table, and the field of a record it is filled from. */
+typedef struct CBHTableColumn {
+	/** The byte offset of the field within a record. */
+	size_t offset;
+
+	/** The width of the field in bytes. */
+	size_t size;
+
+	/** How the field is interpreted when scanned. */
+	CBHPrimitiveType type;
+} CBHTableColumn;
+
+/** Describes a column holding `aField` of the record struct `aStruct`. */
+#define CBHTableColumnOf(aStruct, aField, aType) ((CBHTableColumn){offsetof(aStruct, aField), sizeof(((aStruct *)0)->aField), (aType)})
+
+
+#pragma mark - Table
+
+/** A dynamic collection of records stored as one wedge per field.
+ *
+ * A Table keeps each field of its records in a column of its own, so scanning a field reads only that field's bytes. Records go in and come out whole, as structs laid out as the columns describe, or field by field. All columns always hold one value per row.
+ *
+ * @author    Christian Huxtable <chris@huxtable.ca>
+ */
+@interface CBHTable : NSObject <NSCopying, CBHCollection, CBHCollectionResizable>
+
+#pragma mark - Factories
+
++ (instancetype)tableWithColumns:(const CBHTableColumn *)columns count:(NSUInteger)columnCount recordSize:(size_t)recordSize;
++ (instancetype)tableWithColumns:(const CBHTableColumn *)columns count:(NSUInteger)columnCount recordSize:(size_t)recordSize andCapacity:(NSUInteger)capacity;
+
++ (instancetype)tableWithColumns:(const CBHTableColumn *)columns count:(NSUInteger)columnCount recordsFromWedge:(CBHWedge *)wedge;
+
+
+#pragma mark - Initialization
+
+- (instancetype)initWithColumns:(const CBHTableColumn *)columns count:(NSUInteger)columnCount recordSize:(size_t)recordSize;
+
+/** Initializes an empty table.
+ *
+ * @param columns        The columns, each of which must lie within a record.
+ * @param columnCount    The number of columns. Must not be zero.
+ * @param recordSize     The size of a record, usually `sizeof` the record struct.
+ * @param capacity       The number of rows the table can hold before growing.
+ *
+ * @return               An initialized empty table.
+ */
+- (instancetype)initWithColumns:(const CBHTableColumn *)columns count:(NSUInteger)columnCount recordSize:(size_t)recordSize andCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+
+/** Initializes a table with the records of `wedge`, splitting each into its columns.
+ *
+ * @param columns        The columns, each of which must lie within a record.
+ * @param columnCount    The number of columns. Must not be zero.
+ * @param wedge          A wedge whose entries are records.
+ *
+ * @return               An initialized table.
+ */
+- (instancetype)initWithColumns:(const CBHTableColumn *)columns count:(NSUInteger)columnCount recordsFromWedge:(CBHWedge *)wedge;
+
+
+#pragma mark - Properties
+
+/** The number of rows. */
+@property (nonatomic, readonly) NSUInteger count;
+@property (nonatomic, readonly) NSUInteger capacity;
+
+@property (nonatomic, readonly) BOOL isEmpty;
+
+@property (nonatomic, readonly) NSUInteger columnCount;
+@property (nonatomic, readonly) size_t recordSize;
+
+- (CBHTableColumn)columnAtIndex:(NSUInteger)column;
+
+
+#pragma mark - Copying
+
+- (id)copyWithZone:(nullable NSZone *)zone;
+
+
+#pragma mark - Equality
+
+- (BOOL)isEqual:(id)other;
+- (BOOL)isEqualToTable:(CBHTable *)other;
+
+- (NSUInteger)hash;
+
+
+#pragma mark - Resizing
+
+- (BOOL)shrink;
+
+- (BOOL)grow;
+- (BOOL)growToFit:(NSUInteger)neededCapacity;
+
+- (BOOL)resize:(NSUInteger)newCapacity;
+
+
+#pragma mark - Description
+
+- (NSString *)description;
+- (NSString *)debugDescription;
+
+
+#pragma mark - Fields
+
+- (const void *)valueAtRow:(NSUInteger)row column:(NSUInteger)column;
+- (void)setValue:(const void *)value atRow:(NSUInteger)row column:(NSUInteger)column;
+
+
+#pragma mark - Records
+
+/** Appends a record, splitting it into its columns.
+ *
+ * @param record    A pointer to a record of `recordSize` bytes.
+ */
+- (void)appendRecord:(const void *)record;
+
+/** Appends records, splitting each into its columns one column at a time.
+ *
+ * @param records    A pointer to `count` consecutive records.
+ * @param count      The number of records.
+ */
+- (void)appendRecords:(const void *)records count:(NSUInteger)count;
+
+/** Gathers a row's fields into a record. Bytes of the record not covered by a column are left untouched.
+ *
+ * @param record    A pointer to a record of `recordSize` bytes.
+ * @param row       The index of the row.
+ */
+- (void)getRecord:(void *)record atRow:(NSUInteger)row;
+
+/** Gathers a range of rows into consecutive records, one column at a time.
+ *
+ * @param records    A pointer to room for `range.length` records.
+ * @param range      The range of rows.
+ */
+- (void)getRecords:(void *)records range:(NSRange)range;
+
+/** A wedge with every row gathered back into a record. */
+- (CBHWedge *)recordWedge;
+
+
+#pragma mark - Columns
+
+/** A wedge of the values of a column. The wedge shares the column's bytes until either is written to.
+ *
+ * @param column    The index of the column.
+ *
+ * @return          A copy of the column.
+ */
+- (CBHWedge *)wedgeOfColumn:(NSUInteger)column;
+
+/** Lends the values of one column, and only that column, to `block`.
+ *
+ * @param column    The index of the column.
+ * @param block     The block to call with a view of the column.
+ */
+- (void)withUnsafeBytesOfColumn:(NSUInteger)column usingBlock:(void (NS_NOESCAPE ^)(CBHSliceView view))block;
+
+
+#pragma mark - Scanning
+
+/** Marks the rows whose value in `column` lies between `low` and `high` inclusive.
+ *
+ * Values are compared in the column's type, using the same ordering as sorting. Each value is compared without branching, and 64 rows are marked at a time.
+ *
+ * @param column    The index of a column 1, 2, 4, or 8 bytes wide (4 or 8 for `CBHPrimitiveTypeFloat`).
+ * @param low       A pointer to the lowest value to select, of the column's size.
+ * @param high      A pointer to the highest value to select, of the column's size.
+ *
+ * @return          A bit slice with one bit per row, set for the rows selected.
+ */
+- (CBHBitSlice *)rowsOfColumn:(NSUInteger)column from:(const void *)low to:(const void *)high;
+
+/** Sums a column in its type.
+ *
+ * @param column    The index of a column 1, 2, 4, or 8 bytes wide (4 or 8 for `CBHPrimitiveTypeFloat`).
+ * @param rows      The rows to sum, or `nil` for all of them. Rows past the end of `rows` are not summed.
+ *
+ * @return          The sum as a double.
+ */
+- (double)sumOfColumn:(NSUInteger)column inRows:(nullable CBHBitSlice *)rows;
+
+
+#pragma mark - Removing
+
+- (void)removeAll;
+- (void)removeLast:(NSUInteger)count;
+
+
+#pragma mark - Unavailable
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
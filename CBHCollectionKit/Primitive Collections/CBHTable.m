@@ -0,0 +1,610 @@
+//  CBHTable.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHTable.h"
+
+#import "_CBHSort.h"
+#import "_CBHHash.h"
+
+@import CBHMemoryKit;
+
+
+#define DEFAULT_CAPACITY 8
+#define CHUNK_LENGTH ((NSUInteger)1024)
+#define WORD_BITS ((NSUInteger)64)
+
+#define _checkColumn(aColumn) if ( (aColumn) >= _columnCount ) @throw NSRangeException
+#define _checkReadableRow(aRow) if ( (aRow) >= _count ) @throw NSRangeException
+#define _checkRange(aRange) if ( (aRange).location > _count || (aRange).length > _count - (aRange).location ) @throw NSRangeException
+#define _checkAppendable(aCount) if ( (aCount) > NSUIntegerMax - _count ) @throw NSRangeException
+
+#define _wordsFor(aCount) (((aCount) + (WORD_BITS - 1)) / WORD_BITS)
+
+
+#pragma mark - Strided Copies
+
+#define _copyStrided(aSize)\
+	for (NSUInteger i = 0; i < count; ++i) { memcpy(destination + (i * destinationStride), source + (i * sourceStride), (aSize)); }
+
+/// Copies `count` fields between records and packed values, in either direction.
+static void CBHTable_copyStrided(uint8_t *destination, size_t destinationStride, const uint8_t *source, size_t sourceStride, size_t size, NSUInteger count)
+{
+	/// Constant sizes let each copy compile down to a single load and store.
+	switch ( size )
+	{
+		case 1: _copyStrided(1); break;
+		case 2: _copyStrided(2); break;
+		case 4: _copyStrided(4); break;
+		case 8: _copyStrided(8); break;
+		default: _copyStrided(size); break;
+	}
+}
+
+
+#pragma mark - Scans
+
+/// Marks, 64 rows to a word, the values whose ordered bits lie within `low` and `high`. Each value is mapped and compared without branching, so the loop vectorizes. Negative floats have every bit flipped, other signed values only their sign.
+#define _defineScan(aBits)\
+static void CBHTable_scan##aBits(const uint##aBits##_t *values, NSUInteger count, CBHPrimitiveType type, uint##aBits##_t low, uint##aBits##_t high, uint64_t *words)\
+{\
+	const uint##aBits##_t sign = (uint##aBits##_t)((uint##aBits##_t)1 << (aBits - 1));\
+	const uint##aBits##_t flip = ( type == CBHPrimitiveTypeFloat ) ? 1 : 0;\
+	const uint##aBits##_t toggle = ( type != CBHPrimitiveTypeUnsigned ) ? sign : 0;\
+	const uint##aBits##_t span = (uint##aBits##_t)(high - low);\
+\
+	for (NSUInteger word = 0; word < _wordsFor(count); ++word)\
+	{\
+		const uint##aBits##_t *chunk = values + (word * WORD_BITS);\
+		const NSUInteger length = MIN(WORD_BITS, count - (word * WORD_BITS));\
+		uint64_t bits = 0;\
+\
+		for (NSUInteger i = 0; i < length; ++i)\
+		{\
+			const uint##aBits##_t value = chunk[i];\
+			const uint##aBits##_t negative = (uint##aBits##_t)(0 - ((value >> (aBits - 1)) & flip));\
+			const uint##aBits##_t key = (uint##aBits##_t)(value ^ (negative | toggle));\
+\
+			bits |= (uint64_t)((uint##aBits##_t)(key - low) <= span) << i;\
+		}\
+\
+		words[word] = bits;\
+	}\
+}
+
+_defineScan(8)
+_defineScan(16)
+_defineScan(32)
+_defineScan(64)
+
+static void CBHTable_scan(const CBHTableColumn *column, const void *values, NSUInteger count, uint64_t low, uint64_t high, uint64_t *words)
+{
+	switch ( column->size )
+	{
+		case 1: CBHTable_scan8((const uint8_t *)values, count, column->type, (uint8_t)low, (uint8_t)high, words); break;
+		case 2: CBHTable_scan16((const uint16_t *)values, count, column->type, (uint16_t)low, (uint16_t)high, words); break;
+		case 4: CBHTable_scan32((const uint32_t *)values, count, column->type, (uint32_t)low, (uint32_t)high, words); break;
+		default: CBHTable_scan64((const uint64_t *)values, count, column->type, low, high, words); break;
+	}
+}
+
+
+#pragma mark - Sums
+
+/// Sums every value, or only those marked in `rows`. Four running sums keep the additions independent.
+#define _defineSum(aName, aType)\
+static double CBHTable_sum_##aName(const void *bytes, NSUInteger count, const uint64_t *rows)\
+{\
+	const aType *values = (const aType *)bytes;\
+	double sums[4] = {0, 0, 0, 0};\
+\
+	if ( !rows )\
+	{\
+		NSUInteger i = 0;\
+		for (; i + 4 <= count; i += 4)\
+		{\
+			sums[0] += (double)values[i];\
+			sums[1] += (double)values[i + 1];\
+			sums[2] += (double)values[i + 2];\
+			sums[3] += (double)values[i + 3];\
+		}\
+		for (; i < count; ++i) { sums[0] += (double)values[i]; }\
+	}\
+	else\
+	{\
+		for (NSUInteger word = 0; word < _wordsFor(count); ++word)\
+		{\
+			const NSUInteger remaining = count - (word * WORD_BITS);\
+			uint64_t bits = rows[word];\
+			if ( remaining < WORD_BITS ) { bits &= (1ull << remaining) - 1; }\
+\
+			for (; bits; bits &= bits - 1) { sums[word % 4] += (double)values[(word * WORD_BITS) + (NSUInteger)__builtin_ctzll(bits)]; }\
+		}\
+	}\
+\
+	return (sums[0] + sums[1]) + (sums[2] + sums[3]);\
+}
+
+_defineSum(uint8, uint8_t)
+_defineSum(uint16, uint16_t)
+_defineSum(uint32, uint32_t)
+_defineSum(uint64, uint64_t)
+_defineSum(int8, int8_t)
+_defineSum(int16, int16_t)
+_defineSum(int32, int32_t)
+_defineSum(int64, int64_t)
+_defineSum(float, float)
+_defineSum(double, double)
+
+static double CBHTable_sum(const CBHTableColumn *column, const void *values, NSUInteger count, const uint64_t *rows)
+{
+	if ( column->type == CBHPrimitiveTypeFloat )
+	{
+		return ( column->size == 4 ) ? CBHTable_sum_float(values, count, rows) : CBHTable_sum_double(values, count, rows);
+	}
+
+	const BOOL isSigned = ( column->type == CBHPrimitiveTypeSigned );
+	switch ( column->size )
+	{
+		case 1: return ( isSigned ) ? CBHTable_sum_int8(values, count, rows) : CBHTable_sum_uint8(values, count, rows);
+		case 2: return ( isSigned ) ? CBHTable_sum_int16(values, count, rows) : CBHTable_sum_uint16(values, count, rows);
+		case 4: return ( isSigned ) ? CBHTable_sum_int32(values, count, rows) : CBHTable_sum_uint32(values, count, rows);
+		default: return ( isSigned ) ? CBHTable_sum_int64(values, count, rows) : CBHTable_sum_uint64(values, count, rows);
+	}
+}
+
+
+@interface CBHTable ()
+{
+	CBHTableColumn *_columns;
+	CBHWedge **_wedges;
+	NSUInteger _columnCount;
+
+	size_t _recordSize;
+	NSUInteger _count;
+}
+
+/// Checks that a column can be scanned, throwing otherwise.
+- (void)validateScannableColumn:(NSUInteger)column;
+
+@end
+
+
+@implementation CBHTable
+
+#pragma mark - Factories
+
++ (instancetype)tableWithColumns:(const CBHTableColumn *)columns count:(NSUInteger)columnCount recordSize:(size_t)recordSize
+{
+	return [[(CBHTable *)[self alloc] initWithColumns:columns count:columnCount recordSize:recordSize] autorelease];
+}
+
++ (instancetype)tableWithColumns:(const CBHTableColumn *)columns count:(NSUInteger)columnCount recordSize:(size_t)recordSize andCapacity:(NSUInteger)capacity
+{
+	return [[(CBHTable *)[self alloc] initWithColumns:columns count:columnCount recordSize:recordSize andCapacity:capacity] autorelease];
+}
+
++ (instancetype)tableWithColumns:(const CBHTableColumn *)columns count:(NSUInteger)columnCount recordsFromWedge:(CBHWedge *)wedge
+{
+	return [[(CBHTable *)[self alloc] initWithColumns:columns count:columnCount recordsFromWedge:wedge] autorelease];
+}
+
+
+#pragma mark - Initialization
+
+- (instancetype)initWithColumns:(const CBHTableColumn *)columns count:(NSUInteger)columnCount recordSize:(size_t)recordSize
+{
+	return [self initWithColumns:columns count:columnCount recordSize:recordSize andCapacity:DEFAULT_CAPACITY];
+}
+
+- (instancetype)initWithColumns:(const CBHTableColumn *)columns count:(NSUInteger)columnCount recordSize:(size_t)recordSize andCapacity:(NSUInteger)capacity
+{
+	NSExceptionName invalid = nil;
+	if ( columnCount <= 0 ) invalid = NSInvalidArgumentException;
+	else if ( recordSize <= 0 ) invalid = CBHEntrySizeException;
+
+	for (NSUInteger i = 0; i < columnCount && !invalid; ++i)
+	{
+		if ( columns[i].size <= 0 ) invalid = CBHEntrySizeException;
+		else if ( columns[i].offset > recordSize || columns[i].size > recordSize - columns[i].offset ) invalid = NSRangeException;
+	}
+
+	if ( invalid )
+	{
+		[self release];
+		@throw invalid;
+	}
+
+	if ( (self = [super init]) )
+	{
+		_columns = CBHMemory_copy(columns, columnCount, sizeof(CBHTableColumn));
+		_wedges = CBHMemory_calloc(columnCount, sizeof(CBHWedge *));
+		if ( !_columns || !_wedges )
+		{
+			[self release];
+			@throw CBHCallocException;
+		}
+
+		_columnCount = columnCount;
+
+		_recordSize = recordSize;
+		_count = 0;
+
+		for (NSUInteger i = 0; i < columnCount; ++i)
+		{
+			_wedges[i] = [[CBHWedge alloc] initWithEntrySize:columns[i].size andCapacity:capacity];
+		}
+	}
+
+	return self;
+}
+
+- (instancetype)initWithColumns:(const CBHTableColumn *)columns count:(NSUInteger)columnCount recordsFromWedge:(CBHWedge *)wedge
+{
+	if ( (self = [self initWithColumns:columns count:columnCount recordSize:[wedge entrySize] andCapacity:[wedge count]]) )
+	{
+		[self appendRecords:[wedge bytes] count:[wedge count]];
+	}
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	for (NSUInteger i = 0; i < _columnCount; ++i) { [_wedges[i] release]; }
+
+	CBHMemory_free(_wedges);
+	CBHMemory_free(_columns);
+
+	[super dealloc];
+}
+
+
+#pragma mark - Properties
+
+- (NSUInteger)count
+{
+	return _count;
+}
+
+- (NSUInteger)capacity
+{
+	/// Columns are always resized together.
+	return [_wedges[0] capacity];
+}
+
+- (BOOL)isEmpty
+{
+	return ( _count <= 0 );
+}
+
+- (NSUInteger)columnCount
+{
+	return _columnCount;
+}
+
+- (size_t)recordSize
+{
+	return _recordSize;
+}
+
+- (CBHTableColumn)columnAtIndex:(NSUInteger)column
+{
+	_checkColumn(column);
+	return _columns[column];
+}
+
+
+#pragma mark - Copying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	CBHTable *copy = [[CBHTable allocWithZone:zone] initWithColumns:_columns count:_columnCount recordSize:_recordSize];
+
+	/// The copied columns share their bytes until either side writes.
+	for (NSUInteger i = 0; i < _columnCount; ++i)
+	{
+		[copy->_wedges[i] release];
+		copy->_wedges[i] = [_wedges[i] copy];
+	}
+
+	copy->_count = _count;
+
+	return copy;
+}
+
+
+#pragma mark - Equality
+
+- (BOOL)isEqual:(id)other
+{
+	if ( [other isKindOfClass:[CBHTable class]] ) return [self isEqualToTable:other];
+	return [super isEqual:other];
+}
+
+- (BOOL)isEqualToTable:(CBHTable *)other
+{
+	/// Catch trivial cases.
+	if ( self == other ) return YES;
+	if ( _count != other->_count ) return NO;
+	if ( _recordSize != other->_recordSize ) return NO;
+	if ( _columnCount != other->_columnCount ) return NO;
+
+	/// Compare the layouts field by field, the structs may have padding.
+	for (NSUInteger i = 0; i < _columnCount; ++i)
+	{
+		if ( _columns[i].offset != other->_columns[i].offset ) return NO;
+		if ( _columns[i].size != other->_columns[i].size ) return NO;
+		if ( _columns[i].type != other->_columns[i].type ) return NO;
+	}
+
+	for (NSUInteger i = 0; i < _columnCount; ++i)
+	{
+		if ( ![_wedges[i] isEqualToWedge:other->_wedges[i]] ) return NO;
+	}
+
+	return YES;
+}
+
+- (NSUInteger)hash
+{
+	/// Mix in every column, so tables differing in any column are told apart.
+	uint64_t hash = _count;
+	for (NSUInteger i = 0; i < _columnCount; ++i) { hash = CBHHash_mix(hash ^ (uint64_t)[_wedges[i] hash], 0x9e3779b97f4a7c15ull); }
+
+	return (NSUInteger)hash;
+}
+
+
+#pragma mark - Resizing
+
+- (BOOL)shrink
+{
+	BOOL didResize = NO;
+	for (NSUInteger i = 0; i < _columnCount; ++i) { didResize = [_wedges[i] shrink] || didResize; }
+
+	return didResize;
+}
+
+- (BOOL)grow
+{
+	BOOL didResize = NO;
+	for (NSUInteger i = 0; i < _columnCount; ++i) { didResize = [_wedges[i] grow] || didResize; }
+
+	return didResize;
+}
+
+- (BOOL)growToFit:(NSUInteger)neededCapacity
+{
+	BOOL didResize = NO;
+	for (NSUInteger i = 0; i < _columnCount; ++i) { didResize = [_wedges[i] growToFit:neededCapacity] || didResize; }
+
+	return didResize;
+}
+
+- (BOOL)resize:(NSUInteger)newCapacity
+{
+	/// Prevent losing rows.
+	if ( newCapacity < _count ) return NO;
+
+	BOOL didResize = NO;
+	for (NSUInteger i = 0; i < _columnCount; ++i) { didResize = [_wedges[i] resize:newCapacity] || didResize; }
+
+	return didResize;
+}
+
+
+#pragma mark - Description
+
+- (NSString *)description
+{
+	NSMutableString *description = [NSMutableString stringWithString:@"("];
+
+	for (NSUInteger row = 0; row < _count; ++row)
+	{
+		[description appendString:@"\n\t("];
+
+		for (NSUInteger column = 0; column < _columnCount; ++column)
+		{
+			[description appendString:@"0x"];
+			const uint8_t *field = [_wedges[column] valueAtIndex:row];
+			for (NSUInteger j = _columns[column].size; j > 0; --j) { [description appendFormat:@"%02x", field[j - 1]]; }
+			if ( column != _columnCount - 1 ) { [description appendString:@", "]; }
+		}
+
+		[description appendString:@")"];
+		if ( row != _count - 1 ) { [description appendString:@","]; }
+	}
+
+	return [NSString stringWithFormat:@"%@\n)", description];
+}
+
+- (NSString *)debugDescription
+{
+	return [NSString stringWithFormat:@"<%@: %p> %lu columns %@", [self class], (void *)self, (unsigned long)_columnCount, [self description]];
+}
+
+
+#pragma mark - Fields
+
+- (const void *)valueAtRow:(NSUInteger)row column:(NSUInteger)column
+{
+	_checkColumn(column);
+	return [_wedges[column] valueAtIndex:row];
+}
+
+- (void)setValue:(const void *)value atRow:(NSUInteger)row column:(NSUInteger)column
+{
+	_checkColumn(column);
+	_checkReadableRow(row);
+
+	[_wedges[column] setValue:value atIndex:row];
+}
+
+
+#pragma mark - Records
+
+- (void)appendRecord:(const void *)record
+{
+	[self appendRecords:record count:1];
+}
+
+- (void)appendRecords:(const void *)records count:(NSUInteger)count
+{
+	_checkAppendable(count);
+	if ( count <= 0 ) return;
+
+	/// Grow every column first so no append can fail part way through a row.
+	[self growToFit:_count + count];
+
+	if ( count == 1 )
+	{
+		for (NSUInteger i = 0; i < _columnCount; ++i) { [_wedges[i] appendValue:(const uint8_t *)records + _columns[i].offset]; }
+
+		++_count;
+		return;
+	}
+
+	size_t widest = 0;
+	for (NSUInteger i = 0; i < _columnCount; ++i) { widest = MAX(widest, _columns[i].size); }
+
+	/// Split a chunk of records at a time, so the chunk is still cached while each column is taken from it.
+	uint8_t *buffer = CBHMemory_alloc(MIN(count, CHUNK_LENGTH), widest);
+	if ( !buffer ) @throw CBHCallocException;
+
+	const uint8_t *source = (const uint8_t *)records;
+
+	for (NSUInteger row = 0; row < count; row += CHUNK_LENGTH)
+	{
+		const NSUInteger length = MIN(CHUNK_LENGTH, count - row);
+		const uint8_t *chunk = source + (row * _recordSize);
+
+		for (NSUInteger i = 0; i < _columnCount; ++i)
+		{
+			CBHTable_copyStrided(buffer, _columns[i].size, chunk + _columns[i].offset, _recordSize, _columns[i].size, length);
+			[_wedges[i] appendValues:buffer count:length];
+		}
+	}
+
+	CBHMemory_free(buffer);
+	_count += count;
+}
+
+- (void)getRecord:(void *)record atRow:(NSUInteger)row
+{
+	[self getRecords:record range:NSMakeRange(row, 1)];
+}
+
+- (void)getRecords:(void *)records range:(NSRange)range
+{
+	_checkRange(range);
+
+	uint8_t *destination = (uint8_t *)records;
+
+	for (NSUInteger i = 0; i < _columnCount; ++i)
+	{
+		const uint8_t *source = (const uint8_t *)[_wedges[i] bytes] + (range.location * _columns[i].size);
+		CBHTable_copyStrided(destination + _columns[i].offset, _recordSize, source, _columns[i].size, _columns[i].size, range.length);
+	}
+}
+
+- (CBHWedge *)recordWedge
+{
+	/// Cleared so the bytes between fields are the same every time.
+	NSMutableData *data = [NSMutableData dataWithLength:_count * _recordSize];
+	[self getRecords:[data mutableBytes] range:NSMakeRange(0, _count)];
+
+	return [CBHWedge wedgeWithEntrySize:_recordSize adoptingData:data];
+}
+
+
+#pragma mark - Columns
+
+- (CBHWedge *)wedgeOfColumn:(NSUInteger)column
+{
+	_checkColumn(column);
+	return [[_wedges[column] copy] autorelease];
+}
+
+- (void)withUnsafeBytesOfColumn:(NSUInteger)column usingBlock:(void (NS_NOESCAPE ^)(CBHSliceView view))block
+{
+	_checkColumn(column);
+	[_wedges[column] withUnsafeBytes:block];
+}
+
+
+#pragma mark - Scanning
+
+- (void)validateScannableColumn:(NSUInteger)column
+{
+	_checkColumn(column);
+
+	const CBHSortKey_t key = {0, _columns[column].size, _columns[column].type};
+	CBHSortKey_validate(&key, _columns[column].size);
+}
+
+- (CBHBitSlice *)rowsOfColumn:(NSUInteger)column from:(const void *)low to:(const void *)high
+{
+	[self validateScannableColumn:column];
+
+	/// Bounds are mapped the same way as the values, so one unsigned comparison orders every type.
+	const CBHSortKey_t key = {0, _columns[column].size, _columns[column].type};
+	const uint64_t lowBits = CBHSortKey_bits(low, &key);
+	const uint64_t highBits = CBHSortKey_bits(high, &key);
+
+	if ( _count <= 0 || lowBits > highBits ) return [CBHBitSlice bitSliceWithCount:_count];
+
+	uint64_t *words = CBHMemory_alloc(_wordsFor(_count), sizeof(uint64_t));
+	if ( !words ) @throw CBHCallocException;
+
+	CBHTable_scan(&_columns[column], [_wedges[column] bytes], _count, lowBits, highBits, words);
+
+	CBHBitSlice *rows = [CBHBitSlice bitSliceWithCount:_count copyingWords:words];
+	CBHMemory_free(words);
+
+	return rows;
+}
+
+- (double)sumOfColumn:(NSUInteger)column inRows:(CBHBitSlice *)rows
+{
+	[self validateScannableColumn:column];
+
+	const NSUInteger count = ( rows ) ? MIN(_count, [rows count]) : _count;
+	if ( count <= 0 ) return 0;
+
+	return CBHTable_sum(&_columns[column], [_wedges[column] bytes], count, [rows bytes]);
+}
+
+
+#pragma mark - Removing
+
+- (void)removeAll
+{
+	for (NSUInteger i = 0; i < _columnCount; ++i) { [_wedges[i] removeAll]; }
+	_count = 0;
+}
+
+- (void)removeLast:(NSUInteger)count
+{
+	for (NSUInteger i = 0; i < _columnCount; ++i) { [_wedges[i] removeLast:count]; }
+	_count = ( count >= _count ) ? 0 : _count - count;
+}
+
+@end
@@ -20,6 +20,8 @@
 
 #import <CBHCollectionKit/CBHPrimitiveCollection.h>
 #import <CBHCollectionKit/CBHSlice.h>
+#import <CBHCollectionKit/CBHCollectionCoder.h>
+#import <CBHCollectionKit/CBHSliceView.h>
 
 
 NS_ASSUME_NONNULL_BEGIN
@@ -30,16 +32,19 @@ NS_ASSUME_NONNULL_BEGIN
  *
  * @author    Christian Huxtable <chris@huxtable.ca>
  */
-@interface CBHWedge : NSObject <NSCopying, CBHPrimitiveCollection, CBHCollectionResizable>
+@interface CBHWedge : NSObject <NSCopying, NSSecureCoding, CBHPrimitiveCollection, CBHCollectionResizable>
 
 #pragma mark - Factories
 
 + (instancetype)wedgeWithEntrySize:(size_t)entrySize;
 + (instancetype)wedgeWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity;
++ (instancetype)wedgeWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options;
 
 + (instancetype)wedgeWithEntrySize:(size_t)entrySize copying:(NSUInteger)count entriesFromBytes:(const void *)bytes;
 + (instancetype)wedgeWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity copying:(NSUInteger)count entriesFromBytes:(const void *)bytes;
 
++ (instancetype)wedgeWithEntrySize:(size_t)entrySize adoptingData:(NSData *)data;
+
 + (instancetype)wedgeWithSlice:(CBHSlice *)slice;
 + (instancetype)wedgeWithSlice:(CBHSlice *)slice andCapacity:(NSUInteger)capacity;
 
@@ -47,14 +52,49 @@ NS_ASSUME_NONNULL_BEGIN
 #pragma mark - Initialization
 
 - (instancetype)initWithEntrySize:(size_t)entrySize;
-- (instancetype)initWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+- (instancetype)initWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity;
+
+/** Initializes an empty wedge whose buffer is allocated as described by `options`.
+ *
+ * The options are kept for the life of the wedge, so growing and shrinking reallocate the buffer the same way.
+ *
+ * @param entrySize    The size of each entry in the wedge.
+ * @param capacity     The number of entries the wedge can hold before growing.
+ * @param options      The alignment and paging of the wedge's buffer.
+ *
+ * @return             An initialized empty wedge.
+ */
+- (instancetype)initWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options NS_DESIGNATED_INITIALIZER;
 
 - (instancetype)initWithEntrySize:(size_t)entrySize copying:(NSUInteger)count entriesFromBytes:(const void *)bytes;
 - (instancetype)initWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity copying:(NSUInteger)count entriesFromBytes:(const void *)bytes NS_DESIGNATED_INITIALIZER;
 
+/** Initializes a wedge with the contents of `data`.
+ *
+ * The bytes of an `NSMutableData` are adopted without copying and written through until the wedge first grows. Other data is copied.
+ *
+ * @param entrySize    The size of each entry in the wedge.
+ * @param data         The data to adopt. Its length must be a multiple of `entrySize`.
+ *
+ * @return             An initialized wedge with the contents of `data`.
+ *
+ * @note: An adopted `NSMutableData` is retained, but the caller must not change its length until the wedge has grown or been freed. Resizing the data can move its bytes and leave the wedge pointing at freed memory.
+ */
+- (instancetype)initWithEntrySize:(size_t)entrySize adoptingData:(NSData *)data;
+
 - (instancetype)initWithSlice:(CBHSlice *)slice;
 - (instancetype)initWithSlice:(CBHSlice *)slice andCapacity:(NSUInteger)capacity;
 
+/** Initializes a newly allocated wedge with the next collection read by `decoder`.
+ *
+ * @param decoder    The decoder to read from.
+ *
+ * @return           A newly initialized wedge, or `nil` if the collection could not be read. The reason is left in the decoder's `error`.
+ */
+- (nullable instancetype)initWithCollectionDecoder:(CBHCollectionDecoder *)decoder;
+
+- (nullable instancetype)initWithCoder:(NSCoder *)coder;
+
 
 #pragma mark - Properties
 
@@ -66,6 +106,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (nonatomic, readonly) const void *bytes;
 
+/** How the wedge's buffer is allocated. Wedges adopting data report the default options.
+ */
+@property (nonatomic, readonly) CBHAllocationOptions allocationOptions;
+
 
 #pragma mark - Copying
 
@@ -84,11 +128,25 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (NSData *)data;
 - (NSMutableData *)mutableData;
+- (NSData *)dataNoCopy;
 - (CBHSlice *)slice;
 
 - (NSString *)stringWithEncoding:(NSStringEncoding)encoding;
 
 
+#pragma mark - Serialization
+
+/** Writes the entries of the receiver to `encoder` in the binary collection format. Unused capacity is not written.
+ *
+ * @param encoder    The encoder to write to.
+ *
+ * @return           `YES` if the receiver was written, otherwise `NO`. The reason is left in the encoder's `error`.
+ */
+- (BOOL)encodeWithCollectionEncoder:(CBHCollectionEncoder *)encoder;
+
+- (void)encodeWithCoder:(NSCoder *)coder;
+
+
 #pragma mark - Resizing
 
 - (BOOL)shrink;
@@ -120,6 +178,12 @@ NS_ASSUME_NONNULL_BEGIN
 - (NSString *)debugDescription;
 
 
+#pragma mark - Unsafe Access
+
+- (void)withUnsafeBytes:(void (NS_NOESCAPE ^)(CBHSliceView view))block;
+- (void)withUnsafeMutableBytes:(void (NS_NOESCAPE ^)(CBHMutableSliceView view))block;
+
+
 #pragma mark - Generic Operations
 
 - (const void *)valueAtIndex:(NSUInteger)index;
@@ -128,6 +192,16 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)setValue:(const void *)value atIndex:(NSUInteger)index;
 
 
+#pragma mark - Bulk Operations
+
+- (void)appendValues:(const void *)values count:(NSUInteger)count;
+- (void)appendData:(NSData *)data;
+- (void)appendWedge:(CBHWedge *)wedge;
+- (void)appendSlice:(CBHSlice *)slice range:(NSRange)range;
+
+- (void)insertValues:(const void *)values count:(NSUInteger)count atIndex:(NSUInteger)index;
+
+
 #pragma mark - Unavailable
 
 - (instancetype)init NS_UNAVAILABLE;
@@ -246,6 +320,113 @@ NS_ASSUME_NONNULL_BEGIN
 @end
 
 
+#pragma mark - Sorting
+
+@interface CBHWedge (Sorting)
+
+/** Sorts the entries of the receiver in ascending order by interpreting each whole entry as a value of the given type.
+ *
+ * Integer entries are sorted with an in-place radix sort. Large collections are sorted concurrently.
+ *
+ * @param type    How to interpret each entry. The entry size must be 1, 2, 4, or 8 bytes (4 or 8 for `CBHPrimitiveTypeFloat`).
+ */
+- (void)sortAsType:(CBHPrimitiveType)type;
+
+/** Sorts the entries of the receiver in ascending order by a key stored within each entry.
+ *
+ * @param offset    The byte offset of the key within an entry.
+ * @param size      The width of the key in bytes. Must be 1, 2, 4, or 8 (4 or 8 for `CBHPrimitiveTypeFloat`).
+ * @param type      How to interpret the key.
+ */
+- (void)sortByKeyAtOffset:(size_t)offset ofSize:(size_t)size asType:(CBHPrimitiveType)type;
+
+/** Sorts the entries of the receiver using a comparison function.
+ *
+ * Uses a pattern-defeating introsort. The sort is not stable.
+ *
+ * @param comparator    The function used to order two entries.
+ * @param context       A pointer passed through to the comparator.
+ */
+- (void)sortUsingFunction:(CBHPrimitiveComparator)comparator context:(nullable void *)context;
+
+@end
+
+
+#pragma mark - Parallel Operations
+
+@interface CBHWedge (ParallelOperations)
+
+/** Sets every entry of the receiver to the same value.
+ *
+ * The count is unchanged. Large wedges are filled concurrently.
+ *
+ * @param value    A pointer to the entry to copy into every index.
+ */
+- (void)fillWithValue:(const void *)value;
+
+/** Rewrites the entries of the receiver in place using a function.
+ *
+ * Large wedges are split into cache sized chunks which are transformed concurrently across all available cores.
+ *
+ * @param function    The function used to rewrite each run of entries.
+ * @param context     A pointer passed through to the function.
+ */
+- (void)transformUsingFunction:(CBHPrimitiveTransform)function context:(nullable void *)context;
+
+/** Folds every entry of the receiver into a single entry.
+ *
+ * Large wedges are split into cache sized chunks which are reduced concurrently across all available cores.
+ *
+ * @param function    The associative function used to fold runs of entries.
+ * @param identity    A pointer to an entry which leaves any entry unchanged when folded with it.
+ * @param context     A pointer passed through to the function.
+ * @param result      A pointer to an entry sized buffer which receives the result.
+ */
+- (void)reduceUsingFunction:(CBHPrimitiveReducer)function identity:(const void *)identity context:(nullable void *)context result:(void *)result;
+
+/** Calls a block with each cache sized chunk of the receiver's entries.
+ *
+ * Large wedges are visited concurrently, so the block may be called from several threads at once and in any order. The receiver must not be mutated from within the block.
+ *
+ * @param block    The block to call with a pointer to the first entry of a chunk and the chunk's range of indices.
+ */
+- (void)forEachChunk:(void (NS_NOESCAPE ^)(const void *entries, NSRange range))block;
+
+@end
+
+
+#pragma mark - Enumeration
+
+@interface CBHWedge (Enumeration)
+
+/** Calls a block with a pointer to each entry of the receiver, in order.
+ *
+ * The receiver must not be mutated from within the block.
+ *
+ * @param block    The block to call with a pointer to an entry, the entry's index, and a flag which stops the enumeration when set to `YES`.
+ */
+- (void)enumerateValuesUsingBlock:(void (NS_NOESCAPE ^)(const void *value, NSUInteger index, BOOL *stop))block;
+
+/** Calls a block with a pointer to each entry of the receiver, as described by `options`.
+ *
+ * With `NSEnumerationConcurrent` the entries are split into chunks which are enumerated concurrently, so the block may be called from several threads at once and in any order. With `NSEnumerationReverse` the entries, or the entries within each chunk, are visited from the last.
+ *
+ * @param options    The options for the enumeration.
+ * @param block      The block to call with a pointer to an entry, the entry's index, and a flag which stops the enumeration when set to `YES`.
+ */
+- (void)enumerateValuesWithOptions:(NSEnumerationOptions)options usingBlock:(void (NS_NOESCAPE ^)(const void *value, NSUInteger index, BOOL *stop))block;
+
+/** Calls a block with a pointer to each entry of the receiver within a range, as described by `options`.
+ *
+ * @param range      The range of entries to enumerate. Raises an `NSRangeException` if it extends past the count.
+ * @param options    The options for the enumeration, as for `enumerateValuesWithOptions:usingBlock:`.
+ * @param block      The block to call with a pointer to an entry, the entry's index, and a flag which stops the enumeration when set to `YES`.
+ */
+- (void)enumerateValuesInRange:(NSRange)range options:(NSEnumerationOptions)options usingBlock:(void (NS_NOESCAPE ^)(const void *value, NSUInteger index, BOOL *stop))block;
+
+@end
+
+
 #pragma mark - Wedge from Slice
 
 @interface CBHSlice (Wedge)
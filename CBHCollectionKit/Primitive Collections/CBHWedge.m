@@ -18,19 +18,30 @@
 
 #import "CBHWedge.h"
 #import "_CBHStack.h"
+#import "_CBHBuffer.h"
+#import "_CBHReuse.h"
+#import "_CBHSort.h"
+#import "_CBHHash.h"
+#import "_CBHParallel.h"
 
 @import CBHMemoryKit;
 
 
 #define DEFAULT_CAPACITY 8
+#define CODER_KEY @"CBHCollection"
 #define GROWTH_FACTOR 1.618033988749895
 
 #define _checkEntrySize(aType) if (_stack._entrySize != sizeof(aType)) @throw CBHEntrySizeException
 #define _checkSettableIndex(anIndex) if ( (anIndex) > _stack._count ) @throw NSRangeException
 #define _checkReadableIndex(anIndex) if ( (anIndex) >= _stack._count ) @throw NSRangeException
+#define _checkAppendable(aCount) if ( (aCount) > NSUIntegerMax - _stack._count ) @throw NSRangeException
 
+#define _pointerToIndex(anIndex) ((uint8_t *)_stack._data + ((anIndex) * _stack._entrySize))
+#define _isInStorage(aPointer) ( (uintptr_t)(aPointer) >= (uintptr_t)_stack._data && (uintptr_t)(aPointer) - (uintptr_t)_stack._data < _stack._capacity * _stack._entrySize )
 #define _typeAtIndex(aType, anIndex) *((aType *)CBHSlice_pointerToOffset((CBHSlice_t *)&_stack, (anIndex)))
 
+#define _makeUnique() CBHSlice_makeUnique((CBHSlice_t *)&_stack)
+
 #define _nextCapacity(aCapacity) (size_t)ceil((double)(aCapacity) * GROWTH_FACTOR)
 #define _growIfNeeded() if ( _stack._capacity <= _stack._count ) { CBHStack_setCapacity(&_stack, _nextCapacity(_stack._capacity)); }
 
@@ -58,6 +69,9 @@
 	CBHStack_t _stack;
 }
 
+/// Takes over an initialized stack.
+- (instancetype)initWithStack:(CBHStack_t)stack NS_DESIGNATED_INITIALIZER;
+
 @end
 
 
@@ -75,6 +89,11 @@
 	return [[(CBHWedge *)[self alloc] initWithEntrySize:entrySize andCapacity:capacity] autorelease];
 }
 
++ (instancetype)wedgeWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options
+{
+	return [[(CBHWedge *)[self alloc] initWithEntrySize:entrySize andCapacity:capacity options:options] autorelease];
+}
+
 + (instancetype)wedgeWithEntrySize:(size_t)entrySize copying:(NSUInteger)count entriesFromBytes:(const void *)bytes
 {
 	return [[(CBHWedge *)[self alloc] initWithEntrySize:entrySize copying:count entriesFromBytes:bytes] autorelease];
@@ -85,6 +104,11 @@
 	return [[(CBHWedge *)[self alloc] initWithEntrySize:entrySize andCapacity:capacity copying:count entriesFromBytes:bytes] autorelease];
 }
 
++ (instancetype)wedgeWithEntrySize:(size_t)entrySize adoptingData:(NSData *)data
+{
+	return [[(CBHWedge *)[self alloc] initWithEntrySize:entrySize adoptingData:data] autorelease];
+}
+
 
 + (instancetype)wedgeWithSlice:(CBHSlice *)slice
 {
@@ -97,6 +121,15 @@
 }
 
 
+#pragma mark - Allocation
+
++ (instancetype)allocWithZone:(NSZone *)zone
+{
+	/// Small collections keep their entries inside the object rather than allocating a buffer.
+	return CBHBuffer_allocInlineObject(self);
+}
+
+
 #pragma mark - Initialization
 
 - (instancetype)initWithEntrySize:(size_t)entrySize
@@ -105,10 +138,15 @@
 }
 
 - (instancetype)initWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity
+{
+	return [self initWithEntrySize:entrySize andCapacity:capacity options:CBHAllocationOptionsDefault];
+}
+
+- (instancetype)initWithEntrySize:(size_t)entrySize andCapacity:(NSUInteger)capacity options:(CBHAllocationOptions)options
 {
 	if ( (self = [super init]) )
 	{
-		_stack = CBHStack_init(capacity, entrySize);
+		_stack = CBHStack_initInline(CBHBuffer_inlineBytes(self), capacity, entrySize, &options);
 	}
 
 	return self;
@@ -132,6 +170,35 @@
 	return self;
 }
 
+- (instancetype)initWithStack:(CBHStack_t)stack
+{
+	if ( (self = [super init]) )
+	{
+		_stack = stack;
+	}
+
+	return self;
+}
+
+- (instancetype)initWithEntrySize:(size_t)entrySize adoptingData:(NSData *)data
+{
+	if ( entrySize <= 0 || [data length] % entrySize != 0 )
+	{
+		[self release];
+		@throw CBHEntrySizeException;
+	}
+
+	/// Only mutable data can be written through, copy anything else.
+	if ( ![data isKindOfClass:[NSMutableData class]] )
+	{
+		return [self initWithEntrySize:entrySize copying:[data length] / entrySize entriesFromBytes:[data bytes]];
+	}
+
+	NSMutableData *mutableData = (NSMutableData *)data;
+	const NSUInteger count = [mutableData length] / entrySize;
+	return [self initWithStack:CBHStack_initBorrowingBytes([mutableData mutableBytes], entrySize, count, count, mutableData)];
+}
+
 - (instancetype)initWithSlice:(CBHSlice *)slice
 {
 	return [self initWithEntrySize:[slice entrySize] copying:[slice capacity] entriesFromBytes:[slice bytes]];
@@ -142,6 +209,52 @@
 	return [self initWithEntrySize:[slice entrySize] andCapacity:capacity copying:[slice capacity] entriesFromBytes:[slice bytes]];
 }
 
+- (instancetype)initWithCollectionDecoder:(CBHCollectionDecoder *)decoder
+{
+	NSUInteger count = 0;
+	size_t entrySize = 0;
+
+	if ( ![decoder decodeEntryCount:&count entrySize:&entrySize] )
+	{
+		[self release];
+		return nil;
+	}
+
+	if ( (self = [self initWithEntrySize:entrySize andCapacity:MIN(count ?: DEFAULT_CAPACITY, DEFAULT_CAPACITY)]) )
+	{
+		const BOOL didDecode = [decoder decodeEntriesReserving:^void *(NSUInteger capacity) {
+			if ( capacity > self->_stack._capacity ) CBHStack_setCapacity(&self->_stack, capacity);
+			return self->_stack._data;
+		}];
+
+		if ( !didDecode )
+		{
+			[self release];
+			return nil;
+		}
+
+		_stack._count = count;
+	}
+
+	return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)coder
+{
+	NSUInteger length = 0;
+	const uint8_t *bytes = [coder decodeBytesForKey:CODER_KEY returnedLength:&length];
+
+	NSData *data = [[NSData alloc] initWithBytesNoCopy:(void *)bytes length:length freeWhenDone:NO];
+	CBHCollectionDecoder *decoder = [[CBHCollectionDecoder alloc] initWithData:data];
+
+	self = [self initWithCollectionDecoder:decoder];
+
+	[decoder release];
+	[data release];
+
+	return self;
+}
+
 
 #pragma mark - Destructor
 
@@ -180,12 +293,18 @@
 	return _stack._data;
 }
 
+- (CBHAllocationOptions)allocationOptions
+{
+	return _stack._options;
+}
+
 
 #pragma mark - Copying
 
 - (id)copyWithZone:(NSZone *)zone
 {
-	return [[CBHWedge allocWithZone:zone] initWithEntrySize:_stack._entrySize andCapacity:_stack._capacity copying:_stack._count entriesFromBytes:_stack._data];
+	/// Shares the bytes, whichever wedge is written to first copies them.
+	return [[CBHWedge allocWithZone:zone] initWithStack:CBHStack_initSharing(&_stack)];
 }
 
 
@@ -211,30 +330,8 @@
 
 - (NSUInteger)hash
 {
-	/// Mix in properties.
-	NSUInteger hash = ((_stack._capacity * 3) ^ (_stack._entrySize * 7) * 31);
-	const NSUInteger byteCount = _stack._capacity * _stack._entrySize;
-
-	/// XOR in middle 32/64 bits.
-	if ( byteCount >= (sizeof(NSUInteger) + sizeof(NSUInteger) + sizeof(NSUInteger)) )
-	{
-		size_t middle = (size_t)((byteCount % sizeof(NSUInteger)) / 2.0) * sizeof(NSUInteger);
-		hash ^= (*(NSUInteger *)((size_t)_stack._data + middle)) * 71;
-	}
-
-	/// XOR in last 32/64 bits.
-	if ( byteCount >= (sizeof(NSUInteger) + sizeof(NSUInteger)) )
-	{
-		hash ^= (*(NSUInteger *)((size_t)_stack._data + (byteCount - sizeof(NSUInteger)))) * 61;
-	}
-
-	/// XOR in first 32/64 bits.
-	if ( byteCount >= sizeof(NSUInteger) )
-	{
-		hash ^= (*(NSUInteger *)_stack._data) * 41;
-	}
-
-	return hash;
+	/// Hash every entry, the same entries hash the same whatever the capacity.
+	return (NSUInteger)CBHHash(_stack._data, _stack._count * _stack._entrySize, _stack._entrySize);
 }
 
 
@@ -268,12 +365,23 @@
 
 - (NSData *)data
 {
-	return [NSData dataWithBytes:_stack._data length:_stack._capacity];
+	return [NSData dataWithBytes:_stack._data length:_stack._count * _stack._entrySize];
 }
 
 - (NSMutableData *)mutableData
 {
-	return [NSMutableData dataWithBytes:_stack._data length:_stack._capacity];
+	return [NSMutableData dataWithBytes:_stack._data length:_stack._count * _stack._entrySize];
+}
+
+- (NSData *)dataNoCopy
+{
+	/// Keep the bytes alive rather than the receiver, which copies away from shared bytes before writing.
+	id owner = CBHSlice_shareStorage((CBHSlice_t *)&_stack) ?: _stack._owner;
+	[owner retain];
+
+	return [[[NSData alloc] initWithBytesNoCopy:_stack._data length:_stack._count * _stack._entrySize deallocator:^(void *bytes, NSUInteger length) {
+		[owner release];
+	}] autorelease];
 }
 
 - (CBHSlice *)slice
@@ -284,7 +392,31 @@
 
 - (NSString *)stringWithEncoding:(NSStringEncoding)encoding
 {
-	return [[[NSString alloc] initWithBytes:_stack._data length:_stack._count encoding:encoding] autorelease];
+	return [[[NSString alloc] initWithBytes:_stack._data length:_stack._count * _stack._entrySize encoding:encoding] autorelease];
+}
+
+
+#pragma mark - Serialization
+
++ (BOOL)supportsSecureCoding
+{
+	return YES;
+}
+
+- (BOOL)encodeWithCollectionEncoder:(CBHCollectionEncoder *)encoder
+{
+	return [encoder encodeEntries:_stack._data entrySize:_stack._entrySize count:_stack._count];
+}
+
+- (void)encodeWithCoder:(NSCoder *)coder
+{
+	NSMutableData *data = [NSMutableData dataWithCapacity:sizeof(CBHCollectionHeader) + (_stack._count * _stack._entrySize)];
+
+	CBHCollectionEncoder *encoder = [[CBHCollectionEncoder alloc] initWithMutableData:data];
+	[self encodeWithCollectionEncoder:encoder];
+	[encoder release];
+
+	[coder encodeBytes:[data bytes] length:[data length] forKey:CODER_KEY];
 }
 
 
@@ -317,7 +449,7 @@
 	if ( neededCapacity <= _stack._capacity ) return NO;
 
 	/// Find new capacity which fits the needed capacity.
-	NSUInteger nextCapacity = _stack._capacity;
+	NSUInteger nextCapacity = ( _stack._capacity > 0 ) ? _stack._capacity : 1;
 	while ( neededCapacity > nextCapacity ) { nextCapacity = _nextCapacity(nextCapacity); }
 
 	/// Grow.
@@ -382,6 +514,23 @@
 }
 
 
+#pragma mark - Unsafe Access
+
+- (void)withUnsafeBytes:(void (NS_NOESCAPE ^)(CBHSliceView view))block
+{
+	CBHSliceView view = {_stack._data, _stack._count, _stack._entrySize, &_stack._generation, _stack._generation};
+	block(view);
+}
+
+- (void)withUnsafeMutableBytes:(void (NS_NOESCAPE ^)(CBHMutableSliceView view))block
+{
+	_makeUnique();
+
+	CBHMutableSliceView view = {_stack._data, _stack._count, _stack._entrySize, &_stack._generation, _stack._generation};
+	block(view);
+}
+
+
 #pragma mark - Generic Accessors
 
 - (const void *)valueAtIndex:(NSUInteger)index
@@ -400,6 +549,90 @@
 	_setValueAtIndex(value, index);
 }
 
+
+#pragma mark - Bulk Operations
+
+- (void)appendValues:(const void *)values count:(NSUInteger)count
+{
+	if ( count <= 0 ) return;
+	_checkAppendable(count);
+
+	/// The values may lie within the receiver, whose storage can move as it grows. Find them again by their offset.
+	const BOOL isInStorage = _isInStorage(values);
+	const uintptr_t offset = (uintptr_t)values - (uintptr_t)_stack._data;
+
+	[self growToFit:_stack._count + count];
+	_makeUnique();
+
+	if ( isInStorage ) { values = (const uint8_t *)_stack._data + offset; }
+
+	CBHMemory_copyTo(values, _pointerToIndex(_stack._count), count, _stack._entrySize);
+	_stack._count += count;
+}
+
+- (void)appendData:(NSData *)data
+{
+	const NSUInteger length = [data length];
+	if ( length % _stack._entrySize != 0 ) @throw CBHEntrySizeException;
+
+	[self appendValues:[data bytes] count:length / _stack._entrySize];
+}
+
+- (void)appendWedge:(CBHWedge *)wedge
+{
+	if ( wedge->_stack._entrySize != _stack._entrySize ) @throw CBHEntrySizeException;
+
+	const NSUInteger count = wedge->_stack._count;
+	if ( count <= 0 ) return;
+	_checkAppendable(count);
+
+	/// Grow before taking the source pointer, the wedge may be the receiver.
+	[self growToFit:_stack._count + count];
+	_makeUnique();
+
+	CBHMemory_copyTo(wedge->_stack._data, _pointerToIndex(_stack._count), count, _stack._entrySize);
+	_stack._count += count;
+}
+
+- (void)appendSlice:(CBHSlice *)slice range:(NSRange)range
+{
+	if ( [slice entrySize] != _stack._entrySize ) @throw CBHEntrySizeException;
+
+	const NSUInteger capacity = [slice capacity];
+	if ( range.location > capacity || range.length > capacity - range.location ) @throw NSRangeException;
+
+	[self appendValues:(const uint8_t *)[slice bytes] + (range.location * _stack._entrySize) count:range.length];
+}
+
+
+- (void)insertValues:(const void *)values count:(NSUInteger)count atIndex:(NSUInteger)index
+{
+	_checkSettableIndex(index);
+	if ( count <= 0 ) return;
+	_checkAppendable(count);
+
+	/// Values within the receiver would move with the storage or the gap, copy them out first.
+	void *copy = NULL;
+	if ( _isInStorage(values) )
+	{
+		copy = CBHMemory_copy(values, count, _stack._entrySize);
+		if ( !copy ) @throw CBHCallocException;
+		values = copy;
+	}
+
+	[self growToFit:_stack._count + count];
+	_makeUnique();
+
+	/// Open a gap and fill it.
+	uint8_t *gap = _pointerToIndex(index);
+	memmove(gap + (count * _stack._entrySize), gap, (_stack._count - index) * _stack._entrySize);
+	CBHMemory_copyTo(values, gap, count, _stack._entrySize);
+
+	_stack._count += count;
+
+	if ( copy ) { CBHMemory_free(copy); }
+}
+
 @end
 
 
@@ -813,6 +1046,86 @@
 @end
 
 
+#pragma mark - Sorting
+
+@implementation CBHWedge (Sorting)
+
+- (void)sortAsType:(CBHPrimitiveType)type
+{
+	_makeUnique();
+	CBHSort_sortByKey(_stack._data, _stack._count, _stack._entrySize, 0, _stack._entrySize, type);
+}
+
+- (void)sortByKeyAtOffset:(size_t)offset ofSize:(size_t)size asType:(CBHPrimitiveType)type
+{
+	_makeUnique();
+	CBHSort_sortByKey(_stack._data, _stack._count, _stack._entrySize, offset, size, type);
+}
+
+- (void)sortUsingFunction:(CBHPrimitiveComparator)comparator context:(void *)context
+{
+	_makeUnique();
+	CBHSort_sortUsingComparator(_stack._data, _stack._count, _stack._entrySize, comparator, context);
+}
+
+@end
+
+
+#pragma mark - Parallel Operations
+
+@implementation CBHWedge (ParallelOperations)
+
+- (void)fillWithValue:(const void *)value
+{
+	_makeUnique();
+	CBHParallel_fill(_stack._data, _stack._count, _stack._entrySize, value);
+}
+
+- (void)transformUsingFunction:(CBHPrimitiveTransform)function context:(void *)context
+{
+	_makeUnique();
+	CBHParallel_transform(_stack._data, _stack._count, _stack._entrySize, function, context);
+}
+
+- (void)reduceUsingFunction:(CBHPrimitiveReducer)function identity:(const void *)identity context:(void *)context result:(void *)result
+{
+	CBHParallel_reduce(_stack._data, _stack._count, _stack._entrySize, function, context, identity, result);
+}
+
+- (void)forEachChunk:(void (NS_NOESCAPE ^)(const void *entries, NSRange range))block
+{
+	CBHParallel_forEachChunk(_stack._data, _stack._count, _stack._entrySize, block);
+}
+
+@end
+
+
+#pragma mark - Enumeration
+
+@implementation CBHWedge (Enumeration)
+
+- (void)enumerateValuesUsingBlock:(void (NS_NOESCAPE ^)(const void *value, NSUInteger index, BOOL *stop))block
+{
+	CBHParallel_enumerate(_stack._data, _stack._count, _stack._entrySize, 0, 0, block);
+}
+
+- (void)enumerateValuesWithOptions:(NSEnumerationOptions)options usingBlock:(void (NS_NOESCAPE ^)(const void *value, NSUInteger index, BOOL *stop))block
+{
+	CBHParallel_enumerate(_stack._data, _stack._count, _stack._entrySize, 0, options, block);
+}
+
+- (void)enumerateValuesInRange:(NSRange)range options:(NSEnumerationOptions)options usingBlock:(void (NS_NOESCAPE ^)(const void *value, NSUInteger index, BOOL *stop))block
+{
+	const NSUInteger count = _stack._count;
+	if ( range.location > count || range.length > count - range.location ) @throw NSRangeException;
+
+	const void *data = (const uint8_t *)_stack._data + (range.location * _stack._entrySize);
+	CBHParallel_enumerate(data, range.length, _stack._entrySize, range.location, options, block);
+}
+
+@end
+
+
 #pragma mark - Wedge from Slice
 
 @implementation CBHSlice (Wedge)
@@ -823,3 +1136,21 @@
 }
 
 @end
+
+
+#pragma mark - Reuse
+
+@implementation CBHWedge (Reuse)
+
+- (BOOL)isReusable
+{
+	return ( !_stack._owner && !_stack._options.allocator );
+}
+
+- (size_t)reusableLength
+{
+	const size_t bufferLength = ( _stack._isInline ) ? 0 : _stack._capacity * _stack._entrySize;
+	return CBHBuffer_inlineObjectSize([self class]) + bufferLength;
+}
+
+@end
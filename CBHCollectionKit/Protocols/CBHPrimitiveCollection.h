@@ -33,6 +33,50 @@ NS_ASSUME_NONNULL_BEGIN
 @end
 
 
+#pragma mark - Primitive Types
+
+/** How the bytes of an entry, or of a key within an entry, are interpreted when ordering by value.
+ *
+ * Keys are read in host byte order and may be 1, 2, 4, or 8 bytes wide. `CBHPrimitiveTypeFloat` keys must be 4 or 8 bytes wide and are ordered by their IEEE-754 total order, so `-0.0` sorts before `+0.0`.
+ */
+typedef NS_ENUM(NSUInteger, CBHPrimitiveType) {
+	CBHPrimitiveTypeUnsigned = 0,
+	CBHPrimitiveTypeSigned,
+	CBHPrimitiveTypeFloat,
+};
+
+/** A function which orders two entries of a primitive collection.
+ *
+ * @param a          A pointer to the first entry.
+ * @param b          A pointer to the second entry.
+ * @param context    The context pointer supplied alongside the function.
+ *
+ * @return           `NSOrderedAscending` if `a` belongs before `b`, `NSOrderedDescending` if after, otherwise `NSOrderedSame`.
+ */
+typedef NSComparisonResult (*CBHPrimitiveComparator)(const void *a, const void *b, void * _Nullable context);
+
+/** A function which rewrites a contiguous run of entries of a primitive collection in place.
+ *
+ * The function is handed runs rather than single entries so the loop over them can be vectorized. Runs may be transformed concurrently and in any order.
+ *
+ * @param entries    A pointer to the first entry of the run.
+ * @param count      The number of entries in the run.
+ * @param context    The context pointer supplied alongside the function.
+ */
+typedef void (*CBHPrimitiveTransform)(void *entries, NSUInteger count, void * _Nullable context);
+
+/** A function which folds a contiguous run of entries of a primitive collection into an accumulator.
+ *
+ * The accumulator is one entry wide. Runs may be reduced concurrently, each from the identity, and the partial results are then reduced by the same function, so it must be associative.
+ *
+ * @param accumulator    A pointer to the entry to fold the run into.
+ * @param entries        A pointer to the first entry of the run.
+ * @param count          The number of entries in the run.
+ * @param context        The context pointer supplied alongside the function.
+ */
+typedef void (*CBHPrimitiveReducer)(void *accumulator, const void *entries, NSUInteger count, void * _Nullable context);
+
+
 #pragma mark - Exceptions
 
 extern const NSExceptionName CBHEntrySizeException;
@@ -0,0 +1,251 @@
+//  CBHCollectionCoder.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import <CBHCollectionKit/CBHCollectionFormat.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class CBHCollectionEncoder;
+@class CBHCollectionDecoder;
+
+
+#pragma mark - Object Codec Protocol
+
+/** Writes and reads the objects of an object collection.
+ *
+ * A codec writes each object with the encoder's `write` methods and must read back exactly what it wrote.
+ */
+@protocol CBHObjectCodec <NSObject>
+@required
+
+/** Writes `object` to `encoder`.
+ *
+ * @param object     The object to write.
+ * @param encoder    The encoder to write to.
+ *
+ * @return           `YES` if the object was written, otherwise `NO`.
+ */
+- (BOOL)encodeObject:(id)object withEncoder:(CBHCollectionEncoder *)encoder;
+
+/** Reads an object written by `encodeObject:withEncoder:` from `decoder`.
+ *
+ * @param decoder    The decoder to read from.
+ *
+ * @return           The object read, or `nil` if it could not be read.
+ */
+- (nullable id)decodeObjectWithDecoder:(CBHCollectionDecoder *)decoder;
+
+@end
+
+
+#pragma mark - Encoder
+
+/** Writes collections in the binary format described by `CBHCollectionHeader`.
+ *
+ * Writes are gathered into a fixed buffer and written in chunks, large runs of entries are written straight from the collection. The header of an object collection is rewritten with its checksum once its objects are written, which is skipped when writing to a pipe or socket.
+ *
+ * @author    Christian Huxtable <chris@huxtable.ca>
+ */
+@interface CBHCollectionEncoder : NSObject
+
+#pragma mark - Initialization
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/** Initializes a newly allocated encoder which writes to a file descriptor.
+ *
+ * @param fd    An open file descriptor. It is not closed by the encoder.
+ *
+ * @return      A newly initialized encoder.
+ */
+- (instancetype)initWithFileDescriptor:(int)fd NS_DESIGNATED_INITIALIZER;
+
+/** Initializes a newly allocated encoder which appends to `data`.
+ *
+ * @param data    The data to append to.
+ *
+ * @return        A newly initialized encoder.
+ */
+- (instancetype)initWithMutableData:(NSMutableData *)data NS_DESIGNATED_INITIALIZER;
+
+
+#pragma mark - Properties
+
+/** The reason the last write failed, or `nil`.
+ */
+@property (nonatomic, readonly, nullable) NSError *error;
+
+
+#pragma mark - Primitive Collections
+
+/** Writes a header followed by `count` entries of `entrySize` from `bytes`.
+ *
+ * @param bytes        A pointer to the first entry.
+ * @param entrySize    The size of each entry.
+ * @param count        The number of entries.
+ *
+ * @return             `YES` if the entries were written, otherwise `NO`.
+ */
+- (BOOL)encodeEntries:(const void *)bytes entrySize:(size_t)entrySize count:(NSUInteger)count;
+
+
+#pragma mark - Object Collections
+
+/** Writes the header of an object collection. Exactly `count` objects must follow before `endObjects`.
+ *
+ * @param count    The number of objects which will follow.
+ *
+ * @return         `YES` if the header was written, otherwise `NO`.
+ */
+- (BOOL)beginObjects:(NSUInteger)count;
+
+/** Writes an object with `codec`.
+ *
+ * @param object    The object to write.
+ * @param codec     The codec to write it with.
+ *
+ * @return          `YES` if the object was written, otherwise `NO`.
+ */
+- (BOOL)encodeObject:(id)object withCodec:(id<CBHObjectCodec>)codec;
+
+/** Finishes an object collection and records its checksum.
+ *
+ * @return    `YES` if the collection was finished, otherwise `NO`.
+ */
+- (BOOL)endObjects;
+
+
+#pragma mark - Writing
+
+/** Writes `length` bytes. For use by codecs. */
+- (BOOL)writeBytes:(const void *)bytes length:(size_t)length;
+
+/** Writes a 64 bit integer in the host's byte order. For use by codecs. */
+- (BOOL)writeUInt64:(uint64_t)value;
+
+/** Writes any buffered bytes.
+ *
+ * @return    `YES` if the bytes were written, otherwise `NO`.
+ */
+- (BOOL)flush;
+
+@end
+
+
+#pragma mark - Decoder
+
+/** Reads collections in the binary format described by `CBHCollectionHeader`.
+ *
+ * Reads are made in chunks through a fixed buffer, large runs of entries are read straight into the collection. Checksums are verified once all entries are read.
+ *
+ * @author    Christian Huxtable <chris@huxtable.ca>
+ */
+@interface CBHCollectionDecoder : NSObject
+
+#pragma mark - Initialization
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/** Initializes a newly allocated decoder which reads from a file descriptor.
+ *
+ * @param fd    An open file descriptor. It is not closed by the decoder.
+ *
+ * @return      A newly initialized decoder.
+ */
+- (instancetype)initWithFileDescriptor:(int)fd NS_DESIGNATED_INITIALIZER;
+
+/** Initializes a newly allocated decoder which reads from `data`.
+ *
+ * @param data    The data to read.
+ *
+ * @return        A newly initialized decoder.
+ */
+- (instancetype)initWithData:(NSData *)data NS_DESIGNATED_INITIALIZER;
+
+
+#pragma mark - Properties
+
+/** The reason the last read failed, or `nil`.
+ */
+@property (nonatomic, readonly, nullable) NSError *error;
+
+
+#pragma mark - Primitive Collections
+
+/** Reads the header of a primitive collection.
+ *
+ * @param count        On return, the number of entries.
+ * @param entrySize    On return, the size of each entry.
+ *
+ * @return             `YES` if a valid header was read, otherwise `NO`.
+ */
+- (BOOL)decodeEntryCount:(NSUInteger *)count entrySize:(size_t *)entrySize;
+
+/** Reads the entries described by the last header and verifies their checksum.
+ *
+ * When the length of the source is unknown, as for pipes and sockets, the count in the header is not trusted with a single allocation. Room is reserved for a modest number of entries first and grows as they arrive, so a corrupt count fails at the end of the stream instead.
+ *
+ * @param reserve    A block which makes room for at least `capacity` entries and returns a pointer to the first. Entries already read must be kept, it is called with a growing capacity until the last one is reached.
+ *
+ * @return           `YES` if the entries were read, otherwise `NO`.
+ */
+- (BOOL)decodeEntriesReserving:(void * _Nonnull (NS_NOESCAPE ^)(NSUInteger capacity))reserve;
+
+
+#pragma mark - Object Collections
+
+/** Reads the header of an object collection.
+ *
+ * @param count    On return, the number of objects which follow.
+ *
+ * @return         `YES` if a valid header was read, otherwise `NO`.
+ */
+- (BOOL)beginObjects:(NSUInteger *)count;
+
+/** Reads an object with `codec`.
+ *
+ * @param codec    The codec to read it with.
+ *
+ * @return         The object read, or `nil` if it could not be read.
+ */
+- (nullable id)decodeObjectWithCodec:(id<CBHObjectCodec>)codec;
+
+/** Finishes an object collection and verifies its checksum.
+ *
+ * @return    `YES` if the objects match the checksum, otherwise `NO`.
+ */
+- (BOOL)endObjects;
+
+
+#pragma mark - Reading
+
+/** Reads exactly `length` bytes into `bytes`. For use by codecs. */
+- (BOOL)readBytes:(void *)bytes length:(size_t)length;
+
+/** Reads exactly `length` bytes into new data, without trusting `length` with a single allocation. For use by codecs. */
+- (nullable NSData *)readDataOfLength:(uint64_t)length;
+
+/** Reads a 64 bit integer in the host's byte order. For use by codecs. */
+- (BOOL)readUInt64:(uint64_t *)value;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,638 @@
+//  CBHCollectionCoder.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHCollectionCoder.h"
+#import "CBHPrimitiveCollection.h"
+#import "_CBHChecksum.h"
+
+@import CBHMemoryKit;
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+
+/// Large enough to amortize system calls, small enough to stay in cache.
+#define BUFFER_SIZE (64 * 1024)
+
+/// The most bytes of entries reserved up front when the length of the source is unknown.
+#define DECODING_LENGTH (1024 * 1024)
+
+#define _formatError(aCode) [NSError errorWithDomain:CBHCollectionFormatErrorDomain code:(aCode) userInfo:nil]
+#define _posixError() [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil]
+
+#define _fail(anError)\
+{\
+	if ( !_error ) _error = [(anError) retain];\
+}
+
+
+#pragma mark - Encoder
+
+@implementation CBHCollectionEncoder
+{
+	int _fd;
+	NSMutableData *_data;
+
+	uint8_t *_buffer;
+	size_t _buffered;
+
+	/// The object collection being written.
+	CBHCollectionHeader _header;
+	CBHChecksum_t _checksum;
+	NSUInteger _remaining;
+	BOOL _inObjects;
+
+	/// Where `_header` was written, or -1 if it can't be rewritten.
+	off_t _headerOffset;
+
+	NSError *_error;
+}
+
+#pragma mark - Initialization
+
+- (instancetype)initWithFileDescriptor:(int)fd
+{
+	if ( (self = [super init]) )
+	{
+		_fd = fd;
+		_buffer = CBHMemory_alloc(BUFFER_SIZE, 1);
+		if ( !_buffer )
+		{
+			[self release];
+			@throw CBHCallocException;
+		}
+	}
+
+	return self;
+}
+
+- (instancetype)initWithMutableData:(NSMutableData *)data
+{
+	if ( (self = [super init]) )
+	{
+		/// Appending to data is already buffered.
+		_fd = -1;
+		_data = [data retain];
+	}
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	[self flush];
+
+	CBHMemory_free(_buffer);
+	[_data release];
+	[_error release];
+
+	[super dealloc];
+}
+
+
+#pragma mark - Properties
+
+- (NSError *)error
+{
+	return _error;
+}
+
+
+#pragma mark - Primitive Collections
+
+- (BOOL)encodeEntries:(const void *)bytes entrySize:(size_t)entrySize count:(NSUInteger)count
+{
+	if ( entrySize <= 0 ) @throw CBHEntrySizeException;
+	if ( CBHMemory_willOverflow(count, entrySize) ) @throw NSRangeException;
+	if ( _inObjects ) @throw NSInternalInconsistencyException;
+	if ( _error ) return NO;
+
+	const size_t length = count * entrySize;
+
+	CBHCollectionHeader header = CBHCollectionHeaderMake(entrySize, count);
+	header.checksum = CBHChecksum(bytes, length);
+
+	return [self bufferBytes:&header length:sizeof(header)] && [self bufferBytes:bytes length:length];
+}
+
+
+#pragma mark - Object Collections
+
+- (BOOL)beginObjects:(NSUInteger)count
+{
+	if ( _inObjects ) @throw NSInternalInconsistencyException;
+	if ( _error ) return NO;
+
+	_header = CBHCollectionHeaderMake(0, count);
+	_headerOffset = [self position];
+	if ( ![self bufferBytes:&_header length:sizeof(_header)] ) return NO;
+
+	_checksum = CBHChecksum_init();
+	_remaining = count;
+	_inObjects = YES;
+
+	return YES;
+}
+
+- (BOOL)encodeObject:(id)object withCodec:(id<CBHObjectCodec>)codec
+{
+	if ( !_inObjects || _remaining <= 0 ) @throw NSInternalInconsistencyException;
+	if ( _error ) return NO;
+
+	if ( ![codec encodeObject:object withEncoder:self] )
+	{
+		_fail(_formatError(CBHCollectionFormatErrorObject));
+		return NO;
+	}
+
+	--_remaining;
+	return YES;
+}
+
+- (BOOL)endObjects
+{
+	if ( !_inObjects ) @throw NSInternalInconsistencyException;
+	_inObjects = NO;
+
+	if ( _error ) return NO;
+	if ( _remaining > 0 ) @throw NSInternalInconsistencyException;
+
+	/// Pipes and sockets keep the header as written, without a checksum.
+	if ( _headerOffset < 0 ) return YES;
+
+	_header.checksum = CBHChecksum_final(&_checksum);
+
+	if ( _data )
+	{
+		[_data replaceBytesInRange:NSMakeRange((NSUInteger)_headerOffset, sizeof(_header)) withBytes:&_header];
+		return YES;
+	}
+
+	if ( ![self flush] ) return NO;
+
+	if ( pwrite(_fd, &_header, sizeof(_header), _headerOffset) != (ssize_t)sizeof(_header) )
+	{
+		_fail(_posixError());
+		return NO;
+	}
+
+	return YES;
+}
+
+
+#pragma mark - Writing
+
+- (BOOL)writeBytes:(const void *)bytes length:(size_t)length
+{
+	if ( _error ) return NO;
+	if ( _inObjects ) CBHChecksum_update(&_checksum, bytes, length);
+
+	return [self bufferBytes:bytes length:length];
+}
+
+- (BOOL)writeUInt64:(uint64_t)value
+{
+	return [self writeBytes:&value length:sizeof(value)];
+}
+
+- (BOOL)flush
+{
+	if ( _buffered <= 0 ) return YES;
+
+	const size_t length = _buffered;
+	_buffered = 0;
+
+	return [self emitBytes:_buffer length:length];
+}
+
+
+#pragma mark - Private
+
+/// The offset the next byte will be written at, or -1 if it is unknown or can't be written to again.
+- (off_t)position
+{
+	if ( _data ) return (off_t)[_data length];
+
+	/// Appending descriptors ignore the offset given to `pwrite`.
+	const int flags = fcntl(_fd, F_GETFL);
+	if ( flags < 0 || (flags & O_APPEND) ) return -1;
+
+	const off_t offset = lseek(_fd, 0, SEEK_CUR);
+	if ( offset < 0 ) return -1;
+
+	return offset + (off_t)_buffered;
+}
+
+- (BOOL)bufferBytes:(const void *)bytes length:(size_t)length
+{
+	if ( !_buffer ) return [self emitBytes:bytes length:length];
+
+	if ( length > BUFFER_SIZE - _buffered )
+	{
+		if ( ![self flush] ) return NO;
+
+		/// Large writes skip the buffer.
+		if ( length >= BUFFER_SIZE ) return [self emitBytes:bytes length:length];
+	}
+
+	memcpy(_buffer + _buffered, bytes, length);
+	_buffered += length;
+
+	return YES;
+}
+
+- (BOOL)emitBytes:(const void *)bytes length:(size_t)length
+{
+	if ( _data )
+	{
+		[_data appendBytes:bytes length:length];
+		return YES;
+	}
+
+	while ( length > 0 )
+	{
+		const ssize_t written = write(_fd, bytes, length);
+		if ( written < 0 )
+		{
+			if ( errno == EINTR ) continue;
+
+			_fail(_posixError());
+			return NO;
+		}
+
+		bytes = (const uint8_t *)bytes + written;
+		length -= (size_t)written;
+	}
+
+	return YES;
+}
+
+@end
+
+
+#pragma mark - Decoder
+
+@implementation CBHCollectionDecoder
+{
+	int _fd;
+	NSData *_data;
+
+	uint8_t *_buffer;
+	const uint8_t *_cursor;
+	const uint8_t *_end;
+
+	/// Bytes in the source beyond `_end`, or `UINT64_MAX` if unknown.
+	uint64_t _unread;
+
+	/// The collection being read.
+	CBHCollectionHeader _header;
+	CBHChecksum_t _checksum;
+	NSUInteger _remaining;
+	BOOL _inObjects;
+	BOOL _hasEntries;
+
+	NSError *_error;
+}
+
+#pragma mark - Initialization
+
+- (instancetype)initWithFileDescriptor:(int)fd
+{
+	if ( (self = [super init]) )
+	{
+		_fd = fd;
+		_buffer = CBHMemory_alloc(BUFFER_SIZE, 1);
+		if ( !_buffer )
+		{
+			[self release];
+			@throw CBHCallocException;
+		}
+		_cursor = _buffer;
+		_end = _buffer;
+
+		/// The length of regular files is known, which lets corrupt counts fail early.
+		struct stat info;
+		const off_t offset = lseek(fd, 0, SEEK_CUR);
+		if ( fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && offset >= 0 && info.st_size >= offset )
+		{
+			_unread = (uint64_t)(info.st_size - offset);
+		}
+		else
+		{
+			_unread = UINT64_MAX;
+		}
+	}
+
+	return self;
+}
+
+- (instancetype)initWithData:(NSData *)data
+{
+	if ( (self = [super init]) )
+	{
+		_fd = -1;
+		_data = [data copy];
+		_cursor = [_data bytes];
+		_end = _cursor + [_data length];
+		_unread = 0;
+	}
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	CBHMemory_free(_buffer);
+	[_data release];
+	[_error release];
+
+	[super dealloc];
+}
+
+
+#pragma mark - Properties
+
+- (NSError *)error
+{
+	return _error;
+}
+
+
+#pragma mark - Primitive Collections
+
+- (BOOL)decodeEntryCount:(NSUInteger *)count entrySize:(size_t *)entrySize
+{
+	if ( _inObjects || _hasEntries ) @throw NSInternalInconsistencyException;
+	if ( ![self decodeHeaderWithEntrySize:NULL] ) return NO;
+
+	*count = (NSUInteger)_header.count;
+	*entrySize = (size_t)_header.entrySize;
+	_hasEntries = YES;
+
+	return YES;
+}
+
+- (BOOL)decodeEntriesReserving:(void * _Nonnull (NS_NOESCAPE ^)(NSUInteger capacity))reserve
+{
+	if ( !_hasEntries ) @throw NSInternalInconsistencyException;
+	_hasEntries = NO;
+
+	const NSUInteger count = (NSUInteger)_header.count;
+	const size_t entrySize = (size_t)_header.entrySize;
+
+	/// A known length has been checked against the header. Otherwise the count is only trusted as far as a modest capacity, which doubles as entries arrive.
+	NSUInteger capacity = count;
+	if ( [self available] == UINT64_MAX ) capacity = MIN(count, MAX(DECODING_LENGTH / entrySize, (size_t)1));
+
+	CBHChecksum_t checksum = CBHChecksum_init();
+	NSUInteger decoded = 0;
+
+	while ( YES )
+	{
+		uint8_t *entries = (uint8_t *)reserve(capacity) + (decoded * entrySize);
+		const size_t length = (capacity - decoded) * entrySize;
+
+		if ( ![self fillBytes:entries length:length] ) return NO;
+		CBHChecksum_update(&checksum, entries, length);
+
+		decoded = capacity;
+		if ( decoded >= count ) break;
+
+		capacity = ( capacity > count / 2 ) ? count : capacity * 2;
+	}
+
+	if ( _header.checksum != 0 && CBHChecksum_final(&checksum) != _header.checksum )
+	{
+		_fail(_formatError(CBHCollectionFormatErrorChecksum));
+		return NO;
+	}
+
+	return YES;
+}
+
+
+#pragma mark - Object Collections
+
+- (BOOL)beginObjects:(NSUInteger *)count
+{
+	if ( _inObjects || _hasEntries ) @throw NSInternalInconsistencyException;
+
+	const size_t objects = 0;
+	if ( ![self decodeHeaderWithEntrySize:&objects] ) return NO;
+
+	*count = (NSUInteger)_header.count;
+	_checksum = CBHChecksum_init();
+	_remaining = *count;
+	_inObjects = YES;
+
+	return YES;
+}
+
+- (id)decodeObjectWithCodec:(id<CBHObjectCodec>)codec
+{
+	if ( !_inObjects || _remaining <= 0 ) @throw NSInternalInconsistencyException;
+	if ( _error ) return nil;
+
+	id object = [codec decodeObjectWithDecoder:self];
+	if ( !object )
+	{
+		_fail(_formatError(CBHCollectionFormatErrorObject));
+		return nil;
+	}
+
+	--_remaining;
+	return object;
+}
+
+- (BOOL)endObjects
+{
+	if ( !_inObjects ) @throw NSInternalInconsistencyException;
+	_inObjects = NO;
+
+	if ( _error ) return NO;
+	if ( _remaining > 0 ) @throw NSInternalInconsistencyException;
+
+	if ( _header.checksum != 0 && CBHChecksum_final(&_checksum) != _header.checksum )
+	{
+		_fail(_formatError(CBHCollectionFormatErrorChecksum));
+		return NO;
+	}
+
+	return YES;
+}
+
+
+#pragma mark - Reading
+
+- (BOOL)readBytes:(void *)bytes length:(size_t)length
+{
+	if ( _error ) return NO;
+	if ( ![self fillBytes:bytes length:length] ) return NO;
+
+	if ( _inObjects ) CBHChecksum_update(&_checksum, bytes, length);
+	return YES;
+}
+
+- (NSData *)readDataOfLength:(uint64_t)length
+{
+	if ( _error ) return nil;
+
+	const uint64_t available = [self available];
+	if ( length > available || length > NSUIntegerMax )
+	{
+		_fail(_formatError(CBHCollectionFormatErrorTruncated));
+		return nil;
+	}
+
+	/// A known length has been checked, so it can be allocated at once.
+	if ( available != UINT64_MAX )
+	{
+		NSMutableData *data = [NSMutableData dataWithLength:(NSUInteger)length];
+		return ( [self readBytes:[data mutableBytes] length:(size_t)length] ) ? data : nil;
+	}
+
+	/// Otherwise grown a buffer at a time, so a corrupt length fails at the end of the stream instead of in one huge allocation.
+	NSMutableData *data = [NSMutableData data];
+	uint64_t remaining = length;
+	while ( remaining > 0 )
+	{
+		const size_t chunk = ( remaining < BUFFER_SIZE ) ? (size_t)remaining : BUFFER_SIZE;
+		const NSUInteger offset = [data length];
+
+		[data setLength:offset + chunk];
+		if ( ![self readBytes:(uint8_t *)[data mutableBytes] + offset length:chunk] ) return nil;
+
+		remaining -= chunk;
+	}
+
+	return data;
+}
+
+- (BOOL)readUInt64:(uint64_t *)value
+{
+	return [self readBytes:value length:sizeof(*value)];
+}
+
+
+#pragma mark - Private
+
+/// Bytes left to read, or `UINT64_MAX` if unknown.
+- (uint64_t)available
+{
+	if ( _unread == UINT64_MAX ) return UINT64_MAX;
+	return (uint64_t)(_end - _cursor) + _unread;
+}
+
+/// Reads and validates a header. `entrySize` points at the expected size, or is `NULL` to accept any primitive entries.
+- (BOOL)decodeHeaderWithEntrySize:(const size_t *)entrySize
+{
+	if ( _error ) return NO;
+	if ( ![self fillBytes:&_header length:sizeof(_header)] ) return NO;
+
+	NSError *error = nil;
+	const size_t expected = ( entrySize ) ? *entrySize : (size_t)_header.entrySize;
+	if ( !CBHCollectionHeaderValidate(&_header, expected, [self available], &error) )
+	{
+		_fail(error);
+		return NO;
+	}
+
+	/// Objects where primitive entries are expected.
+	if ( !entrySize && _header.entrySize <= 0 )
+	{
+		_fail(_formatError(CBHCollectionFormatErrorEntrySize));
+		return NO;
+	}
+
+	return YES;
+}
+
+- (BOOL)fillBytes:(void *)bytes length:(size_t)length
+{
+	uint8_t *output = bytes;
+
+	while ( length > 0 )
+	{
+		const size_t ready = (size_t)(_end - _cursor);
+		if ( ready > 0 )
+		{
+			const size_t taken = ( ready < length ) ? ready : length;
+			memcpy(output, _cursor, taken);
+
+			_cursor += taken;
+			output += taken;
+			length -= taken;
+			continue;
+		}
+
+		/// Large reads skip the buffer.
+		const BOOL direct = ( length >= BUFFER_SIZE );
+		const ssize_t got = [self readInto:(direct) ? output : _buffer length:(direct) ? length : BUFFER_SIZE];
+		if ( got <= 0 ) return NO;
+
+		if ( direct )
+		{
+			output += got;
+			length -= (size_t)got;
+		}
+		else
+		{
+			_cursor = _buffer;
+			_end = _buffer + got;
+		}
+	}
+
+	return YES;
+}
+
+/// Reads up to `length` bytes from the file descriptor. Fails at the end of the source.
+- (ssize_t)readInto:(void *)bytes length:(size_t)length
+{
+	if ( _fd < 0 )
+	{
+		_fail(_formatError(CBHCollectionFormatErrorTruncated));
+		return -1;
+	}
+
+	ssize_t got = 0;
+	do { got = read(_fd, bytes, length); } while ( got < 0 && errno == EINTR );
+
+	if ( got < 0 )
+	{
+		_fail(_posixError());
+		return -1;
+	}
+
+	if ( got == 0 )
+	{
+		_fail(_formatError(CBHCollectionFormatErrorTruncated));
+		return -1;
+	}
+
+	if ( _unread != UINT64_MAX ) _unread -= ( (uint64_t)got < _unread ) ? (uint64_t)got : _unread;
+	return got;
+}
+
+@end
@@ -0,0 +1,113 @@
+//  CBHCollectionFormat.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Header
+
+/** The version of the header written by this framework. */
+#define CBHCollectionFormatVersion 1
+
+/** The byte order of the entries following a header. */
+typedef NS_ENUM(uint8_t, CBHByteOrder) {
+	CBHByteOrderLittleEndian = 1,
+	CBHByteOrderBigEndian = 2,
+};
+
+/** The fixed 32 byte header which precedes the entries of a collection stored in a file or stream.
+ *
+ * Entries immediately follow the header, so they stay aligned for entries of up to 32 bytes when the file is mapped. The entries of an object collection are written by an object codec and vary in size, their header has an entry size of zero.
+ */
+typedef struct CBHCollectionHeader {
+	/** Always the four bytes `CBHK`. */
+	char magic[4];
+
+	/** The version of the format, `CBHCollectionFormatVersion` when written by this framework. */
+	uint16_t version;
+
+	/** The byte order of the header fields and entries. */
+	uint8_t byteOrder;
+
+	/** Reserved. Always zero. */
+	uint8_t flags;
+
+	/** The size of each entry in bytes, or zero for objects. */
+	uint64_t entrySize;
+
+	/** The number of entries following the header. */
+	uint64_t count;
+
+	/** A checksum of the entries, or zero if none was recorded. */
+	uint64_t checksum;
+} CBHCollectionHeader;
+
+/** The host's byte order. */
+CBHByteOrder CBHByteOrderHost(void);
+
+/** Makes a header for `count` entries of `entrySize` in the host's byte order with no checksum.
+ *
+ * @param entrySize    The size of each entry.
+ * @param count        The number of entries.
+ *
+ * @return             A new header.
+ */
+CBHCollectionHeader CBHCollectionHeaderMake(size_t entrySize, uint64_t count);
+
+/** Checks that a header can be read by this host and describes entries of `entrySize` which fit within `length` bytes.
+ *
+ * @param header       The header to check.
+ * @param entrySize    The expected size of each entry, or zero for objects, whose length is not checked.
+ * @param length       The number of bytes available after the header.
+ * @param error        On return, the reason the header is invalid. May be `NULL`.
+ *
+ * @return             `YES` if the header is valid, otherwise `NO`.
+ */
+BOOL CBHCollectionHeaderValidate(const CBHCollectionHeader *header, size_t entrySize, uint64_t length, NSError * _Nullable * _Nullable error);
+
+
+#pragma mark - Errors
+
+extern NSErrorDomain const CBHCollectionFormatErrorDomain;
+
+typedef NS_ERROR_ENUM(CBHCollectionFormatErrorDomain, CBHCollectionFormatError) {
+	/** The data is too short to contain a header or its entries. */
+	CBHCollectionFormatErrorTruncated = 1,
+
+	/** The header doesn't begin with the magic bytes. */
+	CBHCollectionFormatErrorMagic,
+
+	/** The header was written by a newer version of the format. */
+	CBHCollectionFormatErrorVersion,
+
+	/** The entries are not in the host's byte order. */
+	CBHCollectionFormatErrorByteOrder,
+
+	/** The entries are not of the expected size. */
+	CBHCollectionFormatErrorEntrySize,
+
+	/** The entries don't match the checksum in the header. */
+	CBHCollectionFormatErrorChecksum,
+
+	/** An object codec could not encode or decode an entry. */
+	CBHCollectionFormatErrorObject,
+};
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,86 @@
+//  CBHCollectionFormat.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHCollectionFormat.h"
+
+
+NSErrorDomain const CBHCollectionFormatErrorDomain = @"CBHCollectionFormatErrorDomain";
+
+static const char kMagic[4] = {'C', 'B', 'H', 'K'};
+
+#define _setError(anError, aCode, aReason) if ( anError ) *(anError) = [NSError errorWithDomain:CBHCollectionFormatErrorDomain code:(aCode) userInfo:@{NSLocalizedFailureReasonErrorKey: (aReason)}]
+
+_Static_assert(sizeof(CBHCollectionHeader) == 32, "Header must stay 32 bytes.");
+
+
+#pragma mark - Header
+
+CBHByteOrder CBHByteOrderHost(void)
+{
+	return ( NSHostByteOrder() == NS_BigEndian ) ? CBHByteOrderBigEndian : CBHByteOrderLittleEndian;
+}
+
+CBHCollectionHeader CBHCollectionHeaderMake(size_t entrySize, uint64_t count)
+{
+	CBHCollectionHeader header;
+	memcpy(header.magic, kMagic, sizeof(kMagic));
+	header.version = CBHCollectionFormatVersion;
+	header.byteOrder = CBHByteOrderHost();
+	header.flags = 0;
+	header.entrySize = entrySize;
+	header.count = count;
+	header.checksum = 0;
+
+	return header;
+}
+
+BOOL CBHCollectionHeaderValidate(const CBHCollectionHeader *header, size_t entrySize, uint64_t length, NSError **error)
+{
+	if ( memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 )
+	{
+		_setError(error, CBHCollectionFormatErrorMagic, @"The data is not a collection.");
+		return NO;
+	}
+
+	/// Checked before any multi-byte field, which may be in the wrong order.
+	if ( header->byteOrder != CBHByteOrderHost() )
+	{
+		_setError(error, CBHCollectionFormatErrorByteOrder, @"The entries are not in the host's byte order.");
+		return NO;
+	}
+
+	if ( header->version > CBHCollectionFormatVersion )
+	{
+		_setError(error, CBHCollectionFormatErrorVersion, @"The collection was written by a newer version of the format.");
+		return NO;
+	}
+
+	if ( header->entrySize != entrySize )
+	{
+		_setError(error, CBHCollectionFormatErrorEntrySize, @"The entries are not of the expected size.");
+		return NO;
+	}
+
+	if ( entrySize > 0 && header->count > length / entrySize )
+	{
+		_setError(error, CBHCollectionFormatErrorTruncated, @"The data is too short to contain its entries.");
+		return NO;
+	}
+
+	return YES;
+}
@@ -0,0 +1,84 @@
+//  CBHObjectCodec.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import <CBHCollectionKit/CBHCollectionCoder.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - String Codec
+
+/** Writes strings as a length followed by their UTF-8 bytes.
+ */
+@interface CBHStringCodec : NSObject <CBHObjectCodec>
+
+/** A shared instance of the codec. */
++ (instancetype)codec;
+
+@end
+
+
+#pragma mark - Data Codec
+
+/** Writes data as a length followed by its bytes.
+ */
+@interface CBHDataCodec : NSObject <CBHObjectCodec>
+
+/** A shared instance of the codec. */
++ (instancetype)codec;
+
+@end
+
+
+#pragma mark - Number Codec
+
+/** Writes numbers as a one byte kind followed by a 64 bit value.
+ *
+ * Booleans, signed and unsigned integers, and floating point numbers each decode as the same kind. Numbers are widened to 64 bits, so a `float` decodes as a `double`.
+ */
+@interface CBHNumberCodec : NSObject <CBHObjectCodec>
+
+/** A shared instance of the codec. */
++ (instancetype)codec;
+
+@end
+
+
+#pragma mark - Archiving Codec
+
+/** Writes any object conforming to `NSSecureCoding` as a keyed archive.
+ *
+ * This is much larger and slower than a dedicated codec and is meant as a fallback.
+ */
+@interface CBHArchivingCodec : NSObject <CBHObjectCodec>
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/** Initializes a newly allocated codec which decodes objects of `classes`.
+ *
+ * @param classes    The classes which may be decoded, including those of any objects they contain.
+ *
+ * @return           A newly initialized codec.
+ */
+- (instancetype)initWithClasses:(NSSet<Class> *)classes NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
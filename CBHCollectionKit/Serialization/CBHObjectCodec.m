@@ -0,0 +1,258 @@
+//  CBHObjectCodec.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHObjectCodec.h"
+
+
+/// Strings up to this length are decoded from the stack.
+#define SMALL_STRING_LENGTH 256
+
+#define _sharedCodec()\
+static id sharedCodec = nil;\
+static dispatch_once_t onceToken;\
+dispatch_once(&onceToken, ^{\
+	sharedCodec = [[self alloc] init];\
+});\
+return sharedCodec
+
+
+#pragma mark - String Codec
+
+@implementation CBHStringCodec
+
++ (instancetype)codec
+{
+	_sharedCodec();
+}
+
+- (BOOL)encodeObject:(id)object withEncoder:(CBHCollectionEncoder *)encoder
+{
+	if ( ![object isKindOfClass:[NSString class]] ) return NO;
+
+	/// Not `strlen`, strings may contain nulls.
+	const char *bytes = [(NSString *)object UTF8String];
+	const uint64_t length = [(NSString *)object lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+
+	return [encoder writeUInt64:length] && [encoder writeBytes:bytes length:(size_t)length];
+}
+
+- (id)decodeObjectWithDecoder:(CBHCollectionDecoder *)decoder
+{
+	uint64_t length = 0;
+	if ( ![decoder readUInt64:&length] ) return nil;
+
+	if ( length <= SMALL_STRING_LENGTH )
+	{
+		char bytes[SMALL_STRING_LENGTH];
+		if ( ![decoder readBytes:bytes length:(size_t)length] ) return nil;
+
+		return [[[NSString alloc] initWithBytes:bytes length:(NSUInteger)length encoding:NSUTF8StringEncoding] autorelease];
+	}
+
+	NSData *data = [decoder readDataOfLength:length];
+	if ( !data ) return nil;
+
+	return [[[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding] autorelease];
+}
+
+@end
+
+
+#pragma mark - Data Codec
+
+@implementation CBHDataCodec
+
++ (instancetype)codec
+{
+	_sharedCodec();
+}
+
+- (BOOL)encodeObject:(id)object withEncoder:(CBHCollectionEncoder *)encoder
+{
+	if ( ![object isKindOfClass:[NSData class]] ) return NO;
+
+	NSData *data = object;
+	return [encoder writeUInt64:[data length]] && [encoder writeBytes:[data bytes] length:[data length]];
+}
+
+- (id)decodeObjectWithDecoder:(CBHCollectionDecoder *)decoder
+{
+	uint64_t length = 0;
+	if ( ![decoder readUInt64:&length] ) return nil;
+
+	return [decoder readDataOfLength:length];
+}
+
+@end
+
+
+#pragma mark - Number Codec
+
+typedef NS_ENUM(uint8_t, CBHNumberKind) {
+	CBHNumberKindBoolean = 'B',
+	CBHNumberKindSigned = 'q',
+	CBHNumberKindUnsigned = 'Q',
+	CBHNumberKindFloat = 'd',
+};
+
+@implementation CBHNumberCodec
+
++ (instancetype)codec
+{
+	_sharedCodec();
+}
+
+- (BOOL)encodeObject:(id)object withEncoder:(CBHCollectionEncoder *)encoder
+{
+	if ( ![object isKindOfClass:[NSNumber class]] ) return NO;
+
+	NSNumber *number = object;
+	uint8_t kind;
+	uint64_t value;
+
+	const char type = *[number objCType];
+	if ( CFGetTypeID((CFTypeRef)number) == CFBooleanGetTypeID() )
+	{
+		kind = CBHNumberKindBoolean;
+		value = ( [number boolValue] ) ? 1 : 0;
+	}
+	else if ( type == 'f' || type == 'd' )
+	{
+		kind = CBHNumberKindFloat;
+		const double bits = [number doubleValue];
+		memcpy(&value, &bits, sizeof(value));
+	}
+	else if ( type == 'C' || type == 'S' || type == 'I' || type == 'L' || type == 'Q' )
+	{
+		kind = CBHNumberKindUnsigned;
+		value = [number unsignedLongLongValue];
+	}
+	else
+	{
+		kind = CBHNumberKindSigned;
+		const long long bits = [number longLongValue];
+		memcpy(&value, &bits, sizeof(value));
+	}
+
+	return [encoder writeBytes:&kind length:sizeof(kind)] && [encoder writeUInt64:value];
+}
+
+- (id)decodeObjectWithDecoder:(CBHCollectionDecoder *)decoder
+{
+	uint8_t kind;
+	uint64_t value;
+	if ( ![decoder readBytes:&kind length:sizeof(kind)] || ![decoder readUInt64:&value] ) return nil;
+
+	switch ( kind )
+	{
+		case CBHNumberKindBoolean:
+			return [NSNumber numberWithBool:(value != 0)];
+
+		case CBHNumberKindUnsigned:
+			return [NSNumber numberWithUnsignedLongLong:value];
+
+		case CBHNumberKindSigned:
+		{
+			long long number;
+			memcpy(&number, &value, sizeof(number));
+			return [NSNumber numberWithLongLong:number];
+		}
+
+		case CBHNumberKindFloat:
+		{
+			double number;
+			memcpy(&number, &value, sizeof(number));
+			return [NSNumber numberWithDouble:number];
+		}
+
+		default:
+			return nil;
+	}
+}
+
+@end
+
+
+#pragma mark - Archiving Codec
+
+@implementation CBHArchivingCodec
+{
+	NSSet<Class> *_classes;
+}
+
+- (instancetype)initWithClasses:(NSSet<Class> *)classes
+{
+	if ( (self = [super init]) )
+	{
+		_classes = [classes copy];
+	}
+
+	return self;
+}
+
+- (void)dealloc
+{
+	[_classes release];
+	[super dealloc];
+}
+
+- (BOOL)encodeObject:(id)object withEncoder:(CBHCollectionEncoder *)encoder
+{
+	if ( ![object conformsToProtocol:@protocol(NSSecureCoding)] ) return NO;
+
+	NSMutableData *data = [NSMutableData data];
+	NSKeyedArchiver *archiver = [[NSKeyedArchiver alloc] initForWritingWithMutableData:data];
+	[archiver setRequiresSecureCoding:YES];
+	[archiver encodeObject:object forKey:NSKeyedArchiveRootObjectKey];
+	[archiver finishEncoding];
+	[archiver release];
+
+	return [encoder writeUInt64:[data length]] && [encoder writeBytes:[data bytes] length:[data length]];
+}
+
+- (id)decodeObjectWithDecoder:(CBHCollectionDecoder *)decoder
+{
+	uint64_t length = 0;
+	if ( ![decoder readUInt64:&length] ) return nil;
+
+	NSData *data = [decoder readDataOfLength:length];
+	if ( !data ) return nil;
+
+	id object = nil;
+	NSKeyedUnarchiver *unarchiver = [[NSKeyedUnarchiver alloc] initForReadingWithData:data];
+	[unarchiver setRequiresSecureCoding:YES];
+
+	@try
+	{
+		object = [[unarchiver decodeObjectOfClasses:_classes forKey:NSKeyedArchiveRootObjectKey] retain];
+	}
+	@catch (NSException *exception)
+	{
+		/// Secure decoding throws on unexpected classes, which is just another bad entry here.
+		object = nil;
+	}
+	@finally
+	{
+		[unarchiver finishDecoding];
+		[unarchiver release];
+	}
+
+	return [object autorelease];
+}
+
+@end
@@ -0,0 +1,98 @@
+//  CBHSliceReader.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import <CBHCollectionKit/CBHSlice.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/** Streams a file of fixed-size entries as a sequence of slices.
+ *
+ * The file is read in windows of a fixed number of entries into two reused buffers. While one window is being processed the next is read on a background queue. No memory is allocated once reading has started.
+ *
+ * A window is only valid until the next call to `nextSlice`. After that its bytes are reused. A copy of a window keeps its contents.
+ *
+ * @author    Christian Huxtable <chris@huxtable.ca>
+ */
+@interface CBHSliceReader : NSObject
+
+#pragma mark - Factories
+
++ (nullable instancetype)readerWithContentsOfFile:(NSString *)path entrySize:(size_t)entrySize windowSize:(NSUInteger)windowSize options:(CBHSliceFileOptions)options;
+
+
+#pragma mark - Initialization
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/** Initializes a newly allocated reader over the entries of a file.
+ *
+ * The file is read sequentially. `CBHSliceFileAdviseWillNeed` asks for the whole file to be read ahead, and `CBHSliceFileAdviseRandom` is not supported.
+ *
+ * @param path          The path of the file to read.
+ * @param entrySize     The size of each entry in bytes.
+ * @param windowSize    The number of entries in each window.
+ * @param options       How the file is laid out. `CBHSliceFileHeader` validates and skips the header.
+ * @param error         Set to the reason the file could not be opened. May be `NULL`.
+ *
+ * @return              A newly initialized reader, or `nil` if the file could not be opened.
+ */
+- (nullable instancetype)initWithContentsOfFile:(NSString *)path entrySize:(size_t)entrySize windowSize:(NSUInteger)windowSize options:(CBHSliceFileOptions)options error:(NSError * _Nullable * _Nullable)error NS_DESIGNATED_INITIALIZER;
+
+
+#pragma mark - Properties
+
+@property (nonatomic, readonly) size_t entrySize;
+@property (nonatomic, readonly) NSUInteger windowSize;
+
+/** The number of entries in the file. */
+@property (nonatomic, readonly) NSUInteger count;
+
+/** The number of bytes delivered so far. */
+@property (nonatomic, readonly) uint64_t bytesRead;
+
+/** The rate entries have been delivered at, from the first window until the last or until now. */
+@property (nonatomic, readonly) double bytesPerSecond;
+
+/** The reason reading stopped early, or `nil`. */
+@property (nonatomic, readonly, nullable) NSError *error;
+
+
+#pragma mark - Reading
+
+/** Returns the next window of entries.
+ *
+ * Every window holds `windowSize` entries except the last, which holds the remainder. Entries are never split between windows.
+ *
+ * @return    The next window, or `nil` once every entry has been read or reading fails. The window is reused by the next call.
+ */
+- (nullable CBHSlice *)nextSlice;
+
+/** Calls `block` with each remaining window in order.
+ *
+ * @param block    The block to call. Setting `stop` to `YES` stops reading.
+ *
+ * @return         `NO` if reading failed, otherwise `YES`.
+ */
+- (BOOL)enumerateSlicesUsingBlock:(void (NS_NOESCAPE ^)(CBHSlice *slice, BOOL *stop))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,454 @@
+//  CBHSliceReader.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "CBHSliceReader.h"
+#import "CBHMutableSlice.h"
+#import "_CBHSlice.h"
+#import "_CBHHash.h"
+
+@import CBHMemoryKit;
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <mach/mach_time.h>
+
+
+#define _posixError(aPath) [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:@{NSFilePathErrorKey: (aPath)}]
+#define _formatError(aCode) [NSError errorWithDomain:CBHCollectionFormatErrorDomain code:(aCode) userInfo:nil]
+
+#define _fail(anError)\
+{\
+	if ( !_error ) _error = [(anError) retain];\
+}
+
+
+#pragma mark - Timing
+
+static uint64_t CBHSliceReader_nanoseconds(void)
+{
+	static mach_timebase_info_data_t timebase;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		mach_timebase_info(&timebase);
+	});
+
+	return mach_absolute_time() * timebase.numer / timebase.denom;
+}
+
+
+#pragma mark - Advice
+
+static void CBHSliceReader_adviseSequential(int fd)
+{
+#if defined(POSIX_FADV_SEQUENTIAL)
+	posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#elif defined(F_RDAHEAD)
+	fcntl(fd, F_RDAHEAD, 1);
+#endif
+}
+
+static void CBHSliceReader_adviseWillNeed(int fd, off_t offset, uint64_t length)
+{
+	if ( length <= 0 ) return;
+
+#if defined(POSIX_FADV_WILLNEED)
+	posix_fadvise(fd, offset, (off_t)length, POSIX_FADV_WILLNEED);
+#elif defined(F_RDADVISE)
+	struct radvisory advisory = { .ra_offset = offset, .ra_count = (int)MIN(length, (uint64_t)INT_MAX) };
+	fcntl(fd, F_RDADVISE, &advisory);
+#endif
+}
+
+
+#pragma mark - Filling
+
+/// A read of one window, handed to the background queue without allocating.
+typedef struct CBHSliceReaderFill_t {
+	int _fd;
+	void *_bytes;
+	off_t _offset;
+	size_t _length;
+
+	/// Written by the background queue, read once the fill is waited on.
+	size_t _filled;
+	int _errno;
+	BOOL _pending;
+} CBHSliceReaderFill_t;
+
+static void CBHSliceReader_fill(void *context)
+{
+	CBHSliceReaderFill_t *fill = (CBHSliceReaderFill_t *)context;
+	uint8_t *bytes = (uint8_t *)fill->_bytes;
+
+	fill->_filled = 0;
+	fill->_errno = 0;
+
+	/// Short reads are continued, so an entry is never left split at the end of a window.
+	while ( fill->_filled < fill->_length )
+	{
+		const ssize_t result = pread(fill->_fd, bytes + fill->_filled, fill->_length - fill->_filled, fill->_offset + (off_t)fill->_filled);
+		if ( result < 0 && errno == EINTR ) continue;
+		if ( result < 0 ) { fill->_errno = errno; return; }
+		if ( result == 0 ) return;
+
+		fill->_filled += (size_t)result;
+	}
+}
+
+
+#pragma mark - Windows
+
+@interface CBHSlice ()
+{
+	@protected
+	CBHSlice_t _slice;
+}
+
+@end
+
+
+/// A slice over a reused buffer. Its bytes change under it, so copies can't share them and its hash can't be kept.
+@interface _CBHSliceWindow : CBHSlice
+
+- (void *)mutableBytes;
+- (void)setCount:(NSUInteger)count;
+
+@end
+
+
+@implementation _CBHSliceWindow
+
+- (void *)mutableBytes
+{
+	return _slice._data;
+}
+
+- (void)setCount:(NSUInteger)count
+{
+	_slice._capacity = count;
+	++_slice._generation;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	return [[CBHSlice allocWithZone:zone] initWithEntrySize:_slice._entrySize copying:_slice._capacity entriesFromBytes:_slice._data];
+}
+
+- (id)mutableCopyWithZone:(NSZone *)zone
+{
+	return [[CBHMutableSlice allocWithZone:zone] initWithEntrySize:_slice._entrySize copying:_slice._capacity entriesFromBytes:_slice._data];
+}
+
+- (NSData *)dataNoCopy
+{
+	return [self data];
+}
+
+- (NSUInteger)hash
+{
+	return (NSUInteger)CBHHash(_slice._data, _slice._capacity * _slice._entrySize, _slice._entrySize);
+}
+
+- (Class)classForCoder
+{
+	return [CBHSlice class];
+}
+
+@end
+
+
+#pragma mark - Reader
+
+@implementation CBHSliceReader
+{
+	int _fd;
+
+	size_t _entrySize;
+	NSUInteger _windowSize;
+	NSUInteger _count;
+
+	/// Where the entries start and how many bytes of them have been handed to a fill.
+	off_t _payloadOffset;
+	uint64_t _payloadLength;
+	uint64_t _scheduled;
+
+	_CBHSliceWindow *_windows[2];
+	CBHSliceReaderFill_t _fills[2];
+	NSUInteger _next;
+
+	dispatch_queue_t _queue;
+	dispatch_group_t _group;
+
+	BOOL _started;
+	BOOL _finished;
+	uint64_t _bytesRead;
+	uint64_t _start;
+	uint64_t _end;
+
+	NSError *_error;
+}
+
+#pragma mark - Factories
+
++ (instancetype)readerWithContentsOfFile:(NSString *)path entrySize:(size_t)entrySize windowSize:(NSUInteger)windowSize options:(CBHSliceFileOptions)options
+{
+	return [[(CBHSliceReader *)[self alloc] initWithContentsOfFile:path entrySize:entrySize windowSize:windowSize options:options error:NULL] autorelease];
+}
+
+
+#pragma mark - Initialization
+
+- (instancetype)initWithContentsOfFile:(NSString *)path entrySize:(size_t)entrySize windowSize:(NSUInteger)windowSize options:(CBHSliceFileOptions)options error:(NSError **)error
+{
+	NSExceptionName exception = nil;
+	if ( entrySize <= 0 ) exception = CBHEntrySizeException;
+	else if ( windowSize <= 0 || windowSize > SIZE_MAX / entrySize ) exception = NSRangeException;
+	else if ( options & CBHSliceFileAdviseRandom ) exception = NSInvalidArgumentException;
+
+	if ( exception )
+	{
+		[self release];
+		@throw exception;
+	}
+
+	if ( !(self = [super init]) ) return nil;
+
+	_fd = -1;
+	_entrySize = entrySize;
+	_windowSize = windowSize;
+
+	_fd = open([path fileSystemRepresentation], O_RDONLY | O_CLOEXEC);
+	struct stat status;
+
+	if ( _fd < 0 || fstat(_fd, &status) != 0 )
+	{
+		if ( error ) *error = _posixError(path);
+		[self release];
+		return nil;
+	}
+
+	uint64_t length = (uint64_t)status.st_size;
+
+	if ( options & CBHSliceFileHeader )
+	{
+		/// A file too short for a header fails on its magic.
+		CBHCollectionHeader header;
+		memset(&header, 0, sizeof(header));
+		if ( length >= sizeof(header) && pread(_fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) )
+		{
+			if ( error ) *error = _posixError(path);
+			[self release];
+			return nil;
+		}
+
+		if ( !CBHCollectionHeaderValidate(&header, entrySize, length - MIN(length, sizeof(header)), error) )
+		{
+			[self release];
+			return nil;
+		}
+
+		_payloadOffset = (off_t)sizeof(header);
+		length = header.count * entrySize;
+	}
+	else if ( length % entrySize != 0 )
+	{
+		if ( error ) *error = [NSError errorWithDomain:CBHCollectionFormatErrorDomain code:CBHCollectionFormatErrorEntrySize userInfo:@{NSFilePathErrorKey: path}];
+		[self release];
+		return nil;
+	}
+
+	_payloadLength = length;
+	_count = (NSUInteger)(length / entrySize);
+
+	CBHSliceReader_adviseSequential(_fd);
+	if ( options & CBHSliceFileAdviseWillNeed ) CBHSliceReader_adviseWillNeed(_fd, _payloadOffset, _payloadLength);
+
+	/// Small files don't need buffers larger than themselves.
+	const NSUInteger capacity = MAX(MIN(windowSize, _count), (NSUInteger)1);
+	for (NSUInteger i = 0; i < 2; ++i)
+	{
+		_windows[i] = [[_CBHSliceWindow alloc] initWithEntrySize:entrySize andCapacity:capacity shouldClear:NO];
+		_fills[i]._fd = _fd;
+		_fills[i]._bytes = [_windows[i] mutableBytes];
+	}
+
+	_queue = dispatch_queue_create("ca.huxtable.CBHSliceReader", DISPATCH_QUEUE_SERIAL);
+	_group = dispatch_group_create();
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	/// The background queue may still be reading into a window.
+	if ( _group ) dispatch_group_wait(_group, DISPATCH_TIME_FOREVER);
+
+	if ( _group ) dispatch_release(_group);
+	if ( _queue ) dispatch_release(_queue);
+
+	[_windows[0] release];
+	[_windows[1] release];
+
+	if ( _fd >= 0 ) close(_fd);
+
+	[_error release];
+
+	[super dealloc];
+}
+
+
+#pragma mark - Properties
+
+- (size_t)entrySize
+{
+	return _entrySize;
+}
+
+- (NSUInteger)windowSize
+{
+	return _windowSize;
+}
+
+- (NSUInteger)count
+{
+	return _count;
+}
+
+- (uint64_t)bytesRead
+{
+	return _bytesRead;
+}
+
+- (double)bytesPerSecond
+{
+	if ( !_started ) return 0.0;
+
+	const uint64_t end = ( _finished ) ? _end : CBHSliceReader_nanoseconds();
+	const uint64_t elapsed = end - _start;
+	if ( elapsed <= 0 ) return 0.0;
+
+	return (double)_bytesRead * 1e9 / (double)elapsed;
+}
+
+- (NSError *)error
+{
+	return _error;
+}
+
+
+#pragma mark - Reading
+
+- (void)scheduleFill:(NSUInteger)index
+{
+	if ( _scheduled >= _payloadLength ) return;
+
+	const size_t window = _windowSize * _entrySize;
+	const uint64_t remaining = _payloadLength - _scheduled;
+
+	CBHSliceReaderFill_t *fill = &_fills[index];
+	fill->_offset = _payloadOffset + (off_t)_scheduled;
+	fill->_length = (size_t)MIN((uint64_t)window, remaining);
+	fill->_pending = YES;
+
+	_scheduled += fill->_length;
+
+	/// Keeps the kernel a window ahead of the read that was just queued.
+	CBHSliceReader_adviseWillNeed(_fd, fill->_offset + (off_t)fill->_length, MIN((uint64_t)window, _payloadLength - _scheduled));
+
+	dispatch_group_async_f(_group, _queue, fill, CBHSliceReader_fill);
+}
+
+- (void)finish
+{
+	if ( _finished ) return;
+
+	_finished = YES;
+	_end = CBHSliceReader_nanoseconds();
+}
+
+- (CBHSlice *)nextSlice
+{
+	if ( _finished ) return nil;
+
+	if ( !_started )
+	{
+		_started = YES;
+		_start = CBHSliceReader_nanoseconds();
+		[self scheduleFill:_next];
+	}
+
+	dispatch_group_wait(_group, DISPATCH_TIME_FOREVER);
+
+	CBHSliceReaderFill_t *fill = &_fills[_next];
+	if ( !fill->_pending )
+	{
+		[self finish];
+		return nil;
+	}
+
+	fill->_pending = NO;
+
+	if ( fill->_errno != 0 )
+	{
+		errno = fill->_errno;
+		_fail([NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil]);
+		[self finish];
+		return nil;
+	}
+
+	/// The file shrank while it was being read.
+	if ( fill->_filled < fill->_length )
+	{
+		_fail(_formatError(CBHCollectionFormatErrorTruncated));
+		[self finish];
+		return nil;
+	}
+
+	/// The caller is done with the previous window, so it starts filling now.
+	const NSUInteger current = _next;
+	_next = 1 - _next;
+	[self scheduleFill:_next];
+
+	_CBHSliceWindow *window = _windows[current];
+	[window setCount:fill->_filled / _entrySize];
+	_bytesRead += fill->_filled;
+
+	return window;
+}
+
+- (BOOL)enumerateSlicesUsingBlock:(void (NS_NOESCAPE ^)(CBHSlice *slice, BOOL *stop))block
+{
+	BOOL stop = NO;
+
+	CBHSlice *slice = nil;
+	while ( !stop && (slice = [self nextSlice]) )
+	{
+		@autoreleasepool
+		{
+			block(slice, &stop);
+		}
+	}
+
+	return ( _error == nil );
+}
+
+@end
@@ -0,0 +1,51 @@
+//  _CBHBuffer.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import "CBHAllocation.h"
+
+
+#pragma mark - Allocation
+
+/// Allocates a buffer for `count` entries of `entrySize` as described by `options`. Returns `NULL` on failure.
+void *CBHBuffer_alloc(NSUInteger count, size_t entrySize, BOOL shouldClear, const CBHAllocationOptions *options);
+
+/// Resizes a buffer allocated with the same `options`, keeping its leading entries. A `NULL` buffer is allocated afresh. Returns `NULL` on failure, leaving `data` untouched.
+void *CBHBuffer_realloc(void *data, NSUInteger oldCount, NSUInteger newCount, size_t entrySize, BOOL shouldClear, const CBHAllocationOptions *options);
+
+/// Frees a buffer of `count` entries allocated with the same `options`.
+void CBHBuffer_free(void *data, NSUInteger count, size_t entrySize, const CBHAllocationOptions *options);
+
+
+#pragma mark - Inline Buffers
+
+/// The number of bytes small collections keep inside the object for their first entries, enough for the default capacity of eight objects.
+#define CBHBufferInlineLength ((size_t)64)
+
+/// Allocates an instance of `cls` followed by `CBHBufferInlineLength` bytes of inline storage.
+id CBHBuffer_allocInlineObject(Class cls);
+
+/// The number of bytes an instance of `cls` allocated by `CBHBuffer_allocInlineObject()` occupies.
+size_t CBHBuffer_inlineObjectSize(Class cls);
+
+/// The inline storage of an object allocated by `CBHBuffer_allocInlineObject()`, aligned as `malloc` would align it.
+void *CBHBuffer_inlineBytes(id object);
+
+/// Whether `count` entries of `entrySize` fit inline. Buffers with an alignment, page handling, or allocator of their own are never inline.
+BOOL CBHBuffer_fitsInline(NSUInteger count, size_t entrySize, const CBHAllocationOptions *options);
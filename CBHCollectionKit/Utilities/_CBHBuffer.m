@@ -0,0 +1,195 @@
+//  _CBHBuffer.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "_CBHBuffer.h"
+
+@import CBHMemoryKit;
+
+@import ObjectiveC.runtime;
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+
+#define _isPlain(anOptions) ( (anOptions)->alignment <= 0 && !((anOptions)->flags & CBHAllocationHugePages) )
+
+/// Allocators are always asked for at least what `malloc` guarantees.
+#define _allocatorAlignment(anOptions) MAX((anOptions)->alignment, 2 * sizeof(void *))
+
+/// Indexed ivars are only pointer aligned, the extra pointer's worth of bytes lets them be rounded up.
+#define _inlineAlignment (2 * sizeof(void *))
+
+
+#pragma mark - Pages
+
+static size_t CBHBuffer_pageSize(void)
+{
+	static size_t pageSize;
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		pageSize = (size_t)sysconf(_SC_PAGESIZE);
+	});
+
+	return pageSize;
+}
+
+/// Writes each page back to itself, faulting it in without changing its contents.
+static void CBHBuffer_prefault(void *data, size_t offset, size_t length)
+{
+	volatile uint8_t *bytes = (volatile uint8_t *)data;
+	const size_t pageSize = CBHBuffer_pageSize();
+
+	for (size_t i = offset; i < offset + length; i += pageSize) { bytes[i] = bytes[i]; }
+}
+
+/// The alignment and rounded length of a buffer of `length` bytes.
+static size_t CBHBuffer_layout(size_t length, const CBHAllocationOptions *options, size_t *alignment)
+{
+	*alignment = MAX(options->alignment, sizeof(void *));
+
+	if ( (options->flags & CBHAllocationHugePages) && length >= CBHHugePageSize )
+	{
+		*alignment = MAX(*alignment, CBHHugePageSize);
+		return (length + CBHHugePageSize - 1) & ~(CBHHugePageSize - 1);
+	}
+
+	/// Zero length allocations are still unique pointers.
+	return MAX(length, (size_t)1);
+}
+
+static void *CBHBuffer_allocAligned(size_t length, const CBHAllocationOptions *options)
+{
+	size_t alignment = 0;
+	const size_t rounded = CBHBuffer_layout(length, options, &alignment);
+
+	void *data = NULL;
+	if ( posix_memalign(&data, alignment, rounded) != 0 ) return NULL;
+
+#if defined(MADV_HUGEPAGE)
+	if ( alignment >= CBHHugePageSize ) madvise(data, rounded, MADV_HUGEPAGE);
+#endif
+
+	return data;
+}
+
+
+#pragma mark - Allocation
+
+void *CBHBuffer_alloc(NSUInteger count, size_t entrySize, BOOL shouldClear, const CBHAllocationOptions *options)
+{
+	if ( CBHMemory_willOverflow(count, entrySize) ) return NULL;
+	const size_t length = count * entrySize;
+
+	void *data = NULL;
+	if ( options->allocator )
+	{
+		data = options->allocator->alloc(length, _allocatorAlignment(options), options->allocator->context);
+		if ( data && shouldClear ) memset(data, 0, length);
+	}
+	else if ( _isPlain(options) )
+	{
+		data = ( shouldClear ) ? CBHMemory_calloc(count, entrySize) : CBHMemory_alloc(count, entrySize);
+	}
+	else
+	{
+		data = CBHBuffer_allocAligned(length, options);
+		if ( data && shouldClear ) memset(data, 0, length);
+	}
+
+	if ( data && (options->flags & CBHAllocationPrefault) ) CBHBuffer_prefault(data, 0, length);
+
+	return data;
+}
+
+void *CBHBuffer_realloc(void *data, NSUInteger oldCount, NSUInteger newCount, size_t entrySize, BOOL shouldClear, const CBHAllocationOptions *options)
+{
+	/// A buffer given up to shared storage has nothing to keep, and allocators needn't accept `NULL`.
+	if ( !data ) return CBHBuffer_alloc(newCount, entrySize, shouldClear, options);
+
+	if ( CBHMemory_willOverflow(newCount, entrySize) ) return NULL;
+
+	const size_t oldLength = oldCount * entrySize;
+	const size_t newLength = newCount * entrySize;
+
+	void *resized = NULL;
+	if ( options->allocator )
+	{
+		resized = options->allocator->realloc(data, oldLength, newLength, _allocatorAlignment(options), options->allocator->context);
+		if ( resized && shouldClear && newLength > oldLength ) memset((uint8_t *)resized + oldLength, 0, newLength - oldLength);
+	}
+	else if ( _isPlain(options) )
+	{
+		resized = ( shouldClear ) ? CBHMemory_recalloc(data, oldCount, newCount, entrySize) : CBHMemory_realloc(data, newCount, entrySize);
+	}
+	else
+	{
+		/// There is no aligned realloc, so the entries are moved to a new buffer.
+		resized = CBHBuffer_allocAligned(newLength, options);
+		if ( !resized ) return NULL;
+
+		memcpy(resized, data, MIN(oldLength, newLength));
+		if ( shouldClear && newLength > oldLength ) memset((uint8_t *)resized + oldLength, 0, newLength - oldLength);
+
+		free(data);
+	}
+
+	if ( resized && (options->flags & CBHAllocationPrefault) && newLength > oldLength ) CBHBuffer_prefault(resized, oldLength, newLength - oldLength);
+
+	return resized;
+}
+
+void CBHBuffer_free(void *data, NSUInteger count, size_t entrySize, const CBHAllocationOptions *options)
+{
+	if ( !data ) return;
+
+	if ( options->allocator )
+	{
+		options->allocator->free(data, count * entrySize, _allocatorAlignment(options), options->allocator->context);
+		return;
+	}
+
+	free(data);
+}
+
+
+#pragma mark - Inline Buffers
+
+id CBHBuffer_allocInlineObject(Class cls)
+{
+	return class_createInstance(cls, CBHBufferInlineLength + sizeof(void *));
+}
+
+size_t CBHBuffer_inlineObjectSize(Class cls)
+{
+	return class_getInstanceSize(cls) + CBHBufferInlineLength + sizeof(void *);
+}
+
+void *CBHBuffer_inlineBytes(id object)
+{
+	const uintptr_t bytes = (uintptr_t)object_getIndexedIvars(object);
+	return (void *)((bytes + _inlineAlignment - 1) & ~(uintptr_t)(_inlineAlignment - 1));
+}
+
+BOOL CBHBuffer_fitsInline(NSUInteger count, size_t entrySize, const CBHAllocationOptions *options)
+{
+	if ( options->allocator || options->flags != CBHAllocationFlagsNone || options->alignment > _inlineAlignment ) return NO;
+	if ( CBHMemory_willOverflow(count, entrySize) ) return NO;
+
+	return ( count * entrySize <= CBHBufferInlineLength );
+}
@@ -0,0 +1,46 @@
+//  _CBHChecksum.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+
+#pragma mark - Type
+
+/// A checksum which can be computed over bytes arriving in pieces.
+///
+/// The result doesn't depend on how the bytes are split or on the host's byte order.
+typedef struct CBHChecksum_t {
+	uint64_t _lanes[4];
+	uint64_t _length;
+
+	/// Bytes waiting for a full block.
+	uint8_t _pending[32];
+	size_t _pendingLength;
+} CBHChecksum_t;
+
+
+#pragma mark - Computing
+
+CBHChecksum_t CBHChecksum_init(void);
+void CBHChecksum_update(CBHChecksum_t *checksum, const void *bytes, size_t length);
+
+/// The checksum of all bytes given so far. Never zero, which means no checksum was recorded.
+uint64_t CBHChecksum_final(const CBHChecksum_t *checksum);
+
+/// The checksum of `length` bytes at `bytes`.
+uint64_t CBHChecksum(const void *bytes, size_t length);
@@ -0,0 +1,135 @@
+//  _CBHChecksum.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "_CBHChecksum.h"
+
+#include <libkern/OSByteOrder.h>
+
+
+/// The rounds and avalanche of xxHash64, over four independent lanes so the multiplies pipeline.
+#define kPrime1 0x9E3779B97F4A7C15ULL
+#define kPrime2 0xC2B2AE3D27D4EB4FULL
+#define kPrime3 0x165667B19E3779F9ULL
+
+#define _rotate(aValue, aBits) (((aValue) << (aBits)) | ((aValue) >> (64 - (aBits))))
+
+
+static inline uint64_t _load(const uint8_t *bytes)
+{
+	uint64_t word;
+	memcpy(&word, bytes, sizeof(word));
+
+	return OSSwapLittleToHostInt64(word);
+}
+
+static inline uint64_t _round(uint64_t lane, uint64_t word)
+{
+	lane += word * kPrime2;
+	lane = _rotate(lane, 31);
+
+	return lane * kPrime1;
+}
+
+static inline void _block(uint64_t lanes[4], const uint8_t *bytes)
+{
+	lanes[0] = _round(lanes[0], _load(bytes));
+	lanes[1] = _round(lanes[1], _load(bytes + 8));
+	lanes[2] = _round(lanes[2], _load(bytes + 16));
+	lanes[3] = _round(lanes[3], _load(bytes + 24));
+}
+
+
+#pragma mark - Computing
+
+CBHChecksum_t CBHChecksum_init(void)
+{
+	CBHChecksum_t retVal;
+	memset(&retVal, 0, sizeof(retVal));
+
+	retVal._lanes[0] = kPrime1 + kPrime2;
+	retVal._lanes[1] = kPrime2;
+	retVal._lanes[2] = 0;
+	retVal._lanes[3] = (uint64_t)0 - kPrime1;
+
+	return retVal;
+}
+
+void CBHChecksum_update(CBHChecksum_t *checksum, const void *bytes, size_t length)
+{
+	const uint8_t *cursor = bytes;
+	checksum->_length += length;
+
+	/// Finish a block started by an earlier update.
+	if ( checksum->_pendingLength > 0 )
+	{
+		const size_t needed = sizeof(checksum->_pending) - checksum->_pendingLength;
+		const size_t taken = ( length < needed ) ? length : needed;
+
+		memcpy(checksum->_pending + checksum->_pendingLength, cursor, taken);
+		checksum->_pendingLength += taken;
+		cursor += taken;
+		length -= taken;
+
+		if ( checksum->_pendingLength < sizeof(checksum->_pending) ) return;
+
+		_block(checksum->_lanes, checksum->_pending);
+		checksum->_pendingLength = 0;
+	}
+
+	while ( length >= 32 )
+	{
+		_block(checksum->_lanes, cursor);
+		cursor += 32;
+		length -= 32;
+	}
+
+	memcpy(checksum->_pending, cursor, length);
+	checksum->_pendingLength = length;
+}
+
+uint64_t CBHChecksum_final(const CBHChecksum_t *checksum)
+{
+	uint64_t lanes[4] = {checksum->_lanes[0], checksum->_lanes[1], checksum->_lanes[2], checksum->_lanes[3]};
+
+	/// The tail is zero padded, the length tells it apart from real zeros.
+	if ( checksum->_pendingLength > 0 )
+	{
+		uint8_t tail[32] = {0};
+		memcpy(tail, checksum->_pending, checksum->_pendingLength);
+		_block(lanes, tail);
+	}
+
+	uint64_t hash = _rotate(lanes[0], 1) + _rotate(lanes[1], 7) + _rotate(lanes[2], 12) + _rotate(lanes[3], 18);
+	hash ^= checksum->_length * kPrime1;
+
+	hash ^= hash >> 33;
+	hash *= kPrime2;
+	hash ^= hash >> 29;
+	hash *= kPrime3;
+	hash ^= hash >> 32;
+
+	return ( hash != 0 ) ? hash : 1;
+}
+
+uint64_t CBHChecksum(const void *bytes, size_t length)
+{
+	CBHChecksum_t checksum = CBHChecksum_init();
+	CBHChecksum_update(&checksum, bytes, length);
+
+	return CBHChecksum_final(&checksum);
+}
@@ -0,0 +1,54 @@
+//  _CBHHash.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+
+#pragma mark - Mixing
+
+/// Multiplies two words into 128 bits, leaving the low half in `a` and the high half in `b`.
+static inline void CBHHash_multiply(uint64_t *a, uint64_t *b)
+{
+#if defined(__SIZEOF_INT128__)
+	const __uint128_t product = (__uint128_t)*a * *b;
+	*a = (uint64_t)product;
+	*b = (uint64_t)(product >> 64);
+#else
+	const uint64_t aHigh = *a >> 32, aLow = (uint32_t)*a;
+	const uint64_t bHigh = *b >> 32, bLow = (uint32_t)*b;
+
+	const uint64_t low = aLow * bLow, middle0 = aHigh * bLow, middle1 = aLow * bHigh, high = aHigh * bHigh;
+	const uint64_t carry = ((low >> 32) + (uint32_t)middle0 + (uint32_t)middle1) >> 32;
+
+	*a = low + (middle0 << 32) + (middle1 << 32);
+	*b = high + (middle0 >> 32) + (middle1 >> 32) + carry;
+#endif
+}
+
+/// Mixes two words into one, every bit of either affecting every bit of the result.
+static inline uint64_t CBHHash_mix(uint64_t a, uint64_t b)
+{
+	CBHHash_multiply(&a, &b);
+	return a ^ b;
+}
+
+
+#pragma mark - Hashing
+
+/// Hashes every byte of `bytes`. Not stable across processes or byte orders, use `CBHChecksum()` for anything stored.
+uint64_t CBHHash(const void *bytes, size_t length, uint64_t seed);
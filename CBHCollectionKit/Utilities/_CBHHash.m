@@ -0,0 +1,115 @@
+//  _CBHHash.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "_CBHHash.h"
+
+
+/// wyhash: each step multiplies two words of input into 128 bits and folds the halves together.
+static const uint64_t kSecret[4] = {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull};
+
+
+static inline uint64_t _load8(const uint8_t *bytes)
+{
+	uint64_t word;
+	memcpy(&word, bytes, sizeof(word));
+
+	return word;
+}
+
+static inline uint64_t _load4(const uint8_t *bytes)
+{
+	uint32_t word;
+	memcpy(&word, bytes, sizeof(word));
+
+	return word;
+}
+
+/// Reads one to three bytes as one word, touching no byte past the end.
+static inline uint64_t _load3(const uint8_t *bytes, size_t length)
+{
+	return ((uint64_t)bytes[0] << 16) | ((uint64_t)bytes[length >> 1] << 8) | bytes[length - 1];
+}
+
+
+#pragma mark - Hashing
+
+uint64_t CBHHash(const void *bytes, size_t length, uint64_t seed)
+{
+	const uint8_t *pointer = (const uint8_t *)bytes;
+	uint64_t a = 0;
+	uint64_t b = 0;
+
+	seed ^= CBHHash_mix(seed ^ kSecret[0], kSecret[1]);
+
+	if ( length <= 16 )
+	{
+		/// Short inputs are read as two possibly overlapping pairs of words, without a loop.
+		if ( length >= 4 )
+		{
+			const size_t stride = (length >> 3) << 2;
+			a = (_load4(pointer) << 32) | _load4(pointer + stride);
+			b = (_load4(pointer + length - 4) << 32) | _load4(pointer + length - 4 - stride);
+		}
+		else if ( length > 0 )
+		{
+			a = _load3(pointer, length);
+		}
+	}
+	else
+	{
+		size_t remaining = length;
+
+		/// Three independent lanes per 48 bytes, so the multiplies overlap.
+		if ( remaining >= 48 )
+		{
+			uint64_t lane1 = seed;
+			uint64_t lane2 = seed;
+
+			do
+			{
+				seed = CBHHash_mix(_load8(pointer) ^ kSecret[1], _load8(pointer + 8) ^ seed);
+				lane1 = CBHHash_mix(_load8(pointer + 16) ^ kSecret[2], _load8(pointer + 24) ^ lane1);
+				lane2 = CBHHash_mix(_load8(pointer + 32) ^ kSecret[3], _load8(pointer + 40) ^ lane2);
+
+				pointer += 48;
+				remaining -= 48;
+			}
+			while ( remaining >= 48 );
+
+			seed ^= lane1 ^ lane2;
+		}
+
+		while ( remaining > 16 )
+		{
+			seed = CBHHash_mix(_load8(pointer) ^ kSecret[1], _load8(pointer + 8) ^ seed);
+
+			pointer += 16;
+			remaining -= 16;
+		}
+
+		/// The last sixteen bytes, overlapping bytes already mixed if need be.
+		a = _load8(pointer + remaining - 16);
+		b = _load8(pointer + remaining - 8);
+	}
+
+	a ^= kSecret[1];
+	b ^= seed;
+	CBHHash_multiply(&a, &b);
+
+	return CBHHash_mix(a ^ kSecret[0] ^ (uint64_t)length, b ^ kSecret[1]);
+}
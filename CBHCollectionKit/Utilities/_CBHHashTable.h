@@ -0,0 +1,93 @@
+//  _CBHHashTable.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import "_CBHSlice.h"
+#import "_CBHSlice_t.h"
+
+
+#pragma mark - Type
+
+/// An open-addressed table of fixed-size keys, each optionally paired with a fixed-size value.
+///
+/// Each slot has a control byte, `CBHHashTableEmpty` or seven bits of its key's hash, so a probe rejects most slots sixteen at a time without touching their keys. Keys are placed by linear probing, and removal shifts later entries back instead of leaving tombstones.
+typedef struct CBHHashTable_t {
+	/// One byte per slot, then the first group repeated so a group can start at any slot.
+	CBHSlice_t _control;
+	CBHSlice_t _keys;
+
+	/// Empty, with an entry size of zero, when the table holds only keys.
+	CBHSlice_t _values;
+
+	NSUInteger _count;
+
+	/// The number of slots, a power of two, less one.
+	NSUInteger _mask;
+} CBHHashTable_t;
+
+#define CBHHashTableEmpty ((uint8_t)0x80)
+
+#define CBHHashTable_slotCount(aTable) ((aTable)->_mask + 1)
+#define CBHHashTable_isFull(aTable, aSlot) (((const uint8_t *)(aTable)->_control._data)[(aSlot)] != CBHHashTableEmpty)
+#define CBHHashTable_keyAtSlot(aTable, aSlot) ((uint8_t *)(aTable)->_keys._data + ((aSlot) * (aTable)->_keys._entrySize))
+#define CBHHashTable_valueAtSlot(aTable, aSlot) ((uint8_t *)(aTable)->_values._data + ((aSlot) * (aTable)->_values._entrySize))
+
+
+#pragma mark - Initializers
+
+/// Initializes a table which fits `capacity` entries before growing.
+CBHHashTable_t CBHHashTable_init(NSUInteger capacity, size_t keySize, size_t valueSize);
+CBHHashTable_t CBHHashTable_initCopying(const CBHHashTable_t *table);
+
+
+#pragma mark - Destructors
+
+void CBHHashTable_dealloc(CBHHashTable_t *table);
+
+
+#pragma mark - Hashing
+
+uint64_t CBHHashTable_hash(const void *key, size_t keySize);
+
+
+#pragma mark - Capacity
+
+/// The number of entries which fit before the table grows, seven eighths of its slots.
+NSUInteger CBHHashTable_capacity(const CBHHashTable_t *table);
+
+/// Rehashes into the fewest slots which fit `capacity` entries, or the table's entries if more.
+void CBHHashTable_setCapacity(CBHHashTable_t *table, NSUInteger capacity);
+
+
+#pragma mark - Lookup
+
+/// The slot holding `key`, or `NSNotFound`.
+NSUInteger CBHHashTable_find(const CBHHashTable_t *table, const void *key);
+
+/// Finds `count` consecutive keys, writing each one's slot or `NSNotFound` to `slots`.
+void CBHHashTable_findMany(const CBHHashTable_t *table, const void *keys, NSUInteger count, NSUInteger *slots);
+
+
+#pragma mark - Mutators
+
+/// The slot holding `key`, inserting it and growing first if needed. `didInsert` is set if the key is new, in which case the slot's value is uninitialized.
+NSUInteger CBHHashTable_insert(CBHHashTable_t *table, const void *key, BOOL *didInsert);
+
+BOOL CBHHashTable_remove(CBHHashTable_t *table, const void *key);
+void CBHHashTable_removeAll(CBHHashTable_t *table);
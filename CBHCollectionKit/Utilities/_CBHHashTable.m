@@ -0,0 +1,352 @@
+//  _CBHHashTable.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "_CBHHashTable.h"
+
+@import Foundation.NSException;
+@import CBHMemoryKit;
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+
+#define GROUP_WIDTH ((NSUInteger)16)
+#define BATCH_LENGTH ((NSUInteger)16)
+
+#define _control(aTable) ((uint8_t *)(aTable)->_control._data)
+
+/// The low seven bits of a hash go in the control byte, the rest pick the home slot.
+#define _tag(aHash) ((uint8_t)((aHash) & 0x7F))
+#define _home(aTable, aHash) ((NSUInteger)((aHash) >> 7) & (aTable)->_mask)
+
+
+#pragma mark - Groups
+
+#if defined(__ARM_NEON)
+/// NEON has no byte mask, so each byte of a group becomes a nibble of which only the top bit is kept.
+#define GROUP_SHIFT 2
+#else
+#define GROUP_SHIFT 0
+#endif
+
+#define _lowestMatch(aMask) ((NSUInteger)__builtin_ctzll(aMask) >> GROUP_SHIFT)
+
+/// A mask with a bit for each of the sixteen control bytes from `control` equal to `byte`.
+static inline uint64_t CBHHashTable_match(const uint8_t *control, uint8_t byte)
+{
+#if defined(__SSE2__)
+	const __m128i group = _mm_loadu_si128((const __m128i *)(const void *)control);
+	return (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)byte)));
+#elif defined(__ARM_NEON)
+	const uint8x16_t matches = vceqq_u8(vld1q_u8(control), vdupq_n_u8(byte));
+	return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0) & 0x8888888888888888ull;
+#else
+	uint64_t mask = 0;
+	for (NSUInteger i = 0; i < GROUP_WIDTH; ++i) { mask |= (uint64_t)(control[i] == byte) << i; }
+	return mask;
+#endif
+}
+
+static inline void CBHHashTable_setControl(CBHHashTable_t *table, NSUInteger slot, uint8_t byte)
+{
+	_control(table)[slot] = byte;
+
+	/// Keep the copy of the first group in step.
+	if ( slot < GROUP_WIDTH ) { _control(table)[CBHHashTable_slotCount(table) + slot] = byte; }
+}
+
+static inline BOOL CBHHashTable_equal(const void *a, const void *b, size_t keySize)
+{
+	switch ( keySize )
+	{
+		case 4: { uint32_t x, y; memcpy(&x, a, 4); memcpy(&y, b, 4); return ( x == y ); }
+		case 8: { uint64_t x, y; memcpy(&x, a, 8); memcpy(&y, b, 8); return ( x == y ); }
+		default: return ( memcmp(a, b, keySize) == 0 );
+	}
+}
+
+
+#pragma mark - Initializers
+
+/// The fewest slots, a power of two no smaller than a group, which fit `capacity` entries.
+static NSUInteger CBHHashTable_slotsFor(NSUInteger capacity)
+{
+	if ( capacity > (NSUIntegerMax / 8) ) @throw NSRangeException;
+
+	const NSUInteger needed = ((capacity * 8) + 6) / 7;
+
+	NSUInteger slots = GROUP_WIDTH;
+	while ( slots < needed ) { slots <<= 1; }
+
+	return slots;
+}
+
+static CBHHashTable_t CBHHashTable_initWithSlots(NSUInteger slots, size_t keySize, size_t valueSize)
+{
+	CBHHashTable_t retVal;
+
+	retVal._control = CBHSlice_init(slots + GROUP_WIDTH, sizeof(uint8_t), NO);
+	memset(retVal._control._data, CBHHashTableEmpty, slots + GROUP_WIDTH);
+
+	retVal._keys = CBHSlice_init(slots, keySize, NO);
+	retVal._values = ( valueSize > 0 ) ? CBHSlice_init(slots, valueSize, NO) : CBHSlice_initOwningBytes(NULL, 0, 0);
+
+	retVal._count = 0;
+	retVal._mask = slots - 1;
+
+	return retVal;
+}
+
+CBHHashTable_t CBHHashTable_init(NSUInteger capacity, size_t keySize, size_t valueSize)
+{
+	return CBHHashTable_initWithSlots(CBHHashTable_slotsFor(capacity), keySize, valueSize);
+}
+
+CBHHashTable_t CBHHashTable_initCopying(const CBHHashTable_t *table)
+{
+	CBHHashTable_t retVal;
+	const NSUInteger slots = CBHHashTable_slotCount(table);
+
+	retVal._control = CBHSlice_initCopyingBytes(table->_control._data, sizeof(uint8_t), slots + GROUP_WIDTH);
+	retVal._keys = CBHSlice_initCopyingBytes(table->_keys._data, table->_keys._entrySize, slots);
+	retVal._values = ( table->_values._entrySize > 0 ) ? CBHSlice_initCopyingBytes(table->_values._data, table->_values._entrySize, slots) : CBHSlice_initOwningBytes(NULL, 0, 0);
+
+	retVal._count = table->_count;
+	retVal._mask = table->_mask;
+
+	return retVal;
+}
+
+
+#pragma mark - Destructors
+
+void CBHHashTable_dealloc(CBHHashTable_t *table)
+{
+	CBHSlice_dealloc(&table->_control);
+	CBHSlice_dealloc(&table->_keys);
+	if ( table->_values._entrySize > 0 ) { CBHSlice_dealloc(&table->_values); }
+}
+
+
+#pragma mark - Hashing
+
+/// The finalizer of MurmurHash3, every bit of the input affects every bit of the output.
+static inline uint64_t CBHHashTable_mix(uint64_t value)
+{
+	value ^= value >> 33;
+	value *= 0xff51afd7ed558ccdull;
+	value ^= value >> 33;
+	value *= 0xc4ceb9fe1a85ec53ull;
+	value ^= value >> 33;
+
+	return value;
+}
+
+uint64_t CBHHashTable_hash(const void *key, size_t keySize)
+{
+	const uint8_t *bytes = (const uint8_t *)key;
+	uint64_t hash = (uint64_t)keySize * 0x9e3779b97f4a7c15ull;
+
+	for (; keySize >= sizeof(uint64_t); keySize -= sizeof(uint64_t), bytes += sizeof(uint64_t))
+	{
+		uint64_t word;
+		memcpy(&word, bytes, sizeof(uint64_t));
+		hash = CBHHashTable_mix(hash ^ word);
+	}
+
+	if ( keySize > 0 )
+	{
+		uint64_t word = 0;
+		memcpy(&word, bytes, keySize);
+		hash = CBHHashTable_mix(hash ^ word);
+	}
+
+	return hash;
+}
+
+
+#pragma mark - Capacity
+
+NSUInteger CBHHashTable_capacity(const CBHHashTable_t *table)
+{
+	return (CBHHashTable_slotCount(table) / 8) * 7;
+}
+
+/// The first empty slot at or after the home of `hash`.
+static NSUInteger CBHHashTable_emptySlot(const CBHHashTable_t *table, uint64_t hash)
+{
+	NSUInteger position = _home(table, hash);
+
+	for (;;)
+	{
+		const uint64_t empties = CBHHashTable_match(_control(table) + position, CBHHashTableEmpty);
+		if ( empties ) return (position + _lowestMatch(empties)) & table->_mask;
+
+		position = (position + GROUP_WIDTH) & table->_mask;
+	}
+}
+
+void CBHHashTable_setCapacity(CBHHashTable_t *table, NSUInteger capacity)
+{
+	const NSUInteger slots = CBHHashTable_slotsFor(MAX(capacity, table->_count));
+	if ( slots == CBHHashTable_slotCount(table) ) return;
+
+	CBHHashTable_t resized = CBHHashTable_initWithSlots(slots, table->_keys._entrySize, table->_values._entrySize);
+
+	/// Keys are already unique, so each goes straight in the first empty slot from its home.
+	for (NSUInteger slot = 0; slot < CBHHashTable_slotCount(table); ++slot)
+	{
+		if ( !CBHHashTable_isFull(table, slot) ) continue;
+
+		const void *key = CBHHashTable_keyAtSlot(table, slot);
+		const uint64_t hash = CBHHashTable_hash(key, table->_keys._entrySize);
+		const NSUInteger destination = CBHHashTable_emptySlot(&resized, hash);
+
+		CBHHashTable_setControl(&resized, destination, _tag(hash));
+		memcpy(CBHHashTable_keyAtSlot(&resized, destination), key, table->_keys._entrySize);
+		if ( table->_values._entrySize > 0 ) { memcpy(CBHHashTable_valueAtSlot(&resized, destination), CBHHashTable_valueAtSlot(table, slot), table->_values._entrySize); }
+	}
+
+	resized._count = table->_count;
+
+	CBHHashTable_dealloc(table);
+	*table = resized;
+}
+
+
+#pragma mark - Lookup
+
+static inline NSUInteger CBHHashTable_findHashed(const CBHHashTable_t *table, const void *key, uint64_t hash)
+{
+	const size_t keySize = table->_keys._entrySize;
+	const uint8_t tag = _tag(hash);
+	NSUInteger position = _home(table, hash);
+
+	for (;;)
+	{
+		const uint8_t *group = _control(table) + position;
+
+		for (uint64_t matches = CBHHashTable_match(group, tag); matches; matches &= matches - 1)
+		{
+			const NSUInteger slot = (position + _lowestMatch(matches)) & table->_mask;
+			if ( CBHHashTable_equal(CBHHashTable_keyAtSlot(table, slot), key, keySize) ) return slot;
+		}
+
+		/// Probing never passes an empty slot, so the key would have been in this group.
+		if ( CBHHashTable_match(group, CBHHashTableEmpty) ) return NSNotFound;
+
+		position = (position + GROUP_WIDTH) & table->_mask;
+	}
+}
+
+NSUInteger CBHHashTable_find(const CBHHashTable_t *table, const void *key)
+{
+	return CBHHashTable_findHashed(table, key, CBHHashTable_hash(key, table->_keys._entrySize));
+}
+
+void CBHHashTable_findMany(const CBHHashTable_t *table, const void *keys, NSUInteger count, NSUInteger *slots)
+{
+	const size_t keySize = table->_keys._entrySize;
+	const uint8_t *bytes = (const uint8_t *)keys;
+	uint64_t hashes[BATCH_LENGTH];
+
+	for (NSUInteger start = 0; start < count; start += BATCH_LENGTH)
+	{
+		const NSUInteger length = MIN(BATCH_LENGTH, count - start);
+
+		/// Hash the batch and prefetch every home first, so the cache misses overlap instead of following one another.
+		for (NSUInteger i = 0; i < length; ++i)
+		{
+			hashes[i] = CBHHashTable_hash(bytes + ((start + i) * keySize), keySize);
+
+			const NSUInteger home = _home(table, hashes[i]);
+			__builtin_prefetch(_control(table) + home);
+			__builtin_prefetch(CBHHashTable_keyAtSlot(table, home));
+		}
+
+		for (NSUInteger i = 0; i < length; ++i)
+		{
+			slots[start + i] = CBHHashTable_findHashed(table, bytes + ((start + i) * keySize), hashes[i]);
+		}
+	}
+}
+
+
+#pragma mark - Mutators
+
+NSUInteger CBHHashTable_insert(CBHHashTable_t *table, const void *key, BOOL *didInsert)
+{
+	const size_t keySize = table->_keys._entrySize;
+	const uint64_t hash = CBHHashTable_hash(key, keySize);
+
+	const NSUInteger existing = CBHHashTable_findHashed(table, key, hash);
+	if ( existing != NSNotFound )
+	{
+		*didInsert = NO;
+		return existing;
+	}
+
+	if ( table->_count >= CBHHashTable_capacity(table) ) { CBHHashTable_setCapacity(table, CBHHashTable_capacity(table) * 2); }
+
+	const NSUInteger slot = CBHHashTable_emptySlot(table, hash);
+	CBHHashTable_setControl(table, slot, _tag(hash));
+	memcpy(CBHHashTable_keyAtSlot(table, slot), key, keySize);
+
+	++table->_count;
+	*didInsert = YES;
+
+	return slot;
+}
+
+BOOL CBHHashTable_remove(CBHHashTable_t *table, const void *key)
+{
+	NSUInteger hole = CBHHashTable_find(table, key);
+	if ( hole == NSNotFound ) return NO;
+
+	const size_t keySize = table->_keys._entrySize;
+	const size_t valueSize = table->_values._entrySize;
+
+	/// Shift back each following entry which may live in the hole, until an empty slot ends the run.
+	for (NSUInteger slot = (hole + 1) & table->_mask; CBHHashTable_isFull(table, slot); slot = (slot + 1) & table->_mask)
+	{
+		const NSUInteger home = _home(table, CBHHashTable_hash(CBHHashTable_keyAtSlot(table, slot), keySize));
+
+		/// Entries whose home lies after the hole would be unreachable from it.
+		if ( ((slot - home) & table->_mask) < ((slot - hole) & table->_mask) ) continue;
+
+		CBHHashTable_setControl(table, hole, _control(table)[slot]);
+		memcpy(CBHHashTable_keyAtSlot(table, hole), CBHHashTable_keyAtSlot(table, slot), keySize);
+		if ( valueSize > 0 ) { memcpy(CBHHashTable_valueAtSlot(table, hole), CBHHashTable_valueAtSlot(table, slot), valueSize); }
+
+		hole = slot;
+	}
+
+	CBHHashTable_setControl(table, hole, CBHHashTableEmpty);
+	--table->_count;
+
+	return YES;
+}
+
+void CBHHashTable_removeAll(CBHHashTable_t *table)
+{
+	memset(table->_control._data, CBHHashTableEmpty, CBHHashTable_slotCount(table) + GROUP_WIDTH);
+	table->_count = 0;
+}
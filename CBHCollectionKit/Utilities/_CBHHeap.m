@@ -48,7 +48,13 @@ const void *CBHHeap_extractValue(CBHQueue_t *heap, NSComparator comparator)
 {
 	_guardNotEmptyReturn(nil);
 
-	const void *retVal = CBHQueue_dequeue(heap);
+	/// The last entry replaces the root and sinks, so nothing else moves.
+	void **root = CBHQueue_pointerToIndex(heap, 0);
+	const void *retVal = *root;
+
+	*root = *(void **)CBHQueue_pointerToIndex(heap, heap->_count - 1);
+	--(heap->_count);
+
 	CBHHeap_downHeap(heap, 0, comparator);
 
 	return retVal;
@@ -62,21 +68,23 @@ void CBHHeap_downHeap(CBHQueue_t *heap, const NSUInteger index, NSComparator com
 	_guardNotEmpty();
 	_guardIndexInBounds(index);
 
-	void *p = (void *)CBHQueue_pointerAtIndex(heap, index);
+	NSUInteger currentIndex = index;
+
+	while ( YES )
+	{
+		NSUInteger nextIndex = currentIndex;
 
-	NSUInteger aIndex = _firstChildOf(index);
-	if ( heap->_count <= aIndex) return;
-	void *a = (void *)CBHQueue_pointerAtIndex(heap, aIndex);
-	if ( comparator((__bridge id)p, (__bridge id)a) != (NSComparisonResult)NSOrderedAscending ) CBHHeap_swapIndeces(heap, index, aIndex);
-	CBHHeap_downHeap(heap, aIndex, comparator);
+		const NSUInteger aIndex = _firstChildOf(currentIndex);
+		const NSUInteger bIndex = _secondChildOf(currentIndex);
 
-	NSUInteger bIndex = aIndex + 1;
-	if ( heap->_count <= bIndex) return;
-	void *b = (void *)CBHQueue_pointerAtIndex(heap, bIndex);
-	if ( comparator((__bridge id)p, (__bridge id)b) != (NSComparisonResult)NSOrderedAscending ) CBHHeap_swapIndeces(heap, index, bIndex);
-	CBHHeap_downHeap(heap, bIndex, comparator);
+		if ( aIndex < heap->_count && comparator((__bridge id)CBHQueue_pointerAtIndex(heap, aIndex), (__bridge id)CBHQueue_pointerAtIndex(heap, nextIndex)) == (NSComparisonResult)NSOrderedAscending ) nextIndex = aIndex;
+		if ( bIndex < heap->_count && comparator((__bridge id)CBHQueue_pointerAtIndex(heap, bIndex), (__bridge id)CBHQueue_pointerAtIndex(heap, nextIndex)) == (NSComparisonResult)NSOrderedAscending ) nextIndex = bIndex;
 
-	//CBHQueue_swapPointers(&_queue, *(void **)a, *(void **)b);
+		if ( nextIndex == currentIndex ) break;
+
+		CBHHeap_swapIndeces(heap, currentIndex, nextIndex);
+		currentIndex = nextIndex;
+	}
 }
 
 void CBHHeap_upHeap(CBHQueue_t *heap, const NSUInteger index, NSComparator comparator)
@@ -0,0 +1,53 @@
+//  _CBHMappedFile.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+
+#pragma mark - Mapped File
+
+/// A file mapped into memory with `mmap`. Unmaps the file when deallocated.
+///
+/// Used as the owner of the bytes of a file-backed slice.
+@interface _CBHMappedFile : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+- (instancetype)initWithPath:(NSString *)path writable:(BOOL)writable error:(NSError **)error NS_DESIGNATED_INITIALIZER;
+
+@end
+
+
+#pragma mark - Access
+
+/// Whether `owner` is a mapped file.
+BOOL CBHMappedFile_isMappedFile(id owner);
+
+/// The first byte of the mapping, or `NULL` if the file is empty.
+void *CBHMappedFile_bytes(_CBHMappedFile *file);
+
+/// The length of the mapping in bytes.
+size_t CBHMappedFile_length(_CBHMappedFile *file);
+
+
+#pragma mark - Paging
+
+/// Passes `advice` to `madvise` for the pages covering `length` bytes at `bytes`.
+void CBHMappedFile_advise(_CBHMappedFile *file, const void *bytes, size_t length, int advice);
+
+/// Writes the dirty pages covering `length` bytes at `bytes` back to the file. Returns `NO` if `msync` fails.
+BOOL CBHMappedFile_sync(_CBHMappedFile *file, const void *bytes, size_t length);
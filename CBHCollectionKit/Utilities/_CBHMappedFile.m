@@ -0,0 +1,143 @@
+//  _CBHMappedFile.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "_CBHMappedFile.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+#define _setPOSIXError(anError) if ( anError ) *(anError) = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:@{NSFilePathErrorKey: path}]
+
+
+@implementation _CBHMappedFile
+{
+	void *_bytes;
+	size_t _length;
+}
+
+#pragma mark - Initialization
+
+- (instancetype)initWithPath:(NSString *)path writable:(BOOL)writable error:(NSError **)error
+{
+	if ( !(self = [super init]) ) return nil;
+
+	int fd = open([path fileSystemRepresentation], (writable) ? O_RDWR : O_RDONLY);
+	if ( fd < 0 )
+	{
+		_setPOSIXError(error);
+		[self release];
+		return nil;
+	}
+
+	struct stat info;
+	if ( fstat(fd, &info) != 0 )
+	{
+		_setPOSIXError(error);
+		close(fd);
+		[self release];
+		return nil;
+	}
+
+	/// Empty files can't be mapped and have nothing to page in anyway.
+	_length = (size_t)info.st_size;
+	if ( _length > 0 )
+	{
+		const int protection = (writable) ? (PROT_READ | PROT_WRITE) : PROT_READ;
+		void *bytes = mmap(NULL, _length, protection, MAP_SHARED, fd, 0);
+		if ( bytes == MAP_FAILED )
+		{
+			_setPOSIXError(error);
+			close(fd);
+			[self release];
+			return nil;
+		}
+
+		_bytes = bytes;
+	}
+
+	/// The mapping holds its own reference to the file.
+	close(fd);
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	if ( _bytes ) munmap(_bytes, _length);
+	[super dealloc];
+}
+
+
+#pragma mark - Access
+
+BOOL CBHMappedFile_isMappedFile(id owner)
+{
+	return [owner isKindOfClass:[_CBHMappedFile class]];
+}
+
+void *CBHMappedFile_bytes(_CBHMappedFile *file)
+{
+	return file->_bytes;
+}
+
+size_t CBHMappedFile_length(_CBHMappedFile *file)
+{
+	return file->_length;
+}
+
+
+#pragma mark - Paging
+
+/// Widens a byte range to the pages containing it, as `madvise` and `msync` require.
+static void *_pageRange(const void *bytes, size_t length, size_t *pageLength)
+{
+	const uintptr_t pageSize = (uintptr_t)getpagesize();
+	const uintptr_t start = (uintptr_t)bytes & ~(pageSize - 1);
+
+	*pageLength = (size_t)((uintptr_t)bytes + length - start);
+	return (void *)start;
+}
+
+void CBHMappedFile_advise(_CBHMappedFile *file, const void *bytes, size_t length, int advice)
+{
+	if ( !file->_bytes || length <= 0 ) return;
+
+	size_t pageLength = 0;
+	void *start = _pageRange(bytes, length, &pageLength);
+
+	/// Advice is only a hint, failing to take it is harmless.
+	madvise(start, pageLength, advice);
+}
+
+BOOL CBHMappedFile_sync(_CBHMappedFile *file, const void *bytes, size_t length)
+{
+	if ( !file->_bytes || length <= 0 ) return YES;
+
+	size_t pageLength = 0;
+	void *start = _pageRange(bytes, length, &pageLength);
+
+	return ( msync(start, pageLength, MS_SYNC) == 0 );
+}
+
+@end
@@ -0,0 +1,55 @@
+//  _CBHParallel.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import "CBHPrimitiveCollection.h"
+
+
+#pragma mark - Chunking
+
+/// The bytes handed to one worker at a time. Sized to sit in a core's L2 cache.
+#define CBHParallel_chunkBytes ((size_t)(256 * 1024))
+
+NSUInteger CBHParallel_entriesPerChunk(size_t entrySize);
+
+
+#pragma mark - Filling
+
+void CBHParallel_fill(void *data, NSUInteger count, size_t entrySize, const void *value);
+
+
+#pragma mark - Transforming
+
+void CBHParallel_transform(void *data, NSUInteger count, size_t entrySize, CBHPrimitiveTransform function, void *context);
+
+
+#pragma mark - Reducing
+
+void CBHParallel_reduce(const void *data, NSUInteger count, size_t entrySize, CBHPrimitiveReducer function, void *context, const void *identity, void *result);
+
+
+#pragma mark - Chunks
+
+void CBHParallel_forEachChunk(const void *data, NSUInteger count, size_t entrySize, void (NS_NOESCAPE ^block)(const void *entries, NSRange range));
+
+
+#pragma mark - Enumeration
+
+/// Calls `block` with every entry of a run, reversed or concurrently in chunks when `options` asks. `firstIndex` is the index reported for the first entry of the run. Returns `YES` if the block set its stop flag.
+BOOL CBHParallel_enumerate(const void *data, NSUInteger count, size_t entrySize, NSUInteger firstIndex, NSEnumerationOptions options, void (NS_NOESCAPE ^block)(const void *entry, NSUInteger index, BOOL *stop));
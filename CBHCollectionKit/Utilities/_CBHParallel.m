@@ -0,0 +1,226 @@
+//  _CBHParallel.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "_CBHParallel.h"
+
+@import Foundation.NSProcessInfo;
+@import CBHMemoryKit;
+@import Dispatch;
+
+#include <string.h>
+
+
+/// Below this many bytes the cost of waking other cores outweighs the work.
+#define PARALLEL_THRESHOLD ((size_t)(1024 * 1024))
+
+/// The most entries handed to one worker when enumerating. A block call per entry costs more than the bytes it reads, so chunks are kept short enough to spread.
+#define ENUMERATION_CHUNK 4096
+
+#define _entry(aBase, anIndex) ((uint8_t *)(aBase) + ((anIndex) * entrySize))
+#define _chunkCount(aCount, aPerChunk) (((aCount) + (aPerChunk) - 1) / (aPerChunk))
+#define _chunkLength(aCount, aPerChunk, aChunk) MIN((aPerChunk), (aCount) - ((aChunk) * (aPerChunk)))
+
+
+#pragma mark - Utilities
+
+static inline BOOL CBHParallel_shouldParallelize(NSUInteger count, size_t entrySize)
+{
+	return ( count * entrySize >= PARALLEL_THRESHOLD && [[NSProcessInfo processInfo] activeProcessorCount] > 1 );
+}
+
+static inline dispatch_queue_t CBHParallel_queue(void)
+{
+	return dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+}
+
+
+#pragma mark - Chunking
+
+NSUInteger CBHParallel_entriesPerChunk(size_t entrySize)
+{
+	const NSUInteger entries = CBHParallel_chunkBytes / entrySize;
+	return ( entries > 0 ) ? entries : 1;
+}
+
+
+#pragma mark - Filling
+
+/// Writes `value` to the first entry then doubles the written run until `count` entries are filled.
+static void CBHParallel_fillSerial(uint8_t *data, NSUInteger count, size_t entrySize, const void *value)
+{
+	if ( count <= 0 ) return;
+
+	const uint8_t *bytes = (const uint8_t *)value;
+
+	BOOL isUniform = YES;
+	for (size_t i = 1; i < entrySize && isUniform; ++i) { isUniform = ( bytes[i] == bytes[0] ); }
+
+	if ( isUniform )
+	{
+		memset(data, bytes[0], count * entrySize);
+		return;
+	}
+
+	memcpy(data, value, entrySize);
+
+	NSUInteger filled = 1;
+	while ( filled < count )
+	{
+		const NSUInteger length = MIN(filled, count - filled);
+		memcpy(_entry(data, filled), data, length * entrySize);
+		filled += length;
+	}
+}
+
+void CBHParallel_fill(void *data, NSUInteger count, size_t entrySize, const void *value)
+{
+	if ( !CBHParallel_shouldParallelize(count, entrySize) )
+	{
+		CBHParallel_fillSerial((uint8_t *)data, count, entrySize, value);
+		return;
+	}
+
+	const NSUInteger perChunk = CBHParallel_entriesPerChunk(entrySize);
+	dispatch_apply(_chunkCount(count, perChunk), CBHParallel_queue(), ^(size_t chunk) {
+		CBHParallel_fillSerial(_entry(data, chunk * perChunk), _chunkLength(count, perChunk, chunk), entrySize, value);
+	});
+}
+
+
+#pragma mark - Transforming
+
+void CBHParallel_transform(void *data, NSUInteger count, size_t entrySize, CBHPrimitiveTransform function, void *context)
+{
+	if ( count <= 0 ) return;
+
+	if ( !CBHParallel_shouldParallelize(count, entrySize) )
+	{
+		function(data, count, context);
+		return;
+	}
+
+	const NSUInteger perChunk = CBHParallel_entriesPerChunk(entrySize);
+	dispatch_apply(_chunkCount(count, perChunk), CBHParallel_queue(), ^(size_t chunk) {
+		function(_entry(data, chunk * perChunk), _chunkLength(count, perChunk, chunk), context);
+	});
+}
+
+
+#pragma mark - Reducing
+
+void CBHParallel_reduce(const void *data, NSUInteger count, size_t entrySize, CBHPrimitiveReducer function, void *context, const void *identity, void *result)
+{
+	memcpy(result, identity, entrySize);
+	if ( count <= 0 ) return;
+
+	if ( !CBHParallel_shouldParallelize(count, entrySize) )
+	{
+		function(result, data, count, context);
+		return;
+	}
+
+	const NSUInteger perChunk = CBHParallel_entriesPerChunk(entrySize);
+	const NSUInteger chunks = _chunkCount(count, perChunk);
+
+	/// Each chunk reduces into its own partial, which are then reduced in order so the function needs only be associative.
+	uint8_t *partials = CBHMemory_alloc(chunks, entrySize);
+	if ( !partials ) @throw CBHCallocException;
+
+	dispatch_apply(chunks, CBHParallel_queue(), ^(size_t chunk) {
+		void *partial = _entry(partials, chunk);
+		memcpy(partial, identity, entrySize);
+		function(partial, _entry(data, chunk * perChunk), _chunkLength(count, perChunk, chunk), context);
+	});
+
+	function(result, partials, chunks, context);
+
+	CBHMemory_free(partials);
+}
+
+
+#pragma mark - Chunks
+
+void CBHParallel_forEachChunk(const void *data, NSUInteger count, size_t entrySize, void (NS_NOESCAPE ^block)(const void *entries, NSRange range))
+{
+	if ( count <= 0 ) return;
+
+	if ( !CBHParallel_shouldParallelize(count, entrySize) )
+	{
+		block(data, NSMakeRange(0, count));
+		return;
+	}
+
+	const NSUInteger perChunk = CBHParallel_entriesPerChunk(entrySize);
+	dispatch_apply(_chunkCount(count, perChunk), CBHParallel_queue(), ^(size_t chunk) {
+		const NSUInteger offset = chunk * perChunk;
+		block(_entry(data, offset), NSMakeRange(offset, _chunkLength(count, perChunk, chunk)));
+	});
+}
+
+
+#pragma mark - Enumeration
+
+/// Walks the run with a pointer, `stopped` is checked before each entry so a stop in one chunk ends the others early.
+static BOOL CBHParallel_enumerateSerial(const uint8_t *data, NSUInteger count, size_t entrySize, NSUInteger firstIndex, BOOL isReversed, BOOL *stopped, void (NS_NOESCAPE ^block)(const void *entry, NSUInteger index, BOOL *stop))
+{
+	BOOL stop = NO;
+
+	if ( isReversed )
+	{
+		const uint8_t *entry = data + (count * entrySize);
+		for (NSUInteger i = count; i > 0 && !stop && !__atomic_load_n(stopped, __ATOMIC_RELAXED); --i)
+		{
+			entry -= entrySize;
+			block(entry, firstIndex + i - 1, &stop);
+		}
+	}
+	else
+	{
+		const uint8_t *entry = data;
+		for (NSUInteger i = 0; i < count && !stop && !__atomic_load_n(stopped, __ATOMIC_RELAXED); ++i)
+		{
+			block(entry, firstIndex + i, &stop);
+			entry += entrySize;
+		}
+	}
+
+	if ( stop ) { __atomic_store_n(stopped, YES, __ATOMIC_RELAXED); }
+	return stop;
+}
+
+BOOL CBHParallel_enumerate(const void *data, NSUInteger count, size_t entrySize, NSUInteger firstIndex, NSEnumerationOptions options, void (NS_NOESCAPE ^block)(const void *entry, NSUInteger index, BOOL *stop))
+{
+	if ( count <= 0 ) return NO;
+
+	const BOOL isReversed = ( (options & NSEnumerationReverse) != 0 );
+
+	__block BOOL stopped = NO;
+	if ( !(options & NSEnumerationConcurrent) || count <= 1 )
+	{
+		return CBHParallel_enumerateSerial(data, count, entrySize, firstIndex, isReversed, &stopped, block);
+	}
+
+	/// Chunks run in any order, each walks its own entries in the requested direction.
+	const NSUInteger perChunk = MIN(CBHParallel_entriesPerChunk(entrySize), (NSUInteger)ENUMERATION_CHUNK);
+	dispatch_apply(_chunkCount(count, perChunk), CBHParallel_queue(), ^(size_t chunk) {
+		const NSUInteger offset = chunk * perChunk;
+		CBHParallel_enumerateSerial(_entry(data, offset), _chunkLength(count, perChunk, chunk), entrySize, firstIndex + offset, isReversed, &stopped, block);
+	});
+
+	return stopped;
+}
@@ -0,0 +1,80 @@
+//  _CBHPerThread.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+@import Foundation;
+
+#include <pthread.h>
+
+
+#pragma mark - Types
+
+typedef struct CBHPerThread_t CBHPerThread_t;
+
+/// The start of every thread's cache. The rest is the owner's.
+typedef struct CBHPerThreadEntry_t {
+	/// The next cache of the same owner, guarded by the owner's lock.
+	struct CBHPerThreadEntry_t *_next;
+
+	/// The next cache of the same thread, only touched by that thread.
+	struct CBHPerThreadEntry_t *_nextOfThread;
+
+	CBHPerThread_t *_perThread;
+} CBHPerThreadEntry_t;
+
+typedef struct CBHPerThreadCallbacks {
+	/// Empties a cache. Called on the cache's own thread as it exits, or once the owner is closed.
+	void (*retire)(CBHPerThreadEntry_t *entry);
+
+	/// Frees the owner's state once it is closed and its last cache is gone. The lock is already destroyed.
+	void (*free)(CBHPerThread_t *perThread);
+} CBHPerThreadCallbacks;
+
+/// Gives each thread its own cache of an owner, which the thread uses without locking.
+///
+/// Embedded at the start of the owner's state, which outlives the owner until its last cache is retired. A cache is only ever touched by its own thread, so those of threads still running when the owner is closed are retired as the threads exit or next set up a cache.
+struct CBHPerThread_t {
+	/// Guards the list of caches and the reference count. Owners may use it for their own shared state.
+	pthread_mutex_t _lock;
+	CBHPerThreadEntry_t *_caches;
+
+	/// The owner plus each registered cache.
+	NSUInteger _references;
+	BOOL _isClosed;
+
+	size_t _cacheLength;
+	CBHPerThreadCallbacks _callbacks;
+};
+
+
+#pragma mark - Owners
+
+/// Prepares `perThread` for caches of `cacheLength` bytes, including their entry.
+void CBHPerThread_init(CBHPerThread_t *perThread, size_t cacheLength, CBHPerThreadCallbacks callbacks);
+
+/// Retires the calling thread's cache and drops the owner's reference. The rest are retired by their threads.
+void CBHPerThread_close(CBHPerThread_t *perThread);
+
+
+#pragma mark - Caches
+
+/// The calling thread's cache, zeroed and registered on first use. Returns `NULL` if it could not be created.
+CBHPerThreadEntry_t *CBHPerThread_current(CBHPerThread_t *perThread);
+
+/// The calling thread's cache, or `NULL` if it has none.
+CBHPerThreadEntry_t *CBHPerThread_existing(CBHPerThread_t *perThread);
@@ -0,0 +1,196 @@
+//  _CBHPerThread.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#import "_CBHPerThread.h"
+
+#include <stdlib.h>
+
+
+/// One key for every owner, whose value is the first of the thread's caches, so owners come and go without using up keys.
+static pthread_key_t CBHPerThread_key;
+
+
+#pragma mark - Thread Lists
+
+static void CBHPerThread_retire(CBHPerThreadEntry_t *entry);
+
+/// Called as a thread exits with the first of its caches.
+static void CBHPerThread_threadDidExit(void *value)
+{
+	CBHPerThreadEntry_t *entry = value;
+
+	while ( entry )
+	{
+		CBHPerThreadEntry_t *next = entry->_nextOfThread;
+		CBHPerThread_retire(entry);
+		entry = next;
+	}
+}
+
+static CBHPerThreadEntry_t *CBHPerThread_first(void)
+{
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		if ( pthread_key_create(&CBHPerThread_key, CBHPerThread_threadDidExit) != 0 ) abort();
+	});
+
+	return pthread_getspecific(CBHPerThread_key);
+}
+
+/// Takes `entry` off the calling thread's list.
+static void CBHPerThread_unlink(CBHPerThreadEntry_t *entry)
+{
+	CBHPerThreadEntry_t *first = CBHPerThread_first();
+	if ( first == entry )
+	{
+		pthread_setspecific(CBHPerThread_key, entry->_nextOfThread);
+		return;
+	}
+
+	for (CBHPerThreadEntry_t *previous = first; previous; previous = previous->_nextOfThread)
+	{
+		if ( previous->_nextOfThread != entry ) continue;
+
+		previous->_nextOfThread = entry->_nextOfThread;
+		return;
+	}
+}
+
+
+#pragma mark - Retiring
+
+static void CBHPerThread_free(CBHPerThread_t *perThread)
+{
+	pthread_mutex_destroy(&perThread->_lock);
+	perThread->_callbacks.free(perThread);
+}
+
+/// Empties and frees `entry`, which must belong to the calling thread and be off its list.
+static void CBHPerThread_retire(CBHPerThreadEntry_t *entry)
+{
+	CBHPerThread_t *perThread = entry->_perThread;
+	perThread->_callbacks.retire(entry);
+
+	pthread_mutex_lock(&perThread->_lock);
+
+	for (CBHPerThreadEntry_t **link = &perThread->_caches; *link; link = &(*link)->_next)
+	{
+		if ( *link != entry ) continue;
+
+		*link = entry->_next;
+		break;
+	}
+
+	const BOOL isLast = ( --perThread->_references == 0 );
+	pthread_mutex_unlock(&perThread->_lock);
+
+	free(entry);
+	if ( isLast ) CBHPerThread_free(perThread);
+}
+
+/// The first of the calling thread's caches whose owner has been closed, or `NULL`.
+static CBHPerThreadEntry_t *CBHPerThread_firstClosed(void)
+{
+	for (CBHPerThreadEntry_t *entry = CBHPerThread_first(); entry; entry = entry->_nextOfThread)
+	{
+		if ( __atomic_load_n(&entry->_perThread->_isClosed, __ATOMIC_ACQUIRE) ) return entry;
+	}
+
+	return NULL;
+}
+
+
+#pragma mark - Owners
+
+void CBHPerThread_init(CBHPerThread_t *perThread, const size_t cacheLength, const CBHPerThreadCallbacks callbacks)
+{
+	pthread_mutex_init(&perThread->_lock, NULL);
+	perThread->_caches = NULL;
+	perThread->_references = 1;
+	perThread->_isClosed = NO;
+	perThread->_cacheLength = MAX(cacheLength, sizeof(CBHPerThreadEntry_t));
+	perThread->_callbacks = callbacks;
+}
+
+void CBHPerThread_close(CBHPerThread_t *perThread)
+{
+	/// The calling thread's cache is its own to retire now, other threads retire theirs.
+	CBHPerThreadEntry_t *entry = CBHPerThread_existing(perThread);
+	if ( entry )
+	{
+		CBHPerThread_unlink(entry);
+		CBHPerThread_retire(entry);
+	}
+
+	pthread_mutex_lock(&perThread->_lock);
+
+	__atomic_store_n(&perThread->_isClosed, YES, __ATOMIC_RELEASE);
+	const BOOL isLast = ( --perThread->_references == 0 );
+
+	pthread_mutex_unlock(&perThread->_lock);
+
+	if ( isLast ) CBHPerThread_free(perThread);
+}
+
+
+#pragma mark - Caches
+
+CBHPerThreadEntry_t *CBHPerThread_existing(CBHPerThread_t *perThread)
+{
+	for (CBHPerThreadEntry_t *entry = CBHPerThread_first(); entry; entry = entry->_nextOfThread)
+	{
+		if ( entry->_perThread == perThread ) return entry;
+	}
+
+	return NULL;
+}
+
+CBHPerThreadEntry_t *CBHPerThread_current(CBHPerThread_t *perThread)
+{
+	CBHPerThreadEntry_t *entry = CBHPerThread_existing(perThread);
+	if ( entry ) return entry;
+
+	/// Caches left behind by closed owners are retired before adding another. Retiring may add caches, so look again each time.
+	CBHPerThreadEntry_t *stale = NULL;
+	while ( (stale = CBHPerThread_firstClosed()) )
+	{
+		CBHPerThread_unlink(stale);
+		CBHPerThread_retire(stale);
+	}
+
+	entry = calloc(1, perThread->_cacheLength);
+	if ( !entry ) return NULL;
+
+	entry->_perThread = perThread;
+	entry->_nextOfThread = CBHPerThread_first();
+
+	if ( pthread_setspecific(CBHPerThread_key, entry) != 0 )
+	{
+		free(entry);
+		return NULL;
+	}
+
+	pthread_mutex_lock(&perThread->_lock);
+	entry->_next = perThread->_caches;
+	perThread->_caches = entry;
+	++perThread->_references;
+	pthread_mutex_unlock(&perThread->_lock);
+
+	return entry;
+}
@@ -0,0 +1,73 @@
+//  _CBHPersistentStack.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+@import Foundation;
+
+
+/// A run of objects, the oldest first, linked to the chunk below it. Chunks are shared by every version which reaches them and are never written below their claimed slots.
+typedef struct CBHPersistentChunk_t CBHPersistentChunk_t;
+
+/// One version of a persistent stack. Holds a reference to its top chunk, of which it uses the first `_fill` objects.
+typedef struct CBHPersistentStack_t {
+	CBHPersistentChunk_t *_chunk;
+	NSUInteger _fill;
+	NSUInteger _count;
+} CBHPersistentStack_t;
+
+
+#pragma mark - Initializers
+
+CBHPersistentStack_t CBHPersistentStack_init(void);
+
+/// Initializes a stack holding `objects`, with the last on top, in chunks no larger than those grown by pushing.
+CBHPersistentStack_t CBHPersistentStack_initWithObjects(const id __unsafe_unretained *objects, NSUInteger count);
+
+/// Takes another reference to the chunks of `stack`.
+CBHPersistentStack_t CBHPersistentStack_initSharing(const CBHPersistentStack_t *stack);
+
+
+#pragma mark - Destructors
+
+void CBHPersistentStack_dealloc(CBHPersistentStack_t *stack);
+
+
+#pragma mark - Versions
+
+/// Returns a new version with `object` on top of `stack`. The object is written to a free slot of the top chunk when no other version has claimed it first, otherwise to a new chunk.
+CBHPersistentStack_t CBHPersistentStack_push(const CBHPersistentStack_t *stack, id object);
+
+/// Returns a new version without the top of `stack`, which must not be empty.
+CBHPersistentStack_t CBHPersistentStack_pop(const CBHPersistentStack_t *stack);
+
+id CBHPersistentStack_peek(const CBHPersistentStack_t *stack);
+
+
+#pragma mark - Enumeration
+
+/// Copies up to `length` objects from the top of `cursor` to `buffer`, and moves `cursor` below them. The cursor holds no reference.
+NSUInteger CBHPersistentStack_copyFromTop(CBHPersistentStack_t *cursor, id __unsafe_unretained *buffer, NSUInteger length);
+
+/// Moves `cursor` below up to `count` objects from its top. The cursor holds no reference.
+void CBHPersistentStack_dropFromTop(CBHPersistentStack_t *cursor, NSUInteger count);
+
+/// Copies every object of `stack` to `buffer`, the bottom first.
+void CBHPersistentStack_copyFromBottom(const CBHPersistentStack_t *stack, id __unsafe_unretained *buffer);
+
+/// Whether two versions are the same version, sharing every chunk they reach.
+BOOL CBHPersistentStack_isShared(const CBHPersistentStack_t *a, const CBHPersistentStack_t *b);
@@ -0,0 +1,233 @@
+//  _CBHPersistentStack.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#import "_CBHPersistentStack.h"
+
+@import CBHMemoryKit;
+
+
+/// A new chunk above a full one doubles up to `MAXIMUM_CHUNK`. A chunk started by branching from the middle of another starts at `MINIMUM_CHUNK`.
+#define MINIMUM_CHUNK 4
+#define MAXIMUM_CHUNK 256
+
+
+struct CBHPersistentChunk_t {
+	NSUInteger _references;
+
+	/// Slots claimed so far. Only ever grows, and a slot is written once by the version which claimed it.
+	NSUInteger _used;
+	NSUInteger _capacity;
+
+	CBHPersistentChunk_t *_next;
+	NSUInteger _nextFill;
+
+	id _objects[];
+};
+
+
+#pragma mark - Chunks
+
+static CBHPersistentChunk_t *CBHPersistentChunk_alloc(NSUInteger capacity, CBHPersistentChunk_t *next, NSUInteger nextFill)
+{
+	CBHPersistentChunk_t *chunk = CBHMemory_alloc(1, sizeof(CBHPersistentChunk_t) + (capacity * sizeof(id)));
+	if ( !chunk ) @throw CBHCallocException;
+
+	chunk->_references = 1;
+	chunk->_used = 0;
+	chunk->_capacity = capacity;
+	chunk->_next = next;
+	chunk->_nextFill = nextFill;
+
+	return chunk;
+}
+
+static inline CBHPersistentChunk_t *CBHPersistentChunk_retain(CBHPersistentChunk_t *chunk)
+{
+	if ( chunk ) { __atomic_add_fetch(&chunk->_references, 1, __ATOMIC_RELAXED); }
+	return chunk;
+}
+
+static void CBHPersistentChunk_release(CBHPersistentChunk_t *chunk)
+{
+	/// Walks down rather than recursing, so a long chain can't exhaust the stack.
+	while ( chunk && __atomic_sub_fetch(&chunk->_references, 1, __ATOMIC_ACQ_REL) == 0 )
+	{
+		for (NSUInteger i = 0; i < chunk->_used; ++i) { [chunk->_objects[i] release]; }
+
+		CBHPersistentChunk_t *next = chunk->_next;
+		free(chunk);
+		chunk = next;
+	}
+}
+
+/// Claims the slot at `fill` if no other version has.
+static inline BOOL CBHPersistentChunk_claim(CBHPersistentChunk_t *chunk, NSUInteger fill)
+{
+	if ( fill >= chunk->_capacity ) return NO;
+
+	NSUInteger expected = fill;
+	return __atomic_compare_exchange_n(&chunk->_used, &expected, fill + 1, NO, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+
+
+#pragma mark - Initializers
+
+CBHPersistentStack_t CBHPersistentStack_init(void)
+{
+	return (CBHPersistentStack_t){NULL, 0, 0};
+}
+
+CBHPersistentStack_t CBHPersistentStack_initWithObjects(const id __unsafe_unretained *objects, NSUInteger count)
+{
+	/// Chunks are filled from the bottom, so objects popped off a full chunk are released with it.
+	CBHPersistentStack_t stack = CBHPersistentStack_init();
+
+	for (NSUInteger first = 0; first < count; first += MAXIMUM_CHUNK)
+	{
+		const NSUInteger length = MIN(count - first, (NSUInteger)MAXIMUM_CHUNK);
+
+		CBHPersistentChunk_t *chunk = CBHPersistentChunk_alloc(length, stack._chunk, stack._fill);
+		for (NSUInteger i = 0; i < length; ++i) { chunk->_objects[i] = [objects[first + i] retain]; }
+		chunk->_used = length;
+
+		stack = (CBHPersistentStack_t){chunk, length, first + length};
+	}
+
+	return stack;
+}
+
+CBHPersistentStack_t CBHPersistentStack_initSharing(const CBHPersistentStack_t *stack)
+{
+	return (CBHPersistentStack_t){CBHPersistentChunk_retain(stack->_chunk), stack->_fill, stack->_count};
+}
+
+
+#pragma mark - Destructors
+
+void CBHPersistentStack_dealloc(CBHPersistentStack_t *stack)
+{
+	CBHPersistentChunk_release(stack->_chunk);
+	*stack = CBHPersistentStack_init();
+}
+
+
+#pragma mark - Versions
+
+CBHPersistentStack_t CBHPersistentStack_push(const CBHPersistentStack_t *stack, id object)
+{
+	CBHPersistentChunk_t *chunk = stack->_chunk;
+	const NSUInteger fill = stack->_fill;
+
+	/// Extend the top chunk in place while this version is its newest.
+	if ( chunk && CBHPersistentChunk_claim(chunk, fill) )
+	{
+		chunk->_objects[fill] = [object retain];
+		return (CBHPersistentStack_t){CBHPersistentChunk_retain(chunk), fill + 1, stack->_count + 1};
+	}
+
+	NSUInteger capacity = MINIMUM_CHUNK;
+	if ( chunk && fill >= chunk->_capacity ) { capacity = MIN(MAX(chunk->_capacity * 2, (NSUInteger)MINIMUM_CHUNK), (NSUInteger)MAXIMUM_CHUNK); }
+
+	CBHPersistentChunk_t *top = CBHPersistentChunk_alloc(capacity, CBHPersistentChunk_retain(chunk), fill);
+	top->_objects[0] = [object retain];
+	top->_used = 1;
+
+	return (CBHPersistentStack_t){top, 1, stack->_count + 1};
+}
+
+CBHPersistentStack_t CBHPersistentStack_pop(const CBHPersistentStack_t *stack)
+{
+	CBHPersistentChunk_t *chunk = stack->_chunk;
+
+	/// The popped object stays in its chunk, which other versions may still reach.
+	if ( stack->_fill > 1 ) return (CBHPersistentStack_t){CBHPersistentChunk_retain(chunk), stack->_fill - 1, stack->_count - 1};
+	return (CBHPersistentStack_t){CBHPersistentChunk_retain(chunk->_next), chunk->_nextFill, stack->_count - 1};
+}
+
+id CBHPersistentStack_peek(const CBHPersistentStack_t *stack)
+{
+	if ( stack->_count <= 0 ) return nil;
+	return stack->_chunk->_objects[stack->_fill - 1];
+}
+
+
+#pragma mark - Enumeration
+
+NSUInteger CBHPersistentStack_copyFromTop(CBHPersistentStack_t *cursor, id __unsafe_unretained *buffer, NSUInteger length)
+{
+	NSUInteger copied = 0;
+
+	while ( copied < length && cursor->_count > 0 )
+	{
+		CBHPersistentChunk_t *chunk = cursor->_chunk;
+		const NSUInteger run = MIN(length - copied, cursor->_fill);
+
+		for (NSUInteger i = 0; i < run; ++i) { buffer[copied + i] = chunk->_objects[cursor->_fill - 1 - i]; }
+		copied += run;
+		cursor->_count -= run;
+		cursor->_fill -= run;
+
+		if ( cursor->_fill <= 0 )
+		{
+			cursor->_fill = chunk->_nextFill;
+			cursor->_chunk = chunk->_next;
+		}
+	}
+
+	return copied;
+}
+
+void CBHPersistentStack_dropFromTop(CBHPersistentStack_t *cursor, NSUInteger count)
+{
+	while ( count > 0 && cursor->_count > 0 )
+	{
+		const NSUInteger run = MIN(count, cursor->_fill);
+		count -= run;
+		cursor->_count -= run;
+		cursor->_fill -= run;
+
+		if ( cursor->_fill <= 0 )
+		{
+			cursor->_fill = cursor->_chunk->_nextFill;
+			cursor->_chunk = cursor->_chunk->_next;
+		}
+	}
+}
+
+void CBHPersistentStack_copyFromBottom(const CBHPersistentStack_t *stack, id __unsafe_unretained *buffer)
+{
+	/// The chunks link downwards, so each run is placed from the end of the buffer.
+	NSUInteger remaining = stack->_count;
+	CBHPersistentChunk_t *chunk = stack->_chunk;
+	NSUInteger fill = stack->_fill;
+
+	while ( remaining > 0 )
+	{
+		remaining -= fill;
+		for (NSUInteger i = 0; i < fill; ++i) { buffer[remaining + i] = chunk->_objects[i]; }
+
+		fill = chunk->_nextFill;
+		chunk = chunk->_next;
+	}
+}
+
+BOOL CBHPersistentStack_isShared(const CBHPersistentStack_t *a, const CBHPersistentStack_t *b)
+{
+	return ( a->_chunk == b->_chunk && a->_fill == b->_fill );
+}
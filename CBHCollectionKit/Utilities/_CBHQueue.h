@@ -25,6 +25,14 @@
 #pragma mark - Initializers
 
 CBHQueue_t CBHQueue_init(NSUInteger capacity, size_t entrySize);
+CBHQueue_t CBHQueue_initWithOptions(NSUInteger capacity, size_t entrySize, const CBHAllocationOptions *options);
+
+/// Initializes a queue over the inline `bytes` of its collection if `capacity` entries fit, otherwise on the heap.
+CBHQueue_t CBHQueue_initInline(void *bytes, NSUInteger capacity, size_t entrySize, const CBHAllocationOptions *options);
+CBHQueue_t CBHQueue_initSharing(CBHQueue_t *queue);
+
+/// Copies storage shared with another queue of objects so it can be written to, retaining the objects in use for the copy. Returns `YES` if the bytes were copied.
+BOOL CBHQueue_makeUniqueRetainingObjects(CBHQueue_t *queue);
 
 
 #pragma mark - Copiers
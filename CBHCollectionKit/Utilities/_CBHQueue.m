@@ -17,6 +17,7 @@
 //  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 #import "_CBHQueue.h"
+#import "_CBHBuffer.h"
 
 @import CBHMemoryKit;
 
@@ -36,15 +37,45 @@
 #pragma mark - Initializers
 
 CBHQueue_t CBHQueue_init(NSUInteger capacity, const size_t entrySize)
+{
+	return CBHQueue_initWithOptions(capacity, entrySize, &CBHAllocationOptionsDefault);
+}
+
+CBHQueue_t CBHQueue_initWithOptions(NSUInteger capacity, const size_t entrySize, const CBHAllocationOptions *options)
 {
 	CBHQueue_t retVal;
 
 	if (capacity < 1) capacity = 1;
 
-	retVal._data = CBHMemory_alloc(capacity, entrySize);
+	retVal._data = CBHBuffer_alloc(capacity, entrySize, NO, options);
 	if ( !retVal._data ) @throw CBHCallocException;
 
 	retVal._capacity = capacity;
+	retVal._generation = 0;
+	retVal._owner = nil;
+	retVal._options = *options;
+	retVal._isInline = NO;
+	retVal._entrySize = entrySize;
+	retVal._offset = 0;
+	retVal._count = 0;
+
+	return retVal;
+}
+
+CBHQueue_t CBHQueue_initInline(void *bytes, NSUInteger capacity, const size_t entrySize, const CBHAllocationOptions *options)
+{
+	if (capacity < 1) capacity = 1;
+	if ( !CBHBuffer_fitsInline(capacity, entrySize, options) ) return CBHQueue_initWithOptions(capacity, entrySize, options);
+
+	CBHQueue_t retVal;
+
+	retVal._data = bytes;
+
+	retVal._capacity = capacity;
+	retVal._generation = 0;
+	retVal._owner = nil;
+	retVal._options = *options;
+	retVal._isInline = YES;
 	retVal._entrySize = entrySize;
 	retVal._offset = 0;
 	retVal._count = 0;
@@ -52,12 +83,41 @@ CBHQueue_t CBHQueue_init(NSUInteger capacity, const size_t entrySize)
 	return retVal;
 }
 
+CBHQueue_t CBHQueue_initSharing(CBHQueue_t *queue)
+{
+	id owner = CBHSlice_shareStorage((CBHSlice_t *)queue);
+	if ( !owner ) return CBHQueue_copy(queue);
+
+	CBHQueue_t retVal = *queue;
+	retVal._generation = 0;
+	retVal._owner = [owner retain];
+
+	return retVal;
+}
+
+BOOL CBHQueue_makeUniqueRetainingObjects(CBHQueue_t *queue)
+{
+	const NSUInteger count = queue->_count;
+	const NSUInteger offset = queue->_offset;
+	const NSUInteger capacity = queue->_capacity;
+
+	return CBHSlice_makeUniqueWithReferences((CBHSlice_t *)queue, ^(const void *data, BOOL retain) {
+		const void * const *objects = (const void * const *)data;
+		for (NSUInteger i = 0; i < count; ++i)
+		{
+			const void *object = objects[(offset + i) % capacity];
+			if ( retain ) CFRetain(object);
+			else CFRelease(object);
+		}
+	});
+}
+
 
 #pragma mark - Copiers
 
 CBHQueue_t CBHQueue_copy(const CBHQueue_t *existing)
 {
-	CBHQueue_t copy = CBHQueue_init(existing->_capacity, sizeof(id));
+	CBHQueue_t copy = CBHQueue_initWithOptions(existing->_capacity, sizeof(id), &existing->_options);
 	CBHMemory_copyTo(existing->_data, copy._data, existing->_entrySize, existing->_capacity);
 	copy._count = existing->_count;
 	copy._offset = existing->_offset;
@@ -70,7 +130,7 @@ CBHQueue_t CBHQueue_copy(const CBHQueue_t *existing)
 
 void CBHQueue_dealloc(CBHQueue_t *queue)
 {
-	CBHMemory_free(queue->_data);
+	CBHSlice_dealloc((CBHSlice_t *)queue);
 }
 
 
@@ -18,11 +18,24 @@
 
 #pragma once
 
+#import "CBHAllocation.h"
+
 
 typedef struct CBHQueue_t {
 	void *_data;
 	size_t _entrySize;
 	NSUInteger _capacity;
+	NSUInteger _generation;
+
+	/// Keeps borrowed bytes alive. `nil` when `_data` is owned and must be freed.
+	id _owner;
+
+	/// How `_data` is allocated, kept so reallocations allocate the same way.
+	CBHAllocationOptions _options;
+
+	/// `_data` is stored inside the collection object. It is never freed, and moves to the heap when the capacity grows.
+	BOOL _isInline;
+
 	NSUInteger _count;
 	NSUInteger _offset;
 } CBHQueue_t;
@@ -0,0 +1,56 @@
+//  _CBHReuse.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import "CBHWedge.h"
+#import "CBHStack.h"
+#import "CBHQueue.h"
+
+
+#pragma mark - Reuse
+
+/// Whether a collection can be emptied and handed out again, and what keeping it costs.
+///
+/// Collections are only reusable while their buffer is their own and comes from the system, not while it is shared, written through to another object, or allocated by an allocator which may go away.
+@interface CBHWedge (Reuse)
+
+@property (nonatomic, readonly, getter=isReusable) BOOL reusable;
+
+/// The number of bytes kept alive by holding on to the wedge, its object and any buffer on the heap.
+@property (nonatomic, readonly) size_t reusableLength;
+
+@end
+
+@interface CBHStack (Reuse)
+
+@property (nonatomic, readonly, getter=isReusable) BOOL reusable;
+
+/// The number of bytes kept alive by holding on to the stack, its object and any buffer on the heap.
+@property (nonatomic, readonly) size_t reusableLength;
+
+@end
+
+@interface CBHQueue (Reuse)
+
+@property (nonatomic, readonly, getter=isReusable) BOOL reusable;
+
+/// The number of bytes kept alive by holding on to the queue, its object and any buffer on the heap.
+@property (nonatomic, readonly) size_t reusableLength;
+
+@end
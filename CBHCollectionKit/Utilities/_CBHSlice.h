@@ -24,9 +24,11 @@
 #pragma mark - Initializers
 
 CBHSlice_t CBHSlice_init(NSUInteger capacity, size_t entrySize, BOOL shouldClear);
+CBHSlice_t CBHSlice_initWithOptions(NSUInteger capacity, size_t entrySize, BOOL shouldClear, const CBHAllocationOptions *options);
 CBHSlice_t CBHSlice_initCopyingBytes(const void *pointer, size_t entrySize, NSUInteger count);
 CBHSlice_t CBHSlice_initCopyingBytesWithCount(const void *pointer, size_t entrySize, NSUInteger capacity, NSUInteger count);
 CBHSlice_t CBHSlice_initOwningBytes(void *pointer, size_t entrySize, NSUInteger capacity);
+CBHSlice_t CBHSlice_initBorrowingBytes(void *pointer, size_t entrySize, NSUInteger capacity, id owner);
 
 
 #pragma mark - Destructors
@@ -39,8 +41,8 @@ void CBHSlice_dealloc(CBHSlice_t *slice);
 const void *CBHSlice_pointerAtOffset(const CBHSlice_t *slice, NSUInteger offset);
 const void *CBHSlice_pointerToOffset(const CBHSlice_t *slice, NSUInteger offset);
 
-void CBHSlice_setValueAtOffset(const CBHSlice_t *slice, NSUInteger offset, const void *value);
-void CBHSlice_setValuesInRange(const CBHSlice_t *slice, const void *value, NSUInteger offset, NSUInteger length);
+void CBHSlice_setValueAtOffset(CBHSlice_t *slice, NSUInteger offset, const void *value);
+void CBHSlice_setValuesInRange(CBHSlice_t *slice, const void *value, NSUInteger offset, NSUInteger length);
 
 
 #pragma mark - Capacity
@@ -48,21 +50,36 @@ void CBHSlice_setValuesInRange(const CBHSlice_t *slice, const void *value, NSUIn
 void CBHSlice_setCapacity(CBHSlice_t *slice, NSUInteger capacity, BOOL shouldClear);
 
 
+#pragma mark - Sharing
+
+/// Returns an owner through which a copy can borrow the bytes, moving owned or inline bytes into shared storage first. Returns `nil` if the bytes are written through to another object and must be copied instead.
+id CBHSlice_shareStorage(CBHSlice_t *slice);
+
+/// Copies shared storage so the slice can be written to. Returns `YES` if the bytes were copied.
+BOOL CBHSlice_makeUnique(CBHSlice_t *slice);
+
+/// Copies shared storage whose entries hold references. `references` is handed the copied bytes to retain them while the storage still keeps them alive. If the other sharers let go in the meantime it is handed them again to release them, and the slice keeps the storage. Returns `YES` if the bytes were copied.
+BOOL CBHSlice_makeUniqueWithReferences(CBHSlice_t *slice, void (NS_NOESCAPE ^references)(const void *data, BOOL retain));
+
+/// Drops the slice's reference to storage shared with another collection, leaving it without bytes. Returns `NO`, leaving the slice untouched, if nothing else shares them.
+BOOL CBHSlice_releaseShared(CBHSlice_t *slice);
+
+
 #pragma mark - Copying
 
-void CBHSlice_copyValueAtOffset(const CBHSlice_t *slice, NSUInteger src, NSUInteger dst);
-void CBHSlice_copyValuesInRange(const CBHSlice_t *slice, NSUInteger src, NSUInteger dst, NSUInteger length);
+void CBHSlice_copyValueAtOffset(CBHSlice_t *slice, NSUInteger src, NSUInteger dst);
+void CBHSlice_copyValuesInRange(CBHSlice_t *slice, NSUInteger src, NSUInteger dst, NSUInteger length);
 
 
 #pragma mark - Swapping
 
-void CBHSlice_swapValuesAtOffsets(const CBHSlice_t *slice, NSUInteger a, NSUInteger b);
-BOOL CBHSlice_swapValuesInRange(const CBHSlice_t *slice, NSUInteger a, NSUInteger b, NSUInteger length);
+void CBHSlice_swapValuesAtOffsets(CBHSlice_t *slice, NSUInteger a, NSUInteger b);
+BOOL CBHSlice_swapValuesInRange(CBHSlice_t *slice, NSUInteger a, NSUInteger b, NSUInteger length);
 
 
 #pragma mark - Zeroing
 
-void CBHSlice_zeroValuesInRange(const CBHSlice_t *slice, NSUInteger index, NSUInteger length);
+void CBHSlice_zeroValuesInRange(CBHSlice_t *slice, NSUInteger index, NSUInteger length);
 
 
 #pragma mark - Accessors
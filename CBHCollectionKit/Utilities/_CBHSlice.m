@@ -17,6 +17,9 @@
 //  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 #import "_CBHSlice.h"
+#import "_CBHStorage.h"
+#import "_CBHBuffer.h"
+#import "_CBHParallel.h"
 
 @import Foundation.NSException;
 @import CBHMemoryKit;
@@ -29,13 +32,22 @@
 #pragma mark - Initializers
 
 CBHSlice_t CBHSlice_init(NSUInteger capacity, const size_t entrySize, const BOOL shouldClear)
+{
+	return CBHSlice_initWithOptions(capacity, entrySize, shouldClear, &CBHAllocationOptionsDefault);
+}
+
+CBHSlice_t CBHSlice_initWithOptions(NSUInteger capacity, const size_t entrySize, const BOOL shouldClear, const CBHAllocationOptions *options)
 {
 	CBHSlice_t retVal;
 
-	retVal._data = ( shouldClear ) ? CBHMemory_calloc(capacity, entrySize) : CBHMemory_alloc(capacity, entrySize);
+	retVal._data = CBHBuffer_alloc(capacity, entrySize, shouldClear, options);
 	if ( !retVal._data ) @throw CBHCallocException;
 
 	retVal._capacity = capacity;
+	retVal._generation = 0;
+	retVal._owner = nil;
+	retVal._options = *options;
+	retVal._isInline = NO;
 	retVal._entrySize = entrySize;
 
 	return retVal;
@@ -55,6 +67,10 @@ CBHSlice_t CBHSlice_initCopyingBytesWithCount(const void *pointer, const size_t
 	if ( !retVal._data ) @throw CBHCallocException;
 
 	retVal._capacity = capacity;
+	retVal._generation = 0;
+	retVal._owner = nil;
+	retVal._options = CBHAllocationOptionsDefault;
+	retVal._isInline = NO;
 	retVal._entrySize = entrySize;
 
 	CBHMemory_copyTo(pointer, retVal._data, count, entrySize);
@@ -69,17 +85,45 @@ CBHSlice_t CBHSlice_initOwningBytes(void *pointer, const size_t entrySize, const
 	retVal._data = pointer;
 
 	retVal._capacity = capacity;
+	retVal._generation = 0;
+	retVal._owner = nil;
+	retVal._options = CBHAllocationOptionsDefault;
+	retVal._isInline = NO;
 	retVal._entrySize = entrySize;
 
 	return retVal;
 }
 
 
+CBHSlice_t CBHSlice_initBorrowingBytes(void *pointer, const size_t entrySize, const NSUInteger capacity, id owner)
+{
+	CBHSlice_t retVal = CBHSlice_initOwningBytes(pointer, entrySize, capacity);
+	retVal._owner = [owner retain];
+
+	return retVal;
+}
+
+
 #pragma mark - Destructors
 
 void CBHSlice_dealloc(CBHSlice_t *slice)
 {
-	CBHMemory_free(slice->_data);
+	if ( slice->_isInline )
+	{
+		slice->_data = NULL;
+		return;
+	}
+
+	if ( slice->_owner )
+	{
+		[slice->_owner release];
+		slice->_owner = nil;
+		slice->_data = NULL;
+		return;
+	}
+
+	CBHBuffer_free(slice->_data, slice->_capacity, slice->_entrySize, &slice->_options);
+	slice->_data = NULL;
 }
 
 
@@ -97,66 +141,184 @@ inline const void *CBHSlice_pointerToOffset(const CBHSlice_t *slice, const NSUIn
 	return _pointerToOffset(offset);
 }
 
-inline void CBHSlice_setValueAtOffset(const CBHSlice_t *slice, const NSUInteger offset, const void *value)
+inline void CBHSlice_setValueAtOffset(CBHSlice_t *slice, const NSUInteger offset, const void *value)
 {
 	_guardOffsetInBounds(offset);
+	CBHSlice_makeUnique(slice);
+
 	CBHMemory_copyTo(value, _pointerToOffset(offset), 1, slice->_entrySize);
 }
 
-inline void CBHSlice_setValuesInRange(const CBHSlice_t *slice, const void *value, const NSUInteger offset, const NSUInteger length)
+inline void CBHSlice_setValuesInRange(CBHSlice_t *slice, const void *value, const NSUInteger offset, const NSUInteger length)
 {
 	if ( length <= 0 ) return;
 
 	_guardOffsetInBounds(offset);
 	_guardOffsetInBounds(offset + length - 1);
+	CBHSlice_makeUnique(slice);
 
-	for (NSUInteger i = offset; i < length; ++i)
-	{
-		CBHMemory_copyTo(value, _pointerToOffset(i), 1, slice->_entrySize);
-	}
+	CBHParallel_fill(_pointerToOffset(offset), length, slice->_entrySize, value);
 }
 
 
 #pragma mark - Capacity
 
+/// Moves borrowed or inline bytes into a buffer of our own so they can be reallocated.
+static void CBHSlice_detachFromOwner(CBHSlice_t *slice, const NSUInteger capacity, const BOOL shouldClear)
+{
+	void *data = CBHBuffer_alloc(capacity, slice->_entrySize, shouldClear, &slice->_options);
+	if ( !data ) @throw CBHReallocException;
+
+	const NSUInteger count = ( capacity < slice->_capacity ) ? capacity : slice->_capacity;
+	CBHMemory_copyTo(slice->_data, data, count, slice->_entrySize);
+
+	[slice->_owner release];
+	slice->_owner = nil;
+	slice->_isInline = NO;
+
+	slice->_data = data;
+	slice->_capacity = capacity;
+	++slice->_generation;
+}
+
 inline void CBHSlice_setCapacity(CBHSlice_t *slice, const NSUInteger capacity, const BOOL shouldClear)
 {
 	if (capacity == slice->_capacity) return;
 
-	if ( shouldClear )
+	if ( slice->_isInline )
 	{
-		slice->_data = CBHMemory_recalloc(slice->_data, slice->_capacity, capacity, slice->_entrySize);
+		/// Inline bytes stay put when shrinking and move to the heap when they overflow.
+		if ( capacity < slice->_capacity )
+		{
+			slice->_capacity = capacity;
+			++slice->_generation;
+		}
+		else CBHSlice_detachFromOwner(slice, capacity, shouldClear);
+
+		return;
 	}
-	else
+
+	if ( slice->_owner )
 	{
-		slice->_data = CBHMemory_realloc(slice->_data, capacity, slice->_entrySize);
+		if ( !CBHStorage_isStorage(slice->_owner) || !CBHStorage_isUnique(slice->_owner) )
+		{
+			CBHSlice_detachFromOwner(slice, capacity, shouldClear);
+			return;
+		}
+
+		/// Nothing else shares the storage, take the bytes back and reallocate them.
+		slice->_data = CBHStorage_takeBytes(slice->_owner);
+		[slice->_owner release];
+		slice->_owner = nil;
 	}
 
-	if ( !slice->_data ) @throw CBHReallocException;
+	void *data = CBHBuffer_realloc(slice->_data, slice->_capacity, capacity, slice->_entrySize, shouldClear, &slice->_options);
+	if ( !data ) @throw CBHReallocException;
+
+	slice->_data = data;
 
 	slice->_capacity = capacity;
+	++slice->_generation;
+}
+
+
+#pragma mark - Sharing
+
+id CBHSlice_shareStorage(CBHSlice_t *slice)
+{
+	/// Inline bytes die with their collection, they move to the heap before they can be shared.
+	if ( slice->_isInline ) CBHSlice_detachFromOwner(slice, slice->_capacity, NO);
+
+	void **field = (void **)&slice->_owner;
+	void *owner = __atomic_load_n(field, __ATOMIC_ACQUIRE);
+
+	if ( !owner )
+	{
+		_CBHStorage *storage = [[_CBHStorage alloc] initOwningBytes:slice->_data length:slice->_capacity * slice->_entrySize options:slice->_options];
+
+		/// Immutable slices may be shared from several threads at once.
+		if ( __atomic_compare_exchange_n(field, &owner, (void *)storage, NO, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) ) return storage;
+
+		/// Lost the race, the bytes belong to the winner's storage.
+		CBHStorage_takeBytes(storage);
+		[storage release];
+	}
+
+	return ( CBHStorage_isStorage((id)owner) ) ? (id)owner : nil;
+}
+
+inline BOOL CBHSlice_makeUnique(CBHSlice_t *slice)
+{
+	if ( !slice->_owner ) return NO;
+	if ( !CBHStorage_isStorage(slice->_owner) || CBHStorage_isUnique(slice->_owner) ) return NO;
+
+	CBHSlice_detachFromOwner(slice, slice->_capacity, NO);
+	return YES;
+}
+
+BOOL CBHSlice_makeUniqueWithReferences(CBHSlice_t *slice, void (NS_NOESCAPE ^references)(const void *data, BOOL retain))
+{
+	if ( !slice->_owner ) return NO;
+	if ( !CBHStorage_isStorage(slice->_owner) || CBHStorage_isUnique(slice->_owner) ) return NO;
+
+	void *data = CBHBuffer_alloc(slice->_capacity, slice->_entrySize, NO, &slice->_options);
+	if ( !data ) @throw CBHReallocException;
+
+	CBHMemory_copyTo(slice->_data, data, slice->_capacity, slice->_entrySize);
+
+	/// The last sharer to let go releases the entries, so the copy's references are taken before the storage is.
+	references(data, YES);
+
+	if ( !CBHStorage_releaseIfShared(slice->_owner) )
+	{
+		/// Every other sharer let go meanwhile, the storage and its references are ours alone.
+		references(data, NO);
+		CBHBuffer_free(data, slice->_capacity, slice->_entrySize, &slice->_options);
+		return NO;
+	}
+
+	slice->_owner = nil;
+	slice->_data = data;
+	++slice->_generation;
+
+	return YES;
+}
+
+BOOL CBHSlice_releaseShared(CBHSlice_t *slice)
+{
+	if ( !slice->_owner || !CBHStorage_isStorage(slice->_owner) ) return NO;
+	if ( !CBHStorage_releaseIfShared(slice->_owner) ) return NO;
+
+	slice->_owner = nil;
+	slice->_data = NULL;
+	slice->_capacity = 0;
+	++slice->_generation;
+
+	return YES;
 }
 
 
 #pragma mark - Copying
 
-void CBHSlice_copyValueAtOffset(const CBHSlice_t *slice, const NSUInteger src, const NSUInteger dst)
+void CBHSlice_copyValueAtOffset(CBHSlice_t *slice, const NSUInteger src, const NSUInteger dst)
 {
 	if ( src == dst ) return;
 
 	_guardOffsetInBounds(src);
 	_guardOffsetInBounds(dst);
+	CBHSlice_makeUnique(slice);
 
 	CBHMemory_copyTo(_pointerToOffset(src), _pointerToOffset(dst), 1, slice->_entrySize);
 }
 
-void CBHSlice_copyValuesInRange(const CBHSlice_t *slice, const NSUInteger src, const NSUInteger dst, const NSUInteger length)
+void CBHSlice_copyValuesInRange(CBHSlice_t *slice, const NSUInteger src, const NSUInteger dst, const NSUInteger length)
 {
 	if ( src == dst ) return;
 
 	_guardOffsetInBounds(src);
 	_guardOffsetInBounds(src + length - 1);
 	_guardOffsetInBounds(dst + length - 1);
+	CBHSlice_makeUnique(slice);
 
 	CBHMemory_copyTo(_pointerToOffset(src), _pointerToOffset(dst), length, slice->_entrySize);
 }
@@ -164,17 +326,18 @@ void CBHSlice_copyValuesInRange(const CBHSlice_t *slice, const NSUInteger src, c
 
 #pragma mark - Swapping
 
-void CBHSlice_swapValuesAtOffsets(const CBHSlice_t *slice, const NSUInteger a, const NSUInteger b)
+void CBHSlice_swapValuesAtOffsets(CBHSlice_t *slice, const NSUInteger a, const NSUInteger b)
 {
 	if ( a == b ) return;
 
 	_guardOffsetInBounds(a);
 	_guardOffsetInBounds(b);
+	CBHSlice_makeUnique(slice);
 
 	CBHMemory_swapBytes(_pointerToOffset(a), _pointerToOffset(b), 1, slice->_entrySize);
 }
 
-BOOL CBHSlice_swapValuesInRange(const CBHSlice_t *slice, const NSUInteger a, const NSUInteger b, const NSUInteger length)
+BOOL CBHSlice_swapValuesInRange(CBHSlice_t *slice, const NSUInteger a, const NSUInteger b, const NSUInteger length)
 {
 	if ( a == b ) return NO;
 	_guardOffsetInBounds(a);
@@ -194,6 +357,7 @@ BOOL CBHSlice_swapValuesInRange(const CBHSlice_t *slice, const NSUInteger a, con
 		if ( a <= b_last ) { return NO; }
 	}
 
+	CBHSlice_makeUnique(slice);
 	CBHMemory_swapBytes(_pointerToOffset(a), _pointerToOffset(b), length, slice->_entrySize);
 	return YES;
 }
@@ -201,12 +365,13 @@ BOOL CBHSlice_swapValuesInRange(const CBHSlice_t *slice, const NSUInteger a, con
 
 #pragma mark - Zeroing
 
-void CBHSlice_zeroValuesInRange(const CBHSlice_t *slice, const NSUInteger index, const NSUInteger length)
+void CBHSlice_zeroValuesInRange(CBHSlice_t *slice, const NSUInteger index, const NSUInteger length)
 {
 	if ( length <= 0 ) return;
 
 	_guardOffsetInBounds(index);
 	_guardOffsetInBounds(index + length - 1);
+	CBHSlice_makeUnique(slice);
 
 	CBHMemory_zero(_pointerToOffset(index), length, slice->_entrySize);
 }
@@ -0,0 +1,70 @@
+//  _CBHSort.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import "CBHPrimitiveCollection.h"
+
+#include <string.h>
+
+
+#pragma mark - Keys
+
+typedef struct CBHSortKey_t {
+	size_t _offset;
+	size_t _size;
+	CBHPrimitiveType _type;
+} CBHSortKey_t;
+
+/// Returns the name of the exception an invalid key raises, or `nil` if the key fits entries of `entrySize`.
+NSExceptionName CBHSortKey_check(const CBHSortKey_t *key, size_t entrySize);
+void CBHSortKey_validate(const CBHSortKey_t *key, size_t entrySize);
+
+/// Loads the key of an entry and maps it onto an unsigned integer with the same ordering.
+static inline uint64_t CBHSortKey_bits(const void *entry, const CBHSortKey_t *key)
+{
+	uint64_t bits = 0;
+	const uint8_t *pointer = (const uint8_t *)entry + key->_offset;
+
+	switch ( key->_size )
+	{
+		case 1: { uint8_t value; memcpy(&value, pointer, 1); bits = value; break; }
+		case 2: { uint16_t value; memcpy(&value, pointer, 2); bits = value; break; }
+		case 4: { uint32_t value; memcpy(&value, pointer, 4); bits = value; break; }
+		default: { memcpy(&bits, pointer, 8); break; }
+	}
+
+	if ( key->_type == CBHPrimitiveTypeUnsigned ) return bits;
+
+	const uint64_t sign = 1ull << ((key->_size * 8) - 1);
+	if ( key->_type == CBHPrimitiveTypeSigned ) return bits ^ sign;
+
+	/// IEEE-754: Flip every bit of negatives, only the sign bit of positives.
+	const uint64_t mask = ( key->_size == 8 ) ? UINT64_MAX : ((1ull << (key->_size * 8)) - 1);
+	return ( bits & sign ) ? (~bits & mask) : (bits | sign);
+}
+
+
+#pragma mark - Sorting by Key
+
+void CBHSort_sortByKey(void *data, NSUInteger count, size_t entrySize, size_t keyOffset, size_t keySize, CBHPrimitiveType type);
+
+
+#pragma mark - Sorting by Comparator
+
+void CBHSort_sortUsingComparator(void *data, NSUInteger count, size_t entrySize, CBHPrimitiveComparator comparator, void *context);
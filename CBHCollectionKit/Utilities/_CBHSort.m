@@ -0,0 +1,461 @@
+//  _CBHSort.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "_CBHSort.h"
+
+@import Foundation.NSException;
+@import Foundation.NSProcessInfo;
+@import CBHMemoryKit;
+@import Dispatch;
+
+
+#define INSERTION_THRESHOLD 24
+#define NINTHER_THRESHOLD 128
+#define PARTIAL_INSERTION_LIMIT 8
+
+#define RADIX_INSERTION_THRESHOLD 64
+#define PARALLEL_THRESHOLD 65536
+
+#define _entry(aBase, anIndex) ((aBase) + ((anIndex) * entrySize))
+#define _less(a, b) (comparator((a), (b), context) == NSOrderedAscending)
+#define _swap(a, b) CBHMemory_swapBytes((a), (b), 1, entrySize)
+#define _copy(src, dst) memcpy((dst), (src), entrySize)
+
+#define _digitOf(anEntry, aDigit) ((NSUInteger)((CBHSortKey_bits((anEntry), key) >> ((aDigit) * 8)) & 0xFF))
+
+
+#pragma mark - Utilities
+
+static inline BOOL CBHSort_shouldParallelize(NSUInteger count)
+{
+	return ( count >= PARALLEL_THRESHOLD && [[NSProcessInfo processInfo] activeProcessorCount] > 1 );
+}
+
+static inline NSUInteger CBHSort_log2(NSUInteger value)
+{
+	NSUInteger log = 0;
+	while ( value >>= 1 ) ++log;
+	return log;
+}
+
+
+#pragma mark - Keys
+
+NSExceptionName CBHSortKey_check(const CBHSortKey_t *key, size_t entrySize)
+{
+	if ( key->_size != 1 && key->_size != 2 && key->_size != 4 && key->_size != 8 ) return CBHEntrySizeException;
+	if ( key->_type == CBHPrimitiveTypeFloat && key->_size != 4 && key->_size != 8 ) return CBHEntrySizeException;
+	if ( key->_offset > entrySize || key->_size > entrySize - key->_offset ) return NSRangeException;
+
+	return nil;
+}
+
+void CBHSortKey_validate(const CBHSortKey_t *key, size_t entrySize)
+{
+	NSExceptionName exception = CBHSortKey_check(key, entrySize);
+	if ( exception ) @throw exception;
+}
+
+static void CBHSort_insertionByKey(uint8_t *base, NSUInteger count, size_t entrySize, const CBHSortKey_t *key, uint8_t *tmp)
+{
+	for (NSUInteger i = 1; i < count; ++i)
+	{
+		const uint64_t bits = CBHSortKey_bits(_entry(base, i), key);
+		if ( CBHSortKey_bits(_entry(base, i - 1), key) <= bits ) continue;
+
+		NSUInteger j = i - 1;
+		while ( j > 0 && CBHSortKey_bits(_entry(base, j - 1), key) > bits ) --j;
+
+		_copy(_entry(base, i), tmp);
+		memmove(_entry(base, j + 1), _entry(base, j), (i - j) * entrySize);
+		_copy(tmp, _entry(base, j));
+	}
+}
+
+
+#pragma mark - Radix Sort
+
+/// In-place MSD radix sort (American flag sort). `tmp` must hold two entries.
+static void CBHSort_radix(uint8_t *base, NSUInteger count, size_t entrySize, const CBHSortKey_t *key, NSUInteger digit, uint8_t *tmp)
+{
+	while ( YES )
+	{
+		if ( count <= RADIX_INSERTION_THRESHOLD )
+		{
+			CBHSort_insertionByKey(base, count, entrySize, key, tmp);
+			return;
+		}
+
+		/// Count the entries in each bucket.
+		NSUInteger histogram[256] = {0};
+		for (NSUInteger i = 0; i < count; ++i) { ++histogram[_digitOf(_entry(base, i), digit)]; }
+
+		/// Skip digits which don't distinguish any entries.
+		if ( histogram[_digitOf(base, digit)] == count )
+		{
+			if ( digit == 0 ) return;
+			--digit;
+			continue;
+		}
+
+		/// Find bucket boundaries.
+		NSUInteger starts[257];
+		NSUInteger heads[256];
+		starts[0] = 0;
+		for (NSUInteger d = 0; d < 256; ++d)
+		{
+			heads[d] = starts[d];
+			starts[d + 1] = starts[d] + histogram[d];
+		}
+
+		/// Permute entries into their buckets by following cycles.
+		uint8_t *carried = tmp;
+		uint8_t *displaced = tmp + entrySize;
+		for (NSUInteger d = 0; d < 256; ++d)
+		{
+			while ( heads[d] < starts[d + 1] )
+			{
+				uint8_t *slot = _entry(base, heads[d]);
+				NSUInteger target = _digitOf(slot, digit);
+				if ( target == d ) { ++heads[d]; continue; }
+
+				_copy(slot, carried);
+				do
+				{
+					uint8_t *destination = _entry(base, heads[target]);
+					++heads[target];
+
+					_copy(destination, displaced);
+					_copy(carried, destination);
+					_copy(displaced, carried);
+
+					target = _digitOf(carried, digit);
+				}
+				while ( target != d );
+
+				_copy(carried, slot);
+				++heads[d];
+			}
+		}
+
+		if ( digit == 0 ) return;
+
+		/// Sort each bucket by the next digit. Each bucket sorted concurrently needs its own scratch entries, without them the buckets are sorted here.
+		uint8_t *bucketTmps = ( CBHSort_shouldParallelize(count) ) ? CBHMemory_alloc(256 * 2, entrySize) : NULL;
+		if ( bucketTmps )
+		{
+			const NSUInteger *bucketStarts = starts;
+			dispatch_apply(256, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t d) {
+				NSUInteger bucketCount = bucketStarts[d + 1] - bucketStarts[d];
+				if ( bucketCount <= 1 ) return;
+
+				CBHSort_radix(_entry(base, bucketStarts[d]), bucketCount, entrySize, key, digit - 1, _entry(bucketTmps, d * 2));
+			});
+			CBHMemory_free(bucketTmps);
+			return;
+		}
+
+		for (NSUInteger d = 0; d < 256; ++d)
+		{
+			NSUInteger bucketCount = starts[d + 1] - starts[d];
+			if ( bucketCount <= 1 ) continue;
+
+			CBHSort_radix(_entry(base, starts[d]), bucketCount, entrySize, key, digit - 1, tmp);
+		}
+		return;
+	}
+}
+
+
+#pragma mark - Introsort Primitives
+
+static void CBHSort_insertion(uint8_t *base, NSUInteger count, size_t entrySize, CBHPrimitiveComparator comparator, void *context, uint8_t *tmp)
+{
+	for (NSUInteger i = 1; i < count; ++i)
+	{
+		if ( !_less(_entry(base, i), _entry(base, i - 1)) ) continue;
+
+		_copy(_entry(base, i), tmp);
+
+		NSUInteger j = i - 1;
+		while ( j > 0 && _less(tmp, _entry(base, j - 1)) ) --j;
+
+		memmove(_entry(base, j + 1), _entry(base, j), (i - j) * entrySize);
+		_copy(tmp, _entry(base, j));
+	}
+}
+
+/// Insertion sort which gives up after moving `PARTIAL_INSERTION_LIMIT` entries. Returns whether the range was sorted.
+static BOOL CBHSort_partialInsertion(uint8_t *base, NSUInteger count, size_t entrySize, CBHPrimitiveComparator comparator, void *context, uint8_t *tmp)
+{
+	NSUInteger moved = 0;
+
+	for (NSUInteger i = 1; i < count; ++i)
+	{
+		if ( !_less(_entry(base, i), _entry(base, i - 1)) ) continue;
+
+		_copy(_entry(base, i), tmp);
+
+		NSUInteger j = i - 1;
+		while ( j > 0 && _less(tmp, _entry(base, j - 1)) ) --j;
+
+		memmove(_entry(base, j + 1), _entry(base, j), (i - j) * entrySize);
+		_copy(tmp, _entry(base, j));
+
+		moved += i - j;
+		if ( moved > PARTIAL_INSERTION_LIMIT ) return NO;
+	}
+
+	return YES;
+}
+
+static void CBHSort_siftDown(uint8_t *base, NSUInteger index, NSUInteger count, size_t entrySize, CBHPrimitiveComparator comparator, void *context)
+{
+	while ( YES )
+	{
+		NSUInteger child = (2 * index) + 1;
+		if ( child >= count ) return;
+
+		if ( child + 1 < count && _less(_entry(base, child), _entry(base, child + 1)) ) ++child;
+		if ( !_less(_entry(base, index), _entry(base, child)) ) return;
+
+		_swap(_entry(base, index), _entry(base, child));
+		index = child;
+	}
+}
+
+static void CBHSort_heap(uint8_t *base, NSUInteger count, size_t entrySize, CBHPrimitiveComparator comparator, void *context)
+{
+	for (NSUInteger i = count / 2; i > 0; --i) { CBHSort_siftDown(base, i - 1, count, entrySize, comparator, context); }
+
+	for (NSUInteger end = count - 1; end > 0; --end)
+	{
+		_swap(base, _entry(base, end));
+		CBHSort_siftDown(base, 0, end, entrySize, comparator, context);
+	}
+}
+
+/// Orders the entries at `a`, `b` and `c` so the median ends up at `b`.
+static inline void CBHSort_sort3(uint8_t *a, uint8_t *b, uint8_t *c, size_t entrySize, CBHPrimitiveComparator comparator, void *context)
+{
+	if ( _less(b, a) ) _swap(a, b);
+	if ( _less(c, b) ) _swap(b, c);
+	if ( _less(b, a) ) _swap(a, b);
+}
+
+/// Partitions around the pivot at `base[0]`. Entries less than the pivot end up left of it. Returns the pivot position.
+static NSUInteger CBHSort_partitionRight(uint8_t *base, NSUInteger count, size_t entrySize, CBHPrimitiveComparator comparator, void *context, uint8_t *pivot, BOOL *alreadyPartitioned)
+{
+	_copy(base, pivot);
+
+	NSUInteger i = 1;
+	NSUInteger j = count - 1;
+	BOOL swapped = NO;
+
+	while ( YES )
+	{
+		while ( i <= j && _less(_entry(base, i), pivot) ) ++i;
+		while ( i <= j && !_less(_entry(base, j), pivot) ) --j;
+		if ( i > j ) break;
+
+		_swap(_entry(base, i), _entry(base, j));
+		swapped = YES;
+		++i;
+		--j;
+	}
+
+	NSUInteger position = i - 1;
+	_swap(base, _entry(base, position));
+
+	*alreadyPartitioned = !swapped;
+	return position;
+}
+
+/// Partitions around the pivot at `base[0]`, placing entries equal to the pivot left of it. Returns the pivot position.
+static NSUInteger CBHSort_partitionLeft(uint8_t *base, NSUInteger count, size_t entrySize, CBHPrimitiveComparator comparator, void *context, uint8_t *pivot)
+{
+	_copy(base, pivot);
+
+	NSUInteger i = 1;
+	NSUInteger j = count - 1;
+
+	while ( YES )
+	{
+		while ( i <= j && !_less(pivot, _entry(base, i)) ) ++i;
+		while ( i <= j && _less(pivot, _entry(base, j)) ) --j;
+		if ( i > j ) break;
+
+		_swap(_entry(base, i), _entry(base, j));
+		++i;
+		--j;
+	}
+
+	NSUInteger position = i - 1;
+	_swap(base, _entry(base, position));
+
+	return position;
+}
+
+/// Moves a few entries around to break up patterns which produced an unbalanced partition.
+static void CBHSort_breakPatterns(uint8_t *base, NSUInteger count, size_t entrySize)
+{
+	if ( count < INSERTION_THRESHOLD ) return;
+
+	NSUInteger quarter = count / 4;
+	_swap(base, _entry(base, quarter));
+	_swap(_entry(base, count - 1), _entry(base, count - quarter));
+
+	if ( count > NINTHER_THRESHOLD )
+	{
+		_swap(_entry(base, 1), _entry(base, quarter + 1));
+		_swap(_entry(base, 2), _entry(base, quarter + 2));
+		_swap(_entry(base, count - 2), _entry(base, count - (quarter + 1)));
+		_swap(_entry(base, count - 3), _entry(base, count - (quarter + 2)));
+	}
+}
+
+
+#pragma mark - Introsort
+
+/// Pattern-defeating quicksort. `tmp` must hold two entries. When `group` is provided large partitions are sorted concurrently.
+static void CBHSort_introsort(uint8_t *base, NSUInteger count, size_t entrySize, CBHPrimitiveComparator comparator, void *context, NSUInteger badAllowed, BOOL leftmost, uint8_t *tmp, dispatch_group_t group)
+{
+	while ( YES )
+	{
+		if ( count < INSERTION_THRESHOLD )
+		{
+			CBHSort_insertion(base, count, entrySize, comparator, context, tmp);
+			return;
+		}
+
+		/// Choose a pivot and move it to the front.
+		NSUInteger half = count / 2;
+		if ( count > NINTHER_THRESHOLD )
+		{
+			CBHSort_sort3(base, _entry(base, half), _entry(base, count - 1), entrySize, comparator, context);
+			CBHSort_sort3(_entry(base, 1), _entry(base, half - 1), _entry(base, count - 2), entrySize, comparator, context);
+			CBHSort_sort3(_entry(base, 2), _entry(base, half + 1), _entry(base, count - 3), entrySize, comparator, context);
+			CBHSort_sort3(_entry(base, half - 1), _entry(base, half), _entry(base, half + 1), entrySize, comparator, context);
+			_swap(base, _entry(base, half));
+		}
+		else
+		{
+			CBHSort_sort3(_entry(base, half), base, _entry(base, count - 1), entrySize, comparator, context);
+		}
+
+		/// If the pivot equals the entry preceding this range every entry equal to it is already in place.
+		if ( !leftmost && !_less(base - entrySize, base) )
+		{
+			NSUInteger position = CBHSort_partitionLeft(base, count, entrySize, comparator, context, tmp);
+			base = _entry(base, position + 1);
+			count -= position + 1;
+			continue;
+		}
+
+		BOOL alreadyPartitioned = NO;
+		NSUInteger position = CBHSort_partitionRight(base, count, entrySize, comparator, context, tmp, &alreadyPartitioned);
+
+		NSUInteger leftCount = position;
+		NSUInteger rightCount = count - position - 1;
+		uint8_t *right = _entry(base, position + 1);
+
+		if ( leftCount < count / 8 || rightCount < count / 8 )
+		{
+			/// Too many bad partitions, fall back to a guaranteed O(n log n).
+			if ( --badAllowed == 0 )
+			{
+				CBHSort_heap(base, count, entrySize, comparator, context);
+				return;
+			}
+
+			CBHSort_breakPatterns(base, leftCount, entrySize);
+			CBHSort_breakPatterns(right, rightCount, entrySize);
+		}
+		else if ( alreadyPartitioned )
+		{
+			/// The input may already be sorted. Try to finish cheaply.
+			if ( CBHSort_partialInsertion(base, leftCount, entrySize, comparator, context, tmp) && CBHSort_partialInsertion(right, rightCount, entrySize, comparator, context, tmp) ) return;
+		}
+
+		/// Sort the left partition, then continue with the right. The left partition is only handed to another core if it has scratch entries of its own.
+		uint8_t *leftTmp = ( group && leftCount >= PARALLEL_THRESHOLD ) ? CBHMemory_alloc(2, entrySize) : NULL;
+		if ( leftTmp )
+		{
+			uint8_t *left = base;
+			BOOL leftIsLeftmost = leftmost;
+			dispatch_group_async(group, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+				uint8_t *taskTmp = leftTmp;
+				CBHSort_introsort(left, leftCount, entrySize, comparator, context, badAllowed, leftIsLeftmost, taskTmp, group);
+				CBHMemory_free(taskTmp);
+			});
+		}
+		else
+		{
+			CBHSort_introsort(base, leftCount, entrySize, comparator, context, badAllowed, leftmost, tmp, group);
+		}
+
+		base = right;
+		count = rightCount;
+		leftmost = NO;
+	}
+}
+
+
+#pragma mark - Sorting by Key
+
+void CBHSort_sortByKey(void *data, NSUInteger count, size_t entrySize, size_t keyOffset, size_t keySize, CBHPrimitiveType type)
+{
+	CBHSortKey_t key = {keyOffset, keySize, type};
+	CBHSortKey_validate(&key, entrySize);
+
+	if ( count <= 1 ) return;
+
+	uint8_t *tmp = CBHMemory_alloc(2, entrySize);
+	if ( !tmp ) @throw CBHCallocException;
+
+	CBHSort_radix((uint8_t *)data, count, entrySize, &key, keySize - 1, tmp);
+
+	CBHMemory_free(tmp);
+}
+
+
+#pragma mark - Sorting by Comparator
+
+void CBHSort_sortUsingComparator(void *data, NSUInteger count, size_t entrySize, CBHPrimitiveComparator comparator, void *context)
+{
+	if ( count <= 1 ) return;
+
+	uint8_t *tmp = CBHMemory_alloc(2, entrySize);
+	if ( !tmp ) @throw CBHCallocException;
+
+	NSUInteger badAllowed = CBHSort_log2(count);
+
+	if ( CBHSort_shouldParallelize(count) )
+	{
+		dispatch_group_t group = dispatch_group_create();
+		CBHSort_introsort((uint8_t *)data, count, entrySize, comparator, context, badAllowed, YES, tmp, group);
+		dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+		dispatch_release(group);
+	}
+	else
+	{
+		CBHSort_introsort((uint8_t *)data, count, entrySize, comparator, context, badAllowed, YES, tmp, NULL);
+	}
+
+	CBHMemory_free(tmp);
+}
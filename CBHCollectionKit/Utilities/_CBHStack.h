@@ -25,7 +25,16 @@
 #pragma mark - Initializers
 
 CBHStack_t CBHStack_init(NSUInteger capacity, size_t entrySize);
+CBHStack_t CBHStack_initWithOptions(NSUInteger capacity, size_t entrySize, const CBHAllocationOptions *options);
+
+/// Initializes a stack over the inline `bytes` of its collection if `capacity` entries fit, otherwise on the heap.
+CBHStack_t CBHStack_initInline(void *bytes, NSUInteger capacity, size_t entrySize, const CBHAllocationOptions *options);
 CBHStack_t CBHStack_initCopyingBytesWithCount(const void *pointer, size_t entrySize, NSUInteger capacity, NSUInteger count);
+CBHStack_t CBHStack_initBorrowingBytes(void *pointer, size_t entrySize, NSUInteger capacity, NSUInteger count, id owner);
+CBHStack_t CBHStack_initSharing(CBHStack_t *stack);
+
+/// Copies storage shared with another stack of objects so it can be written to, retaining the objects in use for the copy. Returns `YES` if the bytes were copied.
+BOOL CBHStack_makeUniqueRetainingObjects(CBHStack_t *stack);
 
 
 #pragma mark - Destructors
@@ -17,6 +17,7 @@
 //  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 #import "_CBHStack.h"
+#import "_CBHBuffer.h"
 
 @import Foundation.NSException;
 @import CBHMemoryKit;
@@ -31,19 +32,39 @@
 #pragma mark - Initializers
 
 CBHStack_t CBHStack_init(const NSUInteger capacity, const size_t entrySize)
+{
+	return CBHStack_initWithOptions(capacity, entrySize, &CBHAllocationOptionsDefault);
+}
+
+CBHStack_t CBHStack_initWithOptions(const NSUInteger capacity, const size_t entrySize, const CBHAllocationOptions *options)
 {
 	CBHStack_t retVal;
 
-	retVal._data = CBHMemory_alloc(capacity, entrySize);
+	retVal._data = CBHBuffer_alloc(capacity, entrySize, NO, options);
 	if ( !retVal._data ) @throw CBHCallocException;
 
 	retVal._entrySize = entrySize;
 	retVal._capacity = capacity;
+	retVal._generation = 0;
+	retVal._owner = nil;
+	retVal._options = *options;
+	retVal._isInline = NO;
 	retVal._count = 0;
 
 	return retVal;
 }
 
+CBHStack_t CBHStack_initInline(void *bytes, const NSUInteger capacity, const size_t entrySize, const CBHAllocationOptions *options)
+{
+	if ( !CBHBuffer_fitsInline(capacity, entrySize, options) ) return CBHStack_initWithOptions(capacity, entrySize, options);
+
+	CBHStack_t retVal = CBHStack_initBorrowingBytes(bytes, entrySize, capacity, 0, nil);
+	retVal._options = *options;
+	retVal._isInline = YES;
+
+	return retVal;
+}
+
 CBHStack_t CBHStack_initCopyingBytesWithCount(const void *pointer, const size_t entrySize, const NSUInteger capacity, const NSUInteger count)
 {
 	CBHStack_t retVal;
@@ -52,18 +73,73 @@ CBHStack_t CBHStack_initCopyingBytesWithCount(const void *pointer, const size_t
 	if ( !retVal._data ) @throw CBHCallocException;
 
 	retVal._capacity = capacity;
+	retVal._generation = 0;
+	retVal._owner = nil;
+	retVal._options = CBHAllocationOptionsDefault;
+	retVal._isInline = NO;
 	retVal._entrySize = entrySize;
+	retVal._count = count;
 
 	CBHMemory_copyTo(pointer, retVal._data, count, entrySize);
 
 	return retVal;
 }
 
+CBHStack_t CBHStack_initBorrowingBytes(void *pointer, const size_t entrySize, const NSUInteger capacity, const NSUInteger count, id owner)
+{
+	CBHStack_t retVal;
+
+	retVal._data = pointer;
+
+	retVal._entrySize = entrySize;
+	retVal._capacity = capacity;
+	retVal._generation = 0;
+	retVal._owner = [owner retain];
+	retVal._options = CBHAllocationOptionsDefault;
+	retVal._isInline = NO;
+	retVal._count = count;
+
+	return retVal;
+}
+
+CBHStack_t CBHStack_initSharing(CBHStack_t *stack)
+{
+	id owner = CBHSlice_shareStorage((CBHSlice_t *)stack);
+	if ( !owner )
+	{
+		CBHStack_t retVal = CBHStack_initWithOptions(stack->_capacity, stack->_entrySize, &stack->_options);
+		CBHMemory_copyTo(stack->_data, retVal._data, stack->_count, stack->_entrySize);
+		retVal._count = stack->_count;
+
+		return retVal;
+	}
+
+	CBHStack_t retVal = CBHStack_initBorrowingBytes(stack->_data, stack->_entrySize, stack->_capacity, stack->_count, owner);
+	retVal._options = stack->_options;
+
+	return retVal;
+}
+
+BOOL CBHStack_makeUniqueRetainingObjects(CBHStack_t *stack)
+{
+	const NSUInteger count = stack->_count;
+
+	return CBHSlice_makeUniqueWithReferences((CBHSlice_t *)stack, ^(const void *data, BOOL retain) {
+		const void * const *objects = (const void * const *)data;
+		for (NSUInteger i = 0; i < count; ++i)
+		{
+			if ( retain ) CFRetain(objects[i]);
+			else CFRelease(objects[i]);
+		}
+	});
+}
+
+
 #pragma mark - Destructors
 
 void CBHStack_dealloc(CBHStack_t *stack)
 {
-	CBHMemory_free(stack->_data);
+	CBHSlice_dealloc((CBHSlice_t *)stack);
 }
 
 
@@ -71,6 +147,7 @@ void CBHStack_dealloc(CBHStack_t *stack)
 
 inline void CBHStack_pushValue(CBHStack_t *stack, const void *value)
 {
+	CBHSlice_makeUnique((CBHSlice_t *)stack);
 	CBHMemory_copyTo(value, _pointerToOffset(stack->_count), 1, stack->_entrySize);
 	++stack->_count;
 }
@@ -78,6 +155,8 @@ inline void CBHStack_pushValue(CBHStack_t *stack, const void *value)
 inline void CBHStack_setValueAtIndex(CBHStack_t *stack, const void *value, const size_t index)
 {
 	_guardOffsetInBounds(index);
+	CBHSlice_makeUnique((CBHSlice_t *)stack);
+
 	CBHMemory_copyTo(value, _pointerToOffset(index), 1, stack->_entrySize);
 }
 
@@ -100,10 +179,5 @@ inline const void *CBHStack_peekValue(CBHStack_t *stack)
 
 inline void CBHStack_setCapacity(CBHStack_t *stack, const NSUInteger capacity)
 {
-	if (capacity == stack->_capacity) return;
-
-	stack->_data = CBHMemory_realloc(stack->_data, capacity, stack->_entrySize);
-	if ( !stack->_data ) @throw CBHReallocException;
-
-	stack->_capacity = capacity;
+	CBHSlice_setCapacity((CBHSlice_t *)stack, capacity, NO);
 }
@@ -0,0 +1,50 @@
+//  _CBHStorage.h
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import Foundation;
+
+#import "CBHAllocation.h"
+
+
+#pragma mark - Storage
+
+/// Heap bytes shared between collections until one of them writes to them.
+///
+/// Keeps its own atomic reference count so collections can ask whether they are its only owner.
+@interface _CBHStorage : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+/// Takes `length` bytes allocated as described by `options`, which are used again to free them.
+- (instancetype)initOwningBytes:(void *)bytes length:(size_t)length options:(CBHAllocationOptions)options NS_DESIGNATED_INITIALIZER;
+
+@end
+
+
+#pragma mark - Ownership
+
+/// Whether `owner` is shared storage rather than an object whose bytes are written through.
+BOOL CBHStorage_isStorage(id owner);
+
+/// Whether the caller holds the only reference to `storage`.
+BOOL CBHStorage_isUnique(_CBHStorage *storage);
+
+/// Releases `storage` unless the caller holds the only reference. Returns `YES` if it was released.
+BOOL CBHStorage_releaseIfShared(_CBHStorage *storage);
+
+/// Takes the bytes back from `storage` so that they are not freed with it.
+void *CBHStorage_takeBytes(_CBHStorage *storage);
@@ -0,0 +1,111 @@
+//  _CBHStorage.m
+//  CBHCollectionKit
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#import "_CBHStorage.h"
+#import "_CBHBuffer.h"
+
+#include <stdatomic.h>
+
+
+@implementation _CBHStorage
+{
+	void *_bytes;
+	size_t _length;
+	CBHAllocationOptions _options;
+
+	/// References beyond the first, so zero means a single owner.
+	_Atomic(NSUInteger) _extraReferences;
+}
+
+#pragma mark - Initialization
+
+- (instancetype)initOwningBytes:(void *)bytes length:(size_t)length options:(CBHAllocationOptions)options
+{
+	if ( (self = [super init]) )
+	{
+		_bytes = bytes;
+		_length = length;
+		_options = options;
+		atomic_init(&_extraReferences, 0);
+	}
+
+	return self;
+}
+
+
+#pragma mark - Destructor
+
+- (void)dealloc
+{
+	CBHBuffer_free(_bytes, _length, 1, &_options);
+	[super dealloc];
+}
+
+
+#pragma mark - Reference Counting
+
+- (instancetype)retain
+{
+	atomic_fetch_add_explicit(&_extraReferences, 1, memory_order_relaxed);
+	return self;
+}
+
+- (oneway void)release
+{
+	if ( atomic_fetch_sub_explicit(&_extraReferences, 1, memory_order_acq_rel) == 0 ) [self dealloc];
+}
+
+- (NSUInteger)retainCount
+{
+	return atomic_load_explicit(&_extraReferences, memory_order_relaxed) + 1;
+}
+
+
+#pragma mark - Ownership
+
+BOOL CBHStorage_isStorage(id owner)
+{
+	return [owner isKindOfClass:[_CBHStorage class]];
+}
+
+BOOL CBHStorage_isUnique(_CBHStorage *storage)
+{
+	return ( atomic_load_explicit(&storage->_extraReferences, memory_order_acquire) == 0 );
+}
+
+BOOL CBHStorage_releaseIfShared(_CBHStorage *storage)
+{
+	/// Never drops the last reference, so the caller can still tear down the contents.
+	NSUInteger references = atomic_load_explicit(&storage->_extraReferences, memory_order_relaxed);
+	while ( references > 0 )
+	{
+		if ( atomic_compare_exchange_weak_explicit(&storage->_extraReferences, &references, references - 1, memory_order_acq_rel, memory_order_relaxed) ) return YES;
+	}
+
+	return NO;
+}
+
+void *CBHStorage_takeBytes(_CBHStorage *storage)
+{
+	void *bytes = storage->_bytes;
+	storage->_bytes = NULL;
+
+	return bytes;
+}
+
+@end
@@ -20,12 +20,79 @@
 
 @import CBHCollectionKit.CBHStack;
 @import CBHCollectionKit.CBHQueue;
+@import CBHCollectionKit.CBHHeap;
+@import CBHCollectionKit.CBHConcurrentHeap;
+@import CBHCollectionKit.CBHConcurrentStack;
+@import CBHCollectionKit.CBHBlockingQueue;
+@import CBHCollectionKit.CBHPersistentStack;
+@import CBHCollectionKit.CBHPersistentQueue;
 @import CBHCollectionKit.CBHWedge;
+@import CBHCollectionKit.CBHMutableSlice;
+@import CBHCollectionKit.CBHCollectionCoder;
+@import CBHCollectionKit.CBHObjectCodec;
+@import CBHCollectionKit.CBHSliceReader;
+@import CBHCollectionKit.CBHArenaAllocator;
+@import CBHCollectionKit.CBHThreadCacheAllocator;
+@import CBHCollectionKit.CBHCollectionPool;
+@import CBHCollectionKit.CBHBitSlice;
+@import CBHCollectionKit.CBHPackedWedge;
+@import CBHCollectionKit.CBHCompressedWedge;
+@import CBHCollectionKit.CBHTable;
+@import CBHCollectionKit.CBHPrimitiveHashMap;
+
+#include <pthread.h>
 
 
 #define ITERATIONS 100000
 
 
+static NSComparisonResult CBHCompareUnsigned(const void *a, const void *b, void *context)
+{
+	NSUInteger lhs = *(const NSUInteger *)a;
+	NSUInteger rhs = *(const NSUInteger *)b;
+
+	if ( lhs < rhs ) return NSOrderedAscending;
+	if ( lhs > rhs ) return NSOrderedDescending;
+	return NSOrderedSame;
+}
+
+static int CBHQSortCompareUnsigned(const void *a, const void *b)
+{
+	NSUInteger lhs = *(const NSUInteger *)a;
+	NSUInteger rhs = *(const NSUInteger *)b;
+
+	return ( lhs > rhs ) - ( lhs < rhs );
+}
+
+static void CBHSquareRoot(void *entries, NSUInteger count, void *context)
+{
+	double *values = (double *)entries;
+	for (NSUInteger i = 0; i < count; ++i) { values[i] = sqrt(values[i]); }
+}
+
+static void CBHSumDoubles(void *accumulator, const void *entries, NSUInteger count, void *context)
+{
+	const double *values = (const double *)entries;
+	double sum = *(double *)accumulator;
+	for (NSUInteger i = 0; i < count; ++i) { sum += values[i]; }
+	*(double *)accumulator = sum;
+}
+
+static void CBHFillRandom(CBHMutableSlice *slice)
+{
+	NSUInteger state = 0x9E3779B97F4A7C15;
+	NSUInteger capacity = [slice capacity];
+
+	for (NSUInteger i = 0; i < capacity; ++i)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		[slice setUnsignedInteger:state atIndex:i];
+	}
+}
+
+
 @interface CBHPerformanceTests : XCTestCase
 @end
 
@@ -93,6 +160,21 @@
 	}];
 }
 
+- (void)test_wedge_appendPackets
+{
+	uint8_t packet[4096];
+	for (NSUInteger i = 0; i < sizeof(packet); ++i) { packet[i] = (uint8_t)i; }
+	const uint8_t *bytes = packet;
+
+	[self measureBlock:^{
+		CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(uint8_t)];
+		for (NSUInteger i = 0; i < ITERATIONS / 100; ++i)
+		{
+			[wedge appendValues:bytes count:4096];
+		}
+	}];
+}
+
 - (void)test_wedge_appendUnsignedInteger
 {
 	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:8];
@@ -117,4 +199,1232 @@
 	}];
 }
 
+
+#pragma mark - Unsafe Access
+
+- (void)test_wedge_sumUnsignedInteger
+{
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:ITERATIONS];
+	for (NSUInteger i = 0; i < ITERATIONS; ++i) { [wedge appendUnsignedInteger:i]; }
+
+	[self measureBlock:^{
+		NSUInteger sum = 0;
+		for (NSUInteger i = 0; i < ITERATIONS; ++i)
+		{
+			sum += [wedge unsignedIntegerAtIndex:i];
+		}
+		XCTAssertEqual(sum, (ITERATIONS * (ITERATIONS - 1)) / 2);
+	}];
+}
+
+- (void)test_wedge_sumUnsafeBytes
+{
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:ITERATIONS];
+	for (NSUInteger i = 0; i < ITERATIONS; ++i) { [wedge appendUnsignedInteger:i]; }
+
+	[self measureBlock:^{
+		__block NSUInteger sum = 0;
+		[wedge withUnsafeBytes:^(CBHSliceView view) {
+			const NSUInteger *values = CBHMutableSliceView_entries(view, NSUInteger);
+			for (NSUInteger i = 0; i < view.count; ++i) { sum += values[i]; }
+		}];
+		XCTAssertEqual(sum, (ITERATIONS * (ITERATIONS - 1)) / 2);
+	}];
+}
+
+
+#pragma mark - Allocation
+
+- (void)measureFillWithOptions:(CBHAllocationOptions)options
+{
+	const NSUInteger count = 10000000;
+
+	[self measureBlock:^{
+		CBHMutableSlice *slice = [[CBHMutableSlice alloc] initWithEntrySize:sizeof(NSUInteger) andCapacity:count shouldClear:NO options:options];
+		[slice withUnsafeMutableBytes:^(CBHMutableSliceView view) {
+			NSUInteger *values = CBHMutableSliceView_entries(view, NSUInteger);
+			for (NSUInteger i = 0; i < view.count; ++i) { values[i] = i; }
+		}];
+		XCTAssertEqual([slice unsignedIntegerAtIndex:count - 1], count - 1);
+		[slice release];
+	}];
+}
+
+- (void)test_allocation_fill_default_1e7
+{
+	[self measureFillWithOptions:CBHAllocationOptionsDefault];
+}
+
+- (void)test_allocation_fill_hugePagesPrefault_1e7
+{
+	[self measureFillWithOptions:CBHAllocationOptionsMake(CBHCacheLineSize, CBHAllocationHugePages | CBHAllocationPrefault)];
+}
+
+- (void)measureSmallWedgesWithOptions:(CBHAllocationOptions)options
+{
+	[self measureBlock:^{
+		for (NSUInteger i = 0; i < ITERATIONS; ++i)
+		{
+			CBHWedge *wedge = [[CBHWedge alloc] initWithEntrySize:sizeof(NSUInteger) andCapacity:4 options:options];
+			for (NSUInteger j = 0; j < 16; ++j) { [wedge appendUnsignedInteger:j]; }
+			[wedge release];
+		}
+	}];
+}
+
+- (void)test_allocation_smallWedges_default
+{
+	[self measureSmallWedgesWithOptions:CBHAllocationOptionsDefault];
+}
+
+- (void)test_allocation_smallWedges_arena
+{
+	CBHArenaAllocator *arena = [CBHArenaAllocator arena];
+	[self measureSmallWedgesWithOptions:[arena allocationOptions]];
+}
+
+- (void)test_allocation_smallWedges_threadCache
+{
+	CBHThreadCacheAllocator *cache = [[[CBHThreadCacheAllocator alloc] init] autorelease];
+	[self measureSmallWedgesWithOptions:[cache allocationOptions]];
+}
+
+
+#pragma mark - Small Collections
+
+/// Eight entries fit inside each collection, so a cycle only allocates the object itself.
+- (void)test_smallCollections_stack
+{
+	NSNumber *object = @(1);
+
+	[self measureBlock:^{
+		for (NSUInteger i = 0; i < ITERATIONS; ++i)
+		{
+			CBHStack *stack = [[CBHStack alloc] initWithCapacity:8];
+			for (NSUInteger j = 0; j < 8; ++j) { [stack pushObject:object]; }
+			[stack release];
+		}
+	}];
+}
+
+- (void)test_smallCollections_queue
+{
+	NSNumber *object = @(1);
+
+	[self measureBlock:^{
+		for (NSUInteger i = 0; i < ITERATIONS; ++i)
+		{
+			CBHQueue *queue = [[CBHQueue alloc] initWithCapacity:8];
+			for (NSUInteger j = 0; j < 8; ++j) { [queue enqueueObject:object]; }
+			[queue release];
+		}
+	}];
+}
+
+- (void)test_smallCollections_wedge
+{
+	[self measureBlock:^{
+		for (NSUInteger i = 0; i < ITERATIONS; ++i)
+		{
+			CBHWedge *wedge = [[CBHWedge alloc] initWithEntrySize:sizeof(NSUInteger) andCapacity:8];
+			for (NSUInteger j = 0; j < 8; ++j) { [wedge appendUnsignedInteger:j]; }
+			[wedge release];
+		}
+	}];
+}
+
+- (void)test_smallCollections_array
+{
+	NSNumber *object = @(1);
+
+	[self measureBlock:^{
+		for (NSUInteger i = 0; i < ITERATIONS; ++i)
+		{
+			NSMutableArray *array = [[NSMutableArray alloc] initWithCapacity:8];
+			for (NSUInteger j = 0; j < 8; ++j) { [array addObject:object]; }
+			[array release];
+		}
+	}];
+}
+
+
+#pragma mark - Pooling
+
+/// A request which fills a 4KB byte buffer and a work list, then throws both away.
+- (void)test_pooling_requests_alloc
+{
+	NSNumber *object = @(1);
+
+	[self measureBlock:^{
+		for (NSUInteger i = 0; i < ITERATIONS; ++i)
+		{
+			CBHWedge *bytes = [[CBHWedge alloc] initWithEntrySize:1 andCapacity:4096];
+			CBHQueue *work = [[CBHQueue alloc] initWithCapacity:64];
+
+			for (NSUInteger j = 0; j < 64; ++j) { [work enqueueObject:object]; }
+			[bytes appendUnsignedChar:(unsigned char)i];
+
+			[work release];
+			[bytes release];
+		}
+	}];
+}
+
+- (void)test_pooling_requests_pool
+{
+	CBHCollectionPool *pool = [CBHCollectionPool pool];
+	NSNumber *object = @(1);
+
+	[self measureBlock:^{
+		for (NSUInteger i = 0; i < ITERATIONS; ++i)
+		{
+			@autoreleasepool
+			{
+				CBHWedge *bytes = [pool wedgeWithEntrySize:1 andCapacity:4096];
+				CBHQueue *work = [pool queueWithCapacity:64];
+
+				for (NSUInteger j = 0; j < 64; ++j) { [work enqueueObject:object]; }
+				[bytes appendUnsignedChar:(unsigned char)i];
+
+				[pool recycleQueue:work];
+				[pool recycleWedge:bytes];
+			}
+		}
+	}];
+}
+
+
+#pragma mark - Bit Slices
+
+/// Intersects two masks of 10^8 bits and counts the survivors.
+- (void)test_bitSlice_andPopCount_1e8
+{
+	CBHBitSlice *mask = [CBHBitSlice bitSliceWithCount:100000000];
+	CBHBitSlice *filter = [CBHBitSlice bitSliceWithCount:100000000];
+	for (NSUInteger i = 0; i < 100000000; i += 3) { [mask setBitAtIndex:i]; }
+	[filter setBitsInRange:NSMakeRange(0, 50000000)];
+
+	[self measureBlock:^{
+		CBHBitSlice *result = [mask copy];
+		[result andWithBitSlice:filter];
+		XCTAssertEqual([result popCount], (NSUInteger)16666667);
+		[result release];
+	}];
+}
+
+- (void)test_bitSlice_select_1e7
+{
+	CBHBitSlice *bits = [CBHBitSlice bitSliceWithCount:10000000];
+	for (NSUInteger i = 0; i < 10000000; i += 5) { [bits setBitAtIndex:i]; }
+
+	[self measureBlock:^{
+		NSUInteger sum = 0;
+		for (NSUInteger i = 0; i < ITERATIONS; ++i) { sum += [bits indexOfSetBitWithRank:(i * 7919) % 2000000]; }
+		XCTAssertGreaterThan(sum, (NSUInteger)0);
+	}];
+}
+
+
+#pragma mark - Packed Wedges
+
+/// Decode throughput in values per second is 10^7 over the measured time.
+- (void)measurePackedDecodeAtWidth:(NSUInteger)bitWidth
+{
+	const NSUInteger count = 10000000;
+	const uint64_t mask = ~(uint64_t)0 >> (64 - bitWidth);
+
+	CBHPackedWedge *wedge = [CBHPackedWedge packedWedgeWithBitWidth:bitWidth andCapacity:count];
+	for (uint64_t i = 0; i < count; ++i) { [wedge appendUInt64:(i * 0x9E3779B97F4A7C15) & mask]; }
+
+	void *values = malloc(count * sizeof(uint64_t));
+
+	[self measureBlock:^{
+		if ( bitWidth <= 32 ) [wedge getValues:values range:NSMakeRange(0, count) entrySize:sizeof(uint32_t)];
+		else [wedge getValues:values range:NSMakeRange(0, count) entrySize:sizeof(uint64_t)];
+	}];
+
+	free(values);
+}
+
+- (void)test_packedWedge_decode_12bit_1e7
+{
+	[self measurePackedDecodeAtWidth:12];
+}
+
+- (void)test_packedWedge_decode_20bit_1e7
+{
+	[self measurePackedDecodeAtWidth:20];
+}
+
+- (void)test_packedWedge_decode_61bit_1e7
+{
+	[self measurePackedDecodeAtWidth:61];
+}
+
+- (void)test_packedWedge_encode_20bit_1e7
+{
+	const NSUInteger count = 10000000;
+
+	uint32_t *values = malloc(count * sizeof(uint32_t));
+	for (NSUInteger i = 0; i < count; ++i) { values[i] = (uint32_t)(i & 0xFFFFF); }
+
+	[self measureBlock:^{
+		CBHPackedWedge *wedge = [[CBHPackedWedge alloc] initWithBitWidth:20 andCapacity:count];
+		[wedge appendValues:values count:count entrySize:sizeof(uint32_t)];
+		[wedge release];
+	}];
+
+	free(values);
+}
+
+
+#pragma mark - Compressed Wedges
+
+/// Ascending timestamps one to a thousand apart.
+- (CBHCompressedWedge *)compressedTimestamps
+{
+	CBHCompressedWedge *wedge = [CBHCompressedWedge compressedWedge];
+
+	uint64_t timestamp = 1700000000000;
+	for (NSUInteger i = 0; i < 10000000; ++i)
+	{
+		timestamp += 1 + ((i * 7919) % 1000);
+		[wedge appendUInt64:timestamp];
+	}
+
+	XCTAssertLessThan([wedge compressedLength] * 4, 10000000 * sizeof(uint64_t), @"Compressed less than 4x.");
+	return wedge;
+}
+
+/// Decode throughput in values per second is 10^7 over the measured time.
+- (void)test_compressedWedge_decode_1e7
+{
+	CBHCompressedWedge *wedge = [self compressedTimestamps];
+
+	[self measureBlock:^{
+		CBHSlice *slice = [wedge slice];
+		XCTAssertEqual([slice capacity], (NSUInteger)10000000);
+	}];
+}
+
+- (void)test_compressedWedge_lowerBound_1e7
+{
+	CBHCompressedWedge *wedge = [self compressedTimestamps];
+	const uint64_t last = [wedge uint64AtIndex:9999999];
+
+	[self measureBlock:^{
+		NSUInteger sum = 0;
+		for (NSUInteger i = 0; i < ITERATIONS; ++i) { sum += [wedge lowerBoundOfValue:1700000000000 + ((i * 104729) % (last - 1700000000000))]; }
+		XCTAssertGreaterThan(sum, (NSUInteger)0);
+	}];
+}
+
+
+#pragma mark - Tables
+
+/// A record of twelve fields, of which the scans below read one or two.
+typedef struct CBHTradeRecord_t {
+	uint64_t identifier;
+	uint64_t timestamp;
+	double price;
+	double quantity;
+	uint32_t venue;
+	uint32_t trader;
+	uint32_t instrument;
+	uint32_t flags;
+	double bid;
+	double ask;
+	uint64_t sequence;
+	uint64_t settlement;
+} CBHTradeRecord_t;
+
+#define TABLE_ROWS ((NSUInteger)1000000)
+
+- (CBHWedge *)tradeRecords
+{
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(CBHTradeRecord_t) andCapacity:TABLE_ROWS];
+
+	CBHTradeRecord_t record;
+	memset(&record, 0, sizeof(CBHTradeRecord_t));
+
+	for (NSUInteger i = 0; i < TABLE_ROWS; ++i)
+	{
+		record.identifier = i;
+		record.timestamp = 1700000000000 + i;
+		record.price = (double)((i * 7919) % 10000) / 100.0;
+		record.quantity = (double)(i % 100);
+		record.venue = (uint32_t)(i % 16);
+		[wedge appendValue:&record];
+	}
+
+	return wedge;
+}
+
+- (CBHTable *)tradeTableFromRecords:(CBHWedge *)records
+{
+	const CBHTableColumn columns[] = {
+		CBHTableColumnOf(CBHTradeRecord_t, identifier, CBHPrimitiveTypeUnsigned),
+		CBHTableColumnOf(CBHTradeRecord_t, timestamp, CBHPrimitiveTypeUnsigned),
+		CBHTableColumnOf(CBHTradeRecord_t, price, CBHPrimitiveTypeFloat),
+		CBHTableColumnOf(CBHTradeRecord_t, quantity, CBHPrimitiveTypeFloat),
+		CBHTableColumnOf(CBHTradeRecord_t, venue, CBHPrimitiveTypeUnsigned),
+		CBHTableColumnOf(CBHTradeRecord_t, trader, CBHPrimitiveTypeUnsigned),
+		CBHTableColumnOf(CBHTradeRecord_t, instrument, CBHPrimitiveTypeUnsigned),
+		CBHTableColumnOf(CBHTradeRecord_t, flags, CBHPrimitiveTypeUnsigned),
+		CBHTableColumnOf(CBHTradeRecord_t, bid, CBHPrimitiveTypeFloat),
+		CBHTableColumnOf(CBHTradeRecord_t, ask, CBHPrimitiveTypeFloat),
+		CBHTableColumnOf(CBHTradeRecord_t, sequence, CBHPrimitiveTypeUnsigned),
+		CBHTableColumnOf(CBHTradeRecord_t, settlement, CBHPrimitiveTypeUnsigned),
+	};
+
+	return [CBHTable tableWithColumns:columns count:12 recordsFromWedge:records];
+}
+
+/// The baseline: the same filter and sum reading whole records.
+- (void)test_table_filterAndSum_records_1e6
+{
+	CBHWedge *records = [self tradeRecords];
+
+	[self measureBlock:^{
+		const CBHTradeRecord_t *record = (const CBHTradeRecord_t *)[records bytes];
+		double sum = 0;
+
+		for (NSUInteger i = 0; i < TABLE_ROWS; ++i)
+		{
+			if ( record[i].price >= 25.0 && record[i].price <= 75.0 ) { sum += record[i].quantity; }
+		}
+
+		XCTAssertGreaterThan(sum, 0.0);
+	}];
+}
+
+/// Reads two of the twelve columns, an eighth of the bytes of the baseline.
+- (void)test_table_filterAndSum_columns_1e6
+{
+	CBHTable *table = [self tradeTableFromRecords:[self tradeRecords]];
+	const double low = 25.0;
+	const double high = 75.0;
+
+	[self measureBlock:^{
+		CBHBitSlice *rows = [table rowsOfColumn:2 from:&low to:&high];
+		XCTAssertGreaterThan([table sumOfColumn:3 inRows:rows], 0.0);
+	}];
+}
+
+
+#pragma mark - Hash Maps
+
+/// Scattered keys, so neither table sees them in insertion order.
+#define _hashKey(anIndex) ((uint64_t)(anIndex) * 0x9e3779b97f4a7c15ull >> 20)
+
+- (void)measurePrimitiveHashMapLookupsWithCount:(NSUInteger)count
+{
+	CBHPrimitiveHashMap *map = [CBHPrimitiveHashMap hashMapWithKeySize:sizeof(uint64_t) valueSize:sizeof(uint64_t) andCapacity:count];
+	for (NSUInteger i = 0; i < count; ++i)
+	{
+		const uint64_t key = _hashKey(i);
+		[map setValue:&i atKey:&key];
+	}
+
+	uint64_t *keys = calloc(ITERATIONS, sizeof(uint64_t));
+	uint64_t *values = calloc(ITERATIONS, sizeof(uint64_t));
+	for (NSUInteger i = 0; i < ITERATIONS; ++i) { keys[i] = _hashKey((i * 7919) % count); }
+
+	[self measureBlock:^{
+		XCTAssertEqual([map getValues:values atKeys:keys count:ITERATIONS found:NULL], ITERATIONS);
+	}];
+
+	free(keys);
+	free(values);
+}
+
+- (void)measureDictionaryLookupsWithCount:(NSUInteger)count
+{
+	NSMutableDictionary *dictionary = [NSMutableDictionary dictionaryWithCapacity:count];
+	for (NSUInteger i = 0; i < count; ++i) { [dictionary setObject:@(i) forKey:@(_hashKey(i))]; }
+
+	[self measureBlock:^{
+		NSUInteger found = 0;
+		for (NSUInteger i = 0; i < ITERATIONS; ++i)
+		{
+			if ( [dictionary objectForKey:@(_hashKey((i * 7919) % count))] ) { ++found; }
+		}
+		XCTAssertEqual(found, ITERATIONS);
+	}];
+}
+
+- (void)test_hashMap_lookup_1e3
+{
+	[self measurePrimitiveHashMapLookupsWithCount:1000];
+}
+
+- (void)test_hashMap_lookup_dictionary_1e3
+{
+	[self measureDictionaryLookupsWithCount:1000];
+}
+
+- (void)test_hashMap_lookup_1e5
+{
+	[self measurePrimitiveHashMapLookupsWithCount:100000];
+}
+
+- (void)test_hashMap_lookup_dictionary_1e5
+{
+	[self measureDictionaryLookupsWithCount:100000];
+}
+
+- (void)test_hashMap_lookup_1e7
+{
+	[self measurePrimitiveHashMapLookupsWithCount:10000000];
+}
+
+- (void)test_hashMap_lookup_dictionary_1e7
+{
+	[self measureDictionaryLookupsWithCount:10000000];
+}
+
+
+#pragma mark - Hashing
+
+/// 32 byte identifiers which share a 24 byte prefix, so only the tail tells them apart.
+- (NSArray<CBHSlice *> *)sliceKeysWithCount:(NSUInteger)count
+{
+	NSMutableArray<CBHSlice *> *keys = [NSMutableArray arrayWithCapacity:count];
+	uint64_t identifier[4] = {0x6f72672e636268ull, 0x636f6c6c656374ull, 0x696f6e6b69742eull, 0};
+	for (NSUInteger i = 0; i < count; ++i)
+	{
+		identifier[3] = i;
+		[keys addObject:[CBHSlice sliceWithEntrySize:sizeof(uint64_t) copying:4 entriesFromBytes:identifier]];
+	}
+	return keys;
+}
+
+- (void)test_hash_slice_setLookup_1e5
+{
+	NSArray<CBHSlice *> *keys = [self sliceKeysWithCount:100000];
+	NSSet<CBHSlice *> *set = [NSSet setWithArray:keys];
+
+	[self measureBlock:^{
+		NSUInteger found = 0;
+		for (CBHSlice *key in keys)
+		{
+			if ( [set member:key] ) { ++found; }
+		}
+		XCTAssertEqual(found, [keys count]);
+	}];
+}
+
+- (void)test_hash_wedge_1e6
+{
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:1000000];
+	for (NSUInteger i = 0; i < 1000000; ++i) { [wedge appendUnsignedInteger:i]; }
+
+	/// Built apart, with room to spare, so only the entries can make the hashes match.
+	CBHWedge *other = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:2000000];
+	for (NSUInteger i = 0; i < 1000000; ++i) { [other appendUnsignedInteger:i]; }
+	const NSUInteger expected = [other hash];
+	[other appendUnsignedInteger:0];
+	XCTAssertNotEqual([other hash], expected);
+
+	[self measureBlock:^{
+		for (NSUInteger i = 0; i < 100; ++i) { XCTAssertEqual([wedge hash], expected); }
+	}];
+}
+
+
+#pragma mark - Parallel Operations
+
+#define PARALLEL_COUNT 10000000
+
+- (void)test_parallel_fill_perIndex_1e7
+{
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(double) andCapacity:PARALLEL_COUNT];
+
+	[self measureBlock:^{
+		for (NSUInteger i = 0; i < PARALLEL_COUNT; ++i) { [slice setDouble:1.5 atIndex:i]; }
+	}];
+}
+
+- (void)test_parallel_fill_1e7
+{
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(double) andCapacity:PARALLEL_COUNT];
+	const double value = 1.5;
+
+	[self measureBlock:^{
+		[slice fillWithValue:&value];
+	}];
+}
+
+- (void)test_parallel_transform_1e7
+{
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(double) andCapacity:PARALLEL_COUNT];
+	const double value = 1e300;
+	[slice fillWithValue:&value];
+
+	[self measureBlock:^{
+		[slice transformUsingFunction:CBHSquareRoot context:NULL];
+	}];
+}
+
+- (void)test_parallel_reduce_serial_1e7
+{
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(double) andCapacity:PARALLEL_COUNT];
+	const double value = 1.0;
+	[slice fillWithValue:&value];
+
+	[self measureBlock:^{
+		[slice withUnsafeBytes:^(CBHSliceView view) {
+			double sum = 0.0;
+			CBHSumDoubles(&sum, view.bytes, view.count, NULL);
+			XCTAssertEqual(sum, (double)PARALLEL_COUNT);
+		}];
+	}];
+}
+
+- (void)test_parallel_reduce_1e7
+{
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(double) andCapacity:PARALLEL_COUNT];
+	const double value = 1.0;
+	[slice fillWithValue:&value];
+
+	[self measureBlock:^{
+		const double identity = 0.0;
+		double sum = 0.0;
+		[slice reduceUsingFunction:CBHSumDoubles identity:&identity context:NULL result:&sum];
+		XCTAssertEqual(sum, (double)PARALLEL_COUNT);
+	}];
+}
+
+- (void)test_parallel_enumerate_serial_1e7
+{
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(double) andCapacity:PARALLEL_COUNT];
+	const double value = 1.0;
+	[slice fillWithValue:&value];
+
+	[self measureBlock:^{
+		[slice enumerateValuesUsingBlock:^(const void *entry, NSUInteger index, BOOL *stop) {
+			if ( sqrt(*(const double *)entry) < 0.0 ) { *stop = YES; }
+		}];
+	}];
+}
+
+- (void)test_parallel_enumerate_1e7
+{
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(double) andCapacity:PARALLEL_COUNT];
+	const double value = 1.0;
+	[slice fillWithValue:&value];
+
+	[self measureBlock:^{
+		[slice enumerateValuesWithOptions:NSEnumerationConcurrent usingBlock:^(const void *entry, NSUInteger index, BOOL *stop) {
+			if ( sqrt(*(const double *)entry) < 0.0 ) { *stop = YES; }
+		}];
+	}];
+}
+
+
+#pragma mark - Concurrent Stacks
+
+/// Each thread pushes and pops in pairs, like workers sharing a freelist. Concurrency is capped by the active processors.
+- (void)measureConcurrentStackWithThreads:(NSUInteger)threads
+{
+	CBHConcurrentStack<NSNumber *> *stack = [CBHConcurrentStack concurrentStack];
+
+	[self measureBlock:^{
+		dispatch_apply(threads, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t thread) {
+			@autoreleasepool
+			{
+				for (NSUInteger i = 0; i < ITERATIONS / threads; ++i)
+				{
+					[stack pushObject:@(i)];
+					[stack popObject];
+				}
+			}
+		});
+	}];
+}
+
+- (void)measureLockedStackWithThreads:(NSUInteger)threads
+{
+	CBHStack<NSNumber *> *stack = [CBHStack stack];
+	__block pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+	[self measureBlock:^{
+		dispatch_apply(threads, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t thread) {
+			@autoreleasepool
+			{
+				for (NSUInteger i = 0; i < ITERATIONS / threads; ++i)
+				{
+					pthread_mutex_lock(&lock);
+					[stack pushObject:@(i)];
+					pthread_mutex_unlock(&lock);
+
+					pthread_mutex_lock(&lock);
+					[stack popObject];
+					pthread_mutex_unlock(&lock);
+				}
+			}
+		});
+	}];
+
+	pthread_mutex_destroy(&lock);
+}
+
+- (void)test_stack_locked_1
+{
+	[self measureLockedStackWithThreads:1];
+}
+
+- (void)test_stack_locked_8
+{
+	[self measureLockedStackWithThreads:8];
+}
+
+- (void)test_stack_locked_64
+{
+	[self measureLockedStackWithThreads:64];
+}
+
+- (void)test_concurrentStack_1
+{
+	[self measureConcurrentStackWithThreads:1];
+}
+
+- (void)test_concurrentStack_8
+{
+	[self measureConcurrentStackWithThreads:8];
+}
+
+- (void)test_concurrentStack_64
+{
+	[self measureConcurrentStackWithThreads:64];
+}
+
+- (void)test_concurrentStack_batch_8
+{
+	CBHConcurrentStack<NSNumber *> *stack = [CBHConcurrentStack concurrentStack];
+
+	/// Blocks can't capture C arrays, so the batch lives on the heap.
+	NSNumber **numbers = calloc(64, sizeof(NSNumber *));
+	for (NSUInteger i = 0; i < 64; ++i) { numbers[i] = @(i); }
+
+	[self measureBlock:^{
+		dispatch_apply(8, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t thread) {
+			@autoreleasepool
+			{
+				for (NSUInteger i = 0; i < ITERATIONS / (8 * 64); ++i)
+				{
+					[stack pushObjects:numbers count:64];
+					[stack popAll];
+				}
+			}
+		});
+	}];
+
+	free(numbers);
+}
+
+
+#pragma mark - Concurrent Heaps
+
+#define HEAP_PREFILL 10000
+
+static NSComparator kNumberComparator = ^NSComparisonResult(NSNumber *number1, NSNumber *number2) {
+	return [number1 compare:number2];
+};
+
+/// Each thread alternates inserting a pseudo-random priority and extracting, like a scheduler's workers. Concurrency is capped by the active processors.
+- (void)measureConcurrentHeapWithThreads:(NSUInteger)threads
+{
+	CBHConcurrentHeap<NSNumber *> *heap = [CBHConcurrentHeap concurrentHeapWithComparator:kNumberComparator shardCount:2 * threads];
+	for (NSUInteger i = 0; i < HEAP_PREFILL; ++i) { [heap insertObject:@(_hashKey(i) % HEAP_PREFILL)]; }
+
+	[self measureBlock:^{
+		dispatch_apply(threads, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t thread) {
+			@autoreleasepool
+			{
+				for (NSUInteger i = 0; i < ITERATIONS / threads; ++i)
+				{
+					[heap insertObject:@(_hashKey(thread * ITERATIONS + i) % HEAP_PREFILL)];
+					[heap extractObject];
+				}
+			}
+		});
+	}];
+}
+
+- (void)measureLockedHeapWithThreads:(NSUInteger)threads
+{
+	CBHHeap<NSNumber *> *heap = [CBHHeap heapWithComparator:kNumberComparator andCapacity:HEAP_PREFILL * 2];
+	for (NSUInteger i = 0; i < HEAP_PREFILL; ++i) { [heap insertObject:@(_hashKey(i) % HEAP_PREFILL)]; }
+
+	NSLock *lock = [[[NSLock alloc] init] autorelease];
+
+	[self measureBlock:^{
+		dispatch_apply(threads, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t thread) {
+			@autoreleasepool
+			{
+				for (NSUInteger i = 0; i < ITERATIONS / threads; ++i)
+				{
+					[lock lock];
+					[heap insertObject:@(_hashKey(thread * ITERATIONS + i) % HEAP_PREFILL)];
+					[heap extractObject];
+					[lock unlock];
+				}
+			}
+		});
+	}];
+}
+
+/// Logs how far concurrent extractions stray from the true minimum.
+///
+/// Every extraction takes a ticket, which orders them. Replaying in ticket order, the rank of an extraction is the number of smaller keys not yet extracted.
+- (void)logRankErrorOfConcurrentHeapWithThreads:(NSUInteger)threads
+{
+	const NSUInteger count = ITERATIONS;
+	CBHConcurrentHeap<NSNumber *> *heap = [CBHConcurrentHeap concurrentHeapWithComparator:kNumberComparator shardCount:2 * threads];
+	for (NSUInteger i = 0; i < count; ++i) { [heap insertObject:@(_hashKey(i) % count)]; }
+
+	NSUInteger *keysByTicket = calloc(count, sizeof(NSUInteger));
+	__block NSUInteger nextTicket = 0;
+
+	dispatch_apply(threads, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t thread) {
+		@autoreleasepool
+		{
+			NSNumber *number = nil;
+			while ( (number = [heap extractObject]) )
+			{
+				keysByTicket[__atomic_fetch_add(&nextTicket, 1, __ATOMIC_RELAXED)] = [number unsignedIntegerValue];
+			}
+		}
+	});
+	XCTAssertEqual(nextTicket, count);
+
+	/// A Fenwick tree counts the keys extracted so far below each key. Keys may repeat, so they are counted per value.
+	NSUInteger *tree = calloc(count + 1, sizeof(NSUInteger));
+	NSUInteger *remaining = calloc(count, sizeof(NSUInteger));
+	for (NSUInteger i = 0; i < count; ++i) { ++remaining[keysByTicket[i]]; }
+
+	NSUInteger *smaller = calloc(count + 1, sizeof(NSUInteger));
+	for (NSUInteger key = 0; key < count; ++key) { smaller[key + 1] = smaller[key] + remaining[key]; }
+
+	double totalRank = 0.0;
+	NSUInteger maximumRank = 0;
+	for (NSUInteger i = 0; i < count; ++i)
+	{
+		const NSUInteger key = keysByTicket[i];
+
+		NSUInteger extracted = 0;
+		for (NSUInteger j = key; j > 0; j -= j & -j) { extracted += tree[j]; }
+		for (NSUInteger j = key + 1; j <= count; j += j & -j) { ++tree[j]; }
+
+		const NSUInteger rank = smaller[key] - extracted;
+		totalRank += (double)rank;
+		maximumRank = MAX(maximumRank, rank);
+	}
+
+	NSLog(@"Concurrent heap with %lu threads and %lu shards: mean rank %.2f, maximum rank %lu.", threads, [heap shardCount], totalRank / (double)count, maximumRank);
+
+	free(keysByTicket);
+	free(tree);
+	free(remaining);
+	free(smaller);
+}
+
+- (void)test_heap_locked_1
+{
+	[self measureLockedHeapWithThreads:1];
+}
+
+- (void)test_heap_locked_8
+{
+	[self measureLockedHeapWithThreads:8];
+}
+
+- (void)test_heap_locked_64
+{
+	[self measureLockedHeapWithThreads:64];
+}
+
+- (void)test_concurrentHeap_1
+{
+	[self measureConcurrentHeapWithThreads:1];
+}
+
+- (void)test_concurrentHeap_2
+{
+	[self measureConcurrentHeapWithThreads:2];
+}
+
+- (void)test_concurrentHeap_4
+{
+	[self measureConcurrentHeapWithThreads:4];
+}
+
+- (void)test_concurrentHeap_8
+{
+	[self measureConcurrentHeapWithThreads:8];
+}
+
+- (void)test_concurrentHeap_16
+{
+	[self measureConcurrentHeapWithThreads:16];
+}
+
+- (void)test_concurrentHeap_32
+{
+	[self measureConcurrentHeapWithThreads:32];
+}
+
+- (void)test_concurrentHeap_64
+{
+	[self measureConcurrentHeapWithThreads:64];
+}
+
+- (void)test_concurrentHeap_rankError
+{
+	for (NSUInteger threads = 1; threads <= 64; threads *= 2) { [self logRankErrorOfConcurrentHeapWithThreads:threads]; }
+}
+
+
+#pragma mark - Blocking Queues
+
+/// One producer feeds one consumer through a small queue, so both sides spend time waiting on each other.
+- (void)measureBlockingQueueWithBatch:(NSUInteger)batch
+{
+	[self measureBlock:^{
+		CBHBlockingQueue<NSNumber *> *queue = [CBHBlockingQueue blockingQueueWithCapacity:64];
+
+		dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+			@autoreleasepool
+			{
+				for (NSUInteger i = 0; i < ITERATIONS; ++i) { [queue enqueueObject:@(i)]; }
+				[queue close];
+			}
+		});
+
+		@autoreleasepool
+		{
+			NSMutableArray<NSNumber *> *array = [NSMutableArray arrayWithCapacity:batch];
+			NSNumber *number;
+			while ( (number = [queue dequeueObject]) )
+			{
+				if ( batch <= 1 ) continue;
+
+				[array removeAllObjects];
+				[queue drainTo:array max:batch - 1];
+			}
+		}
+	}];
+}
+
+- (void)test_blockingQueue_single
+{
+	[self measureBlockingQueueWithBatch:1];
+}
+
+- (void)test_blockingQueue_drain_32
+{
+	[self measureBlockingQueueWithBatch:32];
+}
+
+
+#pragma mark - Persistent Collections
+
+/// Every push keeps the previous version, like an undo checkpoint. Copied stacks share storage until written, so each push after a snapshot copies every object.
+- (void)test_stack_snapshots_1e4
+{
+	[self measureBlock:^{
+		NSMutableArray<CBHStack<NSNumber *> *> *snapshots = [NSMutableArray arrayWithCapacity:10000];
+		CBHStack<NSNumber *> *stack = [CBHStack stack];
+
+		for (NSUInteger i = 0; i < 10000; ++i)
+		{
+			[stack pushObject:@(i)];
+
+			CBHStack<NSNumber *> *snapshot = [stack copy];
+			[snapshots addObject:snapshot];
+			[snapshot release];
+		}
+	}];
+}
+
+- (void)test_persistentStack_snapshots_1e4
+{
+	[self measureBlock:^{
+		NSMutableArray<CBHPersistentStack<NSNumber *> *> *snapshots = [NSMutableArray arrayWithCapacity:10000];
+		CBHPersistentStack<NSNumber *> *stack = [CBHPersistentStack persistentStack];
+
+		for (NSUInteger i = 0; i < 10000; ++i)
+		{
+			stack = [stack stackByPushingObject:@(i)];
+			[snapshots addObject:stack];
+		}
+	}];
+}
+
+- (void)test_persistentQueue_enqueueAndDequeue
+{
+	[self measureBlock:^{
+		@autoreleasepool
+		{
+			CBHPersistentQueue<NSNumber *> *queue = [CBHPersistentQueue persistentQueue];
+			for (NSUInteger i = 0; i < ITERATIONS; ++i)
+			{
+				queue = [queue queueByEnqueuingObject:@(i)];
+				if ( i % 2 == 1 ) { queue = [queue queueByDequeuingObject]; }
+			}
+		}
+	}];
+}
+
+
+#pragma mark - Copying
+
+- (void)test_wedge_copy
+{
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:ITERATIONS];
+	for (NSUInteger i = 0; i < ITERATIONS; ++i) { [wedge appendUnsignedInteger:i]; }
+
+	[self measureBlock:^{
+		NSUInteger sum = 0;
+		for (NSUInteger i = 0; i < 1000; ++i)
+		{
+			CBHWedge *copy = [wedge copy];
+			sum += [copy unsignedIntegerAtIndex:i];
+			[copy release];
+		}
+		XCTAssertEqual(sum, (1000 * (1000 - 1)) / 2);
+	}];
+}
+
+- (void)test_wedge_copyThenWrite
+{
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:ITERATIONS];
+	for (NSUInteger i = 0; i < ITERATIONS; ++i) { [wedge appendUnsignedInteger:i]; }
+
+	[self measureBlock:^{
+		for (NSUInteger i = 0; i < 1000; ++i)
+		{
+			CBHWedge *copy = [wedge copy];
+			[copy setUnsignedInteger:0 atIndex:i];
+			[copy release];
+		}
+	}];
+}
+
+- (void)test_Stack_copy
+{
+	CBHStack<NSNumber *> *stack = [CBHStack stackWithCapacity:ITERATIONS];
+	for (NSUInteger i = 0; i < ITERATIONS; ++i) { [stack pushObject:@(i)]; }
+
+	[self measureBlock:^{
+		for (NSUInteger i = 0; i < 1000; ++i)
+		{
+			CBHStack<NSNumber *> *copy = [stack copy];
+			XCTAssertEqualObjects([copy peekAtObject], @(ITERATIONS - 1));
+			[copy release];
+		}
+	}];
+}
+
+- (void)test_Queue_copy
+{
+	CBHQueue<NSNumber *> *queue = [CBHQueue queueWithCapacity:ITERATIONS];
+	for (NSUInteger i = 0; i < ITERATIONS; ++i) { [queue enqueueObject:@(i)]; }
+
+	[self measureBlock:^{
+		for (NSUInteger i = 0; i < 1000; ++i)
+		{
+			CBHQueue<NSNumber *> *copy = [queue copy];
+			XCTAssertEqualObjects([copy peekAtObject], @(0));
+			[copy release];
+		}
+	}];
+}
+
+
+#pragma mark - Files
+
+- (void)measureFile:(void (^)(NSString *path))load
+{
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(NSUInteger) andCapacity:10000000];
+	CBHFillRandom(slice);
+
+	NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+	XCTAssertTrue([slice writeToFile:path options:CBHSliceFileHeader error:NULL]);
+
+	[self measureBlock:^{
+		load(path);
+	}];
+
+	[[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+- (void)test_file_readAndCopy_1e7
+{
+	[self measureFile:^(NSString *path) {
+		NSData *data = [NSData dataWithContentsOfFile:path];
+		const NSUInteger count = ([data length] - sizeof(CBHCollectionHeader)) / sizeof(NSUInteger);
+		CBHSlice *slice = [CBHSlice sliceWithEntrySize:sizeof(NSUInteger) copying:count entriesFromBytes:(const uint8_t *)[data bytes] + sizeof(CBHCollectionHeader)];
+		XCTAssertEqual([slice count], 10000000);
+	}];
+}
+
+- (void)test_file_map_1e7
+{
+	[self measureFile:^(NSString *path) {
+		CBHSlice *slice = [CBHSlice sliceWithContentsOfFile:path entrySize:sizeof(NSUInteger) options:CBHSliceFileHeader | CBHSliceFileAdviseRandom];
+		XCTAssertEqual([slice count], 10000000);
+	}];
+}
+
+- (void)test_file_reader_1e7
+{
+	[self measureFile:^(NSString *path) {
+		CBHSliceReader *reader = [CBHSliceReader readerWithContentsOfFile:path entrySize:sizeof(NSUInteger) windowSize:65536 options:CBHSliceFileHeader];
+
+		__block NSUInteger sum = 0;
+		[reader enumerateSlicesUsingBlock:^(CBHSlice *slice, BOOL *stop) {
+			const NSUInteger *values = [slice bytes];
+			for (NSUInteger i = 0; i < [slice count]; ++i) { sum += values[i]; }
+		}];
+
+		XCTAssertEqual([reader bytesRead], 10000000 * sizeof(NSUInteger));
+		XCTAssertGreaterThan([reader bytesPerSecond], 0.0);
+		XCTAssertNotEqual(sum, 0);
+	}];
+}
+
+
+#pragma mark - Serialization
+
+- (void)test_serialize_wedge_coder
+{
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:ITERATIONS];
+	for (NSUInteger i = 0; i < ITERATIONS; ++i) { [wedge appendUnsignedInteger:i]; }
+
+	[self measureBlock:^{
+		NSMutableData *data = [NSMutableData data];
+		CBHCollectionEncoder *encoder = [[CBHCollectionEncoder alloc] initWithMutableData:data];
+		[wedge encodeWithCollectionEncoder:encoder];
+		[encoder release];
+
+		CBHCollectionDecoder *decoder = [[CBHCollectionDecoder alloc] initWithData:data];
+		CBHWedge *decoded = [[CBHWedge alloc] initWithCollectionDecoder:decoder];
+		XCTAssertEqual([decoded count], ITERATIONS);
+		[decoded release];
+		[decoder release];
+	}];
+}
+
+- (void)test_serialize_array_keyedArchiver
+{
+	NSMutableArray *array = [NSMutableArray arrayWithCapacity:ITERATIONS];
+	for (NSUInteger i = 0; i < ITERATIONS; ++i) { [array addObject:@(i)]; }
+
+	[self measureBlock:^{
+		NSData *data = [NSKeyedArchiver archivedDataWithRootObject:array];
+		NSArray *decoded = [NSKeyedUnarchiver unarchiveObjectWithData:data];
+		XCTAssertEqual([decoded count], ITERATIONS);
+	}];
+}
+
+- (void)test_serialize_queue_coder
+{
+	CBHQueue *queue = [CBHQueue queueWithCapacity:ITERATIONS];
+	for (NSUInteger i = 0; i < ITERATIONS; ++i) { [queue enqueueObject:@(i)]; }
+
+	[self measureBlock:^{
+		NSMutableData *data = [NSMutableData data];
+		CBHCollectionEncoder *encoder = [[CBHCollectionEncoder alloc] initWithMutableData:data];
+		[queue encodeWithCollectionEncoder:encoder codec:[CBHNumberCodec codec]];
+		[encoder release];
+
+		CBHCollectionDecoder *decoder = [[CBHCollectionDecoder alloc] initWithData:data];
+		CBHQueue *decoded = [[CBHQueue alloc] initWithCollectionDecoder:decoder codec:[CBHNumberCodec codec]];
+		XCTAssertEqual([decoded count], ITERATIONS);
+		[decoded release];
+		[decoder release];
+	}];
+}
+
+
+#pragma mark - Sorting
+
+- (void)measureSort:(void (^)(CBHMutableSlice *slice))sort withCount:(NSUInteger)count
+{
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(NSUInteger) andCapacity:count];
+
+	[self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+		CBHFillRandom(slice);
+
+		[self startMeasuring];
+		sort(slice);
+		[self stopMeasuring];
+	}];
+}
+
+- (void)test_sort_qsort_1e4
+{
+	[self measureSort:^(CBHMutableSlice *slice) {
+		qsort((void *)[slice bytes], [slice capacity], sizeof(NSUInteger), CBHQSortCompareUnsigned);
+	} withCount:10000];
+}
+
+- (void)test_sort_radix_1e4
+{
+	[self measureSort:^(CBHMutableSlice *slice) {
+		[slice sortAsType:CBHPrimitiveTypeUnsigned];
+	} withCount:10000];
+}
+
+- (void)test_sort_introsort_1e4
+{
+	[self measureSort:^(CBHMutableSlice *slice) {
+		[slice sortUsingFunction:CBHCompareUnsigned context:NULL];
+	} withCount:10000];
+}
+
+- (void)test_sort_qsort_1e6
+{
+	[self measureSort:^(CBHMutableSlice *slice) {
+		qsort((void *)[slice bytes], [slice capacity], sizeof(NSUInteger), CBHQSortCompareUnsigned);
+	} withCount:1000000];
+}
+
+- (void)test_sort_radix_1e6
+{
+	[self measureSort:^(CBHMutableSlice *slice) {
+		[slice sortAsType:CBHPrimitiveTypeUnsigned];
+	} withCount:1000000];
+}
+
+- (void)test_sort_introsort_1e6
+{
+	[self measureSort:^(CBHMutableSlice *slice) {
+		[slice sortUsingFunction:CBHCompareUnsigned context:NULL];
+	} withCount:1000000];
+}
+
+- (void)test_sort_qsort_1e8
+{
+	[self measureSort:^(CBHMutableSlice *slice) {
+		qsort((void *)[slice bytes], [slice capacity], sizeof(NSUInteger), CBHQSortCompareUnsigned);
+	} withCount:100000000];
+}
+
+- (void)test_sort_radix_1e8
+{
+	[self measureSort:^(CBHMutableSlice *slice) {
+		[slice sortAsType:CBHPrimitiveTypeUnsigned];
+	} withCount:100000000];
+}
+
+- (void)test_sort_introsort_1e8
+{
+	[self measureSort:^(CBHMutableSlice *slice) {
+		[slice sortUsingFunction:CBHCompareUnsigned context:NULL];
+	} withCount:100000000];
+}
+
 @end
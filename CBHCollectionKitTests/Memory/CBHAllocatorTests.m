@@ -0,0 +1,219 @@
+//  CBHAllocatorTests.m
+//  CBHCollectionKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import XCTest;
+
+@import CBHCollectionKit.CBHAllocator;
+@import CBHCollectionKit.CBHArenaAllocator;
+@import CBHCollectionKit.CBHPoolAllocator;
+@import CBHCollectionKit.CBHThreadCacheAllocator;
+@import CBHCollectionKit.CBHWedge;
+@import CBHCollectionKit.CBHMutableSlice;
+@import CBHCollectionKit.CBHStack;
+@import CBHCollectionKit.CBHQueue;
+@import CBHCollectionKit.CBHHeap;
+
+
+#pragma mark - Counting Allocator
+
+typedef struct CBHCountingAllocator_t
+{
+	NSUInteger _allocs;
+	NSUInteger _reallocs;
+	NSUInteger _frees;
+} CBHCountingAllocator_t;
+
+static void *CBHCounting_alloc(size_t length, size_t alignment, void *context)
+{
+	++((CBHCountingAllocator_t *)context)->_allocs;
+	return CBHSystemAllocator.alloc(length, alignment, CBHSystemAllocator.context);
+}
+
+static void *CBHCounting_realloc(void *data, size_t oldLength, size_t newLength, size_t alignment, void *context)
+{
+	++((CBHCountingAllocator_t *)context)->_reallocs;
+	return CBHSystemAllocator.realloc(data, oldLength, newLength, alignment, CBHSystemAllocator.context);
+}
+
+static void CBHCounting_free(void *data, size_t length, size_t alignment, void *context)
+{
+	++((CBHCountingAllocator_t *)context)->_frees;
+	CBHSystemAllocator.free(data, length, alignment, CBHSystemAllocator.context);
+}
+
+
+@interface CBHAllocatorTests : XCTestCase
+@end
+
+
+@implementation CBHAllocatorTests
+
+#pragma mark - Routing
+
+- (void)test_options_routeThroughAllocator
+{
+	CBHCountingAllocator_t counts = {0, 0, 0};
+	CBHAllocator allocator = {CBHCounting_alloc, CBHCounting_realloc, CBHCounting_free, &counts};
+
+	@autoreleasepool
+	{
+		CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:4 options:CBHAllocationOptionsWithAllocator(&allocator)];
+		for (NSUInteger i = 0; i < 1000; ++i) { [wedge appendUnsignedInteger:i]; }
+
+		XCTAssertEqual([wedge allocationOptions].allocator, &allocator, @"Options not kept.");
+		XCTAssertEqual([wedge unsignedIntegerAtIndex:999], (NSUInteger)999, @"Incorrect value.");
+		XCTAssertEqual(counts._allocs, (NSUInteger)1, @"Initial allocation not routed.");
+		XCTAssertGreaterThan(counts._reallocs, (NSUInteger)0, @"Growth not routed.");
+	}
+
+	XCTAssertEqual(counts._frees, counts._allocs, @"Free not routed.");
+}
+
+- (void)test_copyOnWrite_freesThroughAllocator
+{
+	CBHCountingAllocator_t counts = {0, 0, 0};
+	CBHAllocator allocator = {CBHCounting_alloc, CBHCounting_realloc, CBHCounting_free, &counts};
+
+	@autoreleasepool
+	{
+		CBHMutableSlice *slice = [[[CBHMutableSlice alloc] initWithEntrySize:sizeof(NSUInteger) andCapacity:16 shouldClear:YES options:CBHAllocationOptionsWithAllocator(&allocator)] autorelease];
+		[slice setUnsignedInteger:7 atIndex:0];
+
+		CBHSlice *copy = [[slice copy] autorelease];
+		XCTAssertEqual(counts._allocs, (NSUInteger)1, @"Copy should share storage.");
+
+		/// Writing detaches the mutable slice into its own buffer.
+		[slice setUnsignedInteger:8 atIndex:0];
+		XCTAssertEqual(counts._allocs, (NSUInteger)2, @"Detach not routed.");
+		XCTAssertEqual([copy unsignedIntegerAtIndex:0], (NSUInteger)7, @"Copy changed on write.");
+		XCTAssertEqual([slice unsignedIntegerAtIndex:0], (NSUInteger)8, @"Incorrect value.");
+	}
+
+	XCTAssertEqual(counts._frees, (NSUInteger)2, @"Shared storage not freed through allocator.");
+}
+
+
+#pragma mark - Arena
+
+- (void)test_arena_wedge
+{
+	CBHArenaAllocator *arena = [CBHArenaAllocator arenaWithBlockSize:4096];
+	XCTAssertEqual([arena bytesAllocated], (size_t)0, @"Fresh arena not empty.");
+
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:8 options:[arena allocationOptions]];
+	for (NSUInteger i = 0; i < 10000; ++i) { [wedge appendUnsignedInteger:i]; }
+	for (NSUInteger i = 0; i < 10000; ++i) { XCTAssertEqual([wedge unsignedIntegerAtIndex:i], i, @"Incorrect value."); }
+
+	XCTAssertGreaterThan([arena bytesAllocated], (size_t)0, @"Allocations not counted.");
+	XCTAssertGreaterThanOrEqual([arena bytesReserved], [arena bytesAllocated], @"Reserved less than allocated.");
+}
+
+- (void)test_arena_reset
+{
+	CBHArenaAllocator *arena = [CBHArenaAllocator arenaWithBlockSize:4096];
+	const CBHAllocator *allocator = [arena allocator];
+
+	void *first = allocator->alloc(64, 16, allocator->context);
+	void *second = allocator->alloc(64, 16, allocator->context);
+	XCTAssertNotEqual(first, second, @"Allocations overlap.");
+	XCTAssertEqual((uintptr_t)first % 16, (uintptr_t)0, @"Misaligned.");
+
+	[arena reset];
+	XCTAssertEqual([arena bytesAllocated], (size_t)0, @"Reset did not take memory back.");
+	XCTAssertEqual(allocator->alloc(64, 16, allocator->context), first, @"Reset did not reuse block.");
+}
+
+- (void)test_arena_badBlockSize
+{
+	XCTAssertThrows([[[CBHArenaAllocator alloc] initWithBlockSize:0] release], @"Zero block size accepted.");
+}
+
+
+#pragma mark - Pool
+
+- (void)test_pool_reuse
+{
+	CBHPoolAllocator *pool = [CBHPoolAllocator poolWithMaximumSize:1024];
+	const CBHAllocator *allocator = [pool allocator];
+
+	void *block = allocator->alloc(100, 8, allocator->context);
+	allocator->free(block, 100, 8, allocator->context);
+	XCTAssertEqual(allocator->alloc(120, 8, allocator->context), block, @"Freed block not reused.");
+
+	CBHStack *stack = [CBHStack stackWithCapacity:4 options:[pool allocationOptions]];
+	for (NSUInteger i = 0; i < 1000; ++i) { [stack pushObject:@(i)]; }
+	XCTAssertEqual([stack count], (NSUInteger)1000, @"Incorrect count.");
+	XCTAssertEqualObjects([stack popObject], @(999), @"Incorrect object.");
+}
+
+
+- (void)test_pool_removeAllShared
+{
+	CBHPoolAllocator *pool = [CBHPoolAllocator poolWithMaximumSize:1024];
+
+	CBHStack *stack = [CBHStack stackWithCapacity:8 options:[pool allocationOptions]];
+	for (NSUInteger i = 0; i < 8; ++i) { [stack pushObject:@(i)]; }
+
+	/// Removing everything gives the shared storage up, so the stack needs a fresh buffer rather than a resized one.
+	CBHStack *copy = [[stack copy] autorelease];
+	[stack removeAllObjects];
+	XCTAssertEqual([stack count], (NSUInteger)0, @"Incorrect count.");
+	XCTAssertEqual([copy count], (NSUInteger)8, @"Copy changed by removal.");
+
+	[stack pushObject:@(8)];
+	XCTAssertEqualObjects([stack peekAtObject], @(8), @"Incorrect object.");
+	XCTAssertEqualObjects([copy peekAtObject], @(7), @"Incorrect object in copy.");
+}
+
+
+#pragma mark - Thread Cache
+
+- (void)test_threadCache_objectCollections
+{
+	CBHThreadCacheAllocator *cache = [[[CBHThreadCacheAllocator alloc] init] autorelease];
+	CBHAllocationOptions options = [cache allocationOptions];
+
+	dispatch_apply(8, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t iteration) {
+		@autoreleasepool
+		{
+			for (NSUInteger round = 0; round < 100; ++round)
+			{
+				CBHQueue *queue = [CBHQueue queueWithCapacity:2 options:options];
+				CBHHeap *heap = [CBHHeap heapWithComparator:^NSComparisonResult(NSNumber *a, NSNumber *b) { return [a compare:b]; } andCapacity:2 options:options];
+
+				for (NSUInteger i = 0; i < 64; ++i)
+				{
+					[queue enqueueObject:@(i + iteration)];
+					[heap insertObject:@(64 - i)];
+				}
+
+				XCTAssertEqualObjects([queue dequeueObject], @(iteration), @"Incorrect object.");
+				XCTAssertEqualObjects([heap extractObject], @(1), @"Incorrect object.");
+			}
+		}
+	});
+
+	[cache flush];
+}
+
+- (void)test_threadCache_badDepth
+{
+	XCTAssertThrows([[[CBHThreadCacheAllocator alloc] initWithAllocator:&CBHSystemAllocator maximumSize:1024 depth:0] release], @"Zero depth accepted.");
+}
+
+@end
@@ -0,0 +1,254 @@
+//  CBHCollectionPoolTests.m
+//  CBHCollectionKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import XCTest;
+
+#include <unistd.h>
+
+@import CBHCollectionKit.CBHCollectionPool;
+@import CBHCollectionKit.CBHAllocator;
+@import CBHCollectionKit.CBHWedge;
+@import CBHCollectionKit.CBHStack;
+@import CBHCollectionKit.CBHQueue;
+
+
+@interface CBHCollectionPoolTests : XCTestCase
+@end
+
+
+@implementation CBHCollectionPoolTests
+
+#pragma mark - Reuse
+
+- (void)test_wedge_reused
+{
+	CBHCollectionPool *pool = [CBHCollectionPool pool];
+
+	CBHWedge *wedge = [pool wedgeWithEntrySize:sizeof(NSUInteger)];
+	for (NSUInteger i = 0; i < 1000; ++i) { [wedge appendUnsignedInteger:i]; }
+	const NSUInteger capacity = [wedge capacity];
+
+	[wedge retain];
+	[pool recycleWedge:wedge];
+
+	XCTAssertEqual([wedge count], (NSUInteger)0, @"Recycled wedge not emptied.");
+	XCTAssertGreaterThan([pool retainedBytes], (size_t)0, @"Retained bytes not counted.");
+
+	CBHWedge *reused = [pool wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:16];
+	XCTAssertEqual(reused, wedge, @"Recycled wedge not reused.");
+	XCTAssertEqual([reused capacity], capacity, @"Capacity not kept.");
+	XCTAssertEqual([pool retainedBytes], (size_t)0, @"Retained bytes not released.");
+
+	[wedge release];
+
+	CBHCollectionPoolStatistics statistics = [pool statistics];
+	XCTAssertEqual(statistics.hits, (NSUInteger)1, @"Incorrect hits.");
+	XCTAssertEqual(statistics.misses, (NSUInteger)1, @"Incorrect misses.");
+	XCTAssertEqual(statistics.recycled, (NSUInteger)1, @"Incorrect recycled.");
+	XCTAssertEqual(statistics.discarded, (NSUInteger)0, @"Incorrect discarded.");
+}
+
+- (void)test_wedge_matchesEntrySize
+{
+	CBHCollectionPool *pool = [CBHCollectionPool pool];
+
+	CBHWedge *wedge = [pool wedgeWithEntrySize:sizeof(uint32_t)];
+	[pool recycleWedge:wedge];
+
+	CBHWedge *other = [pool wedgeWithEntrySize:sizeof(uint64_t)];
+	XCTAssertNotEqual(other, wedge, @"Wedge of another entry size reused.");
+	XCTAssertEqual([other entrySize], sizeof(uint64_t), @"Incorrect entry size.");
+
+	XCTAssertEqual([pool wedgeWithEntrySize:sizeof(uint32_t)], wedge, @"Matching wedge not reused.");
+	XCTAssertEqual([pool statistics].misses, (NSUInteger)2, @"Incorrect misses.");
+}
+
+- (void)test_stack_releasesObjects
+{
+	CBHCollectionPool *pool = [CBHCollectionPool pool];
+	NSObject *object = [[NSObject alloc] init];
+
+	CBHStack *stack = [pool stack];
+	[stack pushObject:object];
+	XCTAssertEqual([object retainCount], (NSUInteger)2, @"Object not retained.");
+
+	[pool recycleStack:stack];
+	XCTAssertEqual([object retainCount], (NSUInteger)1, @"Object not released.");
+
+	CBHStack *reused = [pool stackWithCapacity:32];
+	XCTAssertEqual(reused, stack, @"Recycled stack not reused.");
+	XCTAssertEqual([reused count], (NSUInteger)0, @"Reused stack not empty.");
+	XCTAssertGreaterThanOrEqual([reused capacity], (NSUInteger)32, @"Capacity not grown.");
+
+	[object release];
+}
+
+- (void)test_queue_reused
+{
+	CBHCollectionPool *pool = [CBHCollectionPool pool];
+
+	CBHQueue *queue = [pool queue];
+	for (NSUInteger i = 0; i < 100; ++i) { [queue enqueueObject:@(i)]; }
+	[queue dequeueObject];
+
+	[pool recycleQueue:queue];
+
+	CBHQueue *reused = [pool queue];
+	XCTAssertEqual(reused, queue, @"Recycled queue not reused.");
+	XCTAssertEqual([reused count], (NSUInteger)0, @"Reused queue not empty.");
+
+	[reused enqueueObject:@"a"];
+	XCTAssertEqualObjects([reused dequeueObject], @"a", @"Incorrect object.");
+}
+
+
+#pragma mark - Discarding
+
+- (void)test_discard_unownedBuffers
+{
+	CBHCollectionPool *pool = [CBHCollectionPool pool];
+	CBHAllocator allocator = CBHSystemAllocator;
+
+	NSMutableData *data = [NSMutableData dataWithLength:sizeof(NSUInteger) * 4];
+	[pool recycleWedge:[CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) adoptingData:data]];
+	[pool recycleWedge:[CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:4 options:CBHAllocationOptionsWithAllocator(&allocator)]];
+
+	CBHStack *stack = [CBHStack stack];
+	CBHStack *copy = [[stack copy] autorelease];
+	[pool recycleStack:stack];
+
+	CBHCollectionPoolStatistics statistics = [pool statistics];
+	XCTAssertEqual(statistics.recycled, (NSUInteger)0, @"Unowned buffer recycled.");
+	XCTAssertEqual(statistics.discarded, (NSUInteger)3, @"Incorrect discarded.");
+	XCTAssertEqual([pool retainedBytes], (size_t)0, @"Retained bytes counted.");
+	XCTAssertNotNil(copy, @"Copy missing.");
+}
+
+- (void)test_discard_overLimit
+{
+	CBHCollectionPool *pool = [CBHCollectionPool poolWithMaximumRetainedBytes:4096];
+
+	CBHWedge *small = [pool wedgeWithEntrySize:1 andCapacity:128];
+	CBHWedge *large = [pool wedgeWithEntrySize:1 andCapacity:8192];
+
+	[pool recycleWedge:small];
+	[pool recycleWedge:large];
+
+	XCTAssertLessThanOrEqual([pool retainedBytes], (size_t)4096, @"Limit exceeded.");
+	XCTAssertEqual([pool statistics].recycled, (NSUInteger)1, @"Incorrect recycled.");
+	XCTAssertEqual([pool statistics].discarded, (NSUInteger)1, @"Incorrect discarded.");
+}
+
+- (void)test_drain
+{
+	CBHCollectionPool *pool = [[CBHCollectionPool alloc] initWithMaximumRetainedBytes:SIZE_MAX depth:1];
+
+	CBHStack *first = [pool stack];
+	CBHStack *second = [pool stack];
+	[pool recycleStack:first];
+	[pool recycleStack:second];
+	XCTAssertGreaterThan([pool retainedBytes], (size_t)0, @"Retained bytes not counted.");
+
+	[pool drain];
+	XCTAssertEqual([pool retainedBytes], (size_t)0, @"Pool not drained.");
+
+	[pool release];
+}
+
+- (void)test_init_badDepth
+{
+	XCTAssertThrows([[[CBHCollectionPool alloc] initWithMaximumRetainedBytes:1024 depth:0] release], @"Zero depth accepted.");
+}
+
+
+#pragma mark - Threads
+
+- (void)test_threads
+{
+	CBHCollectionPool *pool = [[CBHCollectionPool alloc] initWithMaximumRetainedBytes:SIZE_MAX depth:2];
+
+	dispatch_apply(8, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t iteration) {
+		for (NSUInteger request = 0; request < 1000; ++request)
+		{
+			@autoreleasepool
+			{
+				CBHWedge *wedge = [pool wedgeWithEntrySize:sizeof(NSUInteger)];
+				CBHQueue *queue = [pool queue];
+
+				for (NSUInteger i = 0; i < 16; ++i)
+				{
+					[wedge appendUnsignedInteger:i + iteration];
+					[queue enqueueObject:@(i)];
+				}
+
+				XCTAssertEqual([wedge count], (NSUInteger)16, @"Collection shared between threads.");
+				XCTAssertEqual([queue count], (NSUInteger)16, @"Collection shared between threads.");
+
+				[pool recycleWedge:wedge];
+				[pool recycleQueue:queue];
+			}
+		}
+	});
+
+	CBHCollectionPoolStatistics statistics = [pool statistics];
+	XCTAssertEqual(statistics.hits + statistics.misses, (NSUInteger)16000, @"Requests miscounted.");
+	XCTAssertEqual(statistics.recycled, (NSUInteger)16000, @"Recycling miscounted.");
+	XCTAssertGreaterThan(statistics.hits, statistics.misses, @"Collections not reused.");
+
+	[pool release];
+}
+
+- (void)test_threads_outliveThePool
+{
+	/// Not retained by the block, so the pool is deallocated while the thread runs.
+	__block CBHCollectionPool *pool = [[CBHCollectionPool alloc] init];
+	__block CBHStack *stack = nil;
+
+	dispatch_semaphore_t didRecycle = dispatch_semaphore_create(0);
+	dispatch_semaphore_t didReleasePool = dispatch_semaphore_create(0);
+
+	NSThread *thread = [[NSThread alloc] initWithBlock:^{
+		@autoreleasepool
+		{
+			stack = [[pool stack] retain];
+			[pool recycleStack:stack];
+		}
+
+		dispatch_semaphore_signal(didRecycle);
+		dispatch_semaphore_wait(didReleasePool, DISPATCH_TIME_FOREVER);
+	}];
+	[thread start];
+
+	dispatch_semaphore_wait(didRecycle, DISPATCH_TIME_FOREVER);
+	[pool release];
+
+	/// Another thread's cache is left to it while it runs.
+	XCTAssertEqual([stack retainCount], (NSUInteger)2, @"Cache of a running thread touched.");
+	dispatch_semaphore_signal(didReleasePool);
+
+	/// And released as it exits.
+	for (NSUInteger i = 0; i < 500 && [stack retainCount] > 1; ++i) { usleep(10000); }
+	XCTAssertEqual([stack retainCount], (NSUInteger)1, @"Cache not released as its thread exited.");
+
+	[stack release];
+	[thread release];
+	dispatch_release(didRecycle);
+	dispatch_release(didReleasePool);
+}
+
+@end
@@ -0,0 +1,247 @@
+//  CBHBlockingQueueTests.m
+//  CBHCollectionKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+@import XCTest;
+
+@import CBHCollectionKit.CBHBlockingQueue;
+
+
+#define CBHAssertBlockingQueueState(aQueue, aCount, aCapacity)\
+{\
+	XCTAssertNotNil(aQueue, @"Queue was nil.");\
+	XCTAssertEqual([aQueue count], (aCount), @"Incorrect count.");\
+	XCTAssertEqual([aQueue capacity], (aCapacity), @"Incorrect capacity.");\
+	XCTAssertEqual([aQueue isEmpty], (aCount <= 0), @"Incorrect empty state.");\
+}
+
+
+@interface CBHBlockingQueueTests : XCTestCase
+@end
+
+
+@implementation CBHBlockingQueueTests
+
+- (void)test_initialization
+{
+	CBHBlockingQueue<NSNumber *> *queue = [CBHBlockingQueue blockingQueueWithCapacity:4];
+	CBHAssertBlockingQueueState(queue, 0, 4);
+	XCTAssertFalse([queue isClosed], @"Is closed when created.");
+
+	XCTAssertNil([queue dequeueObjectWithTimeout:0.0], @"Returned non-nil value when empty.");
+
+	XCTAssertThrows([[CBHBlockingQueue alloc] initWithCapacity:0], @"Accepts a capacity of zero.");
+}
+
+- (void)test_enqueueAndDequeue
+{
+	CBHBlockingQueue<NSNumber *> *queue = [CBHBlockingQueue blockingQueueWithCapacity:100];
+	for (NSUInteger i = 0; i < 100; ++i)
+	{
+		XCTAssertTrue([queue enqueueObject:@(i)], @"Fails to enqueue %lu.", i);
+	}
+	CBHAssertBlockingQueueState(queue, 100, 100);
+
+	for (NSUInteger i = 0; i < 100; ++i)
+	{
+		XCTAssertEqualObjects([queue dequeueObject], @(i), @"Entry is incorrect at index %lu.", i);
+	}
+	CBHAssertBlockingQueueState(queue, 0, 100);
+}
+
+- (void)test_capacity
+{
+	CBHBlockingQueue<NSNumber *> *queue = [CBHBlockingQueue blockingQueueWithCapacity:2];
+	XCTAssertTrue([queue enqueueObject:@0 timeout:0.0], @"Fails to enqueue with space.");
+	XCTAssertTrue([queue enqueueObject:@1 timeout:0.0], @"Fails to enqueue with space.");
+	CBHAssertBlockingQueueState(queue, 2, 2);
+
+	/// A full queue refuses objects once the time runs out.
+	NSDate *start = [NSDate date];
+	XCTAssertFalse([queue enqueueObject:@2 timeout:0.05], @"Exceeds capacity.");
+	XCTAssertGreaterThanOrEqual(-[start timeIntervalSinceNow], 0.04, @"Gives up before the timeout.");
+	CBHAssertBlockingQueueState(queue, 2, 2);
+
+	/// Space freed by a consumer wakes a waiting producer.
+	dispatch_after(dispatch_time(DISPATCH_TIME_NOW, 50 * NSEC_PER_MSEC), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+		[queue dequeueObject];
+	});
+	XCTAssertTrue([queue enqueueObject:@2 timeout:10.0], @"Fails to wake when space is freed.");
+
+	XCTAssertEqualObjects([queue dequeueObject], @1, @"Incorrect head.");
+	XCTAssertEqualObjects([queue dequeueObject], @2, @"Incorrect head.");
+	CBHAssertBlockingQueueState(queue, 0, 2);
+}
+
+- (void)test_timeout
+{
+	CBHBlockingQueue<NSNumber *> *queue = [CBHBlockingQueue blockingQueueWithCapacity:2];
+
+	NSDate *start = [NSDate date];
+	XCTAssertNil([queue dequeueObjectWithTimeout:0.05], @"Returned non-nil value when empty.");
+	XCTAssertGreaterThanOrEqual(-[start timeIntervalSinceNow], 0.04, @"Gives up before the timeout.");
+
+	/// An object from a producer wakes a waiting consumer.
+	dispatch_after(dispatch_time(DISPATCH_TIME_NOW, 50 * NSEC_PER_MSEC), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+		[queue enqueueObject:@7];
+	});
+	XCTAssertEqualObjects([queue dequeueObjectWithTimeout:10.0], @7, @"Fails to wake when an object is added.");
+}
+
+- (void)test_drain
+{
+	CBHBlockingQueue<NSNumber *> *queue = [CBHBlockingQueue blockingQueueWithCapacity:8];
+	for (NSUInteger i = 0; i < 5; ++i) { [queue enqueueObject:@(i)]; }
+
+	NSMutableArray<NSNumber *> *array = [NSMutableArray arrayWithObject:@-1];
+	XCTAssertEqual([queue drainTo:array max:3], 3, @"Drains the wrong number of objects.");
+	XCTAssertEqualObjects(array, (@[@-1, @0, @1, @2]), @"Appends the wrong objects.");
+	CBHAssertBlockingQueueState(queue, 2, 8);
+
+	XCTAssertEqual([queue drainTo:array max:10], 2, @"Drains the wrong number of objects.");
+	XCTAssertEqualObjects(array, (@[@-1, @0, @1, @2, @3, @4]), @"Appends the wrong objects.");
+	CBHAssertBlockingQueueState(queue, 0, 8);
+
+	/// Draining an empty queue doesn't wait.
+	XCTAssertEqual([queue drainTo:array max:10], 0, @"Drains objects when empty.");
+}
+
+- (void)test_close
+{
+	CBHBlockingQueue<NSNumber *> *queue = [CBHBlockingQueue blockingQueueWithCapacity:4];
+	[queue enqueueObject:@0];
+	[queue enqueueObject:@1];
+
+	[queue close];
+	XCTAssertTrue([queue isClosed], @"Fails to close.");
+	XCTAssertFalse([queue enqueueObject:@2], @"Accepts objects when closed.");
+
+	/// Objects already queued still come out, then nil without waiting.
+	XCTAssertEqualObjects([queue dequeueObject], @0, @"Incorrect head.");
+	XCTAssertEqualObjects([queue dequeueObject], @1, @"Incorrect head.");
+	XCTAssertNil([queue dequeueObject], @"Waits or returns objects when closed and empty.");
+	CBHAssertBlockingQueueState(queue, 0, 4);
+}
+
+- (void)test_closeWakesWaiters
+{
+	CBHBlockingQueue<NSNumber *> *queue = [CBHBlockingQueue blockingQueueWithCapacity:1];
+
+	dispatch_after(dispatch_time(DISPATCH_TIME_NOW, 50 * NSEC_PER_MSEC), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+		[queue close];
+	});
+	XCTAssertNil([queue dequeueObject], @"Fails to wake a consumer when closed.");
+
+	queue = [CBHBlockingQueue blockingQueueWithCapacity:1];
+	[queue enqueueObject:@0];
+
+	dispatch_after(dispatch_time(DISPATCH_TIME_NOW, 50 * NSEC_PER_MSEC), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+		[queue close];
+	});
+	XCTAssertFalse([queue enqueueObject:@1], @"Fails to wake a producer when closed.");
+}
+
+- (void)test_shutdown
+{
+	CBHBlockingQueue<NSNumber *> *queue = [CBHBlockingQueue blockingQueueWithCapacity:4];
+	for (NSUInteger i = 0; i < 3; ++i) { [queue enqueueObject:@(i)]; }
+	[queue dequeueObject];
+
+	XCTAssertEqualObjects([queue shutdown], (@[@1, @2]), @"Returns the wrong remainder.");
+	XCTAssertTrue([queue isClosed], @"Fails to close.");
+	CBHAssertBlockingQueueState(queue, 0, 4);
+
+	XCTAssertEqualObjects([queue shutdown], @[], @"Returns objects when empty.");
+}
+
+- (void)test_retention
+{
+	NSObject *object = [[NSObject alloc] init];
+	const NSUInteger retainCount = [object retainCount];
+
+	CBHBlockingQueue<NSObject *> *queue = [[CBHBlockingQueue alloc] initWithCapacity:4];
+	[queue enqueueObject:object];
+	[queue enqueueObject:object];
+	XCTAssertEqual([object retainCount], retainCount + 2, @"Fails to retain enqueued objects.");
+
+	@autoreleasepool
+	{
+		XCTAssertEqual([queue dequeueObject], object, @"Incorrect head.");
+	}
+	XCTAssertEqual([object retainCount], retainCount + 1, @"Fails to release dequeued objects.");
+
+	[queue release];
+	XCTAssertEqual([object retainCount], retainCount, @"Fails to release objects when freed.");
+
+	[object release];
+}
+
+- (void)test_concurrent
+{
+	const NSUInteger producers = 4;
+	const NSUInteger consumers = 4;
+	const NSUInteger perProducer = 10000;
+
+	/// A small capacity keeps both sides waiting on each other.
+	CBHBlockingQueue<NSNumber *> *queue = [CBHBlockingQueue blockingQueueWithCapacity:8];
+	uint8_t *dequeues = calloc(producers * perProducer, sizeof(uint8_t));
+	dispatch_group_t group = dispatch_group_create();
+	dispatch_queue_t global = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+
+	for (NSUInteger consumer = 0; consumer < consumers; ++consumer)
+	{
+		dispatch_group_async(group, global, ^{
+			@autoreleasepool
+			{
+				NSMutableArray<NSNumber *> *batch = [NSMutableArray array];
+				NSNumber *number;
+				while ( (number = [queue dequeueObject]) )
+				{
+					__atomic_fetch_add(&dequeues[[number unsignedIntegerValue]], 1, __ATOMIC_RELAXED);
+
+					/// Alternate single dequeues with batches.
+					[batch removeAllObjects];
+					[queue drainTo:batch max:4];
+					for (NSNumber *entry in batch) { __atomic_fetch_add(&dequeues[[entry unsignedIntegerValue]], 1, __ATOMIC_RELAXED); }
+				}
+			}
+		});
+	}
+
+	dispatch_apply(producers, global, ^(size_t producer) {
+		@autoreleasepool
+		{
+			for (NSUInteger i = 0; i < perProducer; ++i) { [queue enqueueObject:@(producer * perProducer + i)]; }
+		}
+	});
+
+	[queue close];
+	XCTAssertEqual(dispatch_group_wait(group, dispatch_time(DISPATCH_TIME_NOW, 30 * NSEC_PER_SEC)), 0, @"Consumers fail to finish.");
+	CBHAssertBlockingQueueState(queue, 0, 8);
+
+	/// Every object comes out exactly once.
+	for (NSUInteger i = 0; i < producers * perProducer; ++i)
+	{
+		XCTAssertEqual(dequeues[i], 1, @"Fails to dequeue %lu exactly once.", i);
+	}
+
+	dispatch_release(group);
+	free(dequeues);
+}
+
+@end
@@ -0,0 +1,226 @@
+//  CBHConcurrentHeapTests.m
+//  CBHCollectionKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import XCTest;
+
+@import CBHCollectionKit.CBHConcurrentHeap;
+
+
+#define CBHAssertConcurrentHeapState(aHeap, aShardCount, aCount)\
+{\
+	XCTAssertNotNil(aHeap, @"Heap was nil.");\
+	XCTAssertEqual([aHeap shardCount], (aShardCount), @"Incorrect shard count.");\
+	XCTAssertEqual([aHeap count], (aCount), @"Incorrect count.");\
+	XCTAssertEqual([aHeap isEmpty], (aCount <= 0), @"Incorrect empty state.");\
+}
+
+
+@interface CBHConcurrentHeapTests : XCTestCase
+@end
+
+
+@implementation CBHConcurrentHeapTests
+
+static NSComparator kComparator = ^NSComparisonResult(NSNumber *number1, NSNumber *number2) {
+	return [number1 compare:number2];
+};
+
+/// Shuffles 0 to `count - 1` with a fixed seed.
+static NSArray<NSNumber *> *CBHShuffledNumbers(NSUInteger count)
+{
+	NSMutableArray<NSNumber *> *numbers = [NSMutableArray arrayWithCapacity:count];
+	for (NSUInteger i = 0; i < count; ++i) { [numbers addObject:@(i)]; }
+
+	uint64_t state = 0x9e3779b97f4a7c15ull;
+	for (NSUInteger i = count - 1; i > 0; --i)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		[numbers exchangeObjectAtIndex:i withObjectAtIndex:(NSUInteger)(state % (i + 1))];
+	}
+
+	return numbers;
+}
+
+- (void)test_initialization
+{
+	CBHConcurrentHeap<NSNumber *> *heap = [CBHConcurrentHeap concurrentHeapWithComparator:kComparator shardCount:4];
+	CBHAssertConcurrentHeapState(heap, 4, 0);
+	XCTAssertNil([heap extractObject], @"Returned non-nil value when empty.");
+	XCTAssertEqualObjects([heap extractObjects:4], @[], @"Returned objects when empty.");
+
+	CBHConcurrentHeap<NSNumber *> *defaultHeap = [CBHConcurrentHeap concurrentHeapWithComparator:kComparator];
+	XCTAssertGreaterThanOrEqual([defaultHeap shardCount], 2, @"Incorrect default shard count.");
+
+	XCTAssertThrows([CBHConcurrentHeap concurrentHeapWithComparator:kComparator shardCount:0], @"Fails to catch zero shards.");
+}
+
+- (void)test_singleShard
+{
+	/// One shard is an exact priority queue.
+	CBHConcurrentHeap<NSNumber *> *heap = [CBHConcurrentHeap concurrentHeapWithComparator:kComparator shardCount:1];
+	for (NSNumber *number in CBHShuffledNumbers(1000)) { [heap insertObject:number]; }
+	CBHAssertConcurrentHeapState(heap, 1, 1000);
+
+	for (NSUInteger i = 0; i < 1000; ++i)
+	{
+		XCTAssertEqualObjects([heap extractObject], @(i), @"Entry is incorrect at index %lu.", i);
+	}
+
+	CBHAssertConcurrentHeapState(heap, 1, 0);
+	XCTAssertNil([heap extractObject], @"Returned non-nil value when empty.");
+}
+
+- (void)test_batches
+{
+	CBHConcurrentHeap<NSNumber *> *heap = [CBHConcurrentHeap concurrentHeapWithComparator:kComparator shardCount:4];
+
+	NSNumber *numbers[8] = {@7, @0, @6, @1, @5, @2, @4, @3};
+	[heap insertObjects:numbers count:8];
+	CBHAssertConcurrentHeapState(heap, 4, 8);
+	XCTAssertEqualObjects([heap array], (@[@0, @1, @2, @3, @4, @5, @6, @7]), @"Incorrect array.");
+
+	/// A batch is spread over the shards, so each extracted batch is only in order within itself.
+	NSMutableArray<NSNumber *> *extracted = [NSMutableArray array];
+	while ( ![heap isEmpty] )
+	{
+		NSArray<NSNumber *> *batch = [heap extractObjects:10];
+		XCTAssertGreaterThan([batch count], 0, @"Returned no objects when not empty.");
+		XCTAssertEqualObjects(batch, [batch sortedArrayUsingComparator:kComparator], @"Incorrect batch order.");
+		[extracted addObjectsFromArray:batch];
+	}
+	XCTAssertEqualObjects([extracted sortedArrayUsingComparator:kComparator], (@[@0, @1, @2, @3, @4, @5, @6, @7]), @"Incorrect objects.");
+	CBHAssertConcurrentHeapState(heap, 4, 0);
+
+	[heap insertObjects:numbers count:8];
+	[heap removeAllObjects];
+	CBHAssertConcurrentHeapState(heap, 4, 0);
+
+	/// One shard gives batches out exactly.
+	heap = [CBHConcurrentHeap concurrentHeapWithComparator:kComparator shardCount:1];
+	[heap insertObjects:numbers count:8];
+	XCTAssertEqualObjects([heap extractObjects:3], (@[@0, @1, @2]), @"Incorrect batch.");
+	XCTAssertEqualObjects([heap extractObjects:10], (@[@3, @4, @5, @6, @7]), @"Incorrect batch.");
+	CBHAssertConcurrentHeapState(heap, 1, 0);
+}
+
+- (void)test_rankBound_batches
+{
+	const NSUInteger shardCount = 8;
+	const NSUInteger count = 10000;
+	const NSUInteger batch = 1000;
+
+	/// Batches are spread like single insertions, so they keep the same bound.
+	CBHConcurrentHeap<NSNumber *> *heap = [CBHConcurrentHeap concurrentHeapWithComparator:kComparator shardCount:shardCount];
+	NSArray<NSNumber *> *numbers = CBHShuffledNumbers(count);
+
+	NSNumber * __unsafe_unretained *objects = calloc(batch, sizeof(NSNumber *));
+	for (NSUInteger i = 0; i < count; i += batch)
+	{
+		[numbers getObjects:objects range:NSMakeRange(i, batch)];
+		[heap insertObjects:objects count:batch];
+	}
+	free(objects);
+	CBHAssertConcurrentHeapState(heap, shardCount, count);
+
+	BOOL *isExtracted = calloc(count, sizeof(BOOL));
+	NSUInteger totalRank = 0;
+
+	for (NSUInteger i = 0; i < count; ++i)
+	{
+		const NSUInteger value = [[heap extractObject] unsignedIntegerValue];
+		XCTAssertFalse(isExtracted[value], @"Extracted %lu twice.", value);
+		isExtracted[value] = YES;
+
+		for (NSUInteger j = 0; j < value; ++j) { totalRank += !isExtracted[j]; }
+	}
+
+	free(isExtracted);
+
+	XCTAssertLessThanOrEqual(totalRank / count, 2 * shardCount, @"Extractions of batches stray too far from the minimum.");
+	CBHAssertConcurrentHeapState(heap, shardCount, 0);
+}
+
+- (void)test_rankBound
+{
+	const NSUInteger shardCount = 8;
+	const NSUInteger count = 10000;
+
+	CBHConcurrentHeap<NSNumber *> *heap = [CBHConcurrentHeap concurrentHeapWithComparator:kComparator shardCount:shardCount];
+	for (NSNumber *number in CBHShuffledNumbers(count)) { [heap insertObject:number]; }
+
+	/// The rank of an extraction is how many smaller objects were still in the heap.
+	BOOL *isExtracted = calloc(count, sizeof(BOOL));
+	NSUInteger totalRank = 0;
+
+	for (NSUInteger i = 0; i < count; ++i)
+	{
+		const NSUInteger value = [[heap extractObject] unsignedIntegerValue];
+		XCTAssertFalse(isExtracted[value], @"Extracted %lu twice.", value);
+		isExtracted[value] = YES;
+
+		for (NSUInteger j = 0; j < value; ++j) { totalRank += !isExtracted[j]; }
+	}
+
+	free(isExtracted);
+
+	/// The expected rank is within a small multiple of the shard count.
+	XCTAssertLessThanOrEqual(totalRank / count, 2 * shardCount, @"Extractions stray too far from the minimum.");
+	CBHAssertConcurrentHeapState(heap, shardCount, 0);
+}
+
+- (void)test_concurrent
+{
+	const NSUInteger threads = 8;
+	const NSUInteger perThread = 5000;
+
+	CBHConcurrentHeap<NSNumber *> *heap = [CBHConcurrentHeap concurrentHeapWithComparator:kComparator shardCount:4];
+
+	dispatch_apply(threads, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t thread) {
+		@autoreleasepool
+		{
+			for (NSUInteger i = 0; i < perThread; ++i) { [heap insertObject:@(thread * perThread + i)]; }
+		}
+	});
+	CBHAssertConcurrentHeapState(heap, 4, threads * perThread);
+
+	uint8_t *extractions = calloc(threads * perThread, sizeof(uint8_t));
+
+	dispatch_apply(threads, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t thread) {
+		@autoreleasepool
+		{
+			NSNumber *number = nil;
+			while ( (number = [heap extractObject]) )
+			{
+				__atomic_fetch_add(&extractions[[number unsignedIntegerValue]], 1, __ATOMIC_RELAXED);
+			}
+		}
+	});
+
+	/// Every object comes out exactly once.
+	for (NSUInteger i = 0; i < threads * perThread; ++i)
+	{
+		XCTAssertEqual(extractions[i], 1, @"Fails to extract %lu exactly once.", i);
+	}
+
+	free(extractions);
+	CBHAssertConcurrentHeapState(heap, 4, 0);
+}
+
+@end
@@ -0,0 +1,145 @@
+//  CBHConcurrentStackTests.m
+//  CBHCollectionKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import XCTest;
+
+@import CBHCollectionKit.CBHConcurrentStack;
+
+
+#define CBHAssertConcurrentStackState(aStack, aCount)\
+{\
+	XCTAssertNotNil(aStack, @"Stack was nil.");\
+	XCTAssertEqual([aStack count], (aCount), @"Incorrect count.");\
+	XCTAssertEqual([aStack isEmpty], (aCount <= 0), @"Incorrect empty state.");\
+}
+
+
+@interface CBHConcurrentStackTests : XCTestCase
+@end
+
+
+@implementation CBHConcurrentStackTests
+
+- (void)test_initialization
+{
+	CBHConcurrentStack<NSNumber *> *stack = [CBHConcurrentStack concurrentStack];
+	CBHAssertConcurrentStackState(stack, 0);
+	XCTAssertEqual([stack capacity], 0, @"Allocates nodes before use.");
+
+	XCTAssertNil([stack popObject], @"Returned non-nil value when empty.");
+	XCTAssertEqualObjects([stack popAll], @[], @"Returned objects when empty.");
+}
+
+- (void)test_pushAndPop
+{
+	CBHConcurrentStack<NSNumber *> *stack = [CBHConcurrentStack concurrentStack];
+	for (NSUInteger i = 0; i < 1000; ++i) { [stack pushObject:@(i)]; }
+	CBHAssertConcurrentStackState(stack, 1000);
+
+	/// Nodes are allocated in slabs.
+	XCTAssertGreaterThanOrEqual([stack capacity], 1000, @"Incorrect capacity.");
+
+	for (NSUInteger i = 0; i < 1000; ++i)
+	{
+		XCTAssertEqualObjects([stack popObject], @(999 - i), @"Entry is incorrect at index %lu.", i);
+	}
+
+	CBHAssertConcurrentStackState(stack, 0);
+	XCTAssertNil([stack popObject], @"Returned non-nil value when empty.");
+}
+
+- (void)test_batches
+{
+	CBHConcurrentStack<NSNumber *> *stack = [CBHConcurrentStack concurrentStack];
+
+	NSNumber *numbers[4] = {@0, @1, @2, @3};
+	[stack pushObjects:numbers count:4];
+	[stack pushObject:@4];
+	CBHAssertConcurrentStackState(stack, 5);
+
+	XCTAssertEqualObjects([stack popObject], @4, @"Incorrect top.");
+	XCTAssertEqualObjects([stack popAll], (@[@3, @2, @1, @0]), @"Incorrect batch.");
+	CBHAssertConcurrentStackState(stack, 0);
+
+	/// Popped nodes are reused rather than allocated again.
+	const NSUInteger capacity = [stack capacity];
+	[stack pushObjects:numbers count:4];
+	XCTAssertEqual([stack capacity], capacity, @"Fails to reuse nodes.");
+
+	[stack removeAllObjects];
+	CBHAssertConcurrentStackState(stack, 0);
+}
+
+- (void)test_retention
+{
+	NSObject *object = [[NSObject alloc] init];
+	const NSUInteger retainCount = [object retainCount];
+
+	CBHConcurrentStack<NSObject *> *stack = [[CBHConcurrentStack alloc] init];
+	[stack pushObject:object];
+	[stack pushObjects:&object count:1];
+	XCTAssertEqual([object retainCount], retainCount + 2, @"Fails to retain pushed objects.");
+
+	@autoreleasepool
+	{
+		XCTAssertEqual([stack popObject], object, @"Incorrect top.");
+	}
+	XCTAssertEqual([object retainCount], retainCount + 1, @"Fails to release popped objects.");
+
+	[stack release];
+	XCTAssertEqual([object retainCount], retainCount, @"Fails to release objects when freed.");
+
+	[object release];
+}
+
+- (void)test_concurrent
+{
+	const NSUInteger threads = 8;
+	const NSUInteger perThread = 10000;
+
+	CBHConcurrentStack<NSNumber *> *stack = [CBHConcurrentStack concurrentStack];
+	uint8_t *pops = calloc(threads * perThread, sizeof(uint8_t));
+
+	/// Every thread pushes its own objects while popping whatever is on top.
+	dispatch_apply(threads, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t thread) {
+		@autoreleasepool
+		{
+			for (NSUInteger i = 0; i < perThread; ++i)
+			{
+				[stack pushObject:@(thread * perThread + i)];
+				if ( i % 2 == 0 ) continue;
+
+				NSNumber *number = [stack popObject];
+				if ( number ) { __atomic_fetch_add(&pops[[number unsignedIntegerValue]], 1, __ATOMIC_RELAXED); }
+			}
+		}
+	});
+
+	for (NSNumber *number in [stack popAll]) { ++pops[[number unsignedIntegerValue]]; }
+	CBHAssertConcurrentStackState(stack, 0);
+
+	/// Every object comes out exactly once.
+	for (NSUInteger i = 0; i < threads * perThread; ++i)
+	{
+		XCTAssertEqual(pops[i], 1, @"Fails to pop %lu exactly once.", i);
+	}
+
+	free(pops);
+}
+
+@end
@@ -145,6 +145,20 @@ static NSArray<NSString *> *kArray = nil;
 	CBHAssertHeapTeardownDefault(copy, 8);
 }
 
+- (void)test_copy_sharesStorage
+{
+	CBHHeap<NSString *> *heap = [CBHHeap heapWithComparator:kComparator andArray:kArray];
+
+	CBHHeap<NSString *> *copy = [[heap copy] autorelease];
+	NSString *top = [heap extractObject];
+	XCTAssertEqual([heap count], 7, @"Incorrect count.");
+	CBHAssertHeapState(copy, 8, 8);
+	XCTAssertEqualObjects([copy peekAtObject], top, @"Extraction is visible through copy.");
+
+	CBHAssertHeapTeardownDefault(copy, 8);
+	XCTAssertEqual([heap count], 7, @"Removal is visible through original.");
+}
+
 
 #pragma mark - Equality
 
@@ -0,0 +1,267 @@
+//  CBHPersistentQueueTests.m
+//  CBHCollectionKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+@import XCTest;
+
+@import CBHCollectionKit.CBHPersistentQueue;
+
+
+#define CBHAssertPersistentQueueState(aQueue, aCount)\
+{\
+	XCTAssertNotNil(aQueue, @"Queue was nil.");\
+	XCTAssertEqual([aQueue count], (aCount), @"Incorrect count.");\
+	XCTAssertEqual([aQueue capacity], (aCount), @"Incorrect capacity.");\
+	XCTAssertEqual([aQueue isEmpty], (aCount <= 0), @"Incorrect empty state.");\
+}
+
+
+@interface CBHPersistentQueueTests : XCTestCase
+@end
+
+
+@implementation CBHPersistentQueueTests
+
+- (void)test_initialization
+{
+	CBHPersistentQueue<NSNumber *> *queue = [CBHPersistentQueue persistentQueue];
+	CBHAssertPersistentQueueState(queue, 0);
+	XCTAssertNil([queue peekAtObject], @"Returned non-nil value when empty.");
+	XCTAssertEqual([queue queueByDequeuingObject], queue, @"Dequeuing an empty queue makes a new one.");
+	XCTAssertEqualObjects([queue array], @[], @"Returned objects when empty.");
+
+	queue = [CBHPersistentQueue persistentQueueWithArray:@[@0, @1, @2]];
+	CBHAssertPersistentQueueState(queue, 3);
+	XCTAssertEqualObjects([queue peekAtObject], @0, @"Incorrect head.");
+	XCTAssertEqualObjects([queue array], (@[@0, @1, @2]), @"Incorrect order.");
+}
+
+- (void)test_enqueueAndDequeue
+{
+	CBHPersistentQueue<NSNumber *> *queue = [CBHPersistentQueue persistentQueue];
+	for (NSUInteger i = 0; i < 1000; ++i) { queue = [queue queueByEnqueuingObject:@(i)]; }
+	CBHAssertPersistentQueueState(queue, 1000);
+
+	/// Interleave so the rear is reversed more than once.
+	for (NSUInteger i = 0; i < 500; ++i)
+	{
+		XCTAssertEqualObjects([queue peekAtObject], @(i), @"Entry is incorrect at index %lu.", i);
+		queue = [[queue queueByDequeuingObject] queueByEnqueuingObject:@(1000 + i)];
+	}
+	CBHAssertPersistentQueueState(queue, 1000);
+
+	for (NSUInteger i = 500; i < 1500; ++i)
+	{
+		XCTAssertEqualObjects([queue peekAtObject], @(i), @"Entry is incorrect at index %lu.", i);
+		queue = [queue queueByDequeuingObject];
+	}
+	CBHAssertPersistentQueueState(queue, 0);
+}
+
+- (void)test_versions
+{
+	CBHPersistentQueue<NSNumber *> *base = [[CBHPersistentQueue persistentQueueWithArray:@[@0]] queueByEnqueuingObjectsFromArray:@[@1, @2]];
+	CBHPersistentQueue<NSNumber *> *enqueued = [base queueByEnqueuingObject:@3];
+	CBHPersistentQueue<NSNumber *> *dequeued = [base queueByDequeuingObject];
+
+	/// Every version is left as it was.
+	XCTAssertEqualObjects([base array], (@[@0, @1, @2]), @"Changed by a new version.");
+	XCTAssertEqualObjects([enqueued array], (@[@0, @1, @2, @3]), @"Incorrect enqueued version.");
+	XCTAssertEqualObjects([dequeued array], (@[@1, @2]), @"Incorrect dequeued version.");
+
+	/// Branches from the same version don't see each other.
+	CBHPersistentQueue<NSNumber *> *branch0 = [dequeued queueByEnqueuingObject:@10];
+	CBHPersistentQueue<NSNumber *> *branch1 = [dequeued queueByEnqueuingObject:@11];
+	XCTAssertEqualObjects([branch0 array], (@[@1, @2, @10]), @"Incorrect branch.");
+	XCTAssertEqualObjects([branch1 array], (@[@1, @2, @11]), @"Incorrect branch.");
+	XCTAssertEqualObjects([base array], (@[@0, @1, @2]), @"Changed by a branch.");
+
+	/// Dequeuing a snapshot again gives an equal version.
+	XCTAssertEqualObjects([base queueByDequeuingObject], dequeued, @"Dequeues a snapshot differently.");
+
+	XCTAssertEqual([base queueByEnqueuingObjectsFromArray:@[]], base, @"Enqueuing nothing makes a new queue.");
+}
+
+- (void)test_copying
+{
+	CBHPersistentQueue<NSNumber *> *queue = [CBHPersistentQueue persistentQueueWithArray:@[@0, @1]];
+	CBHPersistentQueue<NSNumber *> *copy = [queue copy];
+
+	XCTAssertEqual(copy, queue, @"Copies an immutable queue.");
+
+	[copy release];
+}
+
+- (void)test_equality
+{
+	/// The same objects split differently between the front and the rear.
+	CBHPersistentQueue<NSNumber *> *queue0 = [CBHPersistentQueue persistentQueueWithArray:@[@0, @1, @2]];
+	CBHPersistentQueue<NSNumber *> *queue1 = [[CBHPersistentQueue persistentQueue] queueByEnqueuingObjectsFromArray:@[@0, @1, @2]];
+	CBHPersistentQueue<NSNumber *> *queue2 = [queue0 queueByEnqueuingObject:@3];
+
+	XCTAssertEqualObjects(queue0, queue1, @"Equal queues are unequal.");
+	XCTAssertEqual([queue0 hash], [queue1 hash], @"Equal queues hash differently.");
+
+	XCTAssertNotEqualObjects(queue0, queue2, @"Queues of different counts are equal.");
+	XCTAssertNotEqualObjects(queue0, [[queue1 queueByDequeuingObject] queueByEnqueuingObject:@0], @"Different queues are equal.");
+}
+
+- (void)test_enumeration
+{
+	NSMutableArray<NSNumber *> *array = [NSMutableArray array];
+	for (NSUInteger i = 0; i < 100; ++i) { [array addObject:@(i)]; }
+
+	/// Half in the front and half in the rear.
+	CBHPersistentQueue<NSNumber *> *queue = [CBHPersistentQueue persistentQueueWithArray:[array subarrayWithRange:NSMakeRange(0, 50)]];
+	queue = [queue queueByEnqueuingObjectsFromArray:[array subarrayWithRange:NSMakeRange(50, 50)]];
+
+	NSUInteger index = 0;
+	for (NSNumber *number in queue)
+	{
+		XCTAssertEqualObjects(number, array[index], @"Entry is incorrect at index %lu.", index);
+		++index;
+	}
+	XCTAssertEqual(index, 100, @"Enumerates the wrong number of objects.");
+	XCTAssertEqualObjects([queue array], array, @"Incorrect array.");
+}
+
+- (void)test_retention
+{
+	NSObject *object = [[NSObject alloc] init];
+	const NSUInteger retainCount = [object retainCount];
+
+	@autoreleasepool
+	{
+		CBHPersistentQueue<NSObject *> *queue = [CBHPersistentQueue persistentQueue];
+		queue = [queue queueByEnqueuingObject:object];
+		queue = [queue queueByEnqueuingObject:object];
+		queue = [queue queueByDequeuingObject];
+		XCTAssertGreaterThan([object retainCount], retainCount, @"Fails to retain enqueued objects.");
+	}
+
+	XCTAssertEqual([object retainCount], retainCount, @"Fails to release objects when freed.");
+
+	[object release];
+}
+
+- (void)test_branching
+{
+	/// Versions are kept and branched from at random, each checked against a copy of its objects.
+	NSMutableArray<CBHPersistentQueue<NSNumber *> *> *queues = [NSMutableArray arrayWithObject:[CBHPersistentQueue persistentQueue]];
+	NSMutableArray<NSMutableArray<NSNumber *> *> *models = [NSMutableArray arrayWithObject:[NSMutableArray array]];
+
+	srandom(49);
+	for (NSUInteger i = 0; i < 20000; ++i)
+	{
+		const NSUInteger version = (NSUInteger)random() % [queues count];
+		CBHPersistentQueue<NSNumber *> *queue = queues[version];
+		NSMutableArray<NSNumber *> *model = [[models[version] mutableCopy] autorelease];
+
+		if ( [model count] > 0 && random() % 3 == 0 )
+		{
+			queue = [queue queueByDequeuingObject];
+			[model removeObjectAtIndex:0];
+		}
+		else
+		{
+			queue = [queue queueByEnqueuingObject:@(i)];
+			[model addObject:@(i)];
+		}
+
+		CBHAssertPersistentQueueState(queue, [model count]);
+		XCTAssertEqualObjects([queue peekAtObject], [model firstObject], @"Incorrect head at step %lu.", i);
+
+		/// Keep a bounded set of versions, newer ones replacing older ones at random.
+		if ( [queues count] < 64 )
+		{
+			[queues addObject:queue];
+			[models addObject:model];
+		}
+		else
+		{
+			const NSUInteger replaced = (NSUInteger)random() % [queues count];
+			queues[replaced] = queue;
+			models[replaced] = model;
+		}
+	}
+
+	for (NSUInteger i = 0; i < [queues count]; ++i)
+	{
+		XCTAssertEqualObjects([queues[i] array], models[i], @"Incorrect objects in version %lu.", i);
+
+		NSUInteger index = 0;
+		for (NSNumber *number in queues[i])
+		{
+			XCTAssertEqualObjects(number, models[i][index], @"Entry is incorrect at index %lu.", index);
+			++index;
+		}
+		XCTAssertEqual(index, [models[i] count], @"Enumerates the wrong number of objects.");
+	}
+}
+
+- (void)test_retention_chunks
+{
+	NSMutableArray<NSObject *> *objects = [NSMutableArray array];
+	for (NSUInteger i = 0; i < 1000; ++i) { [objects addObject:[[[NSObject alloc] init] autorelease]]; }
+
+	NSObject *head = [objects firstObject];
+	NSObject *tail = [objects lastObject];
+	const NSUInteger headCount = [head retainCount];
+	const NSUInteger tailCount = [tail retainCount];
+
+	CBHPersistentQueue<NSObject *> *queue = nil;
+	@autoreleasepool
+	{
+		queue = [CBHPersistentQueue persistentQueueWithArray:objects];
+		for (NSUInteger i = 0; i < 300; ++i) { queue = [queue queueByDequeuingObject]; }
+		[queue retain];
+	}
+
+	/// The head's chunk is left behind once the versions reaching it are freed.
+	XCTAssertEqual([head retainCount], headCount, @"Keeps dequeued objects of a consumed chunk.");
+	XCTAssertGreaterThan([tail retainCount], tailCount, @"Fails to retain queued objects.");
+
+	[queue release];
+}
+
+- (void)test_concurrent
+{
+	const NSUInteger threads = 8;
+
+	/// Every thread dequeues the same snapshot.
+	CBHPersistentQueue<NSNumber *> *base = [CBHPersistentQueue persistentQueueWithArray:@[@0]];
+	base = [base queueByEnqueuingObjectsFromArray:@[@1, @2, @3]];
+
+	/// Blocks can't capture C arrays, so the results live on the heap.
+	CBHPersistentQueue<NSNumber *> * __unsafe_unretained *results = calloc(threads, sizeof(CBHPersistentQueue *));
+
+	dispatch_apply(threads, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t thread) {
+		results[thread] = [[base queueByDequeuingObject] retain];
+	});
+
+	for (NSUInteger i = 0; i < threads; ++i)
+	{
+		XCTAssertEqualObjects(results[i], results[0], @"Dequeues a snapshot differently.");
+		XCTAssertEqualObjects([results[i] array], (@[@1, @2, @3]), @"Incorrect dequeued version.");
+		[results[i] release];
+	}
+
+	free(results);
+}
+
+@end
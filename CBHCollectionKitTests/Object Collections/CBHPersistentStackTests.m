@@ -0,0 +1,180 @@
+//  CBHPersistentStackTests.m
+//  CBHCollectionKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+@import XCTest;
+
+@import CBHCollectionKit.CBHPersistentStack;
+
+
+#define CBHAssertPersistentStackState(aStack, aCount)\
+{\
+	XCTAssertNotNil(aStack, @"Stack was nil.");\
+	XCTAssertEqual([aStack count], (aCount), @"Incorrect count.");\
+	XCTAssertEqual([aStack capacity], (aCount), @"Incorrect capacity.");\
+	XCTAssertEqual([aStack isEmpty], (aCount <= 0), @"Incorrect empty state.");\
+}
+
+
+@interface CBHPersistentStackTests : XCTestCase
+@end
+
+
+@implementation CBHPersistentStackTests
+
+- (void)test_initialization
+{
+	CBHPersistentStack<NSNumber *> *stack = [CBHPersistentStack persistentStack];
+	CBHAssertPersistentStackState(stack, 0);
+	XCTAssertNil([stack peekAtObject], @"Returned non-nil value when empty.");
+	XCTAssertEqual([stack stackByPoppingObject], stack, @"Popping an empty stack makes a new one.");
+	XCTAssertEqualObjects([stack array], @[], @"Returned objects when empty.");
+
+	stack = [CBHPersistentStack persistentStackWithArray:@[@2, @1, @0]];
+	CBHAssertPersistentStackState(stack, 3);
+	XCTAssertEqualObjects([stack peekAtObject], @2, @"Incorrect top.");
+	XCTAssertEqualObjects([stack array], (@[@2, @1, @0]), @"Incorrect order.");
+}
+
+- (void)test_pushAndPop
+{
+	CBHPersistentStack<NSNumber *> *stack = [CBHPersistentStack persistentStack];
+	for (NSUInteger i = 0; i < 1000; ++i) { stack = [stack stackByPushingObject:@(i)]; }
+	CBHAssertPersistentStackState(stack, 1000);
+
+	for (NSUInteger i = 0; i < 1000; ++i)
+	{
+		XCTAssertEqualObjects([stack peekAtObject], @(999 - i), @"Entry is incorrect at index %lu.", i);
+		stack = [stack stackByPoppingObject];
+	}
+
+	CBHAssertPersistentStackState(stack, 0);
+}
+
+- (void)test_versions
+{
+	CBHPersistentStack<NSNumber *> *base = [CBHPersistentStack persistentStackWithArray:@[@1, @0]];
+	CBHPersistentStack<NSNumber *> *pushed = [base stackByPushingObject:@2];
+	CBHPersistentStack<NSNumber *> *popped = [base stackByPoppingObject];
+
+	/// Every version is left as it was.
+	XCTAssertEqualObjects([base array], (@[@1, @0]), @"Changed by a new version.");
+	XCTAssertEqualObjects([pushed array], (@[@2, @1, @0]), @"Incorrect pushed version.");
+	XCTAssertEqualObjects([popped array], (@[@0]), @"Incorrect popped version.");
+
+	/// Branches from the same version don't see each other.
+	CBHPersistentStack<NSNumber *> *branch0 = [popped stackByPushingObject:@10];
+	CBHPersistentStack<NSNumber *> *branch1 = [popped stackByPushingObject:@11];
+	XCTAssertEqualObjects([branch0 array], (@[@10, @0]), @"Incorrect branch.");
+	XCTAssertEqualObjects([branch1 array], (@[@11, @0]), @"Incorrect branch.");
+	XCTAssertEqualObjects([base array], (@[@1, @0]), @"Changed by a branch.");
+
+	CBHPersistentStack<NSNumber *> *batch = [popped stackByPushingObjectsFromArray:@[@1, @2, @3]];
+	XCTAssertEqualObjects([batch array], (@[@3, @2, @1, @0]), @"Incorrect batch.");
+	XCTAssertEqual([popped stackByPushingObjectsFromArray:@[]], popped, @"Pushing nothing makes a new stack.");
+}
+
+- (void)test_copying
+{
+	CBHPersistentStack<NSNumber *> *stack = [CBHPersistentStack persistentStackWithArray:@[@1, @0]];
+	CBHPersistentStack<NSNumber *> *copy = [stack copy];
+
+	XCTAssertEqual(copy, stack, @"Copies an immutable stack.");
+
+	[copy release];
+}
+
+- (void)test_equality
+{
+	CBHPersistentStack<NSNumber *> *stack0 = [CBHPersistentStack persistentStackWithArray:@[@2, @1, @0]];
+	CBHPersistentStack<NSNumber *> *stack1 = [[[CBHPersistentStack persistentStack] stackByPushingObjectsFromArray:@[@0, @1]] stackByPushingObject:@2];
+	CBHPersistentStack<NSNumber *> *stack2 = [stack0 stackByPushingObject:@3];
+
+	XCTAssertEqualObjects(stack0, stack1, @"Equal stacks from different chunks are unequal.");
+	XCTAssertEqual([stack0 hash], [stack1 hash], @"Equal stacks hash differently.");
+	XCTAssertEqualObjects([stack2 stackByPoppingObject], stack0, @"Shared stacks are unequal.");
+
+	XCTAssertNotEqualObjects(stack0, stack2, @"Stacks of different counts are equal.");
+	XCTAssertNotEqualObjects(stack0, [[stack1 stackByPoppingObject] stackByPushingObject:@4], @"Different stacks are equal.");
+}
+
+- (void)test_enumeration
+{
+	NSMutableArray<NSNumber *> *array = [NSMutableArray array];
+	for (NSUInteger i = 0; i < 100; ++i) { [array addObject:@(i)]; }
+
+	/// Spans several chunks, enumerated from the top.
+	CBHPersistentStack<NSNumber *> *stack = [CBHPersistentStack persistentStack];
+	for (NSUInteger i = 0; i < 100; ++i) { stack = [stack stackByPushingObject:@(99 - i)]; }
+
+	NSUInteger index = 0;
+	for (NSNumber *number in stack)
+	{
+		XCTAssertEqualObjects(number, array[index], @"Entry is incorrect at index %lu.", index);
+		++index;
+	}
+	XCTAssertEqual(index, 100, @"Enumerates the wrong number of objects.");
+	XCTAssertEqualObjects([stack array], array, @"Incorrect array.");
+}
+
+- (void)test_retention
+{
+	NSObject *object = [[NSObject alloc] init];
+	const NSUInteger retainCount = [object retainCount];
+
+	@autoreleasepool
+	{
+		CBHPersistentStack<NSObject *> *stack = [CBHPersistentStack persistentStack];
+		stack = [stack stackByPushingObject:object];
+		stack = [stack stackByPushingObject:object];
+		XCTAssertEqual([object retainCount], retainCount + 2, @"Fails to retain pushed objects.");
+	}
+
+	XCTAssertEqual([object retainCount], retainCount, @"Fails to release objects when freed.");
+
+	[object release];
+}
+
+- (void)test_concurrent
+{
+	const NSUInteger threads = 8;
+	const NSUInteger perThread = 1000;
+
+	CBHPersistentStack<NSNumber *> *base = [CBHPersistentStack persistentStackWithArray:@[@-1]];
+
+	/// Every thread grows its own branch from the same version at once.
+	dispatch_apply(threads, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t thread) {
+		@autoreleasepool
+		{
+			CBHPersistentStack<NSNumber *> *stack = base;
+			for (NSUInteger i = 0; i < perThread; ++i) { stack = [stack stackByPushingObject:@(thread * perThread + i)]; }
+
+			XCTAssertEqual([stack count], perThread + 1, @"Incorrect count.");
+			for (NSUInteger i = 0; i < perThread; ++i)
+			{
+				XCTAssertEqualObjects([stack peekAtObject], @(thread * perThread + perThread - 1 - i), @"Branch mixed with another.");
+				stack = [stack stackByPoppingObject];
+			}
+			XCTAssertEqualObjects(stack, base, @"Branch fails to return to the base.");
+		}
+	});
+
+	CBHAssertPersistentStackState(base, 1);
+}
+
+@end
@@ -156,6 +156,32 @@ CBHQueue<NSString *> *aName = nil; \
 	CBHAssertQueueTeardownDefault(copy, 8);
 }
 
+- (void)test_copy_sharesStorage
+{
+	CBHQueue<NSString *> *queue = [CBHQueue queueWithArray:@[@"0", @"1", @"2", @"3", @"4", @"5", @"6", @"7"]];
+	[queue dequeueObject];
+	[queue enqueueObject:@"8"];
+
+	CBHQueue<NSString *> *copy = [[queue copy] autorelease];
+	XCTAssertEqualObjects(queue, copy, @"Fails to detect equality.");
+
+	XCTAssertEqualObjects([queue dequeueObject], @"1", @"Entry is incorrect at head.");
+	[copy enqueueObject:@"9"];
+	CBHAssertQueueState(queue, 8, 7);
+	XCTAssertEqual([copy count], 9, @"Incorrect count.");
+
+	for (NSUInteger i = 1; i <= 9; ++i)
+	{
+		NSString *expected = [NSString stringWithFormat:@"%lu", i];
+		XCTAssertEqualObjects([copy dequeueObject], expected, @"Entry is incorrect at index %lu.", i);
+	}
+	for (NSUInteger i = 2; i <= 8; ++i)
+	{
+		NSString *expected = [NSString stringWithFormat:@"%lu", i];
+		XCTAssertEqualObjects([queue dequeueObject], expected, @"Entry is incorrect at index %lu.", i);
+	}
+}
+
 @end
 
 
@@ -339,6 +365,80 @@ CBHQueue<NSString *> *aName = nil; \
 	XCTAssertEqual(i, 8, @"Iterated wrong number of times.");
 }
 
+- (void)test_fastEnumeration_mutation
+{
+	CBHQueue<NSString *> *queue = [CBHQueue queueWithArray:@[@"0", @"1", @"2", @"3"]];
+
+	XCTAssertThrows({ for (NSString *string in queue) { [queue enqueueObject:string]; } }, @"Fails to detect mutation.");
+}
+
+@end
+
+
+#pragma mark - Block Enumeration
+@implementation CBHQueueTests (BlockEnumeration)
+
+- (void)test_blockEnumeration_offset
+{
+	CBHCreateOffsetEmptyQueue(queue);
+	[queue enqueueObjects:@"0", @"1", @"2", @"3", @"4", @"5", @"6", @"7", nil];
+
+	__block NSUInteger calls = 0;
+	[queue enumerateObjectsUsingBlock:^(NSString *string, NSUInteger index, BOOL *stop) {
+		XCTAssertEqual(index, calls, @"Fails to enumerate in order.");
+		XCTAssertEqualObjects(string, [NSString stringWithFormat:@"%lu", index], @"Entry is incorrect at index %lu.", index);
+		++calls;
+	}];
+	XCTAssertEqual(calls, 8, @"Iterated wrong number of times.");
+
+	calls = 0;
+	[queue enumerateObjectsWithOptions:NSEnumerationReverse usingBlock:^(NSString *string, NSUInteger index, BOOL *stop) {
+		XCTAssertEqual(index, 7 - calls, @"Fails to enumerate in reverse.");
+		XCTAssertEqualObjects(string, [NSString stringWithFormat:@"%lu", index], @"Entry is incorrect at index %lu.", index);
+		++calls;
+	}];
+	XCTAssertEqual(calls, 8, @"Iterated wrong number of times.");
+}
+
+- (void)test_blockEnumeration_stop
+{
+	CBHCreateOffsetEmptyQueue(queue);
+	[queue enqueueObjects:@"0", @"1", @"2", @"3", @"4", @"5", @"6", @"7", nil];
+
+	/// Stopping in the first segment skips the second.
+	__block NSUInteger calls = 0;
+	[queue enumerateObjectsUsingBlock:^(NSString *string, NSUInteger index, BOOL *stop) {
+		++calls;
+		if ( index == 1 ) { *stop = YES; }
+	}];
+	XCTAssertEqual(calls, 2, @"Fails to stop enumerating.");
+
+	calls = 0;
+	[queue enumerateObjectsWithOptions:NSEnumerationReverse usingBlock:^(NSString *string, NSUInteger index, BOOL *stop) {
+		++calls;
+		if ( index == 6 ) { *stop = YES; }
+	}];
+	XCTAssertEqual(calls, 2, @"Fails to stop enumerating in reverse.");
+}
+
+- (void)test_blockEnumeration_concurrent
+{
+	CBHCreateOffsetEmptyQueue(queue);
+	[queue enqueueObjects:@"0", @"1", @"2", @"3", @"4", @"5", @"6", @"7", nil];
+
+	/// Each object must be visited exactly once.
+	unsigned char *visits = calloc(8, sizeof(unsigned char));
+	XCTAssertTrue(visits != NULL);
+
+	[queue enumerateObjectsWithOptions:NSEnumerationConcurrent usingBlock:^(NSString *string, NSUInteger index, BOOL *stop) {
+		if ( [string integerValue] == (NSInteger)index ) { __atomic_add_fetch(&visits[index], 1, __ATOMIC_RELAXED); }
+	}];
+
+	for (NSUInteger i = 0; i < 8; ++i) { XCTAssertEqual(visits[i], 1, @"Fails to visit object at index %lu once.", i); }
+
+	free(visits);
+}
+
 @end
 
 
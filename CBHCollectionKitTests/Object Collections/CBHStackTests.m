@@ -134,6 +134,84 @@
 	CBHAssertStackDefault(copy, 8);
 }
 
+- (void)test_copy_sharesStorage
+{
+	NSObject *object = [[[NSObject alloc] init] autorelease];
+	const NSUInteger retainCount = [object retainCount];
+
+	CBHStack<NSObject *> *stack = [CBHStack stackWithCapacity:8];
+	[stack pushObject:object];
+	[stack pushObject:object];
+
+	CBHStack<NSObject *> *copy = [[stack copy] autorelease];
+	XCTAssertEqual([object retainCount], retainCount + 2, @"Copy retains shared entries.");
+
+	[copy pushObject:@"top"];
+	XCTAssertEqual([object retainCount], retainCount + 4, @"Fails to retain entries on write.");
+	CBHAssertStackState(stack, 8, 2);
+	XCTAssertEqual([copy count], 3, @"Incorrect count.");
+
+	XCTAssertEqual([stack popObject], object, @"Entry is incorrect at top.");
+	XCTAssertEqualObjects([copy popObject], @"top", @"Entry is incorrect at top.");
+	XCTAssertEqual([copy popObject], object, @"Entry is incorrect at top.");
+	XCTAssertEqual([copy count], 1, @"Incorrect count.");
+	XCTAssertEqual([stack count], 1, @"Incorrect count.");
+}
+
+- (void)test_copy_sharesStorage_bulkPush
+{
+	NSObject *object = [[[NSObject alloc] init] autorelease];
+	const NSUInteger retainCount = [object retainCount];
+
+	@autoreleasepool
+	{
+		/// Spare capacity means the bulk push doesn't need to grow.
+		CBHStack<NSObject *> *stack = [CBHStack stackWithCapacity:16];
+		[stack pushObject:object];
+		[stack pushObject:object];
+
+		CBHStack<NSObject *> *copy = [[stack copy] autorelease];
+		[copy pushObjectsFromArray:@[@"a", @"b"]];
+		XCTAssertEqual([object retainCount], retainCount + 4, @"Fails to retain entries on bulk write.");
+
+		[stack pushObjectsFromOrderedSet:[NSOrderedSet orderedSetWithObject:@"c"]];
+		XCTAssertEqual([object retainCount], retainCount + 4, @"Retains entries which are no longer shared.");
+
+		CBHAssertStackState(copy, 16, 4);
+		CBHAssertStackState(stack, 16, 3);
+	}
+
+	XCTAssertEqual([object retainCount], retainCount, @"Fails to balance references.");
+}
+
+- (void)test_copy_sharesStorage_concurrentRelease
+{
+	NSObject *object = [[[NSObject alloc] init] autorelease];
+	const NSUInteger retainCount = [object retainCount];
+	dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+
+	/// One sharer writes while the other is released, the writer must take its references first.
+	for (NSUInteger i = 0; i < 1000; ++i)
+	{
+		/// Not retained by the block, so the release below deallocates it.
+		__block CBHStack<NSObject *> *stack = [[CBHStack alloc] initWithCapacity:16];
+		[stack pushObject:object];
+
+		CBHStack<NSObject *> *copy = [stack copy];
+
+		dispatch_group_t group = dispatch_group_create();
+		dispatch_group_async(group, queue, ^{ [stack release]; });
+		[copy pushObject:@"top"];
+		dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+		dispatch_release(group);
+
+		XCTAssertEqual([copy peekAtObjectFromBottom:0], object, @"Entry is incorrect at bottom.");
+		[copy release];
+	}
+
+	XCTAssertEqual([object retainCount], retainCount, @"Fails to balance references.");
+}
+
 @end
 
 
@@ -302,6 +380,40 @@
 	}
 }
 
+- (void)test_fastEnumeration_mutation
+{
+	CBHStack<NSString *> *stack = [CBHStack stackWithArray:@[@"0", @"1", @"2", @"3"]];
+
+	XCTAssertThrows({ for (NSString *string in stack) { [stack pushObject:string]; } }, @"Fails to detect mutation.");
+}
+
+@end
+
+
+#pragma mark - Block Enumeration
+@implementation CBHStackTests (BlockEnumeration)
+
+- (void)test_blockEnumeration
+{
+	CBHStack<NSString *> *stack = [CBHStack stackWithArray:@[@"0", @"1", @"2", @"3", @"4", @"5", @"6", @"7"]];
+
+	__block NSUInteger calls = 0;
+	[stack enumerateObjectsUsingBlock:^(NSString *string, NSUInteger index, BOOL *stop) {
+		XCTAssertEqual(index, calls, @"Fails to enumerate in order.");
+		XCTAssertEqualObjects(string, [NSString stringWithFormat:@"%lu", index], @"Entry is incorrect at index %lu.", index);
+		++calls;
+	}];
+	XCTAssertEqual(calls, 8, @"Iterated wrong number of times.");
+
+	calls = 0;
+	[stack enumerateObjectsWithOptions:NSEnumerationReverse usingBlock:^(NSString *string, NSUInteger index, BOOL *stop) {
+		XCTAssertEqual(index, 7 - calls, @"Fails to enumerate in reverse.");
+		++calls;
+		if ( index == 4 ) { *stop = YES; }
+	}];
+	XCTAssertEqual(calls, 4, @"Fails to stop enumerating.");
+}
+
 @end
 
 
@@ -451,6 +563,25 @@
 	CBHAssertStackDefault(stack, 4);
 }
 
+- (void)test_pushPop_inlineOverflow
+{
+	NSObject *object = [[[NSObject alloc] init] autorelease];
+	const NSUInteger retainCount = [object retainCount];
+
+	CBHStack<NSObject *> *stack = [[CBHStack alloc] initWithCapacity:8];
+	for (NSUInteger i = 0; i < 8; ++i) { [stack pushObject:object]; }
+	XCTAssertEqual([object retainCount], retainCount + 8, @"Fails to retain inline entries.");
+
+	/// The ninth entry moves the stack's entries to the heap.
+	[stack pushObject:object];
+	XCTAssertEqual([object retainCount], retainCount + 9, @"Fails to keep references on overflow.");
+	XCTAssertEqual([stack count], 9, @"Incorrect count.");
+	XCTAssertEqual([stack peekAtObjectFromBottom:0], object, @"Entry is incorrect at bottom.");
+
+	[stack release];
+	XCTAssertEqual([object retainCount], retainCount, @"Fails to release entries.");
+}
+
 @end
 
 
@@ -0,0 +1,274 @@
+//  CBHBitSliceTests.m
+//  CBHCollectionKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import XCTest;
+@import CBHCollectionKit.CBHBitSlice;
+
+
+@interface CBHBitSliceTests : XCTestCase
+@end
+
+
+@implementation CBHBitSliceTests
+
+#pragma mark - Initialization
+
+- (void)testInitialization_basic
+{
+	CBHBitSlice *bits = [CBHBitSlice bitSlice];
+	XCTAssertEqual([bits count], 0);
+	XCTAssertEqual([bits capacity], 512);
+	XCTAssertEqual([bits entrySize], sizeof(uint64_t));
+	XCTAssertTrue([bits isEmpty]);
+
+	XCTAssertThrows([bits bitAtIndex:0], @"Fails to catch out-of-bounds on access.");
+}
+
+- (void)testInitialization_count
+{
+	CBHBitSlice *bits = [CBHBitSlice bitSliceWithCount:130];
+	XCTAssertEqual([bits count], 130);
+	XCTAssertEqual([bits wordCount], 3);
+	XCTAssertEqual([bits popCount], 0);
+	XCTAssertFalse([bits bitAtIndex:129]);
+	XCTAssertThrows([bits bitAtIndex:130], @"Fails to catch out-of-bounds on access.");
+}
+
+- (void)testInitialization_words
+{
+	const uint64_t words[] = {0x5, UINT64_MAX};
+	CBHBitSlice *bits = [CBHBitSlice bitSliceWithCount:68 copyingWords:words];
+
+	XCTAssertTrue([bits bitAtIndex:0]);
+	XCTAssertFalse([bits bitAtIndex:1]);
+	XCTAssertTrue([bits bitAtIndex:2]);
+	XCTAssertTrue([bits bitAtIndex:67]);
+	XCTAssertEqual([bits popCount], 6, @"Bits past the end kept.");
+	XCTAssertEqual(((const uint64_t *)[bits bytes])[1], (uint64_t)0xF, @"Bits past the end kept.");
+}
+
+
+#pragma mark - Bits
+
+- (void)testBits_setClearFlip
+{
+	CBHBitSlice *bits = [CBHBitSlice bitSliceWithCount:100];
+
+	[bits setBitAtIndex:3];
+	[bits setBit:YES atIndex:64];
+	[bits flipBitAtIndex:99];
+	XCTAssertTrue([bits bitAtIndex:3]);
+	XCTAssertTrue([bits bitAtIndex:64]);
+	XCTAssertTrue([bits bitAtIndex:99]);
+	XCTAssertEqual([bits popCount], 3);
+
+	[bits clearBitAtIndex:3];
+	[bits setBit:NO atIndex:64];
+	[bits flipBitAtIndex:99];
+	XCTAssertEqual([bits popCount], 0);
+
+	XCTAssertThrows([bits setBitAtIndex:100], @"Fails to catch out-of-bounds on write.");
+}
+
+- (void)testBits_ranges
+{
+	CBHBitSlice *bits = [CBHBitSlice bitSliceWithCount:300];
+
+	[bits setBitsInRange:NSMakeRange(10, 200)];
+	XCTAssertEqual([bits popCount], 200);
+	XCTAssertFalse([bits bitAtIndex:9]);
+	XCTAssertTrue([bits bitAtIndex:10]);
+	XCTAssertTrue([bits bitAtIndex:209]);
+	XCTAssertFalse([bits bitAtIndex:210]);
+
+	[bits clearBitsInRange:NSMakeRange(60, 10)];
+	XCTAssertEqual([bits popCount], 190);
+	XCTAssertEqual([bits popCountInRange:NSMakeRange(0, 64)], 50);
+
+	[bits setAll];
+	XCTAssertEqual([bits popCount], 300, @"Bits past the end set.");
+
+	[bits clearAll];
+	XCTAssertEqual([bits popCount], 0);
+
+	XCTAssertThrows([bits setBitsInRange:NSMakeRange(250, 51)], @"Fails to catch out-of-bounds range.");
+}
+
+
+#pragma mark - Appending and Removing
+
+- (void)testAppend_grows
+{
+	CBHBitSlice *bits = [CBHBitSlice bitSliceWithCapacity:1];
+
+	for (NSUInteger i = 0; i < 1000; ++i) { [bits appendBit:(i % 3 == 0)]; }
+	XCTAssertEqual([bits count], 1000);
+	XCTAssertGreaterThanOrEqual([bits capacity], 1000);
+	XCTAssertEqual([bits popCount], 334);
+
+	[bits appendBits:YES count:100];
+	XCTAssertEqual([bits popCount], 434);
+}
+
+- (void)testRemove_clearsTail
+{
+	CBHBitSlice *bits = [CBHBitSlice bitSlice];
+	[bits appendBits:YES count:200];
+
+	[bits removeLast:150];
+	XCTAssertEqual([bits count], 50);
+	XCTAssertEqual([bits popCount], 50);
+
+	/// Bits added back must be clear, not the ones removed.
+	[bits appendBits:NO count:150];
+	XCTAssertEqual([bits popCount], 50);
+	XCTAssertFalse([bits bitAtIndex:199]);
+
+	[bits removeAll];
+	XCTAssertTrue([bits isEmpty]);
+}
+
+
+#pragma mark - Finding
+
+- (void)testFind_set
+{
+	CBHBitSlice *bits = [CBHBitSlice bitSliceWithCount:1000];
+	XCTAssertEqual([bits firstSetBit], NSNotFound);
+
+	[bits setBitAtIndex:5];
+	[bits setBitAtIndex:700];
+
+	XCTAssertEqual([bits firstSetBit], 5);
+	XCTAssertEqual([bits nextSetBitFromIndex:5], 5);
+	XCTAssertEqual([bits nextSetBitFromIndex:6], 700);
+	XCTAssertEqual([bits nextSetBitFromIndex:701], NSNotFound);
+	XCTAssertEqual([bits nextSetBitFromIndex:5000], NSNotFound);
+}
+
+- (void)testFind_clear
+{
+	CBHBitSlice *bits = [CBHBitSlice bitSliceWithCount:130];
+	[bits setAll];
+	XCTAssertEqual([bits firstClearBit], NSNotFound, @"Bits past the end found.");
+
+	[bits clearBitAtIndex:64];
+	XCTAssertEqual([bits firstClearBit], 64);
+	XCTAssertEqual([bits nextClearBitFromIndex:65], NSNotFound);
+}
+
+
+#pragma mark - Rank and Select
+
+- (void)testRankSelect
+{
+	CBHBitSlice *bits = [CBHBitSlice bitSliceWithCount:5000];
+	for (NSUInteger i = 0; i < 5000; i += 7) { [bits setBitAtIndex:i]; }
+
+	NSUInteger rank = 0;
+	for (NSUInteger i = 0; i < 5000; ++i)
+	{
+		XCTAssertEqual([bits rankAtIndex:i], rank, @"Incorrect rank.");
+		if ( i % 7 != 0 ) continue;
+
+		XCTAssertEqual([bits indexOfSetBitWithRank:rank], i, @"Incorrect select.");
+		++rank;
+	}
+
+	XCTAssertEqual([bits rankAtIndex:5000], rank);
+	XCTAssertEqual([bits indexOfSetBitWithRank:rank], NSNotFound);
+	XCTAssertThrows([bits rankAtIndex:5001], @"Fails to catch out-of-bounds rank.");
+
+	/// Changes are seen by the next query.
+	[bits clearBitAtIndex:0];
+	XCTAssertEqual([bits rankAtIndex:5000], rank - 1);
+	XCTAssertEqual([bits indexOfSetBitWithRank:0], 7);
+}
+
+
+#pragma mark - Bulk Logic
+
+- (void)testBulk_logic
+{
+	CBHBitSlice *a = [CBHBitSlice bitSliceWithCount:1000];
+	CBHBitSlice *b = [CBHBitSlice bitSliceWithCount:1000];
+	[a setBitsInRange:NSMakeRange(0, 600)];
+	[b setBitsInRange:NSMakeRange(400, 600)];
+
+	CBHBitSlice *result = [[a copy] autorelease];
+	[result andWithBitSlice:b];
+	XCTAssertEqual([result popCount], 200);
+	XCTAssertEqual([result firstSetBit], 400);
+
+	result = [[a copy] autorelease];
+	[result orWithBitSlice:b];
+	XCTAssertEqual([result popCount], 1000);
+
+	result = [[a copy] autorelease];
+	[result xorWithBitSlice:b];
+	XCTAssertEqual([result popCount], 800);
+	XCTAssertFalse([result bitAtIndex:500]);
+
+	result = [[a copy] autorelease];
+	[result andNotWithBitSlice:b];
+	XCTAssertEqual([result popCount], 400);
+	XCTAssertEqual([result nextClearBitFromIndex:0], 400);
+
+	XCTAssertEqual([a popCount], 600, @"Copy shares bits.");
+}
+
+- (void)testBulk_differentCounts
+{
+	CBHBitSlice *shorter = [CBHBitSlice bitSliceWithCount:70];
+	CBHBitSlice *longer = [CBHBitSlice bitSliceWithCount:300];
+	[shorter setAll];
+	[longer setAll];
+
+	CBHBitSlice *result = [[longer copy] autorelease];
+	[result andWithBitSlice:shorter];
+	XCTAssertEqual([result count], 300);
+	XCTAssertEqual([result popCount], 70);
+
+	result = [[shorter copy] autorelease];
+	[result orWithBitSlice:longer];
+	XCTAssertEqual([result count], 300);
+	XCTAssertEqual([result popCount], 300);
+
+	result = [[longer copy] autorelease];
+	[result andNotWithBitSlice:shorter];
+	XCTAssertEqual([result popCount], 230);
+}
+
+
+#pragma mark - Equality
+
+- (void)testEquality
+{
+	CBHBitSlice *a = [CBHBitSlice bitSliceWithCount:100];
+	CBHBitSlice *b = [CBHBitSlice bitSliceWithCount:100];
+	[a setBitAtIndex:42];
+	[b setBitAtIndex:42];
+
+	XCTAssertEqualObjects(a, b);
+	XCTAssertEqual([a hash], [b hash]);
+
+	[b appendBit:NO];
+	XCTAssertNotEqualObjects(a, b);
+}
+
+@end
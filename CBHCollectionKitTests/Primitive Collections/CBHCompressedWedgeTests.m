@@ -0,0 +1,185 @@
+//  CBHCompressedWedgeTests.m
+//  CBHCollectionKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import XCTest;
+@import CBHCollectionKit.CBHCompressedWedge;
+@import CBHCollectionKit.CBHWedge;
+@import CBHCollectionKit.CBHSlice;
+
+
+@interface CBHCompressedWedgeTests : XCTestCase
+@end
+
+
+@implementation CBHCompressedWedgeTests
+
+#pragma mark - Initialization
+
+- (void)testInitialization_basic
+{
+	CBHCompressedWedge *wedge = [CBHCompressedWedge compressedWedge];
+	XCTAssertEqual([wedge count], 0);
+	XCTAssertEqual([wedge blockCount], 0);
+	XCTAssertEqual([wedge entrySize], sizeof(uint64_t));
+	XCTAssertTrue([wedge isEmpty]);
+	XCTAssertTrue([wedge isSorted]);
+
+	XCTAssertThrows([wedge uint64AtIndex:0], @"Fails to catch out-of-bounds on access.");
+	XCTAssertThrows([CBHCompressedWedge compressedWedgeWithWedge:[CBHWedge wedgeWithEntrySize:4]], @"Fails to catch invalid entry size.");
+}
+
+
+#pragma mark - Values
+
+- (void)testValues_timestamps
+{
+	CBHCompressedWedge *wedge = [CBHCompressedWedge compressedWedge];
+
+	uint64_t timestamp = 1700000000000;
+	for (NSUInteger i = 0; i < 10000; ++i)
+	{
+		timestamp += (i * 7919) % 1000;
+		[wedge appendUInt64:timestamp];
+	}
+
+	XCTAssertEqual([wedge count], 10000);
+	XCTAssertEqual([wedge blockCount], 79);
+	XCTAssertTrue([wedge isSorted]);
+	XCTAssertLessThan([wedge compressedLength] * 4, 10000 * sizeof(uint64_t), @"Compressed less than 4x.");
+
+	timestamp = 1700000000000;
+	for (NSUInteger i = 0; i < 10000; ++i)
+	{
+		timestamp += (i * 7919) % 1000;
+		XCTAssertEqual([wedge uint64AtIndex:i], timestamp, @"Fails to return correct value at index.");
+	}
+}
+
+- (void)testValues_unsorted
+{
+	uint64_t values[1000];
+	for (NSUInteger i = 0; i < 1000; ++i) { values[i] = 5000000 + ((i * 7919) % 4096); }
+	values[300] = UINT64_MAX;
+
+	CBHCompressedWedge *wedge = [CBHCompressedWedge compressedWedge];
+	[wedge appendValues:values count:1000];
+	XCTAssertFalse([wedge isSorted]);
+
+	/// Reverse order reads every block in place or from the cache.
+	for (NSUInteger i = 1000; i > 0; --i)
+	{
+		XCTAssertEqual([wedge uint64AtIndex:i - 1], values[i - 1], @"Fails to return correct value at index.");
+	}
+
+	XCTAssertThrows([wedge lowerBoundOfValue:5], @"Searches unsorted values.");
+}
+
+
+#pragma mark - Decoding
+
+- (void)testDecoding_ranges
+{
+	uint64_t values[1000];
+	for (NSUInteger i = 0; i < 1000; ++i) { values[i] = i * i; }
+
+	CBHCompressedWedge *wedge = [CBHCompressedWedge compressedWedge];
+	[wedge appendValues:values count:1000];
+
+	uint64_t decoded[1000];
+	[wedge getValues:decoded range:NSMakeRange(0, 1000)];
+	XCTAssertEqual(memcmp(decoded, values, sizeof(values)), 0, @"Fails to decode every value.");
+
+	[wedge getValues:decoded range:NSMakeRange(100, 300)];
+	XCTAssertEqual(memcmp(decoded, values + 100, 300 * sizeof(uint64_t)), 0, @"Fails to decode across blocks.");
+
+	XCTAssertEqual([wedge getValues:decoded ofBlock:7], 1000 - 7 * 128, @"Incorrect length of the last block.");
+	XCTAssertEqual(decoded[0], values[7 * 128]);
+
+	CBHSlice *slice = [wedge sliceInRange:NSMakeRange(990, 10)];
+	XCTAssertEqual([slice capacity], 10);
+	XCTAssertEqual(*(const uint64_t *)[slice valueAtIndex:9], values[999]);
+
+	XCTAssertEqual([[wedge slice] capacity], 1000);
+	XCTAssertThrows([wedge getValues:decoded range:NSMakeRange(999, 2)], @"Fails to catch out-of-bounds range.");
+}
+
+
+#pragma mark - Searching
+
+- (void)testSearching_lowerBound
+{
+	CBHCompressedWedge *wedge = [CBHCompressedWedge compressedWedge];
+	for (uint64_t i = 0; i < 1000; ++i) { [wedge appendUInt64:(i / 2) * 10]; }
+
+	XCTAssertEqual([wedge lowerBoundOfValue:0], 0);
+	XCTAssertEqual([wedge lowerBoundOfValue:10], 2);
+	XCTAssertEqual([wedge lowerBoundOfValue:11], 4);
+	XCTAssertEqual([wedge lowerBoundOfValue:640], 128, @"Fails at a block boundary.");
+	XCTAssertEqual([wedge lowerBoundOfValue:4980], 996, @"Fails in the tail.");
+	XCTAssertEqual([wedge lowerBoundOfValue:5000], 1000);
+}
+
+- (void)testSearching_lowerBoundRaw
+{
+	/// The gap leaves the second block too wide to pack, so it is stored raw.
+	CBHCompressedWedge *wedge = [CBHCompressedWedge compressedWedge];
+	for (uint64_t i = 0; i < 400; ++i) { [wedge appendUInt64:( i < 200 ) ? i : ((uint64_t)1 << 40) + i]; }
+	XCTAssertTrue([wedge isSorted]);
+
+	XCTAssertEqual([wedge lowerBoundOfValue:100], 100, @"Fails before a raw block.");
+	XCTAssertEqual([wedge lowerBoundOfValue:150], 150, @"Fails in a raw block.");
+	XCTAssertEqual([wedge lowerBoundOfValue:(uint64_t)1 << 40], 200, @"Fails across the gap.");
+	XCTAssertEqual([wedge lowerBoundOfValue:((uint64_t)1 << 40) + 300], 300, @"Fails after a raw block.");
+}
+
+
+#pragma mark - Equality
+
+- (void)testEquality
+{
+	CBHCompressedWedge *a = [CBHCompressedWedge compressedWedge];
+	CBHCompressedWedge *b = [CBHCompressedWedge compressedWedge];
+	for (uint64_t i = 0; i < 300; ++i)
+	{
+		[a appendUInt64:i * 3];
+		[b appendUInt64:i * 3];
+	}
+
+	XCTAssertEqualObjects(a, b);
+	XCTAssertEqual([a hash], [b hash]);
+
+	/// Every value is hashed, not only the ends.
+	CBHCompressedWedge *c = [CBHCompressedWedge compressedWedge];
+	for (uint64_t i = 0; i < 300; ++i) { [c appendUInt64:( i == 100 ) ? 301 : i * 3]; }
+	XCTAssertNotEqualObjects(a, c);
+	XCTAssertNotEqual([a hash], [c hash]);
+
+	CBHCompressedWedge *copy = [[a copy] autorelease];
+	XCTAssertEqualObjects(a, copy);
+
+	[copy appendUInt64:1];
+	XCTAssertNotEqualObjects(a, copy);
+	XCTAssertFalse([copy isSorted]);
+	XCTAssertTrue([a isSorted]);
+
+	[copy removeAll];
+	XCTAssertTrue([copy isEmpty]);
+	XCTAssertEqual([a count], 300, @"Copy shares values.");
+}
+
+@end
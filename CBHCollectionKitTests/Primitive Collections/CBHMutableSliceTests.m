@@ -22,6 +22,31 @@
 #import "CBHSliceTestMacros.h"
 
 
+static NSComparisonResult CBHCompareDescending(const void *a, const void *b, void *context)
+{
+	NSInteger lhs = *(const NSInteger *)a;
+	NSInteger rhs = *(const NSInteger *)b;
+
+	if ( lhs > rhs ) return NSOrderedAscending;
+	if ( lhs < rhs ) return NSOrderedDescending;
+	return NSOrderedSame;
+}
+
+static void CBHDouble(void *entries, NSUInteger count, void *context)
+{
+	NSUInteger *values = (NSUInteger *)entries;
+	for (NSUInteger i = 0; i < count; ++i) { values[i] *= 2; }
+}
+
+static void CBHSum(void *accumulator, const void *entries, NSUInteger count, void *context)
+{
+	const NSUInteger *values = (const NSUInteger *)entries;
+	NSUInteger sum = *(NSUInteger *)accumulator;
+	for (NSUInteger i = 0; i < count; ++i) { sum += values[i]; }
+	*(NSUInteger *)accumulator = sum;
+}
+
+
 @interface CBHMutableSliceTests : XCTestCase
 @end
 
@@ -65,6 +90,26 @@
 	XCTAssertNotEqualObjects(slice, copy);
 }
 
+- (void)test_copy_sharesBytes
+{
+	CBHMutableSliceCreateDefault(slice, NSUInteger);
+
+	CBHSlice *copy = [[slice copy] autorelease];
+	CBHMutableSlice *mutableCopy = [[slice mutableCopy] autorelease];
+	XCTAssertEqual([copy bytes], [slice bytes], @"Fails to share bytes with copy.");
+	XCTAssertEqual([mutableCopy bytes], [slice bytes], @"Fails to share bytes with mutable copy.");
+
+	[slice setUnsignedInteger:8 atIndex:4];
+	XCTAssertNotEqual([copy bytes], [slice bytes], @"Fails to separate bytes on write.");
+	XCTAssertEqual([copy unsignedIntegerAtIndex:4], 4, @"Write is visible through copy.");
+	XCTAssertEqual([mutableCopy unsignedIntegerAtIndex:4], 4, @"Write is visible through mutable copy.");
+
+	[mutableCopy setUnsignedInteger:9 atIndex:5];
+	XCTAssertNotEqual([copy bytes], [mutableCopy bytes], @"Fails to separate bytes on write.");
+	XCTAssertEqual([copy unsignedIntegerAtIndex:5], 5, @"Write is visible through copy.");
+	XCTAssertEqual([slice unsignedIntegerAtIndex:5], 5, @"Write is visible through original.");
+}
+
 @end
 
 
@@ -184,6 +229,26 @@
 	XCTAssertThrows([slice resize:NSUIntegerMax], @"Did not catch overflow");
 }
 
+- (void)test_resize_keepsAlignment
+{
+	CBHAllocationOptions options = CBHAllocationOptionsMake(256, CBHAllocationFlagsNone);
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(NSUInteger) andCapacity:8 options:options];
+	CBHAssertSliceState(slice, 8, NSUInteger, NO);
+	XCTAssertEqual((uintptr_t)[slice bytes] % 256, 0, @"Buffer is not aligned.");
+
+	for (NSUInteger i = 0; i < 8; ++i) XCTAssertEqual([slice unsignedIntegerAtIndex:i], 0, @"Entry is not cleared at index %lu.", i);
+	for (NSUInteger i = 0; i < 8; ++i) [slice setUnsignedInteger:i atIndex:i];
+
+	[slice resize:1000 andClear:YES];
+	XCTAssertEqual((uintptr_t)[slice bytes] % 256, 0, @"Growth loses alignment.");
+	for (NSUInteger i = 0; i < 8; ++i) XCTAssertEqual([slice unsignedIntegerAtIndex:i], i, @"Entry is incorrectly set.");
+	for (NSUInteger i = 8; i < 1000; ++i) XCTAssertEqual([slice unsignedIntegerAtIndex:i], 0, @"Entry is incorrectly set at index %lu.", i);
+
+	[slice resize:4];
+	XCTAssertEqual((uintptr_t)[slice bytes] % 256, 0, @"Shrinking loses alignment.");
+	XCTAssertEqual([slice allocationOptions].alignment, 256, @"Fails to keep options.");
+}
+
 @end
 
 
@@ -279,3 +344,355 @@
 }
 
 @end
+
+
+@implementation CBHMutableSliceTests (Sorting)
+
+- (void)test_sortUnsigned
+{
+	const NSUInteger count = 10000;
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(NSUInteger) andCapacity:count];
+
+	for (NSUInteger i = 0; i < count; ++i) { [slice setUnsignedInteger:(i * 7919) % count atIndex:i]; }
+
+	[slice sortAsType:CBHPrimitiveTypeUnsigned];
+
+	/// Check new values
+	for (NSUInteger i = 0; i < count; ++i)
+	{
+		XCTAssertEqual([slice unsignedIntegerAtIndex:i], i, @"Fails to return correct value at index.");
+	}
+}
+
+- (void)test_sortSigned
+{
+	const NSInteger list[] = {3, -1, 0, NSIntegerMin, 7, -42, NSIntegerMax, 3};
+	const NSInteger expected[] = {NSIntegerMin, -42, -1, 0, 3, 3, 7, NSIntegerMax};
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(NSInteger) copying:8 entriesFromBytes:list];
+
+	[slice sortAsType:CBHPrimitiveTypeSigned];
+
+	/// Check new values
+	for (NSUInteger i = 0; i < 8; ++i)
+	{
+		XCTAssertEqual([slice integerAtIndex:i], expected[i], @"Fails to return correct value at index.");
+	}
+}
+
+- (void)test_sortFloat
+{
+	const double list[] = {2.5, -0.5, 0.0, -INFINITY, 1e-300, -1e300, INFINITY, -2.5};
+	const double expected[] = {-INFINITY, -1e300, -2.5, -0.5, 0.0, 1e-300, 2.5, INFINITY};
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(double) copying:8 entriesFromBytes:list];
+
+	[slice sortAsType:CBHPrimitiveTypeFloat];
+
+	/// Check new values
+	for (NSUInteger i = 0; i < 8; ++i)
+	{
+		XCTAssertEqual([slice doubleAtIndex:i], expected[i], @"Fails to return correct value at index.");
+	}
+}
+
+- (void)test_sortByKey
+{
+	typedef struct { uint32_t identifier; int16_t key; } CBHRecord;
+
+	const NSUInteger count = 1000;
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(CBHRecord) andCapacity:count shouldClear:YES];
+
+	for (NSUInteger i = 0; i < count; ++i)
+	{
+		CBHRecord record = {(uint32_t)i, (int16_t)(500 - (NSInteger)i)};
+		[slice setValue:&record atIndex:i];
+	}
+
+	[slice sortByKeyAtOffset:offsetof(CBHRecord, key) ofSize:sizeof(int16_t) asType:CBHPrimitiveTypeSigned];
+
+	/// Check new values
+	for (NSUInteger i = 0; i < count; ++i)
+	{
+		const CBHRecord *record = (const CBHRecord *)[slice valueAtIndex:i];
+		XCTAssertEqual(record->identifier, (uint32_t)(count - 1 - i), @"Fails to return correct value at index.");
+	}
+}
+
+- (void)test_sortByKey_invalid
+{
+	CBHMutableSliceCreateDefault(slice, NSUInteger);
+
+	XCTAssertThrows([slice sortByKeyAtOffset:0 ofSize:3 asType:CBHPrimitiveTypeUnsigned], @"Fails to catch invalid key size.");
+	XCTAssertThrows([slice sortByKeyAtOffset:0 ofSize:2 asType:CBHPrimitiveTypeFloat], @"Fails to catch invalid key size.");
+	XCTAssertThrows([slice sortByKeyAtOffset:4 ofSize:8 asType:CBHPrimitiveTypeUnsigned], @"Fails to catch out-of-bounds key.");
+
+	CBHAssertSliceDefault(slice, NSUInteger, unsignedInteger);
+}
+
+- (void)test_sortUsingFunction
+{
+	const NSUInteger count = 10000;
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(NSInteger) andCapacity:count];
+
+	for (NSUInteger i = 0; i < count; ++i) { [slice setInteger:(NSInteger)((i * 7919) % 100) - 50 atIndex:i]; }
+
+	[slice sortUsingFunction:CBHCompareDescending context:NULL];
+
+	/// Check new values
+	for (NSUInteger i = 1; i < count; ++i)
+	{
+		XCTAssertGreaterThanOrEqual([slice integerAtIndex:i - 1], [slice integerAtIndex:i], @"Fails to sort values.");
+	}
+}
+
+- (void)test_sortUnsigned_parallel
+{
+	/// Large enough to sort buckets concurrently.
+	const NSUInteger count = 1 << 18;
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(NSUInteger) andCapacity:count];
+
+	for (NSUInteger i = 0; i < count; ++i) { [slice setUnsignedInteger:(i * 7919) % count atIndex:i]; }
+
+	[slice sortAsType:CBHPrimitiveTypeUnsigned];
+
+	/// Check new values
+	NSUInteger misplaced = 0;
+	for (NSUInteger i = 0; i < count; ++i) { if ( [slice unsignedIntegerAtIndex:i] != i ) { ++misplaced; } }
+	XCTAssertEqual(misplaced, 0, @"Fails to sort values.");
+}
+
+- (void)test_sortFloat_parallel
+{
+	/// Large enough to use radix passes, and to sort buckets concurrently, over negatives, signed zeros and NaNs.
+	const NSUInteger count = 1 << 17;
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(double) andCapacity:count];
+
+	for (NSUInteger i = 0; i < count; ++i)
+	{
+		double value = 0.0;
+		switch ( (i * 7919) % 7 )
+		{
+			case 0: value = -(double)i * 0.25; break;
+			case 1: value = (double)i * 1.5; break;
+			case 2: value = -0.0; break;
+			case 3: value = 0.0; break;
+			case 4: value = NAN; break;
+			case 5: value = copysign(NAN, -1.0); break;
+			default: value = ( i & 1 ) ? -INFINITY : INFINITY; break;
+		}
+		[slice setDouble:value atIndex:i];
+	}
+
+	[slice sortAsType:CBHPrimitiveTypeFloat];
+
+	/// Negative NaNs come first and positive NaNs last, everything between is ascending with -0.0 before +0.0.
+	NSUInteger first = 0;
+	while ( first < count && isnan([slice doubleAtIndex:first]) ) { XCTAssertTrue(signbit([slice doubleAtIndex:first]), @"Positive NaN sorted first."); ++first; }
+
+	NSUInteger last = count;
+	while ( last > first && isnan([slice doubleAtIndex:last - 1]) ) { XCTAssertFalse(signbit([slice doubleAtIndex:last - 1]), @"Negative NaN sorted last."); --last; }
+
+	XCTAssertGreaterThan(first, 0, @"Fails to sort negative NaNs first.");
+	XCTAssertLessThan(last, count, @"Fails to sort positive NaNs last.");
+
+	NSUInteger misordered = 0;
+	for (NSUInteger i = first + 1; i < last; ++i)
+	{
+		const double previous = [slice doubleAtIndex:i - 1];
+		const double current = [slice doubleAtIndex:i];
+
+		if ( isnan(current) || previous > current ) { ++misordered; }
+		else if ( previous == 0.0 && current == 0.0 && !signbit(previous) && signbit(current) ) { ++misordered; }
+	}
+	XCTAssertEqual(misordered, 0, @"Fails to sort values.");
+}
+
+- (void)test_sortUsingFunction_parallel
+{
+	/// Large enough to sort partitions concurrently.
+	const NSUInteger count = 1 << 18;
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(NSInteger) andCapacity:count];
+
+	for (NSUInteger i = 0; i < count; ++i) { [slice setInteger:(NSInteger)((i * 7919) % count) atIndex:i]; }
+
+	[slice sortUsingFunction:CBHCompareDescending context:NULL];
+
+	/// Check new values
+	NSUInteger misplaced = 0;
+	for (NSUInteger i = 0; i < count; ++i) { if ( [slice integerAtIndex:i] != (NSInteger)(count - 1 - i) ) { ++misplaced; } }
+	XCTAssertEqual(misplaced, 0, @"Fails to sort values.");
+}
+
+@end
+
+
+@implementation CBHMutableSliceTests (ParallelOperations)
+
+- (void)test_fill
+{
+	const uint8_t pattern[3] = {1, 2, 3};
+	const NSUInteger count = 1000003;
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(pattern) andCapacity:count];
+
+	[slice fillWithValue:pattern];
+
+	/// Check new values
+	for (NSUInteger i = 0; i < count; i += 997)
+	{
+		XCTAssertEqual(memcmp([slice valueAtIndex:i], pattern, sizeof(pattern)), 0, @"Fails to fill value at index.");
+	}
+	XCTAssertEqual(memcmp([slice valueAtIndex:count - 1], pattern, sizeof(pattern)), 0, @"Fails to fill last index.");
+}
+
+- (void)test_transformAndReduce
+{
+	const NSUInteger count = 1 << 20;
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(NSUInteger) andCapacity:count];
+	for (NSUInteger i = 0; i < count; ++i) { [slice setUnsignedInteger:i atIndex:i]; }
+
+	[slice transformUsingFunction:CBHDouble context:NULL];
+	XCTAssertEqual([slice unsignedIntegerAtIndex:count - 1], (count - 1) * 2, @"Fails to transform value at index.");
+
+	const NSUInteger identity = 0;
+	NSUInteger sum = 42;
+	[slice reduceUsingFunction:CBHSum identity:&identity context:NULL result:&sum];
+	XCTAssertEqual(sum, count * (count - 1), @"Fails to reduce values.");
+}
+
+- (void)test_forEachChunk
+{
+	const NSUInteger count = 1 << 20;
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(NSUInteger) andCapacity:count];
+	for (NSUInteger i = 0; i < count; ++i) { [slice setUnsignedInteger:i atIndex:i]; }
+
+	__block NSUInteger visited = 0;
+	__block BOOL isConsistent = YES;
+	NSLock *lock = [[NSLock alloc] init];
+
+	[slice forEachChunk:^(const void *entries, NSRange range) {
+		const NSUInteger *values = (const NSUInteger *)entries;
+		const BOOL matches = ( values[0] == range.location && values[range.length - 1] == NSMaxRange(range) - 1 );
+
+		[lock lock];
+		visited += range.length;
+		isConsistent = isConsistent && matches;
+		[lock unlock];
+	}];
+
+	[lock release];
+
+	XCTAssertEqual(visited, count, @"Fails to visit every entry.");
+	XCTAssertTrue(isConsistent, @"Fails to pass entries matching the range.");
+}
+
+@end
+
+
+@implementation CBHMutableSliceTests (UnsafeAccess)
+
+- (void)test_unsafeMutableBytes
+{
+	CBHMutableSliceCreateDefault(slice, NSUInteger);
+
+	[slice withUnsafeMutableBytes:^(CBHMutableSliceView view) {
+		NSUInteger *values = CBHMutableSliceView_entries(view, NSUInteger);
+		for (NSUInteger i = 0; i < view.count; ++i) { values[i] *= 2; }
+	}];
+
+	/// Check new values
+	for (NSUInteger i = 0; i < 8; ++i)
+	{
+		XCTAssertEqual([slice unsignedIntegerAtIndex:i], i * 2, @"Fails to return correct value at index.");
+	}
+}
+
+- (void)test_unsafeMutableBytes_resized
+{
+	CBHMutableSliceCreateDefault(slice, NSUInteger);
+
+	[slice withUnsafeMutableBytes:^(CBHMutableSliceView view) {
+		XCTAssertTrue(CBHMutableSliceView_isValid(view));
+
+		[slice resize:1024];
+		XCTAssertFalse(CBHMutableSliceView_isValid(view), @"Fails to detect resize.");
+
+#if DEBUG
+		XCTAssertThrows(CBHMutableSliceView_valueAtIndex(view, 0), @"Fails to catch stale view.");
+#endif
+	}];
+}
+
+@end
+
+
+@implementation CBHMutableSliceTests (Adopting)
+
+- (void)test_adoptingMutableData
+{
+	const NSUInteger list[] = {0, 1, 2, 3, 4, 5, 6, 7};
+	NSMutableData *data = [NSMutableData dataWithBytes:list length:sizeof(list)];
+
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(NSUInteger) adoptingData:data];
+	CBHAssertSliceState(slice, 8, NSUInteger, NO);
+
+	/// Writes go through to the data.
+	[slice setUnsignedInteger:42 atIndex:3];
+	XCTAssertEqual(((const NSUInteger *)[data bytes])[3], 42, @"Fails to write through.");
+
+	/// Resizing detaches from the data.
+	[slice resize:16];
+	[slice setUnsignedInteger:7 atIndex:3];
+	XCTAssertEqual(((const NSUInteger *)[data bytes])[3], 42, @"Fails to detach on resize.");
+	XCTAssertEqual([slice unsignedIntegerAtIndex:2], 2, @"Fails to preserve values on resize.");
+}
+
+- (void)test_adoptingImmutableData
+{
+	const NSUInteger list[] = {0, 1, 2, 3, 4, 5, 6, 7};
+	NSData *data = [NSData dataWithBytes:list length:sizeof(list)];
+
+	CBHMutableSlice *slice = [CBHMutableSlice sliceWithEntrySize:sizeof(NSUInteger) adoptingData:data];
+	[slice setUnsignedInteger:42 atIndex:3];
+
+	XCTAssertEqual(((const NSUInteger *)[data bytes])[3], 3, @"Fails to copy immutable data.");
+}
+
+@end
+
+
+@implementation CBHMutableSliceTests (Files)
+
+- (void)test_file_writeThrough
+{
+	CBHMutableSliceCreateDefault(slice, NSUInteger);
+	NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+	XCTAssertTrue([slice writeToFile:path options:CBHSliceFileHeader error:NULL], @"Fails to write file.");
+
+	NSError *error = nil;
+	CBHMutableSlice *mapped = [[[CBHMutableSlice alloc] initWithContentsOfFile:path entrySize:sizeof(NSUInteger) options:CBHSliceFileHeader error:&error] autorelease];
+	XCTAssertNotNil(mapped, @"Fails to map file: %@", error);
+	CBHAssertSliceDefault(mapped, NSUInteger, unsignedInteger);
+
+	/// Writes go through to the file.
+	[mapped setUnsignedInteger:42 atIndex:3];
+	XCTAssertTrue([mapped syncRange:NSMakeRange(3, 1)], @"Fails to sync range.");
+	XCTAssertTrue([mapped sync], @"Fails to sync.");
+	XCTAssertThrows([mapped syncRange:NSMakeRange(4, 8)], @"Fails to catch out-of-bounds range.");
+
+	CBHSlice *reread = [CBHSlice sliceWithContentsOfFile:path entrySize:sizeof(NSUInteger) options:CBHSliceFileHeader];
+	XCTAssertEqual([reread unsignedIntegerAtIndex:3], 42, @"Fails to write through.");
+
+	/// Copies don't write through.
+	CBHMutableSlice *copy = [[mapped mutableCopy] autorelease];
+	[copy setUnsignedInteger:7 atIndex:3];
+	XCTAssertEqual([reread unsignedIntegerAtIndex:3], 42, @"Copy writes through.");
+
+	/// Resizing detaches from the file.
+	[mapped resize:16];
+	[mapped setUnsignedInteger:7 atIndex:3];
+	XCTAssertFalse([mapped sync], @"Syncs a detached slice.");
+	XCTAssertEqual([reread unsignedIntegerAtIndex:3], 42, @"Fails to detach on resize.");
+
+	[[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+@end
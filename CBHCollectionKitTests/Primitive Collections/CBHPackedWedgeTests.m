@@ -0,0 +1,179 @@
+//  CBHPackedWedgeTests.m
+//  CBHCollectionKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import XCTest;
+@import CBHCollectionKit.CBHPackedWedge;
+@import CBHCollectionKit.CBHWedge;
+
+
+@interface CBHPackedWedgeTests : XCTestCase
+@end
+
+
+@implementation CBHPackedWedgeTests
+
+#pragma mark - Initialization
+
+- (void)testInitialization_basic
+{
+	CBHPackedWedge *wedge = [CBHPackedWedge packedWedgeWithBitWidth:12];
+	XCTAssertEqual([wedge count], 0);
+	XCTAssertGreaterThanOrEqual([wedge capacity], 64);
+	XCTAssertEqual([wedge entrySize], sizeof(uint64_t));
+	XCTAssertEqual([wedge bitWidth], 12);
+	XCTAssertTrue([wedge isEmpty]);
+
+	XCTAssertThrows([wedge uint64AtIndex:0], @"Fails to catch out-of-bounds on access.");
+	XCTAssertThrows([CBHPackedWedge packedWedgeWithBitWidth:0], @"Fails to catch invalid width.");
+	XCTAssertThrows([CBHPackedWedge packedWedgeWithBitWidth:65], @"Fails to catch invalid width.");
+}
+
+- (void)testInitialization_wedge
+{
+	CBHWedge *source = [CBHWedge wedgeWithEntrySize:sizeof(uint32_t)];
+	for (uint32_t i = 0; i < 1000; ++i) { [source appendUInt32:i * 1000]; }
+
+	CBHPackedWedge *wedge = [CBHPackedWedge packedWedgeWithWedge:source];
+	XCTAssertEqual([wedge count], 1000);
+	XCTAssertEqual([wedge bitWidth], 20, @"Not packed to the widest value.");
+
+	for (NSUInteger i = 0; i < 1000; ++i)
+	{
+		XCTAssertEqual([wedge uint64AtIndex:i], (uint64_t)i * 1000, @"Fails to return correct value at index.");
+	}
+}
+
+
+#pragma mark - Values
+
+- (void)testValues_everyWidth
+{
+	for (NSUInteger width = 1; width <= 64; ++width)
+	{
+		const uint64_t mask = ~(uint64_t)0 >> (64 - width);
+		CBHPackedWedge *wedge = [CBHPackedWedge packedWedgeWithBitWidth:width andCapacity:1];
+
+		for (uint64_t i = 0; i < 300; ++i) { [wedge appendUInt64:(i * 0x9E3779B97F4A7C15) & mask]; }
+		XCTAssertEqual([wedge bitWidth], width, @"Widened needlessly.");
+
+		for (uint64_t i = 0; i < 300; ++i)
+		{
+			XCTAssertEqual([wedge uint64AtIndex:(NSUInteger)i], (i * 0x9E3779B97F4A7C15) & mask, @"Fails to return correct value at width %lu.", (unsigned long)width);
+		}
+	}
+}
+
+- (void)testValues_set
+{
+	CBHPackedWedge *wedge = [CBHPackedWedge packedWedgeWithBitWidth:7];
+	for (NSUInteger i = 0; i < 100; ++i) { [wedge appendUInt64:i]; }
+
+	[wedge setUInt64:127 atIndex:9];
+	[wedge setUInt64:0 atIndex:10];
+	[wedge setUInt64:55 atIndex:100];
+
+	XCTAssertEqual([wedge uint64AtIndex:8], 8);
+	XCTAssertEqual([wedge uint64AtIndex:9], 127);
+	XCTAssertEqual([wedge uint64AtIndex:10], 0);
+	XCTAssertEqual([wedge uint64AtIndex:11], 11);
+	XCTAssertEqual([wedge uint64AtIndex:100], 55, @"Fails to append at the end.");
+
+	XCTAssertThrows([wedge setUInt64:1 atIndex:102], @"Fails to catch out-of-bounds on write.");
+}
+
+- (void)testValues_widen
+{
+	CBHPackedWedge *wedge = [CBHPackedWedge packedWedgeWithBitWidth:4];
+	for (NSUInteger i = 0; i < 100; ++i) { [wedge appendUInt64:i % 16]; }
+
+	[wedge appendUInt64:1 << 20];
+	XCTAssertEqual([wedge bitWidth], 21);
+
+	[wedge setUInt64:UINT64_MAX atIndex:50];
+	XCTAssertEqual([wedge bitWidth], 64);
+
+	for (NSUInteger i = 0; i < 100; ++i)
+	{
+		if ( i == 50 ) continue;
+		XCTAssertEqual([wedge uint64AtIndex:i], i % 16, @"Value lost when widening.");
+	}
+
+	XCTAssertEqual([wedge uint64AtIndex:50], UINT64_MAX);
+	XCTAssertEqual([wedge uint64AtIndex:100], 1 << 20);
+}
+
+
+#pragma mark - Bulk
+
+- (void)testBulk_roundTrip
+{
+	uint16_t values[1000];
+	for (NSUInteger i = 0; i < 1000; ++i) { values[i] = (uint16_t)((i * 37) % 4096); }
+
+	CBHPackedWedge *wedge = [CBHPackedWedge packedWedgeWithBitWidth:1];
+	[wedge appendValues:values count:500 entrySize:sizeof(uint16_t)];
+	[wedge appendValues:values + 500 count:500 entrySize:sizeof(uint16_t)];
+	XCTAssertEqual([wedge bitWidth], 12);
+
+	uint32_t unpacked[1000];
+	[wedge getValues:unpacked range:NSMakeRange(0, 1000) entrySize:sizeof(uint32_t)];
+	for (NSUInteger i = 0; i < 1000; ++i) { XCTAssertEqual(unpacked[i], values[i], @"Fails to unpack."); }
+
+	CBHWedge *unpackedWedge = [wedge wedgeWithEntrySize:sizeof(uint16_t)];
+	XCTAssertEqual([unpackedWedge count], 1000);
+	XCTAssertEqual(memcmp([unpackedWedge bytes], values, sizeof(values)), 0, @"Fails to unpack into a wedge.");
+
+	XCTAssertThrows([wedge wedgeWithEntrySize:sizeof(uint8_t)], @"Fails to catch narrow entries.");
+	XCTAssertThrows([wedge getValues:unpacked range:NSMakeRange(999, 2) entrySize:sizeof(uint32_t)], @"Fails to catch out-of-bounds range.");
+	XCTAssertThrows([wedge appendValues:values count:1 entrySize:3], @"Fails to catch invalid entry size.");
+}
+
+
+#pragma mark - Equality
+
+- (void)testEquality
+{
+	CBHPackedWedge *a = [CBHPackedWedge packedWedgeWithBitWidth:5];
+	CBHPackedWedge *b = [CBHPackedWedge packedWedgeWithBitWidth:9];
+	for (NSUInteger i = 0; i < 20; ++i)
+	{
+		[a appendUInt64:i];
+		[b appendUInt64:i];
+	}
+
+	XCTAssertEqualObjects(a, b, @"Widths matter to equality.");
+	XCTAssertEqual([a hash], [b hash]);
+	XCTAssertEqualObjects(a, [[a copy] autorelease]);
+
+	/// Removed values do not matter.
+	CBHPackedWedge *c = [[a copy] autorelease];
+	[c appendUInt64:31];
+	[c removeLast:1];
+	XCTAssertEqualObjects(a, c);
+
+	XCTAssertEqual([a hash], [c hash]);
+
+	/// Every value is hashed, not only the ends.
+	[c setUInt64:30 atIndex:5];
+	XCTAssertNotEqual([a hash], [c hash]);
+
+	[c setUInt64:30 atIndex:0];
+	XCTAssertNotEqualObjects(a, c);
+}
+
+@end
@@ -0,0 +1,167 @@
+//  CBHPrimitiveHashMapTests.m
+//  CBHCollectionKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import XCTest;
+@import CBHCollectionKit.CBHPrimitiveHashMap;
+@import CBHCollectionKit.CBHWedge;
+
+
+@interface CBHPrimitiveHashMapTests : XCTestCase
+@end
+
+
+@implementation CBHPrimitiveHashMapTests
+
+#pragma mark - Initialization
+
+- (void)testInitialization_basic
+{
+	CBHPrimitiveHashMap *map = [CBHPrimitiveHashMap hashMapWithKeySize:sizeof(uint32_t) valueSize:sizeof(double)];
+	XCTAssertEqual([map count], 0);
+	XCTAssertEqual([map keySize], sizeof(uint32_t));
+	XCTAssertEqual([map valueSize], sizeof(double));
+	XCTAssertTrue([map isEmpty]);
+
+	const uint32_t key = 3;
+	XCTAssertFalse([map containsKey:&key]);
+	XCTAssertTrue([map valueAtKey:&key] == NULL);
+
+	XCTAssertThrows([CBHPrimitiveHashMap hashMapWithKeySize:4 valueSize:0], @"Fails to catch invalid value size.");
+}
+
+
+#pragma mark - Accessors
+
+- (void)testAccessors_setAndGet
+{
+	CBHPrimitiveHashMap *map = [CBHPrimitiveHashMap hashMapWithKeySize:sizeof(uint64_t) valueSize:sizeof(double)];
+
+	for (uint64_t i = 0; i < 50000; ++i)
+	{
+		const double value = (double)i * 0.25;
+		[map setValue:&value atKey:&i];
+	}
+
+	XCTAssertEqual([map count], 50000);
+
+	const uint64_t key = 1234;
+	XCTAssertEqual(*(const double *)[map valueAtKey:&key], 308.5);
+
+	const double replacement = -1.0;
+	[map setValue:&replacement atKey:&key];
+	XCTAssertEqual([map count], 50000, @"Replacing a value adds an entry.");
+	XCTAssertEqual(*(const double *)[map valueAtKey:&key], -1.0);
+
+	for (uint64_t i = 0; i < 50000; i += 3) { XCTAssertTrue([map removeValueAtKey:&i]); }
+
+	const uint64_t removed = 0;
+	XCTAssertFalse([map removeValueAtKey:&removed]);
+	XCTAssertEqual([map count], 50000 - 16667);
+
+	for (uint64_t i = 1; i < 50000; i += 3)
+	{
+		XCTAssertEqual(*(const double *)[map valueAtKey:&i], ( i == 1234 ) ? -1.0 : (double)i * 0.25, @"Value moved with the wrong key.");
+	}
+}
+
+- (void)testAccessors_batch
+{
+	CBHPrimitiveHashMap *map = [CBHPrimitiveHashMap hashMapWithKeySize:sizeof(uint32_t) valueSize:sizeof(uint32_t)];
+	for (uint32_t i = 0; i < 1000; i += 2)
+	{
+		const uint32_t value = i * 10;
+		[map setValue:&value atKey:&i];
+	}
+
+	uint32_t keys[1000];
+	uint32_t values[1000];
+	BOOL found[1000];
+	for (uint32_t i = 0; i < 1000; ++i) { keys[i] = i; values[i] = UINT32_MAX; }
+
+	XCTAssertEqual([map getValues:values atKeys:keys count:1000 found:found], 500);
+
+	for (uint32_t i = 0; i < 1000; ++i)
+	{
+		XCTAssertEqual(found[i], (BOOL)(i % 2 == 0));
+		XCTAssertEqual(values[i], ( i % 2 == 0 ) ? i * 10 : UINT32_MAX);
+	}
+}
+
+
+#pragma mark - Conversion
+
+- (void)testConversion_wedges
+{
+	CBHPrimitiveHashMap *map = [CBHPrimitiveHashMap hashMapWithKeySize:sizeof(uint32_t) valueSize:sizeof(uint64_t)];
+	for (uint32_t i = 0; i < 300; ++i)
+	{
+		const uint64_t value = (uint64_t)i << 32;
+		[map setValue:&value atKey:&i];
+	}
+
+	CBHWedge *keys = [map keyWedge];
+	CBHWedge *values = [map valueWedge];
+	XCTAssertEqual([keys count], 300);
+	XCTAssertEqual([values count], 300);
+
+	for (NSUInteger i = 0; i < 300; ++i)
+	{
+		XCTAssertEqual([values uint64AtIndex:i], (uint64_t)[keys uint32AtIndex:i] << 32, @"Keys and values are out of step.");
+	}
+}
+
+
+#pragma mark - Copying and Equality
+
+- (void)testCopying_basic
+{
+	CBHPrimitiveHashMap *map = [CBHPrimitiveHashMap hashMapWithKeySize:sizeof(uint32_t) valueSize:sizeof(uint32_t)];
+	for (uint32_t i = 0; i < 100; ++i) { [map setValue:&i atKey:&i]; }
+
+	CBHPrimitiveHashMap *copy = [map copy];
+	XCTAssertEqualObjects(map, copy);
+
+	const uint32_t key = 10;
+	const uint32_t value = 11;
+	[copy setValue:&value atKey:&key];
+
+	XCTAssertEqual(*(const uint32_t *)[map valueAtKey:&key], 10, @"Original changed with the copy.");
+	XCTAssertNotEqualObjects(map, copy);
+
+	[copy release];
+}
+
+- (void)testEquality_hash
+{
+	CBHPrimitiveHashMap *map = [CBHPrimitiveHashMap hashMapWithKeySize:sizeof(uint32_t) valueSize:sizeof(uint32_t)];
+	for (uint32_t i = 0; i < 100; ++i) { [map setValue:&i atKey:&i]; }
+
+	/// The same entries added in another order land in other slots but hash the same.
+	CBHPrimitiveHashMap *reversed = [CBHPrimitiveHashMap hashMapWithKeySize:sizeof(uint32_t) valueSize:sizeof(uint32_t) andCapacity:5000];
+	for (uint32_t i = 100; i > 0; --i) { const uint32_t key = i - 1; [reversed setValue:&key atKey:&key]; }
+	XCTAssertEqualObjects(map, reversed);
+	XCTAssertEqual([map hash], [reversed hash], @"Equal maps hash differently.");
+
+	/// Equal sizes and counts, but one value differs.
+	const uint32_t key = 10;
+	const uint32_t value = 11;
+	[reversed setValue:&value atKey:&key];
+	XCTAssertNotEqual([map hash], [reversed hash], @"Ignores the entries.");
+}
+
+@end
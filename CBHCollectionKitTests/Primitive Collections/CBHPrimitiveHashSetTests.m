@@ -0,0 +1,172 @@
+//  CBHPrimitiveHashSetTests.m
+//  CBHCollectionKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import XCTest;
+@import CBHCollectionKit.CBHPrimitiveHashSet;
+@import CBHCollectionKit.CBHWedge;
+
+
+@interface CBHPrimitiveHashSetTests : XCTestCase
+@end
+
+
+@implementation CBHPrimitiveHashSetTests
+
+#pragma mark - Initialization
+
+- (void)testInitialization_basic
+{
+	CBHPrimitiveHashSet *set = [CBHPrimitiveHashSet hashSetWithEntrySize:sizeof(uint64_t)];
+	XCTAssertEqual([set count], 0);
+	XCTAssertEqual([set entrySize], sizeof(uint64_t));
+	XCTAssertGreaterThanOrEqual([set capacity], 8);
+	XCTAssertTrue([set isEmpty]);
+
+	const uint64_t value = 7;
+	XCTAssertFalse([set containsValue:&value]);
+	XCTAssertFalse([set removeValue:&value]);
+
+	XCTAssertThrows([CBHPrimitiveHashSet hashSetWithEntrySize:0], @"Fails to catch invalid entry size.");
+}
+
+- (void)testInitialization_copying
+{
+	const uint32_t values[] = {5, 3, 5, 9, 3, 1};
+	CBHPrimitiveHashSet *set = [CBHPrimitiveHashSet hashSetWithEntrySize:sizeof(uint32_t) copying:6 entriesFromBytes:values];
+
+	XCTAssertEqual([set count], 4);
+	XCTAssertEqual([[set wedge] count], 4);
+}
+
+
+#pragma mark - Set
+
+- (void)testSet_addAndRemove
+{
+	CBHPrimitiveHashSet *set = [CBHPrimitiveHashSet hashSetWithEntrySize:sizeof(uint64_t)];
+
+	for (uint64_t i = 0; i < 100000; ++i) { XCTAssertTrue([set addValue:&i]); }
+	XCTAssertEqual([set count], 100000);
+	XCTAssertGreaterThanOrEqual([set capacity], 100000);
+
+	const uint64_t duplicate = 500;
+	XCTAssertFalse([set addValue:&duplicate], @"Adds a duplicate.");
+
+	for (uint64_t i = 0; i < 100000; i += 2) { XCTAssertTrue([set removeValue:&i]); }
+	XCTAssertEqual([set count], 50000);
+
+	/// Removal shifts entries back, every remaining entry must still be found.
+	for (uint64_t i = 0; i < 100000; ++i)
+	{
+		XCTAssertEqual([set containsValue:&i], (BOOL)(i % 2), @"Fails to find the correct entries after removal.");
+	}
+
+	[set removeAll];
+	XCTAssertTrue([set isEmpty]);
+	XCTAssertFalse([set containsValue:&duplicate]);
+}
+
+- (void)testSet_oddEntrySize
+{
+	typedef struct { uint8_t bytes[11]; } CBHEntry;
+	CBHPrimitiveHashSet *set = [CBHPrimitiveHashSet hashSetWithEntrySize:sizeof(CBHEntry)];
+
+	for (uint8_t i = 0; i < 200; ++i)
+	{
+		CBHEntry entry;
+		memset(&entry, i, sizeof(CBHEntry));
+		[set addValue:&entry];
+	}
+
+	CBHEntry entry;
+	memset(&entry, 150, sizeof(CBHEntry));
+	XCTAssertTrue([set containsValue:&entry]);
+
+	entry.bytes[10] = 0;
+	XCTAssertFalse([set containsValue:&entry]);
+}
+
+- (void)testSet_batch
+{
+	uint64_t values[1000];
+	for (uint64_t i = 0; i < 1000; ++i) { values[i] = i * 3; }
+
+	CBHPrimitiveHashSet *set = [CBHPrimitiveHashSet hashSetWithEntrySize:sizeof(uint64_t) copying:1000 entriesFromBytes:values];
+
+	uint64_t queries[600];
+	BOOL results[600];
+	for (uint64_t i = 0; i < 600; ++i) { queries[i] = i; }
+
+	XCTAssertEqual([set containsValues:queries count:600 results:results], 200);
+	for (NSUInteger i = 0; i < 600; ++i) { XCTAssertEqual(results[i], (BOOL)(i % 3 == 0)); }
+
+	XCTAssertEqual([set containsValues:queries count:600 results:NULL], 200);
+}
+
+
+#pragma mark - Resizing
+
+- (void)testResizing_basic
+{
+	CBHPrimitiveHashSet *set = [CBHPrimitiveHashSet hashSetWithEntrySize:sizeof(uint32_t) andCapacity:1000];
+	XCTAssertGreaterThanOrEqual([set capacity], 1000);
+
+	for (uint32_t i = 0; i < 10; ++i) { [set addValue:&i]; }
+
+	XCTAssertTrue([set shrink]);
+	XCTAssertLessThan([set capacity], 1000);
+
+	XCTAssertFalse([set resize:5], @"Resizes below the count.");
+	XCTAssertTrue([set growToFit:5000]);
+	XCTAssertFalse([set growToFit:10]);
+
+	for (uint32_t i = 0; i < 10; ++i) { XCTAssertTrue([set containsValue:&i]); }
+}
+
+
+#pragma mark - Copying and Equality
+
+- (void)testCopying_basic
+{
+	CBHPrimitiveHashSet *set = [CBHPrimitiveHashSet hashSetWithEntrySize:sizeof(uint32_t)];
+	for (uint32_t i = 0; i < 100; ++i) { [set addValue:&i]; }
+
+	CBHPrimitiveHashSet *copy = [set copy];
+	XCTAssertEqualObjects(set, copy);
+	XCTAssertEqual([set hash], [copy hash]);
+
+	/// The same entries added in another order land in other slots.
+	CBHPrimitiveHashSet *reversed = [CBHPrimitiveHashSet hashSetWithEntrySize:sizeof(uint32_t) andCapacity:5000];
+	for (uint32_t i = 100; i > 0; --i) { const uint32_t value = i - 1; [reversed addValue:&value]; }
+	XCTAssertEqualObjects(set, reversed);
+	XCTAssertEqual([set hash], [reversed hash], @"Equal sets hash differently.");
+
+	/// Equal sizes and counts, but different entries.
+	CBHPrimitiveHashSet *shifted = [CBHPrimitiveHashSet hashSetWithEntrySize:sizeof(uint32_t)];
+	for (uint32_t i = 1; i <= 100; ++i) { [shifted addValue:&i]; }
+	XCTAssertNotEqual([set hash], [shifted hash], @"Ignores the entries.");
+
+	const uint32_t value = 50;
+	[copy removeValue:&value];
+	XCTAssertTrue([set containsValue:&value], @"Original changed with the copy.");
+	XCTAssertNotEqualObjects(set, copy);
+
+	[copy release];
+}
+
+@end
@@ -18,6 +18,7 @@
 
 @import XCTest;
 @import CBHCollectionKit.CBHSlice;
+@import CBHCollectionKit.CBHMutableSlice;
 
 #import "CBHSliceTestMacros.h"
 
@@ -306,6 +307,25 @@
 	XCTAssertNotEqual(hash13, hash14, @"Hash too easily collides.");
 }
 
+- (void)testEquality_hashMiddle
+{
+	NSUInteger list[64];
+	for (NSUInteger i = 0; i < 64; ++i) { list[i] = i; }
+
+	CBHSlice *slice0 = [CBHSlice sliceWithEntrySize:sizeof(NSUInteger) copying:64 entriesFromBytes:list];
+	list[29] = 1000;
+	CBHSlice *slice1 = [CBHSlice sliceWithEntrySize:sizeof(NSUInteger) copying:64 entriesFromBytes:list];
+	XCTAssertNotEqual([slice0 hash], [slice1 hash], @"Hash ignores entries away from the ends.");
+
+	CBHMutableSlice *mutableSlice = [slice0 mutableCopy];
+	XCTAssertEqual([mutableSlice hash], [slice0 hash], @"Equal mutable and immutable slices hash apart.");
+
+	[mutableSlice setUnsignedInteger:1000 atIndex:29];
+	XCTAssertEqual([mutableSlice hash], [slice1 hash], @"Mutable slice keeps a stale hash.");
+
+	[mutableSlice release];
+}
+
 #pragma mark - Conversion
 
 - (void)testConversion_data
@@ -338,6 +358,120 @@
 	XCTAssertEqualObjects(string, @"abcdefgh", @"Fails to convert slice to string or data.");
 }
 
+- (void)testConversion_dataNoCopy
+{
+	CBHSliceCreateDefault(slice, NSUInteger);
+
+	NSData *data = [slice dataNoCopy];
+	XCTAssertEqual([data length], 8 * sizeof(NSUInteger), @"Incorrect length.");
+	XCTAssertEqual([data bytes], [slice valueAtIndex:0], @"Fails to share bytes.");
+}
+
+- (void)testConversion_adoptingData
+{
+	const NSUInteger list[] = {0, 1, 2, 3, 4, 5, 6, 7};
+	NSData *data = [NSData dataWithBytes:list length:sizeof(list)];
+
+	CBHSlice *slice = [CBHSlice sliceWithEntrySize:sizeof(NSUInteger) adoptingData:data];
+	CBHAssertSliceState(slice, 8, NSUInteger, NO);
+	CBHAssertSliceDefault(slice, NSUInteger, unsignedInteger);
+	XCTAssertEqual([slice valueAtIndex:0], [data bytes], @"Fails to share bytes.");
+
+	XCTAssertThrows([CBHSlice sliceWithEntrySize:3 adoptingData:data], @"Fails to catch bad length.");
+}
+
+- (void)testConversion_adoptingDispatchData
+{
+	const NSUInteger list[] = {0, 1, 2, 3, 4, 5, 6, 7};
+	dispatch_data_t data = dispatch_data_create(list, sizeof(list), NULL, DISPATCH_DATA_DESTRUCTOR_DEFAULT);
+
+	CBHSlice *slice = [CBHSlice sliceWithEntrySize:sizeof(NSUInteger) adoptingDispatchData:data];
+	dispatch_release(data);
+
+	CBHAssertSliceState(slice, 8, NSUInteger, NO);
+	CBHAssertSliceDefault(slice, NSUInteger, unsignedInteger);
+}
+
+
+#pragma mark - Files
+
+- (void)testFile_header
+{
+	CBHSliceCreateDefault(slice, NSUInteger);
+	NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+
+	NSError *error = nil;
+	XCTAssertTrue([slice writeToFile:path options:CBHSliceFileHeader error:&error], @"Fails to write file: %@", error);
+
+	CBHSlice *mapped = [CBHSlice sliceWithContentsOfFile:path entrySize:sizeof(NSUInteger) options:CBHSliceFileHeader | CBHSliceFileAdviseRandom];
+	CBHAssertSliceState(mapped, 8, NSUInteger, NO);
+	CBHAssertSliceDefault(mapped, NSUInteger, unsignedInteger);
+	XCTAssertEqualObjects(slice, mapped, @"Fails to detect equality.");
+
+	/// Rewriting doesn't disturb the mapping.
+	CBHSlice *other = [CBHSlice sliceWithEntrySize:sizeof(NSUInteger) andCapacity:2];
+	XCTAssertTrue([other writeToFile:path options:CBHSliceFileHeader error:NULL], @"Fails to rewrite file.");
+	CBHAssertSliceDefault(mapped, NSUInteger, unsignedInteger);
+
+	[[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+- (void)testFile_raw
+{
+	CBHSliceCreateDefault(slice, NSUInteger);
+	NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+	XCTAssertTrue([slice writeToFile:path options:CBHSliceFileOptionsNone error:NULL], @"Fails to write file.");
+
+	NSError *error = nil;
+	CBHSlice *mapped = [[[CBHSlice alloc] initWithContentsOfFile:path entrySize:sizeof(NSUInteger) options:CBHSliceFileAdviseSequential | CBHSliceFileAdviseWillNeed error:&error] autorelease];
+	XCTAssertNotNil(mapped, @"Fails to map file: %@", error);
+	CBHAssertSliceDefault(mapped, NSUInteger, unsignedInteger);
+
+	/// Uneven and headerless files are rejected.
+	error = nil;
+	XCTAssertNil([[[CBHSlice alloc] initWithContentsOfFile:path entrySize:3 options:CBHSliceFileOptionsNone error:&error] autorelease], @"Fails to catch bad length.");
+	XCTAssertEqual([error code], CBHCollectionFormatErrorEntrySize, @"Incorrect error.");
+
+	error = nil;
+	XCTAssertNil([[[CBHSlice alloc] initWithContentsOfFile:path entrySize:sizeof(NSUInteger) options:CBHSliceFileHeader error:&error] autorelease], @"Fails to catch missing header.");
+	XCTAssertEqualObjects([error domain], CBHCollectionFormatErrorDomain, @"Incorrect error domain.");
+	XCTAssertEqual([error code], CBHCollectionFormatErrorMagic, @"Incorrect error.");
+
+	XCTAssertThrows([CBHSlice sliceWithContentsOfFile:path entrySize:sizeof(NSUInteger) options:CBHSliceFileAdviseSequential | CBHSliceFileAdviseRandom], @"Fails to catch conflicting advice.");
+
+	[[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+- (void)testFile_invalid
+{
+	NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+
+	NSError *error = nil;
+	XCTAssertNil([[[CBHSlice alloc] initWithContentsOfFile:path entrySize:sizeof(NSUInteger) options:CBHSliceFileOptionsNone error:&error] autorelease], @"Fails to catch missing file.");
+	XCTAssertEqualObjects([error domain], NSPOSIXErrorDomain, @"Incorrect error domain.");
+
+	/// The header must describe the expected entries, and fit.
+	CBHCollectionHeader header = CBHCollectionHeaderMake(sizeof(uint32_t), 8);
+	[[NSData dataWithBytes:&header length:sizeof(header)] writeToFile:path atomically:YES];
+
+	error = nil;
+	XCTAssertNil([[[CBHSlice alloc] initWithContentsOfFile:path entrySize:sizeof(uint64_t) options:CBHSliceFileHeader error:&error] autorelease], @"Fails to catch entry size.");
+	XCTAssertEqual([error code], CBHCollectionFormatErrorEntrySize, @"Incorrect error.");
+
+	error = nil;
+	XCTAssertNil([[[CBHSlice alloc] initWithContentsOfFile:path entrySize:sizeof(uint32_t) options:CBHSliceFileHeader error:&error] autorelease], @"Fails to catch truncation.");
+	XCTAssertEqual([error code], CBHCollectionFormatErrorTruncated, @"Incorrect error.");
+
+	header.version = CBHCollectionFormatVersion + 1;
+	[[NSData dataWithBytes:&header length:sizeof(header)] writeToFile:path atomically:YES];
+
+	error = nil;
+	XCTAssertNil([[[CBHSlice alloc] initWithContentsOfFile:path entrySize:sizeof(uint32_t) options:CBHSliceFileHeader error:&error] autorelease], @"Fails to catch version.");
+	XCTAssertEqual([error code], CBHCollectionFormatErrorVersion, @"Incorrect error.");
+
+	[[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
 
 #pragma mark - Description
 
@@ -365,4 +499,134 @@
 	XCTAssertTrue([description compare:expected], @"Description is wrong");
 }
 
+
+#pragma mark - Enumeration
+
+- (void)testEnumeration_values
+{
+	CBHSliceCreateDefault(slice, NSUInteger);
+
+	__block NSUInteger calls = 0;
+	[slice enumerateValuesUsingBlock:^(const void *value, NSUInteger index, BOOL *stop) {
+		XCTAssertEqual(index, calls, @"Fails to enumerate in order.");
+		XCTAssertEqual(*(const NSUInteger *)value, index, @"Fails to point at the entry.");
+		++calls;
+	}];
+	XCTAssertEqual(calls, 8, @"Enumerated wrong number of times.");
+}
+
+- (void)testEnumeration_reverse
+{
+	CBHSliceCreateDefault(slice, NSUInteger);
+
+	__block NSUInteger calls = 0;
+	[slice enumerateValuesWithOptions:NSEnumerationReverse usingBlock:^(const void *value, NSUInteger index, BOOL *stop) {
+		XCTAssertEqual(index, 7 - calls, @"Fails to enumerate in reverse.");
+		XCTAssertEqual(*(const NSUInteger *)value, index, @"Fails to point at the entry.");
+		++calls;
+	}];
+	XCTAssertEqual(calls, 8, @"Enumerated wrong number of times.");
+
+	/// Indexes within a range are still those of the whole slice.
+	calls = 0;
+	[slice enumerateValuesInRange:NSMakeRange(2, 4) options:NSEnumerationReverse usingBlock:^(const void *value, NSUInteger index, BOOL *stop) {
+		XCTAssertEqual(index, 5 - calls, @"Fails to enumerate range in reverse.");
+		XCTAssertEqual(*(const NSUInteger *)value, index, @"Fails to point at the entry.");
+		++calls;
+	}];
+	XCTAssertEqual(calls, 4, @"Enumerated wrong number of times.");
+}
+
+- (void)testEnumeration_stop
+{
+	CBHSliceCreateDefault(slice, NSUInteger);
+
+	__block NSUInteger calls = 0;
+	[slice enumerateValuesUsingBlock:^(const void *value, NSUInteger index, BOOL *stop) {
+		++calls;
+		if ( index == 3 ) { *stop = YES; }
+	}];
+	XCTAssertEqual(calls, 4, @"Fails to stop enumerating.");
+}
+
+- (void)testEnumeration_range
+{
+	CBHSliceCreateDefault(slice, NSUInteger);
+
+	__block NSUInteger sum = 0;
+	[slice enumerateValuesInRange:NSMakeRange(2, 4) options:0 usingBlock:^(const void *value, NSUInteger index, BOOL *stop) {
+		XCTAssertTrue(index >= 2 && index < 6, @"Fails to respect range.");
+		XCTAssertEqual(*(const NSUInteger *)value, index, @"Fails to point at the entry.");
+		sum += *(const NSUInteger *)value;
+	}];
+	XCTAssertEqual(sum, 2 + 3 + 4 + 5, @"Fails to enumerate range.");
+
+	__block NSUInteger calls = 0;
+	[slice enumerateValuesInRange:NSMakeRange(8, 0) options:0 usingBlock:^(const void *value, NSUInteger index, BOOL *stop) { ++calls; }];
+	XCTAssertEqual(calls, 0, @"Enumerates an empty range.");
+
+	XCTAssertThrows([slice enumerateValuesInRange:NSMakeRange(6, 3) options:0 usingBlock:^(const void *value, NSUInteger index, BOOL *stop) {}], @"Fails to catch out-of-bounds range.");
+	XCTAssertThrows([slice enumerateValuesInRange:NSMakeRange(9, 0) options:0 usingBlock:^(const void *value, NSUInteger index, BOOL *stop) {}], @"Fails to catch out-of-bounds range.");
+}
+
+- (void)testEnumeration_concurrent
+{
+	const NSUInteger count = 1 << 16;
+
+	NSUInteger *list = calloc(count, sizeof(NSUInteger));
+	XCTAssertTrue(list != NULL);
+	for (NSUInteger i = 0; i < count; ++i) { list[i] = i; }
+
+	CBHSlice *slice = [CBHSlice sliceWithEntrySize:sizeof(NSUInteger) copying:count entriesFromBytes:list];
+	free(list);
+
+	/// Each entry must be visited exactly once, both over the whole slice and over a range of it.
+	unsigned char *visits = calloc(count, sizeof(unsigned char));
+	XCTAssertTrue(visits != NULL);
+
+	[slice enumerateValuesWithOptions:NSEnumerationConcurrent usingBlock:^(const void *value, NSUInteger index, BOOL *stop) {
+		XCTAssertEqual(*(const NSUInteger *)value, index);
+		__atomic_add_fetch(&visits[index], 1, __ATOMIC_RELAXED);
+	}];
+
+	const NSRange range = NSMakeRange(1000, count - 2000);
+	[slice enumerateValuesInRange:range options:NSEnumerationConcurrent usingBlock:^(const void *value, NSUInteger index, BOOL *stop) {
+		XCTAssertEqual(*(const NSUInteger *)value, index);
+		__atomic_add_fetch(&visits[index], 1, __ATOMIC_RELAXED);
+	}];
+
+	NSUInteger missed = 0;
+	for (NSUInteger i = 0; i < count; ++i)
+	{
+		const unsigned char expected = ( NSLocationInRange(i, range) ) ? 2 : 1;
+		if ( visits[i] != expected ) { ++missed; }
+	}
+	XCTAssertEqual(missed, 0, @"Fails to visit each entry once.");
+
+	free(visits);
+}
+
+
+#pragma mark - Unsafe Access
+
+- (void)testUnsafeBytes
+{
+	CBHSliceCreateDefault(slice, NSUInteger);
+
+	__block NSUInteger sum = 0;
+	[slice withUnsafeBytes:^(CBHSliceView view) {
+		XCTAssertEqual(view.count, 8);
+		XCTAssertEqual(view.entrySize, sizeof(NSUInteger));
+		XCTAssertTrue(CBHSliceView_isValid(view));
+
+		const NSUInteger *values = CBHSliceView_entries(view, NSUInteger);
+		for (NSUInteger i = 0; i < view.count; ++i) { sum += values[i]; }
+
+		XCTAssertEqual(*(const NSUInteger *)CBHSliceView_valueAtIndex(view, 7), 7);
+		XCTAssertThrows(CBHSliceView_entries(view, uint8_t), @"Fails to catch bad entry size.");
+	}];
+
+	XCTAssertEqual(sum, 28);
+}
+
 @end
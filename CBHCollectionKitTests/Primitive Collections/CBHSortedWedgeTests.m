@@ -0,0 +1,246 @@
+//  CBHSortedWedgeTests.m
+//  CBHCollectionKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import XCTest;
+@import CBHCollectionKit.CBHSortedWedge;
+
+
+@interface CBHSortedWedgeTests : XCTestCase
+@end
+
+
+@implementation CBHSortedWedgeTests
+
+#pragma mark - Initialization
+
+- (void)testInitialization_basic
+{
+	CBHSortedWedge *wedge = [CBHSortedWedge sortedWedgeWithEntrySize:sizeof(uint64_t) type:CBHPrimitiveTypeUnsigned];
+	XCTAssertEqual([wedge count], 0);
+	XCTAssertEqual([wedge capacity], 8);
+	XCTAssertEqual([wedge entrySize], sizeof(uint64_t));
+	XCTAssertTrue([wedge isEmpty]);
+
+	XCTAssertThrows([wedge valueAtIndex:0], @"Fails to catch out-of-bounds on access.");
+}
+
+- (void)testInitialization_copying
+{
+	const int32_t list[] = {5, -3, 9, 0, -3, 12, 7, 1};
+	const int32_t expected[] = {-3, -3, 0, 1, 5, 7, 9, 12};
+	CBHSortedWedge *wedge = [CBHSortedWedge sortedWedgeWithEntrySize:sizeof(int32_t) type:CBHPrimitiveTypeSigned copying:8 entriesFromBytes:list];
+	XCTAssertEqual([wedge count], 8);
+
+	for (NSUInteger i = 0; i < 8; ++i)
+	{
+		XCTAssertEqual(*(const int32_t *)[wedge valueAtIndex:i], expected[i], @"Fails to return correct value at index.");
+	}
+}
+
+- (void)testInitialization_invalidKey
+{
+	XCTAssertThrows([CBHSortedWedge sortedWedgeWithEntrySize:3 type:CBHPrimitiveTypeUnsigned], @"Fails to catch invalid key size.");
+	XCTAssertThrows([CBHSortedWedge sortedWedgeWithEntrySize:sizeof(uint16_t) type:CBHPrimitiveTypeFloat], @"Fails to catch invalid key size.");
+	XCTAssertThrows([[CBHSortedWedge alloc] initWithEntrySize:8 andCapacity:8 sortedByKeyAtOffset:6 ofSize:4 asType:CBHPrimitiveTypeUnsigned], @"Fails to catch out-of-bounds key.");
+}
+
+
+#pragma mark - Searching
+
+- (void)testSearch_bounds
+{
+	const uint64_t list[] = {10, 20, 20, 20, 30, 40, 40, 50};
+	CBHSortedWedge *wedge = [CBHSortedWedge sortedWedgeWithEntrySize:sizeof(uint64_t) type:CBHPrimitiveTypeUnsigned copying:8 entriesFromBytes:list];
+
+	uint64_t key = 20;
+	XCTAssertEqual([wedge lowerBound:&key], 1);
+	XCTAssertEqual([wedge upperBound:&key], 4);
+	XCTAssertTrue([wedge containsValue:&key]);
+	XCTAssertEqual([wedge indexOfValue:&key], 1);
+
+	key = 5;
+	XCTAssertEqual([wedge lowerBound:&key], 0);
+	XCTAssertEqual([wedge upperBound:&key], 0);
+	XCTAssertFalse([wedge containsValue:&key]);
+
+	key = 35;
+	XCTAssertEqual([wedge lowerBound:&key], 5);
+	XCTAssertEqual([wedge upperBound:&key], 5);
+	XCTAssertEqual([wedge indexOfValue:&key], NSNotFound);
+
+	key = 99;
+	XCTAssertEqual([wedge lowerBound:&key], 8);
+	XCTAssertEqual([wedge upperBound:&key], 8);
+	XCTAssertFalse([wedge containsValue:&key]);
+}
+
+- (void)testSearch_empty
+{
+	CBHSortedWedge *wedge = [CBHSortedWedge sortedWedgeWithEntrySize:sizeof(uint64_t) type:CBHPrimitiveTypeUnsigned];
+
+	uint64_t key = 7;
+	XCTAssertEqual([wedge lowerBound:&key], 0);
+	XCTAssertEqual([wedge upperBound:&key], 0);
+	XCTAssertFalse([wedge containsValue:&key]);
+}
+
+- (void)testSearch_float
+{
+	const double list[] = {1.5, -2.5, 0.0, -0.25};
+	CBHSortedWedge *wedge = [CBHSortedWedge sortedWedgeWithEntrySize:sizeof(double) type:CBHPrimitiveTypeFloat copying:4 entriesFromBytes:list];
+
+	XCTAssertEqual(*(const double *)[wedge valueAtIndex:0], -2.5);
+	XCTAssertEqual(*(const double *)[wedge valueAtIndex:3], 1.5);
+
+	double key = -0.25;
+	XCTAssertEqual([wedge indexOfValue:&key], 1);
+
+	key = 1.0;
+	XCTAssertEqual([wedge lowerBound:&key], 3);
+}
+
+- (void)testSearch_byKey
+{
+	typedef struct { uint32_t identifier; uint16_t key; } CBHRecord;
+
+	CBHSortedWedge *wedge = [[[CBHSortedWedge alloc] initWithEntrySize:sizeof(CBHRecord) andCapacity:4 sortedByKeyAtOffset:offsetof(CBHRecord, key) ofSize:sizeof(uint16_t) asType:CBHPrimitiveTypeUnsigned] autorelease];
+
+	for (uint32_t i = 0; i < 100; ++i)
+	{
+		CBHRecord record = {i, (uint16_t)(1000 - (i * 10))};
+		[wedge insertValue:&record];
+	}
+
+	uint16_t key = 500;
+	NSUInteger index = [wedge indexOfValue:&key];
+	XCTAssertNotEqual(index, NSNotFound);
+	XCTAssertEqual(((const CBHRecord *)[wedge valueAtIndex:index])->identifier, 50);
+}
+
+
+#pragma mark - Inserting
+
+- (void)testInsert_value
+{
+	CBHSortedWedge *wedge = [CBHSortedWedge sortedWedgeWithEntrySize:sizeof(int64_t) type:CBHPrimitiveTypeSigned];
+
+	const int64_t list[] = {4, -1, 9, 4, 0};
+	const NSUInteger expectedIndexes[] = {0, 0, 2, 2, 1};
+	for (NSUInteger i = 0; i < 5; ++i)
+	{
+		XCTAssertEqual([wedge insertValue:&list[i]], expectedIndexes[i], @"Inserted at the wrong index.");
+	}
+
+	const int64_t expected[] = {-1, 0, 4, 4, 9};
+	for (NSUInteger i = 0; i < 5; ++i)
+	{
+		XCTAssertEqual(*(const int64_t *)[wedge valueAtIndex:i], expected[i], @"Fails to return correct value at index.");
+	}
+}
+
+- (void)testInsert_values
+{
+	const NSUInteger count = 5000;
+	CBHSortedWedge *wedge = [CBHSortedWedge sortedWedgeWithEntrySize:sizeof(uint32_t) type:CBHPrimitiveTypeUnsigned];
+
+	/// Even values individually, odd values as a batch.
+	for (uint32_t i = 0; i < count; i += 2) { [wedge insertValue:&i]; }
+
+	uint32_t *batch = malloc((count / 2) * sizeof(uint32_t));
+	for (NSUInteger i = 0; i < count / 2; ++i) { batch[i] = (uint32_t)(count - 1 - (i * 2)); }
+
+	[wedge insertValues:batch count:count / 2];
+	free(batch);
+
+	XCTAssertEqual([wedge count], count);
+	for (NSUInteger i = 0; i < count; ++i)
+	{
+		XCTAssertEqual(*(const uint32_t *)[wedge valueAtIndex:i], (uint32_t)i, @"Fails to return correct value at index.");
+	}
+}
+
+- (void)testInsert_valuesFromReceiver
+{
+	const uint32_t list[] = {1, 3, 5, 7};
+	CBHSortedWedge *wedge = [CBHSortedWedge sortedWedgeWithEntrySize:sizeof(uint32_t) type:CBHPrimitiveTypeUnsigned copying:4 entriesFromBytes:list];
+	[wedge shrink];
+
+	/// Growing moves the storage the values are read from.
+	[wedge insertValues:[wedge valueAtIndex:0] count:4];
+
+	const uint32_t expected[] = {1, 1, 3, 3, 5, 5, 7, 7};
+	XCTAssertEqual([wedge count], 8);
+	for (NSUInteger i = 0; i < 8; ++i)
+	{
+		XCTAssertEqual(*(const uint32_t *)[wedge valueAtIndex:i], expected[i], @"Fails to return correct value at index.");
+	}
+}
+
+- (void)testInsert_valuesEmpty
+{
+	CBHSortedWedge *wedge = [CBHSortedWedge sortedWedgeWithEntrySize:sizeof(uint32_t) type:CBHPrimitiveTypeUnsigned];
+
+	const uint32_t value = 1;
+	XCTAssertNoThrow([wedge insertValues:&value count:0]);
+	XCTAssertEqual([wedge count], 0);
+}
+
+
+#pragma mark - Removing
+
+- (void)testRemove
+{
+	const uint16_t list[] = {3, 1, 2, 2, 5};
+	CBHSortedWedge *wedge = [CBHSortedWedge sortedWedgeWithEntrySize:sizeof(uint16_t) type:CBHPrimitiveTypeUnsigned copying:5 entriesFromBytes:list];
+
+	uint16_t key = 2;
+	XCTAssertTrue([wedge removeValue:&key]);
+	XCTAssertTrue([wedge removeValue:&key]);
+	XCTAssertFalse([wedge removeValue:&key]);
+	XCTAssertEqual([wedge count], 3);
+
+	[wedge removeValueAtIndex:0];
+	XCTAssertEqual(*(const uint16_t *)[wedge valueAtIndex:0], 3);
+	XCTAssertThrows([wedge removeValueAtIndex:2], @"Fails to catch out-of-bounds on removal.");
+
+	[wedge removeAll];
+	XCTAssertTrue([wedge isEmpty]);
+}
+
+
+#pragma mark - Copying and Equality
+
+- (void)testCopy
+{
+	const uint64_t list[] = {7, 3, 5};
+	CBHSortedWedge *wedge = [CBHSortedWedge sortedWedgeWithEntrySize:sizeof(uint64_t) type:CBHPrimitiveTypeUnsigned copying:3 entriesFromBytes:list];
+
+	CBHSortedWedge *copy = [[wedge copy] autorelease];
+	XCTAssertEqualObjects(wedge, copy);
+	XCTAssertEqual([wedge hash], [copy hash]);
+
+	const uint64_t value = 4;
+	[copy insertValue:&value];
+	XCTAssertNotEqualObjects(wedge, copy);
+
+	CBHWedge *plain = [copy wedge];
+	XCTAssertEqual([plain count], 4);
+	XCTAssertEqual([plain unsignedIntegerAtIndex:1], 4);
+}
+
+@end
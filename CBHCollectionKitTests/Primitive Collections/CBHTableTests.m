@@ -0,0 +1,237 @@
+//  CBHTableTests.m
+//  CBHCollectionKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import XCTest;
+@import CBHCollectionKit.CBHTable;
+@import CBHCollectionKit.CBHWedge;
+@import CBHCollectionKit.CBHBitSlice;
+
+
+typedef struct CBHTableRecord_t {
+	uint32_t identifier;
+	int16_t delta;
+	double price;
+	uint8_t flags;
+} CBHTableRecord_t;
+
+static const CBHTableColumn CBHTableRecordColumns[] = {
+	CBHTableColumnOf(CBHTableRecord_t, identifier, CBHPrimitiveTypeUnsigned),
+	CBHTableColumnOf(CBHTableRecord_t, delta, CBHPrimitiveTypeSigned),
+	CBHTableColumnOf(CBHTableRecord_t, price, CBHPrimitiveTypeFloat),
+	CBHTableColumnOf(CBHTableRecord_t, flags, CBHPrimitiveTypeUnsigned),
+};
+
+
+@interface CBHTableTests : XCTestCase
+@end
+
+
+@implementation CBHTableTests
+
+#pragma mark - Utilities
+
+- (CBHTable *)tableWithCount:(NSUInteger)count
+{
+	CBHTable *table = [CBHTable tableWithColumns:CBHTableRecordColumns count:4 recordSize:sizeof(CBHTableRecord_t)];
+
+	for (NSUInteger i = 0; i < count; ++i)
+	{
+		CBHTableRecord_t record = {(uint32_t)i, (int16_t)((NSInteger)i - 50), (double)i * 0.5, (uint8_t)(i % 3)};
+		[table appendRecord:&record];
+	}
+
+	return table;
+}
+
+
+#pragma mark - Initialization
+
+- (void)testInitialization_basic
+{
+	CBHTable *table = [CBHTable tableWithColumns:CBHTableRecordColumns count:4 recordSize:sizeof(CBHTableRecord_t)];
+	XCTAssertEqual([table count], 0);
+	XCTAssertEqual([table columnCount], 4);
+	XCTAssertEqual([table recordSize], sizeof(CBHTableRecord_t));
+	XCTAssertTrue([table isEmpty]);
+
+	XCTAssertEqual([table columnAtIndex:2].offset, offsetof(CBHTableRecord_t, price));
+	XCTAssertEqual([table columnAtIndex:2].size, sizeof(double));
+
+	XCTAssertThrows([table columnAtIndex:4], @"Fails to catch out-of-bounds column.");
+	XCTAssertThrows([table valueAtRow:0 column:0], @"Fails to catch out-of-bounds row.");
+}
+
+- (void)testInitialization_invalid
+{
+	const CBHTableColumn outside = {6, 4, CBHPrimitiveTypeUnsigned};
+	const CBHTableColumn empty = {0, 0, CBHPrimitiveTypeUnsigned};
+
+	XCTAssertThrows([CBHTable tableWithColumns:CBHTableRecordColumns count:0 recordSize:sizeof(CBHTableRecord_t)], @"Fails to catch missing columns.");
+	XCTAssertThrows([CBHTable tableWithColumns:&outside count:1 recordSize:8], @"Fails to catch a column outside the record.");
+	XCTAssertThrows([CBHTable tableWithColumns:&empty count:1 recordSize:8], @"Fails to catch an empty column.");
+}
+
+
+#pragma mark - Records
+
+- (void)testRecords_roundTrip
+{
+	CBHTable *table = [self tableWithCount:3000];
+	XCTAssertEqual([table count], 3000);
+
+	for (NSUInteger i = 0; i < 3000; i += 7)
+	{
+		CBHTableRecord_t record;
+		memset(&record, 0, sizeof(CBHTableRecord_t));
+		[table getRecord:&record atRow:i];
+
+		XCTAssertEqual(record.identifier, (uint32_t)i);
+		XCTAssertEqual(record.delta, (int16_t)((NSInteger)i - 50));
+		XCTAssertEqual(record.price, (double)i * 0.5);
+		XCTAssertEqual(record.flags, (uint8_t)(i % 3));
+	}
+
+	XCTAssertEqual(*(const double *)[table valueAtRow:10 column:2], 5.0);
+
+	CBHTableRecord_t record;
+	XCTAssertThrows([table getRecord:&record atRow:3000], @"Fails to catch out-of-bounds row.");
+}
+
+- (void)testRecords_wedge
+{
+	CBHTable *table = [self tableWithCount:2500];
+	CBHWedge *records = [table recordWedge];
+
+	XCTAssertEqual([records count], 2500);
+	XCTAssertEqual([records entrySize], sizeof(CBHTableRecord_t));
+
+	CBHTable *other = [CBHTable tableWithColumns:CBHTableRecordColumns count:4 recordsFromWedge:records];
+	XCTAssertEqualObjects(table, other);
+
+	const CBHTableRecord_t *record = (const CBHTableRecord_t *)[records valueAtIndex:2499];
+	XCTAssertEqual(record->identifier, 2499);
+	XCTAssertEqual(record->price, 1249.5);
+}
+
+- (void)testRecords_setValue
+{
+	CBHTable *table = [self tableWithCount:10];
+	CBHTable *copy = [table copy];
+
+	const double price = 99.25;
+	[table setValue:&price atRow:4 column:2];
+
+	XCTAssertEqual(*(const double *)[table valueAtRow:4 column:2], 99.25);
+	XCTAssertEqual(*(const double *)[copy valueAtRow:4 column:2], 2.0, @"Copy changed with the original.");
+	XCTAssertNotEqualObjects(table, copy);
+
+	XCTAssertThrows([table setValue:&price atRow:10 column:2], @"Fails to catch out-of-bounds row.");
+
+	[copy release];
+}
+
+- (void)testRecords_hash
+{
+	CBHTable *table = [self tableWithCount:10];
+	CBHTable *copy = [[table copy] autorelease];
+	XCTAssertEqual([table hash], [copy hash], @"Equal tables hash differently.");
+
+	/// Only a column after the first differs.
+	const double price = 99.25;
+	[copy setValue:&price atRow:4 column:2];
+	XCTAssertNotEqual([table hash], [copy hash], @"Ignores columns after the first.");
+}
+
+- (void)testRecords_remove
+{
+	CBHTable *table = [self tableWithCount:10];
+
+	[table removeLast:4];
+	XCTAssertEqual([table count], 6);
+	XCTAssertEqual([[table wedgeOfColumn:1] count], 6);
+
+	[table removeLast:40];
+	XCTAssertTrue([table isEmpty]);
+
+	[table removeAll];
+	XCTAssertEqual([table count], 0);
+}
+
+
+#pragma mark - Scanning
+
+- (void)testScanning_range
+{
+	CBHTable *table = [self tableWithCount:1000];
+
+	const int16_t low = -10;
+	const int16_t high = 20;
+	CBHBitSlice *rows = [table rowsOfColumn:1 from:&low to:&high];
+
+	XCTAssertEqual([rows count], 1000);
+	XCTAssertEqual([rows popCount], 31);
+	XCTAssertEqual([rows firstSetBit], 40);
+	XCTAssertTrue([rows bitAtIndex:70]);
+	XCTAssertFalse([rows bitAtIndex:71]);
+
+	const double emptyLow = 10.0;
+	const double emptyHigh = -10.0;
+	XCTAssertEqual([[table rowsOfColumn:2 from:&emptyLow to:&emptyHigh] popCount], 0);
+}
+
+- (void)testScanning_sum
+{
+	CBHTable *table = [self tableWithCount:1000];
+
+	XCTAssertEqual([table sumOfColumn:0 inRows:nil], 499500.0);
+	XCTAssertEqual([table sumOfColumn:1 inRows:nil], 449500.0);
+
+	const uint8_t flag = 2;
+	CBHBitSlice *rows = [table rowsOfColumn:3 from:&flag to:&flag];
+	XCTAssertEqual([rows popCount], 333);
+
+	/// Rows 2, 5, ... 998.
+	XCTAssertEqual([table sumOfColumn:2 inRows:rows], 0.5 * ((2.0 + 998.0) * 333.0 / 2.0));
+}
+
+- (void)testScanning_invalid
+{
+	const CBHTableColumn columns[] = {{0, 3, CBHPrimitiveTypeUnsigned}, {4, 2, CBHPrimitiveTypeFloat}};
+	CBHTable *table = [CBHTable tableWithColumns:columns count:2 recordSize:8];
+
+	const uint64_t value = 0;
+	XCTAssertThrows([table rowsOfColumn:0 from:&value to:&value], @"Fails to catch an unscannable width.");
+	XCTAssertThrows([table sumOfColumn:1 inRows:nil], @"Fails to catch a half-width float.");
+	XCTAssertThrows([table sumOfColumn:2 inRows:nil], @"Fails to catch out-of-bounds column.");
+}
+
+
+#pragma mark - Columns
+
+- (void)testColumns_unsafeBytes
+{
+	CBHTable *table = [self tableWithCount:100];
+
+	[table withUnsafeBytesOfColumn:0 usingBlock:^(CBHSliceView view) {
+		XCTAssertEqual(view.count, 100);
+		XCTAssertEqual(view.entrySize, sizeof(uint32_t));
+		XCTAssertEqual(((const uint32_t *)view.bytes)[99], 99);
+	}];
+}
+
+@end
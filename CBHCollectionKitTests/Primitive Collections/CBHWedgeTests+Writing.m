@@ -850,4 +850,129 @@
 	}
 }
 
+
+#pragma mark - Bulk
+
+- (void)testWrite_appendValues
+{
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:2];
+
+	const NSUInteger list[] = {0, 1, 2, 3, 4, 5, 6, 7};
+	[wedge appendValues:list count:4];
+	[wedge appendValues:&list[4] count:4];
+	XCTAssertEqual([wedge count], 8, @"Incorrect count.");
+
+	CBHAssertWedgeDefault(wedge, NSUInteger, unsignedInteger);
+
+	XCTAssertNoThrow([wedge appendValues:list count:0]);
+	XCTAssertEqual([wedge count], 8, @"Incorrect count.");
+}
+
+- (void)testWrite_appendValuesToEmpty
+{
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:0];
+
+	const NSUInteger list[] = {0, 1, 2, 3, 4, 5, 6, 7};
+	[wedge appendValues:list count:8];
+
+	CBHAssertWedgeDefault(wedge, NSUInteger, unsignedInteger);
+}
+
+- (void)testWrite_appendData
+{
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger)];
+
+	const NSUInteger list[] = {0, 1, 2, 3, 4, 5, 6, 7};
+	[wedge appendData:[NSData dataWithBytes:list length:sizeof(list)]];
+	CBHAssertWedgeDefault(wedge, NSUInteger, unsignedInteger);
+
+	XCTAssertThrows([wedge appendData:[NSData dataWithBytes:list length:3]], @"Fails to catch partial entries.");
+	XCTAssertEqual([wedge count], 8, @"Incorrect count.");
+}
+
+- (void)testWrite_appendWedge
+{
+	const NSUInteger list[] = {0, 1, 2, 3, 4, 5, 6, 7};
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) copying:4 entriesFromBytes:list];
+	CBHWedge *other = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) copying:4 entriesFromBytes:&list[4]];
+
+	[wedge appendWedge:other];
+	CBHAssertWedgeDefault(wedge, NSUInteger, unsignedInteger);
+
+	/// Append to itself.
+	[wedge appendWedge:wedge];
+	XCTAssertEqual([wedge count], 16, @"Incorrect count.");
+	for (NSUInteger i = 0; i < 16; ++i)
+	{
+		XCTAssertEqual([wedge unsignedIntegerAtIndex:i], i % 8, @"Fails to return correct value at index.");
+	}
+
+	CBHWedge *mismatched = [CBHWedge wedgeWithEntrySize:sizeof(uint8_t)];
+	XCTAssertThrows([wedge appendWedge:mismatched], @"Fails to catch mismatched entry size.");
+}
+
+- (void)testWrite_appendSlice
+{
+	const NSUInteger list[] = {9, 0, 1, 2, 3, 4, 5, 6, 7, 9};
+	CBHSlice *slice = [CBHSlice sliceWithEntrySize:sizeof(NSUInteger) copying:10 entriesFromBytes:list];
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger)];
+
+	[wedge appendSlice:slice range:NSMakeRange(1, 8)];
+	CBHAssertWedgeDefault(wedge, NSUInteger, unsignedInteger);
+
+	XCTAssertThrows([wedge appendSlice:slice range:NSMakeRange(5, 6)], @"Fails to catch out of bounds range.");
+	XCTAssertThrows([wedge appendSlice:slice range:NSMakeRange(1, NSUIntegerMax)], @"Fails to catch out of bounds range.");
+	XCTAssertEqual([wedge count], 8, @"Incorrect count.");
+}
+
+- (void)testWrite_insertValues
+{
+	const NSUInteger list[] = {0, 1, 6, 7};
+	const NSUInteger middle[] = {2, 3, 4, 5};
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) copying:4 entriesFromBytes:list];
+
+	[wedge insertValues:middle count:4 atIndex:2];
+	CBHAssertWedgeDefault(wedge, NSUInteger, unsignedInteger);
+
+	/// Insert at the end.
+	const NSUInteger tail[] = {8, 9};
+	[wedge insertValues:tail count:2 atIndex:8];
+	XCTAssertEqual([wedge unsignedIntegerAtIndex:9], 9, @"Fails to return correct value at index.");
+
+	XCTAssertThrows([wedge insertValues:tail count:2 atIndex:11], @"Fails to catch out of bounds on `insert`.");
+}
+
+- (void)testWrite_appendValuesFromSelf
+{
+	const NSUInteger list[] = {0, 1, 2, 3};
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:4];
+	[wedge appendValues:list count:4];
+
+	/// The source moves when the wedge grows.
+	[wedge appendValues:[wedge bytes] count:4];
+	XCTAssertEqual([wedge count], 8, @"Incorrect count.");
+
+	for (NSUInteger i = 0; i < 8; ++i)
+	{
+		XCTAssertEqual([wedge unsignedIntegerAtIndex:i], i % 4, @"Fails to return correct value at index.");
+	}
+}
+
+- (void)testWrite_insertValuesFromSelf
+{
+	const NSUInteger list[] = {0, 1, 2, 3};
+	const NSUInteger expected[] = {0, 1, 1, 2, 3, 2, 3};
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:4];
+	[wedge appendValues:list count:4];
+
+	/// The source straddles the gap and moves when the wedge grows.
+	[wedge insertValues:(const NSUInteger *)[wedge bytes] + 1 count:3 atIndex:2];
+	XCTAssertEqual([wedge count], 7, @"Incorrect count.");
+
+	for (NSUInteger i = 0; i < 7; ++i)
+	{
+		XCTAssertEqual([wedge unsignedIntegerAtIndex:i], expected[i], @"Fails to return correct value at index.");
+	}
+}
+
 @end
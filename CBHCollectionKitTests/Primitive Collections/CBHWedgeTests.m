@@ -19,9 +19,36 @@
 @import XCTest;
 @import CBHCollectionKit.CBHWedge;
 
+#include <malloc/malloc.h>
+
 #import "CBHWedgeTestMacros.h"
 
 
+static NSComparisonResult CBHCompareDescending(const void *a, const void *b, void *context)
+{
+	NSUInteger lhs = *(const NSUInteger *)a;
+	NSUInteger rhs = *(const NSUInteger *)b;
+
+	if ( lhs > rhs ) return NSOrderedAscending;
+	if ( lhs < rhs ) return NSOrderedDescending;
+	return NSOrderedSame;
+}
+
+static void CBHDouble(void *entries, NSUInteger count, void *context)
+{
+	NSUInteger *values = (NSUInteger *)entries;
+	for (NSUInteger i = 0; i < count; ++i) { values[i] *= 2; }
+}
+
+static void CBHSum(void *accumulator, const void *entries, NSUInteger count, void *context)
+{
+	const NSUInteger *values = (const NSUInteger *)entries;
+	NSUInteger sum = *(NSUInteger *)accumulator;
+	for (NSUInteger i = 0; i < count; ++i) { sum += values[i]; }
+	*(NSUInteger *)accumulator = sum;
+}
+
+
 @interface CBHWedgeTests : XCTestCase
 @end
 
@@ -107,6 +134,100 @@
 	XCTAssertThrows([CBHSlice sliceWithEntrySize:sizeof(NSUInteger) copying:NSUIntegerMax entriesFromBytes:list], @"Fails to catch overflow error.");
 }
 
+- (void)testInitialization_aligned
+{
+	CBHAllocationOptions options = CBHAllocationOptionsMake(CBHCacheLineSize, CBHAllocationFlagsNone);
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:3 options:options];
+	CBHAssertWedgeState(wedge, 3, 0, NSUInteger, YES);
+
+	XCTAssertEqual((uintptr_t)[wedge bytes] % CBHCacheLineSize, 0, @"Buffer is not aligned.");
+	XCTAssertEqual([wedge allocationOptions].alignment, CBHCacheLineSize, @"Fails to keep options.");
+
+	/// Growing keeps the alignment.
+	for (NSUInteger i = 0; i < 100; ++i)
+	{
+		[wedge appendUnsignedInteger:i];
+		XCTAssertEqual((uintptr_t)[wedge bytes] % CBHCacheLineSize, 0, @"Growth loses alignment.");
+	}
+
+	[wedge resize:10];
+	XCTAssertEqual((uintptr_t)[wedge bytes] % CBHCacheLineSize, 0, @"Shrinking loses alignment.");
+
+	for (NSUInteger i = 0; i < 10; ++i)
+	{
+		XCTAssertEqual([wedge unsignedIntegerAtIndex:i], i, @"Entry is incorrectly set.");
+	}
+
+	/// Writing to a copy moves it to a buffer allocated the same way.
+	CBHWedge *copy = [[wedge copy] autorelease];
+	[copy appendUnsignedInteger:10];
+	XCTAssertNotEqual([copy bytes], [wedge bytes], @"Fails to separate bytes on write.");
+	XCTAssertEqual((uintptr_t)[copy bytes] % CBHCacheLineSize, 0, @"Copy loses alignment.");
+	XCTAssertEqual([copy allocationOptions].alignment, CBHCacheLineSize, @"Copy loses options.");
+}
+
+- (void)testInitialization_hugePages
+{
+	const NSUInteger capacity = (CBHHugePageSize / sizeof(NSUInteger)) + 1;
+	CBHAllocationOptions options = CBHAllocationOptionsMake(0, CBHAllocationHugePages | CBHAllocationPrefault);
+
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:capacity options:options];
+	CBHAssertWedgeState(wedge, capacity, 0, NSUInteger, YES);
+	XCTAssertEqual((uintptr_t)[wedge bytes] % CBHHugePageSize, 0, @"Large buffer is not aligned to huge pages.");
+
+	for (NSUInteger i = 0; i <= capacity; ++i) { [wedge appendUnsignedInteger:i]; }
+	XCTAssertEqual((uintptr_t)[wedge bytes] % CBHHugePageSize, 0, @"Growth loses huge page alignment.");
+	XCTAssertEqual([wedge unsignedIntegerAtIndex:capacity], capacity, @"Entry is incorrectly set.");
+
+	/// Small buffers are left to the default alignment.
+	CBHWedge *small = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:8 options:options];
+	[small appendUnsignedInteger:1];
+	XCTAssertEqual([small unsignedIntegerAtIndex:0], 1, @"Entry is incorrectly set.");
+}
+
+- (void)testInitialization_badAlignment
+{
+	XCTAssertThrows(CBHAllocationOptionsMake(48, CBHAllocationFlagsNone), @"Fails to catch alignment that isn't a power of two.");
+	XCTAssertNoThrow(CBHAllocationOptionsMake(0, CBHAllocationFlagsNone), @"Rejects the default alignment.");
+}
+
+
+- (void)testInitialization_inline
+{
+	CBHWedge *wedge = [[CBHWedge alloc] initWithEntrySize:sizeof(NSUInteger) andCapacity:8];
+
+	/// Eight entries fit inside the object.
+	const uintptr_t start = (uintptr_t)wedge;
+	XCTAssertTrue((uintptr_t)[wedge bytes] > start && (uintptr_t)[wedge bytes] < start + malloc_size(wedge), @"Small wedge allocates a buffer.");
+	XCTAssertEqual((uintptr_t)[wedge bytes] % (2 * sizeof(void *)), 0, @"Inline bytes are misaligned.");
+
+	for (NSUInteger i = 0; i < 9; ++i) { [wedge appendUnsignedInteger:i]; }
+	XCTAssertFalse((uintptr_t)[wedge bytes] > start && (uintptr_t)[wedge bytes] < start + malloc_size(wedge), @"Fails to move to the heap on overflow.");
+	for (NSUInteger i = 0; i < 9; ++i) { XCTAssertEqual([wedge unsignedIntegerAtIndex:i], i, @"Entry is incorrect after overflow."); }
+
+	/// Larger wedges start on the heap.
+	CBHWedge *large = [[[CBHWedge alloc] initWithEntrySize:sizeof(NSUInteger) andCapacity:9] autorelease];
+	XCTAssertFalse((uintptr_t)[large bytes] > (uintptr_t)large && (uintptr_t)[large bytes] < (uintptr_t)large + malloc_size(large), @"Too large for inline bytes.");
+
+	[wedge release];
+}
+
+- (void)testInitialization_inlineShared
+{
+	CBHWedge *wedge = [[CBHWedge alloc] initWithEntrySize:sizeof(NSUInteger) andCapacity:4];
+	for (NSUInteger i = 0; i < 4; ++i) { [wedge appendUnsignedInteger:i]; }
+
+	/// Sharing moves the bytes out of the object so they outlive it.
+	CBHWedge *copy = [[wedge copy] autorelease];
+	NSData *data = [wedge dataNoCopy];
+	XCTAssertEqual([copy bytes], [wedge bytes], @"Fails to share bytes with copy.");
+	[wedge release];
+
+	XCTAssertEqual([copy count], 4, @"Incorrect count.");
+	XCTAssertEqual(((const NSUInteger *)[data bytes])[3], 3, @"Shared bytes freed with the wedge.");
+	XCTAssertEqual([copy unsignedIntegerAtIndex:3], 3, @"Shared bytes freed with the wedge.");
+}
+
 
 #pragma mark - Copying
 
@@ -133,6 +254,24 @@
 	XCTAssertNotEqualObjects(wedge, copy);
 }
 
+- (void)testCopy_sharesBytes
+{
+	const NSUInteger list[] = {0, 1, 2, 3, 4, 5, 6, 7};
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) copying:8 entriesFromBytes:list];
+
+	CBHWedge *copy = [[wedge copy] autorelease];
+	XCTAssertEqual([copy bytes], [wedge bytes], @"Fails to share bytes with copy.");
+
+	[copy appendUnsignedInteger:8];
+	XCTAssertNotEqual([copy bytes], [wedge bytes], @"Fails to separate bytes on write.");
+	CBHAssertWedgeState(wedge, 8, 8, NSUInteger, NO);
+	XCTAssertEqual([copy count], 9, @"Incorrect count.");
+	XCTAssertEqual([copy unsignedIntegerAtIndex:8], 8, @"Fails to append to copy.");
+
+	[wedge removeAll];
+	XCTAssertEqual([copy unsignedIntegerAtIndex:7], 7, @"Removal is visible through copy.");
+}
+
 
 #pragma mark - Equality
 
@@ -276,6 +415,9 @@
 
 	const NSUInteger hash12 = [[CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) copying:8 entriesFromBytes:list0] hash];
 	XCTAssertEqual(hash0, hash12, @"Hash of the same data should be equal.");
+
+	const NSUInteger hash13 = [[CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:100 copying:8 entriesFromBytes:list0] hash];
+	XCTAssertEqual(hash0, hash13, @"Hash depends on capacity.");
 }
 
 
@@ -336,6 +478,35 @@
 	XCTAssertEqualObjects(wedge, expected, @"Fails to convert slice to string or data.");
 }
 
+- (void)testConversion_dataNoCopy
+{
+	CBHWedgeCreateDefault(wedge, NSUInteger);
+	[wedge resize:32];
+
+	NSData *data = [wedge dataNoCopy];
+	XCTAssertEqual([data length], 8 * sizeof(NSUInteger), @"Incorrect length.");
+	XCTAssertEqual([data bytes], [wedge bytes], @"Fails to share bytes.");
+}
+
+- (void)testConversion_adoptingData
+{
+	const NSUInteger list[] = {0, 1, 2, 3, 4, 5, 6, 7};
+	NSMutableData *data = [NSMutableData dataWithBytes:list length:sizeof(list)];
+
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) adoptingData:data];
+	XCTAssertEqual([wedge count], 8, @"Incorrect count.");
+	XCTAssertEqual([wedge bytes], [data bytes], @"Fails to share bytes.");
+
+	/// Growing detaches from the data.
+	NSUInteger value = 8;
+	[wedge appendValue:&value];
+	XCTAssertNotEqual([wedge bytes], [data bytes], @"Fails to detach on growth.");
+	XCTAssertEqual([data length], sizeof(list), @"Modified adopted data.");
+	XCTAssertEqual([wedge unsignedIntegerAtIndex:8], 8, @"Fails to append.");
+
+	XCTAssertThrows([CBHWedge wedgeWithEntrySize:3 adoptingData:data], @"Fails to catch bad length.");
+}
+
 
 #pragma mark - Resizing
 
@@ -717,4 +888,203 @@
 	XCTAssertTrue([description compare:expected], @"Description is wrong");
 }
 
+
+
+#pragma mark - Sorting
+
+- (void)testSort_values
+{
+	const NSUInteger list[] = {7, 6, 5, 4, 3, 2, 1, 0, 42, 42};
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:16 copying:8 entriesFromBytes:list];
+	CBHAssertWedgeState(wedge, 16, 8, NSUInteger, NO);
+
+	/// Only the entries in use are sorted.
+	[wedge sortAsType:CBHPrimitiveTypeUnsigned];
+	CBHAssertWedgeDefault(wedge, NSUInteger, unsignedInteger);
+}
+
+- (void)testSort_function
+{
+	CBHWedgeCreateDefault(wedge, NSUInteger);
+
+	[wedge sortUsingFunction:CBHCompareDescending context:NULL];
+
+	/// Check new values
+	for (NSUInteger i = 0; i < 8; ++i)
+	{
+		XCTAssertEqual([wedge unsignedIntegerAtIndex:i], 7 - i, @"Fails to return correct value at index.");
+	}
+
+	[wedge sortAsType:CBHPrimitiveTypeUnsigned];
+	CBHAssertWedgeDefault(wedge, NSUInteger, unsignedInteger);
+}
+
+- (void)testSort_empty
+{
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger)];
+
+	XCTAssertNoThrow([wedge sortAsType:CBHPrimitiveTypeUnsigned]);
+	XCTAssertNoThrow([wedge sortUsingFunction:CBHCompareDescending context:NULL]);
+	CBHAssertWedgeState(wedge, 8, 0, NSUInteger, YES);
+}
+
+
+#pragma mark - Parallel Operations
+
+- (void)testParallel_fill
+{
+	CBHWedgeCreateDefault(wedge, NSUInteger);
+	[wedge resize:32];
+
+	/// Only the entries in use are filled.
+	const NSUInteger value = 0x0102030405060708;
+	[wedge fillWithValue:&value];
+	CBHAssertWedgeState(wedge, 32, 8, NSUInteger, NO);
+
+	for (NSUInteger i = 0; i < 8; ++i)
+	{
+		XCTAssertEqual([wedge unsignedIntegerAtIndex:i], value, @"Fails to fill value at index.");
+	}
+}
+
+- (void)testParallel_transformAndReduce
+{
+	const NSUInteger count = 1 << 20;
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:count];
+	for (NSUInteger i = 0; i < count; ++i) { [wedge appendUnsignedInteger:i]; }
+
+	[wedge transformUsingFunction:CBHDouble context:NULL];
+	XCTAssertEqual([wedge unsignedIntegerAtIndex:count - 1], (count - 1) * 2, @"Fails to transform value at index.");
+
+	const NSUInteger identity = 0;
+	NSUInteger sum = 0;
+	[wedge reduceUsingFunction:CBHSum identity:&identity context:NULL result:&sum];
+	XCTAssertEqual(sum, count * (count - 1), @"Fails to reduce values.");
+}
+
+- (void)testParallel_empty
+{
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger)];
+
+	const NSUInteger identity = 7;
+	NSUInteger result = 0;
+	[wedge reduceUsingFunction:CBHSum identity:&identity context:NULL result:&result];
+	XCTAssertEqual(result, identity, @"Fails to return identity when empty.");
+
+	__block NSUInteger calls = 0;
+	[wedge forEachChunk:^(const void *entries, NSRange range) { ++calls; }];
+	XCTAssertEqual(calls, 0, @"Fails to skip an empty wedge.");
+}
+
+
+#pragma mark - Enumeration
+
+- (void)testEnumeration_values
+{
+	CBHWedgeCreateDefault(wedge, NSUInteger);
+
+	__block NSUInteger calls = 0;
+	[wedge enumerateValuesUsingBlock:^(const void *value, NSUInteger index, BOOL *stop) {
+		XCTAssertEqual(index, calls, @"Fails to enumerate in order.");
+		XCTAssertEqual(*(const NSUInteger *)value, index, @"Fails to point at the entry.");
+		++calls;
+	}];
+	XCTAssertEqual(calls, 8, @"Enumerated wrong number of times.");
+}
+
+- (void)testEnumeration_reverse
+{
+	CBHWedgeCreateDefault(wedge, NSUInteger);
+
+	__block NSUInteger calls = 0;
+	[wedge enumerateValuesWithOptions:NSEnumerationReverse usingBlock:^(const void *value, NSUInteger index, BOOL *stop) {
+		XCTAssertEqual(index, 7 - calls, @"Fails to enumerate in reverse.");
+		XCTAssertEqual(*(const NSUInteger *)value, index, @"Fails to point at the entry.");
+		++calls;
+	}];
+	XCTAssertEqual(calls, 8, @"Enumerated wrong number of times.");
+}
+
+- (void)testEnumeration_stop
+{
+	CBHWedgeCreateDefault(wedge, NSUInteger);
+
+	__block NSUInteger calls = 0;
+	[wedge enumerateValuesUsingBlock:^(const void *value, NSUInteger index, BOOL *stop) {
+		++calls;
+		if ( index == 3 ) { *stop = YES; }
+	}];
+	XCTAssertEqual(calls, 4, @"Fails to stop enumerating.");
+}
+
+- (void)testEnumeration_range
+{
+	CBHWedgeCreateDefault(wedge, NSUInteger);
+
+	__block NSUInteger sum = 0;
+	[wedge enumerateValuesInRange:NSMakeRange(2, 4) options:0 usingBlock:^(const void *value, NSUInteger index, BOOL *stop) {
+		XCTAssertTrue(index >= 2 && index < 6, @"Fails to respect range.");
+		sum += *(const NSUInteger *)value;
+	}];
+	XCTAssertEqual(sum, 2 + 3 + 4 + 5, @"Fails to enumerate range.");
+
+	XCTAssertThrows([wedge enumerateValuesInRange:NSMakeRange(6, 3) options:0 usingBlock:^(const void *value, NSUInteger index, BOOL *stop) {}]);
+	XCTAssertThrows([wedge enumerateValuesInRange:NSMakeRange(9, 0) options:0 usingBlock:^(const void *value, NSUInteger index, BOOL *stop) {}]);
+}
+
+- (void)testEnumeration_concurrent
+{
+	const NSUInteger count = 1 << 16;
+	CBHWedge *wedge = [CBHWedge wedgeWithEntrySize:sizeof(NSUInteger) andCapacity:count];
+	for (NSUInteger i = 0; i < count; ++i) { [wedge appendUnsignedInteger:i]; }
+
+	/// Each entry must be visited exactly once.
+	unsigned char *visits = calloc(count, sizeof(unsigned char));
+	XCTAssertTrue(visits != NULL);
+
+	[wedge enumerateValuesWithOptions:NSEnumerationConcurrent usingBlock:^(const void *value, NSUInteger index, BOOL *stop) {
+		XCTAssertEqual(*(const NSUInteger *)value, index);
+		__atomic_add_fetch(&visits[index], 1, __ATOMIC_RELAXED);
+	}];
+
+	NSUInteger missed = 0;
+	for (NSUInteger i = 0; i < count; ++i) { if ( visits[i] != 1 ) { ++missed; } }
+	XCTAssertEqual(missed, 0, @"Fails to visit each entry once.");
+
+	free(visits);
+}
+
+
+#pragma mark - Unsafe Access
+
+- (void)testUnsafeBytes
+{
+	CBHWedgeCreateDefault(wedge, NSUInteger);
+	[wedge resize:32];
+
+	[wedge withUnsafeBytes:^(CBHSliceView view) {
+		/// Only entries in use are visible.
+		XCTAssertEqual(view.count, 8);
+
+		const NSUInteger *values = CBHSliceView_entries(view, NSUInteger);
+		for (NSUInteger i = 0; i < view.count; ++i) { XCTAssertEqual(values[i], i); }
+	}];
+}
+
+- (void)testUnsafeMutableBytes_resized
+{
+	CBHWedgeCreateDefault(wedge, NSUInteger);
+
+	[wedge withUnsafeMutableBytes:^(CBHMutableSliceView view) {
+		NSUInteger value = 8;
+		[wedge appendValue:&value];
+		XCTAssertFalse(CBHMutableSliceView_isValid(view), @"Fails to detect growth.");
+
+#if DEBUG
+		XCTAssertThrows(CBHMutableSliceView_entries(view, NSUInteger), @"Fails to catch stale view.");
+		XCTAssertThrows(CBHMutableSliceView_valueAtIndex(view, 0), @"Fails to catch stale view.");
+#endif
+	}];
+}
+
 @end
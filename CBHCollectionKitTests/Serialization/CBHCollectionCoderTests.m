@@ -0,0 +1,359 @@
+//  CBHCollectionCoderTests.m
+//  CBHCollectionKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import XCTest;
+
+#include <fcntl.h>
+#include <unistd.h>
+
+@import CBHCollectionKit.CBHCollectionCoder;
+@import CBHCollectionKit.CBHObjectCodec;
+@import CBHCollectionKit.CBHSlice;
+@import CBHCollectionKit.CBHWedge;
+@import CBHCollectionKit.CBHSortedWedge;
+@import CBHCollectionKit.CBHStack;
+@import CBHCollectionKit.CBHQueue;
+@import CBHCollectionKit.CBHHeap;
+
+
+#define CBHCreateDefaultWedge(aName, aCount)\
+CBHWedge *aName = [CBHWedge wedgeWithEntrySize:sizeof(uint32_t)];\
+for (uint32_t i = 0; i < (aCount); ++i) { [aName appendUInt32:i * 3]; }
+
+#define CBHCreateDefaultStrings(aName, aCount)\
+NSMutableArray<NSString *> *aName = [NSMutableArray arrayWithCapacity:(aCount)];\
+for (NSUInteger i = 0; i < (aCount); ++i) { [aName addObject:[NSString stringWithFormat:@"%lu", i]]; }
+
+
+@interface CBHCollectionCoderTests : XCTestCase
+@end
+
+
+@implementation CBHCollectionCoderTests
+
+#pragma mark - Primitive Collections
+
+- (void)test_slice_roundTrip
+{
+	CBHSlice *slice = [CBHSlice sliceWithEntrySize:sizeof(uint64_t) copying:4 entriesFromBytes:(uint64_t[]){1, 2, 3, 4}];
+
+	NSMutableData *data = [NSMutableData data];
+	CBHCollectionEncoder *encoder = [[[CBHCollectionEncoder alloc] initWithMutableData:data] autorelease];
+	XCTAssertTrue([slice encodeWithCollectionEncoder:encoder], @"Fails to encode: %@", [encoder error]);
+	XCTAssertEqual([data length], sizeof(CBHCollectionHeader) + (4 * sizeof(uint64_t)), @"Incorrect length.");
+
+	CBHCollectionDecoder *decoder = [[[CBHCollectionDecoder alloc] initWithData:data] autorelease];
+	CBHSlice *decoded = [[[CBHSlice alloc] initWithCollectionDecoder:decoder] autorelease];
+	XCTAssertNotNil(decoded, @"Fails to decode: %@", [decoder error]);
+	XCTAssertEqualObjects(decoded, slice, @"Fails to round trip.");
+}
+
+- (void)test_wedge_roundTrip
+{
+	CBHCreateDefaultWedge(wedge, 100);
+
+	NSMutableData *data = [NSMutableData data];
+	CBHCollectionEncoder *encoder = [[[CBHCollectionEncoder alloc] initWithMutableData:data] autorelease];
+	XCTAssertTrue([wedge encodeWithCollectionEncoder:encoder], @"Fails to encode.");
+
+	/// Unused capacity isn't written.
+	XCTAssertEqual([data length], sizeof(CBHCollectionHeader) + (100 * sizeof(uint32_t)), @"Incorrect length.");
+
+	CBHCollectionDecoder *decoder = [[[CBHCollectionDecoder alloc] initWithData:data] autorelease];
+	CBHWedge *decoded = [[[CBHWedge alloc] initWithCollectionDecoder:decoder] autorelease];
+	XCTAssertEqualObjects(decoded, wedge, @"Fails to round trip.");
+
+	/// Decoded wedges still grow.
+	[decoded appendUInt32:7];
+	XCTAssertEqual([decoded count], (NSUInteger)101, @"Incorrect count.");
+}
+
+- (void)test_sortedWedge_roundTrip
+{
+	CBHSortedWedge *wedge = [CBHSortedWedge sortedWedgeWithEntrySize:sizeof(int32_t) type:CBHPrimitiveTypeSigned];
+	[wedge insertValues:(int32_t[]){5, -3, 9, 0, -7} count:5];
+
+	NSMutableData *data = [NSMutableData data];
+	CBHCollectionEncoder *encoder = [[[CBHCollectionEncoder alloc] initWithMutableData:data] autorelease];
+	XCTAssertTrue([wedge encodeWithCollectionEncoder:encoder], @"Fails to encode.");
+
+	CBHCollectionDecoder *decoder = [[[CBHCollectionDecoder alloc] initWithData:data] autorelease];
+	CBHSortedWedge *decoded = [[[CBHSortedWedge alloc] initWithCollectionDecoder:decoder type:CBHPrimitiveTypeSigned] autorelease];
+	XCTAssertEqualObjects(decoded, wedge, @"Fails to round trip.");
+
+	/// Entries written by a plain wedge are sorted as they're read.
+	CBHWedge *unsorted = [CBHWedge wedgeWithEntrySize:sizeof(int32_t) copying:3 entriesFromBytes:(int32_t[]){3, 1, 2}];
+	data = [NSMutableData data];
+	encoder = [[[CBHCollectionEncoder alloc] initWithMutableData:data] autorelease];
+	XCTAssertTrue([unsorted encodeWithCollectionEncoder:encoder], @"Fails to encode.");
+
+	decoder = [[[CBHCollectionDecoder alloc] initWithData:data] autorelease];
+	decoded = [[[CBHSortedWedge alloc] initWithCollectionDecoder:decoder type:CBHPrimitiveTypeSigned] autorelease];
+	const int32_t *values = [decoded bytes];
+	XCTAssertTrue(values[0] == 1 && values[1] == 2 && values[2] == 3, @"Fails to sort.");
+}
+
+- (void)test_primitive_checksum
+{
+	CBHCreateDefaultWedge(wedge, 16);
+
+	NSMutableData *data = [NSMutableData data];
+	CBHCollectionEncoder *encoder = [[[CBHCollectionEncoder alloc] initWithMutableData:data] autorelease];
+	XCTAssertTrue([wedge encodeWithCollectionEncoder:encoder], @"Fails to encode.");
+
+	((uint8_t *)[data mutableBytes])[[data length] - 1] ^= 0x01;
+
+	CBHCollectionDecoder *decoder = [[[CBHCollectionDecoder alloc] initWithData:data] autorelease];
+	XCTAssertNil([[[CBHWedge alloc] initWithCollectionDecoder:decoder] autorelease], @"Fails to catch corruption.");
+	XCTAssertEqualObjects([[decoder error] domain], CBHCollectionFormatErrorDomain, @"Incorrect error domain.");
+	XCTAssertEqual([[decoder error] code], CBHCollectionFormatErrorChecksum, @"Incorrect error.");
+}
+
+- (void)test_primitive_truncated
+{
+	CBHCreateDefaultWedge(wedge, 16);
+
+	NSMutableData *data = [NSMutableData data];
+	CBHCollectionEncoder *encoder = [[[CBHCollectionEncoder alloc] initWithMutableData:data] autorelease];
+	XCTAssertTrue([wedge encodeWithCollectionEncoder:encoder], @"Fails to encode.");
+
+	[data setLength:[data length] - 1];
+
+	CBHCollectionDecoder *decoder = [[[CBHCollectionDecoder alloc] initWithData:data] autorelease];
+	XCTAssertNil([[[CBHWedge alloc] initWithCollectionDecoder:decoder] autorelease], @"Fails to catch truncation.");
+	XCTAssertEqual([[decoder error] code], CBHCollectionFormatErrorTruncated, @"Incorrect error.");
+}
+
+
+#pragma mark - Object Collections
+
+- (void)test_stack_roundTrip
+{
+	CBHCreateDefaultStrings(strings, 50);
+	CBHStack *stack = [CBHStack stackWithArray:strings];
+
+	NSMutableData *data = [NSMutableData data];
+	CBHCollectionEncoder *encoder = [[[CBHCollectionEncoder alloc] initWithMutableData:data] autorelease];
+	XCTAssertTrue([stack encodeWithCollectionEncoder:encoder codec:[CBHStringCodec codec]], @"Fails to encode: %@", [encoder error]);
+
+	CBHCollectionDecoder *decoder = [[[CBHCollectionDecoder alloc] initWithData:data] autorelease];
+	CBHStack *decoded = [[[CBHStack alloc] initWithCollectionDecoder:decoder codec:[CBHStringCodec codec]] autorelease];
+	XCTAssertEqualObjects(decoded, stack, @"Fails to round trip.");
+	XCTAssertEqualObjects([decoded popObject], @"49", @"Incorrect top.");
+}
+
+- (void)test_queue_roundTrip
+{
+	/// Wraps the ring so both segments are written.
+	CBHQueue *queue = [CBHQueue queueWithCapacity:8];
+	for (NSUInteger i = 0; i < 6; ++i) { [queue enqueueObject:@(i)]; }
+	for (NSUInteger i = 0; i < 4; ++i) { [queue dequeueObject]; }
+	for (NSUInteger i = 6; i < 12; ++i) { [queue enqueueObject:@(i)]; }
+
+	NSMutableData *data = [NSMutableData data];
+	CBHCollectionEncoder *encoder = [[[CBHCollectionEncoder alloc] initWithMutableData:data] autorelease];
+	XCTAssertTrue([queue encodeWithCollectionEncoder:encoder codec:[CBHNumberCodec codec]], @"Fails to encode.");
+
+	CBHCollectionDecoder *decoder = [[[CBHCollectionDecoder alloc] initWithData:data] autorelease];
+	CBHQueue *decoded = [[[CBHQueue alloc] initWithCollectionDecoder:decoder codec:[CBHNumberCodec codec]] autorelease];
+	XCTAssertEqualObjects([decoded array], [queue array], @"Fails to round trip.");
+	XCTAssertEqualObjects([decoded dequeueObject], @4, @"Incorrect head.");
+}
+
+- (void)test_heap_roundTrip
+{
+	NSComparator comparator = ^NSComparisonResult(NSNumber *a, NSNumber *b) { return [a compare:b]; };
+	CBHHeap *heap = [CBHHeap heapWithComparator:comparator andArray:@[@5, @1, @4, @2, @3]];
+
+	NSMutableData *data = [NSMutableData data];
+	CBHCollectionEncoder *encoder = [[[CBHCollectionEncoder alloc] initWithMutableData:data] autorelease];
+	XCTAssertTrue([heap encodeWithCollectionEncoder:encoder codec:[CBHNumberCodec codec]], @"Fails to encode.");
+
+	CBHCollectionDecoder *decoder = [[[CBHCollectionDecoder alloc] initWithData:data] autorelease];
+	CBHHeap *decoded = [[[CBHHeap alloc] initWithComparator:comparator collectionDecoder:decoder codec:[CBHNumberCodec codec]] autorelease];
+	XCTAssertEqualObjects([decoded array], (@[@1, @2, @3, @4, @5]), @"Fails to round trip.");
+}
+
+- (void)test_objects_checksum
+{
+	CBHCreateDefaultStrings(strings, 10);
+	CBHQueue *queue = [CBHQueue queueWithArray:strings];
+
+	NSMutableData *data = [NSMutableData data];
+	CBHCollectionEncoder *encoder = [[[CBHCollectionEncoder alloc] initWithMutableData:data] autorelease];
+	XCTAssertTrue([queue encodeWithCollectionEncoder:encoder codec:[CBHStringCodec codec]], @"Fails to encode.");
+
+	((uint8_t *)[data mutableBytes])[[data length] - 1] ^= 0x01;
+
+	CBHCollectionDecoder *decoder = [[[CBHCollectionDecoder alloc] initWithData:data] autorelease];
+	XCTAssertNil([[[CBHQueue alloc] initWithCollectionDecoder:decoder codec:[CBHStringCodec codec]] autorelease], @"Fails to catch corruption.");
+	XCTAssertEqual([[decoder error] code], CBHCollectionFormatErrorChecksum, @"Incorrect error.");
+}
+
+- (void)test_objects_wrongCodec
+{
+	CBHCreateDefaultWedge(wedge, 4);
+
+	NSMutableData *data = [NSMutableData data];
+	CBHCollectionEncoder *encoder = [[[CBHCollectionEncoder alloc] initWithMutableData:data] autorelease];
+	XCTAssertTrue([wedge encodeWithCollectionEncoder:encoder], @"Fails to encode.");
+
+	/// Primitive entries aren't an object collection.
+	CBHCollectionDecoder *decoder = [[[CBHCollectionDecoder alloc] initWithData:data] autorelease];
+	XCTAssertNil([[[CBHStack alloc] initWithCollectionDecoder:decoder codec:[CBHStringCodec codec]] autorelease], @"Fails to catch primitive collection.");
+	XCTAssertEqual([[decoder error] code], CBHCollectionFormatErrorEntrySize, @"Incorrect error.");
+}
+
+
+#pragma mark - Streams
+
+- (void)test_fileDescriptor_sequence
+{
+	NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+	int fd = open([path fileSystemRepresentation], O_RDWR | O_CREAT | O_TRUNC, 0600);
+	XCTAssertTrue(fd >= 0, @"Fails to open file.");
+
+	CBHCreateDefaultWedge(wedge, 1000);
+	CBHCreateDefaultStrings(strings, 1000);
+	CBHStack *stack = [CBHStack stackWithArray:strings];
+
+	/// Collections are written back to back into one stream.
+	CBHCollectionEncoder *encoder = [[CBHCollectionEncoder alloc] initWithFileDescriptor:fd];
+	XCTAssertTrue([wedge encodeWithCollectionEncoder:encoder], @"Fails to encode wedge.");
+	XCTAssertTrue([stack encodeWithCollectionEncoder:encoder codec:[CBHStringCodec codec]], @"Fails to encode stack.");
+	XCTAssertTrue([encoder flush], @"Fails to flush.");
+	[encoder release];
+
+	lseek(fd, 0, SEEK_SET);
+
+	CBHCollectionDecoder *decoder = [[[CBHCollectionDecoder alloc] initWithFileDescriptor:fd] autorelease];
+	XCTAssertEqualObjects([[[CBHWedge alloc] initWithCollectionDecoder:decoder] autorelease], wedge, @"Fails to decode wedge.");
+	XCTAssertEqualObjects([[[CBHStack alloc] initWithCollectionDecoder:decoder codec:[CBHStringCodec codec]] autorelease], stack, @"Fails to decode stack.");
+
+	close(fd);
+	[[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+- (void)test_pipe_growsWhileDecoding
+{
+	int fds[2];
+	XCTAssertEqual(pipe(fds), 0, @"Fails to open pipe.");
+
+	/// More entries than are reserved up front when the length is unknown.
+	CBHCreateDefaultWedge(wedge, 300000);
+
+	CBHCollectionEncoder *encoder = [[CBHCollectionEncoder alloc] initWithFileDescriptor:fds[1]];
+	dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+		[wedge encodeWithCollectionEncoder:encoder];
+		[encoder flush];
+		[encoder release];
+		close(fds[1]);
+	});
+
+	CBHCollectionDecoder *decoder = [[[CBHCollectionDecoder alloc] initWithFileDescriptor:fds[0]] autorelease];
+	XCTAssertEqualObjects([[[CBHWedge alloc] initWithCollectionDecoder:decoder] autorelease], wedge, @"Fails to decode wedge.");
+
+	close(fds[0]);
+}
+
+- (void)test_pipe_corruptCount
+{
+	int fds[2];
+	XCTAssertEqual(pipe(fds), 0, @"Fails to open pipe.");
+
+	/// A header claiming far more entries than follow it.
+	CBHCollectionHeader header = CBHCollectionHeaderMake(sizeof(uint64_t), (uint64_t)1 << 40);
+	const uint64_t entries[4] = {1, 2, 3, 4};
+	XCTAssertEqual(write(fds[1], &header, sizeof(header)), (ssize_t)sizeof(header), @"Fails to write header.");
+	XCTAssertEqual(write(fds[1], entries, sizeof(entries)), (ssize_t)sizeof(entries), @"Fails to write entries.");
+	close(fds[1]);
+
+	CBHCollectionDecoder *decoder = [[[CBHCollectionDecoder alloc] initWithFileDescriptor:fds[0]] autorelease];
+	XCTAssertNil([[[CBHSlice alloc] initWithCollectionDecoder:decoder] autorelease], @"Fails to catch truncation.");
+	XCTAssertEqual([[decoder error] code], CBHCollectionFormatErrorTruncated, @"Incorrect error.");
+
+	close(fds[0]);
+}
+
+
+#pragma mark - Codecs
+
+- (void)test_codecs
+{
+	NSArray *objects = @[@"", @"héllo", [@"" stringByPaddingToLength:1000 withString:@"x" startingAtIndex:0]];
+	NSArray *numbers = @[@YES, @(-42), @(UINT64_MAX), @(3.25)];
+	NSArray *datas = @[[NSData data], [@"bytes" dataUsingEncoding:NSUTF8StringEncoding]];
+	NSArray *dates = @[[NSDate dateWithTimeIntervalSince1970:0], [NSDate dateWithTimeIntervalSince1970:1e9]];
+
+	CBHArchivingCodec *archiving = [[[CBHArchivingCodec alloc] initWithClasses:[NSSet setWithObject:[NSDate class]]] autorelease];
+
+	NSArray *pairs = @[@[objects, [CBHStringCodec codec]], @[numbers, [CBHNumberCodec codec]], @[datas, [CBHDataCodec codec]], @[dates, archiving]];
+	for (NSArray *pair in pairs)
+	{
+		CBHQueue *queue = [CBHQueue queueWithArray:pair[0]];
+
+		NSMutableData *data = [NSMutableData data];
+		CBHCollectionEncoder *encoder = [[[CBHCollectionEncoder alloc] initWithMutableData:data] autorelease];
+		XCTAssertTrue([queue encodeWithCollectionEncoder:encoder codec:pair[1]], @"Fails to encode %@.", pair[1]);
+
+		CBHCollectionDecoder *decoder = [[[CBHCollectionDecoder alloc] initWithData:data] autorelease];
+		CBHQueue *decoded = [[[CBHQueue alloc] initWithCollectionDecoder:decoder codec:pair[1]] autorelease];
+		XCTAssertEqualObjects([decoded array], pair[0], @"Fails to round trip %@.", pair[1]);
+	}
+
+	/// Numbers keep their kind.
+	NSData *encoded = [NSMutableData data];
+	CBHCollectionEncoder *encoder = [[[CBHCollectionEncoder alloc] initWithMutableData:(NSMutableData *)encoded] autorelease];
+	[[CBHQueue queueWithArray:@[@(3.25)]] encodeWithCollectionEncoder:encoder codec:[CBHNumberCodec codec]];
+	CBHCollectionDecoder *decoder = [[[CBHCollectionDecoder alloc] initWithData:encoded] autorelease];
+	NSNumber *number = [[[[CBHQueue alloc] initWithCollectionDecoder:decoder codec:[CBHNumberCodec codec]] autorelease] dequeueObject];
+	XCTAssertEqual(strcmp([number objCType], @encode(double)), 0, @"Fails to keep kind.");
+}
+
+
+#pragma mark - Secure Coding
+
+- (void)test_secureCoding
+{
+	CBHCreateDefaultWedge(wedge, 20);
+	CBHSortedWedge *sorted = [CBHSortedWedge sortedWedgeWithWedge:wedge type:CBHPrimitiveTypeUnsigned];
+	CBHCreateDefaultStrings(strings, 20);
+	CBHQueue *queue = [CBHQueue queueWithArray:strings];
+
+	NSArray *collections = @[[wedge slice], wedge, sorted, [CBHStack stackWithArray:strings], queue];
+	for (id collection in collections)
+	{
+		NSMutableData *data = [NSMutableData data];
+		NSKeyedArchiver *archiver = [[NSKeyedArchiver alloc] initForWritingWithMutableData:data];
+		[archiver setRequiresSecureCoding:YES];
+		[archiver encodeObject:collection forKey:NSKeyedArchiveRootObjectKey];
+		[archiver finishEncoding];
+		[archiver release];
+
+		NSKeyedUnarchiver *unarchiver = [[NSKeyedUnarchiver alloc] initForReadingWithData:data];
+		[unarchiver setRequiresSecureCoding:YES];
+		NSSet *classes = [NSSet setWithObjects:[collection class], [NSString class], nil];
+		id decoded = [unarchiver decodeObjectOfClasses:classes forKey:NSKeyedArchiveRootObjectKey];
+		[unarchiver finishDecoding];
+		[unarchiver release];
+
+		XCTAssertEqualObjects(decoded, collection, @"Fails to round trip %@.", [collection class]);
+	}
+}
+
+@end
@@ -0,0 +1,169 @@
+//  CBHSliceReaderTests.m
+//  CBHCollectionKitTests
+//
+//  Created by Christian Huxtable <chris@huxtable.ca>, October 2026.
+//  Copyright (c) 2026 Christian Huxtable. All rights reserved.
+//
+//  Permission to use, copy, modify, and/or distribute this software for any
+//  purpose with or without fee is hereby granted, provided that the above
+//  copyright notice and this permission notice appear in all copies.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+//  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+//  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+//  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+//  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+//  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+//  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+@import XCTest;
+
+@import CBHCollectionKit.CBHSliceReader;
+@import CBHCollectionKit.CBHMutableSlice;
+@import CBHCollectionKit.CBHWedge;
+
+
+#define CBHWriteDefaultFile(aPath, aCount, anOptions)\
+NSString *aPath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];\
+{\
+	CBHWedge *__wedge = [CBHWedge wedgeWithEntrySize:sizeof(uint64_t) andCapacity:(aCount)];\
+	for (uint64_t i = 0; i < (aCount); ++i) { [__wedge appendUInt64:i]; }\
+	XCTAssertTrue([[__wedge slice] writeToFile:aPath options:(anOptions) error:NULL], @"Fails to write file.");\
+}
+
+
+@interface CBHSliceReaderTests : XCTestCase
+@end
+
+
+@implementation CBHSliceReaderTests
+
+- (void)test_windows
+{
+	CBHWriteDefaultFile(path, 1000, CBHSliceFileOptionsNone);
+
+	NSError *error = nil;
+	CBHSliceReader *reader = [[[CBHSliceReader alloc] initWithContentsOfFile:path entrySize:sizeof(uint64_t) windowSize:64 options:CBHSliceFileOptionsNone error:&error] autorelease];
+	XCTAssertNotNil(reader, @"Fails to open: %@", error);
+	XCTAssertEqual([reader count], (NSUInteger)1000, @"Incorrect count.");
+
+	uint64_t expected = 0;
+	NSUInteger windows = 0;
+
+	CBHSlice *slice = nil;
+	while ( (slice = [reader nextSlice]) )
+	{
+		/// Only the last window is partial.
+		XCTAssertEqual([slice count], ( expected + 64 <= 1000 ) ? (NSUInteger)64 : (NSUInteger)(1000 % 64), @"Incorrect window size.");
+
+		const uint64_t *values = [slice bytes];
+		for (NSUInteger i = 0; i < [slice count]; ++i) { XCTAssertEqual(values[i], expected++, @"Incorrect entry."); }
+		++windows;
+	}
+
+	XCTAssertNil([reader error], @"Fails with: %@", [reader error]);
+	XCTAssertEqual(windows, (NSUInteger)16, @"Incorrect window count.");
+	XCTAssertEqual([reader bytesRead], (uint64_t)(1000 * sizeof(uint64_t)), @"Incorrect bytes read.");
+	XCTAssertTrue([reader bytesPerSecond] > 0.0, @"Fails to measure throughput.");
+	XCTAssertNil([reader nextSlice], @"Fails to stay finished.");
+
+	[[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+- (void)test_header
+{
+	CBHWriteDefaultFile(path, 100, CBHSliceFileHeader);
+
+	CBHSliceReader *reader = [CBHSliceReader readerWithContentsOfFile:path entrySize:sizeof(uint64_t) windowSize:30 options:CBHSliceFileHeader | CBHSliceFileAdviseWillNeed];
+	XCTAssertEqual([reader count], (NSUInteger)100, @"Incorrect count.");
+
+	__block uint64_t sum = 0;
+	XCTAssertTrue([reader enumerateSlicesUsingBlock:^(CBHSlice *slice, BOOL *stop) {
+		const uint64_t *values = [slice bytes];
+		for (NSUInteger i = 0; i < [slice count]; ++i) { sum += values[i]; }
+	}], @"Fails to enumerate.");
+	XCTAssertEqual(sum, (uint64_t)(99 * 100 / 2), @"Incorrect entries.");
+
+	/// A headerless file is rejected when a header is expected.
+	NSError *error = nil;
+	CBHWriteDefaultFile(raw, 10, CBHSliceFileOptionsNone);
+	XCTAssertNil([[[CBHSliceReader alloc] initWithContentsOfFile:raw entrySize:sizeof(uint64_t) windowSize:4 options:CBHSliceFileHeader error:&error] autorelease], @"Fails to catch missing header.");
+	XCTAssertEqual([error code], CBHCollectionFormatErrorMagic, @"Incorrect error.");
+
+	[[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+	[[NSFileManager defaultManager] removeItemAtPath:raw error:NULL];
+}
+
+- (void)test_invalid
+{
+	CBHWriteDefaultFile(path, 10, CBHSliceFileOptionsNone);
+
+	NSError *error = nil;
+	XCTAssertNil([[[CBHSliceReader alloc] initWithContentsOfFile:path entrySize:3 windowSize:4 options:CBHSliceFileOptionsNone error:&error] autorelease], @"Fails to catch bad length.");
+	XCTAssertEqual([error code], CBHCollectionFormatErrorEntrySize, @"Incorrect error.");
+
+	error = nil;
+	XCTAssertNil([[[CBHSliceReader alloc] initWithContentsOfFile:@"/nonexistent/file" entrySize:8 windowSize:4 options:CBHSliceFileOptionsNone error:&error] autorelease], @"Fails to catch missing file.");
+	XCTAssertEqualObjects([error domain], NSPOSIXErrorDomain, @"Incorrect error domain.");
+
+	XCTAssertThrows([CBHSliceReader readerWithContentsOfFile:path entrySize:8 windowSize:0 options:CBHSliceFileOptionsNone], @"Fails to catch empty window.");
+	XCTAssertThrows([CBHSliceReader readerWithContentsOfFile:path entrySize:8 windowSize:4 options:CBHSliceFileAdviseRandom], @"Fails to catch random access.");
+
+	[[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+- (void)test_empty
+{
+	CBHWriteDefaultFile(path, 0, CBHSliceFileOptionsNone);
+
+	CBHSliceReader *reader = [CBHSliceReader readerWithContentsOfFile:path entrySize:sizeof(uint64_t) windowSize:8 options:CBHSliceFileOptionsNone];
+	XCTAssertNotNil(reader, @"Fails to open empty file.");
+	XCTAssertNil([reader nextSlice], @"Fails to finish.");
+	XCTAssertNil([reader error], @"Incorrect error.");
+
+	[[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+- (void)test_copy
+{
+	CBHWriteDefaultFile(path, 20, CBHSliceFileOptionsNone);
+
+	CBHSliceReader *reader = [CBHSliceReader readerWithContentsOfFile:path entrySize:sizeof(uint64_t) windowSize:4 options:CBHSliceFileOptionsNone];
+
+	/// Windows are reused, copies keep their contents.
+	CBHSlice *first = [[[reader nextSlice] copy] autorelease];
+	[reader nextSlice];
+	[reader nextSlice];
+
+	XCTAssertEqual([first uint64AtIndex:0], 0ULL, @"Fails to keep copy.");
+	XCTAssertEqual([first uint64AtIndex:3], 3ULL, @"Fails to keep copy.");
+
+	[[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+- (void)test_reusedWindow
+{
+	CBHWriteDefaultFile(path, 20, CBHSliceFileOptionsNone);
+
+	CBHSliceReader *reader = [CBHSliceReader readerWithContentsOfFile:path entrySize:sizeof(uint64_t) windowSize:4 options:CBHSliceFileOptionsNone];
+
+	CBHSlice *window = [reader nextSlice];
+	CBHSlice *copy = [[window copy] autorelease];
+	CBHMutableSlice *mutableCopy = [[window mutableCopy] autorelease];
+	NSData *data = [window dataNoCopy];
+	XCTAssertEqual([window hash], [copy hash], @"Incorrect hash.");
+
+	/// Reading on until the window is reused leaves everything taken from it alone.
+	CBHSlice *next = [reader nextSlice];
+	while ( next && next != window ) { next = [reader nextSlice]; }
+	XCTAssertEqual(next, window, @"Fails to reuse window.");
+
+	XCTAssertNotEqualObjects(window, copy, @"Fails to refill window.");
+	XCTAssertEqual([window hash], [[[window copy] autorelease] hash], @"Fails to hash refilled window.");
+	XCTAssertEqualObjects(mutableCopy, copy, @"Fails to keep mutable copy.");
+	XCTAssertEqual(*(const uint64_t *)[data bytes], 0ULL, @"Fails to keep data.");
+
+	[[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+@end